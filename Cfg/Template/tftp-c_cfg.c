@@ -68,6 +68,23 @@ const  TFTPc_CFG  TFTPc_Cfg = {
 *--------------------------------------------------------------------------------------------------------
 */
          5000,                                          /* Maximum inactivity time (ms) on RX.                          */
-         5000                                           /* Maximum inactivity time (ms) on TX.                          */
+         5000,                                          /* Maximum inactivity time (ms) on TX.                          */
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                    TX RATE LIMIT CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                        /* Only used when TFTPc_CFG_TX_RATE_LIMIT_EN is enabled.        */
+         0,                                             /* Maximum tx rate (octets/s) of a session, 0 if unlimited.     */
+         0,                                             /* Maximum tx burst (octets), 0 for a single packet.            */
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                  TRANSFER DEADLINE CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                        /* Only used when TFTPc_CFG_ABORT_EN is enabled.                */
+         0                                              /* Maximum duration (ms) of a transfer, 0 if unbounded.         */
 };
 
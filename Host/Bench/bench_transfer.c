@@ -0,0 +1,392 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : TRANSFER BENCHMARK DRIVER
+*
+* Filename : bench_transfer.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc_Get() on the BSD socket port against the test server on 127.0.0.1, for every
+*                combination of :
+*
+*                (a) File size   : 1 KB to 1 GB (see Bench_SizeTbl[]), up to the size given with '-s'.
+*                (b) Block size  : req'd with TFTPc_BlkSizeSet().
+*                (c) Window size : req'd by TFTPc, capped by the server (see 'Srv/host_srv.h  Note #5b').
+*                (d) Sink        : NetFS file, or the simulated flash (sizes up to BENCH_FLASH_SIZE only).
+*
+*            (2) One CSV line is printed per transfer, after a header line :
+*
+*                    size,blksize,winsize,sink,result,duration_ms,throughput_kBps,cpu_ms_per_MB,
+*                    client_retx,client_rx_timeouts,server_retx
+*
+*                (a) 'duration_ms'     is the session duration reported by TFTPc (see 'tftp-c.h  TFTPc
+*                                      STATISTICS DATA TYPE  Note #2c').
+*                (b) 'throughput_kBps' is computed over the wall-clock time of TFTPc_Get(), in octets per
+*                                      millisecond, so that small files are measured too.
+*                (c) 'cpu_ms_per_MB'   is the CPU time of the client thread only, per MB (2^20 octets).
+*                (d) 'result' is 'ok', or the TFTPc error code.
+*
+*            (3) Usage : tftpc_bench [-s max_size_octets] [-l loss_rate] [-r rtt_ms]
+*
+*                (a) '-l' drops the given rate of the packets of each direction, in units of 0.01 %.
+*                (b) '-r' delays the packets of each direction by half the given round-trip time.
+*
+*                The impairments are applied by the BSD backend (see 'Port/host_net.h  Note #2'), with fixed
+*                seeds, so that the same transfer loses the same packets from one run to the next.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+
+#include  <Source/tftp-c.h>
+#include  <Source/tftp-c_flash.h>
+#include  "../Srv/host_srv.h"
+#include  "../Test/host_test.h"
+#include  "../Port/host_net.h"
+
+#include  <stdlib.h>
+#include  <string.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  BENCH_FLASH_SIZE                   (64u * 1024u * 1024u)
+#define  BENCH_FLASH_SECTOR_SIZE                        4096u
+#define  BENCH_FLASH_PAGE_SIZE                           256u
+
+#define  BENCH_SINK_FILE                                   0u
+#define  BENCH_SINK_FLASH                                  1u
+
+#define  BENCH_OCTETS_PER_MB                (1024.0 * 1024.0)
+
+#define  BENCH_IMPAIR_SEED_TX                     0x7F4A7C15u   /* See Note #3.                                         */
+#define  BENCH_IMPAIR_SEED_RX                     0x2545F491u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL CONSTANTS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  CPU_INT32U   Bench_SizeTbl[]    = { 1024u, 65536u, 1048576u, 16777216u, 268435456u, 1073741824u };
+static  const  CPU_INT16U   Bench_BlkSizeTbl[] = { 512u, 1428u, 8192u };
+static  const  CPU_INT16U   Bench_WinSizeTbl[] = { 1u, 4u, 16u };
+static  const  CPU_CHAR    *Bench_SinkName[]   = { "file", "flash" };
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR         *Bench_DirSrv;
+static  CPU_CHAR         *Bench_DirLocal;
+static  TFTPc_CFG         Bench_Cfg;
+static  TFTPc_FLASH       Bench_Flash;
+static  TFTPc_FLASH_RAM   Bench_FlashRAM;
+static  CPU_INT08U       *Bench_FlashMemPtr;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Bench_TimeGet()
+*
+* Description : Get the time of a clock, in seconds.
+*********************************************************************************************************
+*/
+
+static  double  Bench_TimeGet (clockid_t  clk)
+{
+    struct  timespec  ts;
+
+
+    clock_gettime(clk, &ts);
+
+    return ((double)ts.tv_sec + ((double)ts.tv_nsec / 1e9));
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Bench_Run()
+*
+* Description : Run one transfer of the matrix & print its CSV line (see Note #2).
+*
+* Argument(s) : size        File size, in octets.
+*
+*               blk_size    Block size req'd.
+*
+*               win_size    Window size answered by the server.
+*
+*               sink        BENCH_SINK_FILE or BENCH_SINK_FLASH.
+*
+*               p_name      Remote file name.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+static  void  Bench_Run (       CPU_INT32U   size,
+                                CPU_INT16U   blk_size,
+                                CPU_INT16U   win_size,
+                                CPU_INT08U   sink,
+                         const  CPU_CHAR    *p_name)
+{
+    HOST_SRV_BSD    *p_srv;
+    HOST_SRV_CFG     srv_cfg;
+    HOST_SRV_STATS   srv_stats;
+    TFTPc_STATS      stats;
+    TFTPc_MODE       mode;
+    CPU_INT16U       port;
+    CPU_BOOLEAN      ok;
+    TFTPc_ERR        err;
+    TFTPc_ERR        err_stats;
+    double           wall_start;
+    double           wall_s;
+    double           cpu_start;
+    double           cpu_s;
+
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Bench_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    srv_cfg.OptEn      = DEF_YES;
+    srv_cfg.WinSizeMax = win_size;
+    p_srv              = HostSrvBSD_Start(&srv_cfg, &port);
+    if (p_srv == DEF_NULL) {
+        fprintf(stderr, "server start failed\n");
+        exit(1);
+    }
+    Bench_Cfg.ServerPortNbr = port;
+
+   (void)TFTPc_BlkSizeSet(blk_size, &err);
+    mode = TFTPc_MODE_OCTET;
+    if (sink == BENCH_SINK_FLASH) {
+        mode |= TFTPc_MODE_FLAG_FLASH;
+    }
+
+    wall_start = Bench_TimeGet(CLOCK_MONOTONIC);
+    cpu_start  = Bench_TimeGet(CLOCK_THREAD_CPUTIME_ID);
+    ok         = TFTPc_Get(&Bench_Cfg, HostTest_Path(Bench_DirLocal, p_name), (CPU_CHAR *)p_name, mode, &err);
+    cpu_s      = Bench_TimeGet(CLOCK_THREAD_CPUTIME_ID) - cpu_start;
+    wall_s     = Bench_TimeGet(CLOCK_MONOTONIC)         - wall_start;
+
+    Mem_Clr(&stats, sizeof(stats));
+   (void)TFTPc_StatsGet(&stats, &err_stats);
+    HostSrvBSD_StatsGet(p_srv, &srv_stats);
+    HostSrvBSD_Stop(p_srv);
+
+    if ((ok   == DEF_OK) &&
+        (sink == BENCH_SINK_FILE)) {
+        remove(HostTest_Path(Bench_DirLocal, p_name));          /* Keep the scratch dir small.                          */
+    }
+
+    printf("%u,%u,%u,%s,", (unsigned)size, (unsigned)stats.BlkSize, (unsigned)stats.WinSize, Bench_SinkName[sink]);
+    if (ok == DEF_OK) {
+        printf("ok,");
+    } else {
+        printf("err%u,", (unsigned)err);
+    }
+    printf("%u,%.1f,%.3f,%u,%u,%u\n",
+           (unsigned)stats.Duration_ms,
+           (wall_s > 0.0) ? ((double)size / (wall_s * 1000.0)) : 0.0,
+           (size   > 0u ) ? ((cpu_s * 1000.0) / ((double)size / BENCH_OCTETS_PER_MB)) : 0.0,
+           (unsigned)stats.TxRetryCtr,
+           (unsigned)stats.RxTimeoutCtr,
+           (unsigned)srv_stats.TxRetryCtr);
+    fflush(stdout);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Bench_ImpairSet()
+*
+* Description : Impair both directions of the client's traffic (see Note #3).
+*
+* Argument(s) : loss_rate   Rate of packets lost, in units of 0.01 %.
+*
+*               rtt_ms      Round-trip time added, in milliseconds.
+*
+* Return(s)   : DEF_OK,   if the impairments were set.
+*
+*               DEF_FAIL, if the loss rate is invalid.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Bench_ImpairSet (CPU_INT32U  loss_rate,
+                                      CPU_INT32U  rtt_ms)
+{
+    HOST_IMPAIR_CFG  impair_cfg;
+
+
+    if (loss_rate > HOST_IMPAIR_RATE_SCALE) {
+        return (DEF_FAIL);
+    }
+
+    Mem_Clr(&impair_cfg, sizeof(impair_cfg));
+    impair_cfg.LossRate = (CPU_INT16U)loss_rate;
+    impair_cfg.Dly_us   = rtt_ms * 500u;                        /* Half the RTT each way.                               */
+
+    impair_cfg.Seed     = BENCH_IMPAIR_SEED_TX;
+    if (HostNet_ImpairSet(HOST_NET_IMPAIR_DIR_TX, &impair_cfg) != DEF_OK) {
+        return (DEF_FAIL);
+    }
+    impair_cfg.Seed     = BENCH_IMPAIR_SEED_RX;
+
+    return (HostNet_ImpairSet(HOST_NET_IMPAIR_DIR_RX, &impair_cfg));
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (int    argc,
+           char  *argv[])
+{
+    CPU_CHAR     name[32];
+    CPU_INT32U   size_max;
+    CPU_INT32U   loss_rate;
+    CPU_INT32U   rtt_ms;
+    CPU_INT32U   val;
+    CPU_INT32U   ix_size;
+    CPU_INT32U   ix_blk;
+    CPU_INT32U   ix_win;
+    CPU_INT08U   sink;
+    int          ix_arg;
+    CPU_BOOLEAN  usage;
+    TFTPc_ERR    err;
+
+
+    size_max  = DEF_INT_32U_MAX_VAL;
+    loss_rate = 0u;
+    rtt_ms    = 0u;
+    usage     = DEF_NO;
+    for (ix_arg = 1; ix_arg < argc; ix_arg += 2) {              /* See Note #3.                                         */
+        if (ix_arg + 1 >= argc) {
+            usage = DEF_YES;
+            break;
+        }
+        val = (CPU_INT32U)strtoul(argv[ix_arg + 1], DEF_NULL, 0);
+        if (strcmp(argv[ix_arg], "-s") == 0) {
+            size_max  = val;
+        } else if (strcmp(argv[ix_arg], "-l") == 0) {
+            loss_rate = val;
+        } else if (strcmp(argv[ix_arg], "-r") == 0) {
+            rtt_ms    = val;
+        } else {
+            usage     = DEF_YES;
+            break;
+        }
+    }
+    if ((usage == DEF_NO) &&
+        ((loss_rate > 0u) || (rtt_ms > 0u))) {
+        usage = (Bench_ImpairSet(loss_rate, rtt_ms) == DEF_OK) ? DEF_NO : DEF_YES;
+    }
+    if (usage == DEF_YES) {
+        fprintf(stderr, "usage: %s [-s max_size_octets] [-l loss_rate] [-r rtt_ms]\n", argv[0]);
+        return (2);
+    }
+
+    Bench_DirSrv      = HostTest_DirCreate();
+    Bench_DirLocal    = HostTest_DirCreate();
+    Bench_FlashMemPtr = (CPU_INT08U *)malloc(BENCH_FLASH_SIZE);
+    if ((Bench_DirSrv      == DEF_NULL) ||
+        (Bench_DirLocal    == DEF_NULL) ||
+        (Bench_FlashMemPtr == DEF_NULL)) {
+        fprintf(stderr, "setup failed\n");
+        return (HostTest_End() | 1);
+    }
+
+    Bench_Cfg = TFTPc_Cfg;
+    if ((TFTPc_Init(&Bench_Cfg, &err)                                                       != DEF_OK) ||
+        (TFTPc_FlashRAM_Init(&Bench_Flash, &Bench_FlashRAM, Bench_FlashMemPtr, BENCH_FLASH_SIZE,
+                             BENCH_FLASH_SECTOR_SIZE, BENCH_FLASH_PAGE_SIZE, 0u, &err)     != DEF_OK) ||
+        (TFTPc_FlashSet(&Bench_Flash, &err)                                                 != DEF_OK)) {
+        fprintf(stderr, "TFTPc init failed : %u\n", (unsigned)err);
+        return (HostTest_End() | 1);
+    }
+
+    printf("size,blksize,winsize,sink,result,duration_ms,throughput_kBps,cpu_ms_per_MB,"
+           "client_retx,client_rx_timeouts,server_retx\n");
+
+    for (ix_size = 0u; ix_size < sizeof(Bench_SizeTbl) / sizeof(Bench_SizeTbl[0]); ix_size++) {
+        if (Bench_SizeTbl[ix_size] > size_max) {
+            break;
+        }
+        snprintf(name, sizeof(name), "bench_%u.bin", (unsigned)Bench_SizeTbl[ix_size]);
+        if (HostTest_FileWr(HostTest_Path(Bench_DirSrv, name), Bench_SizeTbl[ix_size], ix_size + 1u) != DEF_OK) {
+            fprintf(stderr, "cannot create %s\n", name);
+            break;
+        }
+
+        for (sink = BENCH_SINK_FILE; sink <= BENCH_SINK_FLASH; sink++) {
+            if ((sink                   == BENCH_SINK_FLASH) &&
+                (Bench_SizeTbl[ix_size] >  BENCH_FLASH_SIZE)) {
+                continue;
+            }
+            for (ix_blk = 0u; ix_blk < sizeof(Bench_BlkSizeTbl) / sizeof(Bench_BlkSizeTbl[0]); ix_blk++) {
+                for (ix_win = 0u; ix_win < sizeof(Bench_WinSizeTbl) / sizeof(Bench_WinSizeTbl[0]); ix_win++) {
+                    Bench_Run(Bench_SizeTbl[ix_size], Bench_BlkSizeTbl[ix_blk], Bench_WinSizeTbl[ix_win], sink, name);
+                }
+            }
+        }
+
+        remove(HostTest_Path(Bench_DirSrv, name));
+    }
+
+    free(Bench_FlashMemPtr);
+
+    return (HostTest_End());
+}
@@ -0,0 +1,90 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP CLIENT CONFIGURATION FILE
+*
+*                                              HOST PORT
+*
+* Filename : tftp-c_cfg.c
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "tftp-c_cfg.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                 TFTP CLIENT CONFIGURATION STRUCTURE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+const  TFTPc_CFG  TFTPc_Cfg = {
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                    TFTP SERVER CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                        /* TFTP Server hostname or IP address.                          */
+        "127.0.0.1",
+                                                        /* TFTP Server port number.                                     */
+         69,
+                                                        /* Select IP family of address when DNS resolution is used:     */
+         NET_IP_ADDR_FAMILY_NONE,
+                                                        /* NET_IP_ADDR_FAMILY_NONE: No preference between IPv6 and IPv4.*/
+                                                        /* NET_IP_ADDR_FAMILY_IPv4: Only IPv4 addr will be returned.    */
+                                                        /* NET_IP_ADDR_FAMILY_IPv6: Only IPv6 addr will be returned.    */
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                     TIMEOUT CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+         5000,                                          /* Maximum inactivity time (ms) on RX.                          */
+         5000,                                          /* Maximum inactivity time (ms) on TX.                          */
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                    TX RATE LIMIT CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                        /* Only used when TFTPc_CFG_TX_RATE_LIMIT_EN is enabled.        */
+         0,                                             /* Maximum tx rate (octets/s) of a session, 0 if unlimited.     */
+         0,                                             /* Maximum tx burst (octets), 0 for a single packet.            */
+
+/*
+*--------------------------------------------------------------------------------------------------------
+*                                  TRANSFER DEADLINE CONFIGURATION
+*--------------------------------------------------------------------------------------------------------
+*/
+                                                        /* Only used when TFTPc_CFG_ABORT_EN is enabled.                */
+         0                                              /* Maximum duration (ms) of a transfer, 0 if unbounded.         */
+};
+
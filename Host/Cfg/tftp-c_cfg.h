@@ -0,0 +1,895 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP CLIENT CONFIGURATION FILE
+*
+*                                              HOST PORT
+*
+* Filename : tftp-c_cfg.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Configuration used by the host build (see 'Host/readme.md').  The values are the ones of
+*                the template; each one may be overridden on the compiler command line, so that the build
+*                can produce the library in several configurations (test variants & size profiles).
+*********************************************************************************************************
+*/
+
+#ifndef TFTPc_CFG_MODULE_PRESENT
+#define TFTPc_CFG_MODULE_PRESENT
+
+#include  <Source/tftp-c_type.h>
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPc ARGUMENT CHECK CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_ARG_CHK_EXT_EN to enable/disable the TFTP client external argument
+*               check feature :
+*
+*               (a) When ENABLED,  ALL arguments received from any port interface provided by the developer
+*                   are checked/validated.
+*
+*               (b) When DISABLED, NO  arguments received from any port interface provided by the developer
+*                   are checked/validated.
+*********************************************************************************************************
+*/
+                                                                /* Configure external argument check feature ...        */
+                                                                /* See Note 1.                                          */
+#ifndef  TFTPc_CFG_ARG_CHK_EXT_EN
+#define  TFTPc_CFG_ARG_CHK_EXT_EN                    DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     External argument check DISABLED    */
+                                                                /* DEF_ENABLED      External argument check ENABLED     */
+
+/*
+*********************************************************************************************************
+*                                    TFTPc FOOTPRINT CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_PUT_EN to enable/disable the write request (TFTPc_Put()) & the whole
+*               file read & DATA tx path.  A client that only downloads files can disable it.
+*
+*           (2) Configure TFTPc_CFG_NETASCII_EN to enable/disable the 'netascii' transfer mode.  When
+*               disabled, TFTPc_MODE_NETASCII requests fail with TFTPc_ERR_INVALID_MODE.
+*
+*           (3) Configure TFTPc_CFG_IPv4_EN & TFTPc_CFG_IPv6_EN to enable/disable each IP family in TFTPc.
+*               An IP family is only used when it is also enabled in the network stack.  At least one
+*               family MUST be enabled.
+*********************************************************************************************************
+*/
+                                                                /* Configure write request support (see Note #1) :      */
+#ifndef  TFTPc_CFG_PUT_EN
+#define  TFTPc_CFG_PUT_EN                            DEF_ENABLED
+#endif
+                                                                /* DEF_DISABLED     TFTPc_Put() DISABLED                */
+                                                                /* DEF_ENABLED      TFTPc_Put() ENABLED                 */
+
+                                                                /* Configure netascii mode support (see Note #2) :      */
+#ifndef  TFTPc_CFG_NETASCII_EN
+#define  TFTPc_CFG_NETASCII_EN                       DEF_ENABLED
+#endif
+                                                                /* DEF_DISABLED     Netascii mode DISABLED              */
+                                                                /* DEF_ENABLED      Netascii mode ENABLED               */
+
+                                                                /* Configure IP families (see Note #3) :                */
+#ifndef  TFTPc_CFG_IPv4_EN
+#define  TFTPc_CFG_IPv4_EN                           DEF_ENABLED
+#endif
+#ifndef  TFTPc_CFG_IPv6_EN
+#define  TFTPc_CFG_IPv6_EN                           DEF_ENABLED
+#endif
+                                                                /* DEF_DISABLED     IP family DISABLED                  */
+                                                                /* DEF_ENABLED      IP family ENABLED                   */
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc SOCKET CONNECT CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_SOCK_CONN_EN to enable/disable connecting the client socket to the
+*               server transfer ID (TID) once the first reply is rx'd :
+*
+*               (a) When DISABLED, packets from other sources reach TFTPc, which discards them & answers
+*                   each with an ERROR 'Unknown transfer ID' (RFC #1350, section 4).  This also stops right
+*                   away a duplicate server session created by a retransmitted request.
+*
+*               (b) When ENABLED,  the network stack discards packets from other sources before they
+*                   reach TFTPc, & pkts are tx'd without specifying the remote address every time.  NO
+*                   ERROR is sent : a duplicate server session goes on until it times out.
+*
+*           (2) The default is DISABLED : RFC #1350 requires the ERROR of Note #1a, & a duplicate server
+*               session left running loads the server & the link until its retries run out.  Enable it
+*               only to have the stack filter the strays, e.g. on a network with heavy broadcast traffic.
+*********************************************************************************************************
+*/
+                                                                /* Configure sock connect (see Notes #1 & #2) :         */
+#ifndef  TFTPc_CFG_SOCK_CONN_EN
+#define  TFTPc_CFG_SOCK_CONN_EN                      DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Sock NOT conn'd, TFTPc filters TID  */
+                                                                /* DEF_ENABLED      Sock conn'd to server TID           */
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc STATISTICS CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_STAT_EN to enable/disable the transfer statistics counters.  Counters
+*               of the last session are obtained with TFTPc_StatsGet().
+*********************************************************************************************************
+*/
+                                                                /* Configure statistics counters (see Note #1) :        */
+#ifndef  TFTPc_CFG_STAT_EN
+#define  TFTPc_CFG_STAT_EN                           DEF_ENABLED
+#endif
+                                                                /* DEF_DISABLED     Statistics DISABLED                 */
+                                                                /* DEF_ENABLED      Statistics ENABLED                  */
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc SERVER ERROR CONFIGURATION
+*
+* Note(s) : (1) The code & message of the last ERROR pkt rx'd from the server are obtained with
+*               TFTPc_ServerErrGet().  Configure TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX with the maximum number of
+*               message characters kept, NOT including the terminating NULL character; longer messages are
+*               truncated.
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX
+#define  TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX                 63u   /* Configure max ERROR msg len (see Note #1).           */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPc DUPLICATE DATA RE-ACK CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_RX_DUP_REACK_EN to enable/disable the immediate re-transmission of the
+*               last ACK when the previous DATA block is rx'd again during a Get.  A duplicate of the
+*               previous block means the server did not get our ACK; answering right away avoids waiting
+*               for the server's own retransmission timeout.
+*
+*           (2) To avoid the 'Sorcerer's Apprentice' syndrome (RFC #1123, section 4.2.3.1), the same
+*               block is re-ACK'd at most once per TFTPc_CFG_RX_DUP_REACK_INTERVAL_MIN_ms.  Copies of a
+*               DATA pkt arriving closer than that (e.g. duplicated by the network) are ignored.
+*********************************************************************************************************
+*/
+                                                                /* Configure duplicate DATA re-ACK (see Note #1) :      */
+#ifndef  TFTPc_CFG_RX_DUP_REACK_EN
+#define  TFTPc_CFG_RX_DUP_REACK_EN                   DEF_ENABLED
+#endif
+                                                                /* DEF_DISABLED     Dup DATA silently ignored           */
+                                                                /* DEF_ENABLED      Dup DATA re-ACK'd                   */
+
+#ifndef  TFTPc_CFG_RX_DUP_REACK_INTERVAL_MIN_ms
+#define  TFTPc_CFG_RX_DUP_REACK_INTERVAL_MIN_ms          100u   /* Configure min interval between re-ACKs (see Note #2).*/
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc PHASE PROFILING CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_PROFILE_EN to enable/disable the measurement of the time spent in each
+*               phase of a transfer (rx, file access, pkt building & tx).  Results for the last session
+*               are obtained with TFTPc_ProfileGet().
+*
+*           (2) Requires CPU_CFG_TS_32_EN to be enabled in 'cpu_cfg.h'.
+*********************************************************************************************************
+*/
+                                                                /* Configure phase profiling (see Note #1) :            */
+#ifndef  TFTPc_CFG_PROFILE_EN
+#define  TFTPc_CFG_PROFILE_EN                        DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Phase profiling DISABLED            */
+                                                                /* DEF_ENABLED      Phase profiling ENABLED             */
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc TX RATE LIMIT CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_TX_RATE_LIMIT_EN to enable/disable tx pacing.  When enabled, every pkt
+*               tx'd must obtain tokens from two token buckets :
+*
+*               (a) The session bucket, configured by the 'TxRateMaxOctetsPerSec' & 'TxBurstMaxOctets'
+*                   fields of the TFTPc_CFG structure used for the transfer.
+*
+*               (b) The global bucket, shared by all sessions & configured with TFTPc_TxRateLimitSet().
+*********************************************************************************************************
+*/
+                                                                /* Configure tx rate limit (see Note #1) :              */
+#ifndef  TFTPc_CFG_TX_RATE_LIMIT_EN
+#define  TFTPc_CFG_TX_RATE_LIMIT_EN                  DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Tx rate limit DISABLED              */
+                                                                /* DEF_ENABLED      Tx rate limit ENABLED               */
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPc BACKGROUND TRANSFER CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_BG_EN to enable/disable background transfers.  A transfer started with
+*               the TFTPc_MODE_FLAG_BG mode flag yields to the other traffic on the path to the server, so
+*               that bulk transfers (e.g. log uploads) do NOT increase the latency of the foreground traffic :
+*
+*               (a) The round-trip time is measured for each ACK tx'd at the end of a window (TFTPc_Get())
+*                   or for each block tx'd (TFTPc_Put()).  The smallest round-trip time of the transfer is
+*                   the base delay; the excess over the base delay is the queuing delay.
+*               (b) While the queuing delay exceeds TFTPc_CFG_BG_DLY_TARGET_ms, the delay inserted before the
+*                   next ACK (TFTPc_Get()) or block (TFTPc_Put()) grows by the excess, up to
+*                   TFTPc_CFG_BG_DLY_MAX_ms.  Otherwise, the delay inserted is halved.
+*
+*           (2) TFTPc_CFG_BG_DLY_MAX_ms MUST be smaller than the retransmission timeout of the server.
+*********************************************************************************************************
+*/
+                                                                /* Configure background transfer (see Note #1) :        */
+#ifndef  TFTPc_CFG_BG_EN
+#define  TFTPc_CFG_BG_EN                             DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Background transfer DISABLED        */
+                                                                /* DEF_ENABLED      Background transfer ENABLED         */
+
+#ifndef  TFTPc_CFG_BG_DLY_TARGET_ms
+#define  TFTPc_CFG_BG_DLY_TARGET_ms                       25u   /* Configure queuing delay target (see Note #1b).       */
+#endif
+#ifndef  TFTPc_CFG_BG_DLY_MAX_ms
+#define  TFTPc_CFG_BG_DLY_MAX_ms                         500u   /* Configure max delay inserted   (see Note #2).        */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc CODEC CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_CODEC_EN to enable/disable the codec stage of the data path (e.g. to
+*               decompress files on the fly).  The codec itself is provided by the application & registered
+*               with TFTPc_CodecSet() (see 'tftp-c.h  TFTPc CODEC DATA TYPE').
+*
+*           (2) TFTPc_CFG_CODEC_BUF_SIZE configures the size of the working buffer between the codec & the
+*               file system, in octets.  It bounds the RAM used by the codec stage, apart from the codec's
+*               own context.
+*
+*           (3) Configure TFTPc_CFG_DELTA_EN to enable/disable the delta update codec, which rebuilds a file
+*               from a patch & a local base file (see 'tftp-c_delta.h').  Requires TFTPc_CFG_CODEC_EN.
+*
+*           (4) Configure TFTPc_CFG_CODEC_HS_EN to enable/disable the heatshrink codec, which compresses &
+*               decompresses files in the heatshrink (LZSS) format (see 'tftp-c_hs.h').  Requires
+*               TFTPc_CFG_CODEC_EN.
+*
+*               (a) TFTPc_CFG_CODEC_HS_WIN_BITS & TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS configure the window &
+*                   lookahead sizes, as the base 2 logarithm of their size in octets.  They MUST match the
+*                   '-w' & '-l' arguments of the heatshrink tool which (de)compresses the files on the
+*                   server side.  The heatshrink context holds 2 windows.
+*********************************************************************************************************
+*/
+                                                                /* Configure codec stage (see Note #1) :                */
+#ifndef  TFTPc_CFG_CODEC_EN
+#define  TFTPc_CFG_CODEC_EN                          DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Codec stage DISABLED                */
+                                                                /* DEF_ENABLED      Codec stage ENABLED                 */
+
+#ifndef  TFTPc_CFG_CODEC_BUF_SIZE
+#define  TFTPc_CFG_CODEC_BUF_SIZE                        256u   /* Configure codec buf size (see Note #2).              */
+#endif
+
+                                                                /* Configure delta update codec (see Note #3) :         */
+#ifndef  TFTPc_CFG_DELTA_EN
+#define  TFTPc_CFG_DELTA_EN                          DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Delta codec DISABLED                */
+                                                                /* DEF_ENABLED      Delta codec ENABLED                 */
+
+                                                                /* Configure heatshrink codec (see Note #4) :           */
+#ifndef  TFTPc_CFG_CODEC_HS_EN
+#define  TFTPc_CFG_CODEC_HS_EN                       DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Heatshrink codec DISABLED           */
+                                                                /* DEF_ENABLED      Heatshrink codec ENABLED            */
+
+#ifndef  TFTPc_CFG_CODEC_HS_WIN_BITS
+#define  TFTPc_CFG_CODEC_HS_WIN_BITS                       8u   /* Configure window    size (see Note #4a).             */
+#endif
+#ifndef  TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS
+#define  TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS                 4u   /* Configure lookahead size (see Note #4a).             */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPc MULTICAST CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_MCAST_EN to enable/disable multicast reception (RFC #2090).  A read
+*               request issued with TFTPc_MODE_FLAG_MCAST then asks the server for a multicast transfer, so
+*               that many clients share the same DATA blocks.  Requires IPv4 multicast rx & NetSock_Sel()
+*               in the network stack (see 'net_cfg.h').
+*
+*           (2) TFTPc_CFG_MCAST_BLK_NBR_MAX configures the maximum number of blocks of a file rx'd by
+*               multicast, i.e. its maximum size in blocks of 512 octets.  One bit of RAM is used per block
+*               to track the blocks rx'd.
+*
+*           (3) TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX configures the number of consecutive rx timeouts after
+*               which a passive client gives up.  A passive client waits for the server to promote it to
+*               master client, which may take as long as the transfer of the master client : it is
+*               configured apart from the re-tx limit of an active client.
+*********************************************************************************************************
+*/
+                                                                /* Configure multicast reception (see Note #1) :        */
+#ifndef  TFTPc_CFG_MCAST_EN
+#define  TFTPc_CFG_MCAST_EN                          DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Multicast DISABLED                  */
+                                                                /* DEF_ENABLED      Multicast ENABLED                   */
+
+#ifndef  TFTPc_CFG_MCAST_BLK_NBR_MAX
+#define  TFTPc_CFG_MCAST_BLK_NBR_MAX                    8192u   /* Configure max nbr of blks (see Note #2).             */
+#endif
+
+#ifndef  TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX
+#define  TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX              12u   /* Configure max nbr of passive rx timeouts (Note #3).  */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc FLASH SINK CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_FLASH_EN to enable/disable the flash sink.  A read request issued with
+*               TFTPc_MODE_FLAG_FLASH then writes the file to the flash partition registered with
+*               TFTPc_FlashSet() instead of NetFS (see 'tftp-c.h  TFTPc FLASH DRIVER DATA TYPE').
+*
+*           (2) TFTPc_CFG_FLASH_PAGE_SIZE_MAX configures the size of the page staging buffer, in octets.  It
+*               bounds the page size of the flash drivers that can be registered.
+*
+*           (3) TFTPc_CFG_FLASH_ERASE_AHEAD_NBR configures the number of sectors kept erased ahead of the
+*               write pointer.  Sectors are erased one at a time, once the ACK of a block has been tx'd, so
+*               that the erase time overlaps the transfer of the next block.  With 0, each sector is only
+*               erased when the first page in it is programmed.
+*
+*           (4) Configure TFTPc_CFG_FLASH_RAM_EN to enable/disable the RAM-backed simulated flash driver
+*               (see 'tftp-c_flash.h').  Requires TFTPc_CFG_FLASH_EN.
+*********************************************************************************************************
+*/
+                                                                /* Configure flash sink (see Note #1) :                 */
+#ifndef  TFTPc_CFG_FLASH_EN
+#define  TFTPc_CFG_FLASH_EN                          DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Flash sink DISABLED                 */
+                                                                /* DEF_ENABLED      Flash sink ENABLED                  */
+
+#ifndef  TFTPc_CFG_FLASH_PAGE_SIZE_MAX
+#define  TFTPc_CFG_FLASH_PAGE_SIZE_MAX                   256u   /* Configure max page size (see Note #2).               */
+#endif
+
+#ifndef  TFTPc_CFG_FLASH_ERASE_AHEAD_NBR
+#define  TFTPc_CFG_FLASH_ERASE_AHEAD_NBR                   1u   /* Configure nbr of sectors erased ahead (see Note #3). */
+#endif
+
+                                                                /* Configure simulated flash driver (see Note #4) :     */
+#ifndef  TFTPc_CFG_FLASH_RAM_EN
+#define  TFTPc_CFG_FLASH_RAM_EN                      DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Simulated flash DISABLED            */
+                                                                /* DEF_ENABLED      Simulated flash ENABLED             */
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPc ARCHIVE EXTRACTION CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_TAR_EN to enable/disable archive extraction.  A read request issued with
+*               TFTPc_MODE_FLAG_TAR then rx's a tar (ustar) archive & extracts each of its files as the blocks
+*               arrive, either into NetFS files or to the entry sink registered with TFTPc_TarSinkSet() (see
+*               'tftp-c.h  TFTPc ARCHIVE ENTRY SINK DATA TYPE').  Nothing is staged : the RAM used does NOT
+*               depend on the size of the archive.
+*
+*           (2) TFTPc_CFG_TAR_PATH_LEN_MAX configures the maximum length of the local path of an extracted
+*               file (destination directory & entry name), NOT including the terminating NULL character.
+*
+*           (3) TFTPc_CFG_TAR_PATH_SEP_CHAR configures the path separator of the file system.  The '/' of
+*               the entry names are replaced by this character in the local paths.  An entry name is also split on
+*               this character, so that its ".." components are rejected whichever separator they use.
+*********************************************************************************************************
+*/
+                                                                /* Configure archive extraction (see Note #1) :         */
+#ifndef  TFTPc_CFG_TAR_EN
+#define  TFTPc_CFG_TAR_EN                            DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Archive extraction DISABLED         */
+                                                                /* DEF_ENABLED      Archive extraction ENABLED          */
+
+#ifndef  TFTPc_CFG_TAR_PATH_LEN_MAX
+#define  TFTPc_CFG_TAR_PATH_LEN_MAX                      128u   /* Configure max local path len (see Note #2).          */
+#endif
+
+#ifndef  TFTPc_CFG_TAR_PATH_SEP_CHAR
+#define  TFTPc_CFG_TAR_PATH_SEP_CHAR                     '/'    /* Configure path separator (see Note #3).              */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc SPARSE WRITE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_SPARSE_EN to enable/disable sparse writes.  When enabled, TFTPc_Get() does
+*               NOT write the blocks that only hold zero octets : the file position is moved past them, &
+*               the file is extended to its full size once the last block is rx'd.
+*
+*           (2) The file system MUST allow setting the file position beyond the end of file & MUST read the
+*               octets never written as zero.
+*
+*           (3) With the flash sink (see 'TFTPc FLASH SINK CONFIGURATION'), the pages that only hold erased
+*               octets are NOT programmed.  Their sectors are still erased.
+*********************************************************************************************************
+*/
+                                                                /* Configure sparse writes (see Note #1) :              */
+#ifndef  TFTPc_CFG_SPARSE_EN
+#define  TFTPc_CFG_SPARSE_EN                         DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Sparse writes DISABLED              */
+                                                                /* DEF_ENABLED      Sparse writes ENABLED               */
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPc LAN RELAY CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_RELAY_EN to enable/disable the LAN relay role :
+*
+*               (a) TFTPc_Get() first requests the file from the peers registered with TFTPc_RelayPeerSet(),
+*                   in order, & only from the server of the configuration if none of them has it.
+*
+*               (b) The files rx'd by TFTPc_Get() are recorded in the relay cache & served to the LAN peers
+*                   by a minimal TFTP responder (see TFTPc_RelaySrvStart() & TFTPc_RelaySrvProcess()).  The
+*                   responder negotiates the block size option; it serves one peer at a time, in lock-step.
+*
+*           (2) TFTPc_CFG_RELAY_CACHE_NBR configures the number of files recorded in the relay cache.  When a
+*               new file is rx'd while the cache is full, the cached files are replaced in turn.
+*
+*           (3) TFTPc_CFG_RELAY_NAME_LEN_MAX configures the maximum length of the remote & local names of a
+*               cached file, NOT including the terminating NULL character.  A file with a longer name is NOT
+*               cached.
+*
+*           (4) TFTPc_CFG_RELAY_SRV_TIMEOUT_ms configures the time the responder waits for the ACK of a
+*               DATA block, & TFTPc_CFG_RELAY_SRV_RETRY_MAX the number of times the block is re-tx'd before
+*               the transfer is abandoned.
+*********************************************************************************************************
+*/
+                                                                /* Configure LAN relay (see Note #1) :                  */
+#ifndef  TFTPc_CFG_RELAY_EN
+#define  TFTPc_CFG_RELAY_EN                          DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     LAN relay DISABLED                  */
+                                                                /* DEF_ENABLED      LAN relay ENABLED                   */
+
+#ifndef  TFTPc_CFG_RELAY_CACHE_NBR
+#define  TFTPc_CFG_RELAY_CACHE_NBR                         4u   /* Configure nbr of cached files (see Note #2).         */
+#endif
+
+#ifndef  TFTPc_CFG_RELAY_NAME_LEN_MAX
+#define  TFTPc_CFG_RELAY_NAME_LEN_MAX                     64u   /* Configure max file name len (see Note #3).           */
+#endif
+
+#ifndef  TFTPc_CFG_RELAY_SRV_TIMEOUT_ms
+#define  TFTPc_CFG_RELAY_SRV_TIMEOUT_ms                 1000u   /* Configure ACK timeout (see Note #4).                 */
+#endif
+#ifndef  TFTPc_CFG_RELAY_SRV_RETRY_MAX
+#define  TFTPc_CFG_RELAY_SRV_RETRY_MAX                     3u   /* Configure max nbr of re-tx (see Note #4).            */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc SERVER POOL CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_POOL_EN to enable/disable the server pool.  When enabled, TFTPc_Get()
+*               called without a configuration requests the file from the servers registered with
+*               TFTPc_PoolSet() instead of the server of the default configuration :
+*
+*               (a) The round-trip time & the failure rate of each server are tracked from the transfers
+*                   themselves, without any probe pkt.  Each request is tx'd to the server expected to answer
+*                   first, the servers never req'd being tried first.
+*
+*               (b) When a server stops answering, the transfer is restarted against the next server.  The
+*                   blocks already wr'n to the local file are compared with the blocks rx'd, NOT wr'n again.
+*
+*           (2) TFTPc_CFG_POOL_NBR_MAX configures the maximum number of servers in the pool.
+*********************************************************************************************************
+*/
+                                                                /* Configure server pool (see Note #1) :                */
+#ifndef  TFTPc_CFG_POOL_EN
+#define  TFTPc_CFG_POOL_EN                           DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Server pool DISABLED                */
+                                                                /* DEF_ENABLED      Server pool ENABLED                 */
+
+#ifndef  TFTPc_CFG_POOL_NBR_MAX
+#define  TFTPc_CFG_POOL_NBR_MAX                            4u   /* Configure max nbr of servers (see Note #2).          */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPc WINDOWED TRANSFER CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_WIN_EN to enable/disable windowed read transfers.  When enabled, the
+*               windowsize option (RFC #7440) is req'd by TFTPc_Get() : the server then sends up to a window
+*               of blocks before waiting for an ACK, instead of a single block.
+*
+*           (2) TFTPc_CFG_WIN_SIZE_MAX configures the window size req'd, in blocks.  The server MAY answer
+*               with a smaller window.
+*
+*           (3) TFTPc_CFG_WIN_REORDER_NBR configures the number of blocks kept when they are rx'd after a
+*               missing block.  The server resends the window from the missing block; once it is rx'd, the
+*               blocks kept are wr'n & ACK'd at once, so that the server skips them.  Each block kept uses
+*               512 octets of RAM, or TFTPc_CFG_BLKSIZE_MAX octets when the block size option is enabled;
+*               0 discards the blocks rx'd after a missing block, as in RFC #7440.  MUST be 0 or a power of 2
+*               up to 128, so that the slots of the blocks kept stay distinct when the block number rolls
+*               over.
+*********************************************************************************************************
+*/
+                                                                /* Configure windowed transfer (see Note #1) :          */
+#ifndef  TFTPc_CFG_WIN_EN
+#define  TFTPc_CFG_WIN_EN                            DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Windowed transfer DISABLED          */
+                                                                /* DEF_ENABLED      Windowed transfer ENABLED           */
+
+#ifndef  TFTPc_CFG_WIN_SIZE_MAX
+#define  TFTPc_CFG_WIN_SIZE_MAX                            8u   /* Configure window size req'd   (see Note #2).         */
+#endif
+#ifndef  TFTPc_CFG_WIN_REORDER_NBR
+#define  TFTPc_CFG_WIN_REORDER_NBR                         4u   /* Configure nbr of blks kept    (see Note #3).         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc ADAPTIVE WINDOW CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_WIN_ADAPT_EN to enable/disable the adaptation of the window size req'd to
+*               the losses on the path to the server.  Only used when windowed transfers are enabled (see
+*               'TFTPc WINDOWED TRANSFER CONFIGURATION').
+*
+*               (a) The window size is negotiated once per transfer (RFC #7440), so the window is adapted per
+*                   transfer, NOT within a transfer : the losses & delay rises of a transfer only change the
+*                   window size req'd by the next one.  A single transfer runs with the window negotiated
+*                   for it, however large.
+*               (b) After a transfer without loss nor delay rise, the window grows by one block (additive
+*                   increase).
+*               (c) After a transfer with a gap in the blocks rx'd, a timeout or a delay rise (see Note #3),
+*                   the window is halved (multiplicative decrease).
+*               (d) The window never exceeds TFTPc_CFG_WIN_SIZE_MAX, nor the window size last answered by
+*                   the server when it is smaller than the window size req'd.
+*
+*           (2) TFTPc_CFG_WIN_ADAPT_SIZE_INIT configures the window size req'd by the first transfer, in
+*               blocks.
+*
+*           (3) TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms configures the delay rise, in milliseconds : the smoothed
+*               round-trip time of a read exceeds the smallest one by more than this delay, i.e. the window
+*               fills the queues on the path.  In a background transfer, a queuing delay above
+*               TFTPc_CFG_BG_DLY_TARGET_ms is also a delay rise (see 'TFTPc BACKGROUND TRANSFER
+*               CONFIGURATION').
+*********************************************************************************************************
+*/
+                                                                /* Configure adaptive window (see Note #1) :            */
+#ifndef  TFTPc_CFG_WIN_ADAPT_EN
+#define  TFTPc_CFG_WIN_ADAPT_EN                      DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Adaptive window DISABLED            */
+                                                                /* DEF_ENABLED      Adaptive window ENABLED             */
+
+#ifndef  TFTPc_CFG_WIN_ADAPT_SIZE_INIT
+#define  TFTPc_CFG_WIN_ADAPT_SIZE_INIT                     2u   /* Configure initial window size (see Note #2).         */
+#endif
+#ifndef  TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms
+#define  TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms                  100u   /* Configure delay rise          (see Note #3).         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc BLOCK SIZE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_BLKSIZE_EN to enable/disable the block size option (RFC #2348) for read
+*               requests.  By default, the block size req'd is the largest one that is NOT fragmented on the
+*               interface (see TFTPc_BlkSizeSet()) :
+*
+*                   Block size = MTU - IP hdr (20 octets IPv4, 40 octets IPv6) - UDP hdr (8 octets)
+*                                    - TFTP hdr (4 octets)  - TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD
+*
+*               A block sent in several fragments is lost whenever one of its fragments is lost.  If a
+*               read with blocks larger than 512 octets times out before the first block is rx'd, the request
+*               is re-tx'd once without the block size option, whether probing is enabled or NOT.
+*
+*           (2) TFTPc_CFG_BLKSIZE_MAX configures the largest block size req'd, in octets.  The pkt buffers
+*               are sized for it.
+*
+*           (3) TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD configures the number of octets added to each pkt by a
+*               tunnel (VPN, IPsec, GRE, ...) on the path to the server, which the interface MTU does NOT
+*               account for.
+*
+*           (4) Configure TFTPc_CFG_BLKSIZE_PROBE_EN to enable/disable block size probing.  The path MTU MAY
+*               be smaller than the size derived from the interface :
+*
+*               (a) A block size is marked as failed when the blocks time out TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX
+*                   times in a transfer, or when the transfer fails on timeout once the server answered.
+*                   The next transfers fall back to 512-octet blocks.
+*               (b) After TFTPc_CFG_BLKSIZE_PROBE_INTERVAL transfers without failure, the next transfer
+*                   probes the size halfway between the largest size that worked & the smallest that failed.
+*
+*           (5) By default, the MTU of the default interface is used.  #define TFTPc_BLKSIZE_IF_NBR_GET() to
+*               return the number of the interface towards the server instead.
+*********************************************************************************************************
+*/
+                                                                /* Configure block size option (see Note #1) :          */
+#ifndef  TFTPc_CFG_BLKSIZE_EN
+#define  TFTPc_CFG_BLKSIZE_EN                        DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Block size option DISABLED          */
+                                                                /* DEF_ENABLED      Block size option ENABLED           */
+
+#ifndef  TFTPc_CFG_BLKSIZE_MAX
+#define  TFTPc_CFG_BLKSIZE_MAX                          1468u   /* Configure max blk size req'd  (see Note #2).         */
+#endif
+#ifndef  TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD
+#define  TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD                 0u   /* Configure tunnel overhead     (see Note #3).         */
+#endif
+
+                                                                /* Configure block size probing (see Note #4) :         */
+#ifndef  TFTPc_CFG_BLKSIZE_PROBE_EN
+#define  TFTPc_CFG_BLKSIZE_PROBE_EN                  DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Probing DISABLED                    */
+                                                                /* DEF_ENABLED      Probing ENABLED                     */
+
+#ifndef  TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX
+#define  TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX               3u   /* Configure nbr of timeouts     (see Note #4a).        */
+#endif
+#ifndef  TFTPc_CFG_BLKSIZE_PROBE_INTERVAL
+#define  TFTPc_CFG_BLKSIZE_PROBE_INTERVAL                 10u   /* Configure nbr of transfers    (see Note #4b).        */
+#endif
+
+#if 0                                                           /* Configure interface used      (see Note #5).         */
+#define  TFTPc_BLKSIZE_IF_NBR_GET()               App_TunnelIF_NbrGet()
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc TRANSFER ABORT CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_ABORT_EN to enable/disable transfer abort.  When enabled, a transfer is
+*               aborted when it exceeds the deadline configured by 'TransferTimeoutMax_ms' (see 'tftp-c_cfg.c')
+*               or when it is canceled with TFTPc_Cancel(), given the ID got with TFTPc_SessionIDGet().  The
+*               server is notified with an ERROR pkt & the socket & file are released before
+*               TFTPc_Get()/TFTPc_Put() returns.
+*
+*           (2) TFTPc_CFG_ABORT_POLL_ms configures the max time, in milliseconds, a rx, a backoff or a tx rate
+*               limit wait blocks before the cancel request & the deadline are checked.  It bounds the latency
+*               of TFTPc_Cancel().
+*********************************************************************************************************
+*/
+                                                                /* Configure transfer abort (see Note #1) :             */
+#ifndef  TFTPc_CFG_ABORT_EN
+#define  TFTPc_CFG_ABORT_EN                          DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Transfer abort DISABLED             */
+                                                                /* DEF_ENABLED      Transfer abort ENABLED              */
+
+#ifndef  TFTPc_CFG_ABORT_POLL_ms
+#define  TFTPc_CFG_ABORT_POLL_ms                          50u   /* Configure rx poll period (see Note #2).              */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc REQUEST BACKOFF CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_BACKOFF_EN to enable/disable request backoff.  It keeps a fleet of clients
+*               started at the same time (e.g. after a power cut) from hitting the server in lockstep :
+*
+*               (a) Each transfer is delayed by a random time, up to TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms,
+*                   before the server is contacted.  Set it to 0 to contact the server right away.
+*
+*               (b) While the server has NOT answered the read/write req, each retransmission of the req is
+*                   delayed by a random time, up to the shortest of TFTPc_CFG_BACKOFF_MAX_ms &
+*                   TFTPc_CFG_BACKOFF_BASE_ms doubled at each attempt ("full jitter" exponential backoff).
+*
+*               (c) When the server answers the req with an ERROR whose code is set in
+*                   TFTPc_CFG_BACKOFF_ERR_CODE_MSK (bit N for code N), the req is tx'd again after a backoff
+*                   delay, up to TFTPc_CFG_BACKOFF_REQ_RETRY_MAX times, instead of failing the transfer.  By
+*                   default, code 0 (not defined, used by most servers to report they are busy) & code 3 (disk
+*                   full or allocation exceeded) are retried.  Codes classified as permanent (see
+*                   TFTPc_ServerErrGet()) are NEVER retried, even if set in the mask.
+*
+*           (2) The random generator is seeded at the start of each transfer, from the hardware address of
+*               the default interface & the current time.  #define TFTPc_BACKOFF_SEED_GET() to supply a
+*               device-unique seed instead; a constant seed gives every transfer the same delays.
+*
+*           (3) Host port : a seed given as HOST_CFG_BACKOFF_SEED on the compiler command line is used for
+*               every transfer, so that the simulated tests draw the same delays on every run.
+*********************************************************************************************************
+*/
+                                                                /* Configure request backoff (see Note #1) :            */
+#ifndef  TFTPc_CFG_BACKOFF_EN
+#define  TFTPc_CFG_BACKOFF_EN                        DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Request backoff DISABLED            */
+                                                                /* DEF_ENABLED      Request backoff ENABLED             */
+
+#ifndef  TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms
+#define  TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms          2000u   /* Configure max start delay  (see Note #1a).           */
+#endif
+#ifndef  TFTPc_CFG_BACKOFF_BASE_ms
+#define  TFTPc_CFG_BACKOFF_BASE_ms                       500u   /* Configure 1st backoff window (see Note #1b).         */
+#endif
+#ifndef  TFTPc_CFG_BACKOFF_MAX_ms
+#define  TFTPc_CFG_BACKOFF_MAX_ms                      30000u   /* Configure max backoff window (see Note #1b).         */
+#endif
+#ifndef  TFTPc_CFG_BACKOFF_REQ_RETRY_MAX
+#define  TFTPc_CFG_BACKOFF_REQ_RETRY_MAX                   5u   /* Configure max nbr of req retries (see Note #1c).     */
+#endif
+#ifndef  TFTPc_CFG_BACKOFF_ERR_CODE_MSK
+#define  TFTPc_CFG_BACKOFF_ERR_CODE_MSK   (DEF_BIT_00 | DEF_BIT_03)  /* Configure ERROR codes retried (see Note #1c).   */
+#endif
+
+#if 0                                                           /* Configure backoff seed (see Note #2).                */
+#define  TFTPc_BACKOFF_SEED_GET()                 App_DevSerialNbrGet()
+#endif
+#ifdef   HOST_CFG_BACKOFF_SEED                                  /* Pin backoff seed (see Note #3).                      */
+#define  TFTPc_BACKOFF_SEED_GET()                 HOST_CFG_BACKOFF_SEED
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc PACKET CAPTURE CONFIGURATION
+*
+* Note(s) : (1) Configure TFTPc_CFG_CAP_EN to enable/disable the packet capture ring.  When enabled, every
+*               pkt rx'd or tx'd by a transfer is recorded, with a timestamp & the remote address, in a RAM
+*               ring that can be dumped with TFTPc_CapDump() & exported as a pcap file with
+*               TFTPc_CapPcapExport() (see 'tftp-c_cap.h').
+*
+*           (2) TFTPc_CFG_CAP_RING_NBR_PKT configures the number of pkts kept in the ring.  MUST be a power
+*               of 2.
+*
+*           (3) TFTPc_CFG_CAP_SNAP_LEN configures the number of octets of each pkt recorded, from the start
+*               of the TFTP header.  The default, 516 octets, records whole pkts for the default blk size,
+*               as needed to replay a capture (see 'tftp-c_cap.h  Note #2'); set it to
+*               TFTPc_CFG_BLKSIZE_MAX + 4 when the blksize option is enabled.  4 octets record the opcode &
+*               the blk nbr or error code only, to save RAM.  Also used by TFTPc_CapPcapImport(), even if
+*               the ring is DISABLED.
+*********************************************************************************************************
+*/
+                                                                /* Configure packet capture (see Note #1) :             */
+#ifndef  TFTPc_CFG_CAP_EN
+#define  TFTPc_CFG_CAP_EN                            DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Packet capture DISABLED             */
+                                                                /* DEF_ENABLED      Packet capture ENABLED              */
+
+#ifndef  TFTPc_CFG_CAP_RING_NBR_PKT
+#define  TFTPc_CFG_CAP_RING_NBR_PKT                       32u   /* Configure nbr of pkts in ring (see Note #2).         */
+#endif
+#ifndef  TFTPc_CFG_CAP_SNAP_LEN
+#define  TFTPc_CFG_CAP_SNAP_LEN                          516u   /* Configure nbr of octets recorded per pkt (Note #3).  */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc TIME SOURCE CONFIGURATION
+*
+* Note(s) : (1) By default, TFTPc reads the time with NetUtil_TS_Get_ms() & waits with KAL_Dly().  Define
+*               TFTPc_TIME_GET_ms() & TFTPc_TIME_DLY_ms() to run the client on a simulated clock, e.g. in
+*               a test or benchmark harness :
+*
+*               (a) TFTPc_TIME_GET_ms() MUST return the current time, in milliseconds, as a NET_TS_MS.
+*
+*               (b) TFTPc_TIME_DLY_ms() MAY simply advance the simulated clock by 'dly_ms'.
+*
+*           (2) Rx timeouts are handled by the socket layer (see NetSock_CfgTimeoutRxQ_Set()).  A simulated
+*               socket layer is expected to return NET_SOCK_ERR_RX_Q_EMPTY immediately when no packet is
+*               pending & advance the simulated clock by the configured timeout, so that lossy transfers
+*               complete in a fraction of their real duration while reporting realistic timing.  The
+*               host port provides one ('Host/Sim/'), which also supplies NetUtil_TS_Get_ms() & KAL_Dly()
+*               on the same virtual clock, so that TFTPc_TIME_GET_ms() & TFTPc_TIME_DLY_ms() keep their
+*               default definitions.
+*********************************************************************************************************
+*/
+                                                                /* Configure time source (see Note #1) :                */
+#if 0
+#define  TFTPc_TIME_GET_ms()                      App_SimTimeGet_ms()
+#define  TFTPc_TIME_DLY_ms(dly_ms)                App_SimDly_ms(dly_ms)
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                TFTPc RUN-TIME STRUCTURE CONFIGURATION
+*
+* Note(s) : (1) This structure should be defined into a 'C' file.
+*********************************************************************************************************
+*/
+
+extern  const  TFTPc_CFG       TFTPc_Cfg;                       /* Must always be defined.                              */
+
+
+/*
+*********************************************************************************************************
+*                                               TRACING
+*
+* Note(s) : (1) TFTPc_TRACE_LEVEL/TFTPc_TRACE format text with TFTPc_TRACE for session level messages only
+*               (request sent, session terminated).
+*
+*           (2) Configure TFTPc_CFG_TRACE_RING_EN to enable/disable the binary trace ring.  Per-packet
+*               events are only recorded in the ring, without text formatting (see 'tftp-c_trace.h').
+*
+*           (3) TFTPc_CFG_TRACE_RING_NBR_EVENT configures the number of events kept in the ring.  MUST be
+*               a power of 2.
+*
+*           (4) TFTPc_CFG_TRACE_RING_LVL_DFLT configures the trace level mask in effect at start-up.  The
+*               mask can be changed at run-time with TFTPc_TraceMaskSet().
+*********************************************************************************************************
+*/
+
+#ifndef  TRACE_LEVEL_OFF
+#define  TRACE_LEVEL_OFF                                   0
+#endif
+
+#ifndef  TRACE_LEVEL_INFO
+#define  TRACE_LEVEL_INFO                                  1
+#endif
+
+#ifndef  TRACE_LEVEL_DBG
+#define  TRACE_LEVEL_DBG                                   2
+#endif
+
+#ifndef  TFTPc_TRACE_LEVEL
+#define  TFTPc_TRACE_LEVEL                   TRACE_LEVEL_OFF
+#endif
+#ifndef  TFTPc_TRACE
+#define  TFTPc_TRACE                                  printf
+#endif
+
+                                                                /* Configure binary trace ring (see Note #2) :          */
+#ifndef  TFTPc_CFG_TRACE_RING_EN
+#define  TFTPc_CFG_TRACE_RING_EN                     DEF_DISABLED
+#endif
+                                                                /* DEF_DISABLED     Trace ring DISABLED                 */
+                                                                /* DEF_ENABLED      Trace ring ENABLED                  */
+
+#ifndef  TFTPc_CFG_TRACE_RING_NBR_EVENT
+#define  TFTPc_CFG_TRACE_RING_NBR_EVENT                   64u   /* Configure nbr of events in ring (see Note #3).       */
+#endif
+
+                                                                /* Configure dflt trace lvl mask   (see Note #4).       */
+#ifndef  TFTPc_CFG_TRACE_RING_LVL_DFLT
+#define  TFTPc_CFG_TRACE_RING_LVL_DFLT              (TFTPc_TRACE_LVL_ERR   | \
+                                                     TFTPc_TRACE_LVL_STATE | \
+                                                     TFTPc_TRACE_LVL_RETRY)
+#endif
+
+
+#endif
@@ -0,0 +1,114 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                HOST PORT : NETWORK FILE SYSTEM INTERFACE
+*
+* Filename : net_fs.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Files are accessed through stdio streams (see 'Port/net_fs_host.c'); names are host paths.
+*
+*            (2) NET_FS_FILE_MODE_CREATE truncates an existing file, as the uC/FS port does.
+*
+*            (3) The position MAY be set beyond the end of file; octets never written read as zero.
+*
+*            (4) NetFS_FileRd() returns DEF_OK with '*p_size_rd' of 0 at the end of file, & DEF_FAIL on error.
+*********************************************************************************************************
+*/
+
+#ifndef  NET_FS_MODULE_PRESENT
+#define  NET_FS_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  NET_FS_SEEK_ORIGIN_START                          1u
+#define  NET_FS_SEEK_ORIGIN_CUR                            2u
+#define  NET_FS_SEEK_ORIGIN_END                            3u
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  enum  net_fs_file_mode {
+    NET_FS_FILE_MODE_NONE,
+    NET_FS_FILE_MODE_APPEND,
+    NET_FS_FILE_MODE_CREATE,                                    /* See Note #2.                                         */
+    NET_FS_FILE_MODE_CREATE_NEW,
+    NET_FS_FILE_MODE_OPEN,
+    NET_FS_FILE_MODE_TRUNCATE
+} NET_FS_FILE_MODE;
+
+typedef  enum  net_fs_file_access {
+    NET_FS_FILE_ACCESS_RD,
+    NET_FS_FILE_ACCESS_RD_WR,
+    NET_FS_FILE_ACCESS_WR
+} NET_FS_FILE_ACCESS;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         *NetFS_FileOpen   (CPU_CHAR            *p_name,
+                                NET_FS_FILE_MODE     mode,
+                                NET_FS_FILE_ACCESS   access);
+
+void          NetFS_FileClose  (void                *p_file);
+
+CPU_BOOLEAN   NetFS_FileRd     (void                *p_file,        /* See Note #4.                                         */
+                                void                *p_dest,
+                                CPU_SIZE_T           size,
+                                CPU_SIZE_T          *p_size_rd);
+
+CPU_BOOLEAN   NetFS_FileWr     (void                *p_file,
+                                void                *p_src,
+                                CPU_SIZE_T           size,
+                                CPU_SIZE_T          *p_size_wr);
+
+CPU_BOOLEAN   NetFS_FilePosSet (void                *p_file,        /* See Note #3.                                         */
+                                CPU_INT32S           offset,
+                                CPU_INT08U           origin);
+
+CPU_BOOLEAN   NetFS_FilePosGet (void                *p_file,
+                                CPU_INT32U          *p_pos);
+
+CPU_BOOLEAN   NetFS_FileSizeGet(void                *p_file,
+                                CPU_INT32U          *p_size);
+
+CPU_BOOLEAN   NetFS_EntryCreate(CPU_CHAR            *p_name,
+                                CPU_BOOLEAN          dir);
+
+CPU_BOOLEAN   NetFS_EntryDel   (CPU_CHAR            *p_name,
+                                CPU_BOOLEAN          file);
+
+
+#endif
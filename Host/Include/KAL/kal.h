@@ -0,0 +1,112 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                HOST PORT : KERNEL ABSTRACTION LAYER SUBSET
+*
+* Filename : kal.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Locks are recursive pthread mutexes, like the kernel mutexes KAL locks are built on.
+*
+*            (2) KAL_Dly() & KAL_TickGet() are provided by the time source linked with the application :
+*                the host clock (see 'Port/host_time.c') or a simulated clock.  The tick rate is 1000 Hz.
+*********************************************************************************************************
+*/
+
+#ifndef  KAL_MODULE_PRESENT
+#define  KAL_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  KAL_OPT_CREATE_NONE                               0u
+
+#define  KAL_OPT_PEND_NONE                        DEF_BIT_NONE
+#define  KAL_OPT_PEND_BLOCKING                    DEF_BIT_NONE
+#define  KAL_OPT_PEND_NON_BLOCKING                  DEF_BIT_00
+
+#define  KAL_OPT_POST_NONE                        DEF_BIT_NONE
+
+#define  KAL_TIMEOUT_INFINITE                              0u
+
+#define  KAL_TICK_RATE_HZ                               1000u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT32U  KAL_OPT;
+typedef  CPU_INT32U  KAL_TICK;
+
+typedef  enum  kal_err {
+    KAL_ERR_NONE,
+    KAL_ERR_NULL_PTR,
+    KAL_ERR_MEM_ALLOC,
+    KAL_ERR_CREATE,
+    KAL_ERR_TIMEOUT,
+    KAL_ERR_WOULD_BLOCK,
+    KAL_ERR_OS
+} KAL_ERR;
+
+typedef  struct  kal_lock_ext_cfg {
+    KAL_OPT  Opt;
+} KAL_LOCK_EXT_CFG;
+
+typedef  struct  kal_lock_handle {
+    void  *LockObjPtr;
+} KAL_LOCK_HANDLE;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+KAL_LOCK_HANDLE  KAL_LockCreate (const  CPU_CHAR          *p_name,
+                                        KAL_LOCK_EXT_CFG  *p_cfg,
+                                        KAL_ERR           *p_err);
+
+void             KAL_LockAcquire(       KAL_LOCK_HANDLE    lock_handle,
+                                        KAL_OPT            opt,
+                                        CPU_INT32U         timeout_ms,
+                                        KAL_ERR           *p_err);
+
+void             KAL_LockRelease(       KAL_LOCK_HANDLE    lock_handle,
+                                        KAL_ERR           *p_err);
+
+void             KAL_LockDel    (       KAL_LOCK_HANDLE    lock_handle,
+                                        KAL_ERR           *p_err);
+
+void             KAL_Dly        (       CPU_INT32U         dly_ms);         /* See Note #2.                         */
+
+KAL_TICK         KAL_TickGet    (       KAL_ERR           *p_err);
+
+
+#endif
@@ -0,0 +1,42 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                 HOST PORT : NETWORK STACK MAIN HEADER
+*
+* Filename : net.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The host port provides the subset of the uC/TCP-IP interface used by TFTPc.  Two network
+*                layers implement it, one of which is linked with the application :
+*
+*                (a) 'Port/net_bsd.c'  maps the sockets on the host BSD sockets.
+*                (b) A simulated network, on which the sockets exchange pkts in virtual time.
+*********************************************************************************************************
+*/
+
+#ifndef  NET_MODULE_PRESENT
+#define  NET_MODULE_PRESENT
+
+#include  <Source/net_type.h>
+#include  <Source/net_err.h>
+#include  <Source/net_util.h>
+#include  <Source/net_sock.h>
+
+
+#endif
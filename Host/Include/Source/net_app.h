@@ -0,0 +1,53 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                HOST PORT : NETWORK APPLICATION INTERFACE
+*
+* Filename : net_app.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+#ifndef  NET_APP_MODULE_PRESENT
+#define  NET_APP_MODULE_PRESENT
+
+#include  <Source/net_type.h>
+#include  <Source/net_sock.h>
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*
+* Note(s) : (1) Opens a datagram sock towards the remote host, whose name is either an IP address string or a
+*               hostname resolved by the host resolver.  '*p_is_hostname' returns DEF_YES for a hostname.
+*               Returns the IP family of the remote address, NET_IP_ADDR_FAMILY_NONE on error.
+*********************************************************************************************************
+*/
+
+NET_IP_ADDR_FAMILY  NetApp_ClientDatagramOpenByHostname(NET_SOCK_ID         *p_sock_id,     /* See Note #1.         */
+                                                        CPU_CHAR            *p_remote_host_name,
+                                                        NET_PORT_NBR         remote_port_nbr,
+                                                        NET_IP_ADDR_FAMILY   ip_family,
+                                                        NET_SOCK_ADDR       *p_sock_addr,
+                                                        CPU_BOOLEAN         *p_is_hostname,
+                                                        NET_ERR             *p_err);
+
+
+#endif
@@ -0,0 +1,44 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : NETWORK ASCII LIBRARY
+*
+* Filename : net_ascii.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+#ifndef  NET_ASCII_MODULE_PRESENT
+#define  NET_ASCII_MODULE_PRESENT
+
+#include  <Source/net_type.h>
+#include  <Source/net_err.h>
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+NET_IPv4_ADDR  NetASCII_Str_to_IPv4(CPU_CHAR  *p_addr_ip_ascii,     /* Rtns addr in host order.                         */
+                                    NET_ERR   *p_err);
+
+
+#endif
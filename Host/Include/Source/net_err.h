@@ -0,0 +1,71 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : NETWORK ERROR CODES
+*
+* Filename : net_err.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+#ifndef  NET_ERR_MODULE_PRESENT
+#define  NET_ERR_MODULE_PRESENT
+
+
+typedef  enum  net_err {
+    NET_ERR_NONE,
+
+    NET_ERR_FAULT_NULL_PTR,
+    NET_ERR_FAULT_MEM_ALLOC,
+    NET_ERR_FAULT_NOT_SUPPORTED,
+    NET_ERR_INVALID_ARG,
+    NET_ERR_RX,
+    NET_ERR_TX,
+
+    NET_SOCK_ERR_NONE,
+    NET_SOCK_ERR_NONE_AVAIL,                                    /* No sock avail.                                       */
+    NET_SOCK_ERR_INVALID_SOCK,
+    NET_SOCK_ERR_INVALID_FAMILY,
+    NET_SOCK_ERR_INVALID_ADDR,
+    NET_SOCK_ERR_INVALID_ADDR_LEN,
+    NET_SOCK_ERR_ADDR_IN_USE,
+    NET_SOCK_ERR_RX_Q_EMPTY,                                    /* Rx timeout, no pkt rx'd.                             */
+    NET_SOCK_ERR_RX_Q_CLOSED,
+    NET_SOCK_ERR_TIMEOUT,
+    NET_SOCK_ERR_CONN_FAIL,
+
+    NET_APP_ERR_NONE,
+    NET_APP_ERR_INVALID_ARG,
+    NET_APP_ERR_NONE_AVAIL,
+    NET_APP_ERR_FAULT,
+
+    NET_ASCII_ERR_NONE,
+    NET_ASCII_ERR_INVALID_STR_LEN,
+    NET_ASCII_ERR_INVALID_CHAR,
+
+    NET_IF_ERR_NONE,
+    NET_IF_ERR_INVALID_IF,
+
+    NET_IGMP_ERR_NONE,
+    NET_IGMP_ERR_HOST_GRP_NONE_AVAIL,
+    NET_IGMP_ERR_HOST_GRP_NOT_FOUND
+} NET_ERR;
+
+
+#endif
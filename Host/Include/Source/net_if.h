@@ -0,0 +1,66 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST PORT : NETWORK INTERFACE LAYER
+*
+* Filename : net_if.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The host port exposes a single interface, whose MTU & hardware address are configurable (see
+*                the network layer linked with the application).
+*********************************************************************************************************
+*/
+
+#ifndef  NET_IF_MODULE_PRESENT
+#define  NET_IF_MODULE_PRESENT
+
+#include  <Source/net_type.h>
+#include  <Source/net_err.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  NET_IF_NBR_NONE                                 255u
+#define  NET_IF_NBR_DFLT                                   1u   /* See Note #1.                                         */
+
+#define  NET_IF_HW_ADDR_LEN_MAX                            6u
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+NET_IF_NBR  NetIF_GetDflt   (void);
+
+NET_MTU     NetIF_MTU_Get   (NET_IF_NBR   if_nbr,
+                             NET_ERR     *p_err);
+
+void        NetIF_AddrHW_Get(NET_IF_NBR   if_nbr,
+                             CPU_INT08U  *p_addr_hw,
+                             CPU_INT08U  *p_addr_len,
+                             NET_ERR     *p_err);
+
+
+#endif
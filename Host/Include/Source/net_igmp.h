@@ -0,0 +1,51 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                HOST PORT : INTERNET GROUP MANAGEMENT PROTOCOL
+*
+* Filename : net_igmp.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Group addresses are in host order, as in uC/TCP-IP.
+*********************************************************************************************************
+*/
+
+#ifndef  NET_IGMP_MODULE_PRESENT
+#define  NET_IGMP_MODULE_PRESENT
+
+#include  <Source/net_type.h>
+#include  <Source/net_err.h>
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetIGMP_HostGrpJoin (NET_IF_NBR      if_nbr,       /* See Note #1.                                         */
+                                  NET_IPv4_ADDR   addr_grp,
+                                  NET_ERR        *p_err);
+
+CPU_BOOLEAN  NetIGMP_HostGrpLeave(NET_IF_NBR      if_nbr,
+                                  NET_IPv4_ADDR   addr_grp,
+                                  NET_ERR        *p_err);
+
+
+#endif
@@ -0,0 +1,219 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : NETWORK SOCKET LAYER
+*
+* Filename : net_sock.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Only datagram sockets are provided.  Socket addresses have the uC/TCP-IP layout : the port
+*                & IPv4 address are stored in network order.
+*
+*            (2) The rx timeout configured with NetSock_CfgTimeoutRxQ_Set() applies to NetSock_RxDataFrom() on
+*                a blocking socket.  NET_SOCK_TIMEOUT_INFINITE (0) waits forever.  On timeout,
+*                NET_SOCK_ERR_RX_Q_EMPTY is returned.
+*********************************************************************************************************
+*/
+
+#ifndef  NET_SOCK_MODULE_PRESENT
+#define  NET_SOCK_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+#include  <lib_mem.h>
+#include  <Source/net_type.h>
+#include  <Source/net_err.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  NET_SOCK_ID_NONE                                 -1
+
+#define  NET_SOCK_BSD_ERR_NONE                             0
+#define  NET_SOCK_BSD_ERR_DFLT                            -1
+#define  NET_SOCK_BSD_ERR_OPEN                            -1
+#define  NET_SOCK_BSD_ERR_CLOSE                           -1
+#define  NET_SOCK_BSD_ERR_BIND                            -1
+#define  NET_SOCK_BSD_ERR_CONN                            -1
+#define  NET_SOCK_BSD_ERR_RX                              -1
+#define  NET_SOCK_BSD_ERR_TX                              -1
+#define  NET_SOCK_BSD_ERR_SEL                             -1
+#define  NET_SOCK_BSD_RTN_CODE_CONN_CLOSED                 0
+
+#define  NET_SOCK_ADDR_FAMILY_IP_V4                        2u
+#define  NET_SOCK_ADDR_FAMILY_IP_V6                       10u
+
+#define  NET_SOCK_PROTOCOL_FAMILY_IP_V4                    2
+#define  NET_SOCK_PROTOCOL_FAMILY_IP_V6                   10
+
+#define  NET_SOCK_TYPE_DATAGRAM                            2
+#define  NET_SOCK_PROTOCOL_UDP                            17
+
+#define  NET_SOCK_ADDR_IP_V4_WILDCARD                      0u
+
+#define  NET_SOCK_FLAG_NONE                       DEF_BIT_NONE
+#define  NET_SOCK_FLAG_RX_DATA_PEEK                 DEF_BIT_01
+#define  NET_SOCK_FLAG_RX_NO_BLOCK                  DEF_BIT_07
+#define  NET_SOCK_FLAG_TX_NO_BLOCK                  DEF_BIT_07
+
+#define  NET_SOCK_BLOCK_SEL_DFLT                           0u
+#define  NET_SOCK_BLOCK_SEL_BLOCK                          1u
+#define  NET_SOCK_BLOCK_SEL_NO_BLOCK                       2u
+
+#define  NET_SOCK_TIMEOUT_INFINITE                         0u   /* See Note #2.                                         */
+
+#define  NET_SOCK_BSD_ADDR_LEN_MAX                        26u
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT16S  NET_SOCK_ID;
+typedef  CPU_INT32S  NET_SOCK_RTN_CODE;
+typedef  CPU_INT32S  NET_SOCK_ADDR_LEN;
+typedef  CPU_INT16U  NET_SOCK_ADDR_FAMILY;
+typedef  CPU_INT16S  NET_SOCK_PROTOCOL_FAMILY;
+typedef  CPU_INT16S  NET_SOCK_TYPE;
+typedef  CPU_INT16S  NET_SOCK_PROTOCOL;
+typedef  CPU_INT16U  NET_SOCK_QTY;
+
+typedef  struct  net_sock_addr {                                /* Generic sock addr.                                   */
+    NET_SOCK_ADDR_FAMILY  AddrFamily;
+    CPU_INT08U            Addr[NET_SOCK_BSD_ADDR_LEN_MAX];
+} NET_SOCK_ADDR;
+
+typedef  struct  net_sock_addr_ipv4 {                           /* IPv4 sock addr (see Note #1).                        */
+    NET_SOCK_ADDR_FAMILY  AddrFamily;
+    NET_PORT_NBR          Port;
+    NET_IPv4_ADDR         Addr;
+    CPU_INT08U            Unused[8];
+} NET_SOCK_ADDR_IPv4;
+
+typedef  struct  net_sock_addr_ipv6 {                           /* IPv6 sock addr (see Note #1).                        */
+    NET_SOCK_ADDR_FAMILY  AddrFamily;
+    NET_PORT_NBR          Port;
+    CPU_INT32U            FlowInfo;
+    NET_IPv6_ADDR         Addr;
+    CPU_INT32U            ScopeID;
+} NET_SOCK_ADDR_IPv6;
+
+typedef  struct  net_sock_timeout {
+    CPU_INT32U  timeout_sec;
+    CPU_INT32U  timeout_us;
+} NET_SOCK_TIMEOUT;
+
+#define  NET_SOCK_DESC_NBR_WORDS             ((NET_SOCK_CFG_NBR_SOCK + 31u) / 32u)
+
+typedef  struct  net_sock_desc {
+    CPU_INT32U  SockID_DescNbrSet[NET_SOCK_DESC_NBR_WORDS];
+} NET_SOCK_DESC;
+
+
+/*
+*********************************************************************************************************
+*                                       SOCKET DESCRIPTOR MACRO'S
+*********************************************************************************************************
+*/
+
+#define  NET_SOCK_DESC_INIT(p_desc)             Mem_Clr((void *)(p_desc), sizeof(NET_SOCK_DESC))
+
+#define  NET_SOCK_DESC_SET(desc_nbr, p_desc)    ((p_desc)->SockID_DescNbrSet[(desc_nbr) / 32u] |=  (1u << ((desc_nbr) % 32u)))
+
+#define  NET_SOCK_DESC_CLR(desc_nbr, p_desc)    ((p_desc)->SockID_DescNbrSet[(desc_nbr) / 32u] &= ~(1u << ((desc_nbr) % 32u)))
+
+#define  NET_SOCK_DESC_IS_SET(desc_nbr, p_desc) ((((p_desc)->SockID_DescNbrSet[(desc_nbr) / 32u] >> ((desc_nbr) % 32u)) & 1u) \
+                                                 ? DEF_YES : DEF_NO)
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+NET_SOCK_ID        NetSock_Open                (NET_SOCK_PROTOCOL_FAMILY   protocol_family,
+                                                NET_SOCK_TYPE              sock_type,
+                                                NET_SOCK_PROTOCOL          protocol,
+                                                NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_Close               (NET_SOCK_ID                sock_id,
+                                                NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_Bind                (NET_SOCK_ID                sock_id,
+                                                NET_SOCK_ADDR             *p_addr_local,
+                                                NET_SOCK_ADDR_LEN          addr_len,
+                                                NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_Conn                (NET_SOCK_ID                sock_id,
+                                                NET_SOCK_ADDR             *p_addr_remote,
+                                                NET_SOCK_ADDR_LEN          addr_len,
+                                                NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_RxDataFrom          (NET_SOCK_ID                sock_id,
+                                                void                      *p_data_buf,
+                                                CPU_INT16U                 data_buf_len,
+                                                CPU_INT16S                 flags,
+                                                NET_SOCK_ADDR             *p_addr_remote,
+                                                NET_SOCK_ADDR_LEN         *p_addr_len,
+                                                void                      *p_ip_opts_buf,
+                                                CPU_INT08U                 ip_opts_buf_len,
+                                                CPU_INT08U                *p_ip_opts_len,
+                                                NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_TxDataTo            (NET_SOCK_ID                sock_id,
+                                                void                      *p_data,
+                                                CPU_INT16U                 data_len,
+                                                CPU_INT16S                 flags,
+                                                NET_SOCK_ADDR             *p_addr_remote,
+                                                NET_SOCK_ADDR_LEN          addr_len,
+                                                NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_TxData              (NET_SOCK_ID                sock_id,
+                                                void                      *p_data,
+                                                CPU_INT16U                 data_len,
+                                                CPU_INT16S                 flags,
+                                                NET_ERR                   *p_err);
+
+NET_SOCK_RTN_CODE  NetSock_Sel                 (NET_SOCK_QTY               sock_nbr_max,
+                                                NET_SOCK_DESC             *p_sock_desc_rd,
+                                                NET_SOCK_DESC             *p_sock_desc_wr,
+                                                NET_SOCK_DESC             *p_sock_desc_err,
+                                                NET_SOCK_TIMEOUT          *p_timeout,
+                                                NET_ERR                   *p_err);
+
+CPU_BOOLEAN        NetSock_CfgBlock            (NET_SOCK_ID                sock_id,
+                                                CPU_INT08U                 block,
+                                                NET_ERR                   *p_err);
+
+CPU_BOOLEAN        NetSock_CfgTimeoutRxQ_Set   (NET_SOCK_ID                sock_id,   /* See Note #2.               */
+                                                CPU_INT32U                 timeout_ms,
+                                                NET_ERR                   *p_err);
+
+CPU_INT32U         NetSock_CfgTimeoutRxQ_Get_ms(NET_SOCK_ID                sock_id,
+                                                NET_ERR                   *p_err);
+
+
+#endif
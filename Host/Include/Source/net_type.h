@@ -0,0 +1,74 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : NETWORK DATA TYPES
+*
+* Filename : net_type.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+#ifndef  NET_TYPE_MODULE_PRESENT
+#define  NET_TYPE_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                     NETWORK MODULE CONFIGURATION
+*********************************************************************************************************
+*/
+
+#define  NET_IPv4_MODULE_EN
+#define  NET_IPv6_MODULE_EN
+#define  NET_IGMP_MODULE_EN
+
+#define  NET_SOCK_CFG_NBR_SOCK                            64u   /* Max nbr of socks open at once.                       */
+#define  NET_SOCK_CFG_SEL_EN                         DEF_ENABLED
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT16U  NET_PORT_NBR;
+typedef  CPU_INT32U  NET_TS_MS;
+typedef  CPU_INT32U  NET_MTU;
+typedef  CPU_INT08U  NET_IF_NBR;
+
+typedef  CPU_INT32U  NET_IPv4_ADDR;                             /* IPv4 addr, in host order.                            */
+
+typedef  CPU_INT08U  NET_IP_ADDR_FAMILY;
+
+#define  NET_IP_ADDR_FAMILY_NONE                           0u
+#define  NET_IP_ADDR_FAMILY_IPv4                           1u
+#define  NET_IP_ADDR_FAMILY_IPv6                           2u
+
+#define  NET_IPv6_ADDR_LEN                                16u
+
+typedef  struct  net_ipv6_addr {
+    CPU_INT08U  Addr[NET_IPv6_ADDR_LEN];
+} NET_IPv6_ADDR;
+
+
+#endif
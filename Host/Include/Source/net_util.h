@@ -0,0 +1,79 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : NETWORK UTILITY LIBRARY
+*
+* Filename : net_util.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) NetUtil_TS_Get_ms() is provided by the time source linked with the application (see
+*                'KAL/kal.h  Note #2').
+*********************************************************************************************************
+*/
+
+#ifndef  NET_UTIL_MODULE_PRESENT
+#define  NET_UTIL_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_mem.h>
+#include  <Source/net_type.h>
+
+
+/*
+*********************************************************************************************************
+*                                      NETWORK ORDER MACRO'S
+*********************************************************************************************************
+*/
+
+#define  NET_UTIL_VAL_SWAP_ORDER_16(val)        ((CPU_INT16U)((((CPU_INT16U)(val) & 0xFF00u) >> 8) | \
+                                                              (((CPU_INT16U)(val) & 0x00FFu) << 8)))
+
+#define  NET_UTIL_VAL_SWAP_ORDER_32(val)        ((CPU_INT32U)((((CPU_INT32U)(val) & 0xFF000000u) >> 24) | \
+                                                              (((CPU_INT32U)(val) & 0x00FF0000u) >>  8) | \
+                                                              (((CPU_INT32U)(val) & 0x0000FF00u) <<  8) | \
+                                                              (((CPU_INT32U)(val) & 0x000000FFu) << 24)))
+
+#if     (CPU_CFG_ENDIAN_TYPE == CPU_ENDIAN_TYPE_BIG)
+#define  NET_UTIL_HOST_TO_NET_16(val)           ((CPU_INT16U)(val))
+#define  NET_UTIL_HOST_TO_NET_32(val)           ((CPU_INT32U)(val))
+#else
+#define  NET_UTIL_HOST_TO_NET_16(val)           NET_UTIL_VAL_SWAP_ORDER_16(val)
+#define  NET_UTIL_HOST_TO_NET_32(val)           NET_UTIL_VAL_SWAP_ORDER_32(val)
+#endif
+
+#define  NET_UTIL_NET_TO_HOST_16(val)           NET_UTIL_HOST_TO_NET_16(val)
+#define  NET_UTIL_NET_TO_HOST_32(val)           NET_UTIL_HOST_TO_NET_32(val)
+
+                                                                /* Get/set host-order val from/to net-order octets.     */
+#define  NET_UTIL_VAL_GET_NET_16(addr)          MEM_VAL_GET_INT16U_BIG(addr)
+#define  NET_UTIL_VAL_GET_NET_32(addr)          MEM_VAL_GET_INT32U_BIG(addr)
+#define  NET_UTIL_VAL_SET_NET_16(addr, val)     MEM_VAL_SET_INT16U_BIG((addr), (val))
+#define  NET_UTIL_VAL_SET_NET_32(addr, val)     MEM_VAL_SET_INT32U_BIG((addr), (val))
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+NET_TS_MS  NetUtil_TS_Get_ms(void);                             /* See Note #1.                                         */
+
+
+#endif
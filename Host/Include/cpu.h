@@ -0,0 +1,119 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        HOST PORT : uC/CPU SUBSET
+*
+* Filename : cpu.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Provides the subset of the uC/CPU interface used by TFTPc, for POSIX hosts (see
+*                'Host/readme.md').  The CPU data types are mapped on the C99 fixed-width types.
+*
+*            (2) Critical sections are implemented with a single process-wide mutex (see 'cpu_core.c'), so
+*                that a TFTPc_Cancel() called from another thread is serialized with the transfer.
+*********************************************************************************************************
+*/
+
+#ifndef  CPU_MODULE_PRESENT
+#define  CPU_MODULE_PRESENT
+
+#include  <stddef.h>
+#include  <stdint.h>
+
+
+/*
+*********************************************************************************************************
+*                                          CPU WORD CONFIGURATION
+*********************************************************************************************************
+*/
+
+#define  CPU_WORD_SIZE_08                                  1u
+#define  CPU_WORD_SIZE_16                                  2u
+#define  CPU_WORD_SIZE_32                                  4u
+#define  CPU_WORD_SIZE_64                                  8u
+
+#define  CPU_ENDIAN_TYPE_BIG                               1u
+#define  CPU_ENDIAN_TYPE_LITTLE                            2u
+
+#if     (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__))
+#define  CPU_CFG_ENDIAN_TYPE                 CPU_ENDIAN_TYPE_BIG
+#else
+#define  CPU_CFG_ENDIAN_TYPE                 CPU_ENDIAN_TYPE_LITTLE
+#endif
+
+#define  CPU_CFG_ADDR_SIZE                      CPU_WORD_SIZE_64
+#define  CPU_CFG_DATA_SIZE                      CPU_WORD_SIZE_32
+
+
+/*
+*********************************************************************************************************
+*                                             CPU DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef            void        CPU_VOID;
+typedef            char        CPU_CHAR;
+typedef            uint8_t     CPU_BOOLEAN;
+typedef            uint8_t     CPU_INT08U;
+typedef            int8_t      CPU_INT08S;
+typedef            uint16_t    CPU_INT16U;
+typedef            int16_t     CPU_INT16S;
+typedef            uint32_t    CPU_INT32U;
+typedef            int32_t     CPU_INT32S;
+typedef            uint64_t    CPU_INT64U;
+typedef            int64_t     CPU_INT64S;
+typedef            float       CPU_FP32;
+typedef            double      CPU_FP64;
+
+typedef            size_t      CPU_SIZE_T;
+typedef            uintptr_t   CPU_ADDR;
+typedef            CPU_INT32U  CPU_DATA;
+typedef            CPU_INT32U  CPU_ALIGN;
+
+typedef            CPU_INT32U  CPU_SR;                              /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                         CRITICAL SECTION MACROS
+*
+* Note(s) : (1) See Note #2.
+*********************************************************************************************************
+*/
+
+#define  CPU_SR_ALLOC()                         CPU_SR  cpu_sr = (CPU_SR)0; (void)cpu_sr
+
+#define  CPU_CRITICAL_ENTER()                   CPU_CriticalEnter()
+#define  CPU_CRITICAL_EXIT()                    CPU_CriticalExit()
+
+#define  CPU_SW_EXCEPTION(err_rtn_val)          CPU_SW_Exception()      /* Does NOT return (see 'cpu_core.c').  */
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void  CPU_CriticalEnter(void);
+void  CPU_CriticalExit (void);
+void  CPU_SW_Exception (void) __attribute__((noreturn));
+
+
+#endif
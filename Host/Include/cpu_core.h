@@ -0,0 +1,87 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST PORT : uC/CPU CORE SUBSET
+*
+* Filename : cpu_core.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The CPU timestamp timer is the host monotonic clock, counted in nanoseconds.  The 32-bit
+*                timestamps wrap around every 4.29 seconds, which is enough for the phase profiling & trace
+*                ring timestamps (see 'tftp-c.h  TFTPc PHASE PROFILE DATA TYPES').
+*********************************************************************************************************
+*/
+
+#ifndef  CPU_CORE_MODULE_PRESENT
+#define  CPU_CORE_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  CPU_CFG_TS_EN                               DEF_ENABLED
+#define  CPU_CFG_TS_32_EN                            DEF_ENABLED
+#define  CPU_CFG_TS_64_EN                            DEF_ENABLED
+#define  CPU_CFG_TS_TMR_EN                           DEF_ENABLED
+
+#define  CPU_TS_TMR_FREQ_HZ                           1000000000u   /* See Note #1.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT32U  CPU_TS32;
+typedef  CPU_INT64U  CPU_TS64;
+typedef  CPU_TS32    CPU_TS;
+typedef  CPU_INT32U  CPU_TS_TMR_FREQ;
+
+typedef  enum  cpu_err {
+    CPU_ERR_NONE,
+    CPU_ERR_NULL_PTR,
+    CPU_ERR_TS_FREQ_INVALID
+} CPU_ERR;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_TS32         CPU_TS_Get32     (void);
+
+CPU_TS64         CPU_TS_Get64     (void);
+
+CPU_INT64U       CPU_TS32_to_uSec (CPU_TS32   ts_cnts);
+
+CPU_INT64U       CPU_TS64_to_uSec (CPU_TS64   ts_cnts);
+
+CPU_TS_TMR_FREQ  CPU_TS_TmrFreqGet(CPU_ERR   *p_err);
+
+
+#endif
@@ -0,0 +1,71 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : uC/LIB ASCII SUBSET
+*
+* Filename : lib_ascii.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_ASCII_MODULE_PRESENT
+#define  LIB_ASCII_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                         ASCII CHARACTER DEFINES
+*********************************************************************************************************
+*/
+
+#define  ASCII_CHAR_NULL                                0x00u
+#define  ASCII_CHAR_LINE_FEED                           0x0Au
+#define  ASCII_CHAR_CARRIAGE_RETURN                     0x0Du
+#define  ASCII_CHAR_SPACE                               0x20u
+#define  ASCII_CHAR_COMMA                               0x2Cu
+#define  ASCII_CHAR_HYPHEN_MINUS                        0x2Du
+#define  ASCII_CHAR_FULL_STOP                           0x2Eu
+#define  ASCII_CHAR_SOLIDUS                             0x2Fu
+#define  ASCII_CHAR_DIGIT_ZERO                          0x30u
+#define  ASCII_CHAR_DIGIT_SEVEN                         0x37u
+#define  ASCII_CHAR_DIGIT_NINE                          0x39u
+#define  ASCII_CHAR_COLON                               0x3Au
+#define  ASCII_CHAR_EQUALS_SIGN                         0x3Du
+#define  ASCII_CHAR_REVERSE_SOLIDUS                     0x5Cu
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  ASCII_IsDig  (CPU_CHAR  c);
+
+CPU_BOOLEAN  ASCII_IsSpace(CPU_CHAR  c);
+
+CPU_CHAR     ASCII_ToLower(CPU_CHAR  c);
+
+CPU_CHAR     ASCII_ToUpper(CPU_CHAR  c);
+
+
+#endif
@@ -0,0 +1,142 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST PORT : uC/LIB CORE DEFINES
+*
+* Filename : lib_def.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Subset of the uC/LIB definitions used by TFTPc & the host port.
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_DEF_MODULE_PRESENT
+#define  LIB_DEF_MODULE_PRESENT
+
+#include  <cpu.h>
+
+
+/*
+*********************************************************************************************************
+*                                         STANDARD DEFINES
+*********************************************************************************************************
+*/
+
+#define  DEF_NULL                                 ((void *)0)
+
+#define  DEF_FALSE                                         0u
+#define  DEF_TRUE                                          1u
+
+#define  DEF_NO                                            0u
+#define  DEF_YES                                           1u
+
+#define  DEF_DISABLED                                      0u
+#define  DEF_ENABLED                                       1u
+
+#define  DEF_INACTIVE                                      0u
+#define  DEF_ACTIVE                                        1u
+
+#define  DEF_INVALID                                       0u
+#define  DEF_VALID                                         1u
+
+#define  DEF_OFF                                           0u
+#define  DEF_ON                                            1u
+
+#define  DEF_CLR                                           0u
+#define  DEF_SET                                           1u
+
+#define  DEF_FAIL                                          0u
+#define  DEF_OK                                            1u
+
+
+/*
+*********************************************************************************************************
+*                                       BIT & OCTET DEFINES
+*********************************************************************************************************
+*/
+
+#define  DEF_BIT_NONE                                   0x00u
+
+#define  DEF_BIT_00                                     0x01u
+#define  DEF_BIT_01                                     0x02u
+#define  DEF_BIT_02                                     0x04u
+#define  DEF_BIT_03                                     0x08u
+#define  DEF_BIT_04                                     0x10u
+#define  DEF_BIT_05                                     0x20u
+#define  DEF_BIT_06                                     0x40u
+#define  DEF_BIT_07                                     0x80u
+#define  DEF_BIT_08                                   0x0100u
+#define  DEF_BIT_09                                   0x0200u
+#define  DEF_BIT_10                                   0x0400u
+#define  DEF_BIT_11                                   0x0800u
+#define  DEF_BIT_12                                   0x1000u
+#define  DEF_BIT_13                                   0x2000u
+#define  DEF_BIT_14                                   0x4000u
+#define  DEF_BIT_15                                   0x8000u
+
+#define  DEF_OCTET_NBR_BITS                                8u
+#define  DEF_OCTET_MASK                                 0xFFu
+
+#define  DEF_INT_08_NBR_BITS                               8u
+#define  DEF_INT_16_NBR_BITS                              16u
+#define  DEF_INT_32_NBR_BITS                              32u
+
+#define  DEF_INT_08U_MAX_VAL                             255u
+#define  DEF_INT_16U_MAX_VAL                           65535u
+#define  DEF_INT_32U_MAX_VAL                      4294967295u
+#define  DEF_INT_32S_MAX_VAL                      2147483647
+
+#define  DEF_NBR_BASE_BIN                                  2u
+#define  DEF_NBR_BASE_OCT                                  8u
+#define  DEF_NBR_BASE_DEC                                 10u
+#define  DEF_NBR_BASE_HEX                                 16u
+
+
+/*
+*********************************************************************************************************
+*                                           TIME DEFINES
+*********************************************************************************************************
+*/
+
+#define  DEF_TIME_NBR_mS_PER_SEC                        1000u
+#define  DEF_TIME_NBR_uS_PER_SEC                     1000000u
+#define  DEF_TIME_NBR_nS_PER_SEC                  1000000000u
+
+
+/*
+*********************************************************************************************************
+*                                             MACRO'S
+*********************************************************************************************************
+*/
+
+#define  DEF_BIT(bit)                           (1u << (bit))
+
+#define  DEF_BIT_SET(val, mask)                 ((val) = ((val) |  (mask)))
+#define  DEF_BIT_CLR(val, mask)                 ((val) = ((val) & ~(mask)))
+
+#define  DEF_BIT_IS_SET(val, mask)              (((((val) & (mask)) == (mask)) && ((mask) != 0u)) ? (DEF_YES) : (DEF_NO))
+#define  DEF_BIT_IS_CLR(val, mask)              (((((val) & (mask)) ==  0u   ) && ((mask) != 0u)) ? (DEF_YES) : (DEF_NO))
+#define  DEF_BIT_IS_SET_ANY(val, mask)          ((((val) & (mask)) != 0u) ? (DEF_YES) : (DEF_NO))
+
+#define  DEF_MIN(a, b)                          (((a) < (b)) ? (a) : (b))
+#define  DEF_MAX(a, b)                          (((a) > (b)) ? (a) : (b))
+#define  DEF_ABS(a)                             (((a) <  0 ) ? (-(a)) : (a))
+
+
+#endif
@@ -0,0 +1,105 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : uC/LIB MEMORY SUBSET
+*
+* Filename : lib_mem.h
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_MEM_MODULE_PRESENT
+#define  LIB_MEM_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                     MEMORY DATA VALUE MACRO'S
+*
+* Note(s) : (1) Octets are accessed one at a time, so that the address does NOT need to be aligned.
+*********************************************************************************************************
+*/
+
+#define  MEM_VAL_GET_INT08U(addr)               ((CPU_INT08U)(((const CPU_INT08U *)(addr))[0]))
+
+#define  MEM_VAL_GET_INT16U_BIG(addr)           ((CPU_INT16U)((((CPU_INT16U)((const CPU_INT08U *)(addr))[0]) << 8) | \
+                                                               ((CPU_INT16U)((const CPU_INT08U *)(addr))[1])))
+
+#define  MEM_VAL_GET_INT32U_BIG(addr)           ((CPU_INT32U)((((CPU_INT32U)((const CPU_INT08U *)(addr))[0]) << 24) | \
+                                                              (((CPU_INT32U)((const CPU_INT08U *)(addr))[1]) << 16) | \
+                                                              (((CPU_INT32U)((const CPU_INT08U *)(addr))[2]) <<  8) | \
+                                                               ((CPU_INT32U)((const CPU_INT08U *)(addr))[3])))
+
+#define  MEM_VAL_GET_INT16U_LITTLE(addr)        ((CPU_INT16U)((((CPU_INT16U)((const CPU_INT08U *)(addr))[1]) << 8) | \
+                                                               ((CPU_INT16U)((const CPU_INT08U *)(addr))[0])))
+
+#define  MEM_VAL_GET_INT32U_LITTLE(addr)        ((CPU_INT32U)((((CPU_INT32U)((const CPU_INT08U *)(addr))[3]) << 24) | \
+                                                              (((CPU_INT32U)((const CPU_INT08U *)(addr))[2]) << 16) | \
+                                                              (((CPU_INT32U)((const CPU_INT08U *)(addr))[1]) <<  8) | \
+                                                               ((CPU_INT32U)((const CPU_INT08U *)(addr))[0])))
+
+#define  MEM_VAL_SET_INT08U(addr, val)          do { ((CPU_INT08U *)(addr))[0] = (CPU_INT08U)(val); } while (0)
+
+#define  MEM_VAL_SET_INT16U_BIG(addr, val)      do { ((CPU_INT08U *)(addr))[0] = (CPU_INT08U)((CPU_INT16U)(val) >> 8); \
+                                                     ((CPU_INT08U *)(addr))[1] = (CPU_INT08U)((CPU_INT16U)(val)     ); } while (0)
+
+#define  MEM_VAL_SET_INT32U_BIG(addr, val)      do { ((CPU_INT08U *)(addr))[0] = (CPU_INT08U)((CPU_INT32U)(val) >> 24); \
+                                                     ((CPU_INT08U *)(addr))[1] = (CPU_INT08U)((CPU_INT32U)(val) >> 16); \
+                                                     ((CPU_INT08U *)(addr))[2] = (CPU_INT08U)((CPU_INT32U)(val) >>  8); \
+                                                     ((CPU_INT08U *)(addr))[3] = (CPU_INT08U)((CPU_INT32U)(val)      ); } while (0)
+
+#define  MEM_VAL_SET_INT16U_LITTLE(addr, val)   do { ((CPU_INT08U *)(addr))[1] = (CPU_INT08U)((CPU_INT16U)(val) >> 8); \
+                                                     ((CPU_INT08U *)(addr))[0] = (CPU_INT08U)((CPU_INT16U)(val)     ); } while (0)
+
+#define  MEM_VAL_SET_INT32U_LITTLE(addr, val)   do { ((CPU_INT08U *)(addr))[3] = (CPU_INT08U)((CPU_INT32U)(val) >> 24); \
+                                                     ((CPU_INT08U *)(addr))[2] = (CPU_INT08U)((CPU_INT32U)(val) >> 16); \
+                                                     ((CPU_INT08U *)(addr))[1] = (CPU_INT08U)((CPU_INT32U)(val) >>  8); \
+                                                     ((CPU_INT08U *)(addr))[0] = (CPU_INT08U)((CPU_INT32U)(val)      ); } while (0)
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void         Mem_Clr (       void        *p_mem,
+                             CPU_SIZE_T   size);
+
+void         Mem_Set (       void        *p_mem,
+                             CPU_INT08U   data_val,
+                             CPU_SIZE_T   size);
+
+void         Mem_Copy(       void        *p_dest,
+                      const  void        *p_src,
+                             CPU_SIZE_T   size);
+
+void         Mem_Move(       void        *p_dest,
+                      const  void        *p_src,
+                             CPU_SIZE_T   size);
+
+CPU_BOOLEAN  Mem_Cmp (const  void        *p1_mem,
+                      const  void        *p2_mem,
+                             CPU_SIZE_T   size);
+
+
+#endif
@@ -0,0 +1,99 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : uC/LIB STRING SUBSET
+*
+* Filename : lib_str.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The functions follow the uC/LIB semantics, which differ from the C library on NULL pointers :
+*                a NULL string is handled as an error (NULL or zero returned) instead of faulting.
+*
+*            (2) Str_FmtNbr_Int32U() formats the number right-justified on 'nbr_dig' characters, padded with
+*                'lead_char'.  When 'lead_char' is the NULL character, the number is NOT padded : the string
+*                holds the significant digits only.
+*********************************************************************************************************
+*/
+
+#ifndef  LIB_STR_MODULE_PRESENT
+#define  LIB_STR_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+#include  <lib_ascii.h>
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T   Str_Len             (const  CPU_CHAR     *p_str);
+
+CPU_SIZE_T   Str_Len_N           (const  CPU_CHAR     *p_str,
+                                         CPU_SIZE_T    len_max);
+
+CPU_CHAR    *Str_Copy            (       CPU_CHAR     *p_str_dest,
+                                  const  CPU_CHAR     *p_str_src);
+
+CPU_CHAR    *Str_Copy_N          (       CPU_CHAR     *p_str_dest,
+                                  const  CPU_CHAR     *p_str_src,
+                                         CPU_SIZE_T    len_max);
+
+CPU_CHAR    *Str_Cat             (       CPU_CHAR     *p_str_dest,
+                                  const  CPU_CHAR     *p_str_cat);
+
+CPU_CHAR    *Str_Cat_N           (       CPU_CHAR     *p_str_dest,
+                                  const  CPU_CHAR     *p_str_cat,
+                                         CPU_SIZE_T    len_max);
+
+CPU_INT16S   Str_Cmp             (const  CPU_CHAR     *p1_str,
+                                  const  CPU_CHAR     *p2_str);
+
+CPU_INT16S   Str_Cmp_N           (const  CPU_CHAR     *p1_str,
+                                  const  CPU_CHAR     *p2_str,
+                                         CPU_SIZE_T    len_max);
+
+CPU_INT16S   Str_CmpIgnoreCase   (const  CPU_CHAR     *p1_str,
+                                  const  CPU_CHAR     *p2_str);
+
+CPU_CHAR    *Str_Char            (const  CPU_CHAR     *p_str,
+                                         CPU_CHAR      srch_char);
+
+CPU_CHAR    *Str_Char_Last       (const  CPU_CHAR     *p_str,
+                                         CPU_CHAR      srch_char);
+
+CPU_CHAR    *Str_Str             (const  CPU_CHAR     *p_str,
+                                  const  CPU_CHAR     *p_str_srch);
+
+CPU_CHAR    *Str_FmtNbr_Int32U   (       CPU_INT32U    nbr,     /* See Note #2.                                         */
+                                         CPU_INT08U    nbr_dig,
+                                         CPU_INT08U    nbr_base,
+                                         CPU_CHAR      lead_char,
+                                         CPU_BOOLEAN   lower_case,
+                                         CPU_BOOLEAN   nul,
+                                         CPU_CHAR     *p_str);
+
+CPU_INT32U   Str_ParseNbr_Int32U (const  CPU_CHAR     *p_str,
+                                         CPU_CHAR    **p_str_next,
+                                         CPU_INT08U    nbr_base);
+
+
+#endif
@@ -0,0 +1,184 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST PORT : uC/CPU CORE SUBSET
+*
+* Filename : cpu_core.c
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <pthread.h>
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  pthread_once_t   CPU_CriticalOnce = PTHREAD_ONCE_INIT;
+static  pthread_mutex_t  CPU_CriticalMutex;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  void  CPU_CriticalInit (void)
+{
+    pthread_mutexattr_t  attr;
+
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&CPU_CriticalMutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                 CPU_CriticalEnter() / CPU_CriticalExit()
+*
+* Description : Enter/exit a critical section.
+*
+* Note(s)     : (1) See 'cpu.h  Note #2'.  The mutex is recursive, so that critical sections MAY nest.
+*********************************************************************************************************
+*/
+
+void  CPU_CriticalEnter (void)
+{
+    pthread_once(&CPU_CriticalOnce, CPU_CriticalInit);
+    pthread_mutex_lock(&CPU_CriticalMutex);
+}
+
+
+void  CPU_CriticalExit (void)
+{
+    pthread_mutex_unlock(&CPU_CriticalMutex);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          CPU_SW_Exception()
+*
+* Description : Trap an invalid argument or an unexpected state, as CPU_SW_EXCEPTION() does on target.
+*********************************************************************************************************
+*/
+
+void  CPU_SW_Exception (void)
+{
+    fprintf(stderr, "CPU_SW_EXCEPTION\n");
+    abort();
+}
+
+
+/*
+*********************************************************************************************************
+*                                    CPU_TS_Get32() / CPU_TS_Get64()
+*
+* Description : Get the current CPU timestamp (see 'cpu_core.h  Note #1').
+*********************************************************************************************************
+*/
+
+CPU_TS64  CPU_TS_Get64 (void)
+{
+    struct  timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((CPU_TS64)ts.tv_sec * DEF_TIME_NBR_nS_PER_SEC + (CPU_TS64)ts.tv_nsec);
+}
+
+
+CPU_TS32  CPU_TS_Get32 (void)
+{
+    return ((CPU_TS32)CPU_TS_Get64());
+}
+
+
+/*
+*********************************************************************************************************
+*                                 CPU_TS32_to_uSec() / CPU_TS64_to_uSec()
+*
+* Description : Convert CPU timestamp counts to microseconds.
+*********************************************************************************************************
+*/
+
+CPU_INT64U  CPU_TS32_to_uSec (CPU_TS32  ts_cnts)
+{
+    return ((CPU_INT64U)ts_cnts / (CPU_TS_TMR_FREQ_HZ / DEF_TIME_NBR_uS_PER_SEC));
+}
+
+
+CPU_INT64U  CPU_TS64_to_uSec (CPU_TS64  ts_cnts)
+{
+    return ((CPU_INT64U)ts_cnts / (CPU_TS_TMR_FREQ_HZ / DEF_TIME_NBR_uS_PER_SEC));
+}
+
+
+/*
+*********************************************************************************************************
+*                                         CPU_TS_TmrFreqGet()
+*
+* Description : Get the CPU timestamp timer frequency, in Hz.
+*********************************************************************************************************
+*/
+
+CPU_TS_TMR_FREQ  CPU_TS_TmrFreqGet (CPU_ERR  *p_err)
+{
+    if (p_err != DEF_NULL) {
+       *p_err = CPU_ERR_NONE;
+    }
+
+    return (CPU_TS_TMR_FREQ_HZ);
+}
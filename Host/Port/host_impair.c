@@ -0,0 +1,221 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST PORT : NETWORK IMPAIRMENT MODEL
+*
+* Filename : host_impair.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) See 'host_impair.h'.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "host_impair.h"
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U   HostImpair_RandGet (HOST_IMPAIR  *p_impair);
+
+static  CPU_BOOLEAN  HostImpair_EventGet(HOST_IMPAIR  *p_impair,
+                                         CPU_INT16U    rate);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          HostImpair_Init()
+*
+* Description : Initialize an impaired link.
+*
+* Argument(s) : p_impair    Pointer to link.
+*
+*               p_cfg       Pointer to impairment configuration.
+*
+* Return(s)   : DEF_OK,   if the link was initialized.
+*
+*               DEF_FAIL, if a rate is greater than HOST_IMPAIR_RATE_SCALE.
+*
+* Note(s)     : (1) The link is idle & its pseudo-random generator is seeded with 'Seed'.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostImpair_Init (       HOST_IMPAIR      *p_impair,
+                              const  HOST_IMPAIR_CFG  *p_cfg)
+{
+    if ((p_cfg->LossRate    > HOST_IMPAIR_RATE_SCALE) ||
+        (p_cfg->DupRate     > HOST_IMPAIR_RATE_SCALE) ||
+        (p_cfg->ReorderRate > HOST_IMPAIR_RATE_SCALE)) {
+        return (DEF_FAIL);
+    }
+
+    p_impair->Cfg         = *p_cfg;
+    p_impair->RandState   =  p_cfg->Seed;                       /* See Note #1.                                         */
+    if (p_impair->RandState == 0u) {                            /* A zero state would stay zero.                        */
+        p_impair->RandState  = 1u;
+    }
+    p_impair->LinkFree_us = 0u;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostImpair_Tx()
+*
+* Description : Compute the fate of a packet sent on an impaired link (see 'host_impair.h  Note #1').
+*
+* Argument(s) : p_impair    Pointer to link.
+*
+*               ts_us       Time at which the packet is sent, in microseconds.
+*
+*               len         Packet length, in octets, headers excluded.
+*
+*               p_pkt       Pointer to variable that will receive the delivery time of the packet, if
+*                           delivered.
+*
+* Return(s)   : HOST_IMPAIR_PKT_DELIVER,    if the packet is delivered.
+*
+*               HOST_IMPAIR_PKT_LOSS,       if the packet is lost.
+*
+*               HOST_IMPAIR_PKT_QUEUE_DROP, if the packet is tail-dropped.
+*
+* Note(s)     : (1) No value is drawn for an impairment that is not used, so that adding an impairment to
+*                   a scenario does not change the draws of the others.
+*********************************************************************************************************
+*/
+
+CPU_INT08U  HostImpair_Tx (HOST_IMPAIR      *p_impair,
+                           CPU_INT64U        ts_us,
+                           CPU_INT32U        len,
+                           HOST_IMPAIR_PKT  *p_pkt)
+{
+    HOST_IMPAIR_CFG  *p_cfg;
+
+
+    p_cfg = &p_impair->Cfg;
+    Mem_Clr(p_pkt, sizeof(HOST_IMPAIR_PKT));
+                                                                /* -------------------- RATE LIMIT -------------------- */
+    if (p_cfg->Rate_bps > 0u) {
+        if (p_impair->LinkFree_us > ts_us) {
+            if ((p_cfg->QueueDlyMax_us         > 0u) &&
+                (p_impair->LinkFree_us - ts_us > p_cfg->QueueDlyMax_us)) {
+                return (HOST_IMPAIR_PKT_QUEUE_DROP);
+            }
+            ts_us = p_impair->LinkFree_us;
+        }
+        ts_us                 += (((CPU_INT64U)len + HOST_IMPAIR_PKT_HDR_LEN) * 8u * 1000000u) / p_cfg->Rate_bps;
+        p_impair->LinkFree_us  =   ts_us;
+    }
+                                                                /* ----------------------- LOSS ----------------------- */
+    if (HostImpair_EventGet(p_impair, p_cfg->LossRate) == DEF_YES) {
+        return (HOST_IMPAIR_PKT_LOSS);
+    }
+                                                                /* -------------- DLY, JITTER & REORDER --------------- */
+    ts_us += p_cfg->Dly_us;
+    if (p_cfg->Jitter_us > 0u) {                                /* See Note #1.                                         */
+        ts_us += HostImpair_RandGet(p_impair) % p_cfg->Jitter_us;
+    }
+    if (HostImpair_EventGet(p_impair, p_cfg->ReorderRate) == DEF_YES) {
+        p_pkt->Reorder  = DEF_YES;
+        ts_us          += p_cfg->ReorderDly_us;
+    }
+    p_pkt->TS_Deliver_us = ts_us;
+                                                                /* -------------------- DUPLICATION ------------------- */
+    p_pkt->Dup = HostImpair_EventGet(p_impair, p_cfg->DupRate);
+
+    return (HOST_IMPAIR_PKT_DELIVER);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        HostImpair_RandGet()
+*
+* Description : Get the next value of a link's pseudo-random generator.
+*
+* Note(s)     : (1) 32-bit xorshift generator : the same seed gives the same draws on every host.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  HostImpair_RandGet (HOST_IMPAIR  *p_impair)
+{
+    CPU_INT32U  x;
+
+
+    x                    = p_impair->RandState;                 /* See Note #1.                                         */
+    x                   ^= x << 13;
+    x                   ^= x >> 17;
+    x                   ^= x <<  5;
+    p_impair->RandState  = x;
+
+    return (x);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostImpair_EventGet()
+*
+* Description : Draw whether an impairment of rate 'rate' applies to the current packet.
+*
+* Note(s)     : (1) See HostImpair_Tx() Note #1.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  HostImpair_EventGet (HOST_IMPAIR  *p_impair,
+                                          CPU_INT16U    rate)
+{
+    if (rate == 0u) {                                           /* See Note #1.                                         */
+        return (DEF_NO);
+    }
+
+    return (((HostImpair_RandGet(p_impair) % HOST_IMPAIR_RATE_SCALE) < rate) ? DEF_YES : DEF_NO);
+}
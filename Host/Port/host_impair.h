@@ -0,0 +1,118 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST PORT : NETWORK IMPAIRMENT MODEL
+*
+* Filename : host_impair.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Seeded model of an impaired link, shared by the network backends.  The model only computes
+*                the fate of each packet sent on the link; the backend drops, duplicates or delivers the
+*                packet at the time returned :
+*
+*                (a) Rate limit : the link serializes its packets at 'Rate_bps', counting 28 octets of
+*                    IPv4/UDP header per datagram.  A packet that would wait more than 'QueueDlyMax_us'
+*                    behind the previous ones is dropped (tail drop).
+*
+*                (b) Loss & duplication : drawn per packet, after the packet is serialized.  A duplicate
+*                    is delivered right after the original.
+*
+*                (c) Delay, jitter & reordering : 'Dly_us' & a random delay (< 'Jitter_us') are added to
+*                    every packet; a reordered packet is delayed by 'ReorderDly_us' more, so that every
+*                    packet sent in the meantime overtakes it.  Any number of packets may be held back at
+*                    once.
+*
+*            (2) Rates are expressed in units of 1/HOST_IMPAIR_RATE_SCALE (0.01 %), e.g. a 'LossRate' of
+*                200 drops 2 % of the packets.
+*
+*            (3) The pseudo-random generator is seeded by HostImpair_Init() : a given packet sequence is
+*                impaired the same way from one run to the next.
+*********************************************************************************************************
+*/
+
+#ifndef  HOST_IMPAIR_MODULE_PRESENT
+#define  HOST_IMPAIR_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  HOST_IMPAIR_RATE_SCALE                       10000u    /* See Note #2.                                         */
+
+#define  HOST_IMPAIR_PKT_HDR_LEN                         28u    /* IPv4 & UDP hdr len (see Note #1a).                   */
+
+                                                                /* ------------- PKT FATES (see Note #1) -------------- */
+#define  HOST_IMPAIR_PKT_DELIVER                          0u    /* Pkt delivered at 'TS_Deliver_us'.                    */
+#define  HOST_IMPAIR_PKT_LOSS                             1u    /* Pkt lost                 (see Note #1b).             */
+#define  HOST_IMPAIR_PKT_QUEUE_DROP                       2u    /* Pkt tail-dropped         (see Note #1a).             */
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  host_impair_cfg {                              /* See Note #1.                                         */
+    CPU_INT32U  Seed;                                           /* Pseudo-random generator seed (see Note #3).          */
+    CPU_INT16U  LossRate;                                       /* Rate of pkts dropped.                                */
+    CPU_INT16U  DupRate;                                        /* Rate of pkts duplicated.                             */
+    CPU_INT16U  ReorderRate;                                    /* Rate of pkts held back.                              */
+    CPU_INT32U  ReorderDly_us;                                  /* Extra dly of a held back pkt.                        */
+    CPU_INT32U  Dly_us;                                         /* One-way dly added to every pkt.                      */
+    CPU_INT32U  Jitter_us;                                      /* Random dly (< 'Jitter_us') added to 'Dly_us'.        */
+    CPU_INT32U  Rate_bps;                                       /* Link rate, in bits/s; 0 if unlimited.                */
+    CPU_INT32U  QueueDlyMax_us;                                 /* Max queuing dly at 'Rate_bps'; 0 if unlimited.       */
+} HOST_IMPAIR_CFG;
+
+typedef  struct  host_impair {
+    HOST_IMPAIR_CFG  Cfg;
+    CPU_INT32U       RandState;                                 /* Pseudo-random generator state.                       */
+    CPU_INT64U       LinkFree_us;                               /* Time at which the last pkt is serialized.            */
+} HOST_IMPAIR;
+
+typedef  struct  host_impair_pkt {
+    CPU_INT64U   TS_Deliver_us;                                 /* Delivery time of the pkt & of its dup.               */
+    CPU_BOOLEAN  Dup;                                           /* DEF_YES if the pkt is duplicated.                    */
+    CPU_BOOLEAN  Reorder;                                       /* DEF_YES if the pkt is held back.                     */
+} HOST_IMPAIR_PKT;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostImpair_Init(       HOST_IMPAIR      *p_impair,
+                             const  HOST_IMPAIR_CFG  *p_cfg);
+
+CPU_INT08U   HostImpair_Tx  (       HOST_IMPAIR      *p_impair,
+                                    CPU_INT64U        ts_us,
+                                    CPU_INT32U        len,
+                                    HOST_IMPAIR_PKT  *p_pkt);
+
+
+#endif
@@ -0,0 +1,85 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : NETWORK BACKEND CONTROL
+*
+* Filename : host_net.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Host-side controls shared by the network backends ('net_bsd.c' & the simulated network).
+*                These are not part of the uC/TCP-IP interface; test & tool programs use them to set up the
+*                interface seen by TFTPc.
+*
+*            (2) The impairment controls are implemented by the BSD backend only; the simulated network has
+*                its own (see 'host_impair.h').
+*********************************************************************************************************
+*/
+
+#ifndef  HOST_NET_MODULE_PRESENT
+#define  HOST_NET_MODULE_PRESENT
+
+#include  <Source/net_type.h>
+#include  "host_impair.h"
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  HOST_NET_IF_MTU_DFLT                           1500u
+
+                                                                /* ------------ IMPAIRED DIR (see Note #2) ------------ */
+#define  HOST_NET_IMPAIR_DIR_TX                            0u   /* Pkts tx'd by TFTPc.                                  */
+#define  HOST_NET_IMPAIR_DIR_RX                            1u   /* Pkts rx'd by TFTPc.                                  */
+#define  HOST_NET_IMPAIR_DIR_NBR                           2u
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  host_net_impair_stats {                        /* See Note #2.                                         */
+    CPU_INT32U  PktLossCtr;                                     /* Nbr of pkts lost.                                    */
+    CPU_INT32U  PktQueueDropCtr;                                /* Nbr of pkts tail-dropped.                            */
+    CPU_INT32U  PktDupCtr;                                      /* Nbr of pkts duplicated.                              */
+    CPU_INT32U  PktReorderCtr;                                  /* Nbr of pkts held back.                               */
+} HOST_NET_IMPAIR_STATS;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+                                                                /* Set MTU returned by NetIF_MTU_Get().                 */
+void         HostNet_IF_MTU_Set    (       NET_MTU                 mtu);
+
+                                                                /* ---------------- BSD BACKEND ONLY ------------------ */
+CPU_BOOLEAN  HostNet_ImpairSet     (       CPU_INT08U              dir,
+                                    const  HOST_IMPAIR_CFG        *p_cfg);
+
+void         HostNet_ImpairStatsGet(       HOST_NET_IMPAIR_STATS  *p_stats);
+
+
+#endif
@@ -0,0 +1,112 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST PORT : HOST CLOCK TIME SOURCE
+*
+* Filename : host_time.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Time source of the host port when TFTPc runs on the BSD socket layer : the time is read from
+*                the host monotonic clock & delays put the calling thread to sleep (see 'KAL/kal.h  Note #2').
+*                A simulated network provides these functions on its virtual clock instead.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+
+#include  <KAL/kal.h>
+#include  <Source/net_util.h>
+
+#include  <errno.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         NetUtil_TS_Get_ms()
+*
+* Description : Get the current time, in milliseconds.  The value wraps around every 49.7 days.
+*********************************************************************************************************
+*/
+
+NET_TS_MS  NetUtil_TS_Get_ms (void)
+{
+    struct  timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((NET_TS_MS)(((CPU_INT64U)ts.tv_sec  * DEF_TIME_NBR_mS_PER_SEC) +
+                        ((CPU_INT64U)ts.tv_nsec / (DEF_TIME_NBR_nS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC))));
+}
+
+
+/*
+*********************************************************************************************************
+*                                              KAL_Dly()
+*
+* Description : Put the calling thread to sleep for 'dly_ms' milliseconds.
+*********************************************************************************************************
+*/
+
+void  KAL_Dly (CPU_INT32U  dly_ms)
+{
+    struct  timespec  ts;
+
+
+    ts.tv_sec  = (time_t)(dly_ms / DEF_TIME_NBR_mS_PER_SEC);
+    ts.tv_nsec = (long)  ((dly_ms % DEF_TIME_NBR_mS_PER_SEC) * (DEF_TIME_NBR_nS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC));
+    while ((nanosleep(&ts, &ts) != 0) && (errno == EINTR)) {
+        ;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            KAL_TickGet()
+*
+* Description : Get the current tick count (see 'KAL/kal.h  Note #2').
+*********************************************************************************************************
+*/
+
+KAL_TICK  KAL_TickGet (KAL_ERR  *p_err)
+{
+    if (p_err != DEF_NULL) {
+       *p_err = KAL_ERR_NONE;
+    }
+
+    return ((KAL_TICK)NetUtil_TS_Get_ms());
+}
@@ -0,0 +1,235 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                HOST PORT : KERNEL ABSTRACTION LAYER LOCKS
+*
+* Filename : kal.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) See 'KAL/kal.h  Note #1'.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+
+#include  <KAL/kal.h>
+
+#include  <errno.h>
+#include  <pthread.h>
+#include  <stdlib.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          KAL_LockCreate()
+*
+* Description : Create a lock.
+*
+* Argument(s) : p_name      Pointer to lock name (unused).
+*
+*               p_cfg       Pointer to lock configuration (unused, MAY be NULL).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               KAL_ERR_NONE            Lock created.
+*                               KAL_ERR_MEM_ALLOC       Lock could NOT be allocated.
+*                               KAL_ERR_CREATE          Mutex could NOT be initialized.
+*
+* Return(s)   : Handle of the lock created.
+*********************************************************************************************************
+*/
+
+KAL_LOCK_HANDLE  KAL_LockCreate (const  CPU_CHAR          *p_name,
+                                        KAL_LOCK_EXT_CFG  *p_cfg,
+                                        KAL_ERR           *p_err)
+{
+    KAL_LOCK_HANDLE       handle;
+    pthread_mutex_t      *p_mutex;
+    pthread_mutexattr_t   attr;
+
+
+    (void)p_name;
+    (void)p_cfg;
+
+    handle.LockObjPtr = DEF_NULL;
+
+    p_mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+    if (p_mutex == DEF_NULL) {
+       *p_err = KAL_ERR_MEM_ALLOC;
+        return (handle);
+    }
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    if (pthread_mutex_init(p_mutex, &attr) != 0) {
+        pthread_mutexattr_destroy(&attr);
+        free(p_mutex);
+       *p_err = KAL_ERR_CREATE;
+        return (handle);
+    }
+    pthread_mutexattr_destroy(&attr);
+
+    handle.LockObjPtr = p_mutex;
+   *p_err             = KAL_ERR_NONE;
+
+    return (handle);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_LockAcquire()
+*
+* Description : Acquire a lock.
+*
+* Argument(s) : lock_handle     Handle of the lock.
+*
+*               opt             KAL_OPT_PEND_NON_BLOCKING, to return at once if the lock is NOT available.
+*
+*               timeout_ms      Max time to wait, in milliseconds, or KAL_TIMEOUT_INFINITE.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   KAL_ERR_NONE            Lock acquired.
+*                                   KAL_ERR_NULL_PTR        Invalid lock handle.
+*                                   KAL_ERR_WOULD_BLOCK     Lock NOT available (non-blocking acquire).
+*                                   KAL_ERR_TIMEOUT         Lock NOT available within 'timeout_ms'.
+*                                   KAL_ERR_OS              Mutex error.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+void  KAL_LockAcquire (KAL_LOCK_HANDLE   lock_handle,
+                       KAL_OPT           opt,
+                       CPU_INT32U        timeout_ms,
+                       KAL_ERR          *p_err)
+{
+    pthread_mutex_t  *p_mutex;
+    struct  timespec  ts;
+    int               rtn;
+
+
+    p_mutex = (pthread_mutex_t *)lock_handle.LockObjPtr;
+    if (p_mutex == DEF_NULL) {
+       *p_err = KAL_ERR_NULL_PTR;
+        return;
+    }
+
+    if (DEF_BIT_IS_SET(opt, KAL_OPT_PEND_NON_BLOCKING) == DEF_YES) {
+        rtn = pthread_mutex_trylock(p_mutex);
+    } else if (timeout_ms == KAL_TIMEOUT_INFINITE) {
+        rtn = pthread_mutex_lock(p_mutex);
+    } else {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec  +=  timeout_ms / DEF_TIME_NBR_mS_PER_SEC;
+        ts.tv_nsec += (timeout_ms % DEF_TIME_NBR_mS_PER_SEC) * (DEF_TIME_NBR_nS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC);
+        if (ts.tv_nsec >= (long)DEF_TIME_NBR_nS_PER_SEC) {
+            ts.tv_sec++;
+            ts.tv_nsec -= DEF_TIME_NBR_nS_PER_SEC;
+        }
+        rtn = pthread_mutex_timedlock(p_mutex, &ts);
+    }
+
+    switch (rtn) {
+        case 0:
+            *p_err = KAL_ERR_NONE;
+             break;
+
+        case EBUSY:
+            *p_err = KAL_ERR_WOULD_BLOCK;
+             break;
+
+        case ETIMEDOUT:
+            *p_err = KAL_ERR_TIMEOUT;
+             break;
+
+        default:
+            *p_err = KAL_ERR_OS;
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          KAL_LockRelease()
+*
+* Description : Release a lock acquired with KAL_LockAcquire().
+*********************************************************************************************************
+*/
+
+void  KAL_LockRelease (KAL_LOCK_HANDLE   lock_handle,
+                       KAL_ERR          *p_err)
+{
+    pthread_mutex_t  *p_mutex;
+
+
+    p_mutex = (pthread_mutex_t *)lock_handle.LockObjPtr;
+    if (p_mutex == DEF_NULL) {
+       *p_err = KAL_ERR_NULL_PTR;
+        return;
+    }
+
+   *p_err = (pthread_mutex_unlock(p_mutex) == 0) ? KAL_ERR_NONE : KAL_ERR_OS;
+}
+
+
+/*
+*********************************************************************************************************
+*                                            KAL_LockDel()
+*
+* Description : Delete a lock.  The lock MUST NOT be held.
+*********************************************************************************************************
+*/
+
+void  KAL_LockDel (KAL_LOCK_HANDLE   lock_handle,
+                   KAL_ERR          *p_err)
+{
+    pthread_mutex_t  *p_mutex;
+
+
+    p_mutex = (pthread_mutex_t *)lock_handle.LockObjPtr;
+    if (p_mutex == DEF_NULL) {
+       *p_err = KAL_ERR_NULL_PTR;
+        return;
+    }
+
+    pthread_mutex_destroy(p_mutex);
+    free(p_mutex);
+
+   *p_err = KAL_ERR_NONE;
+}
@@ -0,0 +1,67 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : uC/LIB ASCII SUBSET
+*
+* Filename : lib_ascii.c
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <lib_ascii.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  ASCII_IsDig (CPU_CHAR  c)
+{
+    return (((c >= '0') && (c <= '9')) ? DEF_YES : DEF_NO);
+}
+
+
+CPU_BOOLEAN  ASCII_IsSpace (CPU_CHAR  c)
+{
+    return (((c == ' ') || ((c >= '\t') && (c <= '\r'))) ? DEF_YES : DEF_NO);
+}
+
+
+CPU_CHAR  ASCII_ToLower (CPU_CHAR  c)
+{
+    return (((c >= 'A') && (c <= 'Z')) ? (CPU_CHAR)(c + ('a' - 'A')) : c);
+}
+
+
+CPU_CHAR  ASCII_ToUpper (CPU_CHAR  c)
+{
+    return (((c >= 'a') && (c <= 'z')) ? (CPU_CHAR)(c - ('a' - 'A')) : c);
+}
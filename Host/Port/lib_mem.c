@@ -0,0 +1,113 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : uC/LIB MEMORY SUBSET
+*
+* Filename : lib_mem.c
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <lib_mem.h>
+
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+void  Mem_Clr (void        *p_mem,
+               CPU_SIZE_T   size)
+{
+    if ((p_mem == DEF_NULL) || (size == 0u)) {
+        return;
+    }
+    memset(p_mem, 0, size);
+}
+
+
+void  Mem_Set (void        *p_mem,
+               CPU_INT08U   data_val,
+               CPU_SIZE_T   size)
+{
+    if ((p_mem == DEF_NULL) || (size == 0u)) {
+        return;
+    }
+    memset(p_mem, data_val, size);
+}
+
+
+void  Mem_Copy (       void        *p_dest,
+                const  void        *p_src,
+                       CPU_SIZE_T   size)
+{
+    if ((p_dest == DEF_NULL) || (p_src == DEF_NULL) || (size == 0u)) {
+        return;
+    }
+    memcpy(p_dest, p_src, size);
+}
+
+
+void  Mem_Move (       void        *p_dest,
+                const  void        *p_src,
+                       CPU_SIZE_T   size)
+{
+    if ((p_dest == DEF_NULL) || (p_src == DEF_NULL) || (size == 0u)) {
+        return;
+    }
+    memmove(p_dest, p_src, size);
+}
+
+
+/*
+*********************************************************************************************************
+*                                              Mem_Cmp()
+*
+* Return(s)   : DEF_YES, if the 'size' octets of both buffers are identical (or 'size' is zero).
+*
+*               DEF_NO,  otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  Mem_Cmp (const  void        *p1_mem,
+                      const  void        *p2_mem,
+                             CPU_SIZE_T   size)
+{
+    if (size == 0u) {
+        return (DEF_YES);
+    }
+    if ((p1_mem == DEF_NULL) || (p2_mem == DEF_NULL)) {
+        return (DEF_NO);
+    }
+
+    return ((memcmp(p1_mem, p2_mem, size) == 0) ? DEF_YES : DEF_NO);
+}
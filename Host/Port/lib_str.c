@@ -0,0 +1,420 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : uC/LIB STRING SUBSET
+*
+* Filename : lib_str.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) See 'lib_str.h  Note #1'.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <lib_str.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  Str_Len (const  CPU_CHAR  *p_str)
+{
+    return (Str_Len_N(p_str, (CPU_SIZE_T)-1));
+}
+
+
+CPU_SIZE_T  Str_Len_N (const  CPU_CHAR    *p_str,
+                              CPU_SIZE_T   len_max)
+{
+    CPU_SIZE_T  len;
+
+
+    if (p_str == DEF_NULL) {
+        return (0u);
+    }
+
+    len = 0u;
+    while ((len < len_max) && (p_str[len] != ASCII_CHAR_NULL)) {
+        len++;
+    }
+
+    return (len);
+}
+
+
+CPU_CHAR  *Str_Copy (       CPU_CHAR  *p_str_dest,
+                     const  CPU_CHAR  *p_str_src)
+{
+    return (Str_Copy_N(p_str_dest, p_str_src, (CPU_SIZE_T)-1));
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Str_Copy_N()
+*
+* Note(s)     : (1) At most 'len_max' characters are copied, including the terminating NULL character : the
+*                   destination is NOT NULL-terminated when the source is 'len_max' characters or longer.
+*********************************************************************************************************
+*/
+
+CPU_CHAR  *Str_Copy_N (       CPU_CHAR    *p_str_dest,
+                       const  CPU_CHAR    *p_str_src,
+                              CPU_SIZE_T   len_max)
+{
+    CPU_SIZE_T  ix;
+
+
+    if ((p_str_dest == DEF_NULL) ||
+        (p_str_src  == DEF_NULL)) {
+        return (DEF_NULL);
+    }
+
+    for (ix = 0u; ix < len_max; ix++) {
+        p_str_dest[ix] = p_str_src[ix];
+        if (p_str_src[ix] == ASCII_CHAR_NULL) {
+            break;
+        }
+    }
+
+    return (p_str_dest);
+}
+
+
+CPU_CHAR  *Str_Cat (       CPU_CHAR  *p_str_dest,
+                    const  CPU_CHAR  *p_str_cat)
+{
+    return (Str_Cat_N(p_str_dest, p_str_cat, (CPU_SIZE_T)-1));
+}
+
+
+CPU_CHAR  *Str_Cat_N (       CPU_CHAR    *p_str_dest,
+                      const  CPU_CHAR    *p_str_cat,
+                             CPU_SIZE_T   len_max)
+{
+    CPU_CHAR    *p_end;
+    CPU_SIZE_T   ix;
+
+
+    if ((p_str_dest == DEF_NULL) ||
+        (p_str_cat  == DEF_NULL)) {
+        return (DEF_NULL);
+    }
+
+    p_end = p_str_dest + Str_Len(p_str_dest);
+    for (ix = 0u; (ix < len_max) && (p_str_cat[ix] != ASCII_CHAR_NULL); ix++) {
+        p_end[ix] = p_str_cat[ix];
+    }
+    p_end[ix] = ASCII_CHAR_NULL;
+
+    return (p_str_dest);
+}
+
+
+CPU_INT16S  Str_Cmp (const  CPU_CHAR  *p1_str,
+                     const  CPU_CHAR  *p2_str)
+{
+    return (Str_Cmp_N(p1_str, p2_str, (CPU_SIZE_T)-1));
+}
+
+
+CPU_INT16S  Str_Cmp_N (const  CPU_CHAR    *p1_str,
+                       const  CPU_CHAR    *p2_str,
+                              CPU_SIZE_T   len_max)
+{
+    CPU_SIZE_T  ix;
+
+
+    if (p1_str == p2_str) {
+        return (0);
+    }
+    if (p1_str == DEF_NULL) {
+        return (-1);
+    }
+    if (p2_str == DEF_NULL) {
+        return (1);
+    }
+
+    for (ix = 0u; ix < len_max; ix++) {
+        if (p1_str[ix] != p2_str[ix]) {
+            return ((CPU_INT16S)((CPU_INT08U)p1_str[ix] - (CPU_INT08U)p2_str[ix]));
+        }
+        if (p1_str[ix] == ASCII_CHAR_NULL) {
+            break;
+        }
+    }
+
+    return (0);
+}
+
+
+CPU_INT16S  Str_CmpIgnoreCase (const  CPU_CHAR  *p1_str,
+                               const  CPU_CHAR  *p2_str)
+{
+    CPU_CHAR    c1;
+    CPU_CHAR    c2;
+    CPU_SIZE_T  ix;
+
+
+    if (p1_str == p2_str) {
+        return (0);
+    }
+    if (p1_str == DEF_NULL) {
+        return (-1);
+    }
+    if (p2_str == DEF_NULL) {
+        return (1);
+    }
+
+    for (ix = 0u; ; ix++) {
+        c1 = ASCII_ToLower(p1_str[ix]);
+        c2 = ASCII_ToLower(p2_str[ix]);
+        if (c1 != c2) {
+            return ((CPU_INT16S)((CPU_INT08U)c1 - (CPU_INT08U)c2));
+        }
+        if (c1 == ASCII_CHAR_NULL) {
+            return (0);
+        }
+    }
+}
+
+
+CPU_CHAR  *Str_Char (const  CPU_CHAR  *p_str,
+                            CPU_CHAR   srch_char)
+{
+    if (p_str == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    while (*p_str != srch_char) {
+        if (*p_str == ASCII_CHAR_NULL) {
+            return (DEF_NULL);
+        }
+        p_str++;
+    }
+
+    return ((CPU_CHAR *)p_str);
+}
+
+
+CPU_CHAR  *Str_Char_Last (const  CPU_CHAR  *p_str,
+                                 CPU_CHAR   srch_char)
+{
+    const  CPU_CHAR  *p_found;
+
+
+    if (p_str == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    p_found = DEF_NULL;
+    for (;;) {
+        if (*p_str == srch_char) {
+            p_found = p_str;
+        }
+        if (*p_str == ASCII_CHAR_NULL) {
+            break;
+        }
+        p_str++;
+    }
+
+    return ((CPU_CHAR *)p_found);
+}
+
+
+CPU_CHAR  *Str_Str (const  CPU_CHAR  *p_str,
+                    const  CPU_CHAR  *p_str_srch)
+{
+    CPU_SIZE_T  len_srch;
+
+
+    if ((p_str      == DEF_NULL) ||
+        (p_str_srch == DEF_NULL)) {
+        return (DEF_NULL);
+    }
+
+    len_srch = Str_Len(p_str_srch);
+    for (; *p_str != ASCII_CHAR_NULL; p_str++) {
+        if (Str_Cmp_N(p_str, p_str_srch, len_srch) == 0) {
+            return ((CPU_CHAR *)p_str);
+        }
+    }
+
+    return ((len_srch == 0u) ? (CPU_CHAR *)p_str : DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Str_FmtNbr_Int32U()
+*
+* Description : Format an unsigned number into a string.
+*
+* Note(s)     : (1) See 'lib_str.h  Note #2'.  When the number does NOT fit in 'nbr_dig' digits, its least
+*                   significant digits are formatted.
+*
+*               (2) 'p_str' MUST hold 'nbr_dig' characters, plus the NULL character when 'nul' is DEF_YES.
+*********************************************************************************************************
+*/
+
+CPU_CHAR  *Str_FmtNbr_Int32U (CPU_INT32U    nbr,
+                              CPU_INT08U    nbr_dig,
+                              CPU_INT08U    nbr_base,
+                              CPU_CHAR      lead_char,
+                              CPU_BOOLEAN   lower_case,
+                              CPU_BOOLEAN   nul,
+                              CPU_CHAR     *p_str)
+{
+    CPU_CHAR     digits[32];
+    CPU_INT08U   nbr_sig;
+    CPU_INT08U   ix;
+    CPU_INT08U   dig_val;
+    CPU_INT08U   pad;
+
+
+    if ((p_str    == DEF_NULL) ||
+        (nbr_dig  == 0u)       ||
+        (nbr_base <  2u)       ||
+        (nbr_base > 36u)) {
+        return (DEF_NULL);
+    }
+
+    nbr_sig = 0u;                                               /* Fmt digits, least significant first.                 */
+    do {
+        dig_val = (CPU_INT08U)(nbr % nbr_base);
+        nbr    /= nbr_base;
+        if (dig_val < 10u) {
+            digits[nbr_sig] = (CPU_CHAR)('0' + dig_val);
+        } else {
+            digits[nbr_sig] = (CPU_CHAR)(((lower_case == DEF_YES) ? 'a' : 'A') + (dig_val - 10u));
+        }
+        nbr_sig++;
+    } while ((nbr != 0u) && (nbr_sig < nbr_dig));
+
+    pad = 0u;
+    if (lead_char != ASCII_CHAR_NULL) {                         /* See Note #1.                                         */
+        pad = (CPU_INT08U)(nbr_dig - nbr_sig);
+        for (ix = 0u; ix < pad; ix++) {
+            p_str[ix] = lead_char;
+        }
+    }
+
+    for (ix = 0u; ix < nbr_sig; ix++) {
+        p_str[pad + ix] = digits[nbr_sig - 1u - ix];
+    }
+
+    if (nul == DEF_YES) {
+        p_str[pad + nbr_sig] = ASCII_CHAR_NULL;
+    }
+
+    return (p_str);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       Str_ParseNbr_Int32U()
+*
+* Description : Parse an unsigned number from a string.
+*
+* Note(s)     : (1) Leading white-space & an optional '+' sign are skipped.  Parsing stops at the first
+*                   character that is NOT a digit of the base; '*p_str_next' is then set to that character, or
+*                   to 'p_str' if NO digit was parsed.
+*
+*               (2) A number larger than DEF_INT_32U_MAX_VAL is returned as DEF_INT_32U_MAX_VAL.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  Str_ParseNbr_Int32U (const  CPU_CHAR     *p_str,
+                                        CPU_CHAR    **p_str_next,
+                                        CPU_INT08U    nbr_base)
+{
+    const  CPU_CHAR     *p_char;
+           CPU_INT32U    nbr;
+           CPU_INT32U    dig_val;
+           CPU_BOOLEAN   dig_found;
+           CPU_BOOLEAN   ovf;
+           CPU_CHAR      c;
+
+
+    if (p_str_next != DEF_NULL) {
+       *p_str_next  = (CPU_CHAR *)p_str;
+    }
+    if ((p_str    == DEF_NULL) ||
+        (nbr_base == 1u)       ||
+        (nbr_base > 36u)) {
+        return (0u);
+    }
+
+    p_char = p_str;
+    while (ASCII_IsSpace(*p_char) == DEF_YES) {
+        p_char++;
+    }
+    if (*p_char == '+') {
+        p_char++;
+    }
+    if (nbr_base == 0u) {
+        nbr_base = DEF_NBR_BASE_DEC;
+    }
+
+    nbr       = 0u;
+    dig_found = DEF_NO;
+    ovf       = DEF_NO;
+    for (;;) {
+        c = ASCII_ToLower(*p_char);
+        if ((c >= '0') && (c <= '9')) {
+            dig_val = (CPU_INT32U)(c - '0');
+        } else if ((c >= 'a') && (c <= 'z')) {
+            dig_val = (CPU_INT32U)(c - 'a') + 10u;
+        } else {
+            break;
+        }
+        if (dig_val >= nbr_base) {
+            break;
+        }
+        if (nbr > ((DEF_INT_32U_MAX_VAL - dig_val) / nbr_base)) {
+            ovf = DEF_YES;                                      /* See Note #2.                                         */
+        } else {
+            nbr = (nbr * nbr_base) + dig_val;
+        }
+        dig_found = DEF_YES;
+        p_char++;
+    }
+
+    if (dig_found == DEF_NO) {
+        return (0u);
+    }
+    if (p_str_next != DEF_NULL) {
+       *p_str_next  = (CPU_CHAR *)p_char;
+    }
+
+    return ((ovf == DEF_YES) ? DEF_INT_32U_MAX_VAL : nbr);
+}
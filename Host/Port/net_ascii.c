@@ -0,0 +1,125 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : NETWORK ASCII LIBRARY
+*
+* Filename : net_ascii.c
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/net_ascii.h>
+#include  <lib_str.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       NetASCII_Str_to_IPv4()
+*
+* Description : Convert a dotted-decimal IPv4 address string (e.g. "224.0.1.2") to an IPv4 address.
+*
+* Argument(s) : p_addr_ip_ascii     Pointer to address string.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       NET_ASCII_ERR_NONE                  Address converted.
+*                                       NET_ERR_FAULT_NULL_PTR              NULL string.
+*                                       NET_ASCII_ERR_INVALID_STR_LEN       Wrong nbr of octets.
+*                                       NET_ASCII_ERR_INVALID_CHAR          Invalid character or octet value.
+*
+* Return(s)   : IPv4 address, in host order, if NO error.
+*
+*               0,                            otherwise.
+*********************************************************************************************************
+*/
+
+NET_IPv4_ADDR  NetASCII_Str_to_IPv4 (CPU_CHAR  *p_addr_ip_ascii,
+                                     NET_ERR   *p_err)
+{
+    CPU_CHAR       *p_char;
+    CPU_INT32U      octet;
+    CPU_INT32U      nbr_dig;
+    CPU_INT08U      nbr_octet;
+    NET_IPv4_ADDR   addr;
+
+
+    if (p_addr_ip_ascii == DEF_NULL) {
+       *p_err = NET_ERR_FAULT_NULL_PTR;
+        return (0u);
+    }
+
+    addr      = 0u;
+    nbr_octet = 0u;
+    p_char    = p_addr_ip_ascii;
+    for (;;) {
+        octet   = 0u;
+        nbr_dig = 0u;
+        while (ASCII_IsDig(*p_char) == DEF_YES) {
+            octet = (octet * 10u) + (CPU_INT32U)(*p_char - '0');
+            nbr_dig++;
+            p_char++;
+            if ((nbr_dig > 3u) || (octet > DEF_INT_08U_MAX_VAL)) {
+               *p_err = NET_ASCII_ERR_INVALID_CHAR;
+                return (0u);
+            }
+        }
+        if (nbr_dig == 0u) {
+           *p_err = NET_ASCII_ERR_INVALID_CHAR;
+            return (0u);
+        }
+
+        addr = (addr << DEF_OCTET_NBR_BITS) | octet;
+        nbr_octet++;
+
+        if (*p_char == ASCII_CHAR_NULL) {
+            break;
+        }
+        if ((*p_char   != ASCII_CHAR_FULL_STOP) ||
+            (nbr_octet >= 4u)) {
+           *p_err = NET_ASCII_ERR_INVALID_CHAR;
+            return (0u);
+        }
+        p_char++;
+    }
+
+    if (nbr_octet != 4u) {
+       *p_err = NET_ASCII_ERR_INVALID_STR_LEN;
+        return (0u);
+    }
+
+   *p_err = NET_ASCII_ERR_NONE;
+
+    return (addr);
+}
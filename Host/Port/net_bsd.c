@@ -0,0 +1,1607 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                 HOST PORT : NETWORK ON BSD SOCKETS
+*
+* Filename : net_bsd.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Implements the subset of the uC/TCP-IP socket, application, interface & IGMP interfaces used
+*                by TFTPc on top of the host BSD UDP sockets.  Socket IDs are indexes in a table that maps
+*                them to the host file descriptors, so that the NET_SOCK_DESC bitmaps work unchanged.
+*
+*            (2) Rx timeouts are implemented with poll().  A connected UDP socket may report ECONNREFUSED
+*                after an ICMP port unreachable; uC/TCP-IP does not surface these, so they are ignored &
+*                the receive continues until the timeout expires.
+*
+*            (3) Datagrams longer than the receive buffer are truncated to the buffer length.
+*
+*            (4) NetIGMP_HostGrpJoin() adds the membership, on the default host interface, to every IPv4
+*                socket open at the time of the call.
+*
+*            (5) When an impairment is set (see HostNet_ImpairSet()), the packets of the impaired direction
+*                are held in a list sorted by delivery time, instead of being tx'd or returned right away :
+*
+*                (a) Held tx'd packets are sent when due, by the next socket call of any thread, including
+*                    the wait of NetSock_RxDataFrom().
+*
+*                (b) Held rx'd packets are returned when due by NetSock_RxDataFrom() on their socket.
+*                    NetSock_Sel() does NOT see them.
+*
+*                (c) Packets still held when their socket is closed are dropped.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+#define    _DEFAULT_SOURCE
+
+#include  <Source/net.h>
+#include  <Source/net_app.h>
+#include  <Source/net_if.h>
+#include  <Source/net_igmp.h>
+#include  "host_net.h"
+
+#include  <errno.h>
+#include  <netdb.h>
+#include  <poll.h>
+#include  <time.h>
+#include  <pthread.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <unistd.h>
+#include  <arpa/inet.h>
+#include  <netinet/in.h>
+#include  <sys/socket.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  NET_BSD_IGMP_GRP_NBR_MAX                          4u
+
+#define  NET_BSD_TS_NONE                    ((CPU_INT64U)-1)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  net_bsd_sock {
+    CPU_BOOLEAN  Used;
+    int          FD;
+    int          Family;                                        /* AF_INET or AF_INET6.                                 */
+    CPU_BOOLEAN  Block;
+    CPU_INT32U   TimeoutRx_ms;                                  /* 0 : infinite.                                        */
+} NET_BSD_SOCK;
+
+typedef  struct  net_bsd_pkt  NET_BSD_PKT;
+
+struct  net_bsd_pkt {                                           /* Pkt held by the impairment (see Note #5).            */
+    NET_BSD_PKT               *NextPtr;
+    CPU_INT64U                 TS_Deliver_us;
+    CPU_INT08U                 Dir;                             /* HOST_NET_IMPAIR_DIR_TX or HOST_NET_IMPAIR_DIR_RX.    */
+    NET_SOCK_ID                SockID;
+    struct  sockaddr_storage   Addr;                            /* Dest addr of a tx'd pkt, src addr of a rx'd pkt.     */
+    socklen_t                  AddrLen;                         /* 0 : tx'd on the connected socket.                    */
+    CPU_INT32U                 Len;
+    CPU_INT08U                 Data[];
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  NET_BSD_SOCK     NetBSD_SockTbl[NET_SOCK_CFG_NBR_SOCK];
+static  pthread_mutex_t  NetBSD_Lock = PTHREAD_MUTEX_INITIALIZER;
+
+static  NET_MTU          NetBSD_IF_MTU = HOST_NET_IF_MTU_DFLT;
+
+static  NET_IPv4_ADDR    NetBSD_IGMP_GrpTbl[NET_BSD_IGMP_GRP_NBR_MAX];
+
+static  HOST_IMPAIR             NetBSD_ImpairTbl[HOST_NET_IMPAIR_DIR_NBR];
+static  CPU_BOOLEAN             NetBSD_ImpairEn[HOST_NET_IMPAIR_DIR_NBR];
+static  HOST_NET_IMPAIR_STATS   NetBSD_ImpairStats;
+static  NET_BSD_PKT            *NetBSD_PktHeldPtr;              /* Held pkts, by delivery time (see Note #5).           */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  NET_BSD_SOCK  *NetBSD_SockGet     (NET_SOCK_ID               sock_id);
+
+static  socklen_t      NetBSD_AddrToHost  (const NET_SOCK_ADDR      *p_addr,
+                                           struct  sockaddr_storage *p_ss);
+
+static  void           NetBSD_AddrFromHost(const struct  sockaddr_storage *p_ss,
+                                           NET_SOCK_ADDR            *p_addr);
+
+static  CPU_BOOLEAN    NetBSD_GrpMembership(NET_IPv4_ADDR            addr_grp,
+                                            int                      opt);
+
+static  CPU_INT64U     NetBSD_TimeGet_us  (void);
+
+static  CPU_BOOLEAN    NetBSD_Impair      (       CPU_INT08U                 dir,
+                                                  NET_SOCK_ID                sock_id,
+                                           const  void                      *p_data,
+                                                  CPU_INT32U                 len,
+                                           const  struct  sockaddr_storage  *p_ss,
+                                                  socklen_t                  ss_len);
+
+static  void           NetBSD_PktHold     (       CPU_INT08U                 dir,
+                                                  NET_SOCK_ID                sock_id,
+                                                  CPU_INT64U                 ts_deliver_us,
+                                           const  void                      *p_data,
+                                                  CPU_INT32U                 len,
+                                           const  struct  sockaddr_storage  *p_ss,
+                                                  socklen_t                  ss_len);
+
+static  NET_BSD_PKT   *NetBSD_PktHeldProc (       NET_SOCK_ID                sock_id,
+                                                  CPU_INT64U                *p_ts_next_us);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          HostNet_IF_MTU_Set()
+*
+* Description : Set the MTU reported for the default interface.
+*********************************************************************************************************
+*/
+
+void  HostNet_IF_MTU_Set (NET_MTU  mtu)
+{
+    NetBSD_IF_MTU = mtu;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostNet_ImpairSet()
+*
+* Description : Set the impairments applied to the packets of one direction (see Note #5).
+*
+* Argument(s) : dir         HOST_NET_IMPAIR_DIR_TX, for the packets tx'd by TFTPc.
+*
+*                           HOST_NET_IMPAIR_DIR_RX, for the packets rx'd by TFTPc.
+*
+*               p_cfg       Pointer to impairment configuration, or NULL to remove the impairments.
+*
+* Return(s)   : DEF_OK,   if the impairments were set.
+*
+*               DEF_FAIL, if the direction or a rate is invalid (see 'host_impair.h  Note #2').
+*
+* Note(s)     : (1) The impairment statistics are reset.  Packets already held are delivered when due.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostNet_ImpairSet (       CPU_INT08U        dir,
+                                const  HOST_IMPAIR_CFG  *p_cfg)
+{
+    CPU_BOOLEAN  ok;
+
+
+    if (dir >= HOST_NET_IMPAIR_DIR_NBR) {
+        return (DEF_FAIL);
+    }
+
+    ok = DEF_OK;
+    pthread_mutex_lock(&NetBSD_Lock);
+    if (p_cfg == DEF_NULL) {
+        NetBSD_ImpairEn[dir] = DEF_NO;
+    } else {
+        ok                   = HostImpair_Init(&NetBSD_ImpairTbl[dir], p_cfg);
+        NetBSD_ImpairEn[dir] = ok;
+    }
+    Mem_Clr(&NetBSD_ImpairStats, sizeof(NetBSD_ImpairStats));   /* See Note #1.                                         */
+    pthread_mutex_unlock(&NetBSD_Lock);
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       HostNet_ImpairStatsGet()
+*
+* Description : Get the impairment statistics, for both directions.
+*********************************************************************************************************
+*/
+
+void  HostNet_ImpairStatsGet (HOST_NET_IMPAIR_STATS  *p_stats)
+{
+    pthread_mutex_lock(&NetBSD_Lock);
+   *p_stats = NetBSD_ImpairStats;
+    pthread_mutex_unlock(&NetBSD_Lock);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Open()
+*
+* Description : Open a UDP socket.
+*
+* Argument(s) : protocol_family     NET_SOCK_PROTOCOL_FAMILY_IP_V4 or NET_SOCK_PROTOCOL_FAMILY_IP_V6.
+*
+*               sock_type           NET_SOCK_TYPE_DATAGRAM.
+*
+*               protocol            NET_SOCK_PROTOCOL_UDP.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function.
+*
+* Return(s)   : Socket ID, if NO error.
+*
+*               NET_SOCK_BSD_ERR_OPEN, otherwise.
+*********************************************************************************************************
+*/
+
+NET_SOCK_ID  NetSock_Open (NET_SOCK_PROTOCOL_FAMILY   protocol_family,
+                           NET_SOCK_TYPE              sock_type,
+                           NET_SOCK_PROTOCOL          protocol,
+                           NET_ERR                   *p_err)
+{
+    NET_SOCK_ID   sock_id;
+    int           family;
+    int           fd;
+
+
+    switch (protocol_family) {
+        case NET_SOCK_PROTOCOL_FAMILY_IP_V4:
+             family = AF_INET;
+             break;
+
+        case NET_SOCK_PROTOCOL_FAMILY_IP_V6:
+             family = AF_INET6;
+             break;
+
+        default:
+            *p_err = NET_SOCK_ERR_INVALID_FAMILY;
+             return (NET_SOCK_BSD_ERR_OPEN);
+    }
+    if ((sock_type != NET_SOCK_TYPE_DATAGRAM) ||
+        (protocol  != NET_SOCK_PROTOCOL_UDP)) {
+       *p_err = NET_ERR_FAULT_NOT_SUPPORTED;
+        return (NET_SOCK_BSD_ERR_OPEN);
+    }
+
+    fd = socket(family, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+       *p_err = NET_SOCK_ERR_NONE_AVAIL;
+        return (NET_SOCK_BSD_ERR_OPEN);
+    }
+
+    pthread_mutex_lock(&NetBSD_Lock);
+    for (sock_id = 0; sock_id < (NET_SOCK_ID)NET_SOCK_CFG_NBR_SOCK; sock_id++) {
+        if (NetBSD_SockTbl[sock_id].Used == DEF_NO) {
+            NetBSD_SockTbl[sock_id].Used         = DEF_YES;
+            NetBSD_SockTbl[sock_id].FD           = fd;
+            NetBSD_SockTbl[sock_id].Family       = family;
+            NetBSD_SockTbl[sock_id].Block        = DEF_YES;
+            NetBSD_SockTbl[sock_id].TimeoutRx_ms = NET_SOCK_TIMEOUT_INFINITE;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&NetBSD_Lock);
+
+    if (sock_id >= (NET_SOCK_ID)NET_SOCK_CFG_NBR_SOCK) {
+        close(fd);
+       *p_err = NET_SOCK_ERR_NONE_AVAIL;
+        return (NET_SOCK_BSD_ERR_OPEN);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (sock_id);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Close()
+*
+* Description : Close a socket & free its socket ID.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Close (NET_SOCK_ID   sock_id,
+                                  NET_ERR      *p_err)
+{
+    NET_BSD_SOCK   *p_sock;
+    NET_BSD_PKT   **pp_pkt;
+    NET_BSD_PKT    *p_pkt;
+    int             fd;
+
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_CLOSE);
+    }
+
+    pthread_mutex_lock(&NetBSD_Lock);
+    fd           = p_sock->FD;
+    p_sock->FD   = -1;
+    p_sock->Used = DEF_NO;
+    pp_pkt       = &NetBSD_PktHeldPtr;
+    while (*pp_pkt != DEF_NULL) {                               /* Drop the sock's held pkts (see Note #5c).            */
+        p_pkt = *pp_pkt;
+        if (p_pkt->SockID == sock_id) {
+           *pp_pkt = p_pkt->NextPtr;
+            free(p_pkt);
+        } else {
+            pp_pkt = &p_pkt->NextPtr;
+        }
+    }
+    pthread_mutex_unlock(&NetBSD_Lock);
+
+    close(fd);
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (NET_SOCK_BSD_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Bind()
+*
+* Description : Bind a socket to a local address.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Bind (NET_SOCK_ID         sock_id,
+                                 NET_SOCK_ADDR      *p_addr_local,
+                                 NET_SOCK_ADDR_LEN   addr_len,
+                                 NET_ERR            *p_err)
+{
+    NET_BSD_SOCK             *p_sock;
+    struct  sockaddr_storage  ss;
+    socklen_t                 ss_len;
+    int                       on;
+
+
+   (void)addr_len;
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_BIND);
+    }
+
+    ss_len = NetBSD_AddrToHost(p_addr_local, &ss);
+    if (ss_len == 0u) {
+       *p_err = NET_SOCK_ERR_INVALID_ADDR;
+        return (NET_SOCK_BSD_ERR_BIND);
+    }
+
+    on = 1;                                                     /* Several hosts may share a mcast port on one machine. */
+   (void)setsockopt(p_sock->FD, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    if (bind(p_sock->FD, (struct sockaddr *)&ss, ss_len) != 0) {
+       *p_err = (errno == EADDRINUSE) ? NET_SOCK_ERR_ADDR_IN_USE
+                                      : NET_SOCK_ERR_INVALID_ADDR;
+        return (NET_SOCK_BSD_ERR_BIND);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (NET_SOCK_BSD_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Conn()
+*
+* Description : Set the remote address of a datagram socket.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Conn (NET_SOCK_ID         sock_id,
+                                 NET_SOCK_ADDR      *p_addr_remote,
+                                 NET_SOCK_ADDR_LEN   addr_len,
+                                 NET_ERR            *p_err)
+{
+    NET_BSD_SOCK             *p_sock;
+    struct  sockaddr_storage  ss;
+    socklen_t                 ss_len;
+
+
+   (void)addr_len;
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_CONN);
+    }
+
+    ss_len = NetBSD_AddrToHost(p_addr_remote, &ss);
+    if ((ss_len == 0u) ||
+        (connect(p_sock->FD, (struct sockaddr *)&ss, ss_len) != 0)) {
+       *p_err = NET_SOCK_ERR_CONN_FAIL;
+        return (NET_SOCK_BSD_ERR_CONN);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (NET_SOCK_BSD_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetSock_RxDataFrom()
+*
+* Description : Receive a datagram.
+*
+* Argument(s) : sock_id             Socket ID.
+*
+*               p_data_buf          Pointer to receive buffer.
+*
+*               data_buf_len        Receive buffer length, in octets (see Note #3).
+*
+*               flags               NET_SOCK_FLAG_RX_NO_BLOCK to return immediately if no datagram is queued.
+*
+*               p_addr_remote       Pointer to variable that will receive the sender address, if NOT NULL.
+*
+*               p_addr_len          Pointer to variable that will receive the sender address length.
+*
+*               p_ip_opts_buf       Not supported.
+*
+*               ip_opts_buf_len     Not supported.
+*
+*               p_ip_opts_len       Not supported.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       NET_SOCK_ERR_NONE                   Datagram received.
+*                                       NET_SOCK_ERR_RX_Q_EMPTY             No datagram before the timeout.
+*                                       NET_SOCK_ERR_INVALID_SOCK           Invalid socket ID.
+*                                       NET_ERR_RX                          Host receive error.
+*
+* Return(s)   : Number of octets received, if NO error.
+*
+*               NET_SOCK_BSD_ERR_RX,       otherwise.
+*
+* Note(s)     : (1) See Notes #2 & #3 at the top of this file.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_RxDataFrom (NET_SOCK_ID         sock_id,
+                                       void               *p_data_buf,
+                                       CPU_INT16U          data_buf_len,
+                                       CPU_INT16S          flags,
+                                       NET_SOCK_ADDR      *p_addr_remote,
+                                       NET_SOCK_ADDR_LEN  *p_addr_len,
+                                       void               *p_ip_opts_buf,
+                                       CPU_INT08U          ip_opts_buf_len,
+                                       CPU_INT08U         *p_ip_opts_len,
+                                       NET_ERR            *p_err)
+{
+    NET_BSD_SOCK             *p_sock;
+    NET_BSD_PKT              *p_pkt;
+    struct  sockaddr_storage  ss;
+    socklen_t                 ss_len;
+    struct  pollfd            pfd;
+    struct  timespec          ts;
+    CPU_INT64U                ts_end_ms;
+    CPU_INT64U                ts_now_ms;
+    CPU_INT64U                ts_next_us;
+    CPU_INT64U                ts_now_us;
+    int                       timeout_ms;
+    int                       hold_ms;
+    CPU_BOOLEAN               infinite;
+    CPU_BOOLEAN               hold_wait;
+    ssize_t                   len;
+
+
+   (void)p_ip_opts_buf;
+   (void)ip_opts_buf_len;
+    if (p_ip_opts_len != DEF_NULL) {
+       *p_ip_opts_len = 0u;
+    }
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_RX);
+    }
+
+    infinite = DEF_NO;
+    if ((p_sock->Block == DEF_NO) ||
+        (DEF_BIT_IS_SET(flags, NET_SOCK_FLAG_RX_NO_BLOCK) == DEF_YES)) {
+        ts_end_ms = 0u;
+    } else if (p_sock->TimeoutRx_ms == NET_SOCK_TIMEOUT_INFINITE) {
+        infinite  = DEF_YES;
+        ts_end_ms = 0u;
+    } else {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts_end_ms = ((CPU_INT64U)ts.tv_sec * DEF_TIME_NBR_mS_PER_SEC) + ((CPU_INT64U)ts.tv_nsec / 1000000u)
+                  +  p_sock->TimeoutRx_ms;
+    }
+
+    for (;;) {
+        p_pkt = NetBSD_PktHeldProc(sock_id, &ts_next_us);       /* See Note #5.                                         */
+        if (p_pkt != DEF_NULL) {
+            len    = (ssize_t)DEF_MIN(p_pkt->Len, data_buf_len);
+            ss     = p_pkt->Addr;
+            ss_len = p_pkt->AddrLen;
+            Mem_Copy(p_data_buf, p_pkt->Data, (CPU_SIZE_T)len);
+            free(p_pkt);
+            break;
+        }
+
+        if (infinite == DEF_YES) {
+            timeout_ms = -1;
+        } else {
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            ts_now_ms  = ((CPU_INT64U)ts.tv_sec * DEF_TIME_NBR_mS_PER_SEC) + ((CPU_INT64U)ts.tv_nsec / 1000000u);
+            timeout_ms = (ts_end_ms > ts_now_ms) ? (int)(ts_end_ms - ts_now_ms) : 0;
+        }
+        hold_wait = DEF_NO;
+        if (ts_next_us != NET_BSD_TS_NONE) {                    /* Wake up when the next held pkt is due.               */
+            ts_now_us = NetBSD_TimeGet_us();
+            hold_ms   = (ts_next_us > ts_now_us) ? (int)((ts_next_us - ts_now_us + 999u) / 1000u) : 0;
+            if ((timeout_ms < 0) ||
+                (hold_ms    < timeout_ms)) {
+                timeout_ms = hold_ms;
+                hold_wait  = DEF_YES;
+            }
+        }
+
+        pfd.fd      = p_sock->FD;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1u, timeout_ms) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+           *p_err = NET_ERR_RX;
+            return (NET_SOCK_BSD_ERR_RX);
+        }
+        if ((pfd.revents & (POLLIN | POLLERR)) == 0) {
+            if (hold_wait == DEF_YES) {
+                continue;
+            }
+           *p_err = NET_SOCK_ERR_RX_Q_EMPTY;
+            return (NET_SOCK_BSD_ERR_RX);
+        }
+
+        ss_len = sizeof(ss);
+        len    = recvfrom(p_sock->FD,
+                          p_data_buf,
+                          data_buf_len,
+                          MSG_DONTWAIT,
+                          (struct sockaddr *)&ss,
+                         &ss_len);
+        if (len >= 0) {
+            if (NetBSD_Impair(HOST_NET_IMPAIR_DIR_RX, sock_id, p_data_buf, (CPU_INT32U)len, &ss, ss_len) == DEF_YES) {
+                continue;                                       /* Pkt held or dropped (see Note #5b).                  */
+            }
+            break;
+        }
+        if ((errno != ECONNREFUSED) &&                          /* See Note #1.                                         */
+            (errno != EAGAIN)       &&
+            (errno != EINTR)) {
+           *p_err = NET_ERR_RX;
+            return (NET_SOCK_BSD_ERR_RX);
+        }
+    }
+
+    if (p_addr_remote != DEF_NULL) {
+        NetBSD_AddrFromHost(&ss, p_addr_remote);
+    }
+    if (p_addr_len != DEF_NULL) {
+       *p_addr_len = sizeof(NET_SOCK_ADDR);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return ((NET_SOCK_RTN_CODE)len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetSock_TxDataTo()
+*
+* Description : Transmit a datagram to a remote address.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_TxDataTo (NET_SOCK_ID         sock_id,
+                                     void               *p_data,
+                                     CPU_INT16U          data_len,
+                                     CPU_INT16S          flags,
+                                     NET_SOCK_ADDR      *p_addr_remote,
+                                     NET_SOCK_ADDR_LEN   addr_len,
+                                     NET_ERR            *p_err)
+{
+    NET_BSD_SOCK             *p_sock;
+    struct  sockaddr_storage  ss;
+    socklen_t                 ss_len;
+    ssize_t                   len;
+
+
+   (void)flags;
+   (void)addr_len;
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+
+    ss_len = NetBSD_AddrToHost(p_addr_remote, &ss);
+    if (ss_len == 0u) {
+       *p_err = NET_SOCK_ERR_INVALID_ADDR;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+
+   (void)NetBSD_PktHeldProc(NET_SOCK_ID_NONE, DEF_NULL);        /* Tx due held pkts first (see Note #5a).               */
+    if (NetBSD_Impair(HOST_NET_IMPAIR_DIR_TX, sock_id, p_data, data_len, &ss, ss_len) == DEF_YES) {
+       *p_err = NET_SOCK_ERR_NONE;                              /* Pkt held or dropped.                                 */
+        return ((NET_SOCK_RTN_CODE)data_len);
+    }
+
+    len = sendto(p_sock->FD, p_data, data_len, 0, (struct sockaddr *)&ss, ss_len);
+    if (len < 0) {
+       *p_err = NET_ERR_TX;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return ((NET_SOCK_RTN_CODE)len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          NetSock_TxData()
+*
+* Description : Transmit a datagram on a connected socket.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_TxData (NET_SOCK_ID   sock_id,
+                                   void         *p_data,
+                                   CPU_INT16U    data_len,
+                                   CPU_INT16S    flags,
+                                   NET_ERR      *p_err)
+{
+    NET_BSD_SOCK  *p_sock;
+    ssize_t        len;
+
+
+   (void)flags;
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+
+   (void)NetBSD_PktHeldProc(NET_SOCK_ID_NONE, DEF_NULL);        /* Tx due held pkts first (see Note #5a).               */
+    if (NetBSD_Impair(HOST_NET_IMPAIR_DIR_TX, sock_id, p_data, data_len, DEF_NULL, 0u) == DEF_YES) {
+       *p_err = NET_SOCK_ERR_NONE;                              /* Pkt held or dropped.                                 */
+        return ((NET_SOCK_RTN_CODE)data_len);
+    }
+
+    len = send(p_sock->FD, p_data, data_len, 0);
+    if ((len < 0) && (errno == ECONNREFUSED)) {                 /* Pending ICMP err from a previous datagram.           */
+        len = send(p_sock->FD, p_data, data_len, 0);
+    }
+    if (len < 0) {
+       *p_err = NET_ERR_TX;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return ((NET_SOCK_RTN_CODE)len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            NetSock_Sel()
+*
+* Description : Wait until one of the sockets in the read descriptor set has a datagram queued.
+*
+* Argument(s) : sock_nbr_max        Highest socket ID in the descriptor sets, plus one.
+*
+*               p_sock_desc_rd      Read descriptor set; on return, contains the ready sockets.
+*
+*               p_sock_desc_wr      Not supported, cleared on return.
+*
+*               p_sock_desc_err     Not supported, cleared on return.
+*
+*               p_timeout           Pointer to timeout; NULL waits forever.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       NET_SOCK_ERR_NONE                   Sockets ready, or timeout with 0 ready.
+*                                       NET_SOCK_ERR_INVALID_SOCK           Invalid socket in a descriptor set.
+*
+* Return(s)   : Number of ready sockets, if NO error.
+*
+*               NET_SOCK_BSD_ERR_SEL,    otherwise.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Sel (NET_SOCK_QTY        sock_nbr_max,
+                                NET_SOCK_DESC      *p_sock_desc_rd,
+                                NET_SOCK_DESC      *p_sock_desc_wr,
+                                NET_SOCK_DESC      *p_sock_desc_err,
+                                NET_SOCK_TIMEOUT   *p_timeout,
+                                NET_ERR            *p_err)
+{
+    struct  pollfd   pfd[NET_SOCK_CFG_NBR_SOCK];
+    NET_SOCK_ID      id_tbl[NET_SOCK_CFG_NBR_SOCK];
+    NET_BSD_SOCK    *p_sock;
+    NET_SOCK_ID      sock_id;
+    nfds_t           nbr_fd;
+    nfds_t           ix;
+    int              timeout_ms;
+    int              rtn;
+
+
+    if (sock_nbr_max > NET_SOCK_CFG_NBR_SOCK) {
+        sock_nbr_max = NET_SOCK_CFG_NBR_SOCK;
+    }
+
+    nbr_fd = 0u;
+    if (p_sock_desc_rd != DEF_NULL) {
+        for (sock_id = 0; sock_id < (NET_SOCK_ID)sock_nbr_max; sock_id++) {
+            if (NET_SOCK_DESC_IS_SET(sock_id, p_sock_desc_rd) == DEF_NO) {
+                continue;
+            }
+            p_sock = NetBSD_SockGet(sock_id);
+            if (p_sock == DEF_NULL) {
+               *p_err = NET_SOCK_ERR_INVALID_SOCK;
+                return (NET_SOCK_BSD_ERR_SEL);
+            }
+            pfd[nbr_fd].fd      = p_sock->FD;
+            pfd[nbr_fd].events  = POLLIN;
+            pfd[nbr_fd].revents = 0;
+            id_tbl[nbr_fd]      = sock_id;
+            nbr_fd++;
+        }
+        NET_SOCK_DESC_INIT(p_sock_desc_rd);
+    }
+    if (p_sock_desc_wr != DEF_NULL) {
+        NET_SOCK_DESC_INIT(p_sock_desc_wr);
+    }
+    if (p_sock_desc_err != DEF_NULL) {
+        NET_SOCK_DESC_INIT(p_sock_desc_err);
+    }
+
+    timeout_ms = -1;
+    if (p_timeout != DEF_NULL) {
+        timeout_ms = (int)((p_timeout->timeout_sec * DEF_TIME_NBR_mS_PER_SEC) +
+                           (p_timeout->timeout_us  / (DEF_TIME_NBR_uS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC)));
+    }
+
+    do {
+        rtn = poll(pfd, nbr_fd, timeout_ms);
+    } while ((rtn < 0) && (errno == EINTR));
+    if (rtn < 0) {
+       *p_err = NET_ERR_RX;
+        return (NET_SOCK_BSD_ERR_SEL);
+    }
+
+    rtn = 0;
+    for (ix = 0u; ix < nbr_fd; ix++) {
+        if ((pfd[ix].revents & (POLLIN | POLLERR)) != 0) {
+            NET_SOCK_DESC_SET(id_tbl[ix], p_sock_desc_rd);
+            rtn++;
+        }
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return ((NET_SOCK_RTN_CODE)rtn);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetSock_CfgBlock()
+*
+* Description : Configure the blocking mode of a socket.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetSock_CfgBlock (NET_SOCK_ID   sock_id,
+                               CPU_INT08U    block,
+                               NET_ERR      *p_err)
+{
+    NET_BSD_SOCK  *p_sock;
+
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (DEF_FAIL);
+    }
+
+    p_sock->Block = (block == NET_SOCK_BLOCK_SEL_NO_BLOCK) ? DEF_NO : DEF_YES;
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     NetSock_CfgTimeoutRxQ_Set()
+*
+* Description : Configure the receive timeout of a socket, in milliseconds (0 : infinite).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetSock_CfgTimeoutRxQ_Set (NET_SOCK_ID   sock_id,
+                                        CPU_INT32U    timeout_ms,
+                                        NET_ERR      *p_err)
+{
+    NET_BSD_SOCK  *p_sock;
+
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (DEF_FAIL);
+    }
+
+    p_sock->TimeoutRx_ms = timeout_ms;
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                   NetSock_CfgTimeoutRxQ_Get_ms()
+*
+* Description : Get the receive timeout of a socket, in milliseconds.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  NetSock_CfgTimeoutRxQ_Get_ms (NET_SOCK_ID   sock_id,
+                                          NET_ERR      *p_err)
+{
+    NET_BSD_SOCK  *p_sock;
+
+
+    p_sock = NetBSD_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (0u);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (p_sock->TimeoutRx_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                NetApp_ClientDatagramOpenByHostname()
+*
+* Description : Resolve a host name or address string & open a datagram socket towards it.
+*
+* Argument(s) : p_sock_id           Pointer to variable that will receive the socket ID.
+*
+*               p_remote_host_name  Host name, or IPv4/IPv6 address string.
+*
+*               remote_port_nbr     Remote port number.
+*
+*               ip_family           Family resolved : NET_IP_ADDR_FAMILY_IPv4/IPv6, or NET_IP_ADDR_FAMILY_NONE
+*                                   for any family.  NOT used for an address string (see Note #1).
+*
+*               p_sock_addr         Pointer to variable that will receive the remote socket address.
+*
+*               p_is_hostname       Pointer to variable that will receive DEF_YES if a host name was resolved.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       NET_APP_ERR_NONE                    Socket opened.
+*                                       NET_APP_ERR_INVALID_ARG             Host name could not be resolved.
+*                                       NET_APP_ERR_NONE_AVAIL              No socket available.
+*
+* Return(s)   : Address family of the opened socket, if NO error.
+*
+*               NET_IP_ADDR_FAMILY_NONE,               otherwise.
+*
+* Note(s)     : (1) As with uC/TCP-IP, the family of an address string is the family of the address, whatever
+*                   the family requested.
+*********************************************************************************************************
+*/
+
+NET_IP_ADDR_FAMILY  NetApp_ClientDatagramOpenByHostname (NET_SOCK_ID         *p_sock_id,
+                                                         CPU_CHAR            *p_remote_host_name,
+                                                         NET_PORT_NBR         remote_port_nbr,
+                                                         NET_IP_ADDR_FAMILY   ip_family,
+                                                         NET_SOCK_ADDR       *p_sock_addr,
+                                                         CPU_BOOLEAN         *p_is_hostname,
+                                                         NET_ERR             *p_err)
+{
+    struct  addrinfo           hints;
+    struct  addrinfo          *p_res;
+    struct  in_addr            addr_v4;
+    struct  in6_addr           addr_v6;
+    struct  sockaddr_storage   ss;
+    NET_SOCK_PROTOCOL_FAMILY   protocol_family;
+    NET_IP_ADDR_FAMILY         family_rtn;
+    NET_SOCK_ADDR_IPv4        *p_addr_v4;
+    NET_SOCK_ADDR_IPv6        *p_addr_v6;
+    NET_ERR                    err;
+
+
+    if (p_remote_host_name == DEF_NULL) {
+       *p_err = NET_APP_ERR_INVALID_ARG;
+        return (NET_IP_ADDR_FAMILY_NONE);
+    }
+
+   *p_is_hostname = DEF_NO;
+    if (inet_pton(AF_INET, p_remote_host_name, &addr_v4) == 1) {
+        Mem_Clr(&ss, sizeof(ss));
+        ((struct sockaddr_in *)&ss)->sin_family = AF_INET;
+        ((struct sockaddr_in *)&ss)->sin_addr   = addr_v4;
+    } else if (inet_pton(AF_INET6, p_remote_host_name, &addr_v6) == 1) {
+        Mem_Clr(&ss, sizeof(ss));
+        ((struct sockaddr_in6 *)&ss)->sin6_family = AF_INET6;
+        ((struct sockaddr_in6 *)&ss)->sin6_addr   = addr_v6;
+    } else {
+        Mem_Clr(&hints, sizeof(hints));
+        hints.ai_family   = (ip_family == NET_IP_ADDR_FAMILY_IPv4) ? AF_INET
+                          : (ip_family == NET_IP_ADDR_FAMILY_IPv6) ? AF_INET6
+                          :                                          AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+        if (getaddrinfo(p_remote_host_name, DEF_NULL, &hints, &p_res) != 0) {
+           *p_err = NET_APP_ERR_INVALID_ARG;
+            return (NET_IP_ADDR_FAMILY_NONE);
+        }
+        Mem_Clr(&ss, sizeof(ss));
+        Mem_Copy(&ss, p_res->ai_addr, p_res->ai_addrlen);
+        freeaddrinfo(p_res);
+       *p_is_hostname = DEF_YES;
+    }
+
+    Mem_Clr(p_sock_addr, sizeof(NET_SOCK_ADDR));
+    if (ss.ss_family == AF_INET) {
+        p_addr_v4             = (NET_SOCK_ADDR_IPv4 *)p_sock_addr;
+        p_addr_v4->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V4;
+        p_addr_v4->Port       =  NET_UTIL_HOST_TO_NET_16(remote_port_nbr);
+        p_addr_v4->Addr       = ((struct sockaddr_in *)&ss)->sin_addr.s_addr;
+        protocol_family       =  NET_SOCK_PROTOCOL_FAMILY_IP_V4;
+        family_rtn            =  NET_IP_ADDR_FAMILY_IPv4;
+    } else {
+        p_addr_v6             = (NET_SOCK_ADDR_IPv6 *)p_sock_addr;
+        p_addr_v6->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V6;
+        p_addr_v6->Port       =  NET_UTIL_HOST_TO_NET_16(remote_port_nbr);
+        Mem_Copy(&p_addr_v6->Addr, &((struct sockaddr_in6 *)&ss)->sin6_addr, NET_IPv6_ADDR_LEN);
+        protocol_family       =  NET_SOCK_PROTOCOL_FAMILY_IP_V6;
+        family_rtn            =  NET_IP_ADDR_FAMILY_IPv6;
+    }
+
+   *p_sock_id = NetSock_Open(protocol_family, NET_SOCK_TYPE_DATAGRAM, NET_SOCK_PROTOCOL_UDP, &err);
+    if (err != NET_SOCK_ERR_NONE) {
+       *p_err = NET_APP_ERR_NONE_AVAIL;
+        return (NET_IP_ADDR_FAMILY_NONE);
+    }
+
+   *p_err = NET_APP_ERR_NONE;
+
+    return (family_rtn);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetIF_GetDflt()
+*
+* Description : Get the default interface number.
+*********************************************************************************************************
+*/
+
+NET_IF_NBR  NetIF_GetDflt (void)
+{
+    return (NET_IF_NBR_DFLT);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetIF_MTU_Get()
+*
+* Description : Get the MTU of an interface (see HostNet_IF_MTU_Set()).
+*********************************************************************************************************
+*/
+
+NET_MTU  NetIF_MTU_Get (NET_IF_NBR   if_nbr,
+                        NET_ERR     *p_err)
+{
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return (0u);
+    }
+
+   *p_err = NET_IF_ERR_NONE;
+
+    return (NetBSD_IF_MTU);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetIF_AddrHW_Get()
+*
+* Description : Get the hardware address of an interface.  The host port reports a fixed, locally
+*               administered address.
+*********************************************************************************************************
+*/
+
+void  NetIF_AddrHW_Get (NET_IF_NBR   if_nbr,
+                        CPU_INT08U  *p_addr_hw,
+                        CPU_INT08U  *p_addr_len,
+                        NET_ERR     *p_err)
+{
+    static  const  CPU_INT08U  addr_hw[NET_IF_HW_ADDR_LEN_MAX] = { 0x02u, 0x00u, 0x00u, 0x00u, 0x00u, 0x01u };
+
+
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return;
+    }
+    if (*p_addr_len < NET_IF_HW_ADDR_LEN_MAX) {
+       *p_err = NET_ERR_INVALID_ARG;
+        return;
+    }
+
+    Mem_Copy(p_addr_hw, addr_hw, NET_IF_HW_ADDR_LEN_MAX);
+   *p_addr_len = NET_IF_HW_ADDR_LEN_MAX;
+   *p_err      = NET_IF_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetIGMP_HostGrpJoin()
+*
+* Description : Join an IPv4 multicast group (see Note #4 at the top of this file).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetIGMP_HostGrpJoin (NET_IF_NBR      if_nbr,
+                                  NET_IPv4_ADDR   addr_grp,
+                                  NET_ERR        *p_err)
+{
+    CPU_INT08U  ix;
+
+
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return (DEF_FAIL);
+    }
+
+    for (ix = 0u; ix < NET_BSD_IGMP_GRP_NBR_MAX; ix++) {
+        if (NetBSD_IGMP_GrpTbl[ix] == 0u) {
+            break;
+        }
+    }
+    if (ix >= NET_BSD_IGMP_GRP_NBR_MAX) {
+       *p_err = NET_IGMP_ERR_HOST_GRP_NONE_AVAIL;
+        return (DEF_FAIL);
+    }
+
+    if (NetBSD_GrpMembership(addr_grp, IP_ADD_MEMBERSHIP) != DEF_OK) {
+       *p_err = NET_IGMP_ERR_HOST_GRP_NONE_AVAIL;
+        return (DEF_FAIL);
+    }
+    NetBSD_IGMP_GrpTbl[ix] = addr_grp;
+
+   *p_err = NET_IGMP_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetIGMP_HostGrpLeave()
+*
+* Description : Leave an IPv4 multicast group.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetIGMP_HostGrpLeave (NET_IF_NBR      if_nbr,
+                                   NET_IPv4_ADDR   addr_grp,
+                                   NET_ERR        *p_err)
+{
+    CPU_INT08U  ix;
+
+
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return (DEF_FAIL);
+    }
+
+    for (ix = 0u; ix < NET_BSD_IGMP_GRP_NBR_MAX; ix++) {
+        if (NetBSD_IGMP_GrpTbl[ix] == addr_grp) {
+            break;
+        }
+    }
+    if (ix >= NET_BSD_IGMP_GRP_NBR_MAX) {
+       *p_err = NET_IGMP_ERR_HOST_GRP_NOT_FOUND;
+        return (DEF_FAIL);
+    }
+
+   (void)NetBSD_GrpMembership(addr_grp, IP_DROP_MEMBERSHIP);
+    NetBSD_IGMP_GrpTbl[ix] = 0u;
+
+   *p_err = NET_IGMP_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          NetBSD_SockGet()
+*
+* Description : Get the table entry of an open socket.
+*
+* Return(s)   : Pointer to socket entry, if socket ID is valid & open.
+*
+*               NULL,                     otherwise.
+*********************************************************************************************************
+*/
+
+static  NET_BSD_SOCK  *NetBSD_SockGet (NET_SOCK_ID  sock_id)
+{
+    if ((sock_id <  0) ||
+        (sock_id >= (NET_SOCK_ID)NET_SOCK_CFG_NBR_SOCK)) {
+        return (DEF_NULL);
+    }
+    if (NetBSD_SockTbl[sock_id].Used == DEF_NO) {
+        return (DEF_NULL);
+    }
+
+    return (&NetBSD_SockTbl[sock_id]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetBSD_AddrToHost()
+*
+* Description : Convert a uC/TCP-IP socket address to a host socket address.
+*
+* Return(s)   : Length of the host socket address, if NO error.
+*
+*               0,                                 otherwise.
+*********************************************************************************************************
+*/
+
+static  socklen_t  NetBSD_AddrToHost (const NET_SOCK_ADDR      *p_addr,
+                                      struct  sockaddr_storage *p_ss)
+{
+    const  NET_SOCK_ADDR_IPv4  *p_addr_v4;
+    const  NET_SOCK_ADDR_IPv6  *p_addr_v6;
+    struct  sockaddr_in        *p_sin;
+    struct  sockaddr_in6       *p_sin6;
+
+
+    if (p_addr == DEF_NULL) {
+        return (0u);
+    }
+
+    Mem_Clr(p_ss, sizeof(*p_ss));
+    switch (p_addr->AddrFamily) {
+        case NET_SOCK_ADDR_FAMILY_IP_V4:
+             p_addr_v4               = (const NET_SOCK_ADDR_IPv4 *)p_addr;
+             p_sin                   = (struct sockaddr_in *)p_ss;
+             p_sin->sin_family       =  AF_INET;
+             p_sin->sin_port         =  p_addr_v4->Port;
+             p_sin->sin_addr.s_addr  =  p_addr_v4->Addr;
+             return (sizeof(struct sockaddr_in));
+
+        case NET_SOCK_ADDR_FAMILY_IP_V6:
+             p_addr_v6               = (const NET_SOCK_ADDR_IPv6 *)p_addr;
+             p_sin6                  = (struct sockaddr_in6 *)p_ss;
+             p_sin6->sin6_family     =  AF_INET6;
+             p_sin6->sin6_port       =  p_addr_v6->Port;
+             p_sin6->sin6_flowinfo   =  p_addr_v6->FlowInfo;
+             p_sin6->sin6_scope_id   =  p_addr_v6->ScopeID;
+             Mem_Copy(&p_sin6->sin6_addr, &p_addr_v6->Addr, NET_IPv6_ADDR_LEN);
+             return (sizeof(struct sockaddr_in6));
+
+        default:
+             return (0u);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetBSD_AddrFromHost()
+*
+* Description : Convert a host socket address to a uC/TCP-IP socket address.
+*********************************************************************************************************
+*/
+
+static  void  NetBSD_AddrFromHost (const struct  sockaddr_storage *p_ss,
+                                   NET_SOCK_ADDR            *p_addr)
+{
+    NET_SOCK_ADDR_IPv4  *p_addr_v4;
+    NET_SOCK_ADDR_IPv6  *p_addr_v6;
+
+
+    Mem_Clr(p_addr, sizeof(NET_SOCK_ADDR));
+    if (p_ss->ss_family == AF_INET) {
+        p_addr_v4             = (NET_SOCK_ADDR_IPv4 *)p_addr;
+        p_addr_v4->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V4;
+        p_addr_v4->Port       = ((const struct sockaddr_in *)p_ss)->sin_port;
+        p_addr_v4->Addr       = ((const struct sockaddr_in *)p_ss)->sin_addr.s_addr;
+    } else if (p_ss->ss_family == AF_INET6) {
+        p_addr_v6             = (NET_SOCK_ADDR_IPv6 *)p_addr;
+        p_addr_v6->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V6;
+        p_addr_v6->Port       = ((const struct sockaddr_in6 *)p_ss)->sin6_port;
+        p_addr_v6->FlowInfo   = ((const struct sockaddr_in6 *)p_ss)->sin6_flowinfo;
+        p_addr_v6->ScopeID    = ((const struct sockaddr_in6 *)p_ss)->sin6_scope_id;
+        Mem_Copy(&p_addr_v6->Addr, &((const struct sockaddr_in6 *)p_ss)->sin6_addr, NET_IPv6_ADDR_LEN);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                       NetBSD_GrpMembership()
+*
+* Description : Add or drop a multicast group membership on every open IPv4 socket.
+*
+* Argument(s) : addr_grp    Group address, in host order.
+*
+*               opt         IP_ADD_MEMBERSHIP or IP_DROP_MEMBERSHIP.
+*
+* Return(s)   : DEF_OK,   if the option was applied to at least one socket, or no IPv4 socket is open.
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  NetBSD_GrpMembership (NET_IPv4_ADDR  addr_grp,
+                                           int            opt)
+{
+    struct  ip_mreq   mreq;
+    NET_SOCK_ID       sock_id;
+    CPU_BOOLEAN       found;
+    CPU_BOOLEAN       ok;
+
+
+    mreq.imr_multiaddr.s_addr = htonl(addr_grp);
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    found = DEF_NO;
+    ok    = DEF_NO;
+    pthread_mutex_lock(&NetBSD_Lock);
+    for (sock_id = 0; sock_id < (NET_SOCK_ID)NET_SOCK_CFG_NBR_SOCK; sock_id++) {
+        if ((NetBSD_SockTbl[sock_id].Used   == DEF_NO) ||
+            (NetBSD_SockTbl[sock_id].Family != AF_INET)) {
+            continue;
+        }
+        found = DEF_YES;
+        if (setsockopt(NetBSD_SockTbl[sock_id].FD, IPPROTO_IP, opt, &mreq, sizeof(mreq)) == 0) {
+            ok = DEF_YES;
+        }
+    }
+    pthread_mutex_unlock(&NetBSD_Lock);
+
+    return (((found == DEF_NO) || (ok == DEF_YES)) ? DEF_OK : DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetBSD_TimeGet_us()
+*
+* Description : Get the monotonic time, in microseconds.
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U  NetBSD_TimeGet_us (void)
+{
+    struct  timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (((CPU_INT64U)ts.tv_sec * 1000000u) + ((CPU_INT64U)ts.tv_nsec / 1000u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetBSD_Impair()
+*
+* Description : Apply the impairments of a direction to a packet (see Note #5).
+*
+* Argument(s) : dir         HOST_NET_IMPAIR_DIR_TX or HOST_NET_IMPAIR_DIR_RX.
+*
+*               sock_id     Socket the packet is tx'd on or rx'd from.
+*
+*               p_data      Pointer to packet.
+*
+*               len         Packet length, in octets.
+*
+*               p_ss        Pointer to destination (tx) or source (rx) address; NULL for a connected tx.
+*
+*               ss_len      Address length.
+*
+* Return(s)   : DEF_YES, if the packet was held or dropped.
+*
+*               DEF_NO,  if the direction is not impaired : the caller handles the packet.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  NetBSD_Impair (       CPU_INT08U                 dir,
+                                           NET_SOCK_ID                sock_id,
+                                    const  void                      *p_data,
+                                           CPU_INT32U                 len,
+                                    const  struct  sockaddr_storage  *p_ss,
+                                           socklen_t                  ss_len)
+{
+    HOST_IMPAIR_PKT  pkt;
+    CPU_INT08U       fate;
+
+
+    pthread_mutex_lock(&NetBSD_Lock);
+    if (NetBSD_ImpairEn[dir] == DEF_NO) {
+        pthread_mutex_unlock(&NetBSD_Lock);
+        return (DEF_NO);
+    }
+
+    fate = HostImpair_Tx(&NetBSD_ImpairTbl[dir], NetBSD_TimeGet_us(), len, &pkt);
+    switch (fate) {
+        case HOST_IMPAIR_PKT_LOSS:
+             NetBSD_ImpairStats.PktLossCtr++;
+             break;
+
+
+        case HOST_IMPAIR_PKT_QUEUE_DROP:
+             NetBSD_ImpairStats.PktQueueDropCtr++;
+             break;
+
+
+        case HOST_IMPAIR_PKT_DELIVER:
+        default:
+             if (pkt.Reorder == DEF_YES) {
+                 NetBSD_ImpairStats.PktReorderCtr++;
+             }
+             NetBSD_PktHold(dir, sock_id, pkt.TS_Deliver_us, p_data, len, p_ss, ss_len);
+             if (pkt.Dup == DEF_YES) {                          /* Dup delivered right after the original.              */
+                 NetBSD_ImpairStats.PktDupCtr++;
+                 NetBSD_PktHold(dir, sock_id, pkt.TS_Deliver_us, p_data, len, p_ss, ss_len);
+             }
+             break;
+    }
+    pthread_mutex_unlock(&NetBSD_Lock);
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          NetBSD_PktHold()
+*
+* Description : Add a copy of a packet to the held packet list.
+*
+* Argument(s) : dir             HOST_NET_IMPAIR_DIR_TX or HOST_NET_IMPAIR_DIR_RX.
+*
+*               sock_id         Socket the packet is tx'd on or rx'd from.
+*
+*               ts_deliver_us   Delivery time of the packet.
+*
+*               p_data          Pointer to packet.
+*
+*               len             Packet length, in octets.
+*
+*               p_ss            Pointer to address, or NULL.
+*
+*               ss_len          Address length.
+*
+* Return(s)   : none.
+*
+* Note(s)     : (1) The list is kept sorted by delivery time; packets due at the same time are delivered in
+*                   the order they were held.
+*
+*               (2) A packet that cannot be allocated is dropped, as a host stack would.
+*
+*               (3) The caller MUST hold 'NetBSD_Lock'.
+*********************************************************************************************************
+*/
+
+static  void  NetBSD_PktHold (       CPU_INT08U                 dir,
+                                     NET_SOCK_ID                sock_id,
+                                     CPU_INT64U                 ts_deliver_us,
+                              const  void                      *p_data,
+                                     CPU_INT32U                 len,
+                              const  struct  sockaddr_storage  *p_ss,
+                                     socklen_t                  ss_len)
+{
+    NET_BSD_PKT   *p_pkt;
+    NET_BSD_PKT  **pp_next;
+
+
+    p_pkt = (NET_BSD_PKT *)malloc(sizeof(NET_BSD_PKT) + len);
+    if (p_pkt == DEF_NULL) {                                    /* See Note #2.                                         */
+        return;
+    }
+
+    p_pkt->TS_Deliver_us = ts_deliver_us;
+    p_pkt->Dir           = dir;
+    p_pkt->SockID        = sock_id;
+    p_pkt->AddrLen       = 0u;
+    p_pkt->Len           = len;
+    if (p_ss != DEF_NULL) {
+        p_pkt->Addr    = *p_ss;
+        p_pkt->AddrLen =  ss_len;
+    }
+    Mem_Copy(p_pkt->Data, p_data, len);
+
+    pp_next = &NetBSD_PktHeldPtr;                               /* See Note #1.                                         */
+    while ((*pp_next != DEF_NULL) &&
+           ((*pp_next)->TS_Deliver_us <= ts_deliver_us)) {
+        pp_next = &(*pp_next)->NextPtr;
+    }
+    p_pkt->NextPtr = *pp_next;
+   *pp_next        =  p_pkt;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetBSD_PktHeldProc()
+*
+* Description : (1) Process the held packet list :
+*
+*                   (a) Transmit the held tx'd packets that are due.
+*                   (b) Get the first held rx'd packet of a socket that is due.
+*
+* Argument(s) : sock_id         Socket to get a rx'd packet for; NET_SOCK_ID_NONE to only transmit.
+*
+*               p_ts_next_us    Pointer to variable that will receive the delivery time of the next held
+*                               packet that this socket waits for (any tx'd packet or a rx'd packet of
+*                               'sock_id'), or NET_BSD_TS_NONE; may be NULL.
+*
+* Return(s)   : Pointer to the rx'd packet, removed from the list, if one is due; the caller frees it.
+*
+*               NULL,                                                   otherwise.
+*
+* Note(s)     : (2) A held tx'd packet is sent even if the sender gets no reply : the send error, if any,
+*                   is ignored, as for a packet lost on the link.
+*********************************************************************************************************
+*/
+
+static  NET_BSD_PKT  *NetBSD_PktHeldProc (NET_SOCK_ID   sock_id,
+                                          CPU_INT64U   *p_ts_next_us)
+{
+    NET_BSD_PKT   *p_pkt;
+    NET_BSD_PKT   *p_pkt_rx;
+    NET_BSD_PKT  **pp_pkt;
+    CPU_INT64U     ts_now_us;
+    CPU_INT64U     ts_next_us;
+    int            fd;
+
+
+    p_pkt_rx   = DEF_NULL;
+    ts_next_us = NET_BSD_TS_NONE;
+    ts_now_us  = NetBSD_TimeGet_us();
+
+    pthread_mutex_lock(&NetBSD_Lock);
+    pp_pkt = &NetBSD_PktHeldPtr;
+    while (*pp_pkt != DEF_NULL) {
+        p_pkt = *pp_pkt;
+        if ((p_pkt->Dir    == HOST_NET_IMPAIR_DIR_RX) &&
+            (p_pkt->SockID != sock_id)) {                       /* Rx'd pkt of another sock.                            */
+            pp_pkt = &p_pkt->NextPtr;
+            continue;
+        }
+        if (p_pkt->TS_Deliver_us > ts_now_us) {                 /* List sorted : no later pkt is due.                   */
+            ts_next_us = p_pkt->TS_Deliver_us;
+            break;
+        }
+
+        if (p_pkt->Dir == HOST_NET_IMPAIR_DIR_RX) {             /* See Note #1b.                                        */
+            if (p_pkt_rx == DEF_NULL) {
+               *pp_pkt   = p_pkt->NextPtr;
+                p_pkt_rx = p_pkt;
+            } else {
+                pp_pkt   = &p_pkt->NextPtr;
+            }
+            continue;
+        }
+
+       *pp_pkt = p_pkt->NextPtr;                                /* See Note #1a.                                        */
+        fd     = NetBSD_SockTbl[p_pkt->SockID].FD;
+        if (p_pkt->AddrLen > 0u) {                              /* See Note #2.                                         */
+           (void)sendto(fd, p_pkt->Data, p_pkt->Len, 0, (struct sockaddr *)&p_pkt->Addr, p_pkt->AddrLen);
+        } else {
+           (void)send(fd, p_pkt->Data, p_pkt->Len, 0);
+        }
+        free(p_pkt);
+    }
+    pthread_mutex_unlock(&NetBSD_Lock);
+
+    if (p_ts_next_us != DEF_NULL) {
+       *p_ts_next_us = ts_next_us;
+    }
+
+    return (p_pkt_rx);
+}
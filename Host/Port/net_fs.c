@@ -0,0 +1,317 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                HOST PORT : NETWORK FILE SYSTEM ON STDIO
+*
+* Filename : net_fs.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) See 'FS/net_fs.h'.  The file handles returned are stdio streams.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+
+#include  <FS/net_fs.h>
+
+#include  <errno.h>
+#include  <stdio.h>
+#include  <sys/stat.h>
+#include  <sys/types.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          NetFS_FileOpen()
+*
+* Description : Open a file.
+*
+* Argument(s) : p_name      Pointer to host path of the file.
+*
+*               mode        File mode :
+*
+*                               NET_FS_FILE_MODE_APPEND         Open or create, wr at end of file.
+*                               NET_FS_FILE_MODE_CREATE         Create, or truncate an existing file.
+*                               NET_FS_FILE_MODE_CREATE_NEW     Create, fail if the file exists.
+*                               NET_FS_FILE_MODE_OPEN           Open an existing file.
+*                               NET_FS_FILE_MODE_TRUNCATE       Truncate an existing file.
+*
+*               access      File access (NET_FS_FILE_ACCESS_RD, _WR or _RD_WR).
+*
+* Return(s)   : Pointer to file handle, if NO error.
+*
+*               Pointer to NULL,        otherwise.
+*********************************************************************************************************
+*/
+
+void  *NetFS_FileOpen (CPU_CHAR            *p_name,
+                       NET_FS_FILE_MODE     mode,
+                       NET_FS_FILE_ACCESS   access)
+{
+    const  char         *p_fmode;
+           FILE         *p_file;
+           CPU_BOOLEAN   rd;
+
+
+    if (p_name == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    rd = (access != NET_FS_FILE_ACCESS_WR) ? DEF_YES : DEF_NO;
+    switch (mode) {
+        case NET_FS_FILE_MODE_APPEND:
+             p_fmode = (rd == DEF_YES) ? "a+b" : "ab";
+             break;
+
+        case NET_FS_FILE_MODE_CREATE:
+             p_fmode = (rd == DEF_YES) ? "w+b" : "wb";
+             break;
+
+        case NET_FS_FILE_MODE_CREATE_NEW:
+             p_fmode = (rd == DEF_YES) ? "w+xb" : "wxb";
+             break;
+
+        case NET_FS_FILE_MODE_OPEN:
+             p_fmode = (access == NET_FS_FILE_ACCESS_RD) ? "rb" : "r+b";
+             break;
+
+        case NET_FS_FILE_MODE_TRUNCATE:
+             p_file = fopen(p_name, "rb");                      /* File MUST exist.                                     */
+             if (p_file == DEF_NULL) {
+                 return (DEF_NULL);
+             }
+             fclose(p_file);
+             p_fmode = (rd == DEF_YES) ? "w+b" : "wb";
+             break;
+
+        case NET_FS_FILE_MODE_NONE:
+        default:
+             return (DEF_NULL);
+    }
+
+    p_file = fopen(p_name, p_fmode);
+
+    return ((void *)p_file);
+}
+
+
+void  NetFS_FileClose (void  *p_file)
+{
+    if (p_file == DEF_NULL) {
+        return;
+    }
+
+    fclose((FILE *)p_file);
+}
+
+
+CPU_BOOLEAN  NetFS_FileRd (void        *p_file,
+                           void        *p_dest,
+                           CPU_SIZE_T   size,
+                           CPU_SIZE_T  *p_size_rd)
+{
+    CPU_SIZE_T  size_rd;
+
+
+    if (p_size_rd != DEF_NULL) {
+       *p_size_rd  = 0u;
+    }
+    if ((p_file == DEF_NULL) ||
+        (p_dest == DEF_NULL)) {
+        return (DEF_FAIL);
+    }
+
+    size_rd = fread(p_dest, 1u, size, (FILE *)p_file);
+    if (p_size_rd != DEF_NULL) {
+       *p_size_rd  = size_rd;
+    }
+    if ((size_rd < size) && (ferror((FILE *)p_file) != 0)) {
+        clearerr((FILE *)p_file);
+        return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  NetFS_FileWr (void        *p_file,
+                           void        *p_src,
+                           CPU_SIZE_T   size,
+                           CPU_SIZE_T  *p_size_wr)
+{
+    CPU_SIZE_T  size_wr;
+
+
+    if (p_size_wr != DEF_NULL) {
+       *p_size_wr  = 0u;
+    }
+    if ((p_file == DEF_NULL) ||
+        (p_src  == DEF_NULL)) {
+        return (DEF_FAIL);
+    }
+
+    size_wr = fwrite(p_src, 1u, size, (FILE *)p_file);
+    if (p_size_wr != DEF_NULL) {
+       *p_size_wr  = size_wr;
+    }
+
+    return ((size_wr == size) ? DEF_OK : DEF_FAIL);
+}
+
+
+CPU_BOOLEAN  NetFS_FilePosSet (void        *p_file,
+                               CPU_INT32S   offset,
+                               CPU_INT08U   origin)
+{
+    int  whence;
+
+
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    switch (origin) {
+        case NET_FS_SEEK_ORIGIN_START:
+             whence = SEEK_SET;
+             break;
+
+        case NET_FS_SEEK_ORIGIN_CUR:
+             whence = SEEK_CUR;
+             break;
+
+        case NET_FS_SEEK_ORIGIN_END:
+             whence = SEEK_END;
+             break;
+
+        default:
+             return (DEF_FAIL);
+    }
+
+    return ((fseeko((FILE *)p_file, (off_t)offset, whence) == 0) ? DEF_OK : DEF_FAIL);
+}
+
+
+CPU_BOOLEAN  NetFS_FilePosGet (void        *p_file,
+                               CPU_INT32U  *p_pos)
+{
+    off_t  pos;
+
+
+    if ((p_file == DEF_NULL) ||
+        (p_pos  == DEF_NULL)) {
+        return (DEF_FAIL);
+    }
+
+    pos = ftello((FILE *)p_file);
+    if (pos < 0) {
+        return (DEF_FAIL);
+    }
+   *p_pos = (CPU_INT32U)pos;
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  NetFS_FileSizeGet (void        *p_file,
+                                CPU_INT32U  *p_size)
+{
+    struct  stat  st;
+
+
+    if ((p_file == DEF_NULL) ||
+        (p_size == DEF_NULL)) {
+        return (DEF_FAIL);
+    }
+
+    fflush((FILE *)p_file);
+    if (fstat(fileno((FILE *)p_file), &st) != 0) {
+        return (DEF_FAIL);
+    }
+   *p_size = (CPU_INT32U)st.st_size;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetFS_EntryCreate()
+*
+* Description : Create a directory, or an empty file.  An existing directory is NOT an error.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetFS_EntryCreate (CPU_CHAR     *p_name,
+                                CPU_BOOLEAN   dir)
+{
+    FILE  *p_file;
+
+
+    if (p_name == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    if (dir == DEF_YES) {
+        if ((mkdir(p_name, 0777) != 0) && (errno != EEXIST)) {
+            return (DEF_FAIL);
+        }
+        return (DEF_OK);
+    }
+
+    p_file = fopen(p_name, "wxb");
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+    fclose(p_file);
+
+    return (DEF_OK);
+}
+
+
+CPU_BOOLEAN  NetFS_EntryDel (CPU_CHAR     *p_name,
+                             CPU_BOOLEAN   file)
+{
+    int  rtn;
+
+
+    if (p_name == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    rtn = (file == DEF_YES) ? unlink(p_name) : rmdir(p_name);
+
+    return ((rtn == 0) ? DEF_OK : DEF_FAIL);
+}
@@ -0,0 +1,1245 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : SIMULATED NETWORK & CLOCK
+*
+* Filename : host_sim.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) See 'host_sim.h  Note #1'.
+*
+*            (2) Timers are polled in milliseconds; a timer due at 'T' ms fires when the virtual clock reaches
+*                'T' * 1000 us.
+*
+*            (3) A wait that can never end, because no packet is in flight & no timer runs, returns at once
+*                instead of blocking the simulation forever.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "host_sim.h"
+#include  <KAL/kal.h>
+#include  <Source/net_util.h>
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  HOST_SIM_SOCK_NBR_MAX                           128u
+#define  HOST_SIM_SOCK_RX_Q_LEN_MAX                     1024u   /* Max nbr of pkts queued on a sock.                    */
+#define  HOST_SIM_HOST_NBR_MAX                            16u
+#define  HOST_SIM_HOST_NAME_LEN_MAX                       63u
+#define  HOST_SIM_TMR_NBR_MAX                             16u
+#define  HOST_SIM_GRP_NBR_MAX                              4u
+#define  HOST_SIM_IMPAIR_NBR_MAX                           4u
+
+
+#define  HOST_SIM_TS_NONE                   ((CPU_INT64U)-1)
+
+#define  HOST_SIM_ADDR_IS_MCAST(addr)       ((((addr) >> 28) == 0xEu) ? DEF_YES : DEF_NO)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+struct  host_sim_sock {
+    CPU_BOOLEAN             Used;
+    CPU_BOOLEAN             Bound;
+    HOST_SIM_ADDR           Addr;
+    CPU_INT16U              Port;
+    CPU_BOOLEAN             Conn;                               /* Only pkts from the remote addr are rx'd when set.    */
+    HOST_SIM_ADDR           ConnAddr;
+    CPU_INT16U              ConnPort;
+    HOST_SIM_PKT           *RxHeadPtr;
+    HOST_SIM_PKT           *RxTailPtr;
+    CPU_INT32U              RxQ_Len;
+    HOST_SIM_HANDLER_FNCT   HandlerFnct;
+    void                   *HandlerArgPtr;
+};
+
+typedef  struct  host_sim_host {
+    CPU_CHAR        Name[HOST_SIM_HOST_NAME_LEN_MAX + 1u];
+    HOST_SIM_ADDR   Addr;
+} HOST_SIM_HOST;
+
+typedef  struct  host_sim_tmr {
+    HOST_SIM_TMR_FNCT   Fnct;
+    void               *ArgPtr;
+} HOST_SIM_TMR;
+
+typedef  struct  host_sim_impair {
+    CPU_BOOLEAN           Used;
+    HOST_SIM_ADDR         Addr;                                 /* Node whose tx'd pkts are impaired.                   */
+    HOST_IMPAIR           Link;                                 /* Impaired link model.                                 */
+} HOST_SIM_IMPAIR;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U             HostSim_TS_us;                   /* Virtual clock.                                       */
+static  HOST_SIM_ADDR          HostSim_NodeAddr;
+static  CPU_INT32U             HostSim_LinkDly_us;
+static  HOST_SIM_FILTER_FNCT   HostSim_FilterFnct;
+static  void                  *HostSim_FilterArgPtr;
+
+static  HOST_SIM_PKT          *HostSim_PktQ_HeadPtr;            /* Pkts in flight, by delivery time.                    */
+static  CPU_INT32U             HostSim_PktSeqNbr;
+static  CPU_INT16U             HostSim_PortEphemeral;
+
+static  HOST_SIM_SOCK          HostSim_SockTbl[HOST_SIM_SOCK_NBR_MAX];
+static  HOST_SIM_HOST          HostSim_HostTbl[HOST_SIM_HOST_NBR_MAX];
+static  HOST_SIM_TMR           HostSim_TmrTbl[HOST_SIM_TMR_NBR_MAX];
+static  HOST_SIM_ADDR          HostSim_GrpTbl[HOST_SIM_GRP_NBR_MAX];
+static  HOST_SIM_IMPAIR        HostSim_ImpairTbl[HOST_SIM_IMPAIR_NBR_MAX];
+
+static  HOST_SIM_STATS         HostSim_Stats;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN     HostSim_Process   (HOST_SIM_SOCK  **p_sock_tbl,
+                                           CPU_INT32U       sock_nbr,
+                                           CPU_INT64U       ts_end_us);
+
+static  CPU_INT64U      HostSim_TmrPoll   (void);
+
+static  void            HostSim_PktQ_Add  (HOST_SIM_PKT    *p_pkt);
+
+static  void            HostSim_PktDeliver(HOST_SIM_PKT    *p_pkt);
+
+static  void            HostSim_SockEnq   (HOST_SIM_SOCK   *p_sock,
+                                           HOST_SIM_PKT    *p_pkt);
+
+static  HOST_SIM_SOCK  *HostSim_SockFind  (HOST_SIM_ADDR    addr,
+                                           CPU_INT16U       port);
+
+static  CPU_BOOLEAN     HostSim_GrpIsMember(HOST_SIM_ADDR   addr_grp);
+
+static  HOST_SIM_IMPAIR *HostSim_ImpairFind(HOST_SIM_ADDR   addr);
+
+static  void            HostSim_ImpairTx  (HOST_SIM_IMPAIR *p_impair,
+                                           HOST_SIM_PKT    *p_pkt);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           HostSim_Init()
+*
+* Description : Reset the simulation : close all sockets, drop the packets in flight, clear the hosts,
+*               timers, link delay, filter & impairments, & set the virtual clock.
+*
+* Argument(s) : start_ms    Virtual time to start from, in milliseconds (e.g. HOST_SIM_TS_START_ms).
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+void  HostSim_Init (CPU_INT32U  start_ms)
+{
+    HOST_SIM_PKT  *p_pkt;
+    CPU_INT32U     ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_SOCK_NBR_MAX; ix++) {
+        if (HostSim_SockTbl[ix].Used == DEF_YES) {
+            HostSim_SockClose(&HostSim_SockTbl[ix]);
+        }
+    }
+    while (HostSim_PktQ_HeadPtr != DEF_NULL) {
+        p_pkt                = HostSim_PktQ_HeadPtr;
+        HostSim_PktQ_HeadPtr = p_pkt->NextPtr;
+        free(p_pkt);
+    }
+
+    Mem_Clr(HostSim_HostTbl, sizeof(HostSim_HostTbl));
+    Mem_Clr(HostSim_TmrTbl,  sizeof(HostSim_TmrTbl));
+    Mem_Clr(HostSim_GrpTbl,  sizeof(HostSim_GrpTbl));
+    Mem_Clr(HostSim_ImpairTbl, sizeof(HostSim_ImpairTbl));
+    Mem_Clr(&HostSim_Stats,  sizeof(HostSim_Stats));
+
+    HostSim_TS_us         = (CPU_INT64U)start_ms * 1000u;
+    HostSim_NodeAddr      = HOST_SIM_ADDR_CLIENT;
+    HostSim_LinkDly_us    = 0u;
+    HostSim_FilterFnct    = DEF_NULL;
+    HostSim_FilterArgPtr  = DEF_NULL;
+    HostSim_PktSeqNbr     = 0u;
+    HostSim_PortEphemeral = HOST_SIM_PORT_EPHEMERAL_BASE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_TimeGet_us()
+*
+* Description : Get the virtual time, in microseconds.
+*********************************************************************************************************
+*/
+
+CPU_INT64U  HostSim_TimeGet_us (void)
+{
+    return (HostSim_TS_us);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            HostSim_Run()
+*
+* Description : Advance the virtual clock by 'dly_ms', processing the packets & timers due meanwhile.
+*********************************************************************************************************
+*/
+
+void  HostSim_Run (CPU_INT32U  dly_ms)
+{
+   (void)HostSim_Process(DEF_NULL, 0u, HostSim_TS_us + ((CPU_INT64U)dly_ms * 1000u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_NodeAddrSet()
+*
+* Description : Set the address of the node sockets opened with NetSock_Open() belong to.
+*********************************************************************************************************
+*/
+
+void  HostSim_NodeAddrSet (HOST_SIM_ADDR  addr)
+{
+    HostSim_NodeAddr = addr;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_LinkDlySet()
+*
+* Description : Set the one-way delay added to every packet, in microseconds.
+*********************************************************************************************************
+*/
+
+void  HostSim_LinkDlySet (CPU_INT32U  dly_us)
+{
+    HostSim_LinkDly_us = dly_us;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_FilterSet()
+*
+* Description : Set the function called for each packet transmitted, which may drop it (see 'host_sim.h
+*               Note #3').  A NULL function removes the filter.
+*********************************************************************************************************
+*/
+
+void  HostSim_FilterSet (HOST_SIM_FILTER_FNCT   fnct,
+                         void                  *p_arg)
+{
+    HostSim_FilterFnct   = fnct;
+    HostSim_FilterArgPtr = p_arg;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_ImpairSet()
+*
+* Description : Set the impairments applied to the packets sent by a node (see 'host_sim.h  Note #4').
+*
+* Argument(s) : addr        Address of the node.
+*
+*               p_cfg       Pointer to impairment configuration, or NULL to remove the node's impairments.
+*
+* Return(s)   : DEF_OK,   if the impairments were set.
+*
+*               DEF_FAIL, if a rate is greater than HOST_SIM_IMPAIR_RATE_SCALE, or if the table is full.
+*
+* Note(s)     : (1) The node's link is idle & its pseudo-random generator is re-seeded with 'Seed' (see
+*                   HostImpair_Init()).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_ImpairSet (       HOST_SIM_ADDR         addr,
+                                const  HOST_SIM_IMPAIR_CFG  *p_cfg)
+{
+    HOST_SIM_IMPAIR  *p_impair;
+    CPU_INT32U        ix;
+
+
+    p_impair = HostSim_ImpairFind(addr);
+    if (p_cfg == DEF_NULL) {
+        if (p_impair != DEF_NULL) {
+            p_impair->Used = DEF_NO;
+        }
+        return (DEF_OK);
+    }
+
+    for (ix = 0u; (p_impair == DEF_NULL) && (ix < HOST_SIM_IMPAIR_NBR_MAX); ix++) {
+        if (HostSim_ImpairTbl[ix].Used == DEF_NO) {
+            p_impair = &HostSim_ImpairTbl[ix];
+        }
+    }
+    if (p_impair == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+    if (HostImpair_Init(&p_impair->Link, p_cfg) != DEF_OK) {    /* See Note #1.                                         */
+        return (DEF_FAIL);
+    }
+
+    p_impair->Used = DEF_YES;
+    p_impair->Addr = addr;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_HostAdd()
+*
+* Description : Add a host name resolved by NetApp_ClientDatagramOpenByHostname().
+*
+* Return(s)   : DEF_OK,   if the host was added.
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_HostAdd (const  CPU_CHAR       *p_name,
+                                     HOST_SIM_ADDR   addr)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_HOST_NBR_MAX; ix++) {
+        if (HostSim_HostTbl[ix].Name[0] == ASCII_CHAR_NULL) {
+            Str_Copy_N(HostSim_HostTbl[ix].Name, p_name, HOST_SIM_HOST_NAME_LEN_MAX);
+            HostSim_HostTbl[ix].Addr = addr;
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_HostResolve()
+*
+* Description : Resolve a host name added with HostSim_HostAdd().
+*
+* Return(s)   : DEF_OK,   if the host name is known.
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_HostResolve (const  CPU_CHAR       *p_name,
+                                         HOST_SIM_ADDR  *p_addr)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_HOST_NBR_MAX; ix++) {
+        if ((HostSim_HostTbl[ix].Name[0] != ASCII_CHAR_NULL) &&
+            (Str_Cmp(HostSim_HostTbl[ix].Name, p_name) == 0)) {
+           *p_addr = HostSim_HostTbl[ix].Addr;
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_TmrAdd()
+*
+* Description : Add a timer function, polled whenever the simulation advances (see Note #2).
+*
+* Return(s)   : DEF_OK,   if the timer was added.
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_TmrAdd (HOST_SIM_TMR_FNCT   fnct,
+                             void               *p_arg)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_TMR_NBR_MAX; ix++) {
+        if (HostSim_TmrTbl[ix].Fnct == DEF_NULL) {
+            HostSim_TmrTbl[ix].Fnct   = fnct;
+            HostSim_TmrTbl[ix].ArgPtr = p_arg;
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_TmrRemove()
+*
+* Description : Remove a timer function added with HostSim_TmrAdd().
+*********************************************************************************************************
+*/
+
+void  HostSim_TmrRemove (HOST_SIM_TMR_FNCT   fnct,
+                         void               *p_arg)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_TMR_NBR_MAX; ix++) {
+        if ((HostSim_TmrTbl[ix].Fnct   == fnct) &&
+            (HostSim_TmrTbl[ix].ArgPtr == p_arg)) {
+            HostSim_TmrTbl[ix].Fnct   = DEF_NULL;
+            HostSim_TmrTbl[ix].ArgPtr = DEF_NULL;
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_StatsGet()
+*
+* Description : Get the network statistics since HostSim_Init().
+*********************************************************************************************************
+*/
+
+void  HostSim_StatsGet (HOST_SIM_STATS  *p_stats)
+{
+   *p_stats = HostSim_Stats;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_SockOpen()
+*
+* Description : Open an unbound socket.
+*
+* Return(s)   : Pointer to socket, if NO error.
+*
+*               NULL,              otherwise.
+*********************************************************************************************************
+*/
+
+HOST_SIM_SOCK  *HostSim_SockOpen (void)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_SOCK_NBR_MAX; ix++) {
+        if (HostSim_SockTbl[ix].Used == DEF_NO) {
+            Mem_Clr(&HostSim_SockTbl[ix], sizeof(HOST_SIM_SOCK));
+            HostSim_SockTbl[ix].Used = DEF_YES;
+            return (&HostSim_SockTbl[ix]);
+        }
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_SockClose()
+*
+* Description : Close a socket & free the packets queued on it.
+*********************************************************************************************************
+*/
+
+void  HostSim_SockClose (HOST_SIM_SOCK  *p_sock)
+{
+    HOST_SIM_PKT  *p_pkt;
+
+
+    while (p_sock->RxHeadPtr != DEF_NULL) {
+        p_pkt             = p_sock->RxHeadPtr;
+        p_sock->RxHeadPtr = p_pkt->NextPtr;
+        free(p_pkt);
+    }
+
+    Mem_Clr(p_sock, sizeof(HOST_SIM_SOCK));
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_SockBind()
+*
+* Description : Bind a socket to a local address & port.
+*
+* Argument(s) : p_sock      Pointer to socket.
+*
+*               addr        Local address, or 0 for the node address (see 'host_sim.h  Note #2').
+*
+*               port        Local port, or 0 for an ephemeral port.
+*
+* Return(s)   : DEF_OK,   if the socket was bound.
+*
+*               DEF_FAIL, otherwise (address & port in use).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_SockBind (HOST_SIM_SOCK  *p_sock,
+                               HOST_SIM_ADDR   addr,
+                               CPU_INT16U      port)
+{
+    if (addr == 0u) {
+        addr = HostSim_NodeAddr;
+    }
+
+    if (port == 0u) {
+        do {
+            port = HostSim_PortEphemeral;
+            HostSim_PortEphemeral++;
+            if (HostSim_PortEphemeral == 0u) {
+                HostSim_PortEphemeral = HOST_SIM_PORT_EPHEMERAL_BASE;
+            }
+        } while (HostSim_SockFind(addr, port) != DEF_NULL);
+    } else if (HostSim_SockFind(addr, port) != DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    p_sock->Addr  = addr;
+    p_sock->Port  = port;
+    p_sock->Bound = DEF_YES;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_SockConn()
+*
+* Description : Set the remote address of a socket; packets from any other address are discarded.
+*********************************************************************************************************
+*/
+
+void  HostSim_SockConn (HOST_SIM_SOCK  *p_sock,
+                        HOST_SIM_ADDR   addr,
+                        CPU_INT16U      port)
+{
+    p_sock->Conn     = DEF_YES;
+    p_sock->ConnAddr = addr;
+    p_sock->ConnPort = port;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_SockAddrGet()
+*
+* Description : Get the local address & port of a socket, binding it to an ephemeral port if needed.
+*********************************************************************************************************
+*/
+
+void  HostSim_SockAddrGet (HOST_SIM_SOCK  *p_sock,
+                           HOST_SIM_ADDR  *p_addr,
+                           CPU_INT16U     *p_port)
+{
+    if (p_sock->Bound == DEF_NO) {
+       (void)HostSim_SockBind(p_sock, 0u, 0u);
+    }
+
+    if (p_addr != DEF_NULL) {
+       *p_addr = p_sock->Addr;
+    }
+    if (p_port != DEF_NULL) {
+       *p_port = p_sock->Port;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                      HostSim_SockHandlerSet()
+*
+* Description : Set the function called when a packet is delivered to a socket, instead of queuing it (see
+*               'host_sim.h  Note #1c').
+*********************************************************************************************************
+*/
+
+void  HostSim_SockHandlerSet (HOST_SIM_SOCK          *p_sock,
+                              HOST_SIM_HANDLER_FNCT   fnct,
+                              void                   *p_arg)
+{
+    p_sock->HandlerFnct   = fnct;
+    p_sock->HandlerArgPtr = p_arg;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_SockTx()
+*
+* Description : Transmit a datagram.
+*
+* Argument(s) : p_sock      Pointer to socket; bound to an ephemeral port if needed.
+*
+*               addr        Remote address.
+*
+*               port        Remote port.
+*
+*               p_data      Pointer to datagram.
+*
+*               len         Datagram length, in octets.
+*
+* Return(s)   : DEF_OK,   if the datagram was sent (it may still be dropped on the way).
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_SockTx (       HOST_SIM_SOCK  *p_sock,
+                                    HOST_SIM_ADDR   addr,
+                                    CPU_INT16U      port,
+                             const  void           *p_data,
+                                    CPU_INT32U      len)
+{
+    HOST_SIM_PKT     *p_pkt;
+    HOST_SIM_IMPAIR  *p_impair;
+
+
+    if (p_sock->Bound == DEF_NO) {
+        if (HostSim_SockBind(p_sock, 0u, 0u) != DEF_OK) {
+            return (DEF_FAIL);
+        }
+    }
+
+    p_pkt = (HOST_SIM_PKT *)malloc(sizeof(HOST_SIM_PKT) + len);
+    if (p_pkt == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    p_pkt->NextPtr       = DEF_NULL;
+    p_pkt->TS_Deliver_us = HostSim_TS_us + HostSim_LinkDly_us;
+    p_pkt->SeqNbr        = HostSim_PktSeqNbr++;
+    p_pkt->SrcAddr       = p_sock->Addr;
+    p_pkt->SrcPort       = p_sock->Port;
+    p_pkt->DstAddr       = addr;
+    p_pkt->DstPort       = port;
+    p_pkt->Len           = len;
+    Mem_Copy(p_pkt->Data, p_data, len);
+
+    HostSim_Stats.PktTxCtr++;
+    HostSim_Stats.OctetTxCtr += len;
+
+    if ((HostSim_FilterFnct != DEF_NULL) &&
+        (HostSim_FilterFnct(HostSim_FilterArgPtr, p_pkt) == DEF_NO)) {
+        HostSim_Stats.PktDropCtr++;
+        free(p_pkt);
+        return (DEF_OK);
+    }
+
+    p_impair = HostSim_ImpairFind(p_pkt->SrcAddr);
+    if (p_impair != DEF_NULL) {
+        HostSim_ImpairTx(p_impair, p_pkt);
+        return (DEF_OK);
+    }
+
+    HostSim_PktQ_Add(p_pkt);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_SockRx()
+*
+* Description : Dequeue the next datagram received on a socket.
+*
+* Return(s)   : Pointer to packet, if one is queued; the caller MUST free() it.
+*
+*               NULL,              otherwise.
+*********************************************************************************************************
+*/
+
+HOST_SIM_PKT  *HostSim_SockRx (HOST_SIM_SOCK  *p_sock)
+{
+    HOST_SIM_PKT  *p_pkt;
+
+
+    p_pkt = p_sock->RxHeadPtr;
+    if (p_pkt == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    p_sock->RxHeadPtr = p_pkt->NextPtr;
+    if (p_sock->RxHeadPtr == DEF_NULL) {
+        p_sock->RxTailPtr = DEF_NULL;
+    }
+    p_sock->RxQ_Len--;
+    p_pkt->NextPtr = DEF_NULL;
+
+    return (p_pkt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_SockRdy()
+*
+* Description : Check whether a datagram is queued on a socket.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_SockRdy (HOST_SIM_SOCK  *p_sock)
+{
+    return ((p_sock->RxHeadPtr != DEF_NULL) ? DEF_YES : DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_SockWait()
+*
+* Description : Run the simulation until a datagram is queued on one of the sockets, or the timeout expires.
+*
+* Argument(s) : p_sock_tbl  Table of sockets.
+*
+*               sock_nbr    Number of sockets in the table.
+*
+*               timeout_ms  Timeout, in milliseconds, or HOST_SIM_TIMEOUT_INFINITE (see Note #3).
+*
+* Return(s)   : DEF_YES, if a datagram is queued on one of the sockets.
+*
+*               DEF_NO,  otherwise; the virtual clock was advanced by the timeout.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_SockWait (HOST_SIM_SOCK  **p_sock_tbl,
+                               CPU_INT32U       sock_nbr,
+                               CPU_INT32U       timeout_ms)
+{
+    CPU_INT64U  ts_end_us;
+
+
+    ts_end_us = (timeout_ms == HOST_SIM_TIMEOUT_INFINITE) ? HOST_SIM_TS_NONE
+                                                          : HostSim_TS_us + ((CPU_INT64U)timeout_ms * 1000u);
+
+    return (HostSim_Process(p_sock_tbl, sock_nbr, ts_end_us));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_GrpJoin()
+*
+* Description : Join a multicast group on the client node.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_GrpJoin (HOST_SIM_ADDR  addr_grp)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_GRP_NBR_MAX; ix++) {
+        if (HostSim_GrpTbl[ix] == 0u) {
+            HostSim_GrpTbl[ix] = addr_grp;
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_GrpLeave()
+*
+* Description : Leave a multicast group joined with HostSim_GrpJoin().
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostSim_GrpLeave (HOST_SIM_ADDR  addr_grp)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_GRP_NBR_MAX; ix++) {
+        if (HostSim_GrpTbl[ix] == addr_grp) {
+            HostSim_GrpTbl[ix] = 0u;
+            return (DEF_OK);
+        }
+    }
+
+    return (DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetUtil_TS_Get_ms()
+*
+* Description : Get the virtual time, in milliseconds (see 'host_sim.h  Note #1a').
+*********************************************************************************************************
+*/
+
+NET_TS_MS  NetUtil_TS_Get_ms (void)
+{
+    return ((NET_TS_MS)(HostSim_TS_us / 1000u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                              KAL_Dly()
+*
+* Description : Advance the virtual clock (see 'host_sim.h  Note #1a').
+*********************************************************************************************************
+*/
+
+void  KAL_Dly (CPU_INT32U  dly_ms)
+{
+    HostSim_Run(dly_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            KAL_TickGet()
+*
+* Description : Get the virtual time, in ticks of 1 ms.
+*********************************************************************************************************
+*/
+
+KAL_TICK  KAL_TickGet (KAL_ERR  *p_err)
+{
+    if (p_err != DEF_NULL) {
+       *p_err = KAL_ERR_NONE;
+    }
+
+    return ((KAL_TICK)(HostSim_TS_us / 1000u));
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          HostSim_Process()
+*
+* Description : Run the simulation until a datagram is queued on one of the sockets, or 'ts_end_us'.
+*
+* Argument(s) : p_sock_tbl  Table of sockets, or NULL to run until 'ts_end_us'.
+*
+*               sock_nbr    Number of sockets in the table.
+*
+*               ts_end_us   Virtual time to stop at, or HOST_SIM_TS_NONE.
+*
+* Return(s)   : DEF_YES, if a datagram is queued on one of the sockets.
+*
+*               DEF_NO,  otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  HostSim_Process (HOST_SIM_SOCK  **p_sock_tbl,
+                                      CPU_INT32U       sock_nbr,
+                                      CPU_INT64U       ts_end_us)
+{
+    HOST_SIM_PKT  *p_pkt;
+    CPU_INT64U     ts_next_us;
+    CPU_INT32U     ix;
+
+
+    for (;;) {
+        ts_next_us = HostSim_TmrPoll();
+
+        for (ix = 0u; ix < sock_nbr; ix++) {
+            if (p_sock_tbl[ix]->RxHeadPtr != DEF_NULL) {
+                return (DEF_YES);
+            }
+        }
+
+        if ((HostSim_PktQ_HeadPtr                != DEF_NULL) &&
+            (HostSim_PktQ_HeadPtr->TS_Deliver_us <  ts_next_us)) {
+            ts_next_us = HostSim_PktQ_HeadPtr->TS_Deliver_us;
+        }
+
+        if (ts_next_us > ts_end_us) {
+            HostSim_TS_us = DEF_MAX(HostSim_TS_us, ts_end_us);
+            return (DEF_NO);
+        }
+        if (ts_next_us == HOST_SIM_TS_NONE) {                   /* See Note #3.                                         */
+            return (DEF_NO);
+        }
+
+        HostSim_TS_us = DEF_MAX(HostSim_TS_us, ts_next_us);
+
+        while ((HostSim_PktQ_HeadPtr                != DEF_NULL) &&
+               (HostSim_PktQ_HeadPtr->TS_Deliver_us <= HostSim_TS_us)) {
+            p_pkt                = HostSim_PktQ_HeadPtr;
+            HostSim_PktQ_HeadPtr = p_pkt->NextPtr;
+            HostSim_PktDeliver(p_pkt);
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_TmrPoll()
+*
+* Description : Call the timer functions (see Note #2).
+*
+* Return(s)   : Virtual time of the next timer, in microseconds, or HOST_SIM_TS_NONE.
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U  HostSim_TmrPoll (void)
+{
+    CPU_INT64U  ts_next_us;
+    CPU_INT64U  ts_us;
+    CPU_INT32U  now_ms;
+    CPU_INT32U  dly_ms;
+    CPU_INT32U  ix;
+
+
+    ts_next_us = HOST_SIM_TS_NONE;
+    now_ms     = (CPU_INT32U)(HostSim_TS_us / 1000u);
+    for (ix = 0u; ix < HOST_SIM_TMR_NBR_MAX; ix++) {
+        if (HostSim_TmrTbl[ix].Fnct == DEF_NULL) {
+            continue;
+        }
+        dly_ms = HostSim_TmrTbl[ix].Fnct(HostSim_TmrTbl[ix].ArgPtr, now_ms);
+        if (dly_ms == HOST_SIM_TIMEOUT_INFINITE) {
+            continue;
+        }
+        ts_us      = ((HostSim_TS_us / 1000u) + DEF_MAX(dly_ms, 1u)) * 1000u;
+        ts_next_us = DEF_MIN(ts_next_us, ts_us);
+    }
+
+    return (ts_next_us);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_PktQ_Add()
+*
+* Description : Insert a packet in the in-flight queue, after the packets due at the same time.
+*********************************************************************************************************
+*/
+
+static  void  HostSim_PktQ_Add (HOST_SIM_PKT  *p_pkt)
+{
+    HOST_SIM_PKT  **pp_next;
+
+
+    pp_next = &HostSim_PktQ_HeadPtr;
+    while ((*pp_next                  != DEF_NULL) &&
+           ((*pp_next)->TS_Deliver_us <= p_pkt->TS_Deliver_us)) {
+        pp_next = &(*pp_next)->NextPtr;
+    }
+
+    p_pkt->NextPtr = *pp_next;
+   *pp_next        =  p_pkt;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_PktDeliver()
+*
+* Description : Deliver a packet to the socket(s) it is addressed to, & free it unless it was queued.
+*********************************************************************************************************
+*/
+
+static  void  HostSim_PktDeliver (HOST_SIM_PKT  *p_pkt)
+{
+    HOST_SIM_SOCK  *p_sock;
+    HOST_SIM_PKT   *p_copy;
+    CPU_BOOLEAN     delivered;
+    CPU_INT32U      ix;
+
+
+    if (HOST_SIM_ADDR_IS_MCAST(p_pkt->DstAddr) == DEF_YES) {    /* Mcast : a copy to each member sock on the port.      */
+        delivered = DEF_NO;
+        if (HostSim_GrpIsMember(p_pkt->DstAddr) == DEF_YES) {
+            for (ix = 0u; ix < HOST_SIM_SOCK_NBR_MAX; ix++) {
+                p_sock = &HostSim_SockTbl[ix];
+                if ((p_sock->Used  == DEF_NO) ||
+                    (p_sock->Bound == DEF_NO) ||
+                    (p_sock->Port  != p_pkt->DstPort)) {
+                    continue;
+                }
+                p_copy = (HOST_SIM_PKT *)malloc(sizeof(HOST_SIM_PKT) + p_pkt->Len);
+                if (p_copy != DEF_NULL) {
+                    Mem_Copy(p_copy, p_pkt, sizeof(HOST_SIM_PKT) + p_pkt->Len);
+                    HostSim_SockEnq(p_sock, p_copy);
+                    delivered = DEF_YES;
+                }
+            }
+        }
+        if (delivered == DEF_NO) {
+            HostSim_Stats.PktNoSockCtr++;
+        }
+        free(p_pkt);
+        return;
+    }
+
+    p_sock = HostSim_SockFind(p_pkt->DstAddr, p_pkt->DstPort);
+    if (p_sock == DEF_NULL) {
+        HostSim_Stats.PktNoSockCtr++;
+        free(p_pkt);
+        return;
+    }
+
+    HostSim_SockEnq(p_sock, p_pkt);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSim_SockEnq()
+*
+* Description : Hand a packet to a socket : call its handler, or queue the packet.
+*********************************************************************************************************
+*/
+
+static  void  HostSim_SockEnq (HOST_SIM_SOCK  *p_sock,
+                               HOST_SIM_PKT   *p_pkt)
+{
+    if ((p_sock->Conn == DEF_YES) &&
+       ((p_pkt->SrcAddr != p_sock->ConnAddr) ||
+        (p_pkt->SrcPort != p_sock->ConnPort))) {
+        free(p_pkt);
+        return;
+    }
+
+    if (p_sock->HandlerFnct != DEF_NULL) {
+        p_sock->HandlerFnct(p_sock->HandlerArgPtr, p_sock, p_pkt);
+        free(p_pkt);
+        return;
+    }
+
+    if (p_sock->RxQ_Len >= HOST_SIM_SOCK_RX_Q_LEN_MAX) {       /* Sock buf full : pkt dropped.                         */
+        free(p_pkt);
+        return;
+    }
+
+    p_pkt->NextPtr = DEF_NULL;
+    if (p_sock->RxTailPtr == DEF_NULL) {
+        p_sock->RxHeadPtr = p_pkt;
+    } else {
+        p_sock->RxTailPtr->NextPtr = p_pkt;
+    }
+    p_sock->RxTailPtr = p_pkt;
+    p_sock->RxQ_Len++;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_SockFind()
+*
+* Description : Find the socket bound to an address & port.
+*********************************************************************************************************
+*/
+
+static  HOST_SIM_SOCK  *HostSim_SockFind (HOST_SIM_ADDR  addr,
+                                          CPU_INT16U     port)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_SOCK_NBR_MAX; ix++) {
+        if ((HostSim_SockTbl[ix].Used  == DEF_YES) &&
+            (HostSim_SockTbl[ix].Bound == DEF_YES) &&
+            (HostSim_SockTbl[ix].Addr  == addr)    &&
+            (HostSim_SockTbl[ix].Port  == port)) {
+            return (&HostSim_SockTbl[ix]);
+        }
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_GrpIsMember()
+*
+* Description : Check whether the client node joined a multicast group.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  HostSim_GrpIsMember (HOST_SIM_ADDR  addr_grp)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_GRP_NBR_MAX; ix++) {
+        if (HostSim_GrpTbl[ix] == addr_grp) {
+            return (DEF_YES);
+        }
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSim_ImpairFind()
+*
+* Description : Find the impairments of the packets sent by a node.
+*********************************************************************************************************
+*/
+
+static  HOST_SIM_IMPAIR  *HostSim_ImpairFind (HOST_SIM_ADDR  addr)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SIM_IMPAIR_NBR_MAX; ix++) {
+        if ((HostSim_ImpairTbl[ix].Used == DEF_YES) &&
+            (HostSim_ImpairTbl[ix].Addr == addr)) {
+            return (&HostSim_ImpairTbl[ix]);
+        }
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSim_ImpairTx()
+*
+* Description : Send an impaired packet : set its delivery time & queue it, or drop it (see 'host_sim.h
+*               Note #4').
+*
+* Argument(s) : p_impair    Pointer to the impairments of the sending node.
+*
+*               p_pkt       Pointer to packet; freed if dropped.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+static  void  HostSim_ImpairTx (HOST_SIM_IMPAIR  *p_impair,
+                                HOST_SIM_PKT     *p_pkt)
+{
+    HOST_IMPAIR_PKT   pkt;
+    HOST_SIM_PKT     *p_dup;
+    CPU_INT08U        fate;
+
+
+    fate = HostImpair_Tx(&p_impair->Link, HostSim_TS_us, p_pkt->Len, &pkt);
+    switch (fate) {
+        case HOST_IMPAIR_PKT_LOSS:
+             HostSim_Stats.PktLossCtr++;
+             free(p_pkt);
+             return;
+
+
+        case HOST_IMPAIR_PKT_QUEUE_DROP:
+             HostSim_Stats.PktQueueDropCtr++;
+             free(p_pkt);
+             return;
+
+
+        case HOST_IMPAIR_PKT_DELIVER:
+        default:
+             break;
+    }
+
+    p_pkt->TS_Deliver_us = pkt.TS_Deliver_us + HostSim_LinkDly_us;
+    if (pkt.Reorder == DEF_YES) {
+        HostSim_Stats.PktReorderCtr++;
+    }
+
+    p_dup = DEF_NULL;
+    if (pkt.Dup == DEF_YES) {
+        p_dup = (HOST_SIM_PKT *)malloc(sizeof(HOST_SIM_PKT) + p_pkt->Len);
+        if (p_dup != DEF_NULL) {
+            Mem_Copy(p_dup, p_pkt, sizeof(HOST_SIM_PKT) + p_pkt->Len);
+            p_dup->SeqNbr = HostSim_PktSeqNbr++;
+            HostSim_Stats.PktDupCtr++;
+        }
+    }
+
+    HostSim_PktQ_Add(p_pkt);
+    if (p_dup != DEF_NULL) {
+        HostSim_PktQ_Add(p_dup);                                /* Queued after the original, due at the same time.     */
+    }
+}
@@ -0,0 +1,265 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : SIMULATED NETWORK & CLOCK
+*
+* Filename : host_sim.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Discrete-event simulation of an IPv4 UDP network & of the clock, linked in place of the BSD
+*                socket layer ('tftpc_port_sim', see 'Host/readme.md') :
+*
+*                (a) NetUtil_TS_Get_ms(), KAL_TickGet() & KAL_Dly() use the virtual clock.  KAL_Dly() advances
+*                    the clock instantly, processing the events due in the meantime.
+*
+*                (b) The NetSock_*() functions are implemented on simulated sockets ('net_sim.c').  A receive
+*                    that times out advances the virtual clock by the timeout & returns
+*                    NET_SOCK_ERR_RX_Q_EMPTY immediately (see 'tftp-c_cfg.h  TFTPc TIME SOURCE CONFIGURATION
+*                    Note #2').
+*
+*                (c) Packets in flight are kept in a queue ordered by delivery time.  Servers attached to the
+*                    simulation (see 'host_sim_srv.c') are called synchronously when a packet is delivered &
+*                    when one of their timers expires.
+*
+*                Everything runs in the calling thread; a run is fully deterministic.
+*
+*            (2) Addresses are IPv4 addresses in host order.  Sockets opened with NetSock_Open() belong to
+*                the client node (HOST_SIM_ADDR_CLIENT by default, see HostSim_NodeAddrSet()).
+*
+*            (3) The link adds a fixed one-way delay to every packet (see HostSim_LinkDlySet()).  A filter
+*                function may drop selected packets (see HostSim_FilterSet()).
+*
+*            (4) The packets sent by a node may be impaired (see HostSim_ImpairSet()), as modelled in
+*                'Port/host_impair.h' : rate limit & tail drop, loss, duplication, delay, jitter & reordering.
+*                Impairments are modelled on the delivery time of each packet, never by holding up the
+*                sender.  'Dly_us' & the jitter add to the link delay.
+*********************************************************************************************************
+*/
+
+#ifndef  HOST_SIM_MODULE_PRESENT
+#define  HOST_SIM_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+#include  "host_impair.h"
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  HOST_SIM_ADDR_CLIENT                    0x0A000001u    /* 10.0.0.1 (see Note #2).                              */
+#define  HOST_SIM_ADDR_SRV                       0x0A000002u    /* 10.0.0.2 : first server node.                        */
+
+#define  HOST_SIM_TIMEOUT_INFINITE        DEF_INT_32U_MAX_VAL
+
+#define  HOST_SIM_TS_START_ms                          1000u    /* Dflt virtual time at HostSim_Init().                 */
+
+#define  HOST_SIM_PORT_EPHEMERAL_BASE                 49152u
+
+#define  HOST_SIM_IMPAIR_RATE_SCALE   HOST_IMPAIR_RATE_SCALE    /* See Note #4.                                         */
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  CPU_INT32U  HOST_SIM_ADDR;                             /* See Note #2.                                         */
+
+typedef  struct  host_sim_pkt  HOST_SIM_PKT;
+
+struct  host_sim_pkt {
+    HOST_SIM_PKT   *NextPtr;
+    CPU_INT64U      TS_Deliver_us;                              /* Virtual time of delivery.                            */
+    CPU_INT32U      SeqNbr;                                     /* Tx order, breaks ties between equal delivery times.  */
+    HOST_SIM_ADDR   SrcAddr;
+    CPU_INT16U      SrcPort;
+    HOST_SIM_ADDR   DstAddr;
+    CPU_INT16U      DstPort;
+    CPU_INT32U      Len;
+    CPU_INT08U      Data[];
+};
+
+typedef  struct  host_sim_sock  HOST_SIM_SOCK;
+
+                                                                /* Filter : rtn DEF_NO to drop the pkt (see Note #3).   */
+typedef  CPU_BOOLEAN  (*HOST_SIM_FILTER_FNCT)  (       void          *p_arg,
+                                                const  HOST_SIM_PKT  *p_pkt);
+
+                                                                /* Handler : pkt delivered to a sock (see Note #1c).    */
+typedef  void         (*HOST_SIM_HANDLER_FNCT) (       void          *p_arg,
+                                                       HOST_SIM_SOCK *p_sock,
+                                                const  HOST_SIM_PKT  *p_pkt);
+
+                                                                /* Tmr : process expired tmrs, rtn dly to next, in ms.  */
+typedef  CPU_INT32U   (*HOST_SIM_TMR_FNCT)     (       void          *p_arg,
+                                                       CPU_INT32U     now_ms);
+
+typedef  HOST_IMPAIR_CFG  HOST_SIM_IMPAIR_CFG;                  /* See Note #4.                                         */
+
+typedef  struct  host_sim_stats {
+    CPU_INT32U  PktTxCtr;                                       /* Nbr of pkts tx'd.                                    */
+    CPU_INT32U  PktDropCtr;                                     /* Nbr of pkts dropped by the filter.                   */
+    CPU_INT32U  PktLossCtr;                                     /* Nbr of pkts lost         (see Note #4).              */
+    CPU_INT32U  PktQueueDropCtr;                                /* Nbr of pkts tail-dropped (see Note #4).              */
+    CPU_INT32U  PktDupCtr;                                      /* Nbr of pkts duplicated   (see Note #4).              */
+    CPU_INT32U  PktReorderCtr;                                  /* Nbr of pkts held back    (see Note #4).              */
+    CPU_INT32U  PktNoSockCtr;                                   /* Nbr of pkts delivered to no sock.                    */
+    CPU_INT64U  OctetTxCtr;                                     /* Nbr of octets tx'd.                                  */
+} HOST_SIM_STATS;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+                                                                /* ------------------- SIMULATION -------------------- */
+void            HostSim_Init        (       CPU_INT32U             start_ms);
+
+CPU_INT64U      HostSim_TimeGet_us  (void);
+
+void            HostSim_Run         (       CPU_INT32U             dly_ms);
+
+void            HostSim_NodeAddrSet (       HOST_SIM_ADDR          addr);
+
+void            HostSim_LinkDlySet  (       CPU_INT32U             dly_us);
+
+void            HostSim_FilterSet   (       HOST_SIM_FILTER_FNCT   fnct,
+                                            void                  *p_arg);
+
+CPU_BOOLEAN     HostSim_ImpairSet   (       HOST_SIM_ADDR          addr,
+                                     const  HOST_SIM_IMPAIR_CFG   *p_cfg);
+
+CPU_BOOLEAN     HostSim_HostAdd     (const  CPU_CHAR              *p_name,
+                                            HOST_SIM_ADDR          addr);
+
+CPU_BOOLEAN     HostSim_HostResolve (const  CPU_CHAR              *p_name,
+                                            HOST_SIM_ADDR         *p_addr);
+
+CPU_BOOLEAN     HostSim_TmrAdd      (       HOST_SIM_TMR_FNCT      fnct,
+                                            void                  *p_arg);
+
+void            HostSim_TmrRemove   (       HOST_SIM_TMR_FNCT      fnct,
+                                            void                  *p_arg);
+
+void            HostSim_StatsGet    (       HOST_SIM_STATS        *p_stats);
+
+                                                                /* --------------------- SOCKETS --------------------- */
+HOST_SIM_SOCK  *HostSim_SockOpen    (void);
+
+void            HostSim_SockClose   (       HOST_SIM_SOCK         *p_sock);
+
+CPU_BOOLEAN     HostSim_SockBind    (       HOST_SIM_SOCK         *p_sock,
+                                            HOST_SIM_ADDR          addr,
+                                            CPU_INT16U             port);
+
+void            HostSim_SockConn    (       HOST_SIM_SOCK         *p_sock,
+                                            HOST_SIM_ADDR          addr,
+                                            CPU_INT16U             port);
+
+void            HostSim_SockAddrGet (       HOST_SIM_SOCK         *p_sock,
+                                            HOST_SIM_ADDR         *p_addr,
+                                            CPU_INT16U            *p_port);
+
+void            HostSim_SockHandlerSet(     HOST_SIM_SOCK         *p_sock,
+                                            HOST_SIM_HANDLER_FNCT  fnct,
+                                            void                  *p_arg);
+
+CPU_BOOLEAN     HostSim_SockTx      (       HOST_SIM_SOCK         *p_sock,
+                                            HOST_SIM_ADDR          addr,
+                                            CPU_INT16U             port,
+                                     const  void                  *p_data,
+                                            CPU_INT32U             len);
+
+HOST_SIM_PKT   *HostSim_SockRx      (       HOST_SIM_SOCK         *p_sock);
+
+CPU_BOOLEAN     HostSim_SockRdy     (       HOST_SIM_SOCK         *p_sock);
+
+CPU_BOOLEAN     HostSim_SockWait    (       HOST_SIM_SOCK        **p_sock_tbl,
+                                            CPU_INT32U             sock_nbr,
+                                            CPU_INT32U             timeout_ms);
+
+CPU_BOOLEAN     HostSim_GrpJoin     (       HOST_SIM_ADDR          addr_grp);
+
+CPU_BOOLEAN     HostSim_GrpLeave    (       HOST_SIM_ADDR          addr_grp);
+
+
+/*
+*********************************************************************************************************
+*                                   SIMULATED SERVER DRIVER PROTOTYPES
+*
+* Note(s) : (1) HostSimSrv_Start() attaches a test server (see 'Srv/host_srv.h') to the simulation, on node
+*               'addr' & port 'port'.  HostSimSrv_Stop() detaches & deletes it.
+*********************************************************************************************************
+*/
+
+typedef  struct  host_sim_srv  HOST_SIM_SRV;
+
+struct  host_srv_cfg;
+struct  host_srv_stats;
+
+HOST_SIM_SRV   *HostSimSrv_Start    (const  struct  host_srv_cfg    *p_cfg,
+                                            HOST_SIM_ADDR            addr,
+                                            CPU_INT16U               port);
+
+void            HostSimSrv_Stop     (       HOST_SIM_SRV            *p_drv);
+
+void            HostSimSrv_StatsGet (       HOST_SIM_SRV            *p_drv,
+                                            struct  host_srv_stats  *p_stats);
+
+
+/*
+*********************************************************************************************************
+*                               SIMULATED CAPTURE REPLAY PEER PROTOTYPES
+*
+* Note(s) : (1) HostSimReplay_Start() attaches a peer that plays the remote side of TFTPc capture records
+*               (see 'host_sim_replay.c  Note #1') to the simulation.  HostSimReplay_Stop() detaches it.
+*
+*           (2) The peer is built with the client configuration, since the record layout depends on
+*               TFTPc_CFG_CAP_SNAP_LEN ('tftpc_sim_replay', see 'Host/readme.md').
+*********************************************************************************************************
+*/
+
+typedef  struct  host_sim_replay  HOST_SIM_REPLAY;
+
+typedef  struct  host_sim_replay_result {
+    CPU_INT32U  RecNbr;                                         /* Nbr of records replayable (IPv4).                    */
+    CPU_INT32U  RecReplayedNbr;                                 /* Nbr of records consumed.                             */
+    CPU_INT32U  RxCtr;                                          /* Nbr of RX records sent to the client.                */
+    CPU_INT32U  DivergeCtr;                                     /* Nbr of client pkts that diverge from the capture.    */
+} HOST_SIM_REPLAY_RESULT;
+
+struct  tftpc_cap_rec;
+
+HOST_SIM_REPLAY  *HostSimReplay_Start     (const  struct  tftpc_cap_rec   *p_recs,
+                                                  CPU_INT16U               nbr_recs);
+
+void              HostSimReplay_Stop      (       HOST_SIM_REPLAY         *p_replay);
+
+void              HostSimReplay_ResultGet (       HOST_SIM_REPLAY         *p_replay,
+                                                  HOST_SIM_REPLAY_RESULT  *p_result);
+
+
+#endif
@@ -0,0 +1,409 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                               HOST PORT : CAPTURE REPLAY SIMULATED PEER
+*
+* Filename : host_sim_replay.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Plays the remote side of a TFTPc capture (see 'Source/tftp-c_cap.h') on the simulated
+*                network, against the unmodified client :
+*
+*                (a) Each remote endpoint of the capture is a simulated socket bound to the captured IPv4
+*                    address & port.  The client is given the captured server address, which the simulated
+*                    stack takes as a node address.
+*
+*                (b) The records are consumed in capture order.  A pkt tx'd by the client is compared with
+*                    the next record, which MUST be a TX record to the same endpoint, with the same length
+*                    & the same recorded octets; any other pkt is counted as a divergence.  A TX record is
+*                    consumed even if it diverges, so that one difference does NOT stall the replay.
+*
+*                (c) An RX record is sent to the client, from its endpoint, at its captured time relative to
+*                    the last TX record consumed.  The octets past 'CapLen' are zero.  RX records never
+*                    overtake a TX record : the peer waits for the client as long as the client needs.
+*
+*            (2) The capture MUST have been taken with the same client configuration (options, timeouts,
+*                retries) for the client to behave the same; IPv6 records are NOT replayed.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "host_sim.h"
+#include  <Source/tftp-c_cap.h>
+#include  <lib_mem.h>
+
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  HOST_SIM_REPLAY_EP_NBR_MAX                       16u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  host_sim_replay_ep {
+    HOST_SIM_ADDR    Addr;                                      /* Captured remote addr & port (see Note #1a).          */
+    CPU_INT16U       Port;
+    HOST_SIM_SOCK   *SockPtr;
+} HOST_SIM_REPLAY_EP;
+
+struct  host_sim_replay {
+    const  TFTPc_CAP_REC       *RecPtr;
+           CPU_INT16U           RecNbr;
+           CPU_INT16U           RecIx;                          /* Next record to consume.                              */
+           HOST_SIM_REPLAY_EP   EpTbl[HOST_SIM_REPLAY_EP_NBR_MAX];
+           CPU_INT32U           EpNbr;
+
+           HOST_SIM_ADDR        ClientAddr;                     /* Addr & port the client last tx'd from.               */
+           CPU_INT16U           ClientPort;
+           CPU_BOOLEAN          ClientKnown;
+
+           CPU_INT32U           AnchorSim_ms;                   /* Timeline anchor (see Note #1c).                      */
+           CPU_INT32U           AnchorCap_ms;
+
+           HOST_SIM_REPLAY_RESULT  Result;
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT32S   HostSimReplay_EpFind (       HOST_SIM_REPLAY      *p_replay,
+                                           const  TFTPc_CAP_REC        *p_rec);
+
+static  CPU_INT32U   HostSimReplay_Play   (       HOST_SIM_REPLAY      *p_replay,
+                                                  CPU_INT32U            now_ms);
+
+static  void         HostSimReplay_Rx     (       void                 *p_arg,
+                                                  HOST_SIM_SOCK        *p_sock,
+                                           const  HOST_SIM_PKT         *p_pkt);
+
+static  CPU_INT32U   HostSimReplay_Tmr    (       void                 *p_arg,
+                                                  CPU_INT32U            now_ms);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        HostSimReplay_Start()
+*
+* Description : Attach a replay peer to the simulation (see 'host_sim.h  SIMULATED CAPTURE REPLAY PEER
+*               PROTOTYPES Note #1').
+*
+* Argument(s) : p_recs      Pointer to capture records, in capture order; MUST remain valid until
+*                           HostSimReplay_Stop().
+*
+*               nbr_recs    Number of records.
+*
+* Return(s)   : Pointer to peer, if NO error.
+*
+*               NULL,        otherwise.
+*********************************************************************************************************
+*/
+
+HOST_SIM_REPLAY  *HostSimReplay_Start (const  TFTPc_CAP_REC  *p_recs,
+                                              CPU_INT16U      nbr_recs)
+{
+    HOST_SIM_REPLAY     *p_replay;
+    HOST_SIM_REPLAY_EP  *p_ep;
+    CPU_INT32U           ix;
+
+
+    p_replay = (HOST_SIM_REPLAY *)calloc(1u, sizeof(HOST_SIM_REPLAY));
+    if (p_replay == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    p_replay->RecPtr = p_recs;
+    p_replay->RecNbr = nbr_recs;
+
+    for (ix = 0u; ix < nbr_recs; ix++) {                        /* Open one sock per captured endpoint (see Note #1a).  */
+        if (p_recs[ix].AddrFamily != TFTPc_CAP_ADDR_FAMILY_IPv4) {
+            continue;
+        }
+        p_replay->Result.RecNbr++;
+        if (HostSimReplay_EpFind(p_replay, &p_recs[ix]) >= 0) {
+            continue;
+        }
+        if (p_replay->EpNbr >= HOST_SIM_REPLAY_EP_NBR_MAX) {
+            HostSimReplay_Stop(p_replay);
+            return (DEF_NULL);
+        }
+
+        p_ep          = &p_replay->EpTbl[p_replay->EpNbr];
+        p_ep->Addr    =  MEM_VAL_GET_INT32U_BIG(&p_recs[ix].AddrRemote[0]);
+        p_ep->Port    =  p_recs[ix].PortRemote;
+        p_ep->SockPtr =  HostSim_SockOpen();
+        if (p_ep->SockPtr == DEF_NULL) {
+            HostSimReplay_Stop(p_replay);
+            return (DEF_NULL);
+        }
+        p_replay->EpNbr++;
+        if (HostSim_SockBind(p_ep->SockPtr, p_ep->Addr, p_ep->Port) != DEF_OK) {
+            HostSimReplay_Stop(p_replay);
+            return (DEF_NULL);
+        }
+        HostSim_SockHandlerSet(p_ep->SockPtr, HostSimReplay_Rx, p_replay);
+    }
+
+    if (HostSim_TmrAdd(HostSimReplay_Tmr, p_replay) != DEF_OK) {
+        HostSimReplay_Stop(p_replay);
+        return (DEF_NULL);
+    }
+
+    return (p_replay);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSimReplay_Stop()
+*
+* Description : Detach a peer started with HostSimReplay_Start() & free its resources.
+*********************************************************************************************************
+*/
+
+void  HostSimReplay_Stop (HOST_SIM_REPLAY  *p_replay)
+{
+    CPU_INT32U  ix;
+
+
+    if (p_replay == DEF_NULL) {
+        return;
+    }
+
+    HostSim_TmrRemove(HostSimReplay_Tmr, p_replay);
+    for (ix = 0u; ix < p_replay->EpNbr; ix++) {
+        if (p_replay->EpTbl[ix].SockPtr != DEF_NULL) {
+            HostSim_SockClose(p_replay->EpTbl[ix].SockPtr);
+        }
+    }
+    free(p_replay);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       HostSimReplay_ResultGet()
+*
+* Description : Get the result of a replay, so far.
+*********************************************************************************************************
+*/
+
+void  HostSimReplay_ResultGet (HOST_SIM_REPLAY         *p_replay,
+                               HOST_SIM_REPLAY_RESULT  *p_result)
+{
+   *p_result = p_replay->Result;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       HostSimReplay_EpFind()
+*
+* Description : Find the endpoint of a record.
+*
+* Return(s)   : Index of the endpoint, if found.
+*
+*               -1,                     otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32S  HostSimReplay_EpFind (       HOST_SIM_REPLAY  *p_replay,
+                                          const  TFTPc_CAP_REC    *p_rec)
+{
+    HOST_SIM_ADDR  addr;
+    CPU_INT32U     ix;
+
+
+    addr = MEM_VAL_GET_INT32U_BIG(&p_rec->AddrRemote[0]);
+    for (ix = 0u; ix < p_replay->EpNbr; ix++) {
+        if ((p_replay->EpTbl[ix].Addr == addr) &&
+            (p_replay->EpTbl[ix].Port == p_rec->PortRemote)) {
+            return ((CPU_INT32S)ix);
+        }
+    }
+
+    return (-1);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSimReplay_Play()
+*
+* Description : Send the RX records due at 'now_ms' to the client (see Note #1c).
+*
+* Return(s)   : Delay to the next RX record, in ms, or HOST_SIM_TIMEOUT_INFINITE if the next record is a TX
+*               record or the replay is over.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  HostSimReplay_Play (HOST_SIM_REPLAY  *p_replay,
+                                        CPU_INT32U        now_ms)
+{
+    const  TFTPc_CAP_REC  *p_rec;
+           CPU_INT08U     *p_pkt;
+           CPU_INT32U      due_ms;
+           CPU_INT32S      ep;
+
+
+    while (p_replay->RecIx < p_replay->RecNbr) {
+        p_rec = &p_replay->RecPtr[p_replay->RecIx];
+        if (p_rec->AddrFamily != TFTPc_CAP_ADDR_FAMILY_IPv4) {  /* See Note #2.                                         */
+            p_replay->RecIx++;
+            continue;
+        }
+        if ((p_rec->Dir                != TFTPc_CAP_DIR_RX) ||
+            (p_replay->ClientKnown     == DEF_NO)) {
+            return (HOST_SIM_TIMEOUT_INFINITE);                 /* Wait for the client.                                 */
+        }
+
+        due_ms = p_replay->AnchorSim_ms + (CPU_INT32U)(p_rec->TS_ms - p_replay->AnchorCap_ms);
+        if ((CPU_INT32S)(due_ms - now_ms) > 0) {
+            return (due_ms - now_ms);
+        }
+
+        ep    = HostSimReplay_EpFind(p_replay, p_rec);
+        p_pkt = (CPU_INT08U *)calloc(1u, DEF_MAX(p_rec->PktLen, 1u));
+        if (p_pkt != DEF_NULL) {
+            Mem_Copy(p_pkt, p_rec->Data, DEF_MIN(p_rec->CapLen, p_rec->PktLen));
+           (void)HostSim_SockTx(p_replay->EpTbl[ep].SockPtr, p_replay->ClientAddr, p_replay->ClientPort,
+                                p_pkt, p_rec->PktLen);
+            free(p_pkt);
+        }
+        p_replay->Result.RxCtr++;
+        p_replay->Result.RecReplayedNbr++;
+        p_replay->RecIx++;
+    }
+
+    return (HOST_SIM_TIMEOUT_INFINITE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSimReplay_Rx()
+*
+* Description : Socket handler : compare a pkt tx'd by the client with the next record (see Note #1b).
+*********************************************************************************************************
+*/
+
+static  void  HostSimReplay_Rx (       void           *p_arg,
+                                       HOST_SIM_SOCK  *p_sock,
+                                const  HOST_SIM_PKT   *p_pkt)
+{
+           HOST_SIM_REPLAY  *p_replay;
+    const  TFTPc_CAP_REC    *p_rec;
+           CPU_INT32U        now_ms;
+           CPU_INT32U        cmp_len;
+           CPU_BOOLEAN       match;
+           CPU_INT32S        ep;
+
+
+    p_replay = (HOST_SIM_REPLAY *)p_arg;
+    now_ms   = (CPU_INT32U)(HostSim_TimeGet_us() / 1000u);
+
+    p_replay->ClientAddr  = p_pkt->SrcAddr;
+    p_replay->ClientPort  = p_pkt->SrcPort;
+    p_replay->ClientKnown = DEF_YES;
+
+   (void)HostSimReplay_Play(p_replay, now_ms);                  /* Send the RX records due before this pkt.             */
+
+    while ((p_replay->RecIx < p_replay->RecNbr) &&
+           (p_replay->RecPtr[p_replay->RecIx].AddrFamily != TFTPc_CAP_ADDR_FAMILY_IPv4)) {
+        p_replay->RecIx++;
+    }
+    if ((p_replay->RecIx                           >= p_replay->RecNbr) ||
+        (p_replay->RecPtr[p_replay->RecIx].Dir    != TFTPc_CAP_DIR_TX)) {
+        p_replay->Result.DivergeCtr++;                          /* Pkt NOT in the capture : do NOT consume.             */
+        return;
+    }
+
+    p_rec   = &p_replay->RecPtr[p_replay->RecIx];
+    ep      =  HostSimReplay_EpFind(p_replay, p_rec);
+    cmp_len =  DEF_MIN(p_rec->CapLen, p_rec->PktLen);
+    match   = ((p_replay->EpTbl[ep].SockPtr == p_sock)      &&
+               (p_rec->PktLen               == p_pkt->Len)  &&
+               (Mem_Cmp(p_rec->Data, p_pkt->Data, (CPU_SIZE_T)cmp_len) == DEF_YES)) ? DEF_YES : DEF_NO;
+    if (match == DEF_NO) {
+        p_replay->Result.DivergeCtr++;
+    }
+    p_replay->Result.RecReplayedNbr++;
+    p_replay->RecIx++;
+
+    p_replay->AnchorSim_ms = now_ms;                            /* Re-anchor the timeline (see Note #1c).               */
+    p_replay->AnchorCap_ms = p_rec->TS_ms;
+
+   (void)HostSimReplay_Play(p_replay, now_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSimReplay_Tmr()
+*
+* Description : Simulation timer : send the RX records due.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  HostSimReplay_Tmr (void        *p_arg,
+                                       CPU_INT32U   now_ms)
+{
+    return (HostSimReplay_Play((HOST_SIM_REPLAY *)p_arg, now_ms));
+}
@@ -0,0 +1,403 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                            HOST PORT : TFTP TEST SERVER SIMULATED NETWORK DRIVER
+*
+* Filename : host_sim_srv.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs the server core (see 'Srv/host_srv.h') on the simulated network.  Endpoint N is served
+*                by the simulated socket at index N of the driver socket table; packets are handed to the
+*                server from the socket handler, & the server timers are run from a simulation timer, so the
+*                server runs on the virtual clock, in the thread that drives the simulation.
+*
+*            (2) A server address holds the 4-octet IPv4 address & the 2-octet port, in host order.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  <lib_mem.h>
+
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  HOST_SIM_SRV_EP_NBR_MAX                (HOST_SRV_SESS_NBR_MAX + 1u)
+
+#define  HOST_SIM_SRV_ADDR_LEN                             6u   /* See Note #2.                                         */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+struct  host_sim_srv {
+    HOST_SRV        *SrvPtr;
+    HOST_SIM_ADDR    Addr;
+    HOST_SIM_SOCK   *SockTbl[HOST_SIM_SRV_EP_NBR_MAX];          /* See Note #1.                                         */
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  HOST_SIM_SOCK  *HostSimSrv_SockOpen(HOST_SIM_SRV         *p_drv,
+                                            CPU_INT16U            port);
+
+static  void            HostSimSrv_Rx      (void                 *p_arg,
+                                            HOST_SIM_SOCK        *p_sock,
+                                            const  HOST_SIM_PKT  *p_pkt);
+
+static  CPU_INT32U      HostSimSrv_Tmr     (void                 *p_arg,
+                                            CPU_INT32U            now_ms);
+
+static  CPU_INT32S      HostSimSrv_EpOpen  (void                 *p_arg);
+
+static  void            HostSimSrv_EpClose (void                 *p_arg,
+                                            CPU_INT32S            ep);
+
+static  void            HostSimSrv_Tx      (void                 *p_arg,
+                                            CPU_INT32S            ep,
+                                            const  HOST_SRV_ADDR *p_addr,
+                                            const  CPU_INT08U    *p_pkt,
+                                            CPU_INT32U            len);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL CONSTANTS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  HOST_SRV_IO  HostSimSrv_IO = {
+    HostSimSrv_EpOpen,
+    HostSimSrv_EpClose,
+    HostSimSrv_Tx
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         HostSimSrv_Start()
+*
+* Description : Attach a server to the simulation (see 'host_sim.h  SIMULATED SERVER DRIVER PROTOTYPES
+*               Note #1').
+*
+* Argument(s) : p_cfg       Pointer to server configuration.
+*
+*               addr        Server node address, e.g. HOST_SIM_ADDR_SRV.
+*
+*               port        Server request port, e.g. 69.
+*
+* Return(s)   : Pointer to driver, if NO error.
+*
+*               NULL,              otherwise.
+*********************************************************************************************************
+*/
+
+HOST_SIM_SRV  *HostSimSrv_Start (const  HOST_SRV_CFG   *p_cfg,
+                                        HOST_SIM_ADDR   addr,
+                                        CPU_INT16U      port)
+{
+    HOST_SIM_SRV  *p_drv;
+
+
+    p_drv = (HOST_SIM_SRV *)calloc(1u, sizeof(HOST_SIM_SRV));
+    if (p_drv == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    p_drv->Addr = addr;
+
+    p_drv->SockTbl[HOST_SRV_EP_REQ] = HostSimSrv_SockOpen(p_drv, port);
+    p_drv->SrvPtr                   = HostSrv_Create(p_cfg, &HostSimSrv_IO, p_drv);
+    if ((p_drv->SockTbl[HOST_SRV_EP_REQ] == DEF_NULL) ||
+        (p_drv->SrvPtr                   == DEF_NULL)  ||
+        (HostSim_TmrAdd(HostSimSrv_Tmr, p_drv) != DEF_OK)) {
+        HostSimSrv_Stop(p_drv);
+        return (DEF_NULL);
+    }
+
+    return (p_drv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSimSrv_Stop()
+*
+* Description : Detach a server started with HostSimSrv_Start() & free its resources.
+*********************************************************************************************************
+*/
+
+void  HostSimSrv_Stop (HOST_SIM_SRV  *p_drv)
+{
+    CPU_INT32U  ix;
+
+
+    if (p_drv == DEF_NULL) {
+        return;
+    }
+
+    HostSim_TmrRemove(HostSimSrv_Tmr, p_drv);
+    HostSrv_Del(p_drv->SrvPtr);
+    for (ix = 0u; ix < HOST_SIM_SRV_EP_NBR_MAX; ix++) {
+        if (p_drv->SockTbl[ix] != DEF_NULL) {
+            HostSim_SockClose(p_drv->SockTbl[ix]);
+        }
+    }
+    free(p_drv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSimSrv_StatsGet()
+*
+* Description : Get the statistics of a server.
+*********************************************************************************************************
+*/
+
+void  HostSimSrv_StatsGet (HOST_SIM_SRV    *p_drv,
+                           HOST_SRV_STATS  *p_stats)
+{
+    HostSrv_StatsGet(p_drv->SrvPtr, p_stats);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        HostSimSrv_SockOpen()
+*
+* Description : Open a simulated socket on the server node, with the driver as its handler.
+*
+* Argument(s) : p_drv       Pointer to driver.
+*
+*               port        Port, or 0 for an ephemeral port.
+*
+* Return(s)   : Pointer to socket, if NO error.
+*
+*               NULL,              otherwise.
+*********************************************************************************************************
+*/
+
+static  HOST_SIM_SOCK  *HostSimSrv_SockOpen (HOST_SIM_SRV  *p_drv,
+                                             CPU_INT16U     port)
+{
+    HOST_SIM_SOCK  *p_sock;
+
+
+    p_sock = HostSim_SockOpen();
+    if (p_sock == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    if (HostSim_SockBind(p_sock, p_drv->Addr, port) != DEF_OK) {
+        HostSim_SockClose(p_sock);
+        return (DEF_NULL);
+    }
+    HostSim_SockHandlerSet(p_sock, HostSimSrv_Rx, p_drv);
+
+    return (p_sock);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostSimSrv_Rx()
+*
+* Description : Socket handler : hand a packet to the server, on the endpoint of the socket.
+*********************************************************************************************************
+*/
+
+static  void  HostSimSrv_Rx (       void           *p_arg,
+                                    HOST_SIM_SOCK  *p_sock,
+                             const  HOST_SIM_PKT   *p_pkt)
+{
+    HOST_SIM_SRV   *p_drv;
+    HOST_SRV_ADDR   addr;
+    CPU_INT32U      ix;
+
+
+    p_drv = (HOST_SIM_SRV *)p_arg;
+    for (ix = 0u; ix < HOST_SIM_SRV_EP_NBR_MAX; ix++) {
+        if (p_drv->SockTbl[ix] == p_sock) {
+            break;
+        }
+    }
+    if (ix >= HOST_SIM_SRV_EP_NBR_MAX) {
+        return;
+    }
+
+    Mem_Clr(&addr, sizeof(addr));                               /* See Note #2.                                         */
+    addr.Len = HOST_SIM_SRV_ADDR_LEN;
+    MEM_VAL_SET_INT32U_BIG(&addr.Addr[0], p_pkt->SrcAddr);
+    MEM_VAL_SET_INT16U_BIG(&addr.Addr[4], p_pkt->SrcPort);
+
+    HostSrv_Rx(p_drv->SrvPtr, (CPU_INT32S)ix, &addr, p_pkt->Data, p_pkt->Len,
+               (CPU_INT32U)(HostSim_TimeGet_us() / 1000u));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSimSrv_Tmr()
+*
+* Description : Simulation timer : run the server timers.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  HostSimSrv_Tmr (void        *p_arg,
+                                    CPU_INT32U   now_ms)
+{
+    HOST_SIM_SRV  *p_drv;
+    CPU_INT32U     dly_ms;
+
+
+    p_drv  = (HOST_SIM_SRV *)p_arg;
+    dly_ms =  HostSrv_Tmr(p_drv->SrvPtr, now_ms);
+
+    return ((dly_ms == HOST_SRV_TMR_NONE) ? HOST_SIM_TIMEOUT_INFINITE : dly_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSimSrv_EpOpen()
+*
+* Description : Open a transfer endpoint (see 'host_srv.h  HOST_SRV_IO').
+*********************************************************************************************************
+*/
+
+static  CPU_INT32S  HostSimSrv_EpOpen (void  *p_arg)
+{
+    HOST_SIM_SRV  *p_drv;
+    CPU_INT32U     ix;
+
+
+    p_drv = (HOST_SIM_SRV *)p_arg;
+    for (ix = HOST_SRV_EP_REQ + 1u; ix < HOST_SIM_SRV_EP_NBR_MAX; ix++) {
+        if (p_drv->SockTbl[ix] == DEF_NULL) {
+            p_drv->SockTbl[ix] = HostSimSrv_SockOpen(p_drv, 0u);
+            return ((p_drv->SockTbl[ix] != DEF_NULL) ? (CPU_INT32S)ix : HOST_SRV_EP_NONE);
+        }
+    }
+
+    return (HOST_SRV_EP_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSimSrv_EpClose()
+*
+* Description : Close a transfer endpoint.
+*********************************************************************************************************
+*/
+
+static  void  HostSimSrv_EpClose (void        *p_arg,
+                                  CPU_INT32S   ep)
+{
+    HOST_SIM_SRV  *p_drv;
+
+
+    p_drv = (HOST_SIM_SRV *)p_arg;
+    if ((ep <= HOST_SRV_EP_REQ) ||
+        (ep >= (CPU_INT32S)HOST_SIM_SRV_EP_NBR_MAX)) {
+        return;
+    }
+    if (p_drv->SockTbl[ep] != DEF_NULL) {
+        HostSim_SockClose(p_drv->SockTbl[ep]);
+        p_drv->SockTbl[ep] = DEF_NULL;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostSimSrv_Tx()
+*
+* Description : Transmit a packet from an endpoint (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  HostSimSrv_Tx (       void           *p_arg,
+                                    CPU_INT32S      ep,
+                             const  HOST_SRV_ADDR  *p_addr,
+                             const  CPU_INT08U     *p_pkt,
+                                    CPU_INT32U      len)
+{
+    HOST_SIM_SRV  *p_drv;
+    HOST_SIM_ADDR  addr;
+    CPU_INT16U     port;
+
+
+    p_drv = (HOST_SIM_SRV *)p_arg;
+    if ((ep <  0) ||
+        (ep >= (CPU_INT32S)HOST_SIM_SRV_EP_NBR_MAX) ||
+        (p_drv->SockTbl[ep] == DEF_NULL) ||
+        (p_addr->Len        != HOST_SIM_SRV_ADDR_LEN)) {
+        return;
+    }
+
+    addr = MEM_VAL_GET_INT32U_BIG(&p_addr->Addr[0]);
+    port = MEM_VAL_GET_INT16U_BIG(&p_addr->Addr[4]);
+   (void)HostSim_SockTx(p_drv->SockTbl[ep], addr, port, p_pkt, len);
+}
@@ -0,0 +1,914 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                               HOST PORT : NETWORK ON THE SIMULATED NETWORK
+*
+* Filename : net_sim.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Implements the subset of the uC/TCP-IP socket, application, interface & IGMP interfaces used
+*                by TFTPc on the simulated network (see 'host_sim.h  Note #1b').  Only IPv4 is simulated.
+*
+*            (2) A receive on a blocking socket runs the simulation until a datagram is queued or the receive
+*                timeout expires; the virtual clock is then advanced by the timeout & NET_SOCK_ERR_RX_Q_EMPTY
+*                is returned at once.
+*
+*            (3) Datagrams longer than the receive buffer are truncated to the buffer length.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  "host_sim.h"
+#include  <Source/net.h>
+#include  <Source/net_app.h>
+#include  <Source/net_ascii.h>
+#include  <Source/net_if.h>
+#include  <Source/net_igmp.h>
+#include  <host_net.h>
+
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  net_sim_sock {
+    HOST_SIM_SOCK  *SockPtr;                                    /* NULL if the sock ID is free.                         */
+    CPU_BOOLEAN     Block;
+    CPU_INT32U      TimeoutRx_ms;                               /* 0 : infinite.                                        */
+    CPU_BOOLEAN     Conn;
+    HOST_SIM_ADDR   ConnAddr;
+    CPU_INT16U      ConnPort;
+} NET_SIM_SOCK;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  NET_SIM_SOCK  NetSim_SockTbl[NET_SOCK_CFG_NBR_SOCK];
+
+static  NET_MTU       NetSim_IF_MTU = HOST_NET_IF_MTU_DFLT;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  NET_SIM_SOCK  *NetSim_SockGet   (NET_SOCK_ID           sock_id);
+
+static  CPU_BOOLEAN    NetSim_AddrToSim (const  NET_SOCK_ADDR *p_addr,
+                                         HOST_SIM_ADDR        *p_addr_sim,
+                                         CPU_INT16U           *p_port);
+
+static  void           NetSim_AddrFromSim(HOST_SIM_ADDR        addr,
+                                          CPU_INT16U           port,
+                                          NET_SOCK_ADDR       *p_addr);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          HostNet_IF_MTU_Set()
+*
+* Description : Set the MTU reported for the default interface.
+*********************************************************************************************************
+*/
+
+void  HostNet_IF_MTU_Set (NET_MTU  mtu)
+{
+    NetSim_IF_MTU = mtu;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Open()
+*
+* Description : Open a simulated UDP socket (see Note #1).
+*********************************************************************************************************
+*/
+
+NET_SOCK_ID  NetSock_Open (NET_SOCK_PROTOCOL_FAMILY   protocol_family,
+                           NET_SOCK_TYPE              sock_type,
+                           NET_SOCK_PROTOCOL          protocol,
+                           NET_ERR                   *p_err)
+{
+    NET_SOCK_ID     sock_id;
+    HOST_SIM_SOCK  *p_sock;
+
+
+    if (protocol_family != NET_SOCK_PROTOCOL_FAMILY_IP_V4) {
+       *p_err = NET_SOCK_ERR_INVALID_FAMILY;
+        return (NET_SOCK_BSD_ERR_OPEN);
+    }
+    if ((sock_type != NET_SOCK_TYPE_DATAGRAM) ||
+        (protocol  != NET_SOCK_PROTOCOL_UDP)) {
+       *p_err = NET_ERR_FAULT_NOT_SUPPORTED;
+        return (NET_SOCK_BSD_ERR_OPEN);
+    }
+
+    for (sock_id = 0; sock_id < (NET_SOCK_ID)NET_SOCK_CFG_NBR_SOCK; sock_id++) {
+        if (NetSim_SockTbl[sock_id].SockPtr == DEF_NULL) {
+            break;
+        }
+    }
+    if (sock_id >= (NET_SOCK_ID)NET_SOCK_CFG_NBR_SOCK) {
+       *p_err = NET_SOCK_ERR_NONE_AVAIL;
+        return (NET_SOCK_BSD_ERR_OPEN);
+    }
+
+    p_sock = HostSim_SockOpen();
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_NONE_AVAIL;
+        return (NET_SOCK_BSD_ERR_OPEN);
+    }
+
+    Mem_Clr(&NetSim_SockTbl[sock_id], sizeof(NET_SIM_SOCK));
+    NetSim_SockTbl[sock_id].SockPtr      = p_sock;
+    NetSim_SockTbl[sock_id].Block        = DEF_YES;
+    NetSim_SockTbl[sock_id].TimeoutRx_ms = NET_SOCK_TIMEOUT_INFINITE;
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (sock_id);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Close()
+*
+* Description : Close a socket & free its socket ID.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Close (NET_SOCK_ID   sock_id,
+                                  NET_ERR      *p_err)
+{
+    NET_SIM_SOCK  *p_sock;
+
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_CLOSE);
+    }
+
+    HostSim_SockClose(p_sock->SockPtr);
+    Mem_Clr(p_sock, sizeof(NET_SIM_SOCK));
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (NET_SOCK_BSD_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Bind()
+*
+* Description : Bind a socket to a local address; the wildcard address binds to the client node.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Bind (NET_SOCK_ID         sock_id,
+                                 NET_SOCK_ADDR      *p_addr_local,
+                                 NET_SOCK_ADDR_LEN   addr_len,
+                                 NET_ERR            *p_err)
+{
+    NET_SIM_SOCK   *p_sock;
+    HOST_SIM_ADDR   addr;
+    CPU_INT16U      port;
+
+
+   (void)addr_len;
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_BIND);
+    }
+    if (NetSim_AddrToSim(p_addr_local, &addr, &port) != DEF_OK) {
+       *p_err = NET_SOCK_ERR_INVALID_ADDR;
+        return (NET_SOCK_BSD_ERR_BIND);
+    }
+    if (HostSim_SockBind(p_sock->SockPtr, addr, port) != DEF_OK) {
+       *p_err = NET_SOCK_ERR_ADDR_IN_USE;
+        return (NET_SOCK_BSD_ERR_BIND);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (NET_SOCK_BSD_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetSock_Conn()
+*
+* Description : Set the remote address of a datagram socket.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Conn (NET_SOCK_ID         sock_id,
+                                 NET_SOCK_ADDR      *p_addr_remote,
+                                 NET_SOCK_ADDR_LEN   addr_len,
+                                 NET_ERR            *p_err)
+{
+    NET_SIM_SOCK  *p_sock;
+
+
+   (void)addr_len;
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_CONN);
+    }
+    if (NetSim_AddrToSim(p_addr_remote, &p_sock->ConnAddr, &p_sock->ConnPort) != DEF_OK) {
+       *p_err = NET_SOCK_ERR_CONN_FAIL;
+        return (NET_SOCK_BSD_ERR_CONN);
+    }
+
+    p_sock->Conn = DEF_YES;
+    HostSim_SockConn(p_sock->SockPtr, p_sock->ConnAddr, p_sock->ConnPort);
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (NET_SOCK_BSD_ERR_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetSock_RxDataFrom()
+*
+* Description : Receive a datagram (see Notes #2 & #3).
+*
+* Argument(s) : sock_id             Socket ID.
+*
+*               p_data_buf          Pointer to receive buffer.
+*
+*               data_buf_len        Receive buffer length, in octets.
+*
+*               flags               NET_SOCK_FLAG_RX_NO_BLOCK to return immediately if no datagram is queued.
+*
+*               p_addr_remote       Pointer to variable that will receive the sender address, if NOT NULL.
+*
+*               p_addr_len          Pointer to variable that will receive the sender address length.
+*
+*               p_ip_opts_buf       Not supported.
+*
+*               ip_opts_buf_len     Not supported.
+*
+*               p_ip_opts_len       Not supported.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       NET_SOCK_ERR_NONE                   Datagram received.
+*                                       NET_SOCK_ERR_RX_Q_EMPTY             No datagram before the timeout.
+*                                       NET_SOCK_ERR_INVALID_SOCK           Invalid socket ID.
+*
+* Return(s)   : Number of octets received, if NO error.
+*
+*               NET_SOCK_BSD_ERR_RX,       otherwise.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_RxDataFrom (NET_SOCK_ID         sock_id,
+                                       void               *p_data_buf,
+                                       CPU_INT16U          data_buf_len,
+                                       CPU_INT16S          flags,
+                                       NET_SOCK_ADDR      *p_addr_remote,
+                                       NET_SOCK_ADDR_LEN  *p_addr_len,
+                                       void               *p_ip_opts_buf,
+                                       CPU_INT08U          ip_opts_buf_len,
+                                       CPU_INT08U         *p_ip_opts_len,
+                                       NET_ERR            *p_err)
+{
+    NET_SIM_SOCK  *p_sock;
+    HOST_SIM_PKT  *p_pkt;
+    CPU_INT32U     timeout_ms;
+    CPU_INT32U     len;
+
+
+   (void)p_ip_opts_buf;
+   (void)ip_opts_buf_len;
+    if (p_ip_opts_len != DEF_NULL) {
+       *p_ip_opts_len = 0u;
+    }
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_RX);
+    }
+
+    if ((p_sock->Block == DEF_YES) &&
+        (DEF_BIT_IS_CLR(flags, NET_SOCK_FLAG_RX_NO_BLOCK) == DEF_YES)) {
+        timeout_ms = (p_sock->TimeoutRx_ms == NET_SOCK_TIMEOUT_INFINITE) ? HOST_SIM_TIMEOUT_INFINITE
+                                                                         : p_sock->TimeoutRx_ms;
+       (void)HostSim_SockWait(&p_sock->SockPtr, 1u, timeout_ms);    /* See Note #2.                                     */
+    } else {
+        HostSim_Run(0u);                                        /* Deliver the pkts due now.                            */
+    }
+
+    p_pkt = HostSim_SockRx(p_sock->SockPtr);
+    if (p_pkt == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_RX_Q_EMPTY;
+        return (NET_SOCK_BSD_ERR_RX);
+    }
+
+    len = DEF_MIN(p_pkt->Len, data_buf_len);                    /* See Note #3.                                         */
+    Mem_Copy(p_data_buf, p_pkt->Data, len);
+    if (p_addr_remote != DEF_NULL) {
+        NetSim_AddrFromSim(p_pkt->SrcAddr, p_pkt->SrcPort, p_addr_remote);
+    }
+    if (p_addr_len != DEF_NULL) {
+       *p_addr_len = sizeof(NET_SOCK_ADDR);
+    }
+    free(p_pkt);
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return ((NET_SOCK_RTN_CODE)len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetSock_TxDataTo()
+*
+* Description : Transmit a datagram to a remote address.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_TxDataTo (NET_SOCK_ID         sock_id,
+                                     void               *p_data,
+                                     CPU_INT16U          data_len,
+                                     CPU_INT16S          flags,
+                                     NET_SOCK_ADDR      *p_addr_remote,
+                                     NET_SOCK_ADDR_LEN   addr_len,
+                                     NET_ERR            *p_err)
+{
+    NET_SIM_SOCK   *p_sock;
+    HOST_SIM_ADDR   addr;
+    CPU_INT16U      port;
+
+
+   (void)flags;
+   (void)addr_len;
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+    if (NetSim_AddrToSim(p_addr_remote, &addr, &port) != DEF_OK) {
+       *p_err = NET_SOCK_ERR_INVALID_ADDR;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+    if (HostSim_SockTx(p_sock->SockPtr, addr, port, p_data, data_len) != DEF_OK) {
+       *p_err = NET_ERR_TX;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return ((NET_SOCK_RTN_CODE)data_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          NetSock_TxData()
+*
+* Description : Transmit a datagram on a connected socket.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_TxData (NET_SOCK_ID   sock_id,
+                                   void         *p_data,
+                                   CPU_INT16U    data_len,
+                                   CPU_INT16S    flags,
+                                   NET_ERR      *p_err)
+{
+    NET_SIM_SOCK  *p_sock;
+
+
+   (void)flags;
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+    if (p_sock->Conn == DEF_NO) {
+       *p_err = NET_SOCK_ERR_CONN_FAIL;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+    if (HostSim_SockTx(p_sock->SockPtr, p_sock->ConnAddr, p_sock->ConnPort, p_data, data_len) != DEF_OK) {
+       *p_err = NET_ERR_TX;
+        return (NET_SOCK_BSD_ERR_TX);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return ((NET_SOCK_RTN_CODE)data_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            NetSock_Sel()
+*
+* Description : Run the simulation until one of the sockets in the read descriptor set has a datagram
+*               queued, or the timeout expires.
+*
+* Argument(s) : sock_nbr_max        Highest socket ID in the descriptor sets, plus one.
+*
+*               p_sock_desc_rd      Read descriptor set; on return, contains the ready sockets.
+*
+*               p_sock_desc_wr      Not supported, cleared on return.
+*
+*               p_sock_desc_err     Not supported, cleared on return.
+*
+*               p_timeout           Pointer to timeout; NULL waits forever.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       NET_SOCK_ERR_NONE                   Sockets ready, or timeout with 0 ready.
+*                                       NET_SOCK_ERR_INVALID_SOCK           Invalid socket in a descriptor set.
+*
+* Return(s)   : Number of ready sockets, if NO error.
+*
+*               NET_SOCK_BSD_ERR_SEL,    otherwise.
+*********************************************************************************************************
+*/
+
+NET_SOCK_RTN_CODE  NetSock_Sel (NET_SOCK_QTY        sock_nbr_max,
+                                NET_SOCK_DESC      *p_sock_desc_rd,
+                                NET_SOCK_DESC      *p_sock_desc_wr,
+                                NET_SOCK_DESC      *p_sock_desc_err,
+                                NET_SOCK_TIMEOUT   *p_timeout,
+                                NET_ERR            *p_err)
+{
+    HOST_SIM_SOCK      *sock_tbl[NET_SOCK_CFG_NBR_SOCK];
+    NET_SOCK_ID         id_tbl[NET_SOCK_CFG_NBR_SOCK];
+    NET_SIM_SOCK       *p_sock;
+    NET_SOCK_ID         sock_id;
+    CPU_INT32U          sock_nbr;
+    CPU_INT32U          timeout_ms;
+    CPU_INT32U          ix;
+    NET_SOCK_RTN_CODE   rtn;
+
+
+    if (sock_nbr_max > NET_SOCK_CFG_NBR_SOCK) {
+        sock_nbr_max = NET_SOCK_CFG_NBR_SOCK;
+    }
+
+    sock_nbr = 0u;
+    if (p_sock_desc_rd != DEF_NULL) {
+        for (sock_id = 0; sock_id < (NET_SOCK_ID)sock_nbr_max; sock_id++) {
+            if (NET_SOCK_DESC_IS_SET(sock_id, p_sock_desc_rd) == DEF_NO) {
+                continue;
+            }
+            p_sock = NetSim_SockGet(sock_id);
+            if (p_sock == DEF_NULL) {
+               *p_err = NET_SOCK_ERR_INVALID_SOCK;
+                return (NET_SOCK_BSD_ERR_SEL);
+            }
+            sock_tbl[sock_nbr] = p_sock->SockPtr;
+            id_tbl[sock_nbr]   = sock_id;
+            sock_nbr++;
+        }
+        NET_SOCK_DESC_INIT(p_sock_desc_rd);
+    }
+    if (p_sock_desc_wr != DEF_NULL) {
+        NET_SOCK_DESC_INIT(p_sock_desc_wr);
+    }
+    if (p_sock_desc_err != DEF_NULL) {
+        NET_SOCK_DESC_INIT(p_sock_desc_err);
+    }
+
+    timeout_ms = HOST_SIM_TIMEOUT_INFINITE;
+    if (p_timeout != DEF_NULL) {
+        timeout_ms = (p_timeout->timeout_sec * DEF_TIME_NBR_mS_PER_SEC) +
+                     (p_timeout->timeout_us  / (DEF_TIME_NBR_uS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC));
+    }
+   (void)HostSim_SockWait(sock_tbl, sock_nbr, timeout_ms);
+
+    rtn = 0;
+    for (ix = 0u; ix < sock_nbr; ix++) {
+        if (HostSim_SockRdy(sock_tbl[ix]) == DEF_YES) {
+            NET_SOCK_DESC_SET(id_tbl[ix], p_sock_desc_rd);
+            rtn++;
+        }
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (rtn);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetSock_CfgBlock()
+*
+* Description : Configure the blocking mode of a socket.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetSock_CfgBlock (NET_SOCK_ID   sock_id,
+                               CPU_INT08U    block,
+                               NET_ERR      *p_err)
+{
+    NET_SIM_SOCK  *p_sock;
+
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (DEF_FAIL);
+    }
+
+    p_sock->Block = (block == NET_SOCK_BLOCK_SEL_NO_BLOCK) ? DEF_NO : DEF_YES;
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     NetSock_CfgTimeoutRxQ_Set()
+*
+* Description : Configure the receive timeout of a socket, in milliseconds (0 : infinite).
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetSock_CfgTimeoutRxQ_Set (NET_SOCK_ID   sock_id,
+                                        CPU_INT32U    timeout_ms,
+                                        NET_ERR      *p_err)
+{
+    NET_SIM_SOCK  *p_sock;
+
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (DEF_FAIL);
+    }
+
+    p_sock->TimeoutRx_ms = timeout_ms;
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                   NetSock_CfgTimeoutRxQ_Get_ms()
+*
+* Description : Get the receive timeout of a socket, in milliseconds.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  NetSock_CfgTimeoutRxQ_Get_ms (NET_SOCK_ID   sock_id,
+                                          NET_ERR      *p_err)
+{
+    NET_SIM_SOCK  *p_sock;
+
+
+    p_sock = NetSim_SockGet(sock_id);
+    if (p_sock == DEF_NULL) {
+       *p_err = NET_SOCK_ERR_INVALID_SOCK;
+        return (0u);
+    }
+
+   *p_err = NET_SOCK_ERR_NONE;
+
+    return (p_sock->TimeoutRx_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                NetApp_ClientDatagramOpenByHostname()
+*
+* Description : Resolve a host name or IPv4 address string & open a datagram socket towards it.
+*
+* Argument(s) : p_sock_id           Pointer to variable that will receive the socket ID.
+*
+*               p_remote_host_name  Host name (see HostSim_HostAdd()), or IPv4 address string.
+*
+*               remote_port_nbr     Remote port number.
+*
+*               ip_family           Family resolved; a host name is only resolved for IPv4 or any family.
+*
+*               p_sock_addr         Pointer to variable that will receive the remote socket address.
+*
+*               p_is_hostname       Pointer to variable that will receive DEF_YES if a host name was resolved.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       NET_APP_ERR_NONE                    Socket opened.
+*                                       NET_APP_ERR_INVALID_ARG             Host name could not be resolved.
+*                                       NET_APP_ERR_NONE_AVAIL              No socket available.
+*
+* Return(s)   : NET_IP_ADDR_FAMILY_IPv4, if NO error.
+*
+*               NET_IP_ADDR_FAMILY_NONE, otherwise.
+*********************************************************************************************************
+*/
+
+NET_IP_ADDR_FAMILY  NetApp_ClientDatagramOpenByHostname (NET_SOCK_ID         *p_sock_id,
+                                                         CPU_CHAR            *p_remote_host_name,
+                                                         NET_PORT_NBR         remote_port_nbr,
+                                                         NET_IP_ADDR_FAMILY   ip_family,
+                                                         NET_SOCK_ADDR       *p_sock_addr,
+                                                         CPU_BOOLEAN         *p_is_hostname,
+                                                         NET_ERR             *p_err)
+{
+    HOST_SIM_ADDR  addr;
+    NET_ERR        err;
+
+
+    if (p_remote_host_name == DEF_NULL) {
+       *p_err = NET_APP_ERR_INVALID_ARG;
+        return (NET_IP_ADDR_FAMILY_NONE);
+    }
+
+   *p_is_hostname = DEF_NO;
+    addr          = NetASCII_Str_to_IPv4(p_remote_host_name, &err);
+    if (err != NET_ASCII_ERR_NONE) {
+       *p_is_hostname = DEF_YES;
+        if ((ip_family == NET_IP_ADDR_FAMILY_IPv6) ||
+            (HostSim_HostResolve(p_remote_host_name, &addr) != DEF_OK)) {
+           *p_err = NET_APP_ERR_INVALID_ARG;
+            return (NET_IP_ADDR_FAMILY_NONE);
+        }
+    }
+
+    NetSim_AddrFromSim(addr, remote_port_nbr, p_sock_addr);
+
+   *p_sock_id = NetSock_Open(NET_SOCK_PROTOCOL_FAMILY_IP_V4, NET_SOCK_TYPE_DATAGRAM, NET_SOCK_PROTOCOL_UDP, &err);
+    if (err != NET_SOCK_ERR_NONE) {
+       *p_err = NET_APP_ERR_NONE_AVAIL;
+        return (NET_IP_ADDR_FAMILY_NONE);
+    }
+
+   *p_err = NET_APP_ERR_NONE;
+
+    return (NET_IP_ADDR_FAMILY_IPv4);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetIF_GetDflt()
+*
+* Description : Get the default interface number.
+*********************************************************************************************************
+*/
+
+NET_IF_NBR  NetIF_GetDflt (void)
+{
+    return (NET_IF_NBR_DFLT);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           NetIF_MTU_Get()
+*
+* Description : Get the MTU of an interface (see HostNet_IF_MTU_Set()).
+*********************************************************************************************************
+*/
+
+NET_MTU  NetIF_MTU_Get (NET_IF_NBR   if_nbr,
+                        NET_ERR     *p_err)
+{
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return (0u);
+    }
+
+   *p_err = NET_IF_ERR_NONE;
+
+    return (NetSim_IF_MTU);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetIF_AddrHW_Get()
+*
+* Description : Get the hardware address of an interface, derived from the client node address.
+*********************************************************************************************************
+*/
+
+void  NetIF_AddrHW_Get (NET_IF_NBR   if_nbr,
+                        CPU_INT08U  *p_addr_hw,
+                        CPU_INT08U  *p_addr_len,
+                        NET_ERR     *p_err)
+{
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return;
+    }
+    if (*p_addr_len < NET_IF_HW_ADDR_LEN_MAX) {
+       *p_err = NET_ERR_INVALID_ARG;
+        return;
+    }
+
+    p_addr_hw[0] = 0x02u;
+    p_addr_hw[1] = 0x00u;
+    MEM_VAL_SET_INT32U_BIG(&p_addr_hw[2], HOST_SIM_ADDR_CLIENT);
+   *p_addr_len   = NET_IF_HW_ADDR_LEN_MAX;
+   *p_err        = NET_IF_ERR_NONE;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetIGMP_HostGrpJoin()
+*
+* Description : Join an IPv4 multicast group on the client node.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetIGMP_HostGrpJoin (NET_IF_NBR      if_nbr,
+                                  NET_IPv4_ADDR   addr_grp,
+                                  NET_ERR        *p_err)
+{
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return (DEF_FAIL);
+    }
+    if (HostSim_GrpJoin(addr_grp) != DEF_OK) {
+       *p_err = NET_IGMP_ERR_HOST_GRP_NONE_AVAIL;
+        return (DEF_FAIL);
+    }
+
+   *p_err = NET_IGMP_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetIGMP_HostGrpLeave()
+*
+* Description : Leave an IPv4 multicast group.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  NetIGMP_HostGrpLeave (NET_IF_NBR      if_nbr,
+                                   NET_IPv4_ADDR   addr_grp,
+                                   NET_ERR        *p_err)
+{
+    if (if_nbr != NET_IF_NBR_DFLT) {
+       *p_err = NET_IF_ERR_INVALID_IF;
+        return (DEF_FAIL);
+    }
+    if (HostSim_GrpLeave(addr_grp) != DEF_OK) {
+       *p_err = NET_IGMP_ERR_HOST_GRP_NOT_FOUND;
+        return (DEF_FAIL);
+    }
+
+   *p_err = NET_IGMP_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          NetSim_SockGet()
+*
+* Description : Get the table entry of an open socket.
+*********************************************************************************************************
+*/
+
+static  NET_SIM_SOCK  *NetSim_SockGet (NET_SOCK_ID  sock_id)
+{
+    if ((sock_id <  0) ||
+        (sock_id >= (NET_SOCK_ID)NET_SOCK_CFG_NBR_SOCK)) {
+        return (DEF_NULL);
+    }
+    if (NetSim_SockTbl[sock_id].SockPtr == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    return (&NetSim_SockTbl[sock_id]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         NetSim_AddrToSim()
+*
+* Description : Convert an IPv4 socket address to a simulated address & port, in host order.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  NetSim_AddrToSim (const  NET_SOCK_ADDR  *p_addr,
+                                              HOST_SIM_ADDR  *p_addr_sim,
+                                              CPU_INT16U     *p_port)
+{
+    const  NET_SOCK_ADDR_IPv4  *p_addr_v4;
+
+
+    if ((p_addr             == DEF_NULL) ||
+        (p_addr->AddrFamily != NET_SOCK_ADDR_FAMILY_IP_V4)) {
+        return (DEF_FAIL);
+    }
+
+    p_addr_v4   = (const NET_SOCK_ADDR_IPv4 *)p_addr;
+   *p_addr_sim  =  NET_UTIL_NET_TO_HOST_32(p_addr_v4->Addr);
+   *p_port      =  NET_UTIL_NET_TO_HOST_16(p_addr_v4->Port);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        NetSim_AddrFromSim()
+*
+* Description : Convert a simulated address & port to an IPv4 socket address.
+*********************************************************************************************************
+*/
+
+static  void  NetSim_AddrFromSim (HOST_SIM_ADDR   addr,
+                                  CPU_INT16U      port,
+                                  NET_SOCK_ADDR  *p_addr)
+{
+    NET_SOCK_ADDR_IPv4  *p_addr_v4;
+
+
+    Mem_Clr(p_addr, sizeof(NET_SOCK_ADDR));
+    p_addr_v4             = (NET_SOCK_ADDR_IPv4 *)p_addr;
+    p_addr_v4->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V4;
+    p_addr_v4->Port       =  NET_UTIL_HOST_TO_NET_16(port);
+    p_addr_v4->Addr       =  NET_UTIL_HOST_TO_NET_32(addr);
+}
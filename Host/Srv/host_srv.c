@@ -0,0 +1,1030 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST PORT : TFTP TEST SERVER
+*
+* Filename : host_srv.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) See 'host_srv.h  Note #1'.
+*
+*            (2) A write transfer dallies for one timeout after the last ACK, so that a DATA re-tx'd by a
+*                client which lost the last ACK is ACK'd again (RFC 1350, section 6).
+*
+*            (3) Block numbers are counted on 32 bits & tx'd on 16 bits : after block 65535, the wire number
+*                rolls over to the 'rollover' option value, 0 by default (see 'host_srv.h  Note #5d').
+*
+*            (4) A read transfer tx's a window of blocks, then waits for an ACK (RFC 7440).  An ACK of a block
+*                in the window slides the window past that block, so that the blocks following a block lost
+*                are re-tx'd at once.  On timeout, the window is re-tx'd from the first block NOT ACK'd.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+#define    _FILE_OFFSET_BITS       64
+
+#include  "host_srv.h"
+#include  <lib_mem.h>
+#include  <lib_str.h>
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <sys/types.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  HOST_SRV_OPCODE_RRQ                               1u
+#define  HOST_SRV_OPCODE_WRQ                               2u
+#define  HOST_SRV_OPCODE_DATA                              3u
+#define  HOST_SRV_OPCODE_ACK                               4u
+#define  HOST_SRV_OPCODE_ERR                               5u
+#define  HOST_SRV_OPCODE_OACK                              6u
+
+#define  HOST_SRV_ERR_CODE_NOT_DEF                         0u
+#define  HOST_SRV_ERR_CODE_FILE_NOT_FOUND                  1u
+#define  HOST_SRV_ERR_CODE_ACCESS                          2u
+#define  HOST_SRV_ERR_CODE_ILLEGAL_OP                      4u
+#define  HOST_SRV_ERR_CODE_UNKNOWN_TID                     5u
+#define  HOST_SRV_ERR_CODE_OPT                             8u
+
+#define  HOST_SRV_HDR_LEN                                  4u
+#define  HOST_SRV_BLK_SIZE_DFLT                          512u
+#define  HOST_SRV_BLK_SIZE_MIN                             8u   /* RFC 2348.                                            */
+#define  HOST_SRV_BLK_SIZE_MAX                         65464u
+#define  HOST_SRV_WIN_SIZE_MAX                         65535u   /* RFC 7440.                                            */
+#define  HOST_SRV_OACK_LEN_MAX                           512u
+#define  HOST_SRV_PKT_LEN_MAX                          65536u
+
+#define  HOST_SRV_PATH_LEN_MAX                           512u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  enum  host_srv_state {
+    HOST_SRV_STATE_FREE,
+    HOST_SRV_STATE_OACK,                                        /* OACK tx'd for a RRQ, waiting for ACK 0.              */
+    HOST_SRV_STATE_RD,                                          /* Server tx's DATA (RRQ).                              */
+    HOST_SRV_STATE_WR,                                          /* Server rx's DATA (WRQ).                              */
+    HOST_SRV_STATE_DALLY                                        /* See Note #2.                                         */
+} HOST_SRV_STATE;
+
+typedef  struct  host_srv_sess {
+    HOST_SRV_STATE   State;
+    CPU_INT32S       EP;
+    HOST_SRV_ADDR    Peer;
+    FILE            *FilePtr;
+
+    CPU_INT32U       BlkSize;
+    CPU_INT32U       WinSize;
+    CPU_INT32U       BlkRollover;                               /* Wire blk nbr following 65535 (see Note #3).          */
+    CPU_INT32U       BlkNbr;                                    /* Highest blk nbr tx'd/rx'd.                           */
+    CPU_INT32U       BlkAckd;                                   /* RRQ : last blk ACK'd        (see Note #4).           */
+    CPU_INT32U       BlkEnd;                                    /* RRQ : last (short) blk nbr, 0 until rd.              */
+    CPU_INT32U       BlkRd;                                     /* RRQ : last blk rd from the file.                     */
+
+    CPU_INT08U      *TxBufPtr;                                  /* Last pkt tx'd, for re-tx.                            */
+    CPU_INT32U       TxLen;
+
+    CPU_INT32U       TS_Tmr_ms;
+    CPU_INT32U       RetryCtr;
+} HOST_SRV_SESS;
+
+struct  host_srv {
+    HOST_SRV_CFG     Cfg;
+    HOST_SRV_IO      IO;
+    void            *IO_ArgPtr;
+    HOST_SRV_SESS    SessTbl[HOST_SRV_SESS_NBR_MAX];
+    HOST_SRV_STATS   Stats;
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  void            HostSrv_RxReq     (HOST_SRV              *p_srv,
+                                           const  HOST_SRV_ADDR  *p_addr,
+                                           const  CPU_INT08U     *p_pkt,
+                                           CPU_INT32U             len,
+                                           CPU_INT32U             now_ms);
+
+static  void            HostSrv_RxAck     (HOST_SRV              *p_srv,
+                                           HOST_SRV_SESS         *p_sess,
+                                           CPU_INT32U             blk_nbr,
+                                           CPU_INT32U             now_ms);
+
+static  void            HostSrv_RxData    (HOST_SRV              *p_srv,
+                                           HOST_SRV_SESS         *p_sess,
+                                           const  CPU_INT08U     *p_pkt,
+                                           CPU_INT32U             len,
+                                           CPU_INT32U             now_ms);
+
+static  CPU_BOOLEAN     HostSrv_RxReqOpt  (HOST_SRV              *p_srv,
+                                           HOST_SRV_SESS         *p_sess,
+                                           const  HOST_SRV_ADDR  *p_addr,
+                                           CPU_INT16U             opcode,
+                                           const  CPU_CHAR       *p_opt,
+                                           CPU_INT32U             opt_len);
+
+static  void            HostSrv_TxWin     (HOST_SRV              *p_srv,
+                                           HOST_SRV_SESS         *p_sess,
+                                           CPU_INT32U             now_ms);
+
+static  void            HostSrv_TxAck     (HOST_SRV              *p_srv,
+                                           HOST_SRV_SESS         *p_sess,
+                                           CPU_INT32U             now_ms);
+
+static  void            HostSrv_TxErr     (HOST_SRV              *p_srv,
+                                           CPU_INT32S             ep,
+                                           const  HOST_SRV_ADDR  *p_addr,
+                                           CPU_INT16U             code,
+                                           const  CPU_CHAR       *p_msg);
+
+static  void            HostSrv_SessTx    (HOST_SRV              *p_srv,
+                                           HOST_SRV_SESS         *p_sess,
+                                           CPU_INT32U             now_ms);
+
+static  void            HostSrv_SessEnd   (HOST_SRV              *p_srv,
+                                           HOST_SRV_SESS         *p_sess,
+                                           CPU_BOOLEAN            ok);
+
+static  HOST_SRV_SESS  *HostSrv_SessGet   (HOST_SRV              *p_srv,
+                                           CPU_INT32S             ep);
+
+static  CPU_INT16U      HostSrv_BlkWire   (const  HOST_SRV_SESS  *p_sess,
+                                           CPU_INT32U             blk_nbr);
+
+static  CPU_BOOLEAN     HostSrv_TmrExpired(CPU_INT32U             ts_ms,
+                                           CPU_INT32U             now_ms);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          HostSrv_Create()
+*
+* Description : Create a server.
+*
+* Argument(s) : p_cfg       Pointer to server configuration.
+*
+*               p_io        Pointer to the endpoint operations of the driver (see 'host_srv.h  Note #1').
+*
+*               p_io_arg    Argument passed to the endpoint operations.
+*
+* Return(s)   : Pointer to server, if NO error.
+*
+*               NULL,              otherwise.
+*********************************************************************************************************
+*/
+
+HOST_SRV  *HostSrv_Create (const  HOST_SRV_CFG  *p_cfg,
+                           const  HOST_SRV_IO   *p_io,
+                                  void          *p_io_arg)
+{
+    HOST_SRV  *p_srv;
+
+
+    p_srv = (HOST_SRV *)calloc(1u, sizeof(HOST_SRV));
+    if (p_srv == DEF_NULL) {
+        return (DEF_NULL);
+    }
+
+    p_srv->Cfg       = *p_cfg;
+    p_srv->IO        = *p_io;
+    p_srv->IO_ArgPtr =  p_io_arg;
+
+    return (p_srv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            HostSrv_Del()
+*
+* Description : Abort all transfers & delete a server.
+*********************************************************************************************************
+*/
+
+void  HostSrv_Del (HOST_SRV  *p_srv)
+{
+    CPU_INT32U  ix;
+
+
+    if (p_srv == DEF_NULL) {
+        return;
+    }
+
+    for (ix = 0u; ix < HOST_SRV_SESS_NBR_MAX; ix++) {
+        if (p_srv->SessTbl[ix].State != HOST_SRV_STATE_FREE) {
+            HostSrv_SessEnd(p_srv, &p_srv->SessTbl[ix], DEF_NO);
+        }
+    }
+
+    free(p_srv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            HostSrv_Rx()
+*
+* Description : Process a packet received on an endpoint.
+*
+* Argument(s) : p_srv       Pointer to server.
+*
+*               ep          Endpoint the packet was received on.
+*
+*               p_addr      Pointer to sender address.
+*
+*               p_pkt       Pointer to packet.
+*
+*               len         Packet length, in octets.
+*
+*               now_ms      Current time, in milliseconds.
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+void  HostSrv_Rx (       HOST_SRV       *p_srv,
+                         CPU_INT32S      ep,
+                  const  HOST_SRV_ADDR  *p_addr,
+                  const  CPU_INT08U     *p_pkt,
+                         CPU_INT32U      len,
+                         CPU_INT32U      now_ms)
+{
+    HOST_SRV_SESS  *p_sess;
+    CPU_INT16U      opcode;
+
+
+    p_srv->Stats.RxPktCtr++;
+
+    if (len < HOST_SRV_HDR_LEN) {
+        return;
+    }
+
+    if (ep == HOST_SRV_EP_REQ) {
+        HostSrv_RxReq(p_srv, p_addr, p_pkt, len, now_ms);
+        return;
+    }
+
+    p_sess = HostSrv_SessGet(p_srv, ep);
+    if (p_sess == DEF_NULL) {
+        return;
+    }
+                                                                /* Pkt from another TID : rejected (RFC 1350, sec 4).   */
+    if ((p_addr->Len != p_sess->Peer.Len) ||
+        (Mem_Cmp(p_addr->Addr, p_sess->Peer.Addr, p_addr->Len) == DEF_NO)) {
+        HostSrv_TxErr(p_srv, ep, p_addr, HOST_SRV_ERR_CODE_UNKNOWN_TID, "Unknown transfer ID");
+        return;
+    }
+
+    opcode = MEM_VAL_GET_INT16U_BIG(&p_pkt[0]);
+    switch (opcode) {
+        case HOST_SRV_OPCODE_ACK:
+             HostSrv_RxAck(p_srv, p_sess, MEM_VAL_GET_INT16U_BIG(&p_pkt[2]), now_ms);
+             break;
+
+        case HOST_SRV_OPCODE_DATA:
+             HostSrv_RxData(p_srv, p_sess, p_pkt, len, now_ms);
+             break;
+
+        case HOST_SRV_OPCODE_ERR:
+             HostSrv_SessEnd(p_srv, p_sess, DEF_NO);
+             break;
+
+        default:
+             HostSrv_TxErr(p_srv, ep, p_addr, HOST_SRV_ERR_CODE_ILLEGAL_OP, "Illegal operation");
+             HostSrv_SessEnd(p_srv, p_sess, DEF_NO);
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            HostSrv_Tmr()
+*
+* Description : Process the expired transfer timers.
+*
+* Argument(s) : p_srv       Pointer to server.
+*
+*               now_ms      Current time, in milliseconds.
+*
+* Return(s)   : Time until the next timer expires, in milliseconds, or HOST_SRV_TMR_NONE if no timer runs.
+*********************************************************************************************************
+*/
+
+CPU_INT32U  HostSrv_Tmr (HOST_SRV    *p_srv,
+                         CPU_INT32U   now_ms)
+{
+    HOST_SRV_SESS  *p_sess;
+    CPU_INT32U      ix;
+    CPU_INT32U      dly_ms;
+    CPU_INT32U      dly_min_ms;
+
+
+    dly_min_ms = HOST_SRV_TMR_NONE;
+    for (ix = 0u; ix < HOST_SRV_SESS_NBR_MAX; ix++) {
+        p_sess = &p_srv->SessTbl[ix];
+        if (p_sess->State == HOST_SRV_STATE_FREE) {
+            continue;
+        }
+
+        if (HostSrv_TmrExpired(p_sess->TS_Tmr_ms, now_ms) == DEF_YES) {
+            if (p_sess->State == HOST_SRV_STATE_DALLY) {
+                HostSrv_SessEnd(p_srv, p_sess, DEF_YES);
+                continue;
+            }
+            if (p_sess->RetryCtr >= p_srv->Cfg.RetryMax) {
+                HostSrv_SessEnd(p_srv, p_sess, DEF_NO);
+                continue;
+            }
+            p_sess->RetryCtr++;
+            if (p_sess->State == HOST_SRV_STATE_RD) {           /* Re-tx the window (see Note #4).                      */
+                HostSrv_TxWin(p_srv, p_sess, now_ms);
+            } else {
+                p_srv->Stats.TxRetryCtr++;
+                HostSrv_SessTx(p_srv, p_sess, now_ms);
+            }
+            if (p_sess->State == HOST_SRV_STATE_FREE) {
+                continue;
+            }
+        }
+
+        dly_ms     = p_sess->TS_Tmr_ms - now_ms;
+        dly_min_ms = DEF_MIN(dly_min_ms, dly_ms);
+    }
+
+    return (dly_min_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSrv_StatsGet()
+*
+* Description : Get the server statistics.
+*********************************************************************************************************
+*/
+
+void  HostSrv_StatsGet (HOST_SRV        *p_srv,
+                        HOST_SRV_STATS  *p_stats)
+{
+   *p_stats = p_srv->Stats;
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           HostSrv_RxReq()
+*
+* Description : Process a RRQ or WRQ : open the file & a transfer endpoint, & start the transfer.
+*
+* Note(s)     : (1) File names are restricted to the served directory : absolute names & names containing
+*                   ".." are rejected.
+*
+*               (2) The OACK, if any, is built in the tx buffer by HostSrv_RxReqOpt() & replaces the first
+*                   DATA of a RRQ or the ACK 0 of a WRQ.
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_RxReq (       HOST_SRV       *p_srv,
+                             const  HOST_SRV_ADDR  *p_addr,
+                             const  CPU_INT08U     *p_pkt,
+                                    CPU_INT32U      len,
+                                    CPU_INT32U      now_ms)
+{
+    HOST_SRV_SESS   *p_sess;
+    const CPU_CHAR  *p_filename;
+    const CPU_CHAR  *p_mode;
+    const CPU_CHAR  *p_opt;
+    CPU_CHAR         path[HOST_SRV_PATH_LEN_MAX];
+    CPU_INT16U       opcode;
+    CPU_INT32U       ix;
+    CPU_INT32U       filename_len;
+    CPU_INT32U       mode_len;
+    CPU_INT32U       opt_len;
+    CPU_BOOLEAN      oack;
+
+
+    opcode = MEM_VAL_GET_INT16U_BIG(&p_pkt[0]);
+    if ((opcode != HOST_SRV_OPCODE_RRQ) &&
+        (opcode != HOST_SRV_OPCODE_WRQ)) {
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_ILLEGAL_OP, "Illegal operation");
+        return;
+    }
+
+    p_filename   = (const CPU_CHAR *)&p_pkt[2];
+    filename_len =  Str_Len_N(p_filename, len - 2u);
+    if (filename_len + 3u >= len) {                             /* Name & mode MUST be NUL-terminated.                  */
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_ILLEGAL_OP, "Malformed request");
+        return;
+    }
+    p_mode   = p_filename + filename_len + 1u;
+    mode_len = Str_Len_N(p_mode, len - 3u - filename_len);
+    if (mode_len >= len - 3u - filename_len) {
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_ILLEGAL_OP, "Malformed request");
+        return;
+    }
+    p_opt = p_mode + mode_len + 1u;
+                                                                /* See Note #1.                                         */
+    if ((p_filename[0] == '/') ||
+        (strstr(p_filename, "..") != DEF_NULL)) {
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_ACCESS, "Access violation");
+        return;
+    }
+
+    p_sess = DEF_NULL;
+    for (ix = 0u; ix < HOST_SRV_SESS_NBR_MAX; ix++) {
+        if (p_srv->SessTbl[ix].State == HOST_SRV_STATE_FREE) {
+            p_sess = &p_srv->SessTbl[ix];
+            break;
+        }
+    }
+    if (p_sess == DEF_NULL) {
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_NOT_DEF, "Server busy");
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", p_srv->Cfg.RootDirPtr, p_filename);
+
+    Mem_Clr(p_sess, sizeof(HOST_SRV_SESS));
+    p_sess->Peer    = *p_addr;
+    p_sess->BlkSize =  HOST_SRV_BLK_SIZE_DFLT;
+    p_sess->WinSize =  1u;
+    p_sess->FilePtr =  fopen(path, (opcode == HOST_SRV_OPCODE_RRQ) ? "rb" : "wb");
+    if (p_sess->FilePtr == DEF_NULL) {
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr,
+                     (opcode == HOST_SRV_OPCODE_RRQ) ? HOST_SRV_ERR_CODE_FILE_NOT_FOUND : HOST_SRV_ERR_CODE_ACCESS,
+                     (opcode == HOST_SRV_OPCODE_RRQ) ? "File not found"                 : "Access violation");
+        return;
+    }
+
+    if (p_srv->Cfg.OptEn == DEF_YES) {
+        opt_len = len - (CPU_INT32U)((const CPU_INT08U *)p_opt - p_pkt);
+        if (HostSrv_RxReqOpt(p_srv, p_sess, p_addr, opcode, p_opt, opt_len) != DEF_OK) {
+            fclose(p_sess->FilePtr);
+            Mem_Clr(p_sess, sizeof(HOST_SRV_SESS));
+            return;
+        }
+    }
+
+    oack = (p_sess->TxBufPtr != DEF_NULL) ? DEF_YES : DEF_NO;
+    if (oack == DEF_NO) {
+        p_sess->TxBufPtr = (CPU_INT08U *)malloc(HOST_SRV_HDR_LEN + p_sess->BlkSize);
+    }
+    p_sess->EP = p_srv->IO.EpOpen(p_srv->IO_ArgPtr);
+    if ((p_sess->TxBufPtr == DEF_NULL) ||
+        (p_sess->EP       <= HOST_SRV_EP_REQ)) {
+        free(p_sess->TxBufPtr);
+        fclose(p_sess->FilePtr);
+        Mem_Clr(p_sess, sizeof(HOST_SRV_SESS));
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_NOT_DEF, "Server busy");
+        return;
+    }
+
+    if (oack == DEF_YES) {                                      /* See Note #2.                                         */
+        p_sess->State = (opcode == HOST_SRV_OPCODE_RRQ) ? HOST_SRV_STATE_OACK : HOST_SRV_STATE_WR;
+        HostSrv_SessTx(p_srv, p_sess, now_ms);
+    } else if (opcode == HOST_SRV_OPCODE_RRQ) {
+        p_sess->State = HOST_SRV_STATE_RD;
+        HostSrv_TxWin(p_srv, p_sess, now_ms);
+    } else {
+        p_sess->State = HOST_SRV_STATE_WR;
+        HostSrv_TxAck(p_srv, p_sess, now_ms);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSrv_RxReqOpt()
+*
+* Description : Process the options of a request (see 'host_srv.h  Note #5') & build the OACK.
+*
+* Argument(s) : p_srv       Pointer to server.
+*
+*               p_sess      Pointer to the transfer being set up; its file is open.
+*
+*               p_addr      Pointer to client address.
+*
+*               opcode      Request opcode.
+*
+*               p_opt       Pointer to the first option name.
+*
+*               opt_len     Length of the options, in octets.
+*
+* Return(s)   : DEF_OK,   if NO option is rejected.  If an option is accepted, the OACK is in a tx buffer
+*                         allocated for the transfer (see Note #1).
+*
+*               DEF_FAIL, otherwise : an ERROR is tx'd.
+*
+* Note(s)     : (1) The tx buffer is allocated for the block size negotiated, & at least for the OACK.
+*
+*               (2) An incomplete trailing option is ignored.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  HostSrv_RxReqOpt (       HOST_SRV       *p_srv,
+                                              HOST_SRV_SESS  *p_sess,
+                                       const  HOST_SRV_ADDR  *p_addr,
+                                              CPU_INT16U      opcode,
+                                       const  CPU_CHAR       *p_opt,
+                                              CPU_INT32U      opt_len)
+{
+    CPU_CHAR          oack[HOST_SRV_OACK_LEN_MAX];
+    CPU_INT32U        oack_len;
+    const  CPU_CHAR  *p_val;
+    CPU_CHAR         *p_end;
+    CPU_INT32U        name_len;
+    CPU_INT32U        val_len;
+    CPU_INT32U        val_max;
+    unsigned  long    val;
+    off_t             file_size;
+    int               wr_len;
+
+
+    oack_len = 0u;
+    while (opt_len > 0u) {
+        name_len = Str_Len_N(p_opt, opt_len);
+        if (name_len + 1u >= opt_len) {                         /* See Note #2.                                         */
+            break;
+        }
+        p_val   = p_opt + name_len + 1u;
+        val_len = Str_Len_N(p_val, opt_len - name_len - 1u);
+        if (val_len >= opt_len - name_len - 1u) {
+            break;
+        }
+
+        val = strtoul(p_val, &p_end, 10);
+        if ((val_len == 0u) || (*p_end != ASCII_CHAR_NULL)) {
+            val = DEF_INT_32U_MAX_VAL;                          /* Not a nbr : rejected below, unless ignored.          */
+        }
+
+        wr_len = -1;
+        if (Str_CmpIgnoreCase(p_opt, "blksize") == 0) {
+            if ((val < HOST_SRV_BLK_SIZE_MIN) ||
+                (val > HOST_SRV_BLK_SIZE_MAX)) {
+                wr_len = -2;
+            } else {
+                val_max         = (p_srv->Cfg.BlkSizeMax != 0u) ? p_srv->Cfg.BlkSizeMax : HOST_SRV_BLK_SIZE_MAX;
+                p_sess->BlkSize = DEF_MIN((CPU_INT32U)val, val_max);
+                wr_len          = snprintf(&oack[oack_len], sizeof(oack) - oack_len, "blksize%c%u",
+                                           ASCII_CHAR_NULL, (unsigned)p_sess->BlkSize);
+            }
+
+        } else if (Str_CmpIgnoreCase(p_opt, "windowsize") == 0) {
+            if ((val < 1u) ||
+                (val > HOST_SRV_WIN_SIZE_MAX)) {
+                wr_len = -2;
+            } else {
+                val_max         = (p_srv->Cfg.WinSizeMax != 0u) ? p_srv->Cfg.WinSizeMax : HOST_SRV_WIN_SIZE_MAX;
+                p_sess->WinSize = DEF_MIN((CPU_INT32U)val, val_max);
+                wr_len          = snprintf(&oack[oack_len], sizeof(oack) - oack_len, "windowsize%c%u",
+                                           ASCII_CHAR_NULL, (unsigned)p_sess->WinSize);
+            }
+
+        } else if (Str_CmpIgnoreCase(p_opt, "tsize") == 0) {
+            if (val == DEF_INT_32U_MAX_VAL) {
+                wr_len = -2;
+            } else {
+                if (opcode == HOST_SRV_OPCODE_RRQ) {
+                    fseeko(p_sess->FilePtr, 0, SEEK_END);
+                    file_size = ftello(p_sess->FilePtr);
+                    fseeko(p_sess->FilePtr, 0, SEEK_SET);
+                    val       = (unsigned long)file_size;
+                }
+                wr_len = snprintf(&oack[oack_len], sizeof(oack) - oack_len, "tsize%c%lu", ASCII_CHAR_NULL, val);
+            }
+
+        } else if (Str_CmpIgnoreCase(p_opt, "rollover") == 0) {
+            if (val > 1u) {
+                wr_len = -2;
+            } else {
+                p_sess->BlkRollover = (CPU_INT32U)val;
+                wr_len              = snprintf(&oack[oack_len], sizeof(oack) - oack_len, "rollover%c%u",
+                                               ASCII_CHAR_NULL, (unsigned)val);
+            }
+        }
+
+        if (wr_len == -2) {
+            HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_OPT, "Option negotiation failed");
+            return (DEF_FAIL);
+        }
+        if (wr_len > 0) {
+            oack_len += (CPU_INT32U)wr_len + 1u;                /* Val NUL included.                                    */
+        }
+
+        opt_len -= name_len + 1u + val_len + 1u;
+        p_opt    = p_val + val_len + 1u;
+    }
+
+    if (oack_len == 0u) {
+        return (DEF_OK);
+    }
+                                                                /* See Note #1.                                         */
+    p_sess->TxBufPtr = (CPU_INT08U *)malloc(HOST_SRV_HDR_LEN + DEF_MAX(p_sess->BlkSize, HOST_SRV_OACK_LEN_MAX));
+    if (p_sess->TxBufPtr == DEF_NULL) {
+        HostSrv_TxErr(p_srv, HOST_SRV_EP_REQ, p_addr, HOST_SRV_ERR_CODE_NOT_DEF, "Server busy");
+        return (DEF_FAIL);
+    }
+    MEM_VAL_SET_INT16U_BIG(&p_sess->TxBufPtr[0], HOST_SRV_OPCODE_OACK);
+    Mem_Copy(&p_sess->TxBufPtr[2], oack, oack_len);
+    p_sess->TxLen = 2u + oack_len;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostSrv_RxAck()
+*
+* Description : Process an ACK of a read transfer.
+*
+* Note(s)     : (1) The ACK is matched against the wire numbers of the blocks tx'd & NOT yet ACK'd; a window
+*                   holds at most 65535 blocks, so that the match is unique (see Note #3).
+*
+*               (2) An ACK of the last block ACK'd is a duplicate.  It is ignored with a window of 1 block
+*                   (no Sorcerer's Apprentice); with a larger window, it reports that the first block of the
+*                   window was lost, & the window is re-tx'd (see Note #4).
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_RxAck (HOST_SRV       *p_srv,
+                             HOST_SRV_SESS  *p_sess,
+                             CPU_INT32U      blk_nbr,
+                             CPU_INT32U      now_ms)
+{
+    CPU_INT32U  blk_ackd;
+
+
+    if (p_sess->State == HOST_SRV_STATE_OACK) {                 /* ACK 0 of the OACK : start the transfer.              */
+        if (blk_nbr == 0u) {
+            p_sess->State    = HOST_SRV_STATE_RD;
+            p_sess->RetryCtr = 0u;
+            HostSrv_TxWin(p_srv, p_sess, now_ms);
+        }
+        return;
+    }
+    if (p_sess->State != HOST_SRV_STATE_RD) {
+        return;
+    }
+                                                                /* See Note #1.                                         */
+    for (blk_ackd = p_sess->BlkNbr; blk_ackd > p_sess->BlkAckd; blk_ackd--) {
+        if (HostSrv_BlkWire(p_sess, blk_ackd) == blk_nbr) {
+            break;
+        }
+    }
+    if (blk_ackd == p_sess->BlkAckd) {                          /* See Note #2.                                         */
+        if ((p_sess->WinSize                          >  1u) &&
+            (HostSrv_BlkWire(p_sess, p_sess->BlkAckd) == blk_nbr)) {
+            HostSrv_TxWin(p_srv, p_sess, now_ms);
+        }
+        return;
+    }
+
+    p_sess->BlkAckd  = blk_ackd;
+    p_sess->RetryCtr = 0u;
+    if (p_sess->BlkAckd == p_sess->BlkEnd) {
+        HostSrv_SessEnd(p_srv, p_sess, DEF_YES);
+        return;
+    }
+
+    HostSrv_TxWin(p_srv, p_sess, now_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSrv_RxData()
+*
+* Description : Process a DATA of a write transfer.
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_RxData (       HOST_SRV       *p_srv,
+                                     HOST_SRV_SESS  *p_sess,
+                              const  CPU_INT08U     *p_pkt,
+                                     CPU_INT32U      len,
+                                     CPU_INT32U      now_ms)
+{
+    CPU_INT32U  blk_nbr;
+    CPU_INT32U  data_len;
+
+
+    if ((p_sess->State != HOST_SRV_STATE_WR) &&
+        (p_sess->State != HOST_SRV_STATE_DALLY)) {
+        return;
+    }
+
+    blk_nbr  = MEM_VAL_GET_INT16U_BIG(&p_pkt[2]);
+    data_len = len - HOST_SRV_HDR_LEN;
+
+    if (blk_nbr == HostSrv_BlkWire(p_sess, p_sess->BlkNbr)) {   /* Dup DATA : ACK'd again.                              */
+        HostSrv_SessTx(p_srv, p_sess, now_ms);
+        return;
+    }
+    if ((p_sess->State != HOST_SRV_STATE_WR) ||
+        (blk_nbr       != HostSrv_BlkWire(p_sess, p_sess->BlkNbr + 1u))) {
+        return;
+    }
+
+    if (data_len > p_sess->BlkSize) {
+        HostSrv_TxErr(p_srv, p_sess->EP, &p_sess->Peer, HOST_SRV_ERR_CODE_ILLEGAL_OP, "Block too long");
+        HostSrv_SessEnd(p_srv, p_sess, DEF_NO);
+        return;
+    }
+    if (fwrite(&p_pkt[HOST_SRV_HDR_LEN], 1u, data_len, p_sess->FilePtr) != data_len) {
+        HostSrv_TxErr(p_srv, p_sess->EP, &p_sess->Peer, HOST_SRV_ERR_CODE_NOT_DEF, "Write error");
+        HostSrv_SessEnd(p_srv, p_sess, DEF_NO);
+        return;
+    }
+
+    p_sess->BlkNbr++;
+    p_sess->RetryCtr = 0u;
+    if (data_len < p_sess->BlkSize) {                           /* Last blk : dally (see Note #2).                      */
+        p_sess->State     = HOST_SRV_STATE_DALLY;
+        p_sess->TS_Tmr_ms = now_ms + p_srv->Cfg.Timeout_ms;
+        fclose(p_sess->FilePtr);                                /* File complete before the client sees the ACK.        */
+        p_sess->FilePtr   = DEF_NULL;
+    }
+    HostSrv_TxAck(p_srv, p_sess, now_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostSrv_TxWin()
+*
+* Description : Read & transmit the window of DATA following the last block ACK'd (see Note #4), & re-arm
+*               the timer.
+*
+* Note(s)     : (1) The blocks are read from the file anew, so that a window re-tx'd does NOT need a buffer
+*                   per block.  The file is only repositioned when a block is re-tx'd.
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_TxWin (HOST_SRV       *p_srv,
+                             HOST_SRV_SESS  *p_sess,
+                             CPU_INT32U      now_ms)
+{
+    CPU_INT32U  blk_nbr;
+    CPU_INT32U  blk_last;
+    size_t      data_len;
+
+
+    blk_nbr  = p_sess->BlkAckd + 1u;
+    blk_last = p_sess->BlkAckd + p_sess->WinSize;
+    if ((p_sess->BlkEnd != 0u) &&
+        (blk_last       >  p_sess->BlkEnd)) {
+        blk_last = p_sess->BlkEnd;
+    }
+                                                                /* See Note #1.                                         */
+    if ((p_sess->BlkRd + 1u != blk_nbr) &&
+        (fseeko(p_sess->FilePtr, (off_t)(blk_nbr - 1u) * p_sess->BlkSize, SEEK_SET) != 0)) {
+        HostSrv_TxErr(p_srv, p_sess->EP, &p_sess->Peer, HOST_SRV_ERR_CODE_NOT_DEF, "Read error");
+        HostSrv_SessEnd(p_srv, p_sess, DEF_NO);
+        return;
+    }
+
+    for (; blk_nbr <= blk_last; blk_nbr++) {
+        data_len      = fread(&p_sess->TxBufPtr[HOST_SRV_HDR_LEN], 1u, p_sess->BlkSize, p_sess->FilePtr);
+        p_sess->BlkRd = blk_nbr;
+        if (data_len < p_sess->BlkSize) {                       /* Last (short) blk.                                    */
+            p_sess->BlkEnd = blk_nbr;
+            blk_last       = blk_nbr;
+        }
+
+        p_sess->TxLen = HOST_SRV_HDR_LEN + (CPU_INT32U)data_len;
+        MEM_VAL_SET_INT16U_BIG(&p_sess->TxBufPtr[0], HOST_SRV_OPCODE_DATA);
+        MEM_VAL_SET_INT16U_BIG(&p_sess->TxBufPtr[2], HostSrv_BlkWire(p_sess, blk_nbr));
+
+        if (blk_nbr <= p_sess->BlkNbr) {
+            p_srv->Stats.TxRetryCtr++;
+        } else {
+            p_sess->BlkNbr = blk_nbr;
+        }
+        HostSrv_SessTx(p_srv, p_sess, now_ms);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostSrv_TxAck()
+*
+* Description : Transmit the ACK of the last DATA received in a write transfer.
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_TxAck (HOST_SRV       *p_srv,
+                             HOST_SRV_SESS  *p_sess,
+                             CPU_INT32U      now_ms)
+{
+    p_sess->TxLen = HOST_SRV_HDR_LEN;
+    MEM_VAL_SET_INT16U_BIG(&p_sess->TxBufPtr[0], HOST_SRV_OPCODE_ACK);
+    MEM_VAL_SET_INT16U_BIG(&p_sess->TxBufPtr[2], HostSrv_BlkWire(p_sess, p_sess->BlkNbr));
+
+    HostSrv_SessTx(p_srv, p_sess, now_ms);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostSrv_TxErr()
+*
+* Description : Transmit an ERROR packet.
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_TxErr (       HOST_SRV       *p_srv,
+                                    CPU_INT32S      ep,
+                             const  HOST_SRV_ADDR  *p_addr,
+                                    CPU_INT16U      code,
+                             const  CPU_CHAR       *p_msg)
+{
+    CPU_INT08U  pkt[HOST_SRV_HDR_LEN + 64u];
+    CPU_INT32U  msg_len;
+
+
+    msg_len = Str_Len_N(p_msg, sizeof(pkt) - HOST_SRV_HDR_LEN - 1u);
+    MEM_VAL_SET_INT16U_BIG(&pkt[0], HOST_SRV_OPCODE_ERR);
+    MEM_VAL_SET_INT16U_BIG(&pkt[2], code);
+    Mem_Copy(&pkt[HOST_SRV_HDR_LEN], p_msg, msg_len);
+    pkt[HOST_SRV_HDR_LEN + msg_len] = ASCII_CHAR_NULL;
+
+    p_srv->Stats.TxPktCtr++;
+    p_srv->IO.Tx(p_srv->IO_ArgPtr, ep, p_addr, pkt, HOST_SRV_HDR_LEN + msg_len + 1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSrv_SessTx()
+*
+* Description : (Re-)transmit the last packet of a transfer & re-arm its timer.
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_SessTx (HOST_SRV       *p_srv,
+                              HOST_SRV_SESS  *p_sess,
+                              CPU_INT32U      now_ms)
+{
+    p_srv->Stats.TxPktCtr++;
+    p_srv->IO.Tx(p_srv->IO_ArgPtr, p_sess->EP, &p_sess->Peer, p_sess->TxBufPtr, p_sess->TxLen);
+
+    if (p_sess->State != HOST_SRV_STATE_DALLY) {
+        p_sess->TS_Tmr_ms = now_ms + p_srv->Cfg.Timeout_ms;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSrv_SessEnd()
+*
+* Description : End a transfer & free its resources.
+*********************************************************************************************************
+*/
+
+static  void  HostSrv_SessEnd (HOST_SRV       *p_srv,
+                               HOST_SRV_SESS  *p_sess,
+                               CPU_BOOLEAN     ok)
+{
+    if (p_sess->FilePtr != DEF_NULL) {
+        fclose(p_sess->FilePtr);
+    }
+    free(p_sess->TxBufPtr);
+    p_srv->IO.EpClose(p_srv->IO_ArgPtr, p_sess->EP);
+
+    if (ok == DEF_YES) {
+        p_srv->Stats.TransferOkCtr++;
+    } else {
+        p_srv->Stats.TransferFailCtr++;
+    }
+
+    Mem_Clr(p_sess, sizeof(HOST_SRV_SESS));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSrv_SessGet()
+*
+* Description : Get the transfer served from an endpoint.
+*********************************************************************************************************
+*/
+
+static  HOST_SRV_SESS  *HostSrv_SessGet (HOST_SRV    *p_srv,
+                                         CPU_INT32S   ep)
+{
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HOST_SRV_SESS_NBR_MAX; ix++) {
+        if ((p_srv->SessTbl[ix].State != HOST_SRV_STATE_FREE) &&
+            (p_srv->SessTbl[ix].EP    == ep)) {
+            return (&p_srv->SessTbl[ix]);
+        }
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSrv_BlkWire()
+*
+* Description : Get the 16-bit wire number of a block (see Note #3).
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  HostSrv_BlkWire (const  HOST_SRV_SESS  *p_sess,
+                                            CPU_INT32U      blk_nbr)
+{
+    CPU_INT32U  span;
+
+
+    if (blk_nbr <= DEF_INT_16U_MAX_VAL) {
+        return ((CPU_INT16U)blk_nbr);
+    }
+
+    span = (DEF_INT_16U_MAX_VAL + 1u) - p_sess->BlkRollover;
+
+    return ((CPU_INT16U)(p_sess->BlkRollover + ((blk_nbr - (DEF_INT_16U_MAX_VAL + 1u)) % span)));
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSrv_TmrExpired()
+*
+* Description : Check whether a timestamp is reached, tolerating the wrap-around of the millisecond clock.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  HostSrv_TmrExpired (CPU_INT32U  ts_ms,
+                                         CPU_INT32U  now_ms)
+{
+    return (((CPU_INT32S)(now_ms - ts_ms) >= 0) ? DEF_YES : DEF_NO);
+}
@@ -0,0 +1,165 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST PORT : TFTP TEST SERVER
+*
+* Filename : host_srv.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) TFTP server (RFC 1350) used by the host tests & tools.  The protocol core does not
+*                own any socket : a driver feeds it the received packets & the current time, & provides the
+*                endpoint operations (HOST_SRV_IO) used to open transfer endpoints & transmit packets :
+*
+*                (a) 'host_srv_bsd.c' runs the server in a thread on BSD sockets bound to 127.0.0.1.
+*                (b) 'Sim/host_sim_srv.c' runs the server on the simulated network (see 'Sim/host_sim.h').
+*
+*            (2) Endpoint 0 is the request endpoint (the server port), opened by the driver.  Each transfer
+*                is served from its own endpoint (its transfer ID), opened with HOST_SRV_IO.EpOpen().
+*
+*            (3) Peer addresses are opaque to the core; they are only copied & compared.
+*
+*            (4) The core is NOT thread-safe : HostSrv_Rx() & HostSrv_Tmr() MUST be called from one thread.
+*
+*            (5) When HOST_SRV_CFG.OptEn is set, the options of a request (RFC 2347) are answered with an OACK :
+*
+*                (a) 'blksize'    (RFC 2348), capped to HOST_SRV_CFG.BlkSizeMax.
+*                (b) 'windowsize' (RFC 7440), capped to HOST_SRV_CFG.WinSizeMax.
+*                (c) 'tsize'      (RFC 2349), the file size for a RRQ & the size req'd for a WRQ.
+*                (d) 'rollover', the block number (0 or 1) that follows block 65535.  Without it, the block
+*                    number rolls over to 0.
+*
+*                Other options are ignored.  An option with an invalid value is rejected with ERROR 8.
+*********************************************************************************************************
+*/
+
+#ifndef  HOST_SRV_MODULE_PRESENT
+#define  HOST_SRV_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+
+/*
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*/
+
+#define  HOST_SRV_EP_NONE                                 -1
+#define  HOST_SRV_EP_REQ                                   0    /* See Note #2.                                         */
+
+#define  HOST_SRV_SESS_NBR_MAX                             8u
+
+#define  HOST_SRV_ADDR_LEN_MAX                            28u
+
+#define  HOST_SRV_TMR_NONE                        DEF_INT_32U_MAX_VAL
+
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef  struct  host_srv_addr {                                /* See Note #3.                                         */
+    CPU_INT32U  Len;
+    CPU_INT08U  Addr[HOST_SRV_ADDR_LEN_MAX];
+} HOST_SRV_ADDR;
+
+typedef  struct  host_srv_io {                                  /* See Note #1.                                         */
+                                                                /* Open a transfer endpoint, rtn its nbr (> 0).         */
+    CPU_INT32S   (*EpOpen) (void                 *p_arg);
+                                                                /* Close a transfer endpoint.                           */
+    void         (*EpClose)(void                 *p_arg,
+                            CPU_INT32S            ep);
+                                                                /* Tx a pkt from 'ep' to 'p_addr'.                      */
+    void         (*Tx)     (void                 *p_arg,
+                            CPU_INT32S            ep,
+                            const  HOST_SRV_ADDR *p_addr,
+                            const  CPU_INT08U    *p_pkt,
+                            CPU_INT32U            len);
+} HOST_SRV_IO;
+
+typedef  struct  host_srv_cfg {
+    const  CPU_CHAR  *RootDirPtr;                               /* Dir served; file names are relative to it.           */
+    CPU_INT32U        Timeout_ms;                               /* Re-tx timeout.                                       */
+    CPU_INT32U        RetryMax;                                 /* Max nbr of re-tx before the transfer is dropped.     */
+    CPU_BOOLEAN       OptEn;                                    /* Answer the options req'd       (see Note #5).        */
+    CPU_INT32U        BlkSizeMax;                               /* Largest blk size accepted, 0 for no limit.           */
+    CPU_INT32U        WinSizeMax;                               /* Largest window accepted,   0 for no limit.           */
+} HOST_SRV_CFG;
+
+typedef  struct  host_srv_stats {
+    CPU_INT32U  RxPktCtr;
+    CPU_INT32U  TxPktCtr;
+    CPU_INT32U  TxRetryCtr;
+    CPU_INT32U  TransferOkCtr;
+    CPU_INT32U  TransferFailCtr;
+} HOST_SRV_STATS;
+
+typedef  struct  host_srv  HOST_SRV;
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+HOST_SRV    *HostSrv_Create  (const  HOST_SRV_CFG   *p_cfg,
+                              const  HOST_SRV_IO    *p_io,
+                                     void           *p_io_arg);
+
+void         HostSrv_Del     (       HOST_SRV       *p_srv);
+
+void         HostSrv_Rx      (       HOST_SRV       *p_srv,
+                                     CPU_INT32S      ep,
+                              const  HOST_SRV_ADDR  *p_addr,
+                              const  CPU_INT08U     *p_pkt,
+                                     CPU_INT32U      len,
+                                     CPU_INT32U      now_ms);
+
+CPU_INT32U   HostSrv_Tmr     (       HOST_SRV       *p_srv,
+                                     CPU_INT32U      now_ms);
+
+void         HostSrv_StatsGet(       HOST_SRV       *p_srv,
+                                     HOST_SRV_STATS *p_stats);
+
+
+/*
+*********************************************************************************************************
+*                                      BSD SOCKET DRIVER PROTOTYPES
+*
+* Note(s) : (1) HostSrvBSD_Start() starts the server in a thread, on 127.0.0.1 & an ephemeral port returned
+*               in 'p_port'.  HostSrvBSD_Stop() stops the thread & deletes the server.
+*********************************************************************************************************
+*/
+
+typedef  struct  host_srv_bsd  HOST_SRV_BSD;
+
+HOST_SRV_BSD  *HostSrvBSD_Start   (const  HOST_SRV_CFG   *p_cfg,
+                                          CPU_INT16U     *p_port);
+
+void           HostSrvBSD_Stop    (       HOST_SRV_BSD   *p_drv);
+
+void           HostSrvBSD_StatsGet(       HOST_SRV_BSD   *p_drv,
+                                          HOST_SRV_STATS *p_stats);
+
+
+#endif
@@ -0,0 +1,461 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                               HOST PORT : TFTP TEST SERVER BSD DRIVER
+*
+* Filename : host_srv_bsd.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs the server core (see 'host_srv.h') in a thread, on UDP sockets bound to 127.0.0.1.
+*                Endpoint N is served by the socket at index N of the driver socket table.
+*
+*            (2) The thread waits with poll(), at most HOST_SRV_BSD_POLL_MAX_ms at a time, so that
+*                HostSrvBSD_Stop() is noticed promptly.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+
+#include  "host_srv.h"
+#include  <lib_mem.h>
+
+#include  <poll.h>
+#include  <pthread.h>
+#include  <stdlib.h>
+#include  <string.h>
+#include  <time.h>
+#include  <unistd.h>
+#include  <arpa/inet.h>
+#include  <netinet/in.h>
+#include  <sys/socket.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  HOST_SRV_BSD_EP_NBR_MAX                (HOST_SRV_SESS_NBR_MAX + 1u)
+
+#define  HOST_SRV_BSD_POLL_MAX_ms                         20    /* See Note #2.                                         */
+
+#define  HOST_SRV_BSD_PKT_LEN_MAX                      65536u
+
+#define  HOST_SRV_BSD_SOCK_BUF_LEN                (4u * 1024u * 1024u)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+struct  host_srv_bsd {
+    HOST_SRV            *SrvPtr;
+    int                  FD_Tbl[HOST_SRV_BSD_EP_NBR_MAX];       /* See Note #1.                                         */
+    pthread_t            Thread;
+    pthread_mutex_t      Lock;                                  /* Protects the server stats.                           */
+    volatile  int        Stop;
+    CPU_INT08U           PktBuf[HOST_SRV_BSD_PKT_LEN_MAX];
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                     LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  void        *HostSrvBSD_Task    (void                 *p_arg);
+
+static  int          HostSrvBSD_SockOpen(CPU_INT16U           *p_port);
+
+static  CPU_INT32S   HostSrvBSD_EpOpen  (void                 *p_arg);
+
+static  void         HostSrvBSD_EpClose (void                 *p_arg,
+                                         CPU_INT32S            ep);
+
+static  void         HostSrvBSD_Tx      (void                 *p_arg,
+                                         CPU_INT32S            ep,
+                                         const  HOST_SRV_ADDR *p_addr,
+                                         const  CPU_INT08U    *p_pkt,
+                                         CPU_INT32U            len);
+
+static  CPU_INT32U   HostSrvBSD_TimeGet (void);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL CONSTANTS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  const  HOST_SRV_IO  HostSrvBSD_IO = {
+    HostSrvBSD_EpOpen,
+    HostSrvBSD_EpClose,
+    HostSrvBSD_Tx
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         HostSrvBSD_Start()
+*
+* Description : Start a server on 127.0.0.1 (see 'host_srv.h  BSD SOCKET DRIVER PROTOTYPES  Note #1').
+*
+* Argument(s) : p_cfg       Pointer to server configuration.
+*
+*               p_port      Pointer to variable that will receive the server port.
+*
+* Return(s)   : Pointer to driver, if NO error.
+*
+*               NULL,              otherwise.
+*********************************************************************************************************
+*/
+
+HOST_SRV_BSD  *HostSrvBSD_Start (const  HOST_SRV_CFG  *p_cfg,
+                                        CPU_INT16U    *p_port)
+{
+    HOST_SRV_BSD  *p_drv;
+    CPU_INT32U     ix;
+
+
+    p_drv = (HOST_SRV_BSD *)calloc(1u, sizeof(HOST_SRV_BSD));
+    if (p_drv == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    for (ix = 0u; ix < HOST_SRV_BSD_EP_NBR_MAX; ix++) {
+        p_drv->FD_Tbl[ix] = -1;
+    }
+    pthread_mutex_init(&p_drv->Lock, DEF_NULL);
+
+    p_drv->FD_Tbl[HOST_SRV_EP_REQ] = HostSrvBSD_SockOpen(p_port);
+    p_drv->SrvPtr                  = HostSrv_Create(p_cfg, &HostSrvBSD_IO, p_drv);
+    if ((p_drv->FD_Tbl[HOST_SRV_EP_REQ] < 0) ||
+        (p_drv->SrvPtr                  == DEF_NULL)) {
+        HostSrvBSD_Stop(p_drv);
+        return (DEF_NULL);
+    }
+
+    if (pthread_create(&p_drv->Thread, DEF_NULL, HostSrvBSD_Task, p_drv) != 0) {
+        p_drv->Stop = 2;                                        /* Thread not started : nothing to join.                */
+        HostSrvBSD_Stop(p_drv);
+        return (DEF_NULL);
+    }
+
+    return (p_drv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostSrvBSD_Stop()
+*
+* Description : Stop a server started with HostSrvBSD_Start() & free its resources.
+*********************************************************************************************************
+*/
+
+void  HostSrvBSD_Stop (HOST_SRV_BSD  *p_drv)
+{
+    CPU_INT32U  ix;
+
+
+    if (p_drv == DEF_NULL) {
+        return;
+    }
+
+    if ((p_drv->SrvPtr != DEF_NULL) &&
+        (p_drv->Stop   == 0)) {
+        p_drv->Stop = 1;
+        pthread_join(p_drv->Thread, DEF_NULL);
+    }
+
+    HostSrv_Del(p_drv->SrvPtr);
+    for (ix = 0u; ix < HOST_SRV_BSD_EP_NBR_MAX; ix++) {
+        if (p_drv->FD_Tbl[ix] >= 0) {
+            close(p_drv->FD_Tbl[ix]);
+        }
+    }
+    pthread_mutex_destroy(&p_drv->Lock);
+    free(p_drv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSrvBSD_StatsGet()
+*
+* Description : Get the statistics of a running server.
+*********************************************************************************************************
+*/
+
+void  HostSrvBSD_StatsGet (HOST_SRV_BSD    *p_drv,
+                           HOST_SRV_STATS  *p_stats)
+{
+    pthread_mutex_lock(&p_drv->Lock);
+    HostSrv_StatsGet(p_drv->SrvPtr, p_stats);
+    pthread_mutex_unlock(&p_drv->Lock);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          HostSrvBSD_Task()
+*
+* Description : Server thread : wait for packets on all endpoints & run the server timers.
+*********************************************************************************************************
+*/
+
+static  void  *HostSrvBSD_Task (void  *p_arg)
+{
+    HOST_SRV_BSD             *p_drv;
+    struct  pollfd            pfd[HOST_SRV_BSD_EP_NBR_MAX];
+    CPU_INT32S                ep_tbl[HOST_SRV_BSD_EP_NBR_MAX];
+    struct  sockaddr_storage  ss;
+    socklen_t                 ss_len;
+    HOST_SRV_ADDR             addr;
+    CPU_INT32U                nbr_fd;
+    CPU_INT32U                ix;
+    CPU_INT32U                dly_ms;
+    ssize_t                   len;
+
+
+    p_drv  = (HOST_SRV_BSD *)p_arg;
+    dly_ms =  0u;
+    while (p_drv->Stop == 0) {
+        nbr_fd = 0u;
+        for (ix = 0u; ix < HOST_SRV_BSD_EP_NBR_MAX; ix++) {
+            if (p_drv->FD_Tbl[ix] >= 0) {
+                pfd[nbr_fd].fd      = p_drv->FD_Tbl[ix];
+                pfd[nbr_fd].events  = POLLIN;
+                pfd[nbr_fd].revents = 0;
+                ep_tbl[nbr_fd]      = (CPU_INT32S)ix;
+                nbr_fd++;
+            }
+        }
+
+        dly_ms = DEF_MIN(dly_ms, HOST_SRV_BSD_POLL_MAX_ms);
+        if (poll(pfd, nbr_fd, (int)dly_ms) < 0) {
+            dly_ms = HOST_SRV_BSD_POLL_MAX_ms;
+            continue;
+        }
+
+        pthread_mutex_lock(&p_drv->Lock);
+        for (ix = 0u; ix < nbr_fd; ix++) {
+            if ((pfd[ix].revents & POLLIN) == 0) {
+                continue;
+            }
+            ss_len = sizeof(ss);
+            len    = recvfrom(pfd[ix].fd, p_drv->PktBuf, sizeof(p_drv->PktBuf), MSG_DONTWAIT,
+                              (struct sockaddr *)&ss, &ss_len);
+            if (len < 0) {
+                continue;
+            }
+            Mem_Clr(&addr, sizeof(addr));
+            addr.Len = DEF_MIN((CPU_INT32U)ss_len, HOST_SRV_ADDR_LEN_MAX);
+            Mem_Copy(addr.Addr, &ss, addr.Len);
+            HostSrv_Rx(p_drv->SrvPtr, ep_tbl[ix], &addr, p_drv->PktBuf, (CPU_INT32U)len, HostSrvBSD_TimeGet());
+        }
+        dly_ms = HostSrv_Tmr(p_drv->SrvPtr, HostSrvBSD_TimeGet());
+        pthread_mutex_unlock(&p_drv->Lock);
+    }
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSrvBSD_SockOpen()
+*
+* Description : Open a UDP socket bound to 127.0.0.1 & an ephemeral port.
+*
+* Argument(s) : p_port      Pointer to variable that will receive the port, or NULL.
+*
+* Return(s)   : Socket file descriptor, if NO error.
+*
+*               -1,                     otherwise.
+*********************************************************************************************************
+*/
+
+static  int  HostSrvBSD_SockOpen (CPU_INT16U  *p_port)
+{
+    struct  sockaddr_in  sin;
+    socklen_t            sin_len;
+    int                  fd;
+    int                  buf_len;
+
+
+    fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+        return (-1);
+    }
+
+    buf_len = HOST_SRV_BSD_SOCK_BUF_LEN;                        /* Room for a whole window of large blks.               */
+   (void)setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf_len, sizeof(buf_len));
+   (void)setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buf_len, sizeof(buf_len));
+
+    Mem_Clr(&sin, sizeof(sin));
+    sin.sin_family      = AF_INET;
+    sin.sin_port        = 0u;
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sin_len             = sizeof(sin);
+    if ((bind(fd, (struct sockaddr *)&sin, sizeof(sin))         != 0) ||
+        (getsockname(fd, (struct sockaddr *)&sin, &sin_len)     != 0)) {
+        close(fd);
+        return (-1);
+    }
+
+    if (p_port != DEF_NULL) {
+       *p_port = ntohs(sin.sin_port);
+    }
+
+    return (fd);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostSrvBSD_EpOpen()
+*
+* Description : Open a transfer endpoint (see 'host_srv.h  HOST_SRV_IO').
+*********************************************************************************************************
+*/
+
+static  CPU_INT32S  HostSrvBSD_EpOpen (void  *p_arg)
+{
+    HOST_SRV_BSD  *p_drv;
+    CPU_INT32U     ix;
+
+
+    p_drv = (HOST_SRV_BSD *)p_arg;
+    for (ix = HOST_SRV_EP_REQ + 1u; ix < HOST_SRV_BSD_EP_NBR_MAX; ix++) {
+        if (p_drv->FD_Tbl[ix] < 0) {
+            p_drv->FD_Tbl[ix] = HostSrvBSD_SockOpen(DEF_NULL);
+            return ((p_drv->FD_Tbl[ix] >= 0) ? (CPU_INT32S)ix : HOST_SRV_EP_NONE);
+        }
+    }
+
+    return (HOST_SRV_EP_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSrvBSD_EpClose()
+*
+* Description : Close a transfer endpoint.
+*********************************************************************************************************
+*/
+
+static  void  HostSrvBSD_EpClose (void        *p_arg,
+                                  CPU_INT32S   ep)
+{
+    HOST_SRV_BSD  *p_drv;
+
+
+    p_drv = (HOST_SRV_BSD *)p_arg;
+    if ((ep <= HOST_SRV_EP_REQ) ||
+        (ep >= (CPU_INT32S)HOST_SRV_BSD_EP_NBR_MAX)) {
+        return;
+    }
+
+    close(p_drv->FD_Tbl[ep]);
+    p_drv->FD_Tbl[ep] = -1;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostSrvBSD_Tx()
+*
+* Description : Transmit a packet from an endpoint.
+*********************************************************************************************************
+*/
+
+static  void  HostSrvBSD_Tx (       void           *p_arg,
+                                    CPU_INT32S      ep,
+                             const  HOST_SRV_ADDR  *p_addr,
+                             const  CPU_INT08U     *p_pkt,
+                                    CPU_INT32U      len)
+{
+    HOST_SRV_BSD  *p_drv;
+
+
+    p_drv = (HOST_SRV_BSD *)p_arg;
+    if ((ep <  HOST_SRV_EP_REQ) ||
+        (ep >= (CPU_INT32S)HOST_SRV_BSD_EP_NBR_MAX) ||
+        (p_drv->FD_Tbl[ep] < 0)) {
+        return;
+    }
+
+   (void)sendto(p_drv->FD_Tbl[ep], p_pkt, len, 0, (const struct sockaddr *)p_addr->Addr, (socklen_t)p_addr->Len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        HostSrvBSD_TimeGet()
+*
+* Description : Get the host monotonic time, in milliseconds.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  HostSrvBSD_TimeGet (void)
+{
+    struct  timespec  ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((CPU_INT32U)(((CPU_INT64U)ts.tv_sec * 1000u) + ((CPU_INT64U)ts.tv_nsec / 1000000u)));
+}
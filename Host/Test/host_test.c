@@ -0,0 +1,263 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      HOST PORT : TEST HELPERS
+*
+* Filename : host_test.c
+* Version  : V2.01.00
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+#define    _DEFAULT_SOURCE
+
+#include  "host_test.h"
+
+#include  <stdlib.h>
+#include  <string.h>
+#include  <unistd.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  HOST_TEST_DIR_NBR_MAX                             8u
+#define  HOST_TEST_PATH_LEN_MAX                          512u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+CPU_INT32U  HostTest_FailCtr;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR    HostTest_DirTbl[HOST_TEST_DIR_NBR_MAX][HOST_TEST_PATH_LEN_MAX];
+static  CPU_INT32U  HostTest_DirNbr;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          GLOBAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                        HostTest_DirCreate()
+*
+* Description : Create a scratch directory, removed with its content by HostTest_End().
+*
+* Return(s)   : Path of the directory, if NO error.
+*
+*               NULL,                  otherwise.
+*********************************************************************************************************
+*/
+
+CPU_CHAR  *HostTest_DirCreate (void)
+{
+    CPU_CHAR  *p_dir;
+
+
+    if (HostTest_DirNbr >= HOST_TEST_DIR_NBR_MAX) {
+        return (DEF_NULL);
+    }
+
+    p_dir = HostTest_DirTbl[HostTest_DirNbr];
+    snprintf(p_dir, HOST_TEST_PATH_LEN_MAX, "/tmp/tftpc_test_XXXXXX");
+    if (mkdtemp(p_dir) == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    HostTest_DirNbr++;
+
+    return (p_dir);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          HostTest_FileWr()
+*
+* Description : Write a file of pseudo-random content.
+*
+* Argument(s) : p_path      Path of the file.
+*
+*               len         File length, in octets.
+*
+*               seed        Seed of the content; files written with the same seed & length are identical.
+*
+* Return(s)   : DEF_OK,   if NO error.
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostTest_FileWr (const  CPU_CHAR    *p_path,
+                                     CPU_INT32U   len,
+                                     CPU_INT32U   seed)
+{
+    FILE        *p_file;
+    CPU_INT32U   state;
+    CPU_INT32U   ix;
+
+
+    p_file = fopen(p_path, "wb");
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    state = seed | 1u;
+    for (ix = 0u; ix < len; ix++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        fputc((int)(state & DEF_INT_08U_MAX_VAL), p_file);
+    }
+
+    return ((fclose(p_file) == 0) ? DEF_OK : DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         HostTest_FileCmp()
+*
+* Description : Compare the content of two files.
+*
+* Return(s)   : DEF_YES, if both files exist & are identical.
+*
+*               DEF_NO,  otherwise.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  HostTest_FileCmp (const  CPU_CHAR  *p_path_a,
+                               const  CPU_CHAR  *p_path_b)
+{
+    FILE         *p_file_a;
+    FILE         *p_file_b;
+    int           c_a;
+    int           c_b;
+    CPU_BOOLEAN   same;
+
+
+    p_file_a = fopen(p_path_a, "rb");
+    p_file_b = fopen(p_path_b, "rb");
+    same     = ((p_file_a != DEF_NULL) && (p_file_b != DEF_NULL)) ? DEF_YES : DEF_NO;
+    while (same == DEF_YES) {
+        c_a = fgetc(p_file_a);
+        c_b = fgetc(p_file_b);
+        if (c_a != c_b) {
+            same = DEF_NO;
+        } else if (c_a == EOF) {
+            break;
+        }
+    }
+
+    if (p_file_a != DEF_NULL) {
+        fclose(p_file_a);
+    }
+    if (p_file_b != DEF_NULL) {
+        fclose(p_file_b);
+    }
+
+    return (same);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostTest_Path()
+*
+* Description : Build the path of a file in a directory.
+*
+* Note(s)     : (1) The path is returned in one of a few rotating static buffers; it MUST be copied if
+*                   more than HOST_TEST_DIR_NBR_MAX paths are used at once.
+*********************************************************************************************************
+*/
+
+CPU_CHAR  *HostTest_Path (const  CPU_CHAR  *p_dir,
+                          const  CPU_CHAR  *p_name)
+{
+    static  CPU_CHAR    path_tbl[HOST_TEST_DIR_NBR_MAX][HOST_TEST_PATH_LEN_MAX];
+    static  CPU_INT32U  path_ix;
+    CPU_CHAR           *p_path;
+
+
+    p_path  = path_tbl[path_ix];
+    path_ix = (path_ix + 1u) % HOST_TEST_DIR_NBR_MAX;
+    snprintf(p_path, HOST_TEST_PATH_LEN_MAX, "%s/%s", p_dir, p_name);
+
+    return (p_path);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           HostTest_End()
+*
+* Description : Remove the scratch directories & report the test result.
+*
+* Return(s)   : Exit status of the test program.
+*********************************************************************************************************
+*/
+
+int  HostTest_End (void)
+{
+    CPU_CHAR    cmd[HOST_TEST_PATH_LEN_MAX + 16u];
+    CPU_INT32U  ix;
+
+
+    for (ix = 0u; ix < HostTest_DirNbr; ix++) {
+        snprintf(cmd, sizeof(cmd), "rm -rf '%s'", HostTest_DirTbl[ix]);
+        if (system(cmd) != 0) {
+            printf("could not remove %s\n", HostTest_DirTbl[ix]);
+        }
+    }
+
+    printf("%u check(s) failed\n", (unsigned)HostTest_FailCtr);
+
+    return ((HostTest_FailCtr == 0u) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
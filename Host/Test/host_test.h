@@ -0,0 +1,101 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      HOST PORT : TEST HELPERS
+*
+* Filename : host_test.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Each test program is registered with ctest & exits with a non-zero status if any check
+*                fails.  HOST_TEST_CHK() reports the failure & continues; HOST_TEST_REQ() returns from the
+*                test function.
+*********************************************************************************************************
+*/
+
+#ifndef  HOST_TEST_MODULE_PRESENT
+#define  HOST_TEST_MODULE_PRESENT
+
+#include  <cpu.h>
+#include  <lib_def.h>
+
+#include  <stdio.h>
+
+
+/*
+*********************************************************************************************************
+*                                           GLOBAL VARIABLES
+*********************************************************************************************************
+*/
+
+extern  CPU_INT32U  HostTest_FailCtr;
+
+
+/*
+*********************************************************************************************************
+*                                                MACRO'S
+*********************************************************************************************************
+*/
+
+#define  HOST_TEST_CHK(cond)                    do {                                                         \
+                                                    if (!(cond)) {                                           \
+                                                        printf("%s:%d: check failed: %s\n",                  \
+                                                               __FILE__, __LINE__, #cond);                   \
+                                                        HostTest_FailCtr++;                                  \
+                                                    }                                                        \
+                                                } while (0)
+
+#define  HOST_TEST_REQ(cond)                    do {                                                         \
+                                                    if (!(cond)) {                                           \
+                                                        printf("%s:%d: requirement failed: %s\n",            \
+                                                               __FILE__, __LINE__, #cond);                   \
+                                                        HostTest_FailCtr++;                                  \
+                                                        return;                                              \
+                                                    }                                                        \
+                                                } while (0)
+
+#define  HOST_TEST_RUN(fnct)                    do {                                                         \
+                                                    CPU_INT32U  fail_ctr = HostTest_FailCtr;                 \
+                                                    fnct();                                                  \
+                                                    printf("%-48s %s\n", #fnct,                              \
+                                                          (HostTest_FailCtr == fail_ctr) ? "ok" : "FAILED"); \
+                                                } while (0)
+
+
+/*
+*********************************************************************************************************
+*                                          FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+CPU_CHAR     *HostTest_DirCreate(void);                         /* Create a scratch dir, removed at exit.               */
+
+CPU_BOOLEAN   HostTest_FileWr   (const  CPU_CHAR    *p_path,
+                                        CPU_INT32U   len,
+                                        CPU_INT32U   seed);
+
+CPU_BOOLEAN   HostTest_FileCmp  (const  CPU_CHAR    *p_path_a,
+                                 const  CPU_CHAR    *p_path_b);
+
+CPU_CHAR     *HostTest_Path     (const  CPU_CHAR    *p_dir,
+                                 const  CPU_CHAR    *p_name);
+
+int           HostTest_End      (void);
+
+
+#endif
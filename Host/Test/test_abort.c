@@ -0,0 +1,429 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : TRANSFER ABORT TEST
+*
+* Filename : test_abort.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with transfer abort on the simulated network against the test server, &
+*                checks the transfers canceled by TFTPc_Cancel() & the ones ended by their deadline (see
+*                'tftp-c_cfg.h  TFTPc TRANSFER ABORT CONFIGURATION').
+*
+*            (2) The cancel is issued from a second thread, as from a second task.  The simulation is NOT
+*                thread-safe : the second thread only calls TFTPc_SessionIDGet() & TFTPc_Cancel(), while
+*                the client thread is held in the simulation filter, on the tx of the first ACK.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <pthread.h>
+#include  <semaphore.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_OPCODE_DATA                                  3u
+#define  TEST_OPCODE_ACK                                   4u
+#define  TEST_OPCODE_ERR                                   5u
+
+#define  TEST_DEADLINE_ms                               3000u   /* Shorter than a client RX timeout.                    */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  test_abort {
+    CPU_BOOLEAN  CancelEn;                                      /* Cancel on the 1st ACK (see Note #2).                 */
+    CPU_INT16U   DropBlkNbr;                                    /* Drop DATA blks from this one on, 0 for none.         */
+    CPU_INT16U   SrvPort;                                       /* Server TID, learnt from the 1st DATA blk.            */
+    CPU_INT32U   ErrTxCtr;                                      /* Nbr of ERRORs tx'd by the client to the server TID.  */
+    CPU_INT16U   ErrCode;
+    CPU_CHAR     ErrMsg[32];
+} TEST_ABORT;
+
+typedef  struct  test_canceler {
+    sem_t        SessionSem;                                    /* Posted when the transfer is in progress.             */
+    sem_t        CancelSem;                                     /* Posted once TFTPc_Cancel() returned.                 */
+    CPU_INT16U   SessionID;
+    TFTPc_ERR    SessionErr;
+    TFTPc_ERR    CancelOtherErr;                                /* TFTPc_Cancel() of another session ID.                */
+    CPU_BOOLEAN  CancelOk;
+    TFTPc_ERR    CancelErr;
+} TEST_CANCELER;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR       *Test_DirSrv;
+static  CPU_CHAR       *Test_DirLocal;
+static  HOST_SIM_SRV   *Test_SrvPtr;
+static  TFTPc_CFG       Test_Cfg;
+
+static  TEST_CANCELER   Test_Canceler;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_CancelTask()
+*
+* Description : Second thread : cancel the transfer in progress (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  *Test_CancelTask (void  *p_arg)
+{
+    TEST_CANCELER  *p_canceler;
+
+
+    p_canceler = (TEST_CANCELER *)p_arg;
+
+    sem_wait(&p_canceler->SessionSem);
+
+    p_canceler->SessionID = TFTPc_SessionIDGet(&p_canceler->SessionErr);
+   (void)TFTPc_Cancel((CPU_INT16U)(p_canceler->SessionID + 1u), &p_canceler->CancelOtherErr);
+    p_canceler->CancelOk  = TFTPc_Cancel(p_canceler->SessionID, &p_canceler->CancelErr);
+
+    sem_post(&p_canceler->CancelSem);
+
+    return (DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_AbortFilter()
+*
+* Description : Simulation filter : drop the DATA blks from 'DropBlkNbr' on; hold the client on its first
+*               ACK until the second thread canceled the transfer; record the ERRORs tx'd by the client.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_AbortFilter (       void          *p_arg,
+                                       const  HOST_SIM_PKT  *p_pkt)
+{
+    TEST_ABORT  *p_abort;
+    CPU_INT16U   opcode;
+    CPU_INT16U   blk_nbr;
+    CPU_INT32U   msg_len;
+
+
+    p_abort = (TEST_ABORT *)p_arg;
+    if (p_pkt->Len < 4u) {
+        return (DEF_YES);
+    }
+    opcode  = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]);
+    blk_nbr = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]);
+
+    if (p_pkt->SrcAddr == HOST_SIM_ADDR_SRV) {
+        if (opcode == TEST_OPCODE_DATA) {
+            p_abort->SrvPort = p_pkt->SrcPort;
+            if ((p_abort->DropBlkNbr >  0u) &&
+                (blk_nbr             >= p_abort->DropBlkNbr)) {
+                return (DEF_NO);
+            }
+        }
+        return (DEF_YES);
+    }
+
+    switch (opcode) {
+        case TEST_OPCODE_ACK:
+             if ((p_abort->CancelEn == DEF_YES) &&
+                 (blk_nbr           == 1u)) {
+                 p_abort->CancelEn = DEF_NO;
+                 sem_post(&Test_Canceler.SessionSem);           /* See Note #2.                                         */
+                 sem_wait(&Test_Canceler.CancelSem);
+             }
+             break;
+
+
+        case TEST_OPCODE_ERR:
+             if ((p_pkt->DstAddr == HOST_SIM_ADDR_SRV) &&
+                 (p_pkt->DstPort == p_abort->SrvPort)) {
+                 p_abort->ErrTxCtr++;
+                 p_abort->ErrCode = blk_nbr;
+                 msg_len          = DEF_MIN(p_pkt->Len - 4u, sizeof(p_abort->ErrMsg) - 1u);
+                 Mem_Copy(&p_abort->ErrMsg[0], &p_pkt->Data[4], msg_len);
+                 p_abort->ErrMsg[msg_len] = '\0';
+             }
+             break;
+
+
+        default:
+             break;
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_SimStart()
+*
+* Description : Reset the simulation & attach the server.
+*********************************************************************************************************
+*/
+
+static  void  Test_SimStart (TEST_ABORT  *p_abort)
+{
+    HOST_SRV_CFG  srv_cfg;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 12000u;
+    srv_cfg.RetryMax   = 5u;
+    Test_SrvPtr        = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_REQ(Test_SrvPtr != DEF_NULL);
+
+    HostSim_FilterSet(Test_AbortFilter, p_abort);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_SimStop()
+*
+* Description : Detach the server.
+*********************************************************************************************************
+*/
+
+static  void  Test_SimStop (void)
+{
+    HostSim_FilterSet(DEF_NULL, DEF_NULL);
+    HostSimSrv_Stop(Test_SrvPtr);
+    Test_SrvPtr = DEF_NULL;
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Idle()
+*
+* Description : With no transfer in progress, there is no session to get or to cancel.
+*********************************************************************************************************
+*/
+
+static  void  Test_Idle (void)
+{
+    CPU_INT16U   session_id;
+    CPU_BOOLEAN  ok;
+    TFTPc_ERR    err;
+
+
+    session_id = TFTPc_SessionIDGet(&err);
+    HOST_TEST_CHK(session_id == TFTPc_SESSION_ID_ANY);
+    HOST_TEST_CHK(err        == TFTPc_ERR_SESSION_NONE);
+
+    ok = TFTPc_Cancel(TFTPc_SESSION_ID_ANY, &err);
+    HOST_TEST_CHK(ok  == DEF_FAIL);
+    HOST_TEST_CHK(err == TFTPc_ERR_SESSION_NONE);
+
+    ok = TFTPc_Cancel(1u, &err);
+    HOST_TEST_CHK(ok  == DEF_FAIL);
+    HOST_TEST_CHK(err == TFTPc_ERR_SESSION_NONE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Cancel()
+*
+* Description : Cancel a get from a second thread, by its session ID (see Note #2) : the get returns
+*               TFTPc_ERR_CANCELED & the server is sent an ERROR.
+*********************************************************************************************************
+*/
+
+static  void  Test_Cancel (void)
+{
+    TEST_ABORT    abort;
+    TFTPc_STATS   stats;
+    pthread_t     thread;
+    CPU_INT64U    ts_start_us;
+    CPU_INT64U    dur_us;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "cancel.bin"), 20000u, 40u) == DEF_OK);
+
+    Mem_Clr(&abort,         sizeof(abort));
+    Mem_Clr(&Test_Canceler, sizeof(Test_Canceler));
+    abort.CancelEn = DEF_YES;
+    HOST_TEST_REQ(sem_init(&Test_Canceler.SessionSem, 0, 0u) == 0);
+    HOST_TEST_REQ(sem_init(&Test_Canceler.CancelSem,  0, 0u) == 0);
+    HOST_TEST_REQ(pthread_create(&thread, DEF_NULL, Test_CancelTask, &Test_Canceler) == 0);
+
+    Test_SimStart(&abort);
+    ts_start_us = HostSim_TimeGet_us();
+    ok          = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "cancel.bin"), "cancel.bin",
+                            TFTPc_MODE_OCTET, &err);
+    dur_us      = HostSim_TimeGet_us() - ts_start_us;
+    Test_SimStop();
+   (void)pthread_join(thread, DEF_NULL);
+
+    HOST_TEST_CHK(Test_Canceler.SessionErr     == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(Test_Canceler.SessionID      != TFTPc_SESSION_ID_ANY);
+    HOST_TEST_CHK(Test_Canceler.CancelOtherErr == TFTPc_ERR_SESSION_NONE);
+    HOST_TEST_CHK(Test_Canceler.CancelOk       == DEF_OK);
+    HOST_TEST_CHK(Test_Canceler.CancelErr      == TFTPc_ERR_NONE);
+
+    HOST_TEST_CHK(ok  == DEF_FAIL);
+    HOST_TEST_CHK(err == TFTPc_ERR_CANCELED);
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.SessionID    == Test_Canceler.SessionID);
+    HOST_TEST_CHK(stats.DataBlkCtr   <  20000u / 512u);
+    HOST_TEST_CHK(stats.RxTimeoutCtr == 0u);
+    HOST_TEST_CHK(dur_us             <  (CPU_INT64U)Test_Cfg.RxInactivityTimeout_ms * 1000u);
+
+    HOST_TEST_CHK(abort.ErrTxCtr == 1u);                        /* Server notified.                                     */
+    HOST_TEST_CHK(abort.ErrCode  == 0u);
+    HOST_TEST_CHK(strcmp(abort.ErrMsg, "Transfer canceled") == 0);
+
+   (void)TFTPc_SessionIDGet(&err);                              /* Session released.                                    */
+    HOST_TEST_CHK(err == TFTPc_ERR_SESSION_NONE);
+
+    sem_destroy(&Test_Canceler.SessionSem);
+    sem_destroy(&Test_Canceler.CancelSem);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Deadline()
+*
+* Description : The server stops sending after the 2nd DATA blk : the get is aborted once it has lasted
+*               'TransferTimeoutMax_ms', within TFTPc_CFG_ABORT_POLL_ms, before its first RX timeout, & the
+*               server is sent an ERROR.
+*********************************************************************************************************
+*/
+
+static  void  Test_Deadline (void)
+{
+    TEST_ABORT   abort;
+    TFTPc_CFG    cfg;
+    TFTPc_STATS  stats;
+    CPU_INT64U   ts_start_us;
+    CPU_INT64U   dur_us;
+    CPU_BOOLEAN  ok;
+    TFTPc_ERR    err;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "deadline.bin"), 20000u, 41u) == DEF_OK);
+
+    Mem_Clr(&abort, sizeof(abort));
+    abort.DropBlkNbr          = 3u;
+    cfg                       = Test_Cfg;
+    cfg.TransferTimeoutMax_ms = TEST_DEADLINE_ms;
+
+    Test_SimStart(&abort);
+    ts_start_us = HostSim_TimeGet_us();
+    ok          = TFTPc_Get(&cfg, HostTest_Path(Test_DirLocal, "deadline.bin"), "deadline.bin",
+                            TFTPc_MODE_OCTET, &err);
+    dur_us      = HostSim_TimeGet_us() - ts_start_us;
+    Test_SimStop();
+
+    HOST_TEST_CHK(ok  == DEF_FAIL);
+    HOST_TEST_CHK(err == TFTPc_ERR_DEADLINE);
+    HOST_TEST_CHK(dur_us >= (CPU_INT64U) TEST_DEADLINE_ms * 1000u);
+    HOST_TEST_CHK(dur_us <= (CPU_INT64U)(TEST_DEADLINE_ms + TFTPc_CFG_ABORT_POLL_ms) * 1000u);
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.DataBlkCtr   == 2u);
+    HOST_TEST_CHK(stats.RxTimeoutCtr == 0u);
+
+    HOST_TEST_CHK(abort.ErrTxCtr == 1u);
+    HOST_TEST_CHK(abort.ErrCode  == 0u);
+    HOST_TEST_CHK(strcmp(abort.ErrMsg, "Transfer deadline exceeded") == 0);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Idle);
+        HOST_TEST_RUN(Test_Cancel);
+        HOST_TEST_RUN(Test_Deadline);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,404 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : REQUEST BACKOFF TEST
+*
+* Filename : test_backoff.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with request backoff on the simulated network, & checks the delays of the
+*                requests against the backoff windows (see 'tftp-c_cfg.h  TFTPc REQUEST BACKOFF
+*                CONFIGURATION  Note #1').
+*
+*            (2) The backoff seed is fixed (see 'CMakeLists.txt  tftpc_backoff') & the generator is seeded
+*                per transfer : two runs of the same scenario MUST send their requests at the same times.
+*
+*            (3) A busy server is modelled by a filter that drops the first requests, & a timer that answers
+*                each of them with an ERROR code 0 from a new port, as a real server would.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_LINK_DLY_us                                500u
+
+#define  TEST_REQ_NBR_MAX                                 16u
+
+#define  TEST_OPCODE_RRQ                                   1u
+#define  TEST_OPCODE_ERR                                   5u
+
+#define  TEST_ERR_CODE_BUSY                                0u   /* Not defined : busy (see Note #3).                    */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  test_run {
+    CPU_BOOLEAN  Ok;
+    TFTPc_ERR    Err;
+    TFTPc_STATS  Stats;
+    CPU_INT64U   TS_Start_us;                                   /* Time TFTPc_Get() was called.                         */
+    CPU_INT32U   ReqNbr;                                        /* Nbr of reqs tx'd by the client.                      */
+    CPU_INT64U   ReqTS_us[TEST_REQ_NBR_MAX];                    /* Tx time of each req.                                 */
+    CPU_INT64U   BusyTS_us[TEST_REQ_NBR_MAX];                   /* Tx time of each busy ERROR.                          */
+} TEST_RUN;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR       *Test_DirSrv;
+static  CPU_CHAR       *Test_DirLocal;
+static  TFTPc_CFG       Test_Cfg;
+
+static  TEST_RUN       *Test_RunPtr;                            /* Run recorded by Test_ReqFilter().                    */
+static  HOST_SIM_SOCK  *Test_BusySockPtr;
+static  CPU_INT32U      Test_BusyCtr;                           /* Nbr of reqs still to answer busy.                    */
+static  CPU_INT32U      Test_BusyTxCtr;                         /* Nbr of busy ERRORs to tx.                            */
+static  CPU_INT16U      Test_ClientPort;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_ReqFilter()
+*
+* Description : Simulation filter : record the tx time of each req; drop the reqs to answer busy.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_ReqFilter (       void          *p_arg,
+                                     const  HOST_SIM_PKT  *p_pkt)
+{
+   (void)p_arg;
+
+    if ((p_pkt->SrcAddr                           != HOST_SIM_ADDR_CLIENT) ||
+        (p_pkt->Len                               <  2u)                   ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) != TEST_OPCODE_RRQ)) {
+        return (DEF_YES);
+    }
+
+    if (Test_RunPtr->ReqNbr < TEST_REQ_NBR_MAX) {
+        Test_RunPtr->ReqTS_us[Test_RunPtr->ReqNbr] = HostSim_TimeGet_us();
+    }
+    Test_RunPtr->ReqNbr++;
+
+    if (Test_BusyCtr == 0u) {
+        return (DEF_YES);
+    }
+
+    Test_BusyCtr--;
+    Test_BusyTxCtr++;
+    Test_ClientPort = p_pkt->SrcPort;
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_BusyTmr()
+*
+* Description : Simulation timer : answer each req dropped by Test_ReqFilter() with a busy ERROR.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_BusyTmr (void        *p_arg,
+                                  CPU_INT32U   now_ms)
+{
+    CPU_INT08U  pkt[9];
+    CPU_INT32U  ix;
+
+
+   (void)p_arg;
+   (void)now_ms;
+
+    while (Test_BusyTxCtr > 0u) {
+        MEM_VAL_SET_INT16U_BIG(&pkt[0], TEST_OPCODE_ERR);
+        MEM_VAL_SET_INT16U_BIG(&pkt[2], TEST_ERR_CODE_BUSY);
+        Mem_Copy(&pkt[4], "busy", 5u);
+       (void)HostSim_SockTx(Test_BusySockPtr, HOST_SIM_ADDR_CLIENT, Test_ClientPort, pkt, sizeof(pkt));
+
+        ix = Test_RunPtr->ReqNbr - 1u;
+        if (ix < TEST_REQ_NBR_MAX) {
+            Test_RunPtr->BusyTS_us[ix] = HostSim_TimeGet_us();
+        }
+        Test_BusyTxCtr--;
+    }
+
+    return (1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Get()
+*
+* Description : Reset the simulation & get 'p_name', answering the first 'busy_nbr' reqs busy.  The test
+*               server is attached if 'srv_en' is DEF_YES.
+*********************************************************************************************************
+*/
+
+static  void  Test_Get (const  CPU_CHAR     *p_name,
+                               CPU_BOOLEAN   srv_en,
+                               CPU_INT32U    busy_nbr,
+                               TEST_RUN     *p_run)
+{
+    HOST_SRV_CFG   srv_cfg;
+    HOST_SIM_SRV  *p_srv;
+    TFTPc_ERR      err;
+
+
+    Mem_Clr(p_run, sizeof(TEST_RUN));
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(TEST_LINK_DLY_us);
+
+    p_srv = DEF_NULL;
+    if (srv_en == DEF_YES) {
+        Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+        srv_cfg.RootDirPtr = Test_DirSrv;
+        srv_cfg.Timeout_ms = 1000u;
+        srv_cfg.RetryMax   = 5u;
+        p_srv              = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+        HOST_TEST_REQ(p_srv != DEF_NULL);
+    }
+
+    Test_RunPtr      = p_run;
+    Test_BusyCtr     = busy_nbr;
+    Test_BusyTxCtr   = 0u;
+    Test_BusySockPtr = HostSim_SockOpen();
+    HOST_TEST_REQ(Test_BusySockPtr != DEF_NULL);
+    HOST_TEST_REQ(HostSim_SockBind(Test_BusySockPtr, HOST_SIM_ADDR_SRV, 0u) == DEF_OK);
+    HostSim_FilterSet(Test_ReqFilter, DEF_NULL);
+    HOST_TEST_REQ(HostSim_TmrAdd(Test_BusyTmr, DEF_NULL) == DEF_OK);
+
+    p_run->TS_Start_us = HostSim_TimeGet_us();
+    p_run->Ok          = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, p_name), (CPU_CHAR *)p_name,
+                                   TFTPc_MODE_OCTET, &p_run->Err);
+   (void)TFTPc_StatsGet(&p_run->Stats, &err);
+
+    HostSim_TmrRemove(Test_BusyTmr, DEF_NULL);
+    HostSim_FilterSet(DEF_NULL, DEF_NULL);
+    HostSim_SockClose(Test_BusySockPtr);
+    if (p_srv != DEF_NULL) {
+        HostSimSrv_Stop(p_srv);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_WinGet_us()
+*
+* Description : Get the backoff window of the req re-tx number 'attempt' (see 'tftp-c_cfg.h  TFTPc REQUEST
+*               BACKOFF CONFIGURATION  Note #1b').
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U  Test_WinGet_us (CPU_INT32U  attempt)
+{
+    CPU_INT32U  win_ms;
+
+
+    win_ms = TFTPc_CFG_BACKOFF_BASE_ms;
+    while ((attempt > 0u) &&
+           (win_ms  < TFTPc_CFG_BACKOFF_MAX_ms)) {
+        win_ms *= 2u;
+        attempt--;
+    }
+
+    return ((CPU_INT64U)DEF_MIN(win_ms, TFTPc_CFG_BACKOFF_MAX_ms) * 1000u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Jitter()
+*
+* Description : (a) With no server, the client delays its first req by the start jitter, then each re-tx
+*                   of the req by a random time within its backoff window, after the RX timeout.
+*
+*               (b) A second run sends its reqs at the same times (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_Jitter (void)
+{
+    TEST_RUN     run_a;
+    TEST_RUN     run_b;
+    CPU_INT64U   timeout_us;
+    CPU_INT64U   dly_us;
+    CPU_INT64U   dly_prev_us;
+    CPU_BOOLEAN  dly_diff;
+    CPU_INT32U   ix;
+
+                                                                /* ------------------ (a) NO SERVER ------------------- */
+    Test_Get("none.bin", DEF_NO, 0u, &run_a);
+    HOST_TEST_CHK(run_a.Ok                 == DEF_FAIL);
+    HOST_TEST_CHK(run_a.Err                == TFTPc_ERR_RX_TIMEOUT);
+    HOST_TEST_REQ(run_a.ReqNbr             >  2u);
+    HOST_TEST_REQ(run_a.ReqNbr             <= TEST_REQ_NBR_MAX);
+    HOST_TEST_CHK(run_a.Stats.TxRetryCtr   == run_a.ReqNbr - 1u);
+    HOST_TEST_CHK(run_a.ReqTS_us[0] - run_a.TS_Start_us <= (CPU_INT64U)TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms * 1000u);
+
+    timeout_us  = (CPU_INT64U)Test_Cfg.RxInactivityTimeout_ms * 1000u;
+    dly_prev_us = 0u;
+    dly_diff    = DEF_NO;
+    for (ix = 1u; ix < run_a.ReqNbr; ix++) {
+        HOST_TEST_REQ(run_a.ReqTS_us[ix] - run_a.ReqTS_us[ix - 1u] >= timeout_us);
+        dly_us = run_a.ReqTS_us[ix] - run_a.ReqTS_us[ix - 1u] - timeout_us;
+        HOST_TEST_CHK(dly_us <= Test_WinGet_us(ix - 1u));
+        if ((ix > 1u) && (dly_us != dly_prev_us)) {
+            dly_diff = DEF_YES;
+        }
+        dly_prev_us = dly_us;
+    }
+    HOST_TEST_CHK(dly_diff == DEF_YES);                         /* Dlys drawn, NOT fixed.                               */
+                                                                /* ---------------- (b) SAME SCENARIO ----------------- */
+    Test_Get("none.bin", DEF_NO, 0u, &run_b);
+    HOST_TEST_CHK(run_b.ReqNbr == run_a.ReqNbr);
+    for (ix = 0u; ix < run_a.ReqNbr; ix++) {
+        HOST_TEST_CHK(run_b.ReqTS_us[ix] - run_b.TS_Start_us == run_a.ReqTS_us[ix] - run_a.TS_Start_us);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Busy()
+*
+* Description : (a) A server busy for the first reqs : each busy ERROR is answered by the req after a
+*                   random time within the backoff window, & the transfer succeeds.
+*
+*               (b) A server busy for longer than TFTPc_CFG_BACKOFF_REQ_RETRY_MAX retries : the transfer
+*                   fails on the last busy ERROR.
+*
+*               (c) A permanent ERROR (file not found) is NOT retried.
+*********************************************************************************************************
+*/
+
+static  void  Test_Busy (void)
+{
+    TEST_RUN          run;
+    TFTPc_SERVER_ERR  srv_err;
+    TFTPc_ERR         err;
+    CPU_INT64U        dly_us;
+    CPU_INT32U        busy_nbr;
+    CPU_INT32U        ix;
+
+                                                                /* ------------------ (a) BUSY, THEN OK --------------- */
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "busy.bin"), 3000u, 41u) == DEF_OK);
+
+    busy_nbr = TFTPc_CFG_BACKOFF_REQ_RETRY_MAX - 1u;
+    Test_Get("busy.bin", DEF_YES, busy_nbr, &run);
+    HOST_TEST_CHK(run.Ok                == DEF_OK);
+    HOST_TEST_CHK(run.ReqNbr            == busy_nbr + 1u);
+    HOST_TEST_CHK(run.Stats.TxRetryCtr  == busy_nbr);
+    HOST_TEST_CHK(run.Stats.RxTimeoutCtr == 0u);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "busy.bin"),
+                                   HostTest_Path(Test_DirLocal, "busy.bin")) == DEF_YES);
+
+    for (ix = 0u; (ix < busy_nbr) && (ix + 1u < TEST_REQ_NBR_MAX); ix++) {
+        HOST_TEST_REQ(run.ReqTS_us[ix + 1u] >= run.BusyTS_us[ix] + TEST_LINK_DLY_us);
+        dly_us = run.ReqTS_us[ix + 1u] - run.BusyTS_us[ix] - TEST_LINK_DLY_us;
+        HOST_TEST_CHK(dly_us <= Test_WinGet_us(ix));
+    }
+                                                                /* ------------------ (b) ALWAYS BUSY ----------------- */
+    Test_Get("busy.bin", DEF_YES, TEST_REQ_NBR_MAX, &run);
+    HOST_TEST_CHK(run.Ok                == DEF_FAIL);
+    HOST_TEST_CHK(run.Err               == TFTPc_ERR_ERR_PKT_RX);
+    HOST_TEST_CHK(run.ReqNbr            == TFTPc_CFG_BACKOFF_REQ_RETRY_MAX + 1u);
+    HOST_TEST_CHK(TFTPc_ServerErrGet(&srv_err, &err) == DEF_OK);
+    HOST_TEST_CHK(srv_err.Code          == TEST_ERR_CODE_BUSY);
+                                                                /* -------------- (c) PERMANENT ERROR ----------------- */
+    Test_Get("missing.bin", DEF_YES, 0u, &run);
+    HOST_TEST_CHK(run.Ok                == DEF_FAIL);
+    HOST_TEST_CHK(run.Err               == TFTPc_ERR_ERR_PKT_RX);
+    HOST_TEST_CHK(run.ReqNbr            == 1u);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Jitter);
+        HOST_TEST_RUN(Test_Busy);
+    }
+
+    return (HostTest_End());
+}
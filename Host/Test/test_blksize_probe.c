@@ -0,0 +1,254 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                 HOST PORT : BLOCK SIZE PROBING TEST
+*
+* Filename : test_blksize_probe.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with block size probing (TFTPc_CFG_BLKSIZE_PROBE_INTERVAL of 2) on the
+*                simulated network, with the block size derived from the MTU of 1500 octets, i.e. 1468
+*                octets.  The path towards the client drops the DATA pkts longer than TEST_DATA_LEN_MAX, as
+*                lost fragments of a smaller path MTU.
+*
+*            (2) Each request is parsed on the way to the server : the block size requested is recorded.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdlib.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_OPCODE_RRQ                                   1u
+#define  TEST_OPCODE_DATA                                  3u
+
+#define  TEST_BLK_SIZE_AUTO                             1468u   /* MTU - IP, UDP & TFTP hdrs (see Note #1).             */
+#define  TEST_BLK_SIZE_PROBE                             990u   /* Halfway between 512 & 1468.                          */
+#define  TEST_DATA_LEN_MAX                        (4u + 1000u)  /* Largest DATA pkt delivered      (see Note #1).       */
+
+#define  TEST_FILE_LEN                                 20000u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR      *Test_DirSrv;
+static  CPU_CHAR      *Test_DirLocal;
+static  TFTPc_CFG      Test_Cfg;
+
+static  CPU_INT32U     Test_ReqCtr;                             /* Nbr of RRQs rx'd by the server.                      */
+static  CPU_INT32U     Test_ReqBlkSize;                         /* Blk size of the last RRQ, 0 if none (see Note #2).   */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_PathFilter()
+*
+* Description : Simulation filter : record the block size of each request (see Note #2) & drop the DATA
+*               pkts longer than TEST_DATA_LEN_MAX (see Note #1).
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_PathFilter (       void          *p_arg,
+                                      const  HOST_SIM_PKT  *p_pkt)
+{
+    const  CPU_CHAR    *p_str;
+           CPU_INT32U   ix;
+           CPU_INT16U   opcode;
+
+
+   (void)p_arg;
+
+    if (p_pkt->Len < 4u) {
+        return (DEF_YES);
+    }
+
+    opcode = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]);
+    if (opcode == TEST_OPCODE_DATA) {
+        return ((p_pkt->Len <= TEST_DATA_LEN_MAX) ? DEF_YES : DEF_NO);
+    }
+    if (opcode != TEST_OPCODE_RRQ) {
+        return (DEF_YES);
+    }
+
+    Test_ReqCtr++;
+    Test_ReqBlkSize = 0u;
+    ix              = 2u;
+    while (ix < p_pkt->Len) {                                   /* Scan the NUL-terminated strings for the option.      */
+        p_str = (const CPU_CHAR *)&p_pkt->Data[ix];
+        if ((strcmp(p_str, "blksize") == 0) &&
+            (ix + sizeof("blksize") < p_pkt->Len)) {
+            Test_ReqBlkSize = (CPU_INT32U)atoi(p_str + sizeof("blksize"));
+        }
+        ix += (CPU_INT32U)strlen(p_str) + 1u;
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Get()
+*
+* Description : Get the file from a new server & check the block size requested & used.
+*
+* Argument(s) : req_nbr         Number of requests expected.
+*
+*               blk_size_req    Block size expected in the last request, 0 if none.
+*
+*               blk_size        Block size expected for the transfer.
+*********************************************************************************************************
+*/
+
+static  void  Test_Get (CPU_INT32U  req_nbr,
+                        CPU_INT32U  blk_size_req,
+                        CPU_INT16U  blk_size)
+{
+    HOST_SRV_CFG   srv_cfg;
+    HOST_SIM_SRV  *p_srv;
+    TFTPc_STATS    stats;
+    CPU_BOOLEAN    ok;
+    TFTPc_ERR      err;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+    HostSim_FilterSet(Test_PathFilter, DEF_NULL);
+    Test_ReqCtr     = 0u;
+    Test_ReqBlkSize = 0u;
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    srv_cfg.OptEn      = DEF_YES;
+    srv_cfg.BlkSizeMax = TFTPc_CFG_BLKSIZE_MAX;
+    p_srv              = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+
+    ok = TFTPc_Get(&Test_Cfg,
+                    HostTest_Path(Test_DirLocal, "probe.bin"),
+                   "probe.bin",
+                    TFTPc_MODE_OCTET,
+                   &err);
+    HostSim_Run(10u);                                           /* Deliver the last ACK.                                */
+    HostSimSrv_Stop(p_srv);
+
+    HOST_TEST_CHK(ok              == DEF_OK);
+    HOST_TEST_CHK(Test_ReqCtr     == req_nbr);
+    HOST_TEST_CHK(Test_ReqBlkSize == blk_size_req);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "probe.bin"),
+                                   HostTest_Path(Test_DirLocal, "probe.bin")) == DEF_YES);
+
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.BlkSize == blk_size);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_EarlyTimeout()
+*
+* Description : The blocks of the size derived from the MTU time out before the 1st block : the request is
+*               re-sent without the block size, 512-octet blocks are used until TFTPc_CFG_BLKSIZE_PROBE_INTERVAL
+*               transfers worked, then a block size halfway to the size that failed is probed & kept.
+*********************************************************************************************************
+*/
+
+static  void  Test_EarlyTimeout (void)
+{
+    TFTPc_ERR  err;
+
+
+    HOST_TEST_REQ(TFTPc_BlkSizeSet(TFTPc_BLKSIZE_AUTO, &err) == DEF_OK);
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "probe.bin"), TEST_FILE_LEN, 49u) == DEF_OK);
+
+    Test_Get(2u, 0u,                  512u);                    /* Re-sent w/o blk size after the early timeout.        */
+    Test_Get(1u, 0u,                  512u);
+    Test_Get(1u, 0u,                  512u);
+    Test_Get(1u, TEST_BLK_SIZE_PROBE, TEST_BLK_SIZE_PROBE);     /* Probe after TFTPc_CFG_BLKSIZE_PROBE_INTERVAL xfers.  */
+    Test_Get(1u, TEST_BLK_SIZE_PROBE, TEST_BLK_SIZE_PROBE);     /* Probed size kept.                                    */
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_EarlyTimeout);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,554 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      HOST PORT : CODEC TEST
+*
+* Filename : test_codec.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with the heatshrink & delta codecs on the simulated network against the
+*                test server, which stores the files as they are tx'd : a file put through the heatshrink
+*                codec is stored compressed, & decompressed when got back through the codec.
+*
+*            (2) The heatshrink stream format is checked against a stream built by hand (see 'tftp-c_hs.h
+*                TFTPc HEATSHRINK STREAM DEFINES'), in the host configuration (window 8, lookahead 4).
+*
+*            (3) The delta patches are built by hand (see 'tftp-c_delta.h  TFTPc DELTA PATCH DEFINES'); the
+*                patch generator is checked by the 'delta_tool' test.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  <Source/tftp-c_hs.h>
+#include  <Source/tftp-c_delta.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdio.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_TEXT_LEN                                 60000u
+
+#define  TEST_DELTA_BASE_LEN                           20000u
+#define  TEST_DELTA_ADD_LEN                              100u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR        *Test_DirSrv;
+static  CPU_CHAR        *Test_DirLocal;
+static  HOST_SIM_SRV    *Test_SrvPtr;
+static  TFTPc_CFG        Test_Cfg;
+
+static  TFTPc_CODEC      Test_Codec;
+static  TFTPc_CODEC_HS   Test_HS;
+
+static  TFTPc_CODEC      Test_DeltaCodec;
+static  TFTPc_DELTA      Test_Delta;
+static  CPU_INT08U       Test_DeltaDigest[TFTPc_DELTA_SHA256_DIGEST_LEN];
+
+static  CPU_INT08U       Test_Text[TEST_TEXT_LEN];
+static  CPU_INT08U       Test_Rand[TEST_TEXT_LEN];
+static  CPU_INT08U       Test_Enc [TEST_TEXT_LEN + TEST_TEXT_LEN / 8u + 16u];
+static  CPU_INT08U       Test_Dec [TEST_TEXT_LEN + 1u];         /* One more octet to detect overflows.                  */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Test_DataGen()
+*
+* Description : Generate compressible text, made of words drawn from a small vocabulary, & pseudo-random
+*               data.
+*********************************************************************************************************
+*/
+
+static  void  Test_DataGen (void)
+{
+    static  const  CPU_CHAR  *words[] = {
+        "block ", "window ", "timeout ", "server ", "client ", "ack ", "data ", "option ", "\n"
+    };
+    const  CPU_CHAR          *p_word;
+    CPU_INT32U                state;
+    CPU_INT32U                ix;
+
+
+    state = 12345u;
+    ix    = 0u;
+    while (ix < TEST_TEXT_LEN) {
+        state  = state * 1103515245u + 12345u;
+        p_word = words[(state >> 16) % (sizeof(words) / sizeof(words[0]))];
+        while ((*p_word != '\0') && (ix < TEST_TEXT_LEN)) {
+            Test_Text[ix] = (CPU_INT08U)*p_word;
+            p_word++;
+            ix++;
+        }
+    }
+
+    for (ix = 0u; ix < TEST_TEXT_LEN; ix++) {
+        state         = state * 1103515245u + 12345u;
+        Test_Rand[ix] = (CPU_INT08U)(state >> 16);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_HS_Run()
+*
+* Description : Run the heatshrink codec over a buffer, by chunks of at most 'chunk_max' octets in & out.
+*
+* Return(s)   : Nbr of octets produced, or -1 on error.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32S  Test_HS_Run (       CPU_BOOLEAN   encode,
+                                 const  CPU_INT08U   *p_src,
+                                        CPU_SIZE_T    src_len,
+                                        CPU_INT08U   *p_dst,
+                                        CPU_SIZE_T    dst_len,
+                                        CPU_SIZE_T    chunk_max)
+{
+    CPU_SIZE_T   src_ix;
+    CPU_SIZE_T   dst_ix;
+    CPU_SIZE_T   src_used;
+    CPU_SIZE_T   dst_used;
+    CPU_SIZE_T   chunk;
+    CPU_BOOLEAN  flush;
+    CPU_INT32U   iter;
+
+
+    if (Test_Codec.Init(Test_Codec.CtxPtr, encode) != DEF_OK) {
+        return (-1);
+    }
+
+    src_ix = 0u;
+    dst_ix = 0u;
+    for (iter = 0u; iter < 10000000u; iter++) {
+        chunk = 1u + (iter % chunk_max);
+        flush = (src_ix == src_len) ? DEF_YES : DEF_NO;
+        if (Test_Codec.Process(Test_Codec.CtxPtr,
+                              &p_src[src_ix],
+                               DEF_MIN(chunk, src_len - src_ix),
+                              &src_used,
+                              &p_dst[dst_ix],
+                               DEF_MIN(chunk, dst_len - dst_ix),
+                              &dst_used,
+                               flush) != DEF_OK) {
+            return (-1);
+        }
+        src_ix += src_used;
+        dst_ix += dst_used;
+        if ((flush == DEF_YES) && (dst_used == 0u)) {
+            return ((CPU_INT32S)dst_ix);
+        }
+        if (dst_ix == dst_len) {                                /* Output overflow.                                     */
+            return (-1);
+        }
+    }
+
+    return (-1);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_SimStart()
+*
+* Description : Reset the simulation & attach a server.
+*********************************************************************************************************
+*/
+
+static  void  Test_SimStart (void)
+{
+    HOST_SRV_CFG  srv_cfg;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(10u);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    Test_SrvPtr        = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_CHK(Test_SrvPtr != DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_FileLen()
+*
+* Description : Get the length of a file, 0 if it does NOT exist.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_FileLen (const  CPU_CHAR  *p_path)
+{
+    FILE  *p_file;
+    long   len;
+
+
+    p_file = fopen(p_path, "rb");
+    if (p_file == DEF_NULL) {
+        return (0u);
+    }
+    fseek(p_file, 0, SEEK_END);
+    len = ftell(p_file);
+    fclose(p_file);
+
+    return ((len > 0) ? (CPU_INT32U)len : 0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_HS_Vector()
+*
+* Description : Check the stream format : "aaaaaaaaaa" is a literal 'a' & a backref of index 0, count 8.
+*
+*                   1 01100001  0 00000000 1000  00     = B0 80 20
+*********************************************************************************************************
+*/
+
+static  void  Test_HS_Vector (void)
+{
+    static  const  CPU_INT08U  enc[] = { 0xB0u, 0x80u, 0x20u };
+    CPU_INT08U                 buf[16];
+    CPU_INT32S                 len;
+
+
+    len = Test_HS_Run(DEF_YES, (const CPU_INT08U *)"aaaaaaaaaa", 10u, buf, sizeof(buf), 4u);
+    HOST_TEST_CHK(len == (CPU_INT32S)sizeof(enc));
+    HOST_TEST_CHK(Mem_Cmp(buf, enc, sizeof(enc)) == DEF_YES);
+
+    len = Test_HS_Run(DEF_NO, enc, sizeof(enc), buf, sizeof(buf), 1u);
+    HOST_TEST_CHK(len == 10);
+    HOST_TEST_CHK(Mem_Cmp(buf, "aaaaaaaaaa", 10u) == DEF_YES);
+
+    len = Test_HS_Run(DEF_NO, (const CPU_INT08U *)"\x00\x00", 2u, buf, sizeof(buf), 1u);
+    HOST_TEST_CHK(len == 1);                                    /* Backref before start of stream outputs 0.            */
+    HOST_TEST_CHK(buf[0] == 0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Test_HS_RoundTrip()
+*
+* Description : Compress & decompress text & pseudo-random data, by chunks of various sizes.
+*********************************************************************************************************
+*/
+
+static  void  Test_HS_RoundTrip (void)
+{
+    static  const  CPU_SIZE_T  chunk_max[] = { 1u, 7u, 512u, TEST_TEXT_LEN };
+    CPU_INT32S                 enc_len;
+    CPU_INT32S                 dec_len;
+    CPU_INT32U                 ix;
+
+
+    for (ix = 0u; ix < sizeof(chunk_max) / sizeof(chunk_max[0]); ix++) {
+        enc_len = Test_HS_Run(DEF_YES, Test_Text, TEST_TEXT_LEN, Test_Enc, sizeof(Test_Enc), chunk_max[ix]);
+        HOST_TEST_REQ(enc_len > 0);
+        HOST_TEST_CHK(enc_len < (CPU_INT32S)(TEST_TEXT_LEN / 2u));
+
+        dec_len = Test_HS_Run(DEF_NO, Test_Enc, (CPU_SIZE_T)enc_len, Test_Dec, sizeof(Test_Dec), chunk_max[ix]);
+        HOST_TEST_CHK(dec_len == (CPU_INT32S)TEST_TEXT_LEN);
+        HOST_TEST_CHK(Mem_Cmp(Test_Dec, Test_Text, TEST_TEXT_LEN) == DEF_YES);
+    }
+
+    enc_len = Test_HS_Run(DEF_YES, Test_Rand, TEST_TEXT_LEN, Test_Enc, sizeof(Test_Enc), 300u);
+    HOST_TEST_REQ(enc_len > 0);                                 /* At most 9 bits per octet.                            */
+    HOST_TEST_CHK(enc_len <= (CPU_INT32S)(TEST_TEXT_LEN + TEST_TEXT_LEN / 8u + 1u));
+
+    dec_len = Test_HS_Run(DEF_NO, Test_Enc, (CPU_SIZE_T)enc_len, Test_Dec, sizeof(Test_Dec), 300u);
+    HOST_TEST_CHK(dec_len == (CPU_INT32S)TEST_TEXT_LEN);
+    HOST_TEST_CHK(Mem_Cmp(Test_Dec, Test_Rand, TEST_TEXT_LEN) == DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Test_HS_Transfer()
+*
+* Description : Put a text file through the codec, check it is stored compressed, & get it back through
+*               the codec.
+*********************************************************************************************************
+*/
+
+static  void  Test_HS_Transfer (void)
+{
+    FILE         *p_file;
+    CPU_INT32U    len;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    p_file = fopen(HostTest_Path(Test_DirLocal, "text.txt"), "wb");
+    HOST_TEST_REQ(p_file != DEF_NULL);
+    HOST_TEST_CHK(fwrite(Test_Text, 1u, TEST_TEXT_LEN, p_file) == TEST_TEXT_LEN);
+    fclose(p_file);
+
+    Test_SimStart();
+
+    ok = TFTPc_Put(&Test_Cfg, HostTest_Path(Test_DirLocal, "text.txt"), "text.txt.hs", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+
+    len = Test_FileLen(HostTest_Path(Test_DirSrv, "text.txt.hs"));
+    HOST_TEST_CHK(len >  0u);
+    HOST_TEST_REQ(len < (TEST_TEXT_LEN / 2u));
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "text_rx.txt"), "text.txt.hs", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirLocal, "text.txt"),
+                                   HostTest_Path(Test_DirLocal, "text_rx.txt")) == DEF_YES);
+
+    HostSimSrv_Stop(Test_SrvPtr);
+
+    p_file = fopen(HostTest_Path(Test_DirSrv, "text.txt.hs"), "rb");
+    HOST_TEST_REQ(p_file != DEF_NULL);                          /* Stored file is a bare heatshrink stream.             */
+    HOST_TEST_CHK(fread(Test_Enc, 1u, len, p_file) == len);
+    fclose(p_file);
+    HOST_TEST_CHK(Test_HS_Run(DEF_NO, Test_Enc, len, Test_Dec, sizeof(Test_Dec), 512u) == (CPU_INT32S)TEST_TEXT_LEN);
+    HOST_TEST_CHK(Mem_Cmp(Test_Dec, Test_Text, TEST_TEXT_LEN) == DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_FileWr()
+*
+* Description : Write a file from a buffer.
+*********************************************************************************************************
+*/
+
+static  void  Test_FileWr (const  CPU_CHAR    *p_path,
+                           const  CPU_INT08U  *p_data,
+                                  CPU_SIZE_T   len)
+{
+    FILE  *p_file;
+
+
+    p_file = fopen(p_path, "wb");
+    HOST_TEST_REQ(p_file != DEF_NULL);
+    HOST_TEST_CHK(fwrite(p_data, 1u, len, p_file) == len);
+    fclose(p_file);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_DeltaSHA256()
+*
+* Description : Check the SHA-256 implementation against the FIPS 180-2 examples (1 & 2 blocks).
+*********************************************************************************************************
+*/
+
+static  void  Test_DeltaSHA256 (void)
+{
+    static  const  CPU_INT08U  digest_abc[TFTPc_DELTA_SHA256_DIGEST_LEN] = {
+        0xBAu, 0x78u, 0x16u, 0xBFu, 0x8Fu, 0x01u, 0xCFu, 0xEAu, 0x41u, 0x41u, 0x40u, 0xDEu, 0x5Du, 0xAEu, 0x22u, 0x23u,
+        0xB0u, 0x03u, 0x61u, 0xA3u, 0x96u, 0x17u, 0x7Au, 0x9Cu, 0xB4u, 0x10u, 0xFFu, 0x61u, 0xF2u, 0x00u, 0x15u, 0xADu
+    };
+    static  const  CPU_INT08U  digest_448[TFTPc_DELTA_SHA256_DIGEST_LEN] = {
+        0x24u, 0x8Du, 0x6Au, 0x61u, 0xD2u, 0x06u, 0x38u, 0xB8u, 0xE5u, 0xC0u, 0x26u, 0x93u, 0x0Cu, 0x3Eu, 0x60u, 0x39u,
+        0xA3u, 0x3Cu, 0xE4u, 0x59u, 0x64u, 0xFFu, 0x21u, 0x67u, 0xF6u, 0xECu, 0xEDu, 0xD4u, 0x19u, 0xDBu, 0x06u, 0xC1u
+    };
+    static  const  CPU_CHAR    msg_448[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    TFTPc_DELTA_SHA256         sha256;
+    CPU_INT08U                 digest[TFTPc_DELTA_SHA256_DIGEST_LEN];
+    CPU_INT32U                 ix;
+
+
+    TFTPc_DeltaSHA256Init(&sha256);
+    TFTPc_DeltaSHA256Update(&sha256, (const CPU_INT08U *)"abc", 3u);
+    TFTPc_DeltaSHA256Final(&sha256, digest);
+    HOST_TEST_CHK(Mem_Cmp(digest, digest_abc, sizeof(digest)) == DEF_YES);
+
+    TFTPc_DeltaSHA256Init(&sha256);                             /* One octet at a time, across the blk boundary.        */
+    for (ix = 0u; ix < sizeof(msg_448) - 1u; ix++) {
+        TFTPc_DeltaSHA256Update(&sha256, (const CPU_INT08U *)&msg_448[ix], 1u);
+    }
+    TFTPc_DeltaSHA256Final(&sha256, digest);
+    HOST_TEST_CHK(Mem_Cmp(digest, digest_448, sizeof(digest)) == DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_DeltaTransfer()
+*
+* Description : Get a patch rebuilding a target file from a base file, with the right & a wrong digest.
+*
+*                   Target = Base[0, 5000) | 100 new octets | Base[6000, 20000)
+*********************************************************************************************************
+*/
+
+static  void  Test_DeltaTransfer (void)
+{
+    CPU_INT08U          *p_base;
+    CPU_INT08U          *p_target;
+    CPU_INT08U           patch[TFTPc_DELTA_HDR_LEN + 2u * (1u + TFTPc_DELTA_CMD_COPY_ARG_LEN) +
+                               1u + TFTPc_DELTA_CMD_ADD_ARG_LEN + TEST_DELTA_ADD_LEN + 1u];
+    CPU_INT08U          *p_patch;
+    CPU_INT32U           target_len;
+    TFTPc_DELTA_SHA256   sha256;
+    CPU_BOOLEAN          ok;
+    TFTPc_ERR            err;
+
+
+    p_base     =  Test_Rand;                                    /* Base is pseudo-random data.                          */
+    p_target   = &Test_Dec[0];
+    target_len =  5000u + TEST_DELTA_ADD_LEN + (TEST_DELTA_BASE_LEN - 6000u);
+    Mem_Copy(&p_target[0],                         &p_base[0],    5000u);
+    Mem_Copy(&p_target[5000u],                     &Test_Text[0], TEST_DELTA_ADD_LEN);
+    Mem_Copy(&p_target[5000u + TEST_DELTA_ADD_LEN], &p_base[6000u], TEST_DELTA_BASE_LEN - 6000u);
+
+    p_patch = &patch[0];
+   *p_patch++ = TFTPc_DELTA_MAGIC_0;
+   *p_patch++ = TFTPc_DELTA_MAGIC_1;
+   *p_patch++ = TFTPc_DELTA_MAGIC_2;
+   *p_patch++ = TFTPc_DELTA_MAGIC_3;
+    MEM_VAL_SET_INT32U_BIG(p_patch, target_len);
+    p_patch  += 4u;
+   *p_patch++ = TFTPc_DELTA_CMD_COPY;
+    MEM_VAL_SET_INT32U_BIG(p_patch,      0u);
+    MEM_VAL_SET_INT32U_BIG(p_patch + 4u, 5000u);
+    p_patch  += TFTPc_DELTA_CMD_COPY_ARG_LEN;
+   *p_patch++ = TFTPc_DELTA_CMD_ADD;
+    MEM_VAL_SET_INT32U_BIG(p_patch, TEST_DELTA_ADD_LEN);
+    p_patch  += TFTPc_DELTA_CMD_ADD_ARG_LEN;
+    Mem_Copy(p_patch, &Test_Text[0], TEST_DELTA_ADD_LEN);
+    p_patch  += TEST_DELTA_ADD_LEN;
+   *p_patch++ = TFTPc_DELTA_CMD_COPY;
+    MEM_VAL_SET_INT32U_BIG(p_patch,      6000u);
+    MEM_VAL_SET_INT32U_BIG(p_patch + 4u, TEST_DELTA_BASE_LEN - 6000u);
+    p_patch  += TFTPc_DELTA_CMD_COPY_ARG_LEN;
+   *p_patch++ = TFTPc_DELTA_CMD_END;
+    HOST_TEST_REQ((CPU_SIZE_T)(p_patch - &patch[0]) == sizeof(patch));
+
+    Test_FileWr(HostTest_Path(Test_DirLocal, "fw_base.bin"), p_base, TEST_DELTA_BASE_LEN);
+    Test_FileWr(HostTest_Path(Test_DirLocal, "fw_target.bin"), p_target, target_len);
+    Test_FileWr(HostTest_Path(Test_DirSrv,   "fw.tdp"), patch, sizeof(patch));
+
+    TFTPc_DeltaSHA256Init(&sha256);
+    TFTPc_DeltaSHA256Update(&sha256, p_target, target_len);
+    TFTPc_DeltaSHA256Final(&sha256, Test_DeltaDigest);
+
+    ok = TFTPc_DeltaCodecInit(&Test_DeltaCodec,
+                              &Test_Delta,
+                               HostTest_Path(Test_DirLocal, "fw_base.bin"),
+                               Test_DeltaDigest,
+                              ".tdp",
+                              &err);
+    HOST_TEST_REQ(ok == DEF_OK);
+    HOST_TEST_REQ(TFTPc_CodecSet(&Test_DeltaCodec, &err) == DEF_OK);
+
+    Test_SimStart();
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "fw_new.bin"), "fw.tdp", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirLocal, "fw_target.bin"),
+                                   HostTest_Path(Test_DirLocal, "fw_new.bin")) == DEF_YES);
+
+    Test_DeltaDigest[0] ^= 0x01u;                               /* Patch does NOT rebuild the expected file.            */
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "fw_bad.bin"), "fw.tdp", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_FAIL);
+    HOST_TEST_CHK(err == TFTPc_ERR_CODEC);
+
+    HostSimSrv_Stop(Test_SrvPtr);
+
+    HOST_TEST_CHK(TFTPc_CodecSet(&Test_Codec, &err) == DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    HOST_TEST_CHK(TFTPc_HS_CodecInit(&Test_Codec, &Test_HS, ".hs", &err) == DEF_OK);
+    HOST_TEST_CHK(TFTPc_CodecSet(&Test_Codec, &err) == DEF_OK);
+
+    Test_DataGen();
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_HS_Vector);
+        HOST_TEST_RUN(Test_HS_RoundTrip);
+        HOST_TEST_RUN(Test_HS_Transfer);
+        HOST_TEST_RUN(Test_DeltaSHA256);
+        HOST_TEST_RUN(Test_DeltaTransfer);
+    }
+
+    return (HostTest_End());
+}
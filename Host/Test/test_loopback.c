@@ -0,0 +1,253 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST PORT : LOOPBACK TRANSFER TEST
+*
+* Filename : test_loopback.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc on the BSD socket port against the test server on 127.0.0.1 & checks that the
+*                files transferred are identical, for sizes around the block size boundaries.
+*
+*            (2) Test_GetImpaired() runs a transfer over the impaired loopback (see 'Port/host_net.h  Note #2'),
+*                against a server of its own that re-tx's sooner than the client gives up, so that a lost
+*                DATA does not fail the transfer.
+*
+*            (3) The test is also built with the socket connected to the server TID
+*                ('test_loopback_sock_conn'), so that the transfers go through NetSock_Conn() &
+*                NetSock_TxData() of the BSD port.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Srv/host_srv.h"
+#include  "../Port/host_net.h"
+#include  "host_test.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR      *Test_DirSrv;
+static  CPU_CHAR      *Test_DirLocal;
+static  HOST_SRV_BSD  *Test_SrvPtr;
+static  TFTPc_CFG      Test_Cfg;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_GetSizes()
+*
+* Description : Get files of sizes around the 512-octet block boundaries.
+*********************************************************************************************************
+*/
+
+static  void  Test_GetSizes (void)
+{
+    static  const  CPU_INT32U  size_tbl[] = { 0u, 1u, 511u, 512u, 513u, 1024u, 100000u };
+    CPU_CHAR                   name[32];
+    CPU_INT32U                 ix;
+    CPU_BOOLEAN                ok;
+    TFTPc_ERR                  err;
+
+
+    for (ix = 0u; ix < sizeof(size_tbl) / sizeof(size_tbl[0]); ix++) {
+        snprintf(name, sizeof(name), "get_%u.bin", (unsigned)size_tbl[ix]);
+        HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, name), size_tbl[ix], ix + 1u) == DEF_OK);
+
+        ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, name), name, TFTPc_MODE_OCTET, &err);
+        HOST_TEST_CHK(ok  == DEF_OK);
+        HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+        HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   name),
+                                       HostTest_Path(Test_DirLocal, name)) == DEF_YES);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Put()
+*
+* Description : Put a file & check the copy written by the server.
+*********************************************************************************************************
+*/
+
+static  void  Test_Put (void)
+{
+    CPU_BOOLEAN  ok;
+    TFTPc_ERR    err;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirLocal, "put.bin"), 70000u, 99u) == DEF_OK);
+
+    ok = TFTPc_Put(&Test_Cfg, HostTest_Path(Test_DirLocal, "put.bin"), "put.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirLocal, "put.bin"),
+                                   HostTest_Path(Test_DirSrv,   "put.bin")) == DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_GetNotFound()
+*
+* Description : Get a file the server does not have : the server ERROR is reported.
+*********************************************************************************************************
+*/
+
+static  void  Test_GetNotFound (void)
+{
+    TFTPc_SERVER_ERR  server_err;
+    CPU_BOOLEAN       ok;
+    TFTPc_ERR         err;
+
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "missing.bin"), "missing.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_FAIL);
+    HOST_TEST_CHK(err == TFTPc_ERR_ERR_PKT_RX);
+
+    ok = TFTPc_ServerErrGet(&server_err, &err);
+    HOST_TEST_CHK(ok == DEF_OK);
+    HOST_TEST_CHK(server_err.Code == 1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_GetImpaired()
+*
+* Description : Get a file over a lossy, duplicating & reordering loopback (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_GetImpaired (void)
+{
+    HOST_IMPAIR_CFG        impair_cfg;
+    HOST_NET_IMPAIR_STATS  impair_stats;
+    HOST_SRV_CFG           srv_cfg;
+    HOST_SRV_BSD          *p_srv;
+    TFTPc_CFG              cfg;
+    CPU_INT16U             port;
+    CPU_BOOLEAN            ok;
+    TFTPc_ERR              err;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "impair.bin"), 70000u, 7u) == DEF_OK);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));                         /* See Note #2.                                         */
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 100u;
+    srv_cfg.RetryMax   = 10u;
+    p_srv              = HostSrvBSD_Start(&srv_cfg, &port);
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+
+    Mem_Clr(&impair_cfg, sizeof(impair_cfg));
+    impair_cfg.LossRate      = 200u;                            /* 2 %.                                                 */
+    impair_cfg.DupRate       = 300u;
+    impair_cfg.ReorderRate   = 200u;
+    impair_cfg.ReorderDly_us = 20000u;
+    impair_cfg.Dly_us        = 1000u;
+    impair_cfg.Jitter_us     = 2000u;
+    impair_cfg.Seed          = 1u;
+    HOST_TEST_REQ(HostNet_ImpairSet(HOST_NET_IMPAIR_DIR_TX, &impair_cfg) == DEF_OK);
+    impair_cfg.Seed          = 2u;
+    HOST_TEST_REQ(HostNet_ImpairSet(HOST_NET_IMPAIR_DIR_RX, &impair_cfg) == DEF_OK);
+
+    cfg                        = Test_Cfg;
+    cfg.ServerPortNbr          = port;
+    cfg.RxInactivityTimeout_ms = 500u;
+    ok = TFTPc_Get(&cfg, HostTest_Path(Test_DirLocal, "impair.bin"), "impair.bin", TFTPc_MODE_OCTET, &err);
+    HostNet_ImpairStatsGet(&impair_stats);
+   (void)HostNet_ImpairSet(HOST_NET_IMPAIR_DIR_TX, DEF_NULL);
+   (void)HostNet_ImpairSet(HOST_NET_IMPAIR_DIR_RX, DEF_NULL);
+    HostSrvBSD_Stop(p_srv);
+
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "impair.bin"),
+                                   HostTest_Path(Test_DirLocal, "impair.bin")) == DEF_YES);
+    HOST_TEST_CHK(impair_stats.PktLossCtr    > 0u);
+    HOST_TEST_CHK(impair_stats.PktDupCtr     > 0u);
+    HOST_TEST_CHK(impair_stats.PktReorderCtr > 0u);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    HOST_SRV_CFG  srv_cfg;
+    CPU_INT16U    port;
+    TFTPc_ERR     err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    Test_SrvPtr        = HostSrvBSD_Start(&srv_cfg, &port);
+    HOST_TEST_CHK(Test_SrvPtr != DEF_NULL);
+
+    Test_Cfg               = TFTPc_Cfg;
+    Test_Cfg.ServerPortNbr = port;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_GetSizes);
+        HOST_TEST_RUN(Test_Put);
+        HOST_TEST_RUN(Test_GetNotFound);
+        HOST_TEST_RUN(Test_GetImpaired);
+    }
+
+    HostSrvBSD_Stop(Test_SrvPtr);
+
+    return (HostTest_End());
+}
@@ -0,0 +1,476 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : MULTICAST RECEPTION TEST
+*
+* Filename : test_mcast.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with multicast reception (RFC #2090) on the simulated network, against a
+*                scripted multicast server :
+*
+*                (a) The RRQ is answered by an OACK whose multicast option value is set per scenario.
+*
+*                (b) Shortly after the OACK, the server multicasts the DATA blocks of a list, in its order :
+*                    blocks may be missing, duplicated or out of order.
+*
+*                (c) An ACK of block N from the master client is answered by block N + 1, multicast.
+*
+*                (d) A passive client may be promoted to master by a second OACK, once the list is sent.
+*
+*            (2) The test server of 'Host/Srv' does NOT support multicast.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "host_test.h"
+
+#include  <stdio.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_GRP_ADDR                           0xE0010203u    /* 224.1.2.3.                                           */
+#define  TEST_GRP_ADDR_STR                       "224.1.2.3"
+#define  TEST_GRP_PORT                                  1758u
+
+#define  TEST_FILE_SIZE                   (10u * 512u + 100u)   /* 11 blks.                                             */
+#define  TEST_FILE_BLK_NBR                                11u
+
+#define  TEST_BLAST_DLY_ms                                10u   /* Dly from the OACK to the 1st blk (see Note #1b).     */
+
+#define  TEST_BLK_LIST_LEN_MAX                            32u
+
+#define  TEST_OPCODE_RRQ                                   1u
+#define  TEST_OPCODE_DATA                                  3u
+#define  TEST_OPCODE_ACK                                   4u
+#define  TEST_OPCODE_ERR                                   5u
+#define  TEST_OPCODE_OACK                                  6u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  test_mcast_srv {
+    const  CPU_CHAR       *OptValPtr;                           /* Multicast opt val of the OACK (see Note #1a).        */
+    const  CPU_INT16U     *BlkList;                             /* Blks multicast after the OACK (see Note #1b).        */
+    CPU_INT32U             BlkListLen;
+    CPU_BOOLEAN            Promote;                             /* Promote the client once the list is sent.            */
+
+    HOST_SIM_SOCK         *LsnSockPtr;
+    HOST_SIM_SOCK         *XferSockPtr;
+    CPU_INT16U             ClientPort;
+    CPU_INT32U             BlastAt_ms;                          /* Time to send the list, 0 if NOT pending.             */
+    CPU_INT32U             PromoteAt_ms;                        /* Time to promote the client, 0 if NOT pending.        */
+
+    CPU_INT32U             AckCtr;                              /* Nbr of ACKs rx'd.                                    */
+    CPU_INT16U             AckLast;                             /* Blk nbr of the last ACK rx'd.                        */
+    CPU_INT32U             ReqBlkCtr;                           /* Nbr of blks sent on ACK    (see Note #1c).           */
+    CPU_INT16U             ReqBlkList[TEST_BLK_LIST_LEN_MAX];
+    CPU_INT32U             ErrCtr;                              /* Nbr of ERRORs rx'd.                                  */
+    CPU_INT16U             ErrCode;
+} TEST_MCAST_SRV;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR    *Test_DirSrv;
+static  CPU_CHAR    *Test_DirLocal;
+static  TFTPc_CFG    Test_Cfg;
+
+static  CPU_INT08U   Test_FileData[TEST_FILE_SIZE];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         Test_SrvBlkTx()
+*
+* Description : Multicast a DATA block of the file.
+*********************************************************************************************************
+*/
+
+static  void  Test_SrvBlkTx (TEST_MCAST_SRV  *p_srv,
+                             CPU_INT16U       blk_nbr)
+{
+    CPU_INT08U  pkt[4u + 512u];
+    CPU_INT32U  pos;
+    CPU_INT32U  len;
+
+
+    pos = ((CPU_INT32U)blk_nbr - 1u) * 512u;
+    len = DEF_MIN(TEST_FILE_SIZE - pos, 512u);
+
+    MEM_VAL_SET_INT16U_BIG(&pkt[0], TEST_OPCODE_DATA);
+    MEM_VAL_SET_INT16U_BIG(&pkt[2], blk_nbr);
+    Mem_Copy(&pkt[4], &Test_FileData[pos], len);
+   (void)HostSim_SockTx(p_srv->XferSockPtr, TEST_GRP_ADDR, TEST_GRP_PORT, pkt, 4u + len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_SrvOACK_Tx()
+*
+* Description : Send an OACK with the multicast option value 'p_val' to the client.
+*********************************************************************************************************
+*/
+
+static  void  Test_SrvOACK_Tx (       TEST_MCAST_SRV  *p_srv,
+                               const  CPU_CHAR        *p_val)
+{
+    CPU_INT08U  pkt[64];
+    CPU_INT32U  len;
+
+
+    MEM_VAL_SET_INT16U_BIG(&pkt[0], TEST_OPCODE_OACK);
+    len = 2u;
+    Mem_Copy(&pkt[len], "multicast", 10u);
+    len += 10u;
+    Mem_Copy(&pkt[len], p_val, Str_Len(p_val) + 1u);
+    len += Str_Len(p_val) + 1u;
+   (void)HostSim_SockTx(p_srv->XferSockPtr, HOST_SIM_ADDR_CLIENT, p_srv->ClientPort, pkt, len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_SrvRx()
+*
+* Description : Simulation handler : serve the RRQ & the ACKs (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Test_SrvRx (       void           *p_arg,
+                                 HOST_SIM_SOCK  *p_sock,
+                          const  HOST_SIM_PKT   *p_pkt)
+{
+    TEST_MCAST_SRV  *p_srv;
+    CPU_INT16U       opcode;
+    CPU_INT16U       blk_nbr;
+
+
+    p_srv = (TEST_MCAST_SRV *)p_arg;
+    if (p_pkt->Len < 4u) {
+        return;
+    }
+    opcode  = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]);
+    blk_nbr = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]);
+
+    if (p_sock == p_srv->LsnSockPtr) {                          /* ------------------- RRQ (Note #1a) ----------------- */
+        if (opcode == TEST_OPCODE_RRQ) {
+            p_srv->ClientPort = p_pkt->SrcPort;
+            Test_SrvOACK_Tx(p_srv, p_srv->OptValPtr);
+            p_srv->BlastAt_ms = (CPU_INT32U)(HostSim_TimeGet_us() / 1000u) + TEST_BLAST_DLY_ms;
+        }
+        return;
+    }
+
+    switch (opcode) {
+        case TEST_OPCODE_ACK:                                   /* ------------------- ACK (Note #1c) ----------------- */
+             p_srv->AckCtr++;
+             p_srv->AckLast = blk_nbr;
+             if (blk_nbr < TEST_FILE_BLK_NBR) {
+                 if (p_srv->ReqBlkCtr < TEST_BLK_LIST_LEN_MAX) {
+                     p_srv->ReqBlkList[p_srv->ReqBlkCtr] = (CPU_INT16U)(blk_nbr + 1u);
+                 }
+                 p_srv->ReqBlkCtr++;
+                 Test_SrvBlkTx(p_srv, (CPU_INT16U)(blk_nbr + 1u));
+             }
+             break;
+
+
+        case TEST_OPCODE_ERR:
+             p_srv->ErrCtr++;
+             p_srv->ErrCode = blk_nbr;
+             break;
+
+
+        default:
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_SrvTmr()
+*
+* Description : Simulation timer : multicast the blocks of the list, then promote the client if required
+*               (see Notes #1b & #1d).  The promotion follows the blocks by TEST_BLAST_DLY_ms, so that the
+*               client has rx'd them.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_SrvTmr (void        *p_arg,
+                                 CPU_INT32U   now_ms)
+{
+    TEST_MCAST_SRV  *p_srv;
+    CPU_INT32U       ix;
+
+
+    p_srv = (TEST_MCAST_SRV *)p_arg;
+    if ((p_srv->BlastAt_ms != 0u) &&
+        (p_srv->BlastAt_ms <= now_ms)) {
+        p_srv->BlastAt_ms = 0u;
+        for (ix = 0u; ix < p_srv->BlkListLen; ix++) {
+            Test_SrvBlkTx(p_srv, p_srv->BlkList[ix]);
+        }
+        if (p_srv->Promote == DEF_YES) {                        /* Promote once the blks are rx'd.                      */
+            p_srv->PromoteAt_ms = now_ms + TEST_BLAST_DLY_ms;
+        }
+    }
+
+    if ((p_srv->PromoteAt_ms != 0u) &&
+        (p_srv->PromoteAt_ms <= now_ms)) {
+        p_srv->PromoteAt_ms = 0u;
+        Test_SrvOACK_Tx(p_srv, ",,1");                          /* Grp addr & port omitted (RFC #2090).                 */
+    }
+
+    return (1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Get()
+*
+* Description : Reset the simulation & get the file from the scripted server 'p_srv'.
+*********************************************************************************************************
+*/
+
+static  void  Test_Get (const  CPU_CHAR        *p_name,
+                               TEST_MCAST_SRV  *p_srv,
+                               CPU_BOOLEAN     *p_ok,
+                               TFTPc_ERR       *p_err)
+{
+    *p_ok = DEF_FAIL;
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+
+    p_srv->LsnSockPtr  = HostSim_SockOpen();
+    p_srv->XferSockPtr = HostSim_SockOpen();
+    HOST_TEST_REQ((p_srv->LsnSockPtr != DEF_NULL) && (p_srv->XferSockPtr != DEF_NULL));
+    HOST_TEST_REQ(HostSim_SockBind(p_srv->LsnSockPtr,  HOST_SIM_ADDR_SRV, TEST_SRV_PORT) == DEF_OK);
+    HOST_TEST_REQ(HostSim_SockBind(p_srv->XferSockPtr, HOST_SIM_ADDR_SRV, 0u)            == DEF_OK);
+    HostSim_SockHandlerSet(p_srv->LsnSockPtr,  Test_SrvRx, p_srv);
+    HostSim_SockHandlerSet(p_srv->XferSockPtr, Test_SrvRx, p_srv);
+    HOST_TEST_REQ(HostSim_TmrAdd(Test_SrvTmr, p_srv) == DEF_OK);
+
+    *p_ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, p_name), (CPU_CHAR *)p_name,
+                      TFTPc_MODE_OCTET | TFTPc_MODE_FLAG_MCAST, p_err);
+    HostSim_Run(TEST_BLAST_DLY_ms);                             /* Deliver the last pkt tx'd by the client.             */
+
+    HostSim_TmrRemove(Test_SrvTmr, p_srv);
+    HostSim_SockClose(p_srv->LsnSockPtr);
+    HostSim_SockClose(p_srv->XferSockPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Master()
+*
+* Description : As master client, get a file multicast out of order, with gaps & a duplicate : every block
+*               is written once at its position, & each ACK requests the first block missing.
+*********************************************************************************************************
+*/
+
+static  void  Test_Master (void)
+{
+    static  const  CPU_INT16U  blk_list[] = { 1u, 2u, 5u, 3u, 5u, 7u, 8u, 11u, 10u };
+    TEST_MCAST_SRV             srv;
+    TFTPc_STATS                stats;
+    CPU_BOOLEAN                ok;
+    TFTPc_ERR                  err;
+
+
+    Mem_Clr(&srv, sizeof(srv));
+    srv.OptValPtr  = TEST_GRP_ADDR_STR ",1758,1";
+    srv.BlkList    = blk_list;
+    srv.BlkListLen = sizeof(blk_list) / sizeof(blk_list[0]);
+
+    Test_Get("mcast.bin", &srv, &ok, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "mcast.bin"),
+                                   HostTest_Path(Test_DirLocal, "mcast.bin")) == DEF_YES);
+
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.DataBlkCtr   == TEST_FILE_BLK_NBR);     /* Dups NOT wr'n.                                       */
+    HOST_TEST_CHK(stats.DataOctetCtr == TEST_FILE_SIZE);
+    HOST_TEST_CHK(srv.AckLast        == TEST_FILE_BLK_NBR);
+    HOST_TEST_CHK(srv.ErrCtr         == 0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Passive()
+*
+* Description : As passive client, receive a file without blocks 4 & 9, last block first, without ACK'ing;
+*               once promoted to master, request exactly the missing blocks.
+*********************************************************************************************************
+*/
+
+static  void  Test_Passive (void)
+{
+    static  const  CPU_INT16U  blk_list[] = { 11u, 1u, 2u, 3u, 5u, 6u, 7u, 8u, 10u };
+    TEST_MCAST_SRV             srv;
+    TFTPc_STATS                stats;
+    CPU_BOOLEAN                ok;
+    TFTPc_ERR                  err;
+
+
+    Mem_Clr(&srv, sizeof(srv));
+    srv.OptValPtr  = TEST_GRP_ADDR_STR ",1758,0";
+    srv.BlkList    = blk_list;
+    srv.BlkListLen = sizeof(blk_list) / sizeof(blk_list[0]);
+    srv.Promote    = DEF_YES;
+
+    Test_Get("mcast.bin", &srv, &ok, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "mcast.bin"),
+                                   HostTest_Path(Test_DirLocal, "mcast.bin")) == DEF_YES);
+
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.DataBlkCtr   == TEST_FILE_BLK_NBR);
+                                                                /* ACKs 3, 8 & 11 : only blks 4 & 9 req'd.              */
+    HOST_TEST_CHK(srv.AckCtr         == 3u);
+    HOST_TEST_REQ(srv.ReqBlkCtr      == 2u);
+    HOST_TEST_CHK(srv.ReqBlkList[0]  == 4u);
+    HOST_TEST_CHK(srv.ReqBlkList[1]  == 9u);
+    HOST_TEST_CHK(srv.AckLast        == TEST_FILE_BLK_NBR);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_OptInvalid()
+*
+* Description : An OACK with a malformed multicast option value is answered by an ERROR 8 (option
+*               negotiation) & fails the get.
+*********************************************************************************************************
+*/
+
+static  void  Test_OptInvalid (void)
+{
+    static  const  CPU_CHAR  *val_tbl[] = {
+        TEST_GRP_ADDR_STR ",1758",                              /* No master/passive flag.                              */
+        TEST_GRP_ADDR_STR ",1758,2",                            /* Invalid flag.                                        */
+        "10.0.0.9,1758,1",                                      /* NOT a class D addr.                                  */
+        TEST_GRP_ADDR_STR ",0,1",                               /* Port 0.                                              */
+        TEST_GRP_ADDR_STR ",70000,1",                           /* Port out of range.                                   */
+        ",,1",                                                  /* Grp omitted in the 1st OACK.                         */
+    };
+    TEST_MCAST_SRV  srv;
+    CPU_INT32U      ix;
+    CPU_BOOLEAN     ok;
+    TFTPc_ERR       err;
+
+
+    for (ix = 0u; ix < sizeof(val_tbl) / sizeof(val_tbl[0]); ix++) {
+        Mem_Clr(&srv, sizeof(srv));
+        srv.OptValPtr = val_tbl[ix];
+
+        Test_Get("mcast.bin", &srv, &ok, &err);
+        HOST_TEST_CHK(ok          == DEF_FAIL);
+        HOST_TEST_CHK(err         == TFTPc_ERR_OPT_NEGO);
+        HOST_TEST_CHK(srv.ErrCtr  == 1u);
+        HOST_TEST_CHK(srv.ErrCode == 8u);
+        HOST_TEST_CHK(srv.AckCtr  == 0u);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    FILE       *p_file;
+    TFTPc_ERR   err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrv, "mcast.bin"), TEST_FILE_SIZE, 38u) == DEF_OK);
+    p_file = fopen(HostTest_Path(Test_DirSrv, "mcast.bin"), "rb");
+    HOST_TEST_CHK((p_file != DEF_NULL) &&
+                  (fread(Test_FileData, 1u, sizeof(Test_FileData), p_file) == sizeof(Test_FileData)));
+    if (p_file != DEF_NULL) {
+        fclose(p_file);
+    }
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Master);
+        HOST_TEST_RUN(Test_Passive);
+        HOST_TEST_RUN(Test_OptInvalid);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,438 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                 HOST PORT : OPTION NEGOTIATION TEST
+*
+* Filename : test_opt.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with the block size & window size options on the simulated network
+*                against the test server, with the options answered (see 'Srv/host_srv.h  Note #5').
+*
+*            (2) The 'rollover' & 'tsize' options, & the rejection of an invalid option, are checked with
+*                requests tx'd from a raw simulated socket, since TFTPc does NOT request them for a file.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_OPCODE_DATA                                  3u
+#define  TEST_OPCODE_ACK                                   4u
+#define  TEST_OPCODE_ERR                                   5u
+#define  TEST_OPCODE_OACK                                  6u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR      *Test_DirSrv;
+static  CPU_CHAR      *Test_DirLocal;
+static  HOST_SIM_SRV  *Test_SrvPtr;
+static  TFTPc_CFG      Test_Cfg;
+
+static  CPU_INT32U     Test_LossBlkNbr;                         /* DATA blk to drop once, 0 for none.                   */
+static  CPU_INT32U     Test_DataLenMax;                         /* Largest DATA pkt delivered, 0 for any.               */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_SimStart()
+*
+* Description : Reset the simulation & attach a server answering the options.
+*********************************************************************************************************
+*/
+
+static  void  Test_SimStart (CPU_INT32U  blk_size_max,
+                             CPU_INT32U  win_size_max)
+{
+    HOST_SRV_CFG  srv_cfg;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    srv_cfg.OptEn      = DEF_YES;
+    srv_cfg.BlkSizeMax = blk_size_max;
+    srv_cfg.WinSizeMax = win_size_max;
+    Test_SrvPtr        = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_CHK(Test_SrvPtr != DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_LossFilter()
+*
+* Description : Simulation filter : drop DATA block Test_LossBlkNbr once.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_LossFilter (       void          *p_arg,
+                                      const  HOST_SIM_PKT  *p_pkt)
+{
+   (void)p_arg;
+
+    if ((Test_LossBlkNbr                          == 0u)               ||
+        (p_pkt->Len                               <  4u)               ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) != TEST_OPCODE_DATA) ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) != Test_LossBlkNbr)) {
+        return (DEF_YES);
+    }
+
+    Test_LossBlkNbr = 0u;
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_MTU_Filter()
+*
+* Description : Simulation filter : drop the DATA pkts longer than Test_DataLenMax, as lost fragments.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_MTU_Filter (       void          *p_arg,
+                                      const  HOST_SIM_PKT  *p_pkt)
+{
+   (void)p_arg;
+
+    if ((Test_DataLenMax                          == 0u)               ||
+        (p_pkt->Len                               <= Test_DataLenMax)  ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) != TEST_OPCODE_DATA)) {
+        return (DEF_YES);
+    }
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_GetChk()
+*
+* Description : Get a file & check the copy & the options negotiated.
+*********************************************************************************************************
+*/
+
+static  void  Test_GetChk (const  CPU_CHAR    *p_name,
+                                  CPU_INT32U   size,
+                                  CPU_INT16U   blk_size,
+                                  CPU_INT16U   win_size)
+{
+    TFTPc_STATS  stats;
+    CPU_BOOLEAN  ok;
+    TFTPc_ERR    err;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, p_name), size, size + 1u) == DEF_OK);
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, p_name), (CPU_CHAR *)p_name, TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   p_name),
+                                   HostTest_Path(Test_DirLocal, p_name)) == DEF_YES);
+
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.BlkSize == blk_size);
+    HOST_TEST_CHK(stats.WinSize == win_size);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_BlkSizeWin()
+*
+* Description : Get files with block sizes & windows answered by the server.
+*********************************************************************************************************
+*/
+
+static  void  Test_BlkSizeWin (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_SimStart(0u, 0u);
+    HOST_TEST_REQ(TFTPc_BlkSizeSet(1428u, &err) == DEF_OK);
+    Test_GetChk("bw_0.bin",          0u, 1428u, TFTPc_CFG_WIN_SIZE_MAX);
+    Test_GetChk("bw_1428.bin",    1428u, 1428u, TFTPc_CFG_WIN_SIZE_MAX);
+    Test_GetChk("bw_200000.bin", 200000u, 1428u, TFTPc_CFG_WIN_SIZE_MAX);
+    HostSimSrv_Stop(Test_SrvPtr);
+
+    Test_SimStart(1024u, 3u);                                   /* Options capped by the server.                        */
+    HOST_TEST_REQ(TFTPc_BlkSizeSet(8192u, &err) == DEF_OK);
+    Test_GetChk("bw_capped.bin",  100000u, 1024u, 3u);
+    HostSimSrv_Stop(Test_SrvPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_WinLoss()
+*
+* Description : Drop a DATA block in the middle of a window : the window slides past the blocks rx'd.
+*********************************************************************************************************
+*/
+
+static  void  Test_WinLoss (void)
+{
+    HOST_SRV_STATS  srv_stats;
+    TFTPc_ERR       err;
+
+
+    Test_SimStart(0u, 0u);
+    HostSim_FilterSet(Test_LossFilter, DEF_NULL);
+    Test_LossBlkNbr = 5u;
+    HOST_TEST_REQ(TFTPc_BlkSizeSet(1428u, &err) == DEF_OK);
+    Test_GetChk("wl.bin", 50000u, 1428u, TFTPc_CFG_WIN_SIZE_MAX);
+
+    HostSim_Run(10u);                                           /* Deliver the last ACK.                                */
+    HostSimSrv_StatsGet(Test_SrvPtr, &srv_stats);
+    HOST_TEST_CHK(Test_LossBlkNbr          == 0u);
+    HOST_TEST_CHK(srv_stats.TxRetryCtr     >= 1u);
+    HOST_TEST_CHK(srv_stats.TransferOkCtr  == 1u);
+    HostSimSrv_Stop(Test_SrvPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Test_BlkSizeFallback()
+*
+* Description : Drop the blocks larger than 512 octets : the request is re-sent without the block size.
+*********************************************************************************************************
+*/
+
+static  void  Test_BlkSizeFallback (void)
+{
+    HOST_SRV_STATS  srv_stats;
+    TFTPc_ERR       err;
+
+
+    Test_SimStart(0u, 0u);
+    HostSim_FilterSet(Test_MTU_Filter, DEF_NULL);
+    Test_DataLenMax = 4u + 512u;
+    HOST_TEST_REQ(TFTPc_BlkSizeSet(1428u, &err) == DEF_OK);
+    Test_GetChk("bf.bin", 20000u, 512u, TFTPc_CFG_WIN_SIZE_MAX);
+
+    HostSim_Run(10u);                                           /* Deliver the last ACK.                                */
+    HostSimSrv_StatsGet(Test_SrvPtr, &srv_stats);
+    HOST_TEST_CHK(srv_stats.TransferOkCtr == 1u);
+    HostSimSrv_Stop(Test_SrvPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_RolloverDflt()
+*
+* Description : Get a file of more than 65535 blocks : the block number rolls over to 0.
+*********************************************************************************************************
+*/
+
+static  void  Test_RolloverDflt (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_SimStart(0u, 0u);
+    HOST_TEST_REQ(TFTPc_BlkSizeSet(8u, &err) == DEF_OK);
+    Test_GetChk("ro.bin", 70000u * 8u + 3u, 8u, TFTPc_CFG_WIN_SIZE_MAX);
+    HostSimSrv_Stop(Test_SrvPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_RawReq()
+*
+* Description : Transmit a request with options from a raw socket & wait for the answer (see Note #2).
+*
+* Argument(s) : p_sock      Pointer to socket.
+*
+*               p_req       Pointer to request, NUL-separated.
+*
+*               req_len     Request length.
+*
+* Return(s)   : Pointer to the answer (freed by the caller), or NULL if none.
+*********************************************************************************************************
+*/
+
+static  HOST_SIM_PKT  *Test_RawReq (       HOST_SIM_SOCK  *p_sock,
+                                    const  CPU_CHAR       *p_req,
+                                           CPU_INT32U      req_len)
+{
+    CPU_INT08U  pkt[128];
+
+
+    MEM_VAL_SET_INT16U_BIG(&pkt[0], 1u);                        /* RRQ.                                                 */
+    Mem_Copy(&pkt[2], p_req, req_len);
+    HOST_TEST_CHK(HostSim_SockTx(p_sock, HOST_SIM_ADDR_SRV, TEST_SRV_PORT, pkt, 2u + req_len) == DEF_OK);
+   (void)HostSim_SockWait(&p_sock, 1u, 5000u);
+
+    return (HostSim_SockRx(p_sock));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_RawOpt()
+*
+* Description : Check the 'rollover' & 'tsize' options & the rejection of an invalid option (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_RawOpt (void)
+{
+    static  const  CPU_CHAR  req_ok[]  = "raw.bin\0octet\0blksize\0" "8\0tsize\0" "0\0rollover\0" "1\0";
+    static  const  CPU_CHAR  oack_ok[] = "blksize\0" "8\0tsize\0" "524300\0rollover\0" "1\0";
+    static  const  CPU_CHAR  req_bad[] = "raw.bin\0octet\0blksize\0" "4\0";
+    HOST_SIM_SOCK           *p_sock;
+    HOST_SIM_PKT            *p_pkt;
+    HOST_SIM_ADDR            addr;
+    CPU_INT16U               port;
+    CPU_INT32U               blk_nbr;
+    CPU_INT16U               blk_wire;
+    CPU_INT16U               blk_wire_exp;
+    CPU_INT08U               ack[4];
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "raw.bin"), 524300u, 5u) == DEF_OK);
+    Test_SimStart(0u, 0u);
+    p_sock = HostSim_SockOpen();
+    HOST_TEST_REQ(p_sock != DEF_NULL);
+    HOST_TEST_REQ(HostSim_SockBind(p_sock, 0u, 0u) == DEF_OK);
+
+    p_pkt = Test_RawReq(p_sock, req_bad, sizeof(req_bad) - 1u);
+    HOST_TEST_REQ(p_pkt != DEF_NULL);
+    HOST_TEST_CHK(MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) == TEST_OPCODE_ERR);
+    HOST_TEST_CHK(MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) == 8u);
+    free(p_pkt);
+
+    p_pkt = Test_RawReq(p_sock, req_ok, sizeof(req_ok) - 1u);
+    HOST_TEST_REQ(p_pkt != DEF_NULL);
+    HOST_TEST_CHK(MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) == TEST_OPCODE_OACK);
+    HOST_TEST_CHK(p_pkt->Len == 2u + sizeof(oack_ok) - 1u);
+    HOST_TEST_CHK(Mem_Cmp(&p_pkt->Data[2], oack_ok, sizeof(oack_ok) - 1u) == DEF_YES);
+    addr = p_pkt->SrcAddr;
+    port = p_pkt->SrcPort;
+    free(p_pkt);
+                                                                /* ACK every blk : wire nbr rolls over to 1.            */
+    blk_wire = 0u;
+    for (blk_nbr = 1u; blk_nbr <= 524300u / 8u + 1u; blk_nbr++) {
+        MEM_VAL_SET_INT16U_BIG(&ack[0], TEST_OPCODE_ACK);
+        MEM_VAL_SET_INT16U_BIG(&ack[2], blk_wire);
+       (void)HostSim_SockTx(p_sock, addr, port, ack, sizeof(ack));
+       (void)HostSim_SockWait(&p_sock, 1u, 5000u);
+        p_pkt = HostSim_SockRx(p_sock);
+        HOST_TEST_REQ(p_pkt != DEF_NULL);
+
+        blk_wire_exp = (blk_nbr <= 65535u) ? (CPU_INT16U)blk_nbr : (CPU_INT16U)(blk_nbr - 65535u);
+        blk_wire     =  MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]);
+        HOST_TEST_CHK(MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) == TEST_OPCODE_DATA);
+        if (blk_wire != blk_wire_exp) {
+            HOST_TEST_CHK(blk_wire == blk_wire_exp);
+            free(p_pkt);
+            break;
+        }
+        free(p_pkt);
+    }
+    MEM_VAL_SET_INT16U_BIG(&ack[2], blk_wire);
+   (void)HostSim_SockTx(p_sock, addr, port, ack, sizeof(ack));
+    HostSim_Run(10u);
+
+    HostSim_SockClose(p_sock);
+    HostSimSrv_Stop(Test_SrvPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_BlkSizeWin);
+        HOST_TEST_RUN(Test_WinLoss);
+        HOST_TEST_RUN(Test_BlkSizeFallback);
+        HOST_TEST_RUN(Test_RolloverDflt);
+        HOST_TEST_RUN(Test_RawOpt);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,321 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                     HOST PORT : SERVER POOL TEST
+*
+* Filename : test_pool.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with the server pool on the simulated network, against two test servers
+*                with root directories of their own.  Server A is first in the pool table, so it is req'd
+*                first while both servers were never req'd.
+*
+*            (2) Server A stops answering at a given block : a filter drops its DATA blocks from that block
+*                on, so that the client fails over to server B once blocks are wr'n.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdio.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_SRV_A_ADDR                   HOST_SIM_ADDR_SRV    /* 10.0.0.2 : 1st server of the pool.                   */
+#define  TEST_SRV_B_ADDR                         0x0A000003u    /* 10.0.0.3 : 2nd server of the pool.                   */
+
+#define  TEST_TIMEOUT_ms                                 500u
+
+#define  TEST_FILE_LEN                                  5000u   /* 10 blks.                                             */
+#define  TEST_BLK_STOP                                     5u   /* Blk server A stops at (see Note #2).                 */
+
+#define  TEST_OPCODE_RRQ                                   1u
+#define  TEST_OPCODE_DATA                                  3u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR     *Test_DirSrvA;
+static  CPU_CHAR     *Test_DirSrvB;
+static  CPU_CHAR     *Test_DirLocal;
+static  TFTPc_CFG     Test_Cfg;
+static  TFTPc_CFG     Test_PoolTbl[2];
+
+static  CPU_INT16U    Test_BlkStop;                             /* Blk server A stops at, 0 if none.                    */
+static  CPU_INT32U    Test_ReqCtrA;                             /* Nbr of reqs rx'd by server A.                        */
+static  CPU_INT32U    Test_ReqCtrB;                             /* Nbr of reqs rx'd by server B.                        */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Test_Filter()
+*
+* Description : Simulation filter : count the reqs rx'd by each server & drop the DATA blocks of server A
+*               from Test_BlkStop on (see Note #2).
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_Filter (       void          *p_arg,
+                                  const  HOST_SIM_PKT  *p_pkt)
+{
+    CPU_INT16U  opcode;
+
+
+   (void)p_arg;
+
+    if (p_pkt->Len < 4u) {
+        return (DEF_YES);
+    }
+    opcode = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]);
+
+    if (opcode == TEST_OPCODE_RRQ) {
+        if (p_pkt->DstAddr == TEST_SRV_A_ADDR) {
+            Test_ReqCtrA++;
+        } else if (p_pkt->DstAddr == TEST_SRV_B_ADDR) {
+            Test_ReqCtrB++;
+        }
+        return (DEF_YES);
+    }
+
+    if ((opcode                                   == TEST_OPCODE_DATA) &&
+        (p_pkt->SrcAddr                           == TEST_SRV_A_ADDR)  &&
+        (Test_BlkStop                             != 0u)               &&
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) >= Test_BlkStop)) {
+        return (DEF_NO);
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Get()
+*
+* Description : Reset the simulation & get 'p_name' from the pool, server A stopping at block 'blk_stop'.
+*********************************************************************************************************
+*/
+
+static  void  Test_Get (const  CPU_CHAR     *p_name,
+                               CPU_INT16U    blk_stop,
+                               CPU_BOOLEAN  *p_ok,
+                               TFTPc_ERR    *p_err)
+{
+    HOST_SRV_CFG   srv_cfg;
+    HOST_SIM_SRV  *p_srv_a;
+    HOST_SIM_SRV  *p_srv_b;
+
+
+    *p_ok = DEF_FAIL;
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    srv_cfg.RootDirPtr = Test_DirSrvA;
+    p_srv_a            = HostSimSrv_Start(&srv_cfg, TEST_SRV_A_ADDR, TEST_SRV_PORT);
+    srv_cfg.RootDirPtr = Test_DirSrvB;
+    p_srv_b            = HostSimSrv_Start(&srv_cfg, TEST_SRV_B_ADDR, TEST_SRV_PORT);
+    HOST_TEST_REQ((p_srv_a != DEF_NULL) && (p_srv_b != DEF_NULL));
+
+    Test_BlkStop = blk_stop;
+    Test_ReqCtrA = 0u;
+    Test_ReqCtrB = 0u;
+    HostSim_FilterSet(Test_Filter, DEF_NULL);
+
+    *p_ok = TFTPc_Get(DEF_NULL, HostTest_Path(Test_DirLocal, p_name), (CPU_CHAR *)p_name, TFTPc_MODE_OCTET, p_err);
+
+    HostSim_FilterSet(DEF_NULL, DEF_NULL);
+    HostSimSrv_Stop(p_srv_a);
+    HostSimSrv_Stop(p_srv_b);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Failover()
+*
+* Description : (a) Server A stops answering once blocks are wr'n : the transfer is restarted against server
+*                   B, which holds the same file, & completes.  Only server A counts a failure.
+*
+*               (b) The next transfer is req'd from server B first, since server A failed.
+*********************************************************************************************************
+*/
+
+static  void  Test_Failover (void)
+{
+    TFTPc_POOL_STAT  stat_a;
+    TFTPc_POOL_STAT  stat_b;
+    CPU_BOOLEAN      ok;
+    TFTPc_ERR        err;
+
+                                                                /* ------------- (a) FAILOVER, SAME FILE -------------- */
+    HOST_TEST_REQ(TFTPc_PoolSet(&Test_PoolTbl[0], 2u, &err) == DEF_OK);
+
+    Test_Get("same.bin", TEST_BLK_STOP, &ok, &err);
+    HOST_TEST_CHK(ok           == DEF_OK);
+    HOST_TEST_CHK(err          == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(Test_ReqCtrA == 1u);
+    HOST_TEST_CHK(Test_ReqCtrB == 1u);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrvB,  "same.bin"),
+                                   HostTest_Path(Test_DirLocal, "same.bin")) == DEF_YES);
+
+    HOST_TEST_REQ(TFTPc_PoolStatGet(0u, &stat_a, &err) == DEF_OK);
+    HOST_TEST_REQ(TFTPc_PoolStatGet(1u, &stat_b, &err) == DEF_OK);
+    HOST_TEST_CHK(stat_a.ReqCtr  == 1u);
+    HOST_TEST_CHK(stat_a.FailCtr == 1u);
+    HOST_TEST_CHK(stat_b.ReqCtr  == 1u);
+    HOST_TEST_CHK(stat_b.FailCtr == 0u);
+                                                                /* ------------- (b) FAILED SERVER LAST --------------- */
+    Test_Get("same.bin", 0u, &ok, &err);
+    HOST_TEST_CHK(ok           == DEF_OK);
+    HOST_TEST_CHK(Test_ReqCtrA == 0u);
+    HOST_TEST_CHK(Test_ReqCtrB == 1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Mismatch()
+*
+* Description : (a) Server B holds a file that differs from the file of server A from its second block on :
+*                   the blocks wr'n from server A are compared with the blocks of server B, & overwritten
+*                   from the first block that differs (see TFTPc_PoolDataCmp()).  The local file is the file
+*                   of server B.
+*
+*               (b) Server B holds a file shorter than the octets wr'n from server A : the transfer fails
+*                   with TFTPc_ERR_POOL, since the local file can NOT be truncated.
+*********************************************************************************************************
+*/
+
+static  void  Test_Mismatch (void)
+{
+    FILE         *p_file;
+    CPU_INT08U    blk[512];
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+                                                                /* ----------------- (a) DIFFERENT FILE --------------- */
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrvA, "diff.bin"), TEST_FILE_LEN, 471u) == DEF_OK);
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrvB, "diff.bin"), TEST_FILE_LEN, 472u) == DEF_OK);
+                                                                /* Same 1st blk on both servers.                        */
+    p_file = fopen(HostTest_Path(Test_DirSrvA, "diff.bin"), "rb");
+    HOST_TEST_REQ(p_file != DEF_NULL);
+    HOST_TEST_REQ(fread(blk, 1u, sizeof(blk), p_file) == sizeof(blk));
+    fclose(p_file);
+    p_file = fopen(HostTest_Path(Test_DirSrvB, "diff.bin"), "r+b");
+    HOST_TEST_REQ(p_file != DEF_NULL);
+   (void)fwrite(blk, 1u, sizeof(blk), p_file);
+    fclose(p_file);
+
+    HOST_TEST_REQ(TFTPc_PoolSet(&Test_PoolTbl[0], 2u, &err) == DEF_OK);
+
+    Test_Get("diff.bin", TEST_BLK_STOP, &ok, &err);
+    HOST_TEST_CHK(ok           == DEF_OK);
+    HOST_TEST_CHK(Test_ReqCtrA == 1u);
+    HOST_TEST_CHK(Test_ReqCtrB == 1u);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrvB,  "diff.bin"),
+                                   HostTest_Path(Test_DirLocal, "diff.bin")) == DEF_YES);
+                                                                /* ------------------ (b) SHORTER FILE ---------------- */
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrvA, "short.bin"), TEST_FILE_LEN, 473u) == DEF_OK);
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrvB, "short.bin"),          1000u, 473u) == DEF_OK);
+
+    HOST_TEST_REQ(TFTPc_PoolSet(&Test_PoolTbl[0], 2u, &err) == DEF_OK);
+
+    Test_Get("short.bin", TEST_BLK_STOP, &ok, &err);
+    HOST_TEST_CHK(ok           == DEF_FAIL);
+    HOST_TEST_CHK(err          == TFTPc_ERR_POOL);
+    HOST_TEST_CHK(Test_ReqCtrB == 1u);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrvA  = HostTest_DirCreate();
+    Test_DirSrvB  = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrvA != DEF_NULL) && (Test_DirSrvB != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrvA, "same.bin"), TEST_FILE_LEN, 47u) == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrvB, "same.bin"), TEST_FILE_LEN, 47u) == DEF_OK);
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    Test_PoolTbl[0]                        = Test_Cfg;
+    Test_PoolTbl[0].RxInactivityTimeout_ms = TEST_TIMEOUT_ms;
+    Test_PoolTbl[1]                        = Test_PoolTbl[0];
+    Test_PoolTbl[1].ServerHostnamePtr      = "10.0.0.3";
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Failover);
+        HOST_TEST_RUN(Test_Mismatch);
+    }
+
+    return (HostTest_End());
+}
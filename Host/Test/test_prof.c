@@ -0,0 +1,269 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*
+*                              HOST PORT : PHASE PROFILE & TX RATE LIMIT TEST
+*
+* Filename : test_prof.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with phase profiling & tx rate limits on the simulated network.
+*
+*            (2) The phase durations are measured with the CPU timestamps of the host, NOT with the virtual
+*                clock : only their counts & their consistency are checked.
+*
+*            (3) The tx rate limits are enforced on the virtual clock : a put of TEST_FILE_LEN octets MUST
+*                last about TEST_FILE_LEN / rate seconds, whichever bucket limits it.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_FILE_LEN                                 20000u
+
+#define  TEST_RATE_SESSION                             10000u   /* Session rate limit (octets/sec).                     */
+#define  TEST_RATE_GLOBAL                              20000u   /* Global  rate limit (octets/sec).                     */
+
+                                                                /* Expected put duration at a rate (see Note #3).       */
+#define  TEST_DURATION_MIN_ms(rate)      ((TEST_FILE_LEN * 1000u / (rate)) *  95u / 100u)
+#define  TEST_DURATION_MAX_ms(rate)      ((TEST_FILE_LEN * 1000u / (rate)) * 110u / 100u)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR      *Test_DirSrv;
+static  CPU_CHAR      *Test_DirLocal;
+static  TFTPc_CFG      Test_Cfg;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_SimStart()
+*
+* Description : Reset the simulation & attach a server.
+*********************************************************************************************************
+*/
+
+static  HOST_SIM_SRV  *Test_SimStart (void)
+{
+    HOST_SRV_CFG  srv_cfg;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+
+    return (HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT));
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Put()
+*
+* Description : Put the file with a session rate limit & check the duration of the transfer.
+*
+* Argument(s) : rate_session    Session rate limit (octets/sec), 0 if unlimited.
+*
+*               rate            Rate expected for the transfer (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_Put (CPU_INT32U  rate_session,
+                        CPU_INT32U  rate)
+{
+    HOST_SIM_SRV  *p_srv;
+    TFTPc_CFG      cfg;
+    TFTPc_STATS    stats;
+    CPU_BOOLEAN    ok;
+    TFTPc_ERR      err;
+
+
+    p_srv = Test_SimStart();
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+
+    cfg                       = Test_Cfg;
+    cfg.TxRateMaxOctetsPerSec = rate_session;
+    cfg.TxBurstMaxOctets      = 0u;                             /* Single pkt.                                          */
+    ok = TFTPc_Put(&cfg, HostTest_Path(Test_DirLocal, "rate.bin"), "rate.bin", TFTPc_MODE_OCTET, &err);
+    HostSim_Run(10u);                                           /* Deliver the last DATA.                               */
+    HostSimSrv_Stop(p_srv);
+
+    HOST_TEST_CHK(ok == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirLocal, "rate.bin"),
+                                   HostTest_Path(Test_DirSrv,   "rate.bin")) == DEF_YES);
+
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.Duration_ms >= TEST_DURATION_MIN_ms(rate));
+    HOST_TEST_CHK(stats.Duration_ms <= TEST_DURATION_MAX_ms(rate));
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Profile()
+*
+* Description : Get a file : every phase of the transfer is sampled, with consistent durations (see
+*               Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_Profile (void)
+{
+    HOST_SIM_SRV         *p_srv;
+    TFTPc_PROFILE         profile;
+    TFTPc_PROFILE_PHASE  *p_phase;
+    TFTPc_STATS           stats;
+    CPU_INT08U            phase;
+    CPU_BOOLEAN           ok;
+    TFTPc_ERR             err;
+
+
+    p_srv = Test_SimStart();
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "prof.bin"), "prof.bin", TFTPc_MODE_OCTET, &err);
+    HostSim_Run(10u);                                           /* Deliver the last ACK.                                */
+    HostSimSrv_Stop(p_srv);
+    HOST_TEST_REQ(ok == DEF_OK);
+
+    HOST_TEST_REQ(TFTPc_ProfileGet(&profile, &err) == DEF_OK);
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(profile.SessionID == stats.SessionID);
+
+    for (phase = 0u; phase < TFTPc_PROFILE_PHASE_NBR; phase++) {
+        p_phase = &profile.Phase[phase];
+        HOST_TEST_CHK(p_phase->NbrSamples >  0u);
+        HOST_TEST_CHK(p_phase->Min        <= p_phase->Mean);
+        HOST_TEST_CHK(p_phase->Mean       <= p_phase->Max);
+        HOST_TEST_CHK(p_phase->Total      >= p_phase->Max);
+    }
+                                                                /* One rx & one file wr per DATA blk.                   */
+    HOST_TEST_CHK(profile.Phase[TFTPc_PROFILE_PHASE_RX].NbrSamples   >= stats.DataBlkCtr);
+    HOST_TEST_CHK(profile.Phase[TFTPc_PROFILE_PHASE_FILE].NbrSamples >= stats.DataBlkCtr);
+    HOST_TEST_CHK(profile.Phase[TFTPc_PROFILE_PHASE_TX].NbrSamples   == stats.TxPktCtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_RateSession()
+*
+* Description : Put a file with a session rate limit : the transfer lasts as long as the rate requires,
+*               on the virtual clock (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_RateSession (void)
+{
+    Test_Put(TEST_RATE_SESSION, TEST_RATE_SESSION);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_RateGlobal()
+*
+* Description : Put a file with the global rate limit, then with both limits : the slower bucket sets the
+*               duration of the transfer (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_RateGlobal (void)
+{
+    TFTPc_ERR  err;
+
+
+    HOST_TEST_REQ(TFTPc_TxRateLimitSet(TEST_RATE_GLOBAL, 0u, &err) == DEF_OK);
+    Test_Put(0u,                TEST_RATE_GLOBAL);
+    Test_Put(TEST_RATE_SESSION, TEST_RATE_SESSION);
+    HOST_TEST_CHK(TFTPc_TxRateLimitSet(0u, 0u, &err) == DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrv,   "prof.bin"), TEST_FILE_LEN, 27u) == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirLocal, "rate.bin"), TEST_FILE_LEN, 28u) == DEF_OK);
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Profile);
+        HOST_TEST_RUN(Test_RateSession);
+        HOST_TEST_RUN(Test_RateGlobal);
+    }
+
+    return (HostTest_End());
+}
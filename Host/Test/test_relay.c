@@ -0,0 +1,343 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      HOST PORT : LAN RELAY TEST
+*
+* Filename : test_relay.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with the LAN relay role on the simulated network.  The client gets files
+*                from the test server, then serves them from its relay cache to a second client :
+*
+*                (a) The second client is scripted on a node of its own (TEST_PEER_ADDR) : it sends a read
+*                    request to the relay responder & acknowledges each DATA block as it is delivered.
+*
+*                (b) The simulation is single-threaded : the responder serves the request from within
+*                    TFTPc_RelaySrvProcess(), which drives the simulated network while it waits.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdio.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+#define  TEST_RELAY_PORT                                1069u
+
+#define  TEST_PEER_ADDR                          0x0A000003u    /* 10.0.0.3 : second client (see Note #1a).             */
+
+#define  TEST_FILE_LEN_MAX                             16384u
+
+#define  TEST_OPCODE_RRQ                                   1u
+#define  TEST_OPCODE_DATA                                  3u
+#define  TEST_OPCODE_ACK                                   4u
+#define  TEST_OPCODE_ERR                                   5u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  test_peer {
+    HOST_SIM_SOCK  *SockPtr;
+    CPU_INT08U      Buf[TEST_FILE_LEN_MAX];                     /* File data rx'd.                                      */
+    CPU_INT32U      Len;
+    CPU_INT16U      BlkNext;                                    /* Nbr of the next blk expected.                        */
+    CPU_BOOLEAN     Complete;                                   /* Last (short) blk rx'd.                               */
+    CPU_INT32U      ErrCtr;                                     /* Nbr of ERRORs rx'd.                                  */
+    CPU_INT16U      ErrCode;
+} TEST_PEER;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR   *Test_DirSrv;
+static  CPU_CHAR   *Test_DirLocal;
+static  TFTPc_CFG   Test_Cfg;
+
+static  TEST_PEER   Test_Peer;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           Test_PeerRx()
+*
+* Description : Simulation handler : store each DATA block rx'd in sequence & acknowledge it (see Note #1a).
+*********************************************************************************************************
+*/
+
+static  void  Test_PeerRx (       void           *p_arg,
+                                  HOST_SIM_SOCK  *p_sock,
+                           const  HOST_SIM_PKT   *p_pkt)
+{
+    TEST_PEER   *p_peer;
+    CPU_INT08U   ack[4];
+    CPU_INT16U   opcode;
+    CPU_INT16U   blk_nbr;
+    CPU_INT32U   data_len;
+
+
+    p_peer = (TEST_PEER *)p_arg;
+    if (p_pkt->Len < 4u) {
+        return;
+    }
+    opcode  = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]);
+    blk_nbr = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]);
+
+    switch (opcode) {
+        case TEST_OPCODE_DATA:
+             data_len = p_pkt->Len - 4u;
+             if ((blk_nbr                  == p_peer->BlkNext) &&
+                 (p_peer->Len + data_len   <= sizeof(p_peer->Buf))) {
+                 Mem_Copy(&p_peer->Buf[p_peer->Len], &p_pkt->Data[4], data_len);
+                 p_peer->Len += data_len;
+                 p_peer->BlkNext++;
+                 if (data_len < 512u) {
+                     p_peer->Complete = DEF_YES;
+                 }
+             }
+             MEM_VAL_SET_INT16U_BIG(&ack[0], TEST_OPCODE_ACK);
+             MEM_VAL_SET_INT16U_BIG(&ack[2], blk_nbr);
+            (void)HostSim_SockTx(p_sock, p_pkt->SrcAddr, p_pkt->SrcPort, ack, sizeof(ack));
+             break;
+
+
+        case TEST_OPCODE_ERR:
+             p_peer->ErrCtr++;
+             p_peer->ErrCode = blk_nbr;
+             break;
+
+
+        default:
+             break;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_PeerGet()
+*
+* Description : Request 'p_name' from the relay responder as the second client, & serve the request.
+*
+* Argument(s) : p_name      Name of the file req'd.
+*
+*               p_ok        Pointer to variable that will receive the result of TFTPc_RelaySrvProcess().
+*
+*               p_err       Pointer to variable that will receive the error of TFTPc_RelaySrvProcess().
+*
+* Return(s)   : none.
+*********************************************************************************************************
+*/
+
+static  void  Test_PeerGet (const  CPU_CHAR     *p_name,
+                                   CPU_BOOLEAN  *p_ok,
+                                   TFTPc_ERR    *p_err)
+{
+    CPU_INT08U  req[128];
+    CPU_INT32U  len;
+
+
+    *p_ok = DEF_FAIL;
+    Mem_Clr(&Test_Peer, sizeof(Test_Peer));
+    Test_Peer.BlkNext = 1u;
+    Test_Peer.SockPtr = HostSim_SockOpen();
+    HOST_TEST_REQ(Test_Peer.SockPtr != DEF_NULL);
+    HOST_TEST_REQ(HostSim_SockBind(Test_Peer.SockPtr, TEST_PEER_ADDR, 0u) == DEF_OK);
+    HostSim_SockHandlerSet(Test_Peer.SockPtr, Test_PeerRx, &Test_Peer);
+
+    MEM_VAL_SET_INT16U_BIG(&req[0], TEST_OPCODE_RRQ);
+    len = 2u;
+    Mem_Copy(&req[len], p_name, Str_Len(p_name) + 1u);
+    len += Str_Len(p_name) + 1u;
+    Mem_Copy(&req[len], "octet", 6u);
+    len += 6u;
+   (void)HostSim_SockTx(Test_Peer.SockPtr, HOST_SIM_ADDR_CLIENT, TEST_RELAY_PORT, req, len);
+
+    *p_ok = TFTPc_RelaySrvProcess(1000u, p_err);
+    HostSim_Run(10u);                                           /* Deliver the last pkt tx'd by the responder.          */
+
+    HostSim_SockClose(Test_Peer.SockPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                             Test_Get()
+*
+* Description : Get 'p_name' from the test server, to the local file of the same name.
+*********************************************************************************************************
+*/
+
+static  void  Test_Get (const  CPU_CHAR     *p_name,
+                               CPU_BOOLEAN  *p_ok,
+                               TFTPc_ERR    *p_err)
+{
+    HOST_SRV_CFG   srv_cfg;
+    HOST_SIM_SRV  *p_srv;
+
+
+    *p_ok = DEF_FAIL;
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    p_srv              = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+
+    *p_ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, p_name), (CPU_CHAR *)p_name, TFTPc_MODE_OCTET, p_err);
+
+    HostSimSrv_Stop(p_srv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Serve()
+*
+* Description : (a) A file rx'd by TFTPc_Get() is served from the relay cache to a second client, whole.
+*
+*               (b) A file that is NOT cached is rejected with an ERROR 1 (file not found), which is NOT an
+*                   error of the responder.
+*
+*               (c) A file whose name is too long to be cached is still rx'd, but NOT served (see 'TFTPc_Get()
+*                   Note #8c').
+*********************************************************************************************************
+*/
+
+static  void  Test_Serve (void)
+{
+    static  const  CPU_CHAR  name_long[] = "relay_name_longer_than_the_relay_cache_entries_can_record_0123456789.bin";
+    FILE         *p_file;
+    CPU_INT08U    buf[TEST_FILE_LEN_MAX];
+    CPU_INT32U    len;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+    HOST_TEST_REQ(TFTPc_RelaySrvStart(NET_IP_ADDR_FAMILY_IPv4, TEST_RELAY_PORT, &err) == DEF_OK);
+                                                                /* ----------------- (a) CACHED FILE ------------------ */
+    Test_Get("relay.bin", &ok, &err);
+    HOST_TEST_REQ(ok == DEF_OK);
+
+    Test_PeerGet("relay.bin", &ok, &err);
+    HOST_TEST_CHK(ok                 == DEF_OK);
+    HOST_TEST_CHK(err                == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(Test_Peer.Complete == DEF_YES);
+    HOST_TEST_CHK(Test_Peer.ErrCtr   == 0u);
+
+    p_file = fopen(HostTest_Path(Test_DirSrv, "relay.bin"), "rb");
+    HOST_TEST_REQ(p_file != DEF_NULL);
+    len = (CPU_INT32U)fread(buf, 1u, sizeof(buf), p_file);
+    fclose(p_file);
+    HOST_TEST_CHK(Test_Peer.Len == len);
+    HOST_TEST_CHK(Mem_Cmp(Test_Peer.Buf, buf, len) == DEF_YES);
+                                                                /* ------------------ (b) NOT CACHED ------------------ */
+    Test_PeerGet("other.bin", &ok, &err);
+    HOST_TEST_CHK(ok                 == DEF_OK);
+    HOST_TEST_CHK(Test_Peer.ErrCtr   == 1u);
+    HOST_TEST_CHK(Test_Peer.ErrCode  == 1u);
+    HOST_TEST_CHK(Test_Peer.Len      == 0u);
+                                                                /* ------------------ (c) NAME TOO LONG --------------- */
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, name_long), 1200u, 46u) == DEF_OK);
+    Test_Get(name_long, &ok, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   name_long),
+                                   HostTest_Path(Test_DirLocal, name_long)) == DEF_YES);
+
+    Test_PeerGet(name_long, &ok, &err);
+    HOST_TEST_CHK(ok                 == DEF_OK);
+    HOST_TEST_CHK(Test_Peer.ErrCtr   == 1u);
+    HOST_TEST_CHK(Test_Peer.Len      == 0u);
+
+    TFTPc_RelaySrvStop();
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrv, "relay.bin"), 5000u, 46u) == DEF_OK);
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Serve);
+    }
+
+    return (HostTest_End());
+}
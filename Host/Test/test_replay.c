@@ -0,0 +1,299 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                   HOST PORT : CAPTURE REPLAY TEST
+*
+* Filename : test_replay.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Captures a lossy get & a put against the test server on the simulated network, converts
+*                the capture to a pcap & back, then replays it without the server (see
+*                'Sim/host_sim_replay.c') : the unmodified client MUST transfer the same files, with the
+*                same RX timeouts, & never diverge from the capture.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  <Source/tftp-c_cap.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdlib.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+#define  TEST_SRV_HOST_NAME                       "tftp.sim"
+
+#define  TEST_SRV_TIMEOUT_ms                           12000u   /* Longer than 2 client RX timeouts.                    */
+
+#define  TEST_LOSS_BLK_NBR                                 3u
+
+#define  TEST_REC_NBR_MAX                   TFTPc_CFG_CAP_RING_NBR_PKT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR       *Test_DirSrv;
+static  CPU_CHAR       *Test_DirLocal;
+static  TFTPc_CFG       Test_Cfg;
+
+static  CPU_INT32U      Test_LossCtr;                           /* Nbr of DATA blks still to drop.                      */
+
+static  TFTPc_CAP_REC   Test_RecTbl[TEST_REC_NBR_MAX];          /* Capture, after the pcap round trip.                  */
+static  CPU_INT16U      Test_RecNbr;
+static  CPU_INT32U      Test_RxTimeoutCtr;                      /* RX timeouts of the captured get.                     */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         Test_LossFilter()
+*
+* Description : Simulation filter : drop the first Test_LossCtr copies of DATA block TEST_LOSS_BLK_NBR.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_LossFilter (       void          *p_arg,
+                                      const  HOST_SIM_PKT  *p_pkt)
+{
+   (void)p_arg;
+
+    if ((p_pkt->SrcAddr                           != HOST_SIM_ADDR_SRV) ||
+        (p_pkt->Len                               <  4u)                ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) != 3u)                ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) != TEST_LOSS_BLK_NBR) ||
+        (Test_LossCtr                             == 0u)) {
+        return (DEF_YES);
+    }
+
+    Test_LossCtr--;
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Capture()
+*
+* Description : Capture a get with a lost DATA block & a put, & convert the capture to a pcap & back.
+*********************************************************************************************************
+*/
+
+static  void  Test_Capture (void)
+{
+    static  TFTPc_CAP_REC   rec_tbl[TEST_REC_NBR_MAX];
+            HOST_SRV_CFG    srv_cfg;
+            HOST_SIM_SRV   *p_srv;
+            TFTPc_STATS     stats;
+            CPU_INT08U     *p_pcap;
+            CPU_SIZE_T      pcap_len;
+            CPU_INT16U      nbr;
+            CPU_BOOLEAN     ok;
+            TFTPc_ERR       err;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv,   "get.bin"), 3000u, 5u) == DEF_OK);
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirLocal, "put.bin"), 1500u, 6u) == DEF_OK);
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+   (void)HostSim_HostAdd(TEST_SRV_HOST_NAME, HOST_SIM_ADDR_SRV);
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = TEST_SRV_TIMEOUT_ms;
+    srv_cfg.RetryMax   = 5u;
+    p_srv              = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+    Test_LossCtr = 1u;
+    HostSim_FilterSet(Test_LossFilter, DEF_NULL);
+
+    TFTPc_CapClr();
+    TFTPc_CapEnSet(DEF_ENABLED);
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "get.bin"), "get.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok == DEF_OK);
+   (void)TFTPc_StatsGet(&stats, &err);
+    Test_RxTimeoutCtr = stats.RxTimeoutCtr;
+    ok = TFTPc_Put(&Test_Cfg, HostTest_Path(Test_DirLocal, "put.bin"), "put.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok == DEF_OK);
+    TFTPc_CapEnSet(DEF_DISABLED);
+    HostSimSrv_Stop(p_srv);
+    HOST_TEST_CHK(Test_RxTimeoutCtr == 2u);
+                                                                /* --------------- PCAP ROUND TRIP -------------------- */
+    nbr      = TFTPc_CapDump(rec_tbl, TEST_REC_NBR_MAX);
+    HOST_TEST_REQ((nbr > 0u) && (nbr < TEST_REC_NBR_MAX));      /* Whole capture, NOT wrapped.                          */
+    pcap_len = TFTPc_CapPcapExport(rec_tbl, nbr, DEF_NULL, 0u);
+    p_pcap   = (CPU_INT08U *)malloc(pcap_len);
+    HOST_TEST_REQ(p_pcap != DEF_NULL);
+    HOST_TEST_CHK(TFTPc_CapPcapExport(rec_tbl, nbr, p_pcap, pcap_len) == pcap_len);
+    Test_RecNbr = TFTPc_CapPcapImport(p_pcap, pcap_len, Test_RecTbl, TEST_REC_NBR_MAX);
+    free(p_pcap);
+    HOST_TEST_CHK(Test_RecNbr == nbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Replay()
+*
+* Description : Replay the capture without the server (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Test_Replay (void)
+{
+    HOST_SIM_REPLAY         *p_replay;
+    HOST_SIM_REPLAY_RESULT   result;
+    TFTPc_STATS              stats;
+    CPU_BOOLEAN              ok;
+    TFTPc_ERR                err;
+
+
+    HOST_TEST_REQ(Test_RecNbr > 0u);
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+   (void)HostSim_HostAdd(TEST_SRV_HOST_NAME, HOST_SIM_ADDR_SRV);
+    p_replay = HostSimReplay_Start(Test_RecTbl, Test_RecNbr);
+    HOST_TEST_REQ(p_replay != DEF_NULL);
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "replay.bin"), "get.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok == DEF_OK);
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stats.RxTimeoutCtr == Test_RxTimeoutCtr);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "get.bin"),
+                                   HostTest_Path(Test_DirLocal, "replay.bin")) == DEF_YES);
+
+    ok = TFTPc_Put(&Test_Cfg, HostTest_Path(Test_DirLocal, "put.bin"), "put.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok == DEF_OK);
+
+    HostSimReplay_ResultGet(p_replay, &result);
+    HostSimReplay_Stop(p_replay);
+
+    HOST_TEST_CHK(result.RecNbr         == Test_RecNbr);
+    HOST_TEST_CHK(result.RecReplayedNbr == Test_RecNbr);
+    HOST_TEST_CHK(result.RxCtr          >  0u);
+    HOST_TEST_CHK(result.DivergeCtr     == 0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Diverge()
+*
+* Description : Replay a capture altered so that one ACK differs : the divergence is reported, & the
+*               replay goes on.
+*********************************************************************************************************
+*/
+
+static  void  Test_Diverge (void)
+{
+    static  TFTPc_CAP_REC            rec_tbl[TEST_REC_NBR_MAX];
+            HOST_SIM_REPLAY         *p_replay;
+            HOST_SIM_REPLAY_RESULT   result;
+            CPU_INT16U               ix;
+            CPU_BOOLEAN              ok;
+            TFTPc_ERR                err;
+
+
+    HOST_TEST_REQ(Test_RecNbr > 0u);
+
+    Mem_Copy(rec_tbl, Test_RecTbl, sizeof(rec_tbl));
+    for (ix = 0u; ix < Test_RecNbr; ix++) {                     /* Alter the first ACK of the get.                      */
+        if ((rec_tbl[ix].Dir                              == TFTPc_CAP_DIR_TX) &&
+            (MEM_VAL_GET_INT16U_BIG(&rec_tbl[ix].Data[0]) == 4u)) {
+            MEM_VAL_SET_INT16U_BIG(&rec_tbl[ix].Data[2], 0xFFFFu);
+            break;
+        }
+    }
+    HOST_TEST_REQ(ix < Test_RecNbr);
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+   (void)HostSim_HostAdd(TEST_SRV_HOST_NAME, HOST_SIM_ADDR_SRV);
+    p_replay = HostSimReplay_Start(rec_tbl, Test_RecNbr);
+    HOST_TEST_REQ(p_replay != DEF_NULL);
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "diverge.bin"), "get.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok == DEF_OK);
+
+    HostSimReplay_ResultGet(p_replay, &result);
+    HostSimReplay_Stop(p_replay);
+
+    HOST_TEST_CHK(result.DivergeCtr == 1u);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = TEST_SRV_HOST_NAME;
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Capture);
+        HOST_TEST_RUN(Test_Replay);
+        HOST_TEST_RUN(Test_Diverge);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,723 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : SIMULATED NETWORK TEST
+*
+* Filename : test_sim.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc on the simulated network (see 'Sim/host_sim.h') against the test server on node
+*                HOST_SIM_ADDR_SRV.  The client RX timeouts run on the virtual clock : a scenario that
+*                waits for several RX timeouts completes in well under a second of wall-clock time.
+*
+*            (2) Each scenario starts from HostSim_Init(), so that two runs of the same scenario MUST give
+*                the same packet counts & the same virtual duration.
+*
+*            (3) Impairments (see 'Sim/host_sim.h  Note #4') are seeded : a lossy, reordering link gives
+*                the same run every time, too.
+*
+*            (4) The test is also built with request backoff & a fixed backoff seed ('test_sim_backoff') :
+*                durations are measured from the first req & allow for the backoff delays.
+*
+*            (5) The test is also built with the socket connected to the server TID ('test_sim_sock_conn') :
+*                the simulated socket layer then drops the strays from another server port, which are
+*                neither counted nor answered (see 'tftp-c_cfg.h  TFTPc SOCKET CONNECT CONFIGURATION').
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdlib.h>
+#include  <time.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+#define  TEST_SRV_HOST_NAME                       "tftp.sim"
+
+#define  TEST_SRV_TIMEOUT_ms                           12000u   /* Longer than 2 client RX timeouts (see Test_Loss()).  */
+
+#define  TEST_LOSS_BLK_NBR                                 3u
+
+#define  TEST_STRAY_PORT                               40000u   /* Port of the stray sender (see Test_Stray()).         */
+#define  TEST_STRAY_PERIOD_ms                           1000u   /* Shorter than the client RX timeout.                  */
+#define  TEST_STRAY_NBR_MAX                              100u
+
+#define  TEST_RATE_bps                               1000000u   /* Rate limited link (see Test_RateLimit()) ...         */
+#define  TEST_RATE_BIT_TX_us                               1u   /* ... : 1 bit per us.                                  */
+#define  TEST_RATE_PKT_LEN                              1000u
+#define  TEST_RATE_PKT_TX_us           ((TEST_RATE_PKT_LEN + 28u) * 8u * TEST_RATE_BIT_TX_us)
+#define  TEST_RATE_DATA_TX_us          ((516u              + 28u) * 8u * TEST_RATE_BIT_TX_us)
+#define  TEST_RATE_DATA_LAST_TX_us     ((  4u              + 28u) * 8u * TEST_RATE_BIT_TX_us)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  test_stray {
+    HOST_SIM_SOCK  *SockPtr;
+    CPU_INT16U      ClientPort;                                 /* Client port, learnt by Test_StrayFilter().           */
+    CPU_BOOLEAN     Armed;                                      /* Send strays once the client ACK'd a DATA blk.        */
+    CPU_BOOLEAN     Periodic;                                   /* Send strays every TEST_STRAY_PERIOD_ms, or once.     */
+    CPU_INT32U      TxCtr;
+    CPU_INT32U      TxNext_ms;                                  /* Time of the next stray.                              */
+} TEST_STRAY;
+
+typedef  struct  test_run {
+    CPU_BOOLEAN     Ok;
+    TFTPc_STATS     Stats;
+    HOST_SIM_STATS  SimStats;
+    CPU_INT64U      Duration_us;                                /* Virtual duration of the transfer.                    */
+} TEST_RUN;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR      *Test_DirSrv;
+static  CPU_CHAR      *Test_DirLocal;
+static  HOST_SIM_SRV  *Test_SrvPtr;
+static  TFTPc_CFG      Test_Cfg;
+
+static  CPU_INT32U     Test_LossCtr;                            /* Nbr of DATA blks still to drop.                      */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_SimStart()
+*
+* Description : Reset the simulation & attach the server (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_SimStart (CPU_INT32U  srv_timeout_ms)
+{
+    HOST_SRV_CFG  srv_cfg;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+   (void)HostSim_HostAdd(TEST_SRV_HOST_NAME, HOST_SIM_ADDR_SRV);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = srv_timeout_ms;
+    srv_cfg.RetryMax   = 5u;
+    Test_SrvPtr        = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_CHK(Test_SrvPtr != DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_SimStop()
+*
+* Description : Detach the server.
+*********************************************************************************************************
+*/
+
+static  void  Test_SimStop (void)
+{
+    HostSimSrv_Stop(Test_SrvPtr);
+    Test_SrvPtr = DEF_NULL;
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_LossFilter()
+*
+* Description : Simulation filter : drop the first Test_LossCtr copies of DATA block TEST_LOSS_BLK_NBR.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_LossFilter (       void          *p_arg,
+                                      const  HOST_SIM_PKT  *p_pkt)
+{
+   (void)p_arg;
+
+    if ((p_pkt->SrcAddr                           != HOST_SIM_ADDR_SRV) ||
+        (p_pkt->Len                               <  4u)                ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) != 3u)                ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) != TEST_LOSS_BLK_NBR) ||
+        (Test_LossCtr                             == 0u)) {
+        return (DEF_YES);
+    }
+
+    Test_LossCtr--;
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_StrayFilter()
+*
+* Description : Simulation filter : learn the client port; arm a one-shot stray on the first ACK.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_StrayFilter (       void          *p_arg,
+                                       const  HOST_SIM_PKT  *p_pkt)
+{
+    TEST_STRAY  *p_stray;
+
+
+    p_stray = (TEST_STRAY *)p_arg;
+    if (p_pkt->SrcAddr != HOST_SIM_ADDR_CLIENT) {
+        return (DEF_YES);
+    }
+
+    p_stray->ClientPort = p_pkt->SrcPort;
+    if ((p_stray->Periodic                          == DEF_YES) ||
+        ((p_pkt->Len                               >= 4u)       &&
+         (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) == 4u))) {
+        p_stray->Armed = DEF_YES;
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_StrayTmr()
+*
+* Description : Simulation timer : send a DATA blk 1 to the client from the stray socket.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_StrayTmr (void        *p_arg,
+                                   CPU_INT32U   now_ms)
+{
+    TEST_STRAY  *p_stray;
+    CPU_INT08U   pkt[516];
+
+
+    p_stray = (TEST_STRAY *)p_arg;
+    if (p_stray->Armed == DEF_NO) {
+        return (1u);
+    }
+    if ((p_stray->TxCtr >= TEST_STRAY_NBR_MAX) ||
+        ((p_stray->Periodic == DEF_NO) && (p_stray->TxCtr > 0u))) {
+        return (HOST_SIM_TIMEOUT_INFINITE);
+    }
+    if ((p_stray->TxCtr > 0u) &&
+        ((CPU_INT32S)(p_stray->TxNext_ms - now_ms) > 0)) {
+        return (p_stray->TxNext_ms - now_ms);
+    }
+
+    Mem_Clr(pkt, sizeof(pkt));
+    MEM_VAL_SET_INT16U_BIG(&pkt[0], 3u);
+    MEM_VAL_SET_INT16U_BIG(&pkt[2], 1u);
+   (void)HostSim_SockTx(p_stray->SockPtr, HOST_SIM_ADDR_CLIENT, p_stray->ClientPort, pkt, sizeof(pkt));
+    p_stray->TxCtr++;
+    p_stray->TxNext_ms = now_ms + TEST_STRAY_PERIOD_ms;
+
+    return ((p_stray->Periodic == DEF_YES) ? TEST_STRAY_PERIOD_ms : HOST_SIM_TIMEOUT_INFINITE);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Test_StartDlyGet_us()
+*
+* Description : Get the time between the start of a transfer at 'ts_start_us' & its first req : the backoff
+*               start jitter, when request backoff is enabled (see 'tftp-c_cfg.h  TFTPc REQUEST BACKOFF
+*               CONFIGURATION  Note #1a').
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U  Test_StartDlyGet_us (       CPU_INT64U    ts_start_us,
+                                         const  TFTPc_STATS  *p_stats)
+{
+    return ((CPU_INT64U)(NET_TS_MS)(p_stats->TS_Start_ms - (NET_TS_MS)(ts_start_us / 1000u)) * 1000u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        Test_BackoffMax_us()
+*
+* Description : Get the longest time the first 'retry_nbr' re-tx of a req may be delayed by request backoff
+*               (see 'tftp-c_cfg.h  TFTPc REQUEST BACKOFF CONFIGURATION  Note #1b'); 0 if NOT enabled.
+*********************************************************************************************************
+*/
+
+static  CPU_INT64U  Test_BackoffMax_us (CPU_INT32U  retry_nbr)
+{
+    CPU_INT64U  max_us;
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+    CPU_INT32U  win_ms;
+
+
+    max_us = 0u;
+    win_ms = TFTPc_CFG_BACKOFF_BASE_ms;
+    while (retry_nbr > 0u) {
+        win_ms  = DEF_MIN(win_ms, TFTPc_CFG_BACKOFF_MAX_ms);
+        max_us += (CPU_INT64U)win_ms * 1000u;
+        win_ms *= 2u;
+        retry_nbr--;
+    }
+#else
+   (void)retry_nbr;
+
+    max_us = 0u;
+#endif
+
+    return (max_us);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Run()
+*
+* Description : Run one read transfer of 'name' with 'loss_nbr' copies of a DATA block dropped, & with
+*               'p_impair' impairments on both nodes, if not NULL.
+*********************************************************************************************************
+*/
+
+static  void  Test_Run (const  CPU_CHAR             *p_name,
+                               CPU_INT32U            loss_nbr,
+                        const  HOST_SIM_IMPAIR_CFG  *p_impair,
+                               TEST_RUN             *p_run)
+{
+    CPU_INT64U  ts_start_us;
+    TFTPc_ERR   err;
+
+
+    Mem_Clr(p_run, sizeof(TEST_RUN));
+    Test_SimStart(TEST_SRV_TIMEOUT_ms);
+    Test_LossCtr = loss_nbr;
+    HostSim_FilterSet(Test_LossFilter, DEF_NULL);
+    if (p_impair != DEF_NULL) {
+        HostSim_LinkDlySet(1000u);
+        HOST_TEST_CHK(HostSim_ImpairSet(HOST_SIM_ADDR_SRV,    p_impair) == DEF_OK);
+        HOST_TEST_CHK(HostSim_ImpairSet(HOST_SIM_ADDR_CLIENT, p_impair) == DEF_OK);
+    }
+
+    ts_start_us = HostSim_TimeGet_us();
+    p_run->Ok   = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, p_name), (CPU_CHAR *)p_name,
+                            TFTPc_MODE_OCTET, &err);
+    p_run->Duration_us = HostSim_TimeGet_us() - ts_start_us;
+
+   (void)TFTPc_StatsGet(&p_run->Stats, &err);
+    HostSim_StatsGet(&p_run->SimStats);
+    Test_SimStop();
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_GetPut()
+*
+* Description : Get files around the block size boundaries & put one, by host name.
+*********************************************************************************************************
+*/
+
+static  void  Test_GetPut (void)
+{
+    static  const  CPU_INT32U  size_tbl[] = { 0u, 511u, 512u, 513u, 100000u };
+    CPU_CHAR                   name[32];
+    CPU_INT32U                 ix;
+    CPU_BOOLEAN                ok;
+    TFTPc_ERR                  err;
+
+
+    Test_SimStart(1000u);
+
+    for (ix = 0u; ix < sizeof(size_tbl) / sizeof(size_tbl[0]); ix++) {
+        snprintf(name, sizeof(name), "get_%u.bin", (unsigned)size_tbl[ix]);
+        HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, name), size_tbl[ix], ix + 1u) == DEF_OK);
+
+        ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, name), name, TFTPc_MODE_OCTET, &err);
+        HOST_TEST_CHK(ok  == DEF_OK);
+        HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+        HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   name),
+                                       HostTest_Path(Test_DirLocal, name)) == DEF_YES);
+    }
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirLocal, "put.bin"), 70000u, 99u) == DEF_OK);
+    ok = TFTPc_Put(&Test_Cfg, HostTest_Path(Test_DirLocal, "put.bin"), "put.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirLocal, "put.bin"),
+                                   HostTest_Path(Test_DirSrv,   "put.bin")) == DEF_YES);
+
+    Test_SimStop();
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Loss()
+*
+* Description : Drop the first copy of a DATA block : the client times out twice before the server re-tx's
+*               it (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Test_Loss (void)
+{
+    TEST_RUN  run;
+    clock_t   clk_start;
+    clock_t   clk_dur;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "loss.bin"), 4096u, 7u) == DEF_OK);
+
+    clk_start = clock();
+    Test_Run("loss.bin", 1u, DEF_NULL, &run);
+    clk_dur   = clock() - clk_start;
+
+    HOST_TEST_CHK(run.Ok                 == DEF_OK);
+    HOST_TEST_CHK(run.Stats.RxTimeoutCtr == 2u);
+    HOST_TEST_CHK(run.SimStats.PktDropCtr == 1u);
+    HOST_TEST_CHK(run.Duration_us        >= (CPU_INT64U)TEST_SRV_TIMEOUT_ms * 1000u);
+    HOST_TEST_CHK(clk_dur                <  CLOCKS_PER_SEC);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "loss.bin"),
+                                   HostTest_Path(Test_DirLocal, "loss.bin")) == DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_Determinism()
+*
+* Description : Run the same lossy scenario twice & compare the runs (see Note #2).
+*********************************************************************************************************
+*/
+
+static  void  Test_Determinism (void)
+{
+    TEST_RUN  run_a;
+    TEST_RUN  run_b;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "det.bin"), 30000u, 11u) == DEF_OK);
+
+    Test_Run("det.bin", 1u, DEF_NULL, &run_a);
+    Test_Run("det.bin", 1u, DEF_NULL, &run_b);
+
+    HOST_TEST_CHK(run_a.Ok                       == DEF_OK);
+    HOST_TEST_CHK(run_b.Ok                       == DEF_OK);
+    HOST_TEST_CHK(run_a.Duration_us              == run_b.Duration_us);
+    HOST_TEST_CHK(run_a.Stats.TxPktCtr           == run_b.Stats.TxPktCtr);
+    HOST_TEST_CHK(run_a.Stats.RxPktCtr           == run_b.Stats.RxPktCtr);
+    HOST_TEST_CHK(run_a.Stats.RxTimeoutCtr       == run_b.Stats.RxTimeoutCtr);
+    HOST_TEST_CHK(run_a.Stats.Duration_ms        == run_b.Stats.Duration_ms);
+    HOST_TEST_CHK(run_a.SimStats.PktTxCtr        == run_b.SimStats.PktTxCtr);
+    HOST_TEST_CHK(run_a.SimStats.OctetTxCtr      == run_b.SimStats.OctetTxCtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Impair()
+*
+* Description : Get a file over a link that loses, duplicates, delays & reorders packets both ways, twice
+*               (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_Impair (void)
+{
+    HOST_SIM_IMPAIR_CFG  impair;
+    TEST_RUN             run_a;
+    TEST_RUN             run_b;
+
+
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "impair.bin"), 200000u, 13u) == DEF_OK);
+
+    Mem_Clr(&impair, sizeof(impair));
+    impair.Seed          = 0x5EED0033u;
+    impair.LossRate      =  300u;                               /* 3 %.                                                 */
+    impair.DupRate       =  300u;
+    impair.ReorderRate   =  300u;
+    impair.ReorderDly_us = 3000u;
+    impair.Jitter_us     =  500u;
+
+    Test_Run("impair.bin", 0u, &impair, &run_a);
+    Test_Run("impair.bin", 0u, &impair, &run_b);
+
+    HOST_TEST_CHK(run_a.Ok                      == DEF_OK);
+    HOST_TEST_CHK(run_a.SimStats.PktLossCtr     >  0u);
+    HOST_TEST_CHK(run_a.SimStats.PktDupCtr      >  0u);
+    HOST_TEST_CHK(run_a.SimStats.PktReorderCtr  >  0u);
+    HOST_TEST_CHK(run_a.Stats.RxTimeoutCtr      >  0u);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "impair.bin"),
+                                   HostTest_Path(Test_DirLocal, "impair.bin")) == DEF_YES);
+
+    HOST_TEST_CHK(run_b.Ok                      == DEF_OK);
+    HOST_TEST_CHK(run_a.Duration_us             == run_b.Duration_us);
+    HOST_TEST_CHK(run_a.SimStats.PktTxCtr       == run_b.SimStats.PktTxCtr);
+    HOST_TEST_CHK(run_a.SimStats.PktLossCtr     == run_b.SimStats.PktLossCtr);
+    HOST_TEST_CHK(run_a.SimStats.PktReorderCtr  == run_b.SimStats.PktReorderCtr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_RateLimit()
+*
+* Description : (a) Get a file over a rate limited link : the transfer takes at least the serialization
+*                   time of its DATA packets.
+*
+*               (b) Send a burst through the same link : the packets that would queue longer than
+*                   'QueueDlyMax_us' are dropped, the others are spaced by their serialization time.
+*********************************************************************************************************
+*/
+
+static  void  Test_RateLimit (void)
+{
+    HOST_SIM_IMPAIR_CFG   impair;
+    TEST_RUN              run;
+    HOST_SIM_SOCK        *p_sock_tx;
+    HOST_SIM_SOCK        *p_sock_rx;
+    HOST_SIM_PKT         *p_pkt;
+    HOST_SIM_STATS        sim_stats;
+    CPU_INT08U            data[TEST_RATE_PKT_LEN];
+    CPU_INT16U            port;
+    CPU_INT64U            ts_start_us;
+    CPU_INT64U            ts_last_us;
+    CPU_INT32U            rx_ctr;
+    CPU_INT32U            ix;
+    TFTPc_ERR             err;
+
+                                                                /* ---------------- (a) RATE LIMITED GET -------------- */
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "rate.bin"), 51200u, 17u) == DEF_OK);
+
+    Mem_Clr(&impair, sizeof(impair));
+    impair.Rate_bps       = TEST_RATE_bps;
+    impair.QueueDlyMax_us = TEST_RATE_PKT_TX_us * 2u + TEST_RATE_PKT_TX_us / 2u;
+
+    Mem_Clr(&run, sizeof(run));
+    Test_SimStart(TEST_SRV_TIMEOUT_ms);
+    HOST_TEST_CHK(HostSim_ImpairSet(HOST_SIM_ADDR_SRV, &impair) == DEF_OK);
+
+    ts_start_us = HostSim_TimeGet_us();
+    run.Ok      = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "rate.bin"), "rate.bin", TFTPc_MODE_OCTET, &err);
+    run.Duration_us = HostSim_TimeGet_us() - ts_start_us;
+    HOST_TEST_CHK(run.Ok == DEF_OK);
+   (void)TFTPc_StatsGet(&run.Stats, &err);
+    run.Duration_us -= Test_StartDlyGet_us(ts_start_us, &run.Stats);
+                                                                /* 100 full DATA pkts & an empty one.                   */
+    HOST_TEST_CHK(run.Duration_us >= 100u * TEST_RATE_DATA_TX_us + TEST_RATE_DATA_LAST_TX_us);
+    HOST_TEST_CHK(run.Duration_us <  100u * TEST_RATE_DATA_TX_us + TEST_RATE_DATA_LAST_TX_us + 10000u);
+                                                                /* ------------------- (b) BURST ---------------------- */
+    p_sock_tx = HostSim_SockOpen();
+    p_sock_rx = HostSim_SockOpen();
+    HOST_TEST_REQ((p_sock_tx != DEF_NULL) && (p_sock_rx != DEF_NULL));
+    HOST_TEST_REQ(HostSim_SockBind(p_sock_tx, HOST_SIM_ADDR_SRV, 0u) == DEF_OK);
+    HOST_TEST_REQ(HostSim_SockBind(p_sock_rx, 0u,                0u) == DEF_OK);
+    HostSim_SockAddrGet(p_sock_rx, DEF_NULL, &port);
+    HostSim_Run(100u);                                          /* Let the link drain.                                  */
+
+    Mem_Clr(data, sizeof(data));
+    ts_start_us = HostSim_TimeGet_us();
+    for (ix = 0u; ix < 10u; ix++) {
+        HOST_TEST_CHK(HostSim_SockTx(p_sock_tx, HOST_SIM_ADDR_CLIENT, port, data, sizeof(data)) == DEF_OK);
+    }
+    HostSim_Run(100u);
+
+    rx_ctr     = 0u;
+    ts_last_us = 0u;
+    p_pkt      = HostSim_SockRx(p_sock_rx);
+    while (p_pkt != DEF_NULL) {
+        rx_ctr++;
+        ts_last_us = p_pkt->TS_Deliver_us;
+        free(p_pkt);
+        p_pkt = HostSim_SockRx(p_sock_rx);
+    }
+    HostSim_StatsGet(&sim_stats);
+                                                                /* 1 on the link, 2 queued, 7 dropped.                  */
+    HOST_TEST_CHK(rx_ctr                    == 3u);
+    HOST_TEST_CHK(sim_stats.PktQueueDropCtr == 7u);
+    HOST_TEST_CHK(ts_last_us - ts_start_us  == 3u * TEST_RATE_PKT_TX_us);
+
+    HostSim_SockClose(p_sock_tx);
+    HostSim_SockClose(p_sock_rx);
+    Test_SimStop();
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Stray()
+*
+* Description : (a) A DATA blk from a second server session is answered with an ERROR 'Unknown transfer
+*                   ID', or dropped by a connected socket (see Note #5), & the transfer goes on.
+*
+*               (b) With no server, a stray pkt every TEST_STRAY_PERIOD_ms does NOT restart the RX
+*                   timeout : the get fails after its RX timeouts, as without strays.
+*********************************************************************************************************
+*/
+
+static  void  Test_Stray (void)
+{
+    TEST_STRAY     stray;
+    TFTPc_STATS    stats;
+    HOST_SIM_PKT  *p_pkt;
+    CPU_INT32U     err_ctr;
+    CPU_INT64U     ts_start_us;
+    CPU_INT64U     dur_us;
+    CPU_BOOLEAN    ok;
+    TFTPc_ERR      err;
+
+                                                                /* ------------ (a) SECOND SERVER SESSION ------------- */
+    HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirSrv, "stray.bin"), 4096u, 19u) == DEF_OK);
+
+    Test_SimStart(TEST_SRV_TIMEOUT_ms);
+    Mem_Clr(&stray, sizeof(stray));
+    stray.SockPtr = HostSim_SockOpen();
+    HOST_TEST_REQ(stray.SockPtr != DEF_NULL);
+    HOST_TEST_REQ(HostSim_SockBind(stray.SockPtr, HOST_SIM_ADDR_SRV, TEST_STRAY_PORT) == DEF_OK);
+    HostSim_FilterSet(Test_StrayFilter, &stray);
+    HOST_TEST_REQ(HostSim_TmrAdd(Test_StrayTmr, &stray) == DEF_OK);
+
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "stray.bin"), "stray.bin", TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "stray.bin"),
+                                   HostTest_Path(Test_DirLocal, "stray.bin")) == DEF_YES);
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(stray.TxCtr         == 1u);
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)                     /* Stray dropped by the sock layer (see Note #5).       */
+    HOST_TEST_CHK(stats.RxStrayPktCtr == 0u);
+#else
+    HOST_TEST_CHK(stats.RxStrayPktCtr == 1u);
+#endif
+
+    HostSim_Run(10u);
+    err_ctr = 0u;
+    p_pkt   = HostSim_SockRx(stray.SockPtr);
+    while (p_pkt != DEF_NULL) {
+        if ((p_pkt->Len                               >= 4u) &&
+            (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) == 5u) &&
+            (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) == 5u)) {
+            err_ctr++;
+        }
+        free(p_pkt);
+        p_pkt = HostSim_SockRx(stray.SockPtr);
+    }
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)
+    HOST_TEST_CHK(err_ctr == 0u);
+#else
+    HOST_TEST_CHK(err_ctr == 1u);
+#endif
+
+    HostSim_TmrRemove(Test_StrayTmr, &stray);
+    HostSim_SockClose(stray.SockPtr);
+    Test_SimStop();
+                                                                /* ----------------- (b) STRAY FLOW ------------------ */
+    HostSim_Init(HOST_SIM_TS_START_ms);
+   (void)HostSim_HostAdd(TEST_SRV_HOST_NAME, HOST_SIM_ADDR_SRV);
+    Mem_Clr(&stray, sizeof(stray));
+    stray.Periodic = DEF_YES;
+    stray.SockPtr  = HostSim_SockOpen();
+    HOST_TEST_REQ(stray.SockPtr != DEF_NULL);
+    HOST_TEST_REQ(HostSim_SockBind(stray.SockPtr, HOST_SIM_ADDR_SRV + 1u, TEST_STRAY_PORT) == DEF_OK);
+    HostSim_FilterSet(Test_StrayFilter, &stray);
+    HOST_TEST_REQ(HostSim_TmrAdd(Test_StrayTmr, &stray) == DEF_OK);
+
+    ts_start_us = HostSim_TimeGet_us();
+    ok          = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, "none.bin"), "none.bin", TFTPc_MODE_OCTET, &err);
+    dur_us      = HostSim_TimeGet_us() - ts_start_us;
+   (void)TFTPc_StatsGet(&stats, &err);
+    HOST_TEST_CHK(ok                  == DEF_FAIL);
+    HOST_TEST_CHK(stats.RxTimeoutCtr  >  0u);
+    HOST_TEST_CHK(stats.RxStrayPktCtr >  0u);
+    dur_us     -= Test_StartDlyGet_us(ts_start_us, &stats);
+    HOST_TEST_CHK(dur_us              <= (CPU_INT64U)stats.RxTimeoutCtr * Test_Cfg.RxInactivityTimeout_ms * 1000u +
+                                         Test_BackoffMax_us(stats.TxRetryCtr) + 1000u);
+
+    HostSim_TmrRemove(Test_StrayTmr, &stray);
+    HostSim_SockClose(stray.SockPtr);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = TEST_SRV_HOST_NAME;
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_GetPut);
+        HOST_TEST_RUN(Test_Loss);
+        HOST_TEST_RUN(Test_Determinism);
+        HOST_TEST_RUN(Test_Impair);
+        HOST_TEST_RUN(Test_RateLimit);
+        HOST_TEST_RUN(Test_Stray);
+    }
+
+    return (HostTest_End());
+}
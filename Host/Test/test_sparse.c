@@ -0,0 +1,258 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : SPARSE WRITE TEST
+*
+* Filename : test_sparse.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Gets images holding runs of zero blocks on the simulated network & compares each local file
+*                with the server file.  The test is built twice :
+*
+*                (a) 'test_sparse'     against 'tftpc_sparse' (TFTPc_CFG_SPARSE_EN enabled) : the zero
+*                                      blocks are NOT written.
+*
+*                (b) 'test_sparse_off' against 'tftpc' (sparse writes disabled) : every block is written.
+*
+*                Both builds MUST produce images identical to the server files, so identical to each other.
+*
+*            (2) Each image overwrites a longer local file of pseudo-random content : the holes MUST NOT read
+*                its former content.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdio.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_BLK_SIZE                                   512u
+
+#define  TEST_IMAGE_LEN_MAX                            16384u
+#define  TEST_LOCAL_LEN           (TEST_IMAGE_LEN_MAX + 1000u)  /* Len of the local file overwritten (see Note #2).     */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  test_image {
+    const  CPU_CHAR    *NamePtr;
+           CPU_INT32U   Len;
+           CPU_INT32U   ZeroStart;                              /* 1st zero octet.                                      */
+           CPU_INT32U   ZeroEnd;                                /* Octet after the last zero octet.                     */
+} TEST_IMAGE;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR    *Test_DirSrv;
+static  CPU_CHAR    *Test_DirLocal;
+static  TFTPc_CFG    Test_Cfg;
+
+static  CPU_INT08U   Test_ImageBuf[TEST_IMAGE_LEN_MAX];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_ImageWr()
+*
+* Description : Write the server file of an image : pseudo-random content, zeroed over its zero range.
+*
+* Return(s)   : Number of octets of the image in zero blocks, i.e. NOT written with sparse writes.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_ImageWr (const  TEST_IMAGE  *p_image)
+{
+    FILE        *p_file;
+    CPU_INT32U   pos;
+    CPU_INT32U   len;
+    CPU_INT32U   ix;
+    CPU_INT32U   zero_len;
+    CPU_BOOLEAN  zero;
+
+
+    if (HostTest_FileWr(HostTest_Path(Test_DirSrv, p_image->NamePtr), p_image->Len, p_image->Len) != DEF_OK) {
+        return (0u);
+    }
+
+    p_file = fopen(HostTest_Path(Test_DirSrv, p_image->NamePtr), "r+b");
+    if (p_file == DEF_NULL) {
+        return (0u);
+    }
+    len = (CPU_INT32U)fread(Test_ImageBuf, 1u, sizeof(Test_ImageBuf), p_file);
+    Mem_Clr(&Test_ImageBuf[p_image->ZeroStart], p_image->ZeroEnd - p_image->ZeroStart);
+    fseek(p_file, 0, SEEK_SET);
+   (void)fwrite(Test_ImageBuf, 1u, len, p_file);
+    fclose(p_file);
+
+    zero_len = 0u;
+    for (pos = 0u; pos < len; pos += TEST_BLK_SIZE) {           /* Count the octets of the zero blks.                   */
+        zero = DEF_YES;
+        for (ix = pos; (ix < pos + TEST_BLK_SIZE) && (ix < len); ix++) {
+            if (Test_ImageBuf[ix] != 0u) {
+                zero = DEF_NO;
+            }
+        }
+        if (zero == DEF_YES) {
+            zero_len += DEF_MIN(TEST_BLK_SIZE, len - pos);
+        }
+    }
+
+    return (zero_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Images()
+*
+* Description : Get images with zero blocks at their start, middle & end, over a longer local file (see
+*               Note #2) : each local file is identical to the server file, & the zero blocks are only
+*               written with sparse writes disabled (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Test_Images (void)
+{
+    static  const  TEST_IMAGE  image_tbl[] = {
+        { "mid.bin",        6000u,  1024u,  4096u },            /* Zero blks 3..8.                                      */
+        { "unaligned.bin",  6000u,   700u,  3000u },            /* Partly zero blks 2 & 6.                              */
+        { "start.bin",      5000u,     0u,  2048u },
+        { "end.bin",        5000u,  1024u,  5000u },            /* Ends with a short zero blk.                          */
+        { "end_full.bin",   4096u,  2048u,  4096u },            /* Ends with zero blks, then an empty blk.              */
+        { "zero.bin",       3000u,     0u,  3000u },
+        { "none.bin",       3000u,     0u,     0u },
+    };
+    HOST_SRV_CFG   srv_cfg;
+    HOST_SIM_SRV  *p_srv;
+    TFTPc_STATS    stats;
+    CPU_INT32U     zero_len;
+    CPU_INT32U     ix;
+    CPU_BOOLEAN    ok;
+    TFTPc_ERR      err;
+
+
+    for (ix = 0u; ix < sizeof(image_tbl) / sizeof(image_tbl[0]); ix++) {
+        zero_len = Test_ImageWr(&image_tbl[ix]);
+        HOST_TEST_REQ(HostTest_FileWr(HostTest_Path(Test_DirLocal, image_tbl[ix].NamePtr),
+                                      TEST_LOCAL_LEN,
+                                      45u) == DEF_OK);
+
+        HostSim_Init(HOST_SIM_TS_START_ms);
+        HostSim_LinkDlySet(500u);
+        Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+        srv_cfg.RootDirPtr = Test_DirSrv;
+        srv_cfg.Timeout_ms = 1000u;
+        srv_cfg.RetryMax   = 5u;
+        p_srv              = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+        HOST_TEST_REQ(p_srv != DEF_NULL);
+
+        ok = TFTPc_Get(&Test_Cfg,
+                        HostTest_Path(Test_DirLocal, image_tbl[ix].NamePtr),
+                       (CPU_CHAR *)image_tbl[ix].NamePtr,
+                        TFTPc_MODE_OCTET,
+                       &err);
+        HostSimSrv_Stop(p_srv);
+
+        HOST_TEST_CHK(ok == DEF_OK);
+        HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   image_tbl[ix].NamePtr),
+                                       HostTest_Path(Test_DirLocal, image_tbl[ix].NamePtr)) == DEF_YES);
+
+       (void)TFTPc_StatsGet(&stats, &err);
+        HOST_TEST_CHK(stats.DataOctetCtr   == image_tbl[ix].Len);
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+        HOST_TEST_CHK(stats.SparseOctetCtr == zero_len);
+#else
+       (void)zero_len;
+        HOST_TEST_CHK(stats.SparseOctetCtr == 0u);
+#endif
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Images);
+    }
+
+    return (HostTest_End());
+}
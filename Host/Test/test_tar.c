@@ -0,0 +1,410 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : ARCHIVE EXTRACTION TEST
+*
+* Filename : test_tar.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with archive extraction on the simulated network.  The ustar archives are
+*                built by the test, from files of pseudo-random content, & served by the test server.
+*
+*            (2) Each archive is extracted to a scratch directory of its own, so that a file written outside
+*                of it (see Test_DotDot()) lands in the parent directory of the scratch directories.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdio.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_TAR_BLK_SIZE                               512u
+#define  TEST_TAR_LEN_MAX                              16384u
+
+#define  TEST_TAR_TYPE_FILE                              '0'
+#define  TEST_TAR_TYPE_DIR                               '5'
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  test_tar {
+    CPU_INT08U  Buf[TEST_TAR_LEN_MAX];
+    CPU_INT32U  Len;
+} TEST_TAR;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR  *Test_DirSrv;
+static  CPU_CHAR  *Test_DirSrc;                                 /* Files archived.                                      */
+static  TFTPc_CFG  Test_Cfg;
+
+static  TEST_TAR   Test_Tar;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_TarEntryAdd()
+*
+* Description : Append an entry to the archive : a ustar header, then the content of the file 'p_src' of
+*               the source directory, padded to a whole number of blocks.
+*
+* Argument(s) : p_tar       Pointer to archive.
+*
+*               p_name      Entry name.
+*
+*               type        Entry type.
+*
+*               p_src       Name of the source file, DEF_NULL for an entry without data.
+*
+* Return(s)   : Offset of the entry header in the archive.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_TarEntryAdd (       TEST_TAR    *p_tar,
+                                      const  CPU_CHAR    *p_name,
+                                             CPU_CHAR     type,
+                                      const  CPU_CHAR    *p_src)
+{
+    CPU_INT08U  *p_hdr;
+    FILE        *p_file;
+    CPU_INT32U   hdr_ix;
+    CPU_INT32U   size;
+    CPU_INT32U   chksum;
+    CPU_INT32U   ix;
+
+
+    hdr_ix = p_tar->Len;
+    p_hdr  = &p_tar->Buf[hdr_ix];
+    Mem_Clr(p_hdr, TEST_TAR_BLK_SIZE);
+    p_tar->Len += TEST_TAR_BLK_SIZE;
+
+    size = 0u;
+    if (p_src != DEF_NULL) {
+        p_file = fopen(HostTest_Path(Test_DirSrc, p_src), "rb");
+        if (p_file != DEF_NULL) {
+            size = (CPU_INT32U)fread(&p_tar->Buf[p_tar->Len], 1u, sizeof(p_tar->Buf) - p_tar->Len, p_file);
+            fclose(p_file);
+        }
+        Mem_Clr(&p_tar->Buf[p_tar->Len + size], (TEST_TAR_BLK_SIZE - size % TEST_TAR_BLK_SIZE) % TEST_TAR_BLK_SIZE);
+        p_tar->Len += (size + TEST_TAR_BLK_SIZE - 1u) / TEST_TAR_BLK_SIZE * TEST_TAR_BLK_SIZE;
+    }
+
+    Str_Copy_N((CPU_CHAR *)&p_hdr[0], p_name, 100u);            /* Name.                                                */
+    snprintf((char *)&p_hdr[100], 8u,  "%07o",  0644u);         /* Mode.                                                */
+    snprintf((char *)&p_hdr[124], 12u, "%011o", (unsigned)size);
+    p_hdr[156] = (CPU_INT08U)type;
+    Mem_Copy(&p_hdr[257], "ustar", 6u);                         /* Magic & version.                                     */
+    Mem_Copy(&p_hdr[263], "00", 2u);
+
+    chksum = 0u;                                                /* Chksum field taken as spaces.                        */
+    Mem_Set(&p_hdr[148], ' ', 8u);
+    for (ix = 0u; ix < TEST_TAR_BLK_SIZE; ix++) {
+        chksum += p_hdr[ix];
+    }
+    snprintf((char *)&p_hdr[148], 8u, "%06o", (unsigned)chksum);
+
+    return (hdr_ix);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_TarWr()
+*
+* Description : Terminate the archive with the two end-of-archive blocks & write it to the server directory.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_TarWr (       TEST_TAR  *p_tar,
+                                 const  CPU_CHAR  *p_name)
+{
+    FILE        *p_file;
+    CPU_SIZE_T   len;
+
+
+    Mem_Clr(&p_tar->Buf[p_tar->Len], 2u * TEST_TAR_BLK_SIZE);
+    p_tar->Len += 2u * TEST_TAR_BLK_SIZE;
+
+    p_file = fopen(HostTest_Path(Test_DirSrv, p_name), "wb");
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+    len = fwrite(p_tar->Buf, 1u, p_tar->Len, p_file);
+    fclose(p_file);
+
+    return ((len == p_tar->Len) ? DEF_OK : DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Get()
+*
+* Description : Reset the simulation & extract the archive 'p_name' of the server to the directory 'p_dir'.
+*********************************************************************************************************
+*/
+
+static  void  Test_Get (const  CPU_CHAR     *p_name,
+                               CPU_CHAR     *p_dir,
+                               CPU_BOOLEAN  *p_ok,
+                               TFTPc_ERR    *p_err)
+{
+    HOST_SRV_CFG   srv_cfg;
+    HOST_SIM_SRV  *p_srv;
+
+
+    *p_ok = DEF_FAIL;
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    p_srv              = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+
+    *p_ok = TFTPc_Get(&Test_Cfg, p_dir, (CPU_CHAR *)p_name, TFTPc_MODE_OCTET | TFTPc_MODE_FLAG_TAR, p_err);
+
+    HostSimSrv_Stop(p_srv);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_FileExists()
+*
+* Description : Indicate whether a file exists.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_FileExists (const  CPU_CHAR  *p_path)
+{
+    FILE  *p_file;
+
+
+    p_file = fopen(p_path, "rb");
+    if (p_file == DEF_NULL) {
+        return (DEF_NO);
+    }
+    fclose(p_file);
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Extract()
+*
+* Description : Extract an archive holding a directory, files of several sizes, an empty file & an absolute
+*               name : each file is extracted below the local directory, with its content.
+*********************************************************************************************************
+*/
+
+static  void  Test_Extract (void)
+{
+    CPU_CHAR     *p_dir;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    Test_Tar.Len = 0u;
+   (void)Test_TarEntryAdd(&Test_Tar, "d/",         TEST_TAR_TYPE_DIR,  DEF_NULL);
+   (void)Test_TarEntryAdd(&Test_Tar, "d/a.bin",    TEST_TAR_TYPE_FILE, "a.bin");
+   (void)Test_TarEntryAdd(&Test_Tar, "./b.bin",    TEST_TAR_TYPE_FILE, "b.bin");
+   (void)Test_TarEntryAdd(&Test_Tar, "empty.bin",  TEST_TAR_TYPE_FILE, "empty.bin");
+   (void)Test_TarEntryAdd(&Test_Tar, "/c.bin",     TEST_TAR_TYPE_FILE, "c.bin");
+    HOST_TEST_REQ(Test_TarWr(&Test_Tar, "ok.tar") == DEF_OK);
+
+    p_dir = HostTest_DirCreate();
+    HOST_TEST_REQ(p_dir != DEF_NULL);
+
+    Test_Get("ok.tar", p_dir, &ok, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrc, "a.bin"),
+                                   HostTest_Path(p_dir,       "d/a.bin"))   == DEF_YES);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrc, "b.bin"),
+                                   HostTest_Path(p_dir,       "b.bin"))     == DEF_YES);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrc, "empty.bin"),
+                                   HostTest_Path(p_dir,       "empty.bin")) == DEF_YES);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrc, "c.bin"),
+                                   HostTest_Path(p_dir,       "c.bin"))     == DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_DotDot()
+*
+* Description : An entry name with a ".." component fails the transfer with TFTPc_ERR_TAR & NO file is
+*               written outside of the local directory (see Note #2).  The entries before it are kept.
+*********************************************************************************************************
+*/
+
+static  void  Test_DotDot (void)
+{
+    static  const  CPU_CHAR  *name_tbl[] = {
+        "../evil.bin",
+        "d/../../evil.bin",
+        "./d/./../..//evil.bin",
+    };
+    CPU_CHAR     *p_dir;
+    CPU_INT32U    ix;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    for (ix = 0u; ix < sizeof(name_tbl) / sizeof(name_tbl[0]); ix++) {
+        Test_Tar.Len = 0u;
+       (void)Test_TarEntryAdd(&Test_Tar, "a.bin",       TEST_TAR_TYPE_FILE, "a.bin");
+       (void)Test_TarEntryAdd(&Test_Tar, name_tbl[ix],  TEST_TAR_TYPE_FILE, "b.bin");
+        HOST_TEST_REQ(Test_TarWr(&Test_Tar, "dotdot.tar") == DEF_OK);
+
+        p_dir = HostTest_DirCreate();
+        HOST_TEST_REQ(p_dir != DEF_NULL);
+       (void)remove(HostTest_Path(p_dir, "../evil.bin"));
+
+        Test_Get("dotdot.tar", p_dir, &ok, &err);
+        HOST_TEST_CHK(ok  == DEF_FAIL);
+        HOST_TEST_CHK(err == TFTPc_ERR_TAR);
+        HOST_TEST_CHK(Test_FileExists(HostTest_Path(p_dir, "../evil.bin")) == DEF_NO);
+        HOST_TEST_CHK(Test_FileExists(HostTest_Path(p_dir, "evil.bin"))    == DEF_NO);
+        HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrc, "a.bin"),
+                                       HostTest_Path(p_dir,       "a.bin")) == DEF_YES);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Chksum()
+*
+* Description : A header with an invalid checksum fails the transfer with TFTPc_ERR_TAR : its entry is NOT
+*               extracted, the entries before it are kept.
+*********************************************************************************************************
+*/
+
+static  void  Test_Chksum (void)
+{
+    CPU_CHAR     *p_dir;
+    CPU_INT32U    hdr_ix;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    Test_Tar.Len = 0u;
+   (void)Test_TarEntryAdd(&Test_Tar, "a.bin", TEST_TAR_TYPE_FILE, "a.bin");
+    hdr_ix = Test_TarEntryAdd(&Test_Tar, "b.bin", TEST_TAR_TYPE_FILE, "b.bin");
+    Test_Tar.Buf[hdr_ix + 1u] ^= 0x01u;                         /* Corrupt the name, NOT the chksum.                    */
+    HOST_TEST_REQ(Test_TarWr(&Test_Tar, "chksum.tar") == DEF_OK);
+
+    p_dir = HostTest_DirCreate();
+    HOST_TEST_REQ(p_dir != DEF_NULL);
+
+    Test_Get("chksum.tar", p_dir, &ok, &err);
+    HOST_TEST_CHK(ok  == DEF_FAIL);
+    HOST_TEST_CHK(err == TFTPc_ERR_TAR);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrc, "a.bin"),
+                                   HostTest_Path(p_dir,       "a.bin")) == DEF_YES);
+    HOST_TEST_CHK(Test_FileExists(HostTest_Path(p_dir, "b.bin")) == DEF_NO);
+    HOST_TEST_CHK(Test_FileExists(HostTest_Path(p_dir, "c.bin")) == DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv = HostTest_DirCreate();
+    Test_DirSrc = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirSrc != DEF_NULL));
+
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrc, "a.bin"),      700u, 441u) == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrc, "b.bin"),     1536u, 442u) == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrc, "c.bin"),     3000u, 443u) == DEF_OK);
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrc, "empty.bin"),    0u, 444u) == DEF_OK);
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Extract);
+        HOST_TEST_RUN(Test_DotDot);
+        HOST_TEST_RUN(Test_Chksum);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,384 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      HOST PORT : TRACE RING TEST
+*
+* Filename : test_trace.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with the trace ring on the simulated network against the test server,
+*                & checks the events dumped by TFTPc_TraceDump() & their text from TFTPc_TraceDecode().
+*
+*            (2) The ring is built with few events (see 'CMakeLists.txt  tftpc_trace'), so that a transfer
+*                of a few blocks wraps it.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_RING_NBR_EVENT           TFTPc_CFG_TRACE_RING_NBR_EVENT
+
+#define  TEST_OPCODE_DATA                                  3u
+#define  TEST_OPCODE_RRQ                                   1u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR           *Test_DirSrv;
+static  CPU_CHAR           *Test_DirLocal;
+static  HOST_SIM_SRV       *Test_SrvPtr;
+static  TFTPc_CFG           Test_Cfg;
+
+static  CPU_INT32U          Test_LossBlkNbr;                    /* DATA blk to drop once, 0 for none.                   */
+
+static  TFTPc_TRACE_EVENT   Test_Events[TEST_RING_NBR_EVENT * 2u];
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         Test_LossFilter()
+*
+* Description : Simulation filter : drop DATA block Test_LossBlkNbr once.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_LossFilter (       void          *p_arg,
+                                      const  HOST_SIM_PKT  *p_pkt)
+{
+   (void)p_arg;
+
+    if ((Test_LossBlkNbr                          == 0u)               ||
+        (p_pkt->Len                               <  4u)               ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]) != TEST_OPCODE_DATA) ||
+        (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) != Test_LossBlkNbr)) {
+        return (DEF_YES);
+    }
+
+    Test_LossBlkNbr = 0u;
+
+    return (DEF_NO);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Get()
+*
+* Description : Reset the simulation, get a file of 'size' octets with the trace ring cleared & 'mask' set,
+*               & dump the ring into Test_Events[].
+*
+* Return(s)   : Number of events dumped.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Test_Get (const  CPU_CHAR    *p_name,
+                                     CPU_INT32U   size,
+                                     CPU_INT08U   mask,
+                                     CPU_INT32U   loss_blk_nbr)
+{
+    HOST_SRV_CFG  srv_cfg;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(500u);
+    Test_LossBlkNbr = loss_blk_nbr;
+    HostSim_FilterSet(Test_LossFilter, DEF_NULL);
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 12000u;                                /* Client re-ACKs before the server re-tx's.            */
+    srv_cfg.RetryMax   = 5u;
+    Test_SrvPtr        = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_CHK(Test_SrvPtr != DEF_NULL);
+
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrv, p_name), size, size + 1u) == DEF_OK);
+
+    TFTPc_TraceClr();
+    TFTPc_TraceMaskSet(mask);
+    ok = TFTPc_Get(&Test_Cfg, HostTest_Path(Test_DirLocal, p_name), (CPU_CHAR *)p_name, TFTPc_MODE_OCTET, &err);
+    HOST_TEST_CHK(ok  == DEF_OK);
+    HOST_TEST_CHK(err == TFTPc_ERR_NONE);
+
+    HostSimSrv_Stop(Test_SrvPtr);
+
+    return (TFTPc_TraceDump(&Test_Events[0], sizeof(Test_Events) / sizeof(Test_Events[0])));
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_EventChk()
+*
+* Description : Check the ID & arguments of an event.
+*********************************************************************************************************
+*/
+
+static  void  Test_EventChk (const  TFTPc_TRACE_EVENT  *p_event,
+                                    CPU_INT08U          event_id,
+                                    CPU_INT32U          arg0,
+                                    CPU_INT32U          arg1)
+{
+    HOST_TEST_CHK(p_event->EventID == event_id);
+    HOST_TEST_CHK(p_event->Arg0    == arg0);
+    HOST_TEST_CHK(p_event->Arg1    == arg1);
+    if (p_event->EventID != event_id) {
+        printf("  event %u : %s, expected %s\n", (unsigned)p_event->SeqNbr,
+               TFTPc_TraceEventNameGet(p_event->EventID), TFTPc_TraceEventNameGet(event_id));
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Session()
+*
+* Description : Get a 3-block file with every level recorded : one event per step of the session, with
+*               consecutive sequence numbers from 1.
+*********************************************************************************************************
+*/
+
+static  void  Test_Session (void)
+{
+    TFTPc_TRACE_EVENT  *p_event;
+    CPU_INT16U          nbr_events;
+    CPU_INT16U          ix;
+
+
+    nbr_events = Test_Get("session.bin", 1100u, TFTPc_TRACE_LVL_ALL, 0u);
+    HOST_TEST_REQ(nbr_events == 9u);
+
+    for (ix = 0u; ix < nbr_events; ix++) {
+        p_event = &Test_Events[ix];
+        HOST_TEST_CHK(p_event->SeqNbr    == ix + 1u);
+        HOST_TEST_CHK(p_event->SessionID == Test_Events[0].SessionID);
+    }
+    HOST_TEST_CHK(Test_Events[0].SessionID != 0u);
+
+    Test_EventChk(&Test_Events[0], TFTPc_TRACE_EVENT_SESSION_START, TEST_OPCODE_RRQ, TFTPc_MODE_OCTET);
+    HOST_TEST_CHK(Test_Events[1].EventID   == TFTPc_TRACE_EVENT_REQ_TX);
+    HOST_TEST_CHK(Test_Events[1].Arg0      == TEST_OPCODE_RRQ);
+    Test_EventChk(&Test_Events[2], TFTPc_TRACE_EVENT_DATA_RX, 1u, 512u);
+    Test_EventChk(&Test_Events[3], TFTPc_TRACE_EVENT_ACK_TX,  1u,   0u);
+    Test_EventChk(&Test_Events[4], TFTPc_TRACE_EVENT_DATA_RX, 2u, 512u);
+    Test_EventChk(&Test_Events[5], TFTPc_TRACE_EVENT_ACK_TX,  2u,   0u);
+    Test_EventChk(&Test_Events[6], TFTPc_TRACE_EVENT_DATA_RX, 3u,  76u);
+    Test_EventChk(&Test_Events[7], TFTPc_TRACE_EVENT_ACK_TX,  3u,   0u);
+    HOST_TEST_CHK(Test_Events[8].EventID   == TFTPc_TRACE_EVENT_SESSION_END);
+    HOST_TEST_CHK(Test_Events[8].Arg0      == TFTPc_ERR_NONE);
+
+    for (ix = 1u; ix < nbr_events; ix++) {                      /* Timestamps never go back.                            */
+        HOST_TEST_CHK((CPU_INT32S)(Test_Events[ix].TS - Test_Events[ix - 1u].TS) >= 0);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Decode()
+*
+* Description : Decode the events of a session : "<seq> <ts> S<session> <event name> <arg0> <arg1>".
+*********************************************************************************************************
+*/
+
+static  void  Test_Decode (void)
+{
+    TFTPc_TRACE_EVENT   event;
+    CPU_CHAR            str[TFTPc_TRACE_DECODE_STR_LEN_MAX];
+    CPU_CHAR            str_exp[TFTPc_TRACE_DECODE_STR_LEN_MAX];
+    CPU_CHAR           *p_str;
+    CPU_INT16U          nbr_events;
+
+
+    nbr_events = Test_Get("decode.bin", 1100u, TFTPc_TRACE_LVL_ALL, 0u);
+    HOST_TEST_REQ(nbr_events == 9u);
+
+    p_str = TFTPc_TraceDecode(&Test_Events[4], str, sizeof(str));
+    HOST_TEST_REQ(p_str == &str[0]);
+    snprintf(str_exp, sizeof(str_exp), "%10u %10u S%05u DATA_RX 2 512",
+             (unsigned)Test_Events[4].SeqNbr, (unsigned)Test_Events[4].TS, (unsigned)Test_Events[4].SessionID);
+    HOST_TEST_CHK(strcmp(str, str_exp) == 0);
+    if (strcmp(str, str_exp) != 0) {
+        printf("  decoded '%s'\n  expected '%s'\n", str, str_exp);
+    }
+
+    p_str = TFTPc_TraceDecode(&Test_Events[7], str, sizeof(str));
+    HOST_TEST_REQ(p_str != DEF_NULL);
+    HOST_TEST_CHK(strstr(str, " ACK_TX 3 0") != DEF_NULL);
+                                                                /* Truncated to the buffer.                             */
+    p_str = TFTPc_TraceDecode(&Test_Events[4], str, 12u);
+    HOST_TEST_REQ(p_str != DEF_NULL);
+    HOST_TEST_CHK(strlen(str) == 11u);
+    HOST_TEST_CHK(strncmp(str, str_exp, 11u) == 0);
+                                                                /* Unknown event ID.                                    */
+    event         = Test_Events[4];
+    event.EventID = TFTPc_TRACE_EVENT_NBR_MAX;
+    p_str = TFTPc_TraceDecode(&event, str, sizeof(str));
+    HOST_TEST_REQ(p_str != DEF_NULL);
+    HOST_TEST_CHK(strstr(str, " UNKNOWN 2 512") != DEF_NULL);
+
+    HOST_TEST_CHK(TFTPc_TraceDecode(DEF_NULL, str, sizeof(str)) == DEF_NULL);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Test_Wrap()
+*
+* Description : Get a file of more blocks than the ring holds, with packet events only : the dump holds the
+*               last TEST_RING_NBR_EVENT events, oldest first, & a smaller buffer the most recent ones.
+*********************************************************************************************************
+*/
+
+static  void  Test_Wrap (void)
+{
+    TFTPc_TRACE_EVENT  *p_event;
+    CPU_INT16U          nbr_events;
+    CPU_INT32U          seq_nbr_last;
+    CPU_INT32U          blk_nbr;
+    CPU_INT16U          ix;
+
+                                                                /* 20 DATA rx'd & 20 ACK tx'd.                          */
+    nbr_events = Test_Get("wrap.bin", 20u * 512u - 1u, TFTPc_TRACE_LVL_PKT, 0u);
+    HOST_TEST_REQ(nbr_events == TEST_RING_NBR_EVENT);
+
+    seq_nbr_last = 40u;
+    for (ix = 0u; ix < nbr_events; ix++) {
+        p_event = &Test_Events[ix];
+        blk_nbr = 20u - (TEST_RING_NBR_EVENT - 1u - ix) / 2u;
+        HOST_TEST_CHK(p_event->SeqNbr == seq_nbr_last - TEST_RING_NBR_EVENT + 1u + ix);
+        HOST_TEST_CHK(p_event->Lvl    == TFTPc_TRACE_LVL_PKT);
+        HOST_TEST_CHK(p_event->Arg0   == blk_nbr);
+        HOST_TEST_CHK(p_event->EventID == (((ix % 2u) == 0u) ? TFTPc_TRACE_EVENT_DATA_RX : TFTPc_TRACE_EVENT_ACK_TX));
+    }
+                                                                /* Smaller buffer : most recent events.                 */
+    nbr_events = TFTPc_TraceDump(&Test_Events[0], 3u);
+    HOST_TEST_REQ(nbr_events == 3u);
+    HOST_TEST_CHK(Test_Events[0].SeqNbr  == seq_nbr_last - 2u);
+    HOST_TEST_CHK(Test_Events[2].SeqNbr  == seq_nbr_last);
+    Test_EventChk(&Test_Events[2], TFTPc_TRACE_EVENT_ACK_TX, 20u, 0u);
+
+    HOST_TEST_CHK(TFTPc_TraceDump(DEF_NULL, 3u) == 0u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Mask()
+*
+* Description : (a) Get a file with no level recorded : the ring stays empty.
+*
+*               (b) Drop a DATA block with the retry level only : the client's RX timeouts & re-tx's of the
+*                   last ACK are the only events, with the retry count & the ACK length.
+*********************************************************************************************************
+*/
+
+static  void  Test_Mask (void)
+{
+    CPU_INT16U  nbr_events;
+
+                                                                /* ------------------- (a) NO LEVEL ------------------- */
+    nbr_events = Test_Get("mask_none.bin", 2000u, TFTPc_TRACE_LVL_NONE, 0u);
+    HOST_TEST_CHK(nbr_events == 0u);
+    HOST_TEST_CHK(TFTPc_TraceMaskGet() == TFTPc_TRACE_LVL_NONE);
+                                                                /* ------------------ (b) RETRY LEVEL ----------------- */
+    nbr_events = Test_Get("mask_retry.bin", 2000u, TFTPc_TRACE_LVL_RETRY, 3u);
+    HOST_TEST_REQ(nbr_events == 4u);                            /* Server re-tx's after 2 client RX timeouts.           */
+    Test_EventChk(&Test_Events[0], TFTPc_TRACE_EVENT_RX_TIMEOUT, 0u, 4u);
+    Test_EventChk(&Test_Events[1], TFTPc_TRACE_EVENT_RE_TX,      1u, 4u);
+    Test_EventChk(&Test_Events[2], TFTPc_TRACE_EVENT_RX_TIMEOUT, 1u, 4u);
+    Test_EventChk(&Test_Events[3], TFTPc_TRACE_EVENT_RE_TX,      2u, 4u);
+    HOST_TEST_CHK(Test_Events[0].Lvl    == TFTPc_TRACE_LVL_RETRY);
+    HOST_TEST_CHK(Test_Events[0].SeqNbr == 1u);
+    HOST_TEST_CHK(Test_Events[3].SeqNbr == 4u);
+
+    TFTPc_TraceMaskSet(TFTPc_CFG_TRACE_RING_LVL_DFLT);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {
+        HOST_TEST_RUN(Test_Session);
+        HOST_TEST_RUN(Test_Decode);
+        HOST_TEST_RUN(Test_Wrap);
+        HOST_TEST_RUN(Test_Mask);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,326 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*
+*                          HOST PORT : ADAPTIVE WINDOW & BACKGROUND TRANSFER TEST
+*
+* Filename : test_win_adapt.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Runs TFTPc built with windowed transfers, the adaptive window (initial window of 2 blocks,
+*                TFTPc_CFG_WIN_SIZE_MAX of 8) & background transfers on the simulated network.  The window
+*                is adapted once per transfer : each test checks the window size req'd by the next one.
+*
+*            (2) Each request is parsed on the way to the server : the window size requested is recorded.
+*
+*            (3) A rise of the queuing delay on the path is modelled by a timer that raises the link delay
+*                from 0.5 ms to TEST_LINK_DLY_RISE_us during the transfer.  The round-trip time rises by
+*                about 39 ms : above TFTPc_CFG_BG_DLY_TARGET_ms (25 ms), but below
+*                TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms (100 ms).
+*
+*            (4) The tests share the window adapted by the previous transfers, so MUST run in order.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  "../Sim/host_sim.h"
+#include  "../Srv/host_srv.h"
+#include  "host_test.h"
+
+#include  <stdlib.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TEST_SRV_PORT                                    69u
+
+#define  TEST_OPCODE_RRQ                                   1u
+#define  TEST_OPCODE_DATA                                  3u
+
+#define  TEST_LINK_DLY_us                                500u
+#define  TEST_LINK_DLY_RISE_us                         20000u   /* See Note #3.                                         */
+#define  TEST_LINK_DLY_RISE_AT_ms                          5u   /* Time of the rise, from the start of the transfer.    */
+
+#define  TEST_FILE_LEN                                100000u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_CHAR      *Test_DirSrv;
+static  CPU_CHAR      *Test_DirLocal;
+static  TFTPc_CFG      Test_Cfg;
+
+static  CPU_INT32U     Test_ReqWinSize;                         /* Window size of last RRQ, 0 if none (see Note #2).    */
+static  CPU_INT32U     Test_LossBlkNbr;                         /* DATA blk to drop once, 0 for none.                   */
+static  CPU_INT32U     Test_DlyRiseAt_ms;                       /* Time of the delay rise, 0 for none (see Note #3).    */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Test_PathFilter()
+*
+* Description : Simulation filter : record the window size of each request (see Note #2) & drop DATA block
+*               Test_LossBlkNbr once.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Test_PathFilter (       void          *p_arg,
+                                      const  HOST_SIM_PKT  *p_pkt)
+{
+    const  CPU_CHAR    *p_str;
+           CPU_INT32U   ix;
+           CPU_INT16U   opcode;
+
+
+   (void)p_arg;
+
+    if (p_pkt->Len < 4u) {
+        return (DEF_YES);
+    }
+
+    opcode = MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[0]);
+    if (opcode == TEST_OPCODE_DATA) {
+        if ((Test_LossBlkNbr                          == 0u) ||
+            (MEM_VAL_GET_INT16U_BIG(&p_pkt->Data[2]) != Test_LossBlkNbr)) {
+            return (DEF_YES);
+        }
+        Test_LossBlkNbr = 0u;
+        return (DEF_NO);
+    }
+    if (opcode != TEST_OPCODE_RRQ) {
+        return (DEF_YES);
+    }
+
+    Test_ReqWinSize = 0u;
+    ix              = 2u;
+    while (ix < p_pkt->Len) {                                   /* Scan the NUL-terminated strings for the option.      */
+        p_str = (const CPU_CHAR *)&p_pkt->Data[ix];
+        if ((strcmp(p_str, "windowsize") == 0) &&
+            (ix + sizeof("windowsize") < p_pkt->Len)) {
+            Test_ReqWinSize = (CPU_INT32U)atoi(p_str + sizeof("windowsize"));
+        }
+        ix += (CPU_INT32U)strlen(p_str) + 1u;
+    }
+
+    return (DEF_YES);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_DlyRiseTmr()
+*
+* Description : Simulation timer : raise the link delay at Test_DlyRiseAt_ms (see Note #3).
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Test_DlyRiseTmr (void        *p_arg,
+                                     CPU_INT32U   now_ms)
+{
+   (void)p_arg;
+
+    if ((Test_DlyRiseAt_ms != 0u) &&
+        (Test_DlyRiseAt_ms <= now_ms)) {
+        Test_DlyRiseAt_ms = 0u;
+        HostSim_LinkDlySet(TEST_LINK_DLY_RISE_us);
+    }
+
+    return (1u);
+}
+
+
+/*
+*********************************************************************************************************
+*                                            Test_Get()
+*
+* Description : Get the file from a new server & check the window size requested.
+*
+* Argument(s) : mode            Transfer mode.
+*
+*               loss_blk_nbr    DATA block to drop once, 0 for none.
+*
+*               dly_rise        Indicates whether the link delay rises during the transfer (see Note #3).
+*
+*               win_size_req    Window size expected in the request.
+*
+*               p_stats         Pointer to variable that will receive the stats of the transfer.
+*********************************************************************************************************
+*/
+
+static  void  Test_Get (TFTPc_MODE    mode,
+                        CPU_INT32U    loss_blk_nbr,
+                        CPU_BOOLEAN   dly_rise,
+                        CPU_INT32U    win_size_req,
+                        TFTPc_STATS  *p_stats)
+{
+    HOST_SRV_CFG   srv_cfg;
+    HOST_SIM_SRV  *p_srv;
+    CPU_BOOLEAN    ok;
+    TFTPc_ERR      err;
+
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    HostSim_LinkDlySet(TEST_LINK_DLY_us);
+    HostSim_FilterSet(Test_PathFilter, DEF_NULL);
+    Test_ReqWinSize   = 0u;
+    Test_LossBlkNbr   = loss_blk_nbr;
+    Test_DlyRiseAt_ms = 0u;
+    if (dly_rise == DEF_YES) {
+        Test_DlyRiseAt_ms = (CPU_INT32U)(HostSim_TimeGet_us() / 1000u) + TEST_LINK_DLY_RISE_AT_ms;
+    }
+
+    Mem_Clr(&srv_cfg, sizeof(srv_cfg));
+    srv_cfg.RootDirPtr = Test_DirSrv;
+    srv_cfg.Timeout_ms = 1000u;
+    srv_cfg.RetryMax   = 5u;
+    srv_cfg.OptEn      = DEF_YES;
+    srv_cfg.WinSizeMax = 16u;
+    p_srv              = HostSimSrv_Start(&srv_cfg, HOST_SIM_ADDR_SRV, TEST_SRV_PORT);
+    HOST_TEST_REQ(p_srv != DEF_NULL);
+    HOST_TEST_REQ(HostSim_TmrAdd(Test_DlyRiseTmr, DEF_NULL) == DEF_OK);
+
+    ok = TFTPc_Get(&Test_Cfg,
+                    HostTest_Path(Test_DirLocal, "win.bin"),
+                   "win.bin",
+                    mode,
+                   &err);
+    HostSim_Run(100u);                                          /* Deliver the last ACK.                                */
+    HostSim_TmrRemove(Test_DlyRiseTmr, DEF_NULL);
+    HostSimSrv_Stop(p_srv);
+
+    HOST_TEST_CHK(ok              == DEF_OK);
+    HOST_TEST_CHK(Test_ReqWinSize == win_size_req);
+    HOST_TEST_CHK(HostTest_FileCmp(HostTest_Path(Test_DirSrv,   "win.bin"),
+                                   HostTest_Path(Test_DirLocal, "win.bin")) == DEF_YES);
+
+   (void)TFTPc_StatsGet(p_stats, &err);
+    HOST_TEST_CHK(p_stats->WinSize == win_size_req);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Test_ShrinkGrow()
+*
+* Description : The window grows by one block after each transfer without loss, up to
+*               TFTPc_CFG_WIN_SIZE_MAX, & is halved after a transfer with a loss.
+*********************************************************************************************************
+*/
+
+static  void  Test_ShrinkGrow (void)
+{
+    TFTPc_STATS  stats;
+    CPU_INT32U   win_size;
+
+
+    Test_Get(TFTPc_MODE_OCTET, 0u, DEF_NO, 2u, &stats);         /* TFTPc_CFG_WIN_ADAPT_SIZE_INIT.                       */
+    Test_Get(TFTPc_MODE_OCTET, 0u, DEF_NO, 3u, &stats);
+    Test_Get(TFTPc_MODE_OCTET, 3u, DEF_NO, 4u, &stats);         /* Gap at blk 3 ...                                     */
+    HOST_TEST_CHK(stats.RxGapCtr > 0u);
+    Test_Get(TFTPc_MODE_OCTET, 0u, DEF_NO, 2u, &stats);         /* ... halves the window.                               */
+
+    for (win_size = 3u; win_size <= TFTPc_CFG_WIN_SIZE_MAX; win_size++) {
+        Test_Get(TFTPc_MODE_OCTET, 0u, DEF_NO, win_size, &stats);
+    }
+    Test_Get(TFTPc_MODE_OCTET, 0u, DEF_NO, TFTPc_CFG_WIN_SIZE_MAX, &stats);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Test_Background()
+*
+* Description : A rise of the queuing delay below TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms leaves a foreground
+*               transfer as is, but slows a background transfer & halves its window (see Note #3).
+*********************************************************************************************************
+*/
+
+static  void  Test_Background (void)
+{
+    TFTPc_STATS  stats_fg;
+    TFTPc_STATS  stats_bg;
+
+
+    Test_Get( TFTPc_MODE_OCTET,                       0u, DEF_YES, TFTPc_CFG_WIN_SIZE_MAX,      &stats_fg);
+    HOST_TEST_CHK(stats_fg.RTT_ms > TFTPc_CFG_BG_DLY_TARGET_ms);
+
+    Test_Get((TFTPc_MODE_OCTET | TFTPc_MODE_FLAG_BG), 0u, DEF_YES, TFTPc_CFG_WIN_SIZE_MAX,      &stats_bg);
+    HOST_TEST_CHK(stats_bg.Duration_ms > stats_fg.Duration_ms + TFTPc_CFG_BG_DLY_TARGET_ms);
+
+    Test_Get( TFTPc_MODE_OCTET,                       0u, DEF_NO,  TFTPc_CFG_WIN_SIZE_MAX / 2u, &stats_fg);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (void)
+{
+    TFTPc_ERR  err;
+
+
+    Test_DirSrv   = HostTest_DirCreate();
+    Test_DirLocal = HostTest_DirCreate();
+    HOST_TEST_CHK((Test_DirSrv != DEF_NULL) && (Test_DirLocal != DEF_NULL));
+    HOST_TEST_CHK(HostTest_FileWr(HostTest_Path(Test_DirSrv, "win.bin"), TEST_FILE_LEN, 50u) == DEF_OK);
+
+    Test_Cfg                   = TFTPc_Cfg;
+    Test_Cfg.ServerHostnamePtr = "10.0.0.2";
+    Test_Cfg.ServerPortNbr     = TEST_SRV_PORT;
+    HOST_TEST_CHK(TFTPc_Init(&Test_Cfg, &err) == DEF_OK);
+
+    if (HostTest_FailCtr == 0u) {                               /* See Note #4.                                         */
+        HOST_TEST_RUN(Test_ShrinkGrow);
+        HOST_TEST_RUN(Test_Background);
+    }
+
+    return (HostTest_End());
+}
@@ -0,0 +1,58 @@
+#!/bin/sh
+#########################################################################################################
+#                                              uC/TFTPc
+#                               Trivial File Transfer Protocol (client)
+#
+#                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+#
+#                                 SPDX-License-Identifier: APACHE-2.0
+#
+#               This software is subject to an open source license and is distributed by
+#                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+#                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+#
+#########################################################################################################
+#
+# Footprint report : prints the code & RAM size of the TFTPc objects built for each footprint profile
+# (see 'CMakeLists.txt  SIZE REPORT'), one CSV line per profile :
+#
+#     profile,text,data,bss
+#
+# Usage : size_report.sh size_tool --profile name obj... [--profile name obj...]...
+#
+#########################################################################################################
+
+set -e
+
+if [ $# -lt 3 ]; then
+    echo "usage: $0 size_tool --profile name obj... [--profile name obj...]..." >&2
+    exit 2
+fi
+
+size_tool=$1
+shift
+
+report() {
+    "$size_tool" -t "$@" | awk -v p="$profile" 'END { print p "," $1 "," $2 "," $3 }'
+}
+
+echo "profile,text,data,bss"
+
+profile=""
+objs=""
+while [ $# -gt 0 ]; do
+    if [ "$1" = "--profile" ]; then
+        if [ -n "$profile" ]; then
+            report $objs
+        fi
+        profile=$2
+        objs=""
+        shift 2
+    else
+        objs="$objs $(echo "$1" | tr ';' ' ')"          # Object lists may be ';'-separated.
+        shift
+    fi
+done
+if [ -n "$profile" ]; then
+    report $objs
+fi
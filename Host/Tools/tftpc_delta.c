@@ -0,0 +1,504 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                  HOST PORT : DELTA PATCH GENERATOR
+*
+* Filename : tftpc_delta.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Generates a patch rebuilding a target file from a base file, in the format of the delta
+*                codec (see 'tftp-c_delta.h  TFTPc DELTA PATCH DEFINES') :
+*
+*                (a) The base file is indexed by blocks of DELTA_BLK_LEN octets, aligned on their size.
+*
+*                (b) The target file is scanned with a rolling hash : each position whose next block matches
+*                    a base block starts a COPY, extended backwards over the pending literal data & forwards
+*                    as far as the files match.  The octets between COPYs are sent with ADD.
+*
+*            (2) The patch is applied back with the delta codec & checked against the target file before
+*                the tool succeeds, so that a patch that would NOT rebuild the target is never shipped.
+*
+*            (3) The SHA-256 digest of the target file is printed : the application passes it to
+*                TFTPc_DeltaCodecInit() (e.g. from a signed release manifest).
+*
+*            (4) Usage : tftpc_delta base target patch
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <Source/tftp-c.h>
+#include  <Source/tftp-c_delta.h>
+
+#include  <stdio.h>
+#include  <stdlib.h>
+#include  <string.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  DELTA_BLK_LEN                                    32u   /* Index blk len (see Note #1a).                        */
+#define  DELTA_HASH_MULT                          0x01000193u   /* Rolling hash multiplier.                             */
+#define  DELTA_CHAIN_MAX                                  32u   /* Max nbr of base blks compared per position.          */
+
+#define  DELTA_APPLY_BUF_LEN                             512u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                          LOCAL DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+typedef  struct  delta_out {
+    FILE        *FilePtr;                                       /* Patch file.                                          */
+    CPU_INT32U   Len;                                           /* Patch len.                                           */
+    CPU_INT32U   CopyNbr;                                       /* Nbr of COPY cmds.                                    */
+    CPU_INT32U   CopyLen;                                       /* Nbr of octets copied from base file.                 */
+    CPU_INT32U   AddNbr;                                        /* Nbr of ADD  cmds.                                    */
+    CPU_INT32U   AddLen;                                        /* Nbr of octets sent in patch.                         */
+} DELTA_OUT;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          Delta_FileRd()
+*
+* Description : Read a whole file.
+*
+* Return(s)   : Pointer to the file content (to free), if NO error.
+*
+*               NULL,                                    otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  *Delta_FileRd (const  CPU_CHAR    *p_path,
+                                          CPU_INT32U  *p_len)
+{
+    FILE        *p_file;
+    CPU_INT08U  *p_buf;
+    long         len;
+
+
+    p_file = fopen(p_path, "rb");
+    if (p_file == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    p_buf = DEF_NULL;
+    if ((fseek(p_file, 0, SEEK_END) == 0)   &&
+        ((len = ftell(p_file)) >= 0)         &&
+        (len <= (long)DEF_INT_32U_MAX_VAL)  &&
+        (fseek(p_file, 0, SEEK_SET) == 0)) {
+        p_buf = (CPU_INT08U *)malloc((size_t)len + 1u);
+        if ((p_buf != DEF_NULL) &&
+            (fread(p_buf, 1u, (size_t)len, p_file) != (size_t)len)) {
+            free(p_buf);
+            p_buf = DEF_NULL;
+        }
+       *p_len = (CPU_INT32U)len;
+    }
+    fclose(p_file);
+
+    return (p_buf);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Delta_Wr()
+*
+* Description : Write octets to the patch.
+*********************************************************************************************************
+*/
+
+static  void  Delta_Wr (       DELTA_OUT   *p_out,
+                        const  void        *p_data,
+                               CPU_SIZE_T   len)
+{
+    if (fwrite(p_data, 1u, len, p_out->FilePtr) != len) {
+        fprintf(stderr, "patch write failed\n");
+        exit(1);
+    }
+    p_out->Len += (CPU_INT32U)len;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Delta_CmdWr()
+*
+* Description : Write a COPY or ADD command & its arguments to the patch.
+*********************************************************************************************************
+*/
+
+static  void  Delta_CmdWr (DELTA_OUT   *p_out,
+                           CPU_INT08U   cmd,
+                           CPU_INT32U   arg_0,
+                           CPU_INT32U   arg_1)
+{
+    CPU_INT08U  buf[1u + TFTPc_DELTA_CMD_COPY_ARG_LEN];
+
+
+    buf[0] = cmd;
+    MEM_VAL_SET_INT32U_BIG(&buf[1], arg_0);
+    if (cmd == TFTPc_DELTA_CMD_COPY) {
+        MEM_VAL_SET_INT32U_BIG(&buf[5], arg_1);
+        Delta_Wr(p_out, buf, 1u + TFTPc_DELTA_CMD_COPY_ARG_LEN);
+    } else {
+        Delta_Wr(p_out, buf, 1u + TFTPc_DELTA_CMD_ADD_ARG_LEN);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Delta_AddWr()
+*
+* Description : Write an ADD command with its literal data, if any.
+*********************************************************************************************************
+*/
+
+static  void  Delta_AddWr (       DELTA_OUT   *p_out,
+                           const  CPU_INT08U  *p_data,
+                                  CPU_INT32U   len)
+{
+    if (len == 0u) {
+        return;
+    }
+    Delta_CmdWr(p_out, TFTPc_DELTA_CMD_ADD, len, 0u);
+    Delta_Wr(p_out, p_data, len);
+    p_out->AddNbr++;
+    p_out->AddLen += len;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           Delta_Hash()
+*
+* Description : Hash a block of DELTA_BLK_LEN octets.
+*********************************************************************************************************
+*/
+
+static  CPU_INT32U  Delta_Hash (const  CPU_INT08U  *p_data)
+{
+    CPU_INT32U  hash;
+    CPU_INT32U  ix;
+
+
+    hash = 0u;
+    for (ix = 0u; ix < DELTA_BLK_LEN; ix++) {
+        hash = hash * DELTA_HASH_MULT + p_data[ix];
+    }
+
+    return (hash);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Delta_Gen()
+*
+* Description : Generate the patch (see Note #1).
+*********************************************************************************************************
+*/
+
+static  void  Delta_Gen (       DELTA_OUT   *p_out,
+                         const  CPU_INT08U  *p_base,
+                                CPU_INT32U   base_len,
+                         const  CPU_INT08U  *p_target,
+                                CPU_INT32U   target_len)
+{
+    CPU_INT32U   blk_nbr;
+    CPU_INT32U   tbl_size;
+    CPU_INT32U  *p_head;
+    CPU_INT32U  *p_next;
+    CPU_INT32U   mult_out;
+    CPU_INT32U   hash;
+    CPU_INT32U   pos;
+    CPU_INT32U   lit_start;
+    CPU_INT32U   blk;
+    CPU_INT32U   chain;
+    CPU_INT32U   off;
+    CPU_INT32U   len;
+    CPU_INT32U   back;
+    CPU_INT32U   best_off;
+    CPU_INT32U   best_pos;
+    CPU_INT32U   best_len;
+    CPU_INT32U   ix;
+    CPU_INT08U   hdr[TFTPc_DELTA_HDR_LEN];
+
+
+    hdr[0] = TFTPc_DELTA_MAGIC_0;
+    hdr[1] = TFTPc_DELTA_MAGIC_1;
+    hdr[2] = TFTPc_DELTA_MAGIC_2;
+    hdr[3] = TFTPc_DELTA_MAGIC_3;
+    MEM_VAL_SET_INT32U_BIG(&hdr[4], target_len);
+    Delta_Wr(p_out, hdr, sizeof(hdr));
+
+    blk_nbr  = base_len / DELTA_BLK_LEN;                        /* Index base blks (see Note #1a).                      */
+    tbl_size = 1u;
+    while (tbl_size < (blk_nbr * 2u)) {
+        tbl_size <<= 1;
+    }
+    p_head = (CPU_INT32U *)malloc(tbl_size * sizeof(CPU_INT32U));
+    p_next = (CPU_INT32U *)malloc((blk_nbr + 1u) * sizeof(CPU_INT32U));
+    if ((p_head == DEF_NULL) || (p_next == DEF_NULL)) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    memset(p_head, 0xFF, tbl_size * sizeof(CPU_INT32U));
+    for (blk = blk_nbr; blk > 0u; blk--) {                      /* Earliest blk first in each chain.                    */
+        hash                           = Delta_Hash(&p_base[(blk - 1u) * DELTA_BLK_LEN]);
+        p_next[blk - 1u]               = p_head[hash & (tbl_size - 1u)];
+        p_head[hash & (tbl_size - 1u)] = blk - 1u;
+    }
+
+    mult_out = 1u;                                              /* DELTA_HASH_MULT ^ (DELTA_BLK_LEN - 1).               */
+    for (ix = 1u; ix < DELTA_BLK_LEN; ix++) {
+        mult_out *= DELTA_HASH_MULT;
+    }
+
+    pos       = 0u;
+    lit_start = 0u;
+    hash      = (target_len >= DELTA_BLK_LEN) ? Delta_Hash(p_target) : 0u;
+    while ((blk_nbr > 0u) &&                                    /* Scan target (see Note #1b).                          */
+           ((pos + DELTA_BLK_LEN) <= target_len)) {
+        best_len = 0u;
+        best_off = 0u;
+        best_pos = pos;
+        blk      = p_head[hash & (tbl_size - 1u)];
+        for (chain = 0u; (blk != DEF_INT_32U_MAX_VAL) && (chain < DELTA_CHAIN_MAX); chain++) {
+            off = blk * DELTA_BLK_LEN;
+            blk = p_next[blk];
+            len = 0u;
+            while (((off + len) < base_len)   &&
+                   ((pos + len) < target_len) &&
+                   (p_base[off + len] == p_target[pos + len])) {
+                len++;
+            }
+            if (len < DELTA_BLK_LEN) {
+                continue;
+            }
+            back = 0u;
+            while (((pos - back) > lit_start) &&
+                   ((off - back) > 0u)        &&
+                   (p_base[off - back - 1u] == p_target[pos - back - 1u])) {
+                back++;
+            }
+            if ((len + back) > best_len) {
+                best_len = len + back;
+                best_off = off - back;
+                best_pos = pos - back;
+            }
+        }
+
+        if (best_len > 0u) {
+            Delta_AddWr(p_out, &p_target[lit_start], best_pos - lit_start);
+            Delta_CmdWr(p_out, TFTPc_DELTA_CMD_COPY, best_off, best_len);
+            p_out->CopyNbr++;
+            p_out->CopyLen += best_len;
+            pos             = best_pos + best_len;
+            lit_start       = pos;
+            if ((pos + DELTA_BLK_LEN) <= target_len) {
+                hash = Delta_Hash(&p_target[pos]);
+            }
+        } else {
+            if ((pos + DELTA_BLK_LEN) < target_len) {           /* Roll hash by one octet.                              */
+                hash = (hash - p_target[pos] * mult_out) * DELTA_HASH_MULT + p_target[pos + DELTA_BLK_LEN];
+            }
+            pos++;
+        }
+    }
+
+    Delta_AddWr(p_out, &p_target[lit_start], target_len - lit_start);
+    hdr[0] = TFTPc_DELTA_CMD_END;
+    Delta_Wr(p_out, hdr, 1u);
+
+    free(p_head);
+    free(p_next);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          Delta_Chk()
+*
+* Description : Apply the patch with the delta codec & compare the result with the target (see Note #2).
+*
+* Return(s)   : DEF_OK,   if the patch rebuilds the target.
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Delta_Chk (       CPU_CHAR    *p_path_base,
+                                const  CPU_INT08U  *p_patch,
+                                       CPU_INT32U   patch_len,
+                                const  CPU_INT08U  *p_target,
+                                       CPU_INT32U   target_len,
+                                const  CPU_INT08U  *p_digest)
+{
+    TFTPc_CODEC   codec;
+    TFTPc_DELTA   delta;
+    CPU_INT08U    buf[DELTA_APPLY_BUF_LEN];
+    CPU_INT32U    src_ix;
+    CPU_INT32U    out_len;
+    CPU_SIZE_T    src_used;
+    CPU_SIZE_T    dst_used;
+    CPU_BOOLEAN   flush;
+    CPU_BOOLEAN   ok;
+    TFTPc_ERR     err;
+
+
+    ok = TFTPc_DeltaCodecInit(&codec, &delta, p_path_base, p_digest, DEF_NULL, &err);
+    if ((ok                                != DEF_OK) ||
+        (codec.Init(codec.CtxPtr, DEF_NO)  != DEF_OK)) {
+        return (DEF_FAIL);
+    }
+
+    src_ix  = 0u;
+    out_len = 0u;
+    do {
+        flush = (src_ix == patch_len) ? DEF_YES : DEF_NO;
+        ok    = codec.Process(codec.CtxPtr,
+                             &p_patch[src_ix],
+                              DEF_MIN(patch_len - src_ix, DELTA_APPLY_BUF_LEN),
+                             &src_used,
+                              buf,
+                              sizeof(buf),
+                             &dst_used,
+                              flush);
+        if ((ok                  != DEF_OK)     ||
+            ((out_len + dst_used) > target_len) ||
+            (memcmp(buf, &p_target[out_len], dst_used) != 0)) {
+            ok = DEF_FAIL;
+            break;
+        }
+        src_ix  += (CPU_INT32U)src_used;
+        out_len += (CPU_INT32U)dst_used;
+    } while ((flush == DEF_NO) || (dst_used > 0u));
+
+    codec.Close(codec.CtxPtr);
+
+    return (((ok == DEF_OK) && (out_len == target_len)) ? DEF_OK : DEF_FAIL);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           MAIN FUNCTION
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+int  main (int    argc,
+           char  *argv[])
+{
+    CPU_INT08U          *p_base;
+    CPU_INT08U          *p_target;
+    CPU_INT08U          *p_patch;
+    CPU_INT32U           base_len;
+    CPU_INT32U           target_len;
+    CPU_INT32U           patch_len;
+    TFTPc_DELTA_SHA256   sha256;
+    CPU_INT08U           digest[TFTPc_DELTA_SHA256_DIGEST_LEN];
+    DELTA_OUT            out;
+    CPU_INT32U           ix;
+
+
+    if (argc != 4) {
+        fprintf(stderr, "usage: %s base target patch\n", argv[0]);
+        return (2);
+    }
+
+    base_len   = 0u;
+    target_len = 0u;
+    p_base     = Delta_FileRd(argv[1], &base_len);
+    p_target   = Delta_FileRd(argv[2], &target_len);
+    if ((p_base == DEF_NULL) || (p_target == DEF_NULL)) {
+        fprintf(stderr, "cannot read %s\n", (p_base == DEF_NULL) ? argv[1] : argv[2]);
+        return (1);
+    }
+
+    TFTPc_DeltaSHA256Init(&sha256);                             /* See Note #3.                                         */
+    TFTPc_DeltaSHA256Update(&sha256, p_target, target_len);
+    TFTPc_DeltaSHA256Final(&sha256, digest);
+
+    memset(&out, 0, sizeof(out));
+    out.FilePtr = fopen(argv[3], "wb");
+    if (out.FilePtr == DEF_NULL) {
+        fprintf(stderr, "cannot create %s\n", argv[3]);
+        return (1);
+    }
+    Delta_Gen(&out, p_base, base_len, p_target, target_len);
+    if (fclose(out.FilePtr) != 0) {
+        fprintf(stderr, "patch write failed\n");
+        return (1);
+    }
+
+    patch_len = 0u;
+    p_patch   = Delta_FileRd(argv[3], &patch_len);
+    if ((p_patch   == DEF_NULL) ||
+        (patch_len != out.Len)  ||
+        (Delta_Chk(argv[1], p_patch, patch_len, p_target, target_len, digest) != DEF_OK)) {
+        fprintf(stderr, "patch check failed\n");
+        remove(argv[3]);
+        return (1);
+    }
+
+    printf("target  %u octets\n", (unsigned)target_len);
+    printf("patch   %u octets : %u copy (%u octets), %u add (%u octets)\n", (unsigned)out.Len,
+           (unsigned)out.CopyNbr, (unsigned)out.CopyLen, (unsigned)out.AddNbr, (unsigned)out.AddLen);
+    printf("sha256  ");
+    for (ix = 0u; ix < TFTPc_DELTA_SHA256_DIGEST_LEN; ix++) {
+        printf("%02x", digest[ix]);
+    }
+    printf("\n");
+
+    free(p_base);
+    free(p_target);
+    free(p_patch);
+
+    return (0);
+}
@@ -0,0 +1,348 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                    HOST PORT : CAPTURE REPLAY TOOL
+*
+* Filename : tftpc_replay.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) Replays a pcap file exported with TFTPc_CapPcapExport() against the client, on the simulated
+*                network (see 'Sim/host_sim_replay.c') :
+*
+*                (a) Each capture session that starts with a RRQ or a WRQ is re-run with TFTPc_Get() or
+*                    TFTPc_Put(), with the captured server address, port, file name & mode.
+*
+*                (b) The local file of a WRQ is rebuilt from the DATA pkts of the capture, which MUST then
+*                    be recorded whole (see 'tftp-c_cfg.h  TFTPc PACKET CAPTURE CONFIGURATION Note #3').
+*
+*            (2) One line is printed per session, then the replay result.  The exit status is zero if every
+*                record was replayed & the client never diverged from the capture.
+*
+*            (3) Usage : tftpc_replay capture.pcap
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    _POSIX_C_SOURCE  200809L
+
+#include  <Source/tftp-c.h>
+#include  <Source/tftp-c_cap.h>
+#include  "../Sim/host_sim.h"
+#include  "../Test/host_test.h"
+
+#include  <stdlib.h>
+#include  <string.h>
+#include  <strings.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  REPLAY_OPCODE_RRQ                                 1u
+#define  REPLAY_OPCODE_WRQ                                 2u
+#define  REPLAY_OPCODE_DATA                                3u
+
+#define  REPLAY_PKT_LEN_MIN             (TFTPc_CAP_PCAP_REC_HDR_LEN + TFTPc_CAP_PCAP_IPv4_HDR_LEN + \
+                                         TFTPc_CAP_PCAP_UDP_HDR_LEN + 4u)
+
+#define  REPLAY_NAME_LEN_MAX                             255u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         Replay_FileRd()
+*
+* Description : Read a whole file.
+*
+* Return(s)   : Pointer to the file content (to free), if NO error.
+*
+*               NULL,                                    otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_INT08U  *Replay_FileRd (const  CPU_CHAR    *p_path,
+                                           CPU_SIZE_T  *p_len)
+{
+    FILE        *p_file;
+    CPU_INT08U  *p_buf;
+    long         len;
+
+
+    p_file = fopen(p_path, "rb");
+    if (p_file == DEF_NULL) {
+        return (DEF_NULL);
+    }
+    p_buf = DEF_NULL;
+    if ((fseek(p_file, 0, SEEK_END) == 0) &&
+        ((len = ftell(p_file)) > 0)       &&
+        (fseek(p_file, 0, SEEK_SET) == 0)) {
+        p_buf = (CPU_INT08U *)malloc((size_t)len);
+        if ((p_buf != DEF_NULL) &&
+            (fread(p_buf, 1u, (size_t)len, p_file) != (size_t)len)) {
+            free(p_buf);
+            p_buf = DEF_NULL;
+        }
+       *p_len = (CPU_SIZE_T)len;
+    }
+    fclose(p_file);
+
+    return (p_buf);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Replay_ReqParse()
+*
+* Description : Parse a RRQ or a WRQ record.
+*
+* Return(s)   : Opcode,   if the record is a request tx'd to an IPv4 server.
+*
+*               0,        otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  Replay_ReqParse (const  TFTPc_CAP_REC  *p_rec,
+                                            CPU_CHAR       *p_name,
+                                            TFTPc_MODE     *p_mode)
+{
+    const  CPU_CHAR    *p_str;
+           CPU_INT16U   opcode;
+           CPU_INT32U   len;
+           CPU_INT32U   len_mode;
+
+
+    if ((p_rec->Dir        != TFTPc_CAP_DIR_TX)            ||
+        (p_rec->AddrFamily != TFTPc_CAP_ADDR_FAMILY_IPv4)  ||
+        (p_rec->CapLen     <  4u)) {
+        return (0u);
+    }
+    opcode = MEM_VAL_GET_INT16U_BIG(&p_rec->Data[0]);
+    if ((opcode != REPLAY_OPCODE_RRQ) &&
+        (opcode != REPLAY_OPCODE_WRQ)) {
+        return (0u);
+    }
+
+    p_str = (const CPU_CHAR *)&p_rec->Data[2];
+    len   = (CPU_INT32U)strnlen(p_str, (size_t)(p_rec->CapLen - 2u));
+    if ((len == 0u) || (len > REPLAY_NAME_LEN_MAX) || (len + 3u >= p_rec->CapLen)) {
+        return (0u);
+    }
+    memcpy(p_name, p_str, len);
+    p_name[len] = '\0';
+
+    p_str   += len + 1u;
+    len_mode = (CPU_INT32U)strnlen(p_str, (size_t)(p_rec->CapLen - 3u - len));
+   *p_mode   = ((len_mode == 8u) && (strncasecmp(p_str, "netascii", 8u) == 0)) ? TFTPc_MODE_NETASCII
+                                                                                : TFTPc_MODE_OCTET;
+
+    return (opcode);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         Replay_PutFileWr()
+*
+* Description : Rebuild the local file of a WRQ session from its DATA records (see Note #1b).
+*
+* Return(s)   : DEF_OK,   if the file was written.
+*
+*               DEF_FAIL, otherwise.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  Replay_PutFileWr (const  TFTPc_CAP_REC  *p_recs,
+                                              CPU_INT16U      nbr_recs,
+                                              CPU_INT16U      session_id,
+                                       const  CPU_CHAR       *p_path)
+{
+    FILE        *p_file;
+    CPU_INT16U   blk_nbr_next;
+    CPU_INT16U   ix;
+    CPU_BOOLEAN  ok;
+
+
+    p_file = fopen(p_path, "wb");
+    if (p_file == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    ok           = DEF_OK;
+    blk_nbr_next = 1u;
+    for (ix = 0u; ix < nbr_recs; ix++) {
+        if ((p_recs[ix].SessionID                        != session_id)         ||
+            (p_recs[ix].Dir                              != TFTPc_CAP_DIR_TX)   ||
+            (p_recs[ix].CapLen                           <  4u)                 ||
+            (MEM_VAL_GET_INT16U_BIG(&p_recs[ix].Data[0]) != REPLAY_OPCODE_DATA) ||
+            (MEM_VAL_GET_INT16U_BIG(&p_recs[ix].Data[2]) != blk_nbr_next)) {
+            continue;                                           /* Skip other pkts & re-tx'd DATA.                      */
+        }
+        if (p_recs[ix].CapLen < p_recs[ix].PktLen) {
+            ok = DEF_FAIL;                                      /* See Note #1b.                                        */
+        }
+        if (fwrite(&p_recs[ix].Data[4], 1u, p_recs[ix].CapLen - 4u, p_file) != (size_t)(p_recs[ix].CapLen - 4u)) {
+            ok = DEF_FAIL;
+        }
+        blk_nbr_next++;
+    }
+
+    fclose(p_file);
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                               main()
+*
+* Description : Replay a capture (see Note #3).
+*********************************************************************************************************
+*/
+
+int  main (int    argc,
+           char  *argv[])
+{
+    TFTPc_CAP_REC           *p_recs;
+    CPU_INT08U              *p_pcap;
+    CPU_SIZE_T               pcap_len;
+    CPU_INT16U               nbr_recs;
+    CPU_INT32U               nbr_max;
+    HOST_SIM_REPLAY         *p_replay;
+    HOST_SIM_REPLAY_RESULT   result;
+    TFTPc_CFG                cfg;
+    CPU_CHAR                *p_dir;
+    CPU_CHAR                 name_remote[REPLAY_NAME_LEN_MAX + 1u];
+    CPU_CHAR                 name_local[32];
+    CPU_CHAR                 addr_str[16];
+    CPU_INT32U               session_nbr;
+    CPU_INT16U               session_id;
+    CPU_INT16U               opcode;
+    CPU_INT16U               ix;
+    TFTPc_MODE               mode;
+    CPU_BOOLEAN              ok;
+    TFTPc_ERR                err;
+
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s capture.pcap\n", argv[0]);
+        return (2);
+    }
+
+    pcap_len = 0u;
+    p_pcap   = Replay_FileRd(argv[1], &pcap_len);
+    if (p_pcap == DEF_NULL) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return (1);
+    }
+    nbr_max  = DEF_MIN((CPU_INT32U)(pcap_len / REPLAY_PKT_LEN_MIN) + 1u, DEF_INT_16U_MAX_VAL);
+    p_recs   = (TFTPc_CAP_REC *)calloc(nbr_max, sizeof(TFTPc_CAP_REC));
+    nbr_recs = (p_recs != DEF_NULL) ? TFTPc_CapPcapImport(p_pcap, pcap_len, p_recs, (CPU_INT16U)nbr_max) : 0u;
+    free(p_pcap);
+    if (nbr_recs == 0u) {
+        fprintf(stderr, "no capture record in %s\n", argv[1]);
+        free(p_recs);
+        return (1);
+    }
+
+    p_dir = HostTest_DirCreate();
+    cfg   = TFTPc_Cfg;
+    if ((p_dir == DEF_NULL) ||
+        (TFTPc_Init(&cfg, &err) != DEF_OK)) {
+        fprintf(stderr, "setup failed\n");
+        free(p_recs);
+        return (HostTest_End() | 1);
+    }
+
+    HostSim_Init(HOST_SIM_TS_START_ms);
+    p_replay = HostSimReplay_Start(p_recs, nbr_recs);
+    if (p_replay == DEF_NULL) {
+        fprintf(stderr, "cannot start the replay peer\n");
+        free(p_recs);
+        return (HostTest_End() | 1);
+    }
+
+    session_nbr = 0u;
+    for (ix = 0u; ix < nbr_recs; ix++) {                        /* Re-run each session (see Note #1a).                  */
+        opcode = Replay_ReqParse(&p_recs[ix], name_remote, &mode);
+        if ((opcode == 0u) ||
+            ((session_nbr > 0u) && (p_recs[ix].SessionID == session_id))) {
+            continue;
+        }
+        session_id = p_recs[ix].SessionID;
+        session_nbr++;
+
+        snprintf(addr_str,   sizeof(addr_str), "%u.%u.%u.%u", p_recs[ix].AddrRemote[0], p_recs[ix].AddrRemote[1],
+                                                               p_recs[ix].AddrRemote[2], p_recs[ix].AddrRemote[3]);
+        snprintf(name_local, sizeof(name_local), "session_%u.bin", (unsigned)session_id);
+        cfg.ServerHostnamePtr = addr_str;
+        cfg.ServerPortNbr     = p_recs[ix].PortRemote;
+
+        if (opcode == REPLAY_OPCODE_RRQ) {
+            ok = TFTPc_Get(&cfg, HostTest_Path(p_dir, name_local), name_remote, mode, &err);
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
+        } else if (Replay_PutFileWr(p_recs, nbr_recs, session_id, HostTest_Path(p_dir, name_local)) == DEF_OK) {
+            ok = TFTPc_Put(&cfg, HostTest_Path(p_dir, name_local), name_remote, mode, &err);
+#endif
+        } else {
+            ok  = DEF_FAIL;
+            err = TFTPc_ERR_FILE_WR;
+        }
+
+        printf("session %u : %s %s:%u '%s' : %s (err %u)\n", (unsigned)session_id,
+               (opcode == REPLAY_OPCODE_RRQ) ? "get" : "put", addr_str, (unsigned)cfg.ServerPortNbr, name_remote,
+               (ok == DEF_OK) ? "ok" : "failed", (unsigned)err);
+    }
+
+    HostSimReplay_ResultGet(p_replay, &result);
+    HostSimReplay_Stop(p_replay);
+    free(p_recs);
+
+    printf("records %u, replayed %u, rx'd by client %u, divergences %u\n", (unsigned)result.RecNbr,
+           (unsigned)result.RecReplayedNbr, (unsigned)result.RxCtr, (unsigned)result.DivergeCtr);
+
+    if ((session_nbr           == 0u)            ||
+        (result.RecReplayedNbr != result.RecNbr) ||
+        (result.DivergeCtr     != 0u)) {
+        return (HostTest_End() | 1);
+    }
+
+    return (HostTest_End());
+}
@@ -52,6 +52,17 @@
 #include  <Source/net_app.h>
 #include  <KAL/kal.h>
 
+#if ((TFTPc_CFG_MCAST_EN   == DEF_ENABLED) || \
+     (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED) || \
+     (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED))
+#include  <Source/net_if.h>
+#endif
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+#include  <Source/net_igmp.h>
+#include  <Source/net_ascii.h>
+#endif
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -81,6 +92,7 @@
 #define  TFTP_OPCODE_DATA                                  3
 #define  TFTP_OPCODE_ACK                                   4
 #define  TFTP_OPCODE_ERR                                   5
+#define  TFTP_OPCODE_OACK                                  6
 
 
 /*
@@ -95,6 +107,7 @@
 #define  TFTP_PKT_OFFSET_ERR_CODE                          2
 #define  TFTP_PKT_OFFSET_ERR_MSG                           4
 #define  TFTP_PKT_OFFSET_DATA                              4
+#define  TFTP_PKT_OFFSET_OPT                               2
 
 
 /*
@@ -115,24 +128,268 @@
 *********************************************************************************************************
 */
 
+#if (TFTPc_CFG_NETASCII_EN == DEF_ENABLED)
 #define  TFTP_MODE_NETASCII_STR                    "netascii"
 #define  TFTP_MODE_NETASCII_STR_LEN                        8
+#endif
 #define  TFTP_MODE_BINARY_STR                         "octet"
 #define  TFTP_MODE_BINARY_STR_LEN                          5
 
 
+/*
+*********************************************************************************************************
+*                                         TFTP OPTION DEFINES
+*
+* Note(s) : (1) TFTPc_OPT_EN is #define'd when at least one TFTP option (RFC #2347) is enabled.  Options
+*               are appended to the request, & an OACK is accepted, only when TFTPc_OPT_EN is #define'd.
+*
+*           (2) The options req'd for the cur session are tracked with TFTPc_OPT_FLAG_xxx bits.  An OACK
+*               carrying an option that was NOT req'd fails the negotiation (RFC #2347, section
+*               'Negotiation Protocol').
+*********************************************************************************************************
+*/
+
+#if ((TFTPc_CFG_MCAST_EN   == DEF_ENABLED) || \
+     (TFTPc_CFG_FLASH_EN   == DEF_ENABLED) || \
+     (TFTPc_CFG_WIN_EN     == DEF_ENABLED) || \
+     (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED))
+#define  TFTPc_OPT_EN                                           /* See Note #1.                                         */
+#endif
+
+#define  TFTPc_OPT_FLAG_MCAST                     DEF_BIT_00    /* See Note #2.                                         */
+#define  TFTPc_OPT_FLAG_TSIZE                     DEF_BIT_01
+#define  TFTPc_OPT_FLAG_WIN                       DEF_BIT_02
+#define  TFTPc_OPT_FLAG_BLKSIZE                   DEF_BIT_03
+
+#define  TFTP_OPT_MCAST_STR                     "multicast"
+#define  TFTP_OPT_TSIZE_STR                         "tsize"     /* Transfer size option (RFC #2349).                    */
+#define  TFTP_OPT_TSIZE_REQ_STR                         "0"     /* Size req'd by a RRQ.                                 */
+#define  TFTP_OPT_WIN_STR                      "windowsize"     /* Window size option (RFC #7440).                      */
+#define  TFTP_OPT_BLKSIZE_STR                     "blksize"     /* Block size option (RFC #2348).                       */
+#define  TFTP_OPT_NBR_VAL_LEN_MAX                          6u   /* Max len of a 16-bit option val, incl. NULL.          */
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc MULTICAST DEFINES
+*
+* Note(s) : (1) RFC #2090, section 'Multicast Option' : the value of the multicast option in an OACK is
+*               "addr,port,mc", where 'mc' is 1 for the master client & 0 for the other clients.  Only the
+*               first OACK MUST carry the group address & port.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+#define  TFTPc_MCAST_BITMAP_SIZE                ((TFTPc_CFG_MCAST_BLK_NBR_MAX + 7u) / 8u)
+
+#define  TFTPc_MCAST_VAL_SEP                             ','    /* See Note #1.                                         */
+#define  TFTPc_MCAST_VAL_MASTER                          '1'
+#define  TFTPc_MCAST_VAL_PASSIVE                         '0'
+
+#define  TFTPc_MCAST_ADDR_CLASS_MASK             0xF0000000u    /* IPv4 class D (multicast) addr.                       */
+#define  TFTPc_MCAST_ADDR_CLASS_D                0xE0000000u
+
+#define  TFTPc_MCAST_FILL_BUF_LEN                         64u   /* Len of zero buf extending the file.                  */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc FLASH SINK DEFINES
+*********************************************************************************************************
+*/
+
+#define  TFTPc_FLASH_ERASED_VAL                         0xFFu   /* Val of an erased flash octet.                        */
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc SPARSE WRITE DEFINES
+*********************************************************************************************************
+*/
+
+#define  TFTPc_SPARSE_HOLE_VAL                          0x00u   /* Val read from a file pos never wr'n.                 */
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc SERVER POOL DEFINES
+*
+* Note(s) : (1) The round-trip time & the failure rate of the servers are smoothed with a gain of
+*               1/2^TFTPc_POOL_EWMA_SHIFT (RFC #6298, section 2).
+*
+*           (2) The octets already wr'n are compared with the local file by chunks of
+*               TFTPc_POOL_CMP_CHUNK_LEN octets, read on the stack.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+#define  TFTPc_POOL_IX_NONE                      DEF_INT_08U_MAX_VAL
+
+#define  TFTPc_POOL_EWMA_SHIFT                             3u   /* See Note #1.                                         */
+
+#define  TFTPc_POOL_CMP_CHUNK_LEN                         64u   /* See Note #2.                                         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc LAN RELAY DEFINES
+*
+* Note(s) : (1) RFC #2348, section 'Blocksize Option Specification' : the block size req'd by a peer MUST be
+*               at least 8 octets.  A larger block size is answered with the largest size the responder
+*               buffers hold, if smaller.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+#define  TFTPc_RELAY_BLKSIZE_MIN                           8u   /* See Note #1.                                         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc SESSION DEFINES
+*
+* Note(s) : (1) TFTPc_SESSION_KEEP_EN is #define'd when a transfer MAY be restarted against another source
+*               (relay peer or pool server), or without the block size option, after a failure within the
+*               same session.
+*********************************************************************************************************
+*/
+
+#if ((TFTPc_CFG_RELAY_EN   == DEF_ENABLED) || \
+     (TFTPc_CFG_POOL_EN    == DEF_ENABLED) || \
+     (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED))
+#define  TFTPc_SESSION_KEEP_EN                                  /* See Note #1.                                         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc WINDOWED TRANSFER DEFINES
+*
+* Note(s) : (1) TFTPc_WIN_REORDER_EN is #define'd when the blocks rx'd after a missing block are kept (see
+*               'tftp-c_cfg.h  TFTPc WINDOWED TRANSFER CONFIGURATION  Note #3').
+*
+*           (2) TFTPc_WIN_ADAPT_EN is #define'd when windowed transfers & the adaptive window are both enabled.
+*********************************************************************************************************
+*/
+
+#if ((TFTPc_CFG_WIN_EN          == DEF_ENABLED) && \
+     (TFTPc_CFG_WIN_REORDER_NBR >  0u))
+#define  TFTPc_WIN_REORDER_EN                                   /* See Note #1.                                         */
+#endif
+
+#if ((TFTPc_CFG_WIN_EN       == DEF_ENABLED) && \
+     (TFTPc_CFG_WIN_ADAPT_EN == DEF_ENABLED))
+#define  TFTPc_WIN_ADAPT_EN                                     /* See Note #2.                                         */
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc BLOCK SIZE DEFINES
+*
+* Note(s) : (1) RFC #2348, section 'Block Size Option Specification' : the block size MUST be between 8 &
+*               65464 octets.
+*
+*           (2) The hdrs subtracted from the interface MTU (see 'tftp-c_cfg.h  TFTPc BLOCK SIZE CONFIGURATION
+*               Note #1').  IP options & extension hdrs are NOT accounted for.
+*
+*           (3) Probing stops once the largest size that worked is less than TFTPc_BLKSIZE_PROBE_STEP_MIN
+*               octets from the smallest size that failed.
+*
+*           (4) TFTPc_BLKSIZE_PROBE_EN is #define'd when the block size option & probing are both enabled.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+#define  TFTPc_BLKSIZE_MIN                                 8u   /* See Note #1.                                         */
+
+#define  TFTPc_BLKSIZE_HDR_LEN_IPv4                       20u   /* See Note #2.                                         */
+#define  TFTPc_BLKSIZE_HDR_LEN_IPv6                       40u
+#define  TFTPc_BLKSIZE_HDR_LEN_UDP                         8u
+
+#define  TFTPc_BLKSIZE_PROBE_STEP_MIN                     32u   /* See Note #3.                                         */
+
+#if (TFTPc_CFG_BLKSIZE_PROBE_EN == DEF_ENABLED)
+#define  TFTPc_BLKSIZE_PROBE_EN                                 /* See Note #4.                                         */
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPc ROUND-TRIP TIME DEFINES
+*
+* Note(s) : (1) TFTPc_RTT_EN is #define'd when the round-trip time is measured, for the adaptive window or
+*               for background transfers.
+*
+*           (2) The smoothed round-trip time moves by 1/8 of the difference with each sample (RFC #6298).
+*********************************************************************************************************
+*/
+
+#if (defined(TFTPc_WIN_ADAPT_EN) || \
+     (TFTPc_CFG_BG_EN == DEF_ENABLED))
+#define  TFTPc_RTT_EN                                           /* See Note #1.                                         */
+
+#define  TFTPc_RTT_EWMA_SHIFT                              3u   /* See Note #2.                                         */
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          TFTP PKT DEFINES
+*
+* Note(s) : (1) TFTPc_DATA_BLOCK_SIZE is the default block size (RFC #1350), used by every transfer but the
+*               reads that negotiated the block size option.  TFTPc_BLK_SIZE_CUR is the block size of the
+*               cur read transfer; the pkt bufs are sized for TFTPc_BLK_SIZE_MAX.
 *********************************************************************************************************
 */
 
 #define  TFTPc_DATA_BLOCK_SIZE                           512
-#define  TFTPc_PKT_BUF_SIZE                     (TFTPc_DATA_BLOCK_SIZE + TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR)
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)                       /* See Note #1.                                         */
+#define  TFTPc_BLK_SIZE_MAX                     TFTPc_CFG_BLKSIZE_MAX
+#define  TFTPc_BLK_SIZE_CUR                     TFTPc_BlkSize
+#else
+#define  TFTPc_BLK_SIZE_MAX                     TFTPc_DATA_BLOCK_SIZE
+#define  TFTPc_BLK_SIZE_CUR                     TFTPc_DATA_BLOCK_SIZE
+#endif
+
+#define  TFTPc_PKT_BUF_SIZE                     (TFTPc_BLK_SIZE_MAX + TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR)
 
 #define  TFTPc_MAX_NBR_TX_RETRY                            3
 
 
+/*
+*********************************************************************************************************
+*                                        TFTPc IP FAMILY DEFINES
+*
+* Note(s) : (1) An IP family is used by TFTPc only if it is enabled both in the network stack & in
+*               'tftp-c_cfg.h' (see 'tftp-c_cfg.h  TFTPc FOOTPRINT CONFIGURATION').
+*
+*           (2) When the server address family is NOT specified, IPv6 is tried first, then IPv4.
+*********************************************************************************************************
+*/
+
+#if ((defined(NET_IPv4_MODULE_EN)) && \
+     (TFTPc_CFG_IPv4_EN == DEF_ENABLED))
+#define  TFTPc_IPv4_EN                                          /* See Note #1.                                         */
+#endif
+
+#if ((defined(NET_IPv6_MODULE_EN)) && \
+     (TFTPc_CFG_IPv6_EN == DEF_ENABLED))
+#define  TFTPc_IPv6_EN
+#endif
+
+#ifdef   TFTPc_IPv6_EN                                          /* See Note #2.                                         */
+#define  TFTPc_IP_ADDR_FAMILY_FIRST         NET_IP_ADDR_FAMILY_IPv6
+#else
+#define  TFTPc_IP_ADDR_FAMILY_FIRST         NET_IP_ADDR_FAMILY_IPv4
+#endif
+
+
 /*
 *********************************************************************************************************
 *                                          TFTP ERROR CODES
@@ -147,6 +404,23 @@
 #define  TFTP_ERR_CODE_UNKNOWN_ID                          5    /* Unknown transfer ID.                                 */
 #define  TFTP_ERR_CODE_FILE_EXISTS                         6    /* File already exists.                                 */
 #define  TFTP_ERR_CODE_NO_USER                             7    /* No such user.                                        */
+#define  TFTP_ERR_CODE_OPT_NEGO                            8    /* Option negotiation failed (RFC #2347).               */
+
+/*
+*********************************************************************************************************
+*                                       TFTP ERROR CLASS DEFINES
+*
+* Note(s) : (1) A server ERROR is transient if the same req MAY succeed later :
+*
+*               (a) Code 0 (not defined) is used by most servers to report they are busy or out of resources.
+*               (b) Code 3 (disk full or allocation exceeded) may clear once space is freed on the server.
+*
+*               Any other code, including codes NOT defined by RFC #1350 & #2347, is permanent : the same req
+*               fails again (file not found, access violation, ...) & is NEVER retried.
+*********************************************************************************************************
+*/
+
+#define  TFTP_ERR_CODE_TRANSIENT_MSK              (DEF_BIT(TFTP_ERR_CODE_NOT_DEF) | DEF_BIT(TFTP_ERR_CODE_DISK_FULL))
 
 
 /*
@@ -156,7 +430,21 @@
 */
 
 #define  TFTPc_ERR_MSG_WR_ERR              "File write error"
+#if ((TFTPc_CFG_PUT_EN   == DEF_ENABLED) || \
+     (TFTPc_CFG_RELAY_EN == DEF_ENABLED))
 #define  TFTPc_ERR_MSG_RD_ERR              "File read error"
+#endif
+#define  TFTPc_ERR_MSG_UNKNOWN_ID          "Unknown transfer ID"
+#define  TFTPc_ERR_MSG_BLKSIZE_INVALID     "Invalid block size"
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+#define  TFTPc_ERR_MSG_CANCELED            "Transfer canceled"
+#define  TFTPc_ERR_MSG_DEADLINE            "Transfer deadline exceeded"
+#endif
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+#define  TFTPc_ERR_MSG_NOT_CACHED          "File not cached"
+#define  TFTPc_ERR_MSG_REQ_UNSUPPORTED     "Only octet read requests served"
+#define  TFTPc_ERR_MSG_CACHE_CHANGED       "Cached file replaced"
+#endif
 
 
 /*
@@ -171,6 +459,178 @@
 #define  TFTPc_STATE_TRANSFER_COMPLETE                     4
 
 
+/*
+*********************************************************************************************************
+*                                        TAR ARCHIVE DEFINES
+*
+* Note(s) : (1) A tar archive is a sequence of 512-octet blocks : each entry is made of a header block
+*               followed by the entry data, padded to a whole number of blocks.  The archive ends with (at
+*               least) two all-zero blocks.
+*
+*           (2) Header fields used (POSIX.1-1988 'ustar' format).  Numeric fields are octal ASCII strings.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+#define  TFTPc_TAR_BLK_SIZE                              512u   /* See Note #1.                                         */
+
+#define  TFTPc_TAR_HDR_OFFSET_NAME                         0u   /* See Note #2.                                         */
+#define  TFTPc_TAR_HDR_LEN_NAME                          100u
+#define  TFTPc_TAR_HDR_OFFSET_SIZE                       124u
+#define  TFTPc_TAR_HDR_LEN_SIZE                           12u
+#define  TFTPc_TAR_HDR_OFFSET_CHKSUM                     148u
+#define  TFTPc_TAR_HDR_LEN_CHKSUM                          8u
+#define  TFTPc_TAR_HDR_OFFSET_TYPE                       156u
+#define  TFTPc_TAR_HDR_OFFSET_MAGIC                      257u
+#define  TFTPc_TAR_HDR_LEN_MAGIC                           5u
+#define  TFTPc_TAR_HDR_OFFSET_PREFIX                     345u
+#define  TFTPc_TAR_HDR_LEN_PREFIX                        155u
+
+#define  TFTPc_TAR_MAGIC_STR                         "ustar"
+
+#define  TFTPc_TAR_TYPE_FILE                             '0'    /* Regular file.                                        */
+#define  TFTPc_TAR_TYPE_FILE_OLD                         '\0'   /* Regular file (pre-POSIX archives).                   */
+#define  TFTPc_TAR_TYPE_FILE_CONTIG                      '7'    /* Contiguous file, extracted as a regular file.        */
+#define  TFTPc_TAR_TYPE_DIR                              '5'    /* Directory.                                           */
+
+#define  TFTPc_TAR_STATE_HDR                               1u   /* Rx'ing entry hdr.                                    */
+#define  TFTPc_TAR_STATE_DATA                              2u   /* Rx'ing entry data.                                   */
+#define  TFTPc_TAR_STATE_PAD                               3u   /* Skipping entry padding.                              */
+#define  TFTPc_TAR_STATE_END                               4u   /* End of archive rx'd.                                 */
+#define  TFTPc_TAR_STATE_ERR                               5u   /* Extraction failed.                                   */
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL MACRO'S
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                         STATISTICS MACRO'S
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_STAT_EN == DEF_ENABLED)
+#define  TFTPc_STAT_INC(ctr)                                ((TFTPc_Stats.ctr)++)
+#define  TFTPc_STAT_ADD(ctr, val)                           ((TFTPc_Stats.ctr) += (val))
+#define  TFTPc_STAT_SET(ctr, val)                           ((TFTPc_Stats.ctr)  = (val))
+#else
+#define  TFTPc_STAT_INC(ctr)
+#define  TFTPc_STAT_ADD(ctr, val)
+#define  TFTPc_STAT_SET(ctr, val)
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TIME SOURCE MACRO'S
+*
+* Note(s) : (1) All time readings & delays of the transfer engine go through TFTPc_TIME_GET_ms() &
+*               TFTPc_TIME_DLY_ms().  Unless #define'd in 'tftp-c_cfg.h', they use the network stack time &
+*               the kernel delay (see 'tftp-c_cfg.h  TFTPc TIME SOURCE CONFIGURATION').
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_TIME_GET_ms
+#define  TFTPc_TIME_GET_ms()                                NetUtil_TS_Get_ms()
+#endif
+
+#ifndef  TFTPc_TIME_DLY_ms
+#define  TFTPc_TIME_DLY_ms(dly_ms)                          KAL_Dly(dly_ms)
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TRANSFER ABORT MACRO'S
+*
+* Note(s) : (1) TFTPc_ERR_IS_ABORT() indicates whether an error code ends the transfer on a cancel req or on
+*               its deadline (see TFTPc_AbortChk()).  Such an error is NEVER retried, over another IP family
+*               nor against another server.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+#define  TFTPc_ERR_IS_ABORT(err)                          ((((err) == TFTPc_ERR_CANCELED) || \
+                                                            ((err) == TFTPc_ERR_DEADLINE)) ? DEF_YES : DEF_NO)
+#else
+#define  TFTPc_ERR_IS_ABORT(err)                            DEF_NO
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         BACKOFF SEED MACRO'S
+*
+* Note(s) : (1) Unless #define'd in 'tftp-c_cfg.h', the backoff generator is seeded by TFTPc_BackoffSeedGet()
+*               (see 'tftp-c_cfg.h  TFTPc REQUEST BACKOFF CONFIGURATION  Note #2').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+#ifndef  TFTPc_BACKOFF_SEED_GET
+#define  TFTPc_BACKOFF_SEED_GET()                           TFTPc_BackoffSeedGet()
+#define  TFTPc_BACKOFF_SEED_DFLT                                /* See Note #1.                                         */
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      BLOCK SIZE INTERFACE MACRO'S
+*
+* Note(s) : (1) Unless #define'd in 'tftp-c_cfg.h', the block size is derived from the MTU of the default
+*               interface (see 'tftp-c_cfg.h  TFTPc BLOCK SIZE CONFIGURATION  Note #5').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+#ifndef  TFTPc_BLKSIZE_IF_NBR_GET
+#define  TFTPc_BLKSIZE_IF_NBR_GET()                         NetIF_GetDflt()     /* See Note #1.                         */
+#endif
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       PHASE PROFILING MACRO'S
+*
+* Note(s) : (1) TFTPc_PROFILE_TS_GET() saves the start time of a phase in a local timestamp variable, that
+*               TFTPc_PROFILE_PHASE_END() uses to account the phase duration.  Both compile to nothing when
+*               profiling is disabled, as does the declaration of the local variable.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+#define  TFTPc_PROFILE_TS_GET(ts)                           ((ts) = CPU_TS_Get32())
+#define  TFTPc_PROFILE_PHASE_END(phase, ts)                 TFTPc_ProfileUpdate((phase), (CPU_TS32)(CPU_TS_Get32() - (ts)))
+#else
+#define  TFTPc_PROFILE_TS_GET(ts)
+#define  TFTPc_PROFILE_PHASE_END(phase, ts)
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       PACKET CAPTURE MACRO'S
+*
+* Note(s) : (1) TFTPc_CAP_PKT_WR() records a pkt rx'd from or tx'd to 'p_addr' in the capture ring (see
+*               'tftp-c_cap.h').  It compiles to nothing when packet capture is disabled.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+#define  TFTPc_CAP_PKT_WR(dir, p_addr, p_pkt, pkt_len)      TFTPc_CapPktWr((dir), (p_addr), (p_pkt), (CPU_INT16U)(pkt_len))
+#else
+#define  TFTPc_CAP_PKT_WR(dir, p_addr, p_pkt, pkt_len)
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -210,6 +670,60 @@ typedef  struct  tftpc_server_obj {
 } TFTPc_SERVER_OBJ;
 
 
+/*
+*********************************************************************************************************
+*                                  TFTPc TX TOKEN BUCKET DATA TYPE
+*
+* Note(s) : (1) Tokens are expressed in octets.  A bucket with a rate of zero never limits tx.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+typedef  struct  tftpc_tx_bucket {
+    CPU_INT32U          RateOctetsPerSec;                       /* Token refill rate (see Note #1).                     */
+    CPU_INT32U          BurstOctets;                            /* Max nbr of tokens.                                   */
+    CPU_INT32U          Tokens;                                 /* Nbr of tokens avail.                                 */
+    NET_TS_MS           TS_Refill_ms;                           /* Time of last refill.                                 */
+} TFTPc_TX_BUCKET;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                 TFTPc WINDOW REORDER SLOT DATA TYPE
+*
+* Note(s) : (1) A blk rx'd after a missing block is kept in slot (blk nbr % TFTPc_CFG_WIN_REORDER_NBR), so
+*               that the blks following the next blk expected never share a slot.  Since the number of slots is
+*               a power of 2, it divides 65536 & the slots stay consecutive when the blk nbr rolls over to 0.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_WIN_REORDER_EN
+typedef  struct  tftpc_win_blk {
+    CPU_BOOLEAN         Used;                                   /* Indicates whether a blk is kept in the slot.         */
+    TFTPc_BLK_NBR       BlkNbr;                                 /* Nbr of blk kept.                                     */
+    CPU_INT16U          DataLen;                                /* Nbr of data octets kept.                             */
+    CPU_INT08U          Data[TFTPc_BLK_SIZE_MAX];               /* Data kept.                                           */
+} TFTPc_WIN_BLK;
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPc RELAY CACHE ENTRY DATA TYPE
+*
+* Note(s) : (1) An entry is free when its remote name is empty.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+typedef  struct  tftpc_relay_cache_entry {
+    CPU_CHAR            NameRemote[TFTPc_CFG_RELAY_NAME_LEN_MAX + 1u];  /* Name req'd by peers (see Note #1).           */
+    CPU_CHAR            NameLocal[TFTPc_CFG_RELAY_NAME_LEN_MAX + 1u];   /* Name of the local file served.               */
+} TFTPc_RELAY_CACHE_ENTRY;
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -230,7 +744,9 @@ static  CPU_INT08U           TFTPc_RxPktBuf[TFTPc_PKT_BUF_SIZE];/* Last rx'd pkt
 static  CPU_INT32S           TFTPc_RxPktLen;                    /* Last rx'd pkt len.                                   */
 static  CPU_INT16U           TFTPc_RxPktOpcode;                 /* Last rx'd pkt opcode.                                */
 
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
 static  CPU_INT16U           TFTPc_TxPktBlkNbr;                 /* Last tx'd pkt blk nbr.                               */
+#endif
 static  CPU_INT08U           TFTPc_TxPktBuf[TFTPc_PKT_BUF_SIZE];/* Last tx'd pkt buf.                                   */
 static  CPU_INT16U           TFTPc_TxPktLen;                    /* Last tx'd pkt len.                                   */
 static  CPU_INT08U           TFTPc_TxPktRetry;                  /* Nbr of time last tx'd pkt had been sent.             */
@@ -239,14 +755,176 @@ static  NET_SOCK_ID          TFTPc_SockID;                      /* Client sock i
 static  NET_SOCK_ADDR        TFTPc_SockAddr;                    /* Server sock addr IP.                                 */
 
 static  CPU_BOOLEAN          TFTPc_TID_Set;                     /* Indicates whether the terminal ID is set or not.     */
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)
+static  CPU_BOOLEAN          TFTPc_SockConn;                    /* Indicates whether sock is conn'd to the server TID.  */
+#endif
 
 static  CPU_INT08U           TFTPc_State;                       /* Cur state of TFTPc state machine.                    */
 
 static  void                *TFTPc_FileHandle;                  /* Handle to cur opened file.                           */
 
+static  CPU_INT16U           TFTPc_SessionID;                   /* ID of cur session (see 'tftp-c_trace.h').            */
 
-/*
-*********************************************************************************************************
+static  TFTPc_SERVER_ERR     TFTPc_ServerErr;                   /* Last ERROR rx'd from the server.                     */
+
+#if (TFTPc_CFG_RX_DUP_REACK_EN == DEF_ENABLED)
+static  TFTPc_BLK_NBR        TFTPc_ReAckBlkNbr;                 /* Last re-ACK'd blk nbr.                               */
+static  NET_TS_MS            TFTPc_ReAckTS_ms;                  /* Time of last re-ACK.                                 */
+static  CPU_BOOLEAN          TFTPc_ReAckDone;                   /* Indicates whether a re-ACK was tx'd in cur session.  */
+#endif
+
+#if (TFTPc_CFG_STAT_EN == DEF_ENABLED)
+static  TFTPc_STATS          TFTPc_Stats;                       /* Stats of cur session.                                */
+#endif
+
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+static  TFTPc_PROFILE        TFTPc_Profile;                     /* Phase profile of cur session.                        */
+#endif
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+static  TFTPc_TX_BUCKET      TFTPc_TxBucketGlobal;              /* Tx token bucket shared by all sessions.              */
+static  TFTPc_TX_BUCKET      TFTPc_TxBucketSession;             /* Tx token bucket of cur session.                      */
+#endif
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+static  const  TFTPc_CODEC  *TFTPc_CodecPtr;                    /* Registered codec, NULL if none.                      */
+static  CPU_BOOLEAN          TFTPc_CodecActive;                 /* Indicates whether codec is used by cur session.      */
+static  CPU_INT08U           TFTPc_CodecBuf[TFTPc_CFG_CODEC_BUF_SIZE];   /* Codec working buf.                          */
+static  CPU_SIZE_T           TFTPc_CodecBufIx;                  /* Ix of 1st octet to encode in working buf.            */
+static  CPU_SIZE_T           TFTPc_CodecBufLen;                 /* Nbr of octets to encode in working buf.              */
+static  CPU_BOOLEAN          TFTPc_CodecEOF;                    /* Indicates whether end of file was rd.                */
+#endif
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+static  const  TFTPc_FLASH  *TFTPc_FlashPtr;                    /* Registered flash driver, NULL if none.               */
+static  CPU_BOOLEAN          TFTPc_FlashActive;                 /* Indicates whether flash is used by cur session.      */
+static  CPU_INT08U           TFTPc_FlashBuf[TFTPc_CFG_FLASH_PAGE_SIZE_MAX];  /* Page staging buf.                       */
+static  CPU_INT16U           TFTPc_FlashBufLen;                 /* Nbr of octets in staging buf.                        */
+static  CPU_INT32U           TFTPc_FlashWrAddr;                 /* Addr of next page to program.                        */
+static  CPU_INT32U           TFTPc_FlashEraseAddr;              /* Addr of 1st sector NOT erased yet.                   */
+static  CPU_INT32U           TFTPc_FlashEraseEnd;               /* Addr beyond which NO sector is erased ahead.         */
+#endif
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  const  TFTPc_TAR_SINK  *TFTPc_TarSinkPtr;               /* Registered entry sink, NULL if none.                 */
+static  CPU_BOOLEAN          TFTPc_TarActive;                   /* Indicates whether cur session extracts an archive.   */
+static  CPU_INT08U           TFTPc_TarState;                    /* Extraction state (TFTPc_TAR_STATE_xxx).              */
+static  TFTPc_ERR            TFTPc_TarErr;                      /* Err that stopped the extraction.                     */
+static  CPU_CHAR            *TFTPc_TarDirPtr;                   /* Local dir the entries are extracted to.              */
+static  CPU_INT08U           TFTPc_TarHdrBuf[TFTPc_TAR_BLK_SIZE];   /* Entry hdr being rx'd.                            */
+static  CPU_INT16U           TFTPc_TarHdrLen;                   /* Nbr of hdr octets rx'd.                              */
+static  CPU_INT32U           TFTPc_TarEntryRem;                 /* Nbr of entry data octets NOT rx'd yet.               */
+static  CPU_INT16U           TFTPc_TarPadRem;                   /* Nbr of entry padding octets NOT rx'd yet.            */
+static  CPU_BOOLEAN          TFTPc_TarEntryOpen;                /* Indicates whether cur entry data is wr'n.            */
+static  CPU_CHAR             TFTPc_TarPath[TFTPc_CFG_TAR_PATH_LEN_MAX + 1u];  /* Local path of cur entry.               */
+#endif
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN          TFTPc_SparseHole;                  /* Indicates whether file ends with skipped data.       */
+#endif
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  KAL_LOCK_HANDLE      TFTPc_RelayLockHandle;             /* Relay cache lock.                                    */
+static  const  TFTPc_CFG    *TFTPc_RelayPeerTbl;                /* Peers tried before the server, NULL if none.         */
+static  CPU_INT08U           TFTPc_RelayPeerNbr;                /* Nbr of peers in tbl.                                 */
+static  TFTPc_RELAY_CACHE_ENTRY  TFTPc_RelayCache[TFTPc_CFG_RELAY_CACHE_NBR];   /* Files served to the peers.           */
+static  CPU_INT08U           TFTPc_RelayCacheIxNext;            /* Ix of entry replaced when cache is full.             */
+static  NET_SOCK_ID          TFTPc_RelaySrvSockID;              /* Responder sock id, NONE if NOT started.              */
+static  TFTPc_RELAY_CACHE_ENTRY  *TFTPc_RelaySrvEntryPtr;       /* Entry served, NULL if none or replaced.              */
+static  CPU_INT08U           TFTPc_RelayRxPktBuf[TFTPc_PKT_BUF_SIZE];   /* Responder rx pkt buf.                        */
+static  CPU_INT08U           TFTPc_RelayTxPktBuf[TFTPc_PKT_BUF_SIZE];   /* Responder tx pkt buf.                        */
+#endif
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+static  const  TFTPc_CFG    *TFTPc_PoolTbl;                     /* Pool servers, NULL if none.                          */
+static  CPU_INT08U           TFTPc_PoolNbr;                     /* Nbr of servers in tbl.                               */
+static  TFTPc_POOL_STAT      TFTPc_PoolStat[TFTPc_CFG_POOL_NBR_MAX];    /* Stats of each server.                        */
+static  CPU_INT08U           TFTPc_PoolIxCur;                   /* Ix of server req'd, NONE if pool NOT used.           */
+static  NET_TS_MS            TFTPc_PoolTS_Req_ms;               /* Timestamp of req tx to cur server.                   */
+static  CPU_INT32U           TFTPc_PoolOctetWr;                 /* Nbr of octets wr'n to the local file.                */
+static  CPU_INT32U           TFTPc_PoolOctetRx;                 /* Nbr of octets rx'd in order from cur server.         */
+#endif
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+static  CPU_INT16U           TFTPc_WinSize;                     /* Window size of cur session, 1 if NOT negotiated.     */
+static  TFTPc_BLK_NBR        TFTPc_WinAckBlkNbr;                /* Last blk ACK'd, start of the cur window.             */
+static  TFTPc_BLK_NBR        TFTPc_WinGapBlkNbr;                /* Last blk ACK'd when a gap was detected.              */
+static  CPU_BOOLEAN          TFTPc_WinGapPending;               /* Indicates whether a gap ACK was tx'd since last ACK. */
+static  CPU_INT16U           TFTPc_WinSizeReq;                  /* Window size req'd by cur session.                    */
+#endif
+
+#ifdef  TFTPc_WIN_ADAPT_EN
+static  CPU_INT16U           TFTPc_WinAdaptSize;                /* Window size req'd by next read.                      */
+static  CPU_BOOLEAN          TFTPc_WinAdaptNego;                /* Indicates whether the window size was negotiated.    */
+static  CPU_BOOLEAN          TFTPc_WinAdaptCongested;           /* Indicates whether a loss or delay rise occurred.     */
+#endif
+
+#ifdef  TFTPc_RTT_EN
+static  NET_TS_MS            TFTPc_RTT_TS_Tx_ms;                /* Timestamp of the pkt whose answer is timed.          */
+static  CPU_BOOLEAN          TFTPc_RTT_Pending;                 /* Indicates whether an answer is timed.                */
+static  CPU_INT32U           TFTPc_RTT_ms;                      /* Smoothed round-trip time of cur session.             */
+static  CPU_INT32U           TFTPc_RTT_Min_ms;                  /* Smallest round-trip time, MAX if none.               */
+#endif
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+static  CPU_BOOLEAN          TFTPc_BgActive;                    /* Indicates whether cur session is in background.      */
+static  CPU_INT32U           TFTPc_BgDly_ms;                    /* Delay inserted before the next ACK or DATA.          */
+#endif
+
+#ifdef  TFTPc_WIN_REORDER_EN
+static  TFTPc_WIN_BLK        TFTPc_WinReorderTbl[TFTPc_CFG_WIN_REORDER_NBR];    /* Blks rx'd after a gap.               */
+#endif
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+static  CPU_INT16U           TFTPc_BlkSizeSel;                  /* Blk size set, TFTPc_BLKSIZE_AUTO if from MTU.        */
+static  CPU_INT16U           TFTPc_BlkSizeReq;                  /* Blk size selected for cur read, 0 if none.           */
+static  CPU_INT16U           TFTPc_BlkSize;                     /* Blk size of cur session.                             */
+static  CPU_BOOLEAN          TFTPc_BlkSizeFallback;             /* Indicates whether req re-tx'd w/o blk size.          */
+#endif
+
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+static  CPU_INT16U           TFTPc_BlkSizeAutoMax;              /* Blk size derived from the MTU.                       */
+static  CPU_INT16U           TFTPc_BlkSizeOk;                   /* Largest blk size that worked.                        */
+static  CPU_INT32U           TFTPc_BlkSizeFail;                 /* Smallest blk size that failed, AutoMax + 1 if none.  */
+static  CPU_INT16U           TFTPc_BlkSizeOkCtr;                /* Nbr of transfers w/o failure since last probe.       */
+static  CPU_INT08U           TFTPc_BlkSizeTimeoutCtr;           /* Nbr of rx timeouts in cur session.                   */
+#endif
+
+#ifdef  TFTPc_SESSION_KEEP_EN
+static  CPU_BOOLEAN          TFTPc_SessionKeep;                 /* Indicates whether a failed session is kept.          */
+#endif
+
+#ifdef  TFTPc_OPT_EN
+static  CPU_INT08U           TFTPc_OptReq;                      /* Options req'd in cur session (TFTPc_OPT_FLAG_xxx).   */
+#endif
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+static  NET_SOCK_ID          TFTPc_McastSockID;                 /* Multicast rx sock id, NONE if no grp joined.         */
+static  NET_IPv4_ADDR        TFTPc_McastAddr;                   /* Multicast grp addr.                                  */
+static  NET_IF_NBR           TFTPc_McastIF_Nbr;                 /* IF on which the grp was joined.                      */
+static  CPU_BOOLEAN          TFTPc_McastMaster;                 /* Indicates whether client is the master client.       */
+static  CPU_INT32U           TFTPc_McastBlkMissing;             /* 1st blk NOT rx'd yet.                                */
+static  CPU_INT32U           TFTPc_McastBlkLast;                /* Last blk of file, 0 if NOT rx'd yet.                 */
+static  CPU_INT32U           TFTPc_McastFileLen;                /* Len of local file wr'n so far.                       */
+static  CPU_INT08U           TFTPc_McastBitmap[TFTPc_MCAST_BITMAP_SIZE]; /* Rx'd blks, 1 bit per blk.                   */
+#endif
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+static  CPU_BOOLEAN          TFTPc_SessionActive;               /* Indicates whether a session is in progress.          */
+static  volatile  CPU_BOOLEAN  TFTPc_AbortReq;                  /* Indicates whether cur session must be canceled.      */
+static  CPU_BOOLEAN          TFTPc_DeadlineEn;                  /* Indicates whether cur session has a deadline.        */
+static  CPU_INT32U           TFTPc_Deadline_ms;                 /* Time at which cur session is aborted.                */
+#endif
+static  CPU_INT32U           TFTPc_RxTimeout_ms;                /* Rx inactivity timeout of cur session.                */
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+static  CPU_INT32U           TFTPc_BackoffRandState;            /* Backoff generator state, seeded per session.         */
+static  CPU_INT08U           TFTPc_BackoffReqRetryCtr;          /* Nbr of req retries after an ERROR.                   */
+#endif
+
+
+/*
+*********************************************************************************************************
 *********************************************************************************************************
 *                                      LOCAL FUNCTION PROTOTYPES
 *********************************************************************************************************
@@ -261,6 +939,29 @@ static  void                TFTPc_LockRelease   (void);
                                                                 /* -------------------- INIT FNCT --------------------- */
 static  void                TFTPc_InitSession   (void);
 
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+                                                                /* ---------------- TX RATE LIMIT FNCTS --------------- */
+static  void                TFTPc_TxBucketInit  (       TFTPc_TX_BUCKET     *p_bucket,
+                                                        CPU_INT32U           rate_octets_per_sec,
+                                                        CPU_INT32U           burst_octets);
+
+static  CPU_INT32U          TFTPc_TxBucketDlyGet(       TFTPc_TX_BUCKET     *p_bucket,
+                                                        CPU_INT16U           pkt_len,
+                                                        NET_TS_MS            ts_cur_ms);
+
+static  void                TFTPc_TxBucketTake  (       TFTPc_TX_BUCKET     *p_bucket,
+                                                        CPU_INT16U           pkt_len);
+
+static  void                TFTPc_TxRateWait    (       CPU_INT16U           pkt_len,
+                                                        TFTPc_ERR           *p_err);
+#endif
+
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+                                                                /* ------------------ PROFILING FNCT ------------------ */
+static  void                TFTPc_ProfileUpdate (       CPU_INT08U           phase,
+                                                        CPU_TS32             ts_delta);
+#endif
+
 static  CPU_BOOLEAN         TFTPc_SockInit      (       CPU_CHAR            *p_server_hostname,
                                                         NET_PORT_NBR         server_port,
                                                         NET_IP_ADDR_FAMILY   ip_family,
@@ -273,10 +974,20 @@ static  void                TFTPc_Processing    (const  TFTPc_CFG           *p_c
 
 static  void                TFTPc_StateDataGet  (       TFTPc_ERR           *p_err);
 
+static  CPU_INT16U          TFTPc_DataGetWr     (       TFTPc_ERR           *p_err);
+
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
 static  void                TFTPc_StateDataPut  (       TFTPc_ERR           *p_err);
+#endif
 
 static  CPU_INT16U          TFTPc_GetRxBlkNbr   (void);
 
+static  void                TFTPc_RxErrPkt      (void);
+
+#if (TFTPc_CFG_RX_DUP_REACK_EN == DEF_ENABLED)
+static  void                TFTPc_RxDupData     (       TFTPc_BLK_NBR        rx_blk_nbr);
+#endif
+
 
                                                                 /* ---------------- FILE ACCESS FNCTS ----------------- */
 static  void               *TFTPc_FileOpenMode  (       CPU_CHAR            *p_filename,
@@ -284,7 +995,268 @@ static  void               *TFTPc_FileOpenMode  (       CPU_CHAR            *p_f
 
 static  CPU_INT16U          TFTPc_DataWr        (       TFTPc_ERR           *p_err);
 
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
 static  CPU_INT16U          TFTPc_DataRd        (       TFTPc_ERR           *p_err);
+#endif
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+                                                                /* -------------------- CODEC FNCTS ------------------- */
+static  void                TFTPc_CodecSel      (       CPU_CHAR            *p_filename_remote,
+                                                        TFTPc_MODE           mode,
+                                                        CPU_BOOLEAN          encode,
+                                                        TFTPc_ERR           *p_err);
+
+static  void                TFTPc_CodecDataWr   (       CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len,
+                                                        CPU_BOOLEAN          last,
+                                                        TFTPc_ERR           *p_err);
+
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
+static  CPU_SIZE_T          TFTPc_CodecDataRd   (       CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len,
+                                                        TFTPc_ERR           *p_err);
+#endif
+#endif
+
+static  CPU_SIZE_T          TFTPc_FileWr        (       CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len);
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+                                                                /* ----------------- FLASH SINK FNCTS ----------------- */
+static  void                TFTPc_FlashSel      (       TFTPc_MODE           mode,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_SIZE_T          TFTPc_FlashWr       (       CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len);
+
+static  void                TFTPc_FlashFlush    (       TFTPc_ERR           *p_err);
+
+static  CPU_BOOLEAN         TFTPc_FlashPageProg (const  CPU_INT08U          *p_page);
+
+static  void                TFTPc_FlashPreErase (void);
+
+static  void                TFTPc_FlashTSizeRx  (       CPU_CHAR            *p_opt_val,
+                                                        TFTPc_ERR           *p_err);
+#endif
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+                                                                /* ---------------- ARCHIVE SINK FNCTS ---------------- */
+static  void                TFTPc_TarSel        (       CPU_CHAR            *p_dir,
+                                                        TFTPc_MODE           mode,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_SIZE_T          TFTPc_TarWr         (       CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len);
+
+static  void                TFTPc_TarChk        (       CPU_BOOLEAN          last,
+                                                        TFTPc_ERR           *p_err);
+
+static  void                TFTPc_TarHdrProc    (       TFTPc_ERR           *p_err);
+
+static  CPU_BOOLEAN         TFTPc_TarNbrParse   (const  CPU_INT08U          *p_field,
+                                                        CPU_INT16U           field_len,
+                                                        CPU_INT32U          *p_nbr);
+
+static  CPU_BOOLEAN         TFTPc_TarPathBuild  (       CPU_SIZE_T          *p_name_len);
+
+static  CPU_BOOLEAN         TFTPc_TarPathAdd    (       CPU_SIZE_T          *p_path_len,
+                                                 const  CPU_CHAR            *p_str,
+                                                        CPU_SIZE_T           str_len_max);
+
+static  void                TFTPc_TarEntryClose (       CPU_BOOLEAN          complete);
+#endif
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+                                                                /* ---------------- SPARSE WRITE FNCTS ---------------- */
+static  CPU_BOOLEAN         TFTPc_SparseSkip    (const  CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len);
+
+static  void                TFTPc_SparseFlush   (       TFTPc_ERR           *p_err);
+
+static  CPU_BOOLEAN         TFTPc_SparseIsFill  (const  CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len,
+                                                        CPU_INT08U           fill_val);
+#endif
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+                                                                /* ------------------ LAN RELAY FNCTS ----------------- */
+static  CPU_BOOLEAN         TFTPc_RelayPeerGet  (       CPU_CHAR            *p_filename_remote,
+                                                        TFTPc_MODE           mode,
+                                                        TFTPc_ERR           *p_err);
+
+static  void                TFTPc_RelayCacheRemove (const  CPU_CHAR         *p_filename_local);
+
+static  void                TFTPc_RelayLockAcquire (   TFTPc_ERR           *p_err);
+
+static  void                TFTPc_RelayLockRelease (void);
+
+static  void                TFTPc_RelaySrvServe (       NET_SOCK_ADDR       *p_addr_peer,
+                                                        CPU_INT16U           req_len,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_BOOLEAN         TFTPc_RelaySrvOptRx (       CPU_INT16U           opt_ix,
+                                                        CPU_INT16U           req_len,
+                                                        CPU_INT16U          *p_blk_size);
+
+static  void                TFTPc_RelaySrvBlkTx (       NET_SOCK_ID          sock_id,
+                                                        NET_SOCK_ADDR       *p_addr_peer,
+                                                        CPU_INT16U           blk_nbr,
+                                                        CPU_INT16U           pkt_len,
+                                                        TFTPc_ERR           *p_err);
+
+static  void                TFTPc_RelaySrvTxErr (       NET_SOCK_ID          sock_id,
+                                                        NET_SOCK_ADDR       *p_addr_peer,
+                                                        CPU_INT16U           err_code,
+                                                        CPU_CHAR            *p_err_msg);
+#endif
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+                                                                /* ----------------- SERVER POOL FNCTS ---------------- */
+static  void                TFTPc_PoolGet       (       CPU_CHAR            *p_filename_remote,
+                                                        TFTPc_MODE           mode,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_INT08U          TFTPc_PoolSel       (       CPU_INT32U           tried);
+
+static  void                TFTPc_PoolStatUpdate(       CPU_INT08U           ix,
+                                                        TFTPc_ERR            err);
+
+static  void                TFTPc_PoolRTT_Update(void);
+
+static  CPU_BOOLEAN         TFTPc_PoolDataCmp   (const  CPU_INT08U          *p_data,
+                                                        CPU_SIZE_T           data_len,
+                                                        TFTPc_ERR           *p_err);
+#endif
+
+#ifdef  TFTPc_SESSION_KEEP_EN
+static  void                TFTPc_SessionSrcReset (void);
+#endif
+
+#ifdef  TFTPc_OPT_EN
+                                                                /* ------------------- OPTION FNCTS ------------------- */
+static  CPU_INT16U          TFTPc_TxReqOptAdd   (       CPU_INT16U           pkt_len,
+                                                 const  CPU_CHAR            *p_opt_name,
+                                                 const  CPU_CHAR            *p_opt_val,
+                                                        CPU_INT08U           opt_flag);
+
+static  void                TFTPc_RxOACK        (       TFTPc_ERR           *p_err);
+#endif
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+                                                                /* ------------------ MULTICAST FNCTS ----------------- */
+static  void                TFTPc_McastOptRx    (       CPU_CHAR            *p_opt_val,
+                                                        TFTPc_ERR           *p_err);
+
+static  void                TFTPc_McastOpen     (       NET_IPv4_ADDR        addr,
+                                                        NET_PORT_NBR         port,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_BOOLEAN         TFTPc_McastFileExtend(      CPU_INT32U           pos);
+
+static  void                TFTPc_McastDataRx   (       TFTPc_BLK_NBR        rx_blk_nbr,
+                                                        TFTPc_ERR           *p_err);
+
+static  NET_SOCK_ID         TFTPc_McastSockSel  (       NET_SOCK_ID          sock_id,
+                                                        NET_ERR             *p_err);
+#endif
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+                                                                /* -------------- WINDOWED TRANSFER FNCTS ------------- */
+static  void                TFTPc_WinReset      (void);
+
+static  void                TFTPc_WinOptRx      (       CPU_CHAR            *p_opt_val,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_BOOLEAN         TFTPc_WinAckChk     (       TFTPc_BLK_NBR        blk_nbr,
+                                                        CPU_BOOLEAN          drained,
+                                                        CPU_BOOLEAN          last);
+
+static  void                TFTPc_WinBlkAheadRx (       TFTPc_BLK_NBR        rx_blk_nbr);
+
+static  void                TFTPc_WinAckRefresh (void);
+
+#ifdef  TFTPc_WIN_ADAPT_EN
+static  void                TFTPc_WinAdaptUpdate(       TFTPc_ERR            err);
+#endif
+
+#ifdef  TFTPc_WIN_REORDER_EN
+static  CPU_INT16U          TFTPc_WinReorderDrain(      TFTPc_BLK_NBR       *p_blk_nbr,
+                                                        CPU_INT16U           wr_data_len,
+                                                        TFTPc_ERR           *p_err);
+#endif
+#endif
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+                                                                /* ----------------- BLOCK SIZE FNCTS ----------------- */
+static  CPU_INT16U          TFTPc_BlkSizeReqGet (void);
+
+static  CPU_INT16U          TFTPc_BlkSizeAutoGet(void);
+
+static  void                TFTPc_BlkSizeOptRx  (       CPU_CHAR            *p_opt_val,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_BOOLEAN         TFTPc_BlkSizeFallbackChk(   TFTPc_ERR            err);
+
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+static  void                TFTPc_BlkSizeProbeUpdate(   TFTPc_ERR            err);
+#endif
+#endif
+
+#ifdef  TFTPc_RTT_EN
+                                                                /* --------------- ROUND-TRIP TIME FNCTS -------------- */
+static  void                TFTPc_RTT_Reset     (void);
+
+static  void                TFTPc_RTT_Start     (void);
+
+static  void                TFTPc_RTT_Sample    (void);
+#endif
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+                                                                /* ------------- BACKGROUND TRANSFER FNCTS ------------ */
+static  void                TFTPc_BgYield       (void);
+
+static  void                TFTPc_BgDlyUpdate   (       CPU_INT32U           qdly_ms);
+#endif
+
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+                                                                /* -------------------- ABORT FNCTS ------------------- */
+static  void                TFTPc_AbortInit     (const  TFTPc_CFG           *p_cfg);
+
+static  CPU_INT32U          TFTPc_AbortChk      (       CPU_INT32U           ts_cur_ms,
+                                                        TFTPc_ERR           *p_err);
+
+static  void                TFTPc_RxWaitChk     (       NET_SOCK_ID          sock_id,
+                                                        CPU_INT32U           ts_start_ms,
+                                                        TFTPc_ERR           *p_err);
+#endif
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+                                                                /* ------------------- BACKOFF FNCTS ------------------ */
+static  void                TFTPc_BackoffStart  (       TFTPc_ERR           *p_err);
+
+static  void                TFTPc_BackoffReqDly (       CPU_INT08U           attempt,
+                                                        TFTPc_ERR           *p_err);
+
+static  void                TFTPc_BackoffErrRx  (       TFTPc_ERR           *p_err);
+
+static  void                TFTPc_BackoffDly    (       CPU_INT32U           dly_ms,
+                                                        TFTPc_ERR           *p_err);
+
+static  CPU_INT32U          TFTPc_BackoffRandGet(void);
+
+#ifdef  TFTPc_BACKOFF_SEED_DFLT
+static  CPU_INT32U          TFTPc_BackoffSeedGet(void);
+#endif
+#endif
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+                                                                /* ------------------- CAPTURE FNCTS ------------------ */
+static  void                TFTPc_CapPktWr      (       CPU_INT08U           dir,
+                                                        NET_SOCK_ADDR       *p_addr,
+                                                 const  void                *p_pkt,
+                                                        CPU_INT16U           pkt_len);
+#endif
 
 
                                                                 /* --------------------- RX FNCTS --------------------- */
@@ -293,6 +1265,19 @@ static  NET_SOCK_RTN_CODE   TFTPc_RxPkt         (       NET_SOCK_ID          soc
                                                         CPU_INT16U           pkt_len,
                                                         TFTPc_ERR           *p_err);
 
+static  NET_SOCK_RTN_CODE   TFTPc_RxPktSock     (       NET_SOCK_ID          sock_id,
+                                                        void                *p_pkt,
+                                                        CPU_INT16U           pkt_len,
+                                                        NET_SOCK_ADDR       *p_addr_remote,
+                                                        NET_SOCK_ADDR_LEN   *p_addr_len,
+                                                        NET_ERR             *p_err);
+
+static  CPU_BOOLEAN         TFTPc_SockAddrCmp   (       NET_SOCK_ADDR       *p_addr,
+                                                        NET_SOCK_ADDR       *p_addr_ref,
+                                                        CPU_BOOLEAN          port_chk);
+
+static  void                TFTPc_TID_Update    (       NET_SOCK_ADDR       *p_addr);
+
 
                                                                 /* --------------------- TX FNCTS --------------------- */
 static  void                TFTPc_TxReq         (       CPU_INT16U           req_opcode,
@@ -300,9 +1285,11 @@ static  void                TFTPc_TxReq         (       CPU_INT16U           req
                                                         TFTPc_MODE           mode,
                                                         TFTPc_ERR           *p_err);
 
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
 static  void                TFTPc_TxData        (       TFTPc_BLK_NBR        blk_nbr,
                                                         CPU_INT16U           data_len,
                                                         TFTPc_ERR           *p_err);
+#endif
 
 static  void                TFTPc_TxAck         (       TFTPc_BLK_NBR        blk_nbr,
                                                         TFTPc_ERR           *p_err);
@@ -311,6 +1298,8 @@ static  void                TFTPc_TxErr         (       CPU_INT16U           err
                                                         CPU_CHAR            *p_err_msg,
                                                         TFTPc_ERR           *p_err);
 
+static  void                TFTPc_TxErrStray    (       NET_SOCK_ADDR       *p_addr_remote);
+
 static  NET_SOCK_RTN_CODE   TFTPc_TxPkt         (       NET_SOCK_ID          sock_id,
                                                         void                *p_pkt,
                                                         CPU_INT16U           pkt_len,
@@ -318,6 +1307,13 @@ static  NET_SOCK_RTN_CODE   TFTPc_TxPkt         (       NET_SOCK_ID          soc
                                                         NET_SOCK_ADDR_LEN    addr_len,
                                                         TFTPc_ERR           *p_err);
 
+static  NET_SOCK_RTN_CODE   TFTPc_TxPktSock     (       NET_SOCK_ID          sock_id,
+                                                        void                *p_pkt,
+                                                        CPU_INT16U           pkt_len,
+                                                        NET_SOCK_ADDR       *p_addr_remote,
+                                                        NET_SOCK_ADDR_LEN    addr_len,
+                                                        NET_ERR             *p_err);
+
 
 static  void                TFTPc_Terminate     (void);
 
@@ -390,6 +1386,38 @@ CPU_BOOLEAN  TFTPc_Init (const  TFTPc_CFG  *p_cfg,
              goto exit;
     }
 
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+                                                                /* ------------- CREATE TFTPC RELAY LOCK -------------- */
+    TFTPc_RelayLockHandle = KAL_LockCreate("TFTPc Relay Lock",
+                                            KAL_OPT_CREATE_NONE,
+                                           &err_kal);
+    switch (err_kal) {
+        case KAL_ERR_NONE:
+             break;
+
+        case KAL_ERR_MEM_ALLOC:
+             result = DEF_FAIL;
+            *p_err  = TFTPc_ERR_MEM_ALLOC;
+             goto exit;
+
+        default:
+             result = DEF_FAIL;
+            *p_err  = TFTPc_ERR_FAULT_INIT;
+             goto exit;
+    }
+
+    TFTPc_RelaySrvSockID   = NET_SOCK_ID_NONE;
+    TFTPc_RelaySrvEntryPtr = DEF_NULL;
+#endif
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+    TFTPc_PoolIxCur      = TFTPc_POOL_IX_NONE;
+#endif
+
+#ifdef  TFTPc_WIN_ADAPT_EN
+    TFTPc_WinAdaptSize   = TFTPc_CFG_WIN_ADAPT_SIZE_INIT;
+#endif
+
                                                                 /* ------------ SET DEFAULT CONFIGURATION ------------- */
    (void)TFTPc_SetDfltCfg(p_cfg, p_err);
     if (*p_err != TFTPc_ERR_NONE) {
@@ -489,11 +1517,24 @@ exit:
 *                                       TFTPc_MODE_NETASCII     ASCII  mode.
 *                                       TFTPc_MODE_OCTET        Binary mode.
 *
+*                                   OR'd with the following flag(s), if needed :
+*
+*                                       TFTPc_MODE_FLAG_CODEC   Decode file data (see TFTPc_CodecSet()).
+*                                       TFTPc_MODE_FLAG_MCAST   Request multicast transfer (see Note #1).
+*                                       TFTPc_MODE_FLAG_FLASH   Write file to flash (see Note #2).
+*                                       TFTPc_MODE_FLAG_TAR     Extract tar archive (see Note #6).
+*                                       TFTPc_MODE_FLAG_BG      Background transfer (see Note #11).
+*
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
 *                               TFTPc_ERR_NONE          TFTP operation was successful.
 *                               TFTPC_ERR_FILE_OPEN     File opening failed.
 *                               TFTPc_ERR_TX            Transmission of TFTP request faulted.
+*                               TFTPc_ERR_FLASH         Flash sink requested while no flash driver is registered.
+*                               TFTPc_ERR_ERR_PKT_RX    Server answered with an ERROR pkt       (see Note #5).
+*                               TFTPc_ERR_TAR           Invalid, unsupported or truncated archive (see Note #6).
+*                               TFTPc_ERR_CANCELED      Transfer canceled by TFTPc_Cancel()     (see Note #3).
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded              (see Note #3).
 *
 *                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
 *                               See TFTPc_LockAcquire() for additional return error codes.
@@ -501,6 +1542,12 @@ exit:
 *                               ------------ RETURNED BY TFTPc_SockInit() ------------
 *                               See TFTPc_SockInit() for additional return error codes.
 *
+*                               ------------ RETURNED BY TFTPc_RelayPeerGet() ------------
+*                               See TFTPc_RelayPeerGet() for additional return error codes.
+*
+*                               ------------ RETURNED BY TFTPc_PoolGet() ------------
+*                               See TFTPc_PoolGet() for additional return error codes.
+*
 *                               ------------ RETURNED BY TFTPc_Processing() ------------
 *                               See TFTPc_Processing() for additional return error codes.
 *
@@ -512,7 +1559,88 @@ exit:
 *               This function is a TFTP client application interface (API) function & MAY be called by
 *               application function(s).
 *
-* Note(s)     : None.
+* Note(s)     : (1) When TFTPc_CFG_MCAST_EN is enabled, TFTPc_MODE_FLAG_MCAST asks the server to send the file
+*                   to a multicast group shared by all the clients reading it (RFC #2090).  The file is then
+*                   rx'd as a master client (ACK'ing) or as a passive listener, as instructed by the server;
+*                   the blocks missed are req'd once the server promotes the client to master.  If the server
+*                   does NOT support the option, the file is rx'd by unicast.
+*
+*               (2) When TFTPc_CFG_FLASH_EN is enabled, TFTPc_MODE_FLAG_FLASH writes the file to the flash
+*                   partition registered with TFTPc_FlashSet(), from its start, instead of a NetFS file;
+*                   'p_filename_local' is then ignored & MAY be NULL.
+*
+*               (3) When TFTPc_CFG_ABORT_EN is enabled, the transfer is aborted once it has lasted
+*                   'TransferTimeoutMax_ms' (if NOT 0) or when it is canceled with TFTPc_Cancel() :
+*
+*                   (a) An ERROR pkt is tx'd to the server, if it already answered the req.
+*                   (b) The socket & the local file are released before returning.  The part of the file
+*                       already rx'd is NOT removed from the local file system.
+*                   (c) The deadline & the cancel req are checked while waiting for pkts, for the backoff &
+*                       for the tx rate limit, & before & after the socket initialization (see TFTPc_SockInit()
+*                       Note #2).
+*
+*               (4) When TFTPc_CFG_BACKOFF_EN is enabled, the req is delayed by a random time & retried with
+*                   randomized exponential backoff (see 'tftp-c_cfg.h  TFTPc REQUEST BACKOFF CONFIGURATION').
+*
+*               (5) An ERROR pkt rx'd from the server ends the transfer; its code, message & class are obtained
+*                   with TFTPc_ServerErrGet().  The req is NEVER tx'd again over another IP family once the
+*                   server answered it : the IPv4 fallback of a hostname is only tried when the IPv6 socket
+*                   can NOT be opened or the req can NOT be tx'd.  Only transient ERRORs are retried, by the
+*                   request backoff (see Note #4).
+*
+*               (6) When TFTPc_CFG_TAR_EN is enabled, TFTPc_MODE_FLAG_TAR rx's a tar (ustar) archive & extracts
+*                   each of its files as the blocks arrive (see 'tftp-c_cfg.h  TFTPc ARCHIVE EXTRACTION
+*                   CONFIGURATION') :
+*
+*                   (a) 'p_filename_local' is the local directory the files are extracted to.  If an entry sink
+*                       is registered with TFTPc_TarSinkSet(), the files are passed to it instead & the
+*                       directory is ignored & MAY be NULL.
+*                   (b) The mode MUST be TFTPc_MODE_OCTET.  TFTPc_MODE_FLAG_CODEC MAY be set to extract a
+*                       compressed archive; TFTPc_MODE_FLAG_FLASH can NOT be set.  Multicast is NOT req'd,
+*                       since the archive MUST be rx'd in sequence.
+*                   (c) The files already extracted are NOT removed if the transfer fails.
+*
+*               (7) When TFTPc_CFG_SPARSE_EN is enabled, the blocks that only hold zero octets are NOT written
+*                   to the local file, & the erased pages are NOT programmed to flash (see 'tftp-c_cfg.h
+*                   TFTPc SPARSE WRITE CONFIGURATION').  Archive entries are always written.
+*
+*               (8) When TFTPc_CFG_RELAY_EN is enabled (see 'tftp-c_cfg.h  TFTPc LAN RELAY CONFIGURATION') :
+*
+*                   (a) An octet mode file is first req'd from the relay peers (see TFTPc_RelayPeerSet()).  The
+*                       server is only req'd if no peer has sent any block of the file.
+*                   (b) An octet mode file wr'n to NetFS without codec is recorded in the relay cache once
+*                       complete, to be served to the peers.  A local file being overwritten is removed from
+*                       the cache first.
+*                   (c) A file that can NOT be recorded in the relay cache, e.g. because its name is too long
+*                       (see TFTPc_RelayCacheAdd()), does NOT fail the transfer : it is only NOT served to the
+*                       peers.
+*
+*               (9) When TFTPc_CFG_POOL_EN is enabled & 'p_cfg' is NULL, the file is req'd from the servers
+*                   registered with TFTPc_PoolSet(), if any, instead of the server of the default configuration
+*                   (see 'tftp-c_cfg.h  TFTPc SERVER POOL CONFIGURATION') :
+*
+*                   (a) The servers are req'd in turn, from the one expected to answer first, until one of
+*                       them sends the whole file (see TFTPc_PoolGet()).  The relay peers, if any, are still
+*                       req'd first (see Note #8a).
+*                   (b) A transfer interrupted once blocks are wr'n is restarted against the next server only
+*                       if the file is wr'n to NetFS, without codec nor multicast.
+*
+*              (10) When TFTPc_CFG_BLKSIZE_EN is enabled, a block size larger than 512 octets is req'd (see
+*                   TFTPc_BlkSizeSet()) :
+*
+*                   (a) A transfer that times out before any block is rx'd is restarted once without the block
+*                       size option, since its blocks MAY be too large for the path (see
+*                       TFTPc_BlkSizeFallbackChk()).
+*                   (b) When probing is enabled, the outcome of the transfer is recorded to select the block
+*                       size of the next transfers.
+*
+*              (11) When TFTPc_CFG_BG_EN is enabled, TFTPc_MODE_FLAG_BG delays the ACKs while the round-trip
+*                   time rises, so that the transfer yields to the other traffic (see 'tftp-c_cfg.h  TFTPc
+*                   BACKGROUND TRANSFER CONFIGURATION').
+*
+*              (12) When TFTPc_CFG_WIN_ADAPT_EN is enabled, the losses & the round-trip time of the transfer
+*                   adapt the window size req'd by the next read (see 'tftp-c_cfg.h  TFTPc ADAPTIVE WINDOW
+*                   CONFIGURATION').
 *********************************************************************************************************
 */
 
@@ -530,6 +1658,10 @@ CPU_BOOLEAN  TFTPc_Get (const  TFTPc_CFG     *p_cfg,
     CPU_BOOLEAN          result;
     CPU_BOOLEAN          is_hostname;
     CPU_BOOLEAN          retry;
+    CPU_BOOLEAN          file_open;
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+    TFTPc_ERR            err;
+#endif
 
 
 #if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABELD)
@@ -537,7 +1669,9 @@ CPU_BOOLEAN  TFTPc_Get (const  TFTPc_CFG     *p_cfg,
         CPU_SW_EXCEPTION(;);
     }
 
-    if (p_filename_local == DEF_NULL) {
+    if ((p_filename_local == DEF_NULL) &&                       /* See Notes #2 & #6.                                   */
+        (DEF_BIT_IS_CLR(mode, TFTPc_MODE_FLAG_FLASH) == DEF_YES) &&
+        (DEF_BIT_IS_CLR(mode, TFTPc_MODE_FLAG_TAR)   == DEF_YES)) {
        *p_err = TFTPc_ERR_NULL_PTR;
         goto exit;
     }
@@ -557,6 +1691,7 @@ CPU_BOOLEAN  TFTPc_Get (const  TFTPc_CFG     *p_cfg,
     TFTPc_TRACE_INFO(("TFTPc_Get: Request for %s\n\r", p_filename_remote));
 
     TFTPc_InitSession();
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_STATE, TFTPc_TRACE_EVENT_SESSION_START, TFTPc_SessionID, TFTP_OPCODE_RRQ, mode);
 
     if (p_cfg == DEF_NULL) {
         p_cfg_to_use      = TFTPc_DfltCfgPtr;
@@ -571,56 +1706,143 @@ CPU_BOOLEAN  TFTPc_Get (const  TFTPc_CFG     *p_cfg,
     }
 
     if (ip_family == NET_IP_ADDR_FAMILY_NONE) {
-        ip_family_tmp = NET_IP_ADDR_FAMILY_IPv6;
+        ip_family_tmp = TFTPc_IP_ADDR_FAMILY_FIRST;
     } else {
         ip_family_tmp = ip_family;
     }
 
-                                                                /* Open file                                            */
-    TFTPc_FileHandle = TFTPc_FileOpenMode(p_filename_local, TFTPc_FILE_OPEN_WR);
-    if (TFTPc_FileHandle == (void *)0) {
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+    TFTPc_TxBucketInit(&TFTPc_TxBucketSession,
+                        p_cfg_to_use->TxRateMaxOctetsPerSec,
+                        p_cfg_to_use->TxBurstMaxOctets);
+#endif
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    TFTPc_AbortInit(p_cfg_to_use);                              /* Start transfer deadline (see Note #3).               */
+#endif
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+    TFTPc_BgActive = DEF_BIT_IS_SET(mode, TFTPc_MODE_FLAG_BG);  /* See Note #11.                                        */
+#endif
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+    TFTPc_BackoffStart(p_err);                                  /* Delay 1st req by a random time (see Note #4).        */
+    if (*p_err != TFTPc_ERR_NONE) {
         TFTPc_Terminate();
         result = DEF_FAIL;
-       *p_err  = TFTPC_ERR_FILE_OPEN;
         goto exit_release;
     }
+#endif
 
-    retry     = DEF_YES;
-    while (retry == DEF_YES) {
-        is_hostname = TFTPc_SockInit(p_server_hostname,         /* Init sock.                                           */
-                                     server_port,
-                                     ip_family_tmp,
-                                     p_err);
-        if (*p_err != TFTPc_ERR_NONE) {
-            if ((ip_family     == NET_IP_ADDR_FAMILY_NONE) &&
-                (ip_family_tmp == NET_IP_ADDR_FAMILY_IPv6) &&
-                (is_hostname   == DEF_YES)                ) {
-                 retry         = DEF_YES;
-                 ip_family_tmp = NET_IP_ADDR_FAMILY_IPv4;
-            } else {
-                TFTPc_Terminate();
-                retry  = DEF_NO;
-                result = DEF_FAIL;
-                goto exit_release;
-            }
-        } else {
-            retry = DEF_NO;
-        }
-
-        if (retry == DEF_NO) {
-                                                                /* Tx rd req.                                           */
-            TFTPc_TxReq(TFTP_OPCODE_RRQ, p_filename_remote, mode, p_err);
+    file_open = DEF_YES;
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    TFTPc_FlashSel(mode, p_err);                                /* Sel flash sink, if req'd (see Note #2).              */
+    if (*p_err != TFTPc_ERR_NONE) {
+        TFTPc_Terminate();
+        result = DEF_FAIL;
+        goto exit_release;
+    }
+
+    if (TFTPc_FlashActive == DEF_YES) {                         /* File data is wr'n to flash.                          */
+        file_open = DEF_NO;
+    }
+#endif
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+    TFTPc_TarSel(p_filename_local, mode, p_err);                /* Sel archive extraction, if req'd (see Note #6).      */
+    if (*p_err != TFTPc_ERR_NONE) {
+        TFTPc_Terminate();
+        result = DEF_FAIL;
+        goto exit_release;
+    }
+
+    if (TFTPc_TarActive == DEF_YES) {                           /* Each entry is wr'n to its own file.                  */
+        file_open = DEF_NO;
+    }
+#endif
+
+    if (file_open == DEF_YES) {                                 /* Open file                                            */
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+        TFTPc_RelayCacheRemove(p_filename_local);               /* See Note #8b.                                        */
+#endif
+        TFTPc_FileHandle = TFTPc_FileOpenMode(p_filename_local, TFTPc_FILE_OPEN_WR);
+        if (TFTPc_FileHandle == (void *)0) {
+            TFTPc_Terminate();
+            result = DEF_FAIL;
+           *p_err  = TFTPC_ERR_FILE_OPEN;
+            goto exit_release;
+        }
+    }
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    TFTPc_CodecSel(p_filename_remote, mode, DEF_NO, p_err);     /* Sel decoder, if any.                                 */
+    if (*p_err != TFTPc_ERR_NONE) {
+        TFTPc_Terminate();
+        result = DEF_FAIL;
+        goto exit_release;
+    }
+#endif
+
+    retry     = DEF_YES;
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+    if (TFTPc_RelayPeerGet(p_filename_remote, mode, p_err) == DEF_YES) {
+        retry = DEF_NO;                                         /* File rx'd from a peer (see Note #8a).                */
+    } else if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit_release;
+    }
+#endif
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+    if ((retry         == DEF_YES)  &&                          /* Req file from pool servers (see Note #9).            */
+        (p_cfg         == DEF_NULL) &&
+        (TFTPc_PoolNbr >  0u)) {
+        TFTPc_PoolGet(p_filename_remote, mode, p_err);
+        if (*p_err != TFTPc_ERR_NONE) {
+            result = DEF_FAIL;
+            goto exit_release;
+        }
+        retry = DEF_NO;
+    }
+#endif
+    while (retry == DEF_YES) {
+        is_hostname = TFTPc_SockInit(p_server_hostname,         /* Init sock.                                           */
+                                     server_port,
+                                     ip_family_tmp,
+                                     p_err);
+        if (*p_err != TFTPc_ERR_NONE) {
+            if ((ip_family     == NET_IP_ADDR_FAMILY_NONE) &&
+                (ip_family_tmp == NET_IP_ADDR_FAMILY_IPv6) &&
+                (is_hostname   == DEF_YES)                 &&
+                (TFTPc_ERR_IS_ABORT(*p_err) == DEF_NO)) {
+                 retry         = DEF_YES;
+                 ip_family_tmp = NET_IP_ADDR_FAMILY_IPv4;
+            } else {
+                TFTPc_Terminate();
+                retry  = DEF_NO;
+                result = DEF_FAIL;
+                goto exit_release;
+            }
+        } else {
+            retry = DEF_NO;
+        }
+
+        if (retry == DEF_NO) {
+                                                                /* Tx rd req.                                           */
+            TFTPc_TxReq(TFTP_OPCODE_RRQ, p_filename_remote, mode, p_err);
             if (*p_err != TFTPc_ERR_NONE) {
                 if ((ip_family     == NET_IP_ADDR_FAMILY_NONE) &&
                     (ip_family_tmp == NET_IP_ADDR_FAMILY_IPv6) &&
-                    (is_hostname   == DEF_YES)                ) {
+                    (is_hostname   == DEF_YES)                 &&
+                    (TFTPc_ERR_IS_ABORT(*p_err) == DEF_NO)) {
                      retry         = DEF_YES;
                      ip_family_tmp = NET_IP_ADDR_FAMILY_IPv4;
                 } else {
                     TFTPc_Terminate();
                     retry  = DEF_NO;
                     result = DEF_FAIL;
-                   *p_err  = TFTPc_ERR_TX;
+                    if (TFTPc_ERR_IS_ABORT(*p_err) == DEF_NO) {
+                       *p_err = TFTPc_ERR_TX;
+                    }
                     goto exit_release;
                 }
             } else {
@@ -628,12 +1850,26 @@ CPU_BOOLEAN  TFTPc_Get (const  TFTPc_CFG     *p_cfg,
             }
 
             if (retry == DEF_NO) {
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+                TFTPc_FlashPreErase();                          /* Erase 1st sector while req is in flight.             */
+#endif
                                                                 /* Process req.                                         */
                 TFTPc_RxBlkNbrNext = 1;
                 TFTPc_State        = TFTPc_STATE_DATA_GET;
 
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+                TFTPc_SessionKeep  = DEF_YES;
+                TFTPc_Processing(p_cfg_to_use, p_err);
+                TFTPc_SessionKeep  = DEF_NO;
+                if (TFTPc_BlkSizeFallbackChk(*p_err) == DEF_YES) {
+                    retry = DEF_YES;                            /* Re-tx req w/o blk size (see Note #10a).              */
+                    continue;
+                }
+#else
                 TFTPc_Processing(p_cfg_to_use, p_err);
+#endif
                 if (*p_err != TFTPc_ERR_NONE) {
+                     TFTPc_Terminate();
                      result = DEF_FAIL;
                      goto exit_release;
                 }
@@ -644,11 +1880,27 @@ CPU_BOOLEAN  TFTPc_Get (const  TFTPc_CFG     *p_cfg,
         }
     }
 
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+    if ((file_open == DEF_YES) &&                               /* See Note #8b.                                        */
+       ((mode & (TFTPc_MODE)~(TFTPc_MODE_FLAG_MCAST | TFTPc_MODE_FLAG_BG)) == TFTPc_MODE_OCTET)) {
+       (void)TFTPc_RelayCacheAdd(p_filename_remote, p_filename_local, &err);
+        if (err != TFTPc_ERR_NONE) {                            /* See Note #8c.                                        */
+            TFTPc_TRACE_INFO(("TFTPc_Get: %s NOT cached, err %u\n\r", p_filename_local, (unsigned)err));
+        }
+    }
+#endif
+
     result = DEF_OK;
    *p_err  = TFTPc_ERR_NONE;
 
 
 exit_release:
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+    TFTPc_BlkSizeProbeUpdate(*p_err);                           /* See Note #10.                                        */
+#endif
+#ifdef  TFTPc_WIN_ADAPT_EN
+    TFTPc_WinAdaptUpdate(*p_err);                               /* See Note #12.                                        */
+#endif
     TFTPc_LockRelease();
 
 exit:
@@ -675,11 +1927,18 @@ exit:
 *                                       TFTPc_MODE_NETASCII     ASCII  mode.
 *                                       TFTPc_MODE_OCTET        Binary mode.
 *
+*                                   OR'd with the following flag, if needed :
+*
+*                                       TFTPc_MODE_FLAG_BG      Background transfer (see Note #4).
+*
 *               p_err       Pointer to variable that will receive the return error code from this function :
 *
 *                               TFTPc_ERR_NONE          TFTP operation was successful.
 *                               TFTPC_ERR_FILE_OPEN     File opening failed.
 *                               TFTPc_ERR_TX            Transmission of TFTP request faulted.
+*                               TFTPc_ERR_ERR_PKT_RX    Server answered with an ERROR pkt       (see Note #3).
+*                               TFTPc_ERR_CANCELED      Transfer canceled by TFTPc_Cancel()     (see Note #1).
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded              (see Note #1).
 *
 *                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
 *                               See TFTPc_LockAcquire() for additional return error codes.
@@ -698,10 +1957,22 @@ exit:
 *               This function is a TFTP client application interface (API) function & MAY be called by
 *               application function(s).
 *
-* Note(s)     : None.
+* Note(s)     : (1) When TFTPc_CFG_ABORT_EN is enabled, the transfer is aborted once it has lasted
+*                   'TransferTimeoutMax_ms' (if NOT 0) or when it is canceled with TFTPc_Cancel() (see
+*                   TFTPc_Get() Note #3).
+*
+*               (2) When TFTPc_CFG_BACKOFF_EN is enabled, the req is delayed by a random time & retried with
+*                   randomized exponential backoff (see TFTPc_Get() Note #4).
+*
+*               (3) An ERROR pkt rx'd from the server ends the transfer & is NEVER retried over another IP
+*                   family (see TFTPc_Get() Note #5).
+*
+*               (4) When TFTPc_CFG_BG_EN is enabled, TFTPc_MODE_FLAG_BG delays the blocks while the round-trip
+*                   time rises (see TFTPc_Get() Note #11).
 *********************************************************************************************************
 */
 
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
 CPU_BOOLEAN  TFTPc_Put (const  TFTPc_CFG   *p_cfg,
                                CPU_CHAR    *p_filename_local,
                                CPU_CHAR    *p_filename_remote,
@@ -743,6 +2014,7 @@ CPU_BOOLEAN  TFTPc_Put (const  TFTPc_CFG   *p_cfg,
     TFTPc_TRACE_INFO(("TFTPc_Put: Request for %s\n\r", p_filename_local));
 
     TFTPc_InitSession();
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_STATE, TFTPc_TRACE_EVENT_SESSION_START, TFTPc_SessionID, TFTP_OPCODE_WRQ, mode);
 
     if (p_cfg == DEF_NULL) {
         p_cfg_to_use      = TFTPc_DfltCfgPtr;
@@ -757,19 +2029,52 @@ CPU_BOOLEAN  TFTPc_Put (const  TFTPc_CFG   *p_cfg,
     }
 
     if (ip_family == NET_IP_ADDR_FAMILY_NONE) {
-        ip_family_tmp = NET_IP_ADDR_FAMILY_IPv6;
+        ip_family_tmp = TFTPc_IP_ADDR_FAMILY_FIRST;
     } else {
         ip_family_tmp = ip_family;
     }
 
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+    TFTPc_TxBucketInit(&TFTPc_TxBucketSession,
+                        p_cfg_to_use->TxRateMaxOctetsPerSec,
+                        p_cfg_to_use->TxBurstMaxOctets);
+#endif
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    TFTPc_AbortInit(p_cfg_to_use);                              /* Start transfer deadline (see Note #1).               */
+#endif
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+    TFTPc_BgActive = DEF_BIT_IS_SET(mode, TFTPc_MODE_FLAG_BG);  /* See Note #4.                                         */
+#endif
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+    TFTPc_BackoffStart(p_err);                                  /* Delay 1st req by a random time (see Note #2).        */
+    if (*p_err != TFTPc_ERR_NONE) {
+        TFTPc_Terminate();
+        result = DEF_FAIL;
+        goto exit_release;
+    }
+#endif
+
                                                                 /* Open file.                                           */
     TFTPc_FileHandle = TFTPc_FileOpenMode(p_filename_local, TFTPc_FILE_OPEN_RD);
     if (TFTPc_FileHandle == (void *)0) {
+        TFTPc_Terminate();
         result = DEF_FAIL;
        *p_err  = TFTPC_ERR_FILE_OPEN;
         goto exit_release;
     }
 
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    TFTPc_CodecSel(p_filename_remote, mode, DEF_YES, p_err);    /* Sel encoder, if any.                                 */
+    if (*p_err != TFTPc_ERR_NONE) {
+        TFTPc_Terminate();
+        result = DEF_FAIL;
+        goto exit_release;
+    }
+#endif
+
     retry     = DEF_YES;
     while (retry == DEF_YES) {
 
@@ -780,7 +2085,8 @@ CPU_BOOLEAN  TFTPc_Put (const  TFTPc_CFG   *p_cfg,
         if (*p_err != TFTPc_ERR_NONE) {
             if ((ip_family     == NET_IP_ADDR_FAMILY_NONE) &&
                 (ip_family_tmp == NET_IP_ADDR_FAMILY_IPv6) &&
-                (is_hostname   == DEF_YES)                ) {
+                (is_hostname   == DEF_YES)                 &&
+                (TFTPc_ERR_IS_ABORT(*p_err) == DEF_NO)) {
                  retry     = DEF_YES;
                  ip_family_tmp = NET_IP_ADDR_FAMILY_IPv4;
 
@@ -800,14 +2106,17 @@ CPU_BOOLEAN  TFTPc_Put (const  TFTPc_CFG   *p_cfg,
             if (*p_err != TFTPc_ERR_NONE) {
                 if ((ip_family     == NET_IP_ADDR_FAMILY_NONE) &&
                     (ip_family_tmp == NET_IP_ADDR_FAMILY_IPv6) &&
-                    (is_hostname   == DEF_YES)                ) {
+                    (is_hostname   == DEF_YES)                 &&
+                    (TFTPc_ERR_IS_ABORT(*p_err) == DEF_NO)) {
                      retry         = DEF_YES;
                      ip_family_tmp = NET_IP_ADDR_FAMILY_IPv4;
                 } else {
                     TFTPc_Terminate();
                     retry  = DEF_NO;
                     result = DEF_FAIL;
-                   *p_err  = TFTPc_ERR_TX;
+                    if (TFTPc_ERR_IS_ABORT(*p_err) == DEF_NO) {
+                       *p_err = TFTPc_ERR_TX;
+                    }
                     goto exit_release;
                 }
             } else {
@@ -821,6 +2130,7 @@ CPU_BOOLEAN  TFTPc_Put (const  TFTPc_CFG   *p_cfg,
 
                 TFTPc_Processing(p_cfg_to_use, p_err);
                 if (*p_err != TFTPc_ERR_NONE) {
+                     TFTPc_Terminate();
                      result = DEF_FAIL;
                      goto exit_release;
                 }
@@ -840,754 +2150,8098 @@ exit_release:
 exit:
     return (result);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*********************************************************************************************************
-*                                           LOCAL FUNCTIONS
-*********************************************************************************************************
-*********************************************************************************************************
-*/
-
-/*
-*********************************************************************************************************
-*                                          TFTPc_LockAcquire()
+*                                          TFTPc_StatsGet()
 *
-* Description : $$$$ Add function description.
+* Description : Get the statistics of the last (or current) transfer session.
 *
-* Argument(s) : p_err   $$$$ Add description for 'p_err'
+* Argument(s) : p_stats     Pointer to variable that will receive the statistics.
 *
-* Return(s)   : $$$$ Add return value description.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-* Caller(s)   : none.
+*                               TFTPc_ERR_NONE          Statistics successfully copied.
+*                               TFTPc_ERR_NULL_PTR      Null pointer was passed as argument.
 *
-* Note(s)     : none.
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if statistics were copied successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Since the TFTPc lock is held for the whole duration of a transfer, this function waits
+*                   for the transfer in progress, if any, to complete.
 *********************************************************************************************************
 */
 
-static  void  TFTPc_LockAcquire (TFTPc_ERR  *p_err)
+#if (TFTPc_CFG_STAT_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_StatsGet (TFTPc_STATS  *p_stats,
+                             TFTPc_ERR    *p_err)
 {
-    KAL_ERR  err;
+    CPU_BOOLEAN  result;
 
 
-    KAL_LockAcquire(TFTPc_LockHandle, KAL_OPT_PEND_NONE, 0, &err);
-    if (err != KAL_ERR_NONE) {
-       *p_err = TFTPc_ERR_LOCK;
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+
+    if (p_stats == DEF_NULL) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
         goto exit;
     }
+#endif
 
-   *p_err = TFTPc_ERR_NONE;
+    TFTPc_LockAcquire(p_err);                                   /* See Note #1.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+   *p_stats = TFTPc_Stats;
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
 
 
 exit:
-    return;
+    return (result);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                          TFTPc_LockRelease()
+*                                        TFTPc_ServerErrGet()
 *
-* Description : $$$$ Add function description.
+* Description : Get the ERROR pkt rx'd from the server during the last (or current) transfer session.
 *
-* Argument(s) : none.
+* Argument(s) : p_server_err    Pointer to variable that will receive the server ERROR code, message & class.
 *
-* Return(s)   : $$$$ Add return value description.
+*               p_err           Pointer to variable that will receive the return error code from this function :
 *
-* Caller(s)   : none.
+*                                   TFTPc_ERR_NONE          Server ERROR successfully copied.
+*                                   TFTPc_ERR_NULL_PTR      Null pointer was passed as argument.
 *
-* Note(s)     : none.
+*                                   ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                                   See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if server ERROR was copied successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Since the TFTPc lock is held for the whole duration of a transfer, this function waits
+*                   for the transfer in progress, if any, to complete.
+*
+*               (2) An application polling the server for a file SHOULD stop retrying when TFTPc_Get() or
+*                   TFTPc_Put() returns TFTPc_ERR_ERR_PKT_RX with a TFTPc_ERR_CLASS_PERMANENT ERROR (e.g.
+*                   file not found).
 *********************************************************************************************************
 */
 
-static  void  TFTPc_LockRelease (void)
+CPU_BOOLEAN  TFTPc_ServerErrGet (TFTPc_SERVER_ERR  *p_server_err,
+                                 TFTPc_ERR         *p_err)
 {
-    KAL_ERR  err;
+    CPU_BOOLEAN  result;
 
 
-    KAL_LockRelease(TFTPc_LockHandle, &err);
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+
+    if (p_server_err == DEF_NULL) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
+
+    TFTPc_LockAcquire(p_err);                                   /* See Note #1.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+   *p_server_err = TFTPc_ServerErr;
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
 }
 
 
 /*
 *********************************************************************************************************
-*                                          TFTPc_InitSession()
+*                                       TFTPc_TxRateLimitSet()
 *
-* Description : Initialize the TFTP session.
+* Description : Configure the global tx rate limit, shared by all transfer sessions.
 *
-* Argument(s) : none.
+* Argument(s) : rate_max_octets_per_sec     Maximum average tx rate (in octets per second).
 *
-* Return(s)   : none.
+*                                               0, if tx rate is NOT limited.
 *
-* Caller(s)   : TFTPc_Get(),
-*               TFTPc_Put().
+*               burst_max_octets            Maximum nbr of octets that can be tx'd back-to-back when the
+*                                           link was idle.
 *
-* Note(s)     : none.
+*                                               0, to allow a single packet.
+*
+*               p_err                       Pointer to variable that will receive the return error code from
+*                                           this function :
+*
+*                                               TFTPc_ERR_NONE      Rate limit successfully configured.
+*
+*                                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                                               See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if rate limit was configured successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Each session is also limited by the 'TxRateMaxOctetsPerSec' & 'TxBurstMaxOctets'
+*                   fields of its configuration (see 'tftp-c_cfg.h  TFTPc TX RATE LIMIT CONFIGURATION').
+*
+*               (2) Since the TFTPc lock is held for the whole duration of a transfer, the new limit takes
+*                   effect once the transfer in progress, if any, completes.
 *********************************************************************************************************
 */
 
-static  void  TFTPc_InitSession (void)
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_TxRateLimitSet (CPU_INT32U   rate_max_octets_per_sec,
+                                   CPU_INT32U   burst_max_octets,
+                                   TFTPc_ERR   *p_err)
 {
-    TFTPc_SockID     =  NET_SOCK_ID_NONE;
-    TFTPc_FileHandle = (void *)0;
+    CPU_BOOLEAN  result;
 
-    TFTPc_RxPktLen   =  0;
-    TFTPc_TxPktLen   =  0;
 
-    TFTPc_TxPktRetry =  0;
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+#endif
 
-    TFTPc_TID_Set    =  DEF_NO;
+    TFTPc_LockAcquire(p_err);                                   /* See Note #2.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    TFTPc_TxBucketInit(&TFTPc_TxBucketGlobal,
+                        rate_max_octets_per_sec,
+                        burst_max_octets);
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                          TFTPc_SockInit()
+*                                         TFTPc_ProfileGet()
 *
-* Description : Initialize the communication socket.
+* Description : Get the phase profile of the last (or current) transfer session.
 *
-* Argument(s) : p_server_hostname     Pointer to hostname or IP address string of the TFTP server.
+* Argument(s) : p_profile   Pointer to variable that will receive the phase profile.
 *
-*               server_port           Port number of the TFTP server.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-* Return(s)   : Error message:
+*                               TFTPc_ERR_NONE          Profile successfully copied.
+*                               TFTPc_ERR_NULL_PTR      Null pointer was passed as argument.
 *
-*               TFTPc_ERR_NONE                      No error.
-*               TFTPc_ERR_NO_SOCK                   Could not open socket.
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
 *
-* Caller(s)   : TFTPc_Get(),
-*               TFTPc_Put().
+* Return(s)   : DEF_OK,   if profile was copied successfully.
+*               DEF_FAIL, otherwise.
 *
-* Note(s)     : none.
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Since the TFTPc lock is held for the whole duration of a transfer, this function waits
+*                   for the transfer in progress, if any, to complete.
+*
+*               (2) Phase durations are expressed in CPU timestamp timer counts.
 *********************************************************************************************************
 */
 
-static  CPU_BOOLEAN  TFTPc_SockInit (CPU_CHAR            *p_server_hostname,
-                                     NET_PORT_NBR         server_port,
-                                     NET_IP_ADDR_FAMILY   ip_family,
-                                     TFTPc_ERR           *p_err)
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_ProfileGet (TFTPc_PROFILE  *p_profile,
+                               TFTPc_ERR      *p_err)
 {
-    NET_SOCK_ID    *p_sock_id;
-    NET_SOCK_ADDR  *p_server_sock_addr;
-    CPU_BOOLEAN     is_hostname;
-    NET_ERR         err;
+    TFTPc_PROFILE_PHASE  *p_phase;
+    CPU_INT08U            phase;
+    CPU_BOOLEAN           result;
 
 
-    p_sock_id          = &TFTPc_SockID;
-    p_server_sock_addr = &TFTPc_SockAddr;
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
 
-    (void)NetApp_ClientDatagramOpenByHostname(p_sock_id,
-                                              p_server_hostname,
-                                              server_port,
-                                              ip_family,
-                                              p_server_sock_addr,
-                                             &is_hostname,
-                                             &err);
-    if (err != NET_APP_ERR_NONE) {
-       *p_err = TFTPc_ERR_INVALID_PROTO_FAMILY;
+    if (p_profile == DEF_NULL) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
         goto exit;
     }
+#endif
 
-   (void)NetSock_CfgBlock(*p_sock_id, NET_SOCK_BLOCK_SEL_BLOCK, &err);
+    TFTPc_LockAcquire(p_err);                                   /* See Note #1.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
 
-   *p_err = TFTPc_ERR_NONE;
+   *p_profile = TFTPc_Profile;
+
+    for (phase = 0u; phase < TFTPc_PROFILE_PHASE_NBR; phase++) {
+        p_phase = &p_profile->Phase[phase];
+        if (p_phase->NbrSamples > 0u) {
+            p_phase->Mean = (CPU_TS32)(p_phase->Total / p_phase->NbrSamples);
+        }
+    }
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
 
 
 exit:
-    return (is_hostname);
+    return (result);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                         TFTPc_Processing()
+*                                          TFTPc_CodecSet()
 *
-* Description : Process data transfer.
+* Description : Register the codec used by the following transfer sessions.
 *
-* Argument(s) : p_cfg       Pointer to TFTPc configuration object.
+* Argument(s) : p_codec     Pointer to codec (see 'tftp-c.h  TFTPc CODEC DATA TYPE').
 *
-*               p_err       Pointer to variable that will receive the return error code from this function :
+*                               DEF_NULL, to remove the registered codec.
 *
-*                               TFTPc_ERR_NONE                  Data transfer successful.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                                                               ------- RETURNED BY TFTPc_RxPkt() : -------
-*                               TFTPc_ERR_RX_TIMEOUT            Receive timeout.
-*                               TFTPc_ERR_RX                    Error receiving packet.
+*                               TFTPc_ERR_NONE          Codec successfully registered.
+*                               TFTPc_ERR_NULL_PTR      Codec function pointer(s) passed NULL pointer(s).
 *
-*                                                               ----- RETURNED BY TFTPc_StateDataGet() : -----
-*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
-*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received.
-*                               TFTPc_ERR_FILE_WR               Error writing to file.
-*                               TFTPc_ERR_TX                    Error transmitting packet.
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
 *
-*                                                               ----- RETURNED BY TFTPc_StateDataPut() : -----
-*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
-*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received.
-*                               TFTPc_ERR_INVALID_STATE         Invalid state machine state.
-*                               TFTPc_ERR_FILE_RD               Error reading file.
-*                               TFTPc_ERR_TX                    Error transmitting packet.
+* Return(s)   : DEF_OK,   if codec was registered successfully.
+*               DEF_FAIL, otherwise.
 *
-*                                                               ----- RETURNED BY TFTPc_TxPkt() : -----
-*                               TFTPc_ERR_TX                    Error transmitting packet.
+* Caller(s)   : Application.
 *
-* Return(s)   : none.
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
 *
-* Caller(s)   : TFTPc_Get(),
-*               TFTPc_Put().
+* Note(s)     : (1) The codec structure is referenced, NOT copied : it MUST remain valid while registered.
 *
-* Note(s)     : none.
+*               (2) Since the TFTPc lock is held for the whole duration of a transfer, the codec takes effect
+*                   once the transfer in progress, if any, completes.
 *********************************************************************************************************
 */
 
-static  void  TFTPc_Processing (const  TFTPc_CFG  *p_cfg,
-                                       TFTPc_ERR  *p_err)
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_CodecSet (const  TFTPc_CODEC  *p_codec,
+                                    TFTPc_ERR    *p_err)
 {
-    NET_SOCK_RTN_CODE  rx_pkt_len;
-    NET_SOCK_ADDR_LEN  sock_addr_size;
-    CPU_INT32U         timeout;
-    NET_ERR            err_net;
-
+    CPU_BOOLEAN  result;
 
-                                                                /* Set rx sock timeout.                                 */
-    timeout = p_cfg->RxInactivityTimeout_ms;
-    NetSock_CfgTimeoutRxQ_Set(TFTPc_SockID,
-                              timeout,
-                             &err_net);
 
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
 
+    if ((p_codec          != DEF_NULL) &&
+       ((p_codec->Init    == DEF_NULL) ||
+        (p_codec->Process == DEF_NULL))) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
 
-    while (TFTPc_State != TFTPc_STATE_TRANSFER_COMPLETE) {
+    TFTPc_LockAcquire(p_err);                                   /* See Note #2.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
 
-        rx_pkt_len = TFTPc_RxPkt((NET_SOCK_ID    ) TFTPc_SockID,
-                                 (void          *)&TFTPc_RxPktBuf[0],
-                                 (CPU_INT16U     ) sizeof(TFTPc_RxPktBuf),
-                                 (TFTPc_ERR     *) p_err);
-        switch (*p_err) {
-            case TFTPc_ERR_NONE:
-                 TFTPc_RxPktLen    = rx_pkt_len;
-                 TFTPc_RxPktOpcode = NET_UTIL_VAL_GET_NET_16(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_OPCODE]);
+    TFTPc_CodecPtr = p_codec;                                   /* See Note #1.                                         */
 
-                 switch (TFTPc_State) {
-                     case TFTPc_STATE_DATA_GET:
-                          TFTPc_StateDataGet(p_err);
-                          break;
+    TFTPc_LockRelease();
 
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
 
-                     case TFTPc_STATE_DATA_PUT:
-                     case TFTPc_STATE_DATA_PUT_WAIT_LAST_ACK:
-                          TFTPc_StateDataPut(p_err);
-                          break;
 
+exit:
+    return (result);
+}
+#endif
 
-                     default:
-                         *p_err = TFTPc_ERR_INVALID_STATE;
-                          break;
-                 }
 
-                 break;
+/*
+*********************************************************************************************************
+*                                          TFTPc_FlashSet()
+*
+* Description : Register the flash driver used by the following transfer sessions.
+*
+* Argument(s) : p_flash     Pointer to flash driver (see 'tftp-c.h  TFTPc FLASH DRIVER DATA TYPE').
+*
+*                               DEF_NULL, to remove the registered flash driver.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Flash driver successfully registered.
+*                               TFTPc_ERR_NULL_PTR      Driver function pointer(s) passed NULL pointer(s).
+*                               TFTPc_ERR_CFG_INVALID   Invalid flash geometry.
+*
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if flash driver was registered successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The flash driver structure is referenced, NOT copied : it MUST remain valid while
+*                   registered.
+*
+*               (2) See 'tftp-c.h  TFTPc FLASH DRIVER DATA TYPE  Note #2'.
+*
+*               (3) Since the TFTPc lock is held for the whole duration of a transfer, the flash driver takes
+*                   effect once the transfer in progress, if any, completes.
+*********************************************************************************************************
+*/
 
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_FlashSet (const  TFTPc_FLASH  *p_flash,
+                                    TFTPc_ERR    *p_err)
+{
+    CPU_BOOLEAN  result;
 
-            case TFTPc_ERR_RX_TIMEOUT:
-                 if (TFTPc_TxPktLen > 0) {                      /* If pkt tx'd ...                                      */
-                                                                /* ... and max retry NOT reached, ...                   */
-                     if (TFTPc_TxPktRetry < TFTPc_MAX_NBR_TX_RETRY) {
-                                                                /* ... re-tx last tx'd pkt.                             */
-                          sock_addr_size = sizeof(NET_SOCK_ADDR);
-                         (void)TFTPc_TxPkt((NET_SOCK_ID      ) TFTPc_SockID,
-                                           (void            *)&TFTPc_TxPktBuf[0],
-                                           (CPU_INT16U       ) TFTPc_TxPktLen,
-                                           (NET_SOCK_ADDR   *)&TFTPc_SockAddr,
-                                           (NET_SOCK_ADDR_LEN) sock_addr_size,
-                                           (TFTPc_ERR       *) p_err);
 
-                         TFTPc_TxPktRetry++;
-                     }
-                 }
-                 break;
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
 
+    if ((p_flash              != DEF_NULL) &&
+       ((p_flash->SectorErase == DEF_NULL) ||
+        (p_flash->PageProg    == DEF_NULL))) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
 
-            case TFTPc_ERR_RX:
-            default:
-                 break;
+    if (p_flash != DEF_NULL) {                                  /* Validate geometry (see Note #2).                     */
+        if ((p_flash->Size       ==  0u)                            ||
+            (p_flash->PageSize   ==  0u)                            ||
+            (p_flash->PageSize   >   TFTPc_CFG_FLASH_PAGE_SIZE_MAX) ||
+            (p_flash->SectorSize <   p_flash->PageSize)             ||
+           ((p_flash->SectorSize %   p_flash->PageSize)   != 0u)    ||
+           ((p_flash->Size       %   p_flash->SectorSize) != 0u)) {
+           *p_err  = TFTPc_ERR_CFG_INVALID;
+            result = DEF_FAIL;
+            goto exit;
         }
+    }
 
-        if (*p_err != TFTPc_ERR_NONE) {
-             TFTPc_TRACE_INFO(("TFTPc_Processing: Error, session terminated\n\r"));
-             TFTPc_State = TFTPc_STATE_TRANSFER_COMPLETE;
-        }
+    TFTPc_LockAcquire(p_err);                                   /* See Note #3.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
     }
 
-    TFTPc_Terminate();
+    TFTPc_FlashPtr = p_flash;                                   /* See Note #1.                                         */
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                        TFTPc_StateDataGet()
+*                                         TFTPc_TarSinkSet()
 *
-* Description : Process received packets for a read request.
+* Description : Register the entry sink that receives the files extracted from an archive by the following
+*               transfer sessions.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : p_sink      Pointer to entry sink (see 'tftp-c.h  TFTPc ARCHIVE ENTRY SINK DATA TYPE').
 *
-*                               TFTPc_ERR_NONE                  No error.
-*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
-*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received.
+*                               DEF_NULL, to remove the registered sink & extract the files to NetFS.
 *
-*                                                               ------- RETURNED BY TFTPc_DataWr() : -------
-*                               TFTPc_ERR_FILE_WR               Error writing to file.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                                                               ------- RETURNED BY TFTPc_TxAck() : -------
-*                               TFTPc_ERR_TX                    Error transmitting packet.
-* Return(s)   : none.
+*                               TFTPc_ERR_NONE          Entry sink successfully registered.
+*                               TFTPc_ERR_NULL_PTR      Sink function pointer(s) passed NULL pointer(s).
 *
-* Caller(s)   : TFTPc_Processing().
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if entry sink was registered successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
 *
-* Note(s)     : (1) If the data block received is not the expected one, nothing is written in the file,
-*                   and the function silently returns.
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The entry sink structure is referenced, NOT copied : it MUST remain valid while registered.
+*
+*               (2) Since the TFTPc lock is held for the whole duration of a transfer, the entry sink takes
+*                   effect once the transfer in progress, if any, completes.
 *********************************************************************************************************
 */
 
-static  void  TFTPc_StateDataGet (TFTPc_ERR  *p_err)
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_TarSinkSet (const  TFTPc_TAR_SINK  *p_sink,
+                                      TFTPc_ERR       *p_err)
 {
-    CPU_INT16U  rx_blk_nbr;
-    CPU_INT16U  wr_data_len;
-    TFTPc_ERR   err;
-
-
-    switch (TFTPc_RxPktOpcode) {
-        case TFTP_OPCODE_DATA:
-             TFTPc_TRACE_INFO(("TFTPc_StateDataGet: Opcode DATA rx'd\n\r"));
-            *p_err = TFTPc_ERR_NONE;
-             break;
-
+    CPU_BOOLEAN  result;
 
-        case TFTP_OPCODE_ERR:
-             TFTPc_TRACE_INFO(("TFTPc_StateDataGet: Opcode ERROR rx'd\n\r"));
-            *p_err = TFTPc_ERR_ERR_PKT_RX;
-             break;
 
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
 
-        case TFTP_OPCODE_ACK:
-        case TFTP_OPCODE_WRQ:
-        case TFTP_OPCODE_RRQ:
-        default:
-             TFTPc_TRACE_INFO(("TFTPc_StateDataGet: Invalid opcode rx'd\n\r"));
-             TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_ILLEGAL_OP,
-                         (CPU_CHAR  *) 0,
-                         (TFTPc_ERR *)&err);
-            *p_err = TFTPc_ERR_INVALID_OPCODE_RX;
-             break;
+    if ((p_sink            != DEF_NULL) &&
+       ((p_sink->EntryOpen == DEF_NULL) ||
+        (p_sink->EntryWr   == DEF_NULL))) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
+        goto exit;
     }
+#endif
 
+    TFTPc_LockAcquire(p_err);                                   /* See Note #2.                                         */
     if (*p_err != TFTPc_ERR_NONE) {
-         return;
+        result = DEF_FAIL;
+        goto exit;
     }
 
+    TFTPc_TarSinkPtr = p_sink;                                  /* See Note #1.                                         */
 
-    rx_blk_nbr = TFTPc_GetRxBlkNbr();                           /* Get rx'd pkt's blk nbr.                              */
+    TFTPc_LockRelease();
 
-    if (rx_blk_nbr == TFTPc_RxBlkNbrNext) {                     /* If data blk nbr expected, (see Note #1) ...          */
-        wr_data_len = TFTPc_DataWr(p_err);                      /* ... wr data to file                ...               */
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
 
-        if (*p_err == TFTPc_ERR_NONE) {
-            TFTPc_TxAck(rx_blk_nbr, &err);                      /* ... and tx ack.                                      */
-            TFTPc_TxPktRetry = 0;
 
-            if (wr_data_len < TFTPc_DATA_BLOCK_SIZE) {          /* If rx'd data len < TFTP blk size, ...                */
-                TFTPc_State = TFTPc_STATE_TRANSFER_COMPLETE;    /* ... last blk rx'd.                                   */
+exit:
+    return (result);
+}
+#endif
 
-            } else {
-                TFTPc_RxBlkNbrNext++;
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelayPeerSet()
+*
+* Description : Register the relay peers from which the following transfer sessions first request a file.
+*
+* Argument(s) : p_peers     Pointer to table of peer configurations (see Note #1).
+*
+*                               DEF_NULL, to remove the registered peers & request files from the server only.
+*
+*               nbr_peers   Number of peers in the table.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Peers successfully registered.
+*
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if peers were registered successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Each peer is described by a TFTPc configuration : the hostname, port & IP family of the
+*                   peer responder, & the rx inactivity timeout used while it is req'd.  The peers are tried
+*                   in table order.
+*
+*               (2) The peer table is referenced, NOT copied : it MUST remain valid while registered.
+*
+*               (3) Since the TFTPc lock is held for the whole duration of a transfer, the peers take effect
+*                   once the transfer in progress, if any, completes.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_RelayPeerSet (const  TFTPc_CFG   *p_peers,
+                                        CPU_INT08U   nbr_peers,
+                                        TFTPc_ERR   *p_err)
+{
+    CPU_BOOLEAN  result;
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+#endif
+
+    TFTPc_LockAcquire(p_err);                                   /* See Note #3.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    if ((p_peers   == DEF_NULL) ||
+        (nbr_peers == 0u)) {
+        TFTPc_RelayPeerTbl = DEF_NULL;
+        TFTPc_RelayPeerNbr = 0u;
+    } else {
+        TFTPc_RelayPeerTbl = p_peers;                           /* See Note #2.                                         */
+        TFTPc_RelayPeerNbr = nbr_peers;
+    }
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelayCacheAdd()
+*
+* Description : Record a local file in the relay cache, to be served to the LAN peers.
+*
+* Argument(s) : p_filename_remote   Pointer to name of the file, as req'd by the peers.
+*
+*               p_filename_local    Pointer to name of the local file served.
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       TFTPc_ERR_NONE          File successfully recorded.
+*                                       TFTPc_ERR_NULL_PTR      Argument(s) passed NULL pointer(s).
+*                                       TFTPc_ERR_RELAY         Name too long (see 'tftp-c_cfg.h  TFTPc LAN RELAY
+*                                                                   CONFIGURATION  Note #3').
+*
+*                                       ----------- RETURNED BY TFTPc_RelayLockAcquire() -----------
+*                                       See TFTPc_RelayLockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if file was recorded successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application,
+*               TFTPc_Get().
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) TFTPc_Get() records the files it rx's (see 'TFTPc_Get()  Note #8b').  The application MAY
+*                   also record files obtained otherwise, e.g. a firmware image stored at production.
+*
+*               (2) The entry of a file already recorded under the same remote name is updated.  Otherwise, a
+*                   free entry is used or, if the cache is full, the entries are replaced in turn.
+*
+*               (3) The relay lock is NOT held while a transfer runs, & is only held by TFTPc_RelaySrvProcess()
+*                   to look up the cache & to read each block : the cache can be updated while a peer is
+*                   served.  Updating the entry being served ends the transfer to the peer (see
+*                   'TFTPc_RelaySrvProcess()  Note #3').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_RelayCacheAdd (const  CPU_CHAR   *p_filename_remote,
+                                  const  CPU_CHAR   *p_filename_local,
+                                         TFTPc_ERR  *p_err)
+{
+    TFTPc_RELAY_CACHE_ENTRY  *p_entry;
+    CPU_INT08U                ix;
+    CPU_BOOLEAN               result;
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+
+    if ((p_filename_remote == DEF_NULL) ||
+        (p_filename_local  == DEF_NULL)) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
+
+    if ((Str_Len_N(p_filename_remote, TFTPc_CFG_RELAY_NAME_LEN_MAX + 1u) > TFTPc_CFG_RELAY_NAME_LEN_MAX) ||
+        (Str_Len_N(p_filename_local,  TFTPc_CFG_RELAY_NAME_LEN_MAX + 1u) > TFTPc_CFG_RELAY_NAME_LEN_MAX)) {
+       *p_err  = TFTPc_ERR_RELAY;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    TFTPc_RelayLockAcquire(p_err);                              /* See Note #3.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+                                                                /* ------------- SEL ENTRY (see Note #2) -------------- */
+    p_entry = DEF_NULL;
+    for (ix = 0u; ix < TFTPc_CFG_RELAY_CACHE_NBR; ix++) {       /* Find entry of same file.                             */
+        if ((TFTPc_RelayCache[ix].NameRemote[0] != ASCII_CHAR_NULL) &&
+            (Str_Cmp(&TFTPc_RelayCache[ix].NameRemote[0], p_filename_remote) == 0)) {
+            p_entry = &TFTPc_RelayCache[ix];
+            break;
+        }
+    }
+
+    if (p_entry == DEF_NULL) {                                  /* Find free entry.                                     */
+        for (ix = 0u; ix < TFTPc_CFG_RELAY_CACHE_NBR; ix++) {
+            if (TFTPc_RelayCache[ix].NameRemote[0] == ASCII_CHAR_NULL) {
+                p_entry = &TFTPc_RelayCache[ix];
+                break;
             }
+        }
+    }
+
+    if (p_entry == DEF_NULL) {                                  /* Replace next entry in turn.                          */
+        p_entry = &TFTPc_RelayCache[TFTPc_RelayCacheIxNext];
+        TFTPc_RelayCacheIxNext++;
+        if (TFTPc_RelayCacheIxNext >= TFTPc_CFG_RELAY_CACHE_NBR) {
+            TFTPc_RelayCacheIxNext = 0u;
+        }
+    }
+
+   (void)Str_Copy_N(&p_entry->NameRemote[0], p_filename_remote, sizeof(p_entry->NameRemote));
+   (void)Str_Copy_N(&p_entry->NameLocal[0],  p_filename_local,  sizeof(p_entry->NameLocal));
+    if (p_entry == TFTPc_RelaySrvEntryPtr) {                    /* See Note #3.                                         */
+        TFTPc_RelaySrvEntryPtr = DEF_NULL;
+    }
+
+    TFTPc_RelayLockRelease();
+
+    TFTPc_TRACE_INFO(("TFTPc_RelayCacheAdd: %s cached as %s\n\r", p_filename_remote, p_filename_local));
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelaySrvStart()
+*
+* Description : Open the relay responder socket, on which the LAN peers request the cached files.
+*
+* Argument(s) : ip_family   IP family of the requests to serve :
+*
+*                               NET_IP_ADDR_FAMILY_IPv4     IPv4 requests.
+*                               NET_IP_ADDR_FAMILY_IPv6     IPv6 requests.
+*
+*               port        Port number the requests are rx'd on (e.g. TFTPc_CFG_DFLT_SERVER_PORT_NBR).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE                  Responder successfully started.
+*                               TFTPc_ERR_RELAY                 Responder already started.
+*                               TFTPc_ERR_INVALID_PROTO_FAMILY  Invalid or disabled IP family.
+*                               TFTPc_ERR_NO_SOCK               Socket could NOT be opened or bound.
+*
+* Return(s)   : DEF_OK,   if responder was started successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The responder is driven by the application : TFTPc_RelaySrvStart(), TFTPc_RelaySrvProcess()
+*                   & TFTPc_RelaySrvStop() MUST be called from the same task, e.g. a low priority task
+*                   dedicated to the relay role.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_RelaySrvStart (NET_IP_ADDR_FAMILY   ip_family,
+                                  NET_PORT_NBR         port,
+                                  TFTPc_ERR           *p_err)
+{
+    NET_SOCK_ID                sock_id;
+    NET_SOCK_ADDR              sock_addr;
+    NET_SOCK_PROTOCOL_FAMILY   protocol_family;
+#ifdef  TFTPc_IPv4_EN
+    NET_SOCK_ADDR_IPv4        *p_addrv4;
+#endif
+#ifdef  TFTPc_IPv6_EN
+    NET_SOCK_ADDR_IPv6        *p_addrv6;
+#endif
+    NET_ERR                    err_net;
+    CPU_BOOLEAN                result;
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+#endif
+
+    if (TFTPc_RelaySrvSockID != NET_SOCK_ID_NONE) {
+       *p_err  = TFTPc_ERR_RELAY;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    Mem_Clr(&sock_addr, sizeof(sock_addr));                     /* Bind to wildcard addr.                               */
+    switch (ip_family) {
+#ifdef  TFTPc_IPv4_EN
+        case NET_IP_ADDR_FAMILY_IPv4:
+             protocol_family      =  NET_SOCK_PROTOCOL_FAMILY_IP_V4;
+             p_addrv4             = (NET_SOCK_ADDR_IPv4 *)&sock_addr;
+             p_addrv4->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V4;
+             p_addrv4->Port       =  NET_UTIL_HOST_TO_NET_16(port);
+             p_addrv4->Addr       =  NET_UTIL_HOST_TO_NET_32(NET_SOCK_ADDR_IP_V4_WILDCARD);
+             break;
+#endif
+
+#ifdef  TFTPc_IPv6_EN
+        case NET_IP_ADDR_FAMILY_IPv6:
+             protocol_family      =  NET_SOCK_PROTOCOL_FAMILY_IP_V6;
+             p_addrv6             = (NET_SOCK_ADDR_IPv6 *)&sock_addr;
+             p_addrv6->AddrFamily =  NET_SOCK_ADDR_FAMILY_IP_V6;
+             p_addrv6->Port       =  NET_UTIL_HOST_TO_NET_16(port);
+             break;
+#endif
+
+        default:
+            *p_err  = TFTPc_ERR_INVALID_PROTO_FAMILY;
+             result = DEF_FAIL;
+             goto exit;
+    }
+
+    sock_id = NetSock_Open(protocol_family,
+                           NET_SOCK_TYPE_DATAGRAM,
+                           NET_SOCK_PROTOCOL_UDP,
+                          &err_net);
+    if (err_net != NET_SOCK_ERR_NONE) {
+       *p_err  = TFTPc_ERR_NO_SOCK;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+   (void)NetSock_Bind((NET_SOCK_ID      ) sock_id,
+                      (NET_SOCK_ADDR   *)&sock_addr,
+                      (NET_SOCK_ADDR_LEN) sizeof(NET_SOCK_ADDR),
+                      (NET_ERR         *)&err_net);
+    if (err_net != NET_SOCK_ERR_NONE) {
+        NetSock_Close(sock_id, &err_net);
+       *p_err  = TFTPc_ERR_NO_SOCK;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+   (void)NetSock_CfgBlock(sock_id, NET_SOCK_BLOCK_SEL_BLOCK, &err_net);
+
+    TFTPc_RelaySrvSockID = sock_id;
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_RelaySrvProcess()
+*
+* Description : Wait for a request from a LAN peer & serve it.
+*
+* Argument(s) : timeout_ms  Time to wait for a request (in milliseconds).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Request served or rejected (see Note #2).
+*                               TFTPc_ERR_RELAY         Responder NOT started, peer aborted or stopped
+*                                                           acknowledging the transfer, or cached file
+*                                                           replaced while served (see Note #3).
+*                               TFTPc_ERR_RX_TIMEOUT    No request rx'd within the timeout.
+*                               TFTPc_ERR_RX            Error receiving the request.
+*
+*                               ----------- RETURNED BY TFTPc_RelaySrvServe() -----------
+*                               See TFTPc_RelaySrvServe() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if a request was served or rejected.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) See 'TFTPc_RelaySrvStart()  Note #1'.  A single request is served at a time : the
+*                   function returns once the file is sent, or the transfer fails.
+*
+*               (2) Only octet mode read requests (RFC #1350) for a cached file are served.  The block size
+*                   option is negotiated (RFC #2348) : the other options are NOT answered in the OACK, so that
+*                   the peer uses their default (RFC #2347).  Any other request is rejected with an ERROR pkt.
+*
+*               (3) The relay lock is only held to look up the cache & to read each block (see
+*                   'TFTPc_RelayCacheAdd()  Note #3').  If the entry served is removed or replaced meanwhile,
+*                   e.g. because the local file is being overwritten, the transfer is aborted with an ERROR
+*                   pkt before the next block is read.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_RelaySrvProcess (CPU_INT32U   timeout_ms,
+                                    TFTPc_ERR   *p_err)
+{
+    NET_SOCK_ADDR       addr_peer;
+    NET_SOCK_ADDR_LEN   addr_len;
+    NET_SOCK_RTN_CODE   rx_len;
+    NET_ERR             err_net;
+    CPU_BOOLEAN         result;
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+#endif
+
+    if (TFTPc_RelaySrvSockID == NET_SOCK_ID_NONE) {
+       *p_err  = TFTPc_ERR_RELAY;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    NetSock_CfgTimeoutRxQ_Set(TFTPc_RelaySrvSockID,
+                              timeout_ms,
+                             &err_net);
+
+    addr_len = sizeof(addr_peer);
+    rx_len   = NetSock_RxDataFrom((NET_SOCK_ID        ) TFTPc_RelaySrvSockID,
+                                  (void              *)&TFTPc_RelayRxPktBuf[0],
+                                  (CPU_INT16U         ) sizeof(TFTPc_RelayRxPktBuf),
+                                  (CPU_INT16S         ) NET_SOCK_FLAG_NONE,
+                                  (NET_SOCK_ADDR     *)&addr_peer,
+                                  (NET_SOCK_ADDR_LEN *)&addr_len,
+                                  (void              *) 0,
+                                  (CPU_INT08U         ) 0,
+                                  (CPU_INT08U        *) 0,
+                                  (NET_ERR           *)&err_net);
+    switch (err_net) {
+        case NET_SOCK_ERR_NONE:
+             break;
+
+
+        case NET_SOCK_ERR_RX_Q_EMPTY:
+            *p_err  = TFTPc_ERR_RX_TIMEOUT;
+             result = DEF_FAIL;
+             goto exit;
+
+
+        default:
+            *p_err  = TFTPc_ERR_RX;
+             result = DEF_FAIL;
+             goto exit;
+    }
+
+    TFTPc_RelaySrvServe(&addr_peer, (CPU_INT16U)rx_len, p_err);
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    result = DEF_OK;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelaySrvStop()
+*
+* Description : Close the relay responder socket.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) See 'TFTPc_RelaySrvStart()  Note #1'.  The relay cache is kept.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+void  TFTPc_RelaySrvStop (void)
+{
+    NET_ERR  err_net;
+
+
+    if (TFTPc_RelaySrvSockID != NET_SOCK_ID_NONE) {
+        NetSock_Close(TFTPc_RelaySrvSockID, &err_net);
+        TFTPc_RelaySrvSockID = NET_SOCK_ID_NONE;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_PoolSet()
+*
+* Description : Register the server pool from which the following transfer sessions request a file.
+*
+* Argument(s) : p_servers       Pointer to table of server configurations (see Note #1).
+*
+*                                   DEF_NULL, to remove the registered servers & use the default configuration.
+*
+*               nbr_servers     Number of servers in the table.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   TFTPc_ERR_NONE          Servers successfully registered.
+*                                   TFTPc_ERR_POOL          Too many servers (see 'tftp-c_cfg.h  TFTPc SERVER
+*                                                               POOL CONFIGURATION  Note #2').
+*
+*                                   ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                                   See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if servers were registered successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Each server is described by a TFTPc configuration : the hostname, port & IP family of the
+*                   server, & the rx inactivity timeout used while it is req'd.  The servers SHOULD hold the
+*                   same files.
+*
+*               (2) The server table is referenced, NOT copied : it MUST remain valid while registered.  The
+*                   statistics of the servers are reset (see TFTPc_PoolStatGet()).
+*
+*               (3) Since the TFTPc lock is held for the whole duration of a transfer, the servers take effect
+*                   once the transfer in progress, if any, completes.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_PoolSet (const  TFTPc_CFG   *p_servers,
+                                   CPU_INT08U   nbr_servers,
+                                   TFTPc_ERR   *p_err)
+{
+    CPU_BOOLEAN  result;
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+#endif
+
+    if (nbr_servers > TFTPc_CFG_POOL_NBR_MAX) {
+       *p_err  = TFTPc_ERR_POOL;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    TFTPc_LockAcquire(p_err);                                   /* See Note #3.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    if ((p_servers   == DEF_NULL) ||
+        (nbr_servers == 0u)) {
+        TFTPc_PoolTbl = DEF_NULL;
+        TFTPc_PoolNbr = 0u;
+    } else {
+        TFTPc_PoolTbl = p_servers;                              /* See Note #2.                                         */
+        TFTPc_PoolNbr = nbr_servers;
+    }
+
+    Mem_Clr(&TFTPc_PoolStat[0], sizeof(TFTPc_PoolStat));
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_PoolStatGet()
+*
+* Description : Get the round-trip time & failure statistics of a pool server.
+*
+* Argument(s) : ix          Index of the server in the table passed to TFTPc_PoolSet().
+*
+*               p_stat      Pointer to variable that will receive the statistics.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Statistics successfully copied.
+*                               TFTPc_ERR_NULL_PTR      Null pointer was passed as argument.
+*                               TFTPc_ERR_POOL          Invalid server index.
+*
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if statistics were copied successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Since the TFTPc lock is held for the whole duration of a transfer, this function waits
+*                   for the transfer in progress, if any, to complete.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_PoolStatGet (CPU_INT08U        ix,
+                                TFTPc_POOL_STAT  *p_stat,
+                                TFTPc_ERR        *p_err)
+{
+    CPU_BOOLEAN  result;
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+
+    if (p_stat == DEF_NULL) {
+       *p_err  = TFTPc_ERR_NULL_PTR;
+        result = DEF_FAIL;
+        goto exit;
+    }
+#endif
+
+    TFTPc_LockAcquire(p_err);                                   /* See Note #1.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    if (ix >= TFTPc_PoolNbr) {
+        TFTPc_LockRelease();
+       *p_err  = TFTPc_ERR_POOL;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+   *p_stat = TFTPc_PoolStat[ix];
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_BlkSizeSet()
+*
+* Description : Set the block size requested by the following read transfers.
+*
+* Argument(s) : blk_size    Block size requested, in octets (see Note #1) :
+*
+*                               TFTPc_BLKSIZE_AUTO      Largest block size NOT fragmented on the interface
+*                                                           (see Note #2).
+*                               8 to TFTPc_CFG_BLKSIZE_MAX.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Block size successfully set.
+*                               TFTPc_ERR_CFG_INVALID   Invalid block size.
+*
+*                               ------------ RETURNED BY TFTPc_LockAcquire() ------------
+*                               See TFTPc_LockAcquire() for additional return error codes.
+*
+* Return(s)   : DEF_OK,   if block size was set successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The block size option is req'd by TFTPc_Get() only, & NOT with the multicast option.  The
+*                   server MAY answer with a smaller block size.  A block size of 512 octets is NOT req'd,
+*                   since it is the default one.
+*
+*               (2) TFTPc_BLKSIZE_AUTO is the default.  The block size is derived from the interface MTU
+*                   before each request, & probed if enabled (see 'tftp-c_cfg.h  TFTPc BLOCK SIZE
+*                   CONFIGURATION  Notes #1 & #4').
+*
+*               (3) Since the TFTPc lock is held for the whole duration of a transfer, the block size takes
+*                   effect once the transfer in progress, if any, completes.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_BlkSizeSet (CPU_INT16U   blk_size,
+                               TFTPc_ERR   *p_err)
+{
+    CPU_BOOLEAN  result;
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+#endif
+
+    if ((blk_size != TFTPc_BLKSIZE_AUTO) &&
+       ((blk_size <  TFTPc_BLKSIZE_MIN)  ||
+        (blk_size >  TFTPc_CFG_BLKSIZE_MAX))) {
+       *p_err  = TFTPc_ERR_CFG_INVALID;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    TFTPc_LockAcquire(p_err);                                   /* See Note #3.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    TFTPc_BlkSizeSel = blk_size;
+
+    TFTPc_LockRelease();
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_Cancel()
+*
+* Description : Cancel the transfer in progress.
+*
+* Argument(s) : session_id  ID of the session to cancel (see TFTPc_SessionIDGet()) :
+*
+*                               TFTPc_SESSION_ID_ANY, to cancel whatever session is in progress.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Cancel requested.
+*                               TFTPc_ERR_SESSION_NONE  No session in progress with this ID.
+*
+* Return(s)   : DEF_OK,   if cancel was requested successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Since the TFTPc lock is held for the whole duration of a transfer, the lock is NOT
+*                   acquired : the session is looked up inside a critical section instead.
+*
+*               (2) The transfer is aborted by the task running it, within TFTPc_CFG_ABORT_POLL_ms, & its
+*                   TFTPc_Get()/TFTPc_Put() call returns TFTPc_ERR_CANCELED (see TFTPc_Get() Note #3).  This
+*                   function does NOT wait for the transfer to end.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_Cancel (CPU_INT16U   session_id,
+                           TFTPc_ERR   *p_err)
+{
+    CPU_BOOLEAN  found;
+    CPU_BOOLEAN  result;
+    CPU_SR_ALLOC();
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    found = DEF_NO;
+    if ((TFTPc_SessionActive == DEF_YES) &&
+       ((session_id          == TFTPc_SESSION_ID_ANY) ||
+        (session_id          == TFTPc_SessionID))) {
+        TFTPc_AbortReq = DEF_YES;                               /* See Note #2.                                         */
+        found          = DEF_YES;
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (found == DEF_NO) {
+       *p_err  = TFTPc_ERR_SESSION_NONE;
+        result = DEF_FAIL;
+        goto exit;
+    }
+
+    result = DEF_OK;
+   *p_err  = TFTPc_ERR_NONE;
+
+
+exit:
+    return (result);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_SessionIDGet()
+*
+* Description : Get the ID of the session in progress.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Session ID returned.
+*                               TFTPc_ERR_SESSION_NONE  No session in progress.
+*
+* Return(s)   : ID of the session in progress, if NO error.
+*
+*               TFTPc_SESSION_ID_ANY,               otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Like TFTPc_Cancel(), this function does NOT acquire the TFTPc lock, which is held for the
+*                   whole duration of a transfer : another task MAY get the ID of the transfer in progress &
+*                   cancel it with TFTPc_Cancel().
+*
+*               (2) A session is in progress from the start of TFTPc_Get()/TFTPc_Put() until the socket & the
+*                   file are released.  The ID returned MAY be the one of a later transfer if the application
+*                   runs several transfers back to back.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+CPU_INT16U  TFTPc_SessionIDGet (TFTPc_ERR  *p_err)
+{
+    CPU_INT16U  session_id;
+    CPU_SR_ALLOC();
+
+
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(TFTPc_SESSION_ID_ANY);
+    }
+#endif
+
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    session_id = TFTPc_SESSION_ID_ANY;
+    if (TFTPc_SessionActive == DEF_YES) {
+        session_id = TFTPc_SessionID;
+    }
+    CPU_CRITICAL_EXIT();
+
+    if (session_id == TFTPc_SESSION_ID_ANY) {
+       *p_err = TFTPc_ERR_SESSION_NONE;
+        goto exit;
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+
+
+exit:
+    return (session_id);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_LockAcquire()
+*
+* Description : $$$$ Add function description.
+*
+* Argument(s) : p_err   $$$$ Add description for 'p_err'
+*
+* Return(s)   : $$$$ Add return value description.
+*
+* Caller(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_LockAcquire (TFTPc_ERR  *p_err)
+{
+    KAL_ERR  err;
+
+
+    KAL_LockAcquire(TFTPc_LockHandle, KAL_OPT_PEND_NONE, 0, &err);
+    if (err != KAL_ERR_NONE) {
+       *p_err = TFTPc_ERR_LOCK;
+        goto exit;
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+
+
+exit:
+    return;
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_LockRelease()
+*
+* Description : $$$$ Add function description.
+*
+* Argument(s) : none.
+*
+* Return(s)   : $$$$ Add return value description.
+*
+* Caller(s)   : none.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_LockRelease (void)
+{
+    KAL_ERR  err;
+
+
+    KAL_LockRelease(TFTPc_LockHandle, &err);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_InitSession()
+*
+* Description : Initialize the TFTP session.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put().
+*
+* Note(s)     : (1) The session ID & the session state are read by TFTPc_Cancel() & TFTPc_SessionIDGet(), which
+*                   do NOT acquire the TFTPc lock.  Session ID TFTPc_SESSION_ID_ANY is never assigned.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_InitSession (void)
+{
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    CPU_SR_ALLOC();
+
+
+#endif
+    TFTPc_SockID     =  NET_SOCK_ID_NONE;
+    TFTPc_FileHandle = (void *)0;
+
+    TFTPc_RxPktLen   =  0;
+    TFTPc_TxPktLen   =  0;
+
+    TFTPc_TxPktRetry =  0;
+
+    TFTPc_TID_Set    =  DEF_NO;
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)
+    TFTPc_SockConn   =  DEF_NO;
+#endif
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    CPU_CRITICAL_ENTER();                                       /* See Note #1.                                         */
+    TFTPc_SessionID++;
+    if (TFTPc_SessionID == TFTPc_SESSION_ID_ANY) {
+        TFTPc_SessionID++;
+    }
+    TFTPc_AbortReq      = DEF_NO;
+    TFTPc_SessionActive = DEF_YES;
+    CPU_CRITICAL_EXIT();
+#else
+    TFTPc_SessionID++;
+#endif
+
+    Mem_Clr(&TFTPc_ServerErr, sizeof(TFTPc_ServerErr));
+    TFTPc_ServerErr.SessionID = TFTPc_SessionID;
+
+#if (TFTPc_CFG_RX_DUP_REACK_EN == DEF_ENABLED)
+    TFTPc_ReAckDone  =  DEF_NO;
+#endif
+
+#if (TFTPc_CFG_STAT_EN == DEF_ENABLED)
+    Mem_Clr(&TFTPc_Stats, sizeof(TFTPc_Stats));
+    TFTPc_Stats.SessionID   = TFTPc_SessionID;
+    TFTPc_Stats.BlkSize     = TFTPc_DATA_BLOCK_SIZE;
+    TFTPc_Stats.WinSize     = 1u;
+#endif
+
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    Mem_Clr(&TFTPc_Profile, sizeof(TFTPc_Profile));
+    TFTPc_Profile.SessionID = TFTPc_SessionID;
+#endif
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    TFTPc_CodecActive = DEF_NO;
+#endif
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    TFTPc_FlashActive = DEF_NO;
+#endif
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+    TFTPc_TarActive   = DEF_NO;
+#endif
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+    TFTPc_SparseHole  = DEF_NO;
+#endif
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+    TFTPc_PoolOctetWr = 0u;
+    TFTPc_PoolOctetRx = 0u;
+#endif
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+    TFTPc_BlkSize         = TFTPc_DATA_BLOCK_SIZE;
+    TFTPc_BlkSizeReq      = 0u;
+    TFTPc_BlkSizeFallback = DEF_NO;
+#endif
+
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+    TFTPc_BlkSizeTimeoutCtr = 0u;
+#endif
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+    TFTPc_BgActive    = DEF_NO;
+#endif
+
+#ifdef  TFTPc_OPT_EN
+    TFTPc_OptReq          = 0u;
+#endif
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    TFTPc_McastSockID     = NET_SOCK_ID_NONE;
+    TFTPc_McastMaster     = DEF_NO;
+    TFTPc_McastBlkMissing = 1u;
+    TFTPc_McastBlkLast    = 0u;
+    TFTPc_McastFileLen    = 0u;
+    Mem_Clr(&TFTPc_McastBitmap[0], sizeof(TFTPc_McastBitmap));
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_ProfileUpdate()
+*
+* Description : Account the duration of a transfer phase in the profile of the current session.
+*
+* Argument(s) : phase       Phase to update (see 'tftp-c.h  TFTPc PHASE PROFILE DATA TYPES  Note #2').
+*
+*               ts_delta    Duration of the phase (in CPU timestamp timer counts).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_PROFILE_PHASE_END().
+*
+* Note(s)     : (1) The mean is only computed when the profile is read, by TFTPc_ProfileGet().
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+static  void  TFTPc_ProfileUpdate (CPU_INT08U  phase,
+                                   CPU_TS32    ts_delta)
+{
+    TFTPc_PROFILE_PHASE  *p_phase;
+
+
+    p_phase = &TFTPc_Profile.Phase[phase];
+
+    if ((p_phase->NbrSamples == 0u) ||
+        (ts_delta < p_phase->Min)) {
+        p_phase->Min = ts_delta;
+    }
+    if (ts_delta > p_phase->Max) {
+        p_phase->Max = ts_delta;
+    }
+
+    p_phase->Total += ts_delta;                                 /* See Note #1.                                         */
+    p_phase->NbrSamples++;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TxBucketInit()
+*
+* Description : Initialize a tx token bucket.  The bucket is initially full.
+*
+* Argument(s) : p_bucket                Pointer to token bucket to initialize.
+*
+*               rate_octets_per_sec     Token refill rate (in octets per second), 0 if unlimited.
+*
+*               burst_octets            Bucket size (in octets), 0 for a single packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put(),
+*               TFTPc_TxRateLimitSet().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+static  void  TFTPc_TxBucketInit (TFTPc_TX_BUCKET  *p_bucket,
+                                  CPU_INT32U        rate_octets_per_sec,
+                                  CPU_INT32U        burst_octets)
+{
+    if (burst_octets == 0u) {
+        burst_octets = TFTPc_PKT_BUF_SIZE;
+    }
+
+    p_bucket->RateOctetsPerSec = rate_octets_per_sec;
+    p_bucket->BurstOctets      = burst_octets;
+    p_bucket->Tokens           = burst_octets;
+    p_bucket->TS_Refill_ms     = TFTPc_TIME_GET_ms();
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_TxBucketDlyGet()
+*
+* Description : Refill a tx token bucket & get the delay until a packet can be tx'd.
+*
+* Argument(s) : p_bucket        Pointer to token bucket.
+*
+*               pkt_len         Length of packet to transmit (in octets).
+*
+*               ts_cur_ms       Current time (in milliseconds).
+*
+* Return(s)   : Delay (in milliseconds) before enough tokens are available, 0 if packet can be tx'd now.
+*
+* Caller(s)   : TFTPc_TxRateWait().
+*
+* Note(s)     : (1) A packet larger than the bucket only requires a full bucket.
+*
+*               (2) The refill time is only advanced once at least one token was added so that tokens are
+*                   not lost when the bucket is polled more often than its rate.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+static  CPU_INT32U  TFTPc_TxBucketDlyGet (TFTPc_TX_BUCKET  *p_bucket,
+                                          CPU_INT16U        pkt_len,
+                                          NET_TS_MS         ts_cur_ms)
+{
+    CPU_INT64U  tokens_add;
+    CPU_INT32U  tokens_needed;
+    CPU_INT32U  dly_ms;
+
+
+    if (p_bucket->RateOctetsPerSec == 0u) {                     /* Rate NOT limited.                                    */
+        return (0u);
+    }
+                                                                /* ----------------- REFILL TOKENS ------------------ */
+    tokens_add = ((CPU_INT64U)(ts_cur_ms - p_bucket->TS_Refill_ms) * p_bucket->RateOctetsPerSec)
+               / DEF_TIME_NBR_mS_PER_SEC;
+    if (tokens_add > 0u) {                                      /* See Note #2.                                         */
+        tokens_add            += p_bucket->Tokens;
+        p_bucket->Tokens       = (CPU_INT32U)DEF_MIN(tokens_add, p_bucket->BurstOctets);
+        p_bucket->TS_Refill_ms = ts_cur_ms;
+    }
+                                                                /* ------------------ COMPUTE DLY ------------------- */
+    tokens_needed = DEF_MIN(pkt_len, p_bucket->BurstOctets);    /* See Note #1.                                         */
+    if (p_bucket->Tokens >= tokens_needed) {
+        return (0u);
+    }
+
+    dly_ms = (CPU_INT32U)((((CPU_INT64U)(tokens_needed - p_bucket->Tokens) * DEF_TIME_NBR_mS_PER_SEC) +
+                             p_bucket->RateOctetsPerSec - 1u) / p_bucket->RateOctetsPerSec);
+
+    return (dly_ms);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TxBucketTake()
+*
+* Description : Remove the tokens used by a tx'd packet from a tx token bucket.
+*
+* Argument(s) : p_bucket        Pointer to token bucket.
+*
+*               pkt_len         Length of packet transmitted (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TxRateWait().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+static  void  TFTPc_TxBucketTake (TFTPc_TX_BUCKET  *p_bucket,
+                                  CPU_INT16U        pkt_len)
+{
+    if (p_bucket->Tokens > pkt_len) {
+        p_bucket->Tokens -= pkt_len;
+    } else {
+        p_bucket->Tokens  = 0u;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_TxRateWait()
+*
+* Description : Wait until both the global & the session tx token buckets allow a packet to be tx'd, then
+*               take the tokens for this packet.
+*
+* Argument(s) : pkt_len         Length of packet to transmit (in octets).
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   TFTPc_ERR_NONE          Packet can be tx'd.
+*
+*                                                           ---- RETURNED BY TFTPc_AbortChk() : ----
+*                                   TFTPc_ERR_CANCELED      Transfer canceled.
+*                                   TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TxPkt().
+*
+* Note(s)     : (1) When transfer abort is enabled, the wait is sliced like the rx wait, so that a low rate
+*                   does NOT postpone the cancel req & the deadline.  The tokens are NOT taken if the wait is
+*                   aborted.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+static  void  TFTPc_TxRateWait (CPU_INT16U   pkt_len,
+                                TFTPc_ERR   *p_err)
+{
+    NET_TS_MS   ts_cur_ms;
+    CPU_INT32U  dly_global_ms;
+    CPU_INT32U  dly_session_ms;
+    CPU_INT32U  dly_ms;
+
+
+    for (;;) {
+        ts_cur_ms      = TFTPc_TIME_GET_ms();
+        dly_global_ms  = TFTPc_TxBucketDlyGet(&TFTPc_TxBucketGlobal,  pkt_len, ts_cur_ms);
+        dly_session_ms = TFTPc_TxBucketDlyGet(&TFTPc_TxBucketSession, pkt_len, ts_cur_ms);
+
+        if ((dly_global_ms  == 0u) &&
+            (dly_session_ms == 0u)) {
+            break;
+        }
+
+        dly_ms = DEF_MAX(dly_global_ms, dly_session_ms);
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+        dly_ms = DEF_MIN(dly_ms, TFTPc_AbortChk((CPU_INT32U)ts_cur_ms, p_err));
+        if (*p_err != TFTPc_ERR_NONE) {                         /* See Note #1.                                         */
+            return;
+        }
+#endif
+        TFTPc_TIME_DLY_ms(dly_ms);
+    }
+
+    TFTPc_TxBucketTake(&TFTPc_TxBucketGlobal,  pkt_len);
+    TFTPc_TxBucketTake(&TFTPc_TxBucketSession, pkt_len);
+
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_SockInit()
+*
+* Description : Initialize the communication socket.
+*
+* Argument(s) : p_server_hostname     Pointer to hostname or IP address string of the TFTP server.
+*
+*               server_port           Port number of the TFTP server.
+*
+* Return(s)   : Error message:
+*
+*               TFTPc_ERR_NONE                      No error.
+*               TFTPc_ERR_NO_SOCK                   Could not open socket.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put().
+*
+* Note(s)     : (1) An IP family compiled out of TFTPc (see 'tftp-c_cfg.h  TFTPc FOOTPRINT CONFIGURATION') is
+*                   rejected even when the network stack supports it.
+*
+*               (2) When TFTPc_CFG_ABORT_EN is enabled, the cancel req & the deadline are checked before the
+*                   socket is opened & once it is opened, & end the transfer with TFTPc_ERR_CANCELED or
+*                   TFTPc_ERR_DEADLINE.  The server hostname resolution can NOT be interrupted : a deadline
+*                   exceeded while resolving ends the transfer as soon as the resolution returns, the socket
+*                   being closed by the caller.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_SockInit (CPU_CHAR            *p_server_hostname,
+                                     NET_PORT_NBR         server_port,
+                                     NET_IP_ADDR_FAMILY   ip_family,
+                                     TFTPc_ERR           *p_err)
+{
+    NET_SOCK_ID    *p_sock_id;
+    NET_SOCK_ADDR  *p_server_sock_addr;
+    CPU_BOOLEAN     is_hostname;
+    NET_ERR         err;
+
+
+    switch (ip_family) {                                        /* See Note #1.                                         */
+#ifdef  TFTPc_IPv4_EN
+        case NET_IP_ADDR_FAMILY_IPv4:
+#endif
+#ifdef  TFTPc_IPv6_EN
+        case NET_IP_ADDR_FAMILY_IPv6:
+#endif
+             break;
+
+        default:
+            *p_err = TFTPc_ERR_INVALID_PROTO_FAMILY;
+             return (DEF_NO);
+    }
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+   (void)TFTPc_AbortChk((CPU_INT32U)TFTPc_TIME_GET_ms(),        /* See Note #2.                                         */
+                        p_err);
+    if (*p_err != TFTPc_ERR_NONE) {
+        return (DEF_NO);
+    }
+#endif
+
+    p_sock_id          = &TFTPc_SockID;
+    p_server_sock_addr = &TFTPc_SockAddr;
+
+    (void)NetApp_ClientDatagramOpenByHostname(p_sock_id,
+                                              p_server_hostname,
+                                              server_port,
+                                              ip_family,
+                                              p_server_sock_addr,
+                                             &is_hostname,
+                                             &err);
+    if (err != NET_APP_ERR_NONE) {
+       *p_err = TFTPc_ERR_INVALID_PROTO_FAMILY;
+        goto exit;
+    }
+
+   (void)NetSock_CfgBlock(*p_sock_id, NET_SOCK_BLOCK_SEL_BLOCK, &err);
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+   (void)TFTPc_AbortChk((CPU_INT32U)TFTPc_TIME_GET_ms(),        /* See Note #2.                                         */
+                        p_err);
+#else
+   *p_err = TFTPc_ERR_NONE;
+#endif
+
+
+exit:
+    return (is_hostname);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_Processing()
+*
+* Description : Process data transfer.
+*
+* Argument(s) : p_cfg       Pointer to TFTPc configuration object.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE                  Data transfer successful.
+*
+*                                                               ------- RETURNED BY TFTPc_RxPkt() : -------
+*                               TFTPc_ERR_RX_TIMEOUT            Receive timeout.
+*                               TFTPc_ERR_RX                    Error receiving packet.
+*                               TFTPc_ERR_CANCELED              Transfer canceled           (see Note #2).
+*                               TFTPc_ERR_DEADLINE              Transfer deadline exceeded  (see Note #2).
+*
+*                                                               ----- RETURNED BY TFTPc_StateDataGet() : -----
+*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
+*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received.
+*                               TFTPc_ERR_FILE_WR               Error writing to file.
+*                               TFTPc_ERR_TX                    Error transmitting packet.
+*                               TFTPc_ERR_OPT_NEGO              Option negotiation failed.
+*                               TFTPc_ERR_MCAST                 Multicast transfer error.
+*
+*                                                               ----- RETURNED BY TFTPc_StateDataPut() : -----
+*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
+*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received.
+*                               TFTPc_ERR_INVALID_STATE         Invalid state machine state.
+*                               TFTPc_ERR_FILE_RD               Error reading file.
+*                               TFTPc_ERR_TX                    Error transmitting packet.
+*
+*                                                               ----- RETURNED BY TFTPc_TxPkt() : -----
+*                               TFTPc_ERR_TX                    Error transmitting packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put(),
+*               TFTPc_RelayPeerGet(),
+*               TFTPc_PoolGet().
+*
+* Note(s)     : (1) A passive multicast client has NOT tx'd any pkt the server waits for : on rx timeout, it
+*                   keeps listening until the server promotes it to master client (see RFC #2090).  Since the
+*                   server only serves passive clients while a master client is active, it gives up after
+*                   TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX consecutive rx timeouts rather than after the
+*                   re-tx limit of an active client (see 'tftp-c_cfg.h  TFTPc MULTICAST CONFIGURATION
+*                   Note #3').
+*
+*               (2) An aborted transfer is reported to the server with an ERROR pkt, unless the server did NOT
+*                   answer the req yet : its TID is then unknown.  The abort is detected while waiting for a
+*                   pkt, for a backoff or for the tx rate limit (see TFTPc_TxPkt() Note #3).
+*
+*               (3) When TFTPc_CFG_ABORT_EN is enabled, the rx inactivity timeout is applied by
+*                   TFTPc_RxWaitChk(), which slices the rx wait to check the deadline & the cancel req.
+*
+*               (4) When TFTPc_CFG_BACKOFF_EN is enabled & the server has NOT answered the req yet :
+*
+*                   (a) Each re-tx of the req is delayed by a random backoff time.
+*                   (b) An ERROR pkt with a retryable code does NOT end the transfer : the req is tx'd again
+*                       after a backoff time (see TFTPc_BackoffErrRx()).
+*
+*               (5) When the req was tx'd to a relay peer or to a pool server, or MAY be re-tx'd without the
+*                   block size option, a failed session is NOT terminated : the caller closes the socket & tries
+*                   the next source or re-tx's the req (see TFTPc_RelayPeerGet(), TFTPc_PoolGet() &
+*                   TFTPc_BlkSizeFallbackChk()).
+*
+*               (6) During a windowed read transfer, the blocks rx'd in sequence since the last ACK are NOT
+*                   ACK'd yet : on rx timeout, the ACK re-tx'd is updated to the last of them (RFC #7440).
+*
+*               (7) Once the server answered, rx timeouts are counted to detect a block size larger than the
+*                   path MTU (see 'tftp-c_cfg.h  TFTPc BLOCK SIZE CONFIGURATION  Note #4a').
+*
+*               (8) Once the server answered, an rx timeout is a loss that halves the window size req'd by the
+*                   next read (see 'tftp-c_cfg.h  TFTPc ADAPTIVE WINDOW CONFIGURATION  Note #1c').
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_Processing (const  TFTPc_CFG  *p_cfg,
+                                       TFTPc_ERR  *p_err)
+{
+    NET_SOCK_RTN_CODE  rx_pkt_len;
+    NET_SOCK_ADDR_LEN  sock_addr_size;
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    CPU_CHAR          *p_err_msg;
+    TFTPc_ERR          err;
+#else
+    NET_ERR            err_net;
+#endif
+
+
+                                                                /* Set rx sock timeout.                                 */
+    TFTPc_RxTimeout_ms = p_cfg->RxInactivityTimeout_ms;         /* Applied by TFTPc_RxWaitChk() (see Note #3).          */
+#if (TFTPc_CFG_ABORT_EN != DEF_ENABLED)
+    NetSock_CfgTimeoutRxQ_Set(TFTPc_SockID,
+                              TFTPc_RxTimeout_ms,
+                             &err_net);
+#endif
+
+
+
+    while (TFTPc_State != TFTPc_STATE_TRANSFER_COMPLETE) {
+
+        rx_pkt_len = TFTPc_RxPkt((NET_SOCK_ID    ) TFTPc_SockID,
+                                 (void          *)&TFTPc_RxPktBuf[0],
+                                 (CPU_INT16U     ) sizeof(TFTPc_RxPktBuf),
+                                 (TFTPc_ERR     *) p_err);
+        switch (*p_err) {
+            case TFTPc_ERR_NONE:
+                 TFTPc_RxPktLen    = rx_pkt_len;
+                 TFTPc_RxPktOpcode = NET_UTIL_VAL_GET_NET_16(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_OPCODE]);
+
+                 switch (TFTPc_State) {
+                     case TFTPc_STATE_DATA_GET:
+                          TFTPc_StateDataGet(p_err);
+                          break;
+
+
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
+                     case TFTPc_STATE_DATA_PUT:
+                     case TFTPc_STATE_DATA_PUT_WAIT_LAST_ACK:
+                          TFTPc_StateDataPut(p_err);
+                          break;
+#endif
+
+
+                     default:
+                         *p_err = TFTPc_ERR_INVALID_STATE;
+                          break;
+                 }
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+                 if (*p_err == TFTPc_ERR_ERR_PKT_RX) {
+                     TFTPc_BackoffErrRx(p_err);                 /* Retry req if server busy (see Note #4b).             */
+                 }
+#endif
+                 break;
+
+
+            case TFTPc_ERR_RX_TIMEOUT:
+                 TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_RETRY, TFTPc_TRACE_EVENT_RX_TIMEOUT, TFTPc_SessionID, TFTPc_TxPktRetry, TFTPc_TxPktLen);
+                 TFTPc_STAT_INC(RxTimeoutCtr);
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+                 if ((TFTPc_TID_Set           == DEF_YES) &&    /* See Note #7.                                         */
+                     (TFTPc_BlkSizeTimeoutCtr <  DEF_INT_08U_MAX_VAL)) {
+                     TFTPc_BlkSizeTimeoutCtr++;
+                 }
+#endif
+#ifdef  TFTPc_WIN_ADAPT_EN
+                 if (TFTPc_TID_Set == DEF_YES) {                /* See Note #8.                                         */
+                     TFTPc_WinAdaptCongested = DEF_YES;
+                 }
+#endif
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+                 if ((TFTPc_McastSockID != NET_SOCK_ID_NONE) && /* If passive multicast client, ...                     */
+                     (TFTPc_McastMaster == DEF_NO)) {
+                     if (TFTPc_TxPktRetry < TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX) {
+                         TFTPc_TxPktRetry++;                    /* ... keep listening without re-tx (see Note #1).      */
+                        *p_err = TFTPc_ERR_NONE;
+                     }
+                     break;
+                 }
+#endif
+                 if (TFTPc_TxPktLen > 0) {                      /* If pkt tx'd ...                                      */
+                                                                /* ... and max retry NOT reached, ...                   */
+                     if (TFTPc_TxPktRetry < TFTPc_MAX_NBR_TX_RETRY) {
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+                         if (TFTPc_TID_Set == DEF_NO) {         /* If req NOT answered, back off (see Note #4a).        */
+                             TFTPc_BackoffReqDly(TFTPc_TxPktRetry, p_err);
+                             if (*p_err != TFTPc_ERR_NONE) {
+                                 break;
+                             }
+                         }
+#endif
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+                         TFTPc_WinAckRefresh();                 /* ACK last blk rx'd in sequence (see Note #6).         */
+#endif
+                                                                /* ... re-tx last tx'd pkt.                             */
+                          sock_addr_size = sizeof(NET_SOCK_ADDR);
+                         (void)TFTPc_TxPkt((NET_SOCK_ID      ) TFTPc_SockID,
+                                           (void            *)&TFTPc_TxPktBuf[0],
+                                           (CPU_INT16U       ) TFTPc_TxPktLen,
+                                           (NET_SOCK_ADDR   *)&TFTPc_SockAddr,
+                                           (NET_SOCK_ADDR_LEN) sock_addr_size,
+                                           (TFTPc_ERR       *) p_err);
+
+                         TFTPc_TxPktRetry++;
+                         TFTPc_STAT_INC(TxRetryCtr);
+                         TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_RETRY, TFTPc_TRACE_EVENT_RE_TX, TFTPc_SessionID, TFTPc_TxPktRetry, TFTPc_TxPktLen);
+                     }
+                 }
+                 break;
+
+
+            case TFTPc_ERR_RX:
+            default:
+                 break;
+        }
+
+        if (*p_err != TFTPc_ERR_NONE) {
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+             if ((TFTPc_ERR_IS_ABORT(*p_err) == DEF_YES) &&     /* Notify server of abort (see Note #2).                */
+                 (TFTPc_TID_Set              == DEF_YES)) {
+                 p_err_msg = (*p_err == TFTPc_ERR_CANCELED) ? TFTPc_ERR_MSG_CANCELED
+                                                            : TFTPc_ERR_MSG_DEADLINE;
+                 TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_NOT_DEF,
+                             (CPU_CHAR  *) p_err_msg,
+                             (TFTPc_ERR *)&err);
+             }
+#endif
+             TFTPc_TRACE_INFO(("TFTPc_Processing: Error, session terminated\n\r"));
+             TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_SESSION_END, TFTPc_SessionID, *p_err, TFTPc_State);
+             TFTPc_State = TFTPc_STATE_TRANSFER_COMPLETE;
+        }
+    }
+
+    if (*p_err == TFTPc_ERR_NONE) {
+        TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_STATE, TFTPc_TRACE_EVENT_SESSION_END, TFTPc_SessionID, TFTPc_ERR_NONE, TFTPc_State);
+    }
+
+#if (TFTPc_CFG_STAT_EN == DEF_ENABLED)
+    if (TFTPc_Stats.TxPktCtr > 0u) {                            /* No req tx'd : no duration (see TFTPc_TxReq()).       */
+        TFTPc_Stats.Duration_ms = TFTPc_TIME_GET_ms() - TFTPc_Stats.TS_Start_ms;
+    }
+#endif
+
+#ifdef  TFTPc_SESSION_KEEP_EN
+    if ((*p_err            != TFTPc_ERR_NONE) &&                /* Keep session for next source (see Note #5).          */
+        (TFTPc_SessionKeep == DEF_YES)) {
+        return;
+    }
+#endif
+
+    TFTPc_Terminate();
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_StateDataGet()
+*
+* Description : Process received packets for a read request.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE                  No error.
+*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
+*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received, or DATA packet too
+*                                                                   long (see Note #6).
+*
+*                                                               ------- RETURNED BY TFTPc_DataWr() : -------
+*                               TFTPc_ERR_FILE_WR               Error writing to file.
+*
+*                                                               ------- RETURNED BY TFTPc_TxAck() : -------
+*                               TFTPc_ERR_TX                    Error transmitting packet.
+*
+*                                                               ------- RETURNED BY TFTPc_RxOACK() : -------
+*                               TFTPc_ERR_OPT_NEGO              Option negotiation failed.
+*                               TFTPc_ERR_MCAST                 Multicast transfer error.
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Processing().
+*
+* Note(s)     : (1) If the data block received is not the expected one, nothing is written in the file.
+*                   A copy of the previous block is handled by TFTPc_RxDupData(); any other block is
+*                   silently discarded.
+*
+*               (2) Once a multicast group is joined, blocks may be rx'd in any order & are handled by
+*                   TFTPc_McastDataRx().
+*
+*               (3) When the file is wr'n to flash, the next sector is erased once the ACK is tx'd, while the
+*                   server sends the next block, so that the erase time does NOT delay the ACK.
+*
+*               (4) When a window size was negotiated (RFC #7440) :
+*
+*                   (a) A block is only ACK'd at the end of a window, or when it ends the file (see
+*                       TFTPc_WinAckChk()).
+*                   (b) The blocks kept since a missing block are wr'n as soon as it is rx'd, & the last of
+*                       them is ACK'd (see TFTPc_WinReorderDrain()).
+*                   (c) A block rx'd ahead of the next block expected is handled by TFTPc_WinBlkAheadRx().
+*
+*               (5) The round-trip time is measured from an ACK that does NOT end the file to the next block
+*                   rx'd in sequence.  In a background transfer, the ACK is delayed while the round-trip time
+*                   rises (see 'tftp-c_cfg.h  TFTPc BACKGROUND TRANSFER CONFIGURATION').
+*
+*               (6) A DATA packet longer than the block size of the session, i.e. 512 octets unless a larger
+*                   block size was negotiated, is an illegal TFTP operation & terminates the transfer.  It is
+*                   NOT wr'n, since its data would NOT fit the block size expected by the file offsets & by
+*                   the end of file detection.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_StateDataGet (TFTPc_ERR  *p_err)
+{
+    CPU_INT16U   rx_blk_nbr;
+    CPU_INT16U   wr_data_len;
+    CPU_BOOLEAN  last;
+    CPU_BOOLEAN  ack;
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+    CPU_BOOLEAN  drained;
+#endif
+    TFTPc_ERR    err;
+
+
+    switch (TFTPc_RxPktOpcode) {
+        case TFTP_OPCODE_DATA:
+             TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_PKT, TFTPc_TRACE_EVENT_DATA_RX, TFTPc_SessionID,
+                                  TFTPc_GetRxBlkNbr(),
+                                  TFTPc_RxPktLen - TFTP_PKT_SIZE_OPCODE - TFTP_PKT_SIZE_BLK_NBR);
+                                                                /* Reject DATA longer than blk size (see Note #6).      */
+             if (TFTPc_RxPktLen > (CPU_INT32S)(TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR + TFTPc_BLK_SIZE_CUR)) {
+                 TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_ILLEGAL_OP,
+                             (CPU_CHAR  *) TFTPc_ERR_MSG_BLKSIZE_INVALID,
+                             (TFTPc_ERR *)&err);
+                *p_err = TFTPc_ERR_INVALID_OPCODE_RX;
+                 break;
+             }
+            *p_err = TFTPc_ERR_NONE;
+             break;
+
+
+#ifdef  TFTPc_OPT_EN
+        case TFTP_OPCODE_OACK:
+             TFTPc_RxOACK(p_err);
+             return;
+#endif
+
+
+        case TFTP_OPCODE_ERR:
+             TFTPc_RxErrPkt();
+            *p_err = TFTPc_ERR_ERR_PKT_RX;
+             break;
+
+
+        case TFTP_OPCODE_ACK:
+        case TFTP_OPCODE_WRQ:
+        case TFTP_OPCODE_RRQ:
+        default:
+             TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_OPCODE_INVALID, TFTPc_SessionID, TFTPc_RxPktOpcode, TFTPc_State);
+             TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_ILLEGAL_OP,
+                         (CPU_CHAR  *) 0,
+                         (TFTPc_ERR *)&err);
+            *p_err = TFTPc_ERR_INVALID_OPCODE_RX;
+             break;
+    }
+
+    if (*p_err != TFTPc_ERR_NONE) {
+         return;
+    }
+
+
+    rx_blk_nbr = TFTPc_GetRxBlkNbr();                           /* Get rx'd pkt's blk nbr.                              */
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if (TFTPc_McastSockID != NET_SOCK_ID_NONE) {                /* See Note #2.                                         */
+        TFTPc_McastDataRx(rx_blk_nbr, p_err);
+        return;
+    }
+#endif
+
+    if (rx_blk_nbr == TFTPc_RxBlkNbrNext) {                     /* If data blk nbr expected, (see Note #1) ...          */
+#ifdef  TFTPc_RTT_EN
+        TFTPc_RTT_Sample();                                     /* See Note #5.                                         */
+#endif
+        wr_data_len = TFTPc_DataGetWr(p_err);                   /* ... wr data to file                ...               */
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+        drained = DEF_NO;
+#ifdef  TFTPc_WIN_REORDER_EN
+        if (*p_err == TFTPc_ERR_NONE) {                         /* Wr blks kept since a gap (see Note #4b).             */
+            wr_data_len = TFTPc_WinReorderDrain(&rx_blk_nbr, wr_data_len, p_err);
+            drained     = (rx_blk_nbr != TFTPc_RxBlkNbrNext) ? DEF_YES : DEF_NO;
+        }
+#endif
+#endif
+
+        if (*p_err == TFTPc_ERR_NONE) {
+            last = (wr_data_len < TFTPc_BLK_SIZE_CUR) ? DEF_YES : DEF_NO;
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+            ack  =  TFTPc_WinAckChk(rx_blk_nbr, drained, last); /* See Note #4a.                                        */
+#else
+            ack  =  DEF_YES;
+#endif
+            if (ack == DEF_YES) {
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+                if (last == DEF_NO) {
+                    TFTPc_BgYield();                            /* See Note #5.                                         */
+                }
+#endif
+                TFTPc_TxAck(rx_blk_nbr, &err);                  /* ... and tx ack.                                      */
+#ifdef  TFTPc_RTT_EN
+                if (last == DEF_NO) {
+                    TFTPc_RTT_Start();
+                }
+#endif
+            }
+            TFTPc_TxPktRetry = 0;
+
+            if (last == DEF_YES) {                              /* If rx'd data len < TFTP blk size, ...                */
+                TFTPc_State = TFTPc_STATE_TRANSFER_COMPLETE;    /* ... last blk rx'd.                                   */
+
+            } else {
+                TFTPc_RxBlkNbrNext = (TFTPc_BLK_NBR)(rx_blk_nbr + 1u);
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+                TFTPc_FlashPreErase();                          /* See Note #3.                                         */
+#endif
+            }
+
+        } else {                                                /* Err wr'ing data to file.                             */
+            TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_FILE_ERR, TFTPc_SessionID, *p_err, rx_blk_nbr);
+            TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_NOT_DEF,
+                        (CPU_CHAR  *) TFTPc_ERR_MSG_WR_ERR,
+                        (TFTPc_ERR *)&err);
+        }
+
+#if (TFTPc_CFG_RX_DUP_REACK_EN == DEF_ENABLED)
+    } else if ((rx_blk_nbr         == (TFTPc_BLK_NBR)(TFTPc_RxBlkNbrNext - 1u)) &&
+               (TFTPc_RxBlkNbrNext != 1u)) {                    /* If prev data blk rx'd again, ...                     */
+        TFTPc_RxDupData(rx_blk_nbr);                            /* ... our ACK was probably lost.                       */
+#endif
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+    } else if (TFTPc_WinSize > 1u) {                            /* See Note #4c.                                        */
+        TFTPc_WinBlkAheadRx(rx_blk_nbr);
+#endif
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_DataGetWr()
+*
+* Description : Write the data block received in sequence during a read request.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE                  No error.
+*
+*                                                               ------- RETURNED BY TFTPc_DataWr() : -------
+*                               TFTPc_ERR_FILE_WR               Error writing to file.
+*                               TFTPc_ERR_CODEC                 Codec error.
+*                               TFTPc_ERR_POOL                  File shorter than the blocks already written.
+*
+*                                                               ------- RETURNED BY TFTPc_TarChk() : -------
+*                               TFTPc_ERR_TAR                   Invalid, unsupported or truncated archive.
+*
+* Return(s)   : Number of data octets received in the block.
+*
+* Caller(s)   : TFTPc_StateDataGet(),
+*               TFTPc_WinReorderDrain().
+*
+* Note(s)     : (1) The block is read from the rx pkt buf.  The last block is flushed to the file or to flash
+*                   before it is ACK'd.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPc_DataGetWr (TFTPc_ERR  *p_err)
+{
+    CPU_INT16U  wr_data_len;
+
+
+    wr_data_len = TFTPc_DataWr(p_err);
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    if ((*p_err            == TFTPc_ERR_NONE) &&                /* If last blk wr'n to flash, ...                       */
+        ( TFTPc_FlashActive == DEF_YES)        &&
+        ( wr_data_len       <  TFTPc_BLK_SIZE_CUR)) {
+        TFTPc_FlashFlush(p_err);                                /* ... program last page before ACK'ing it.             */
+    }
+#endif
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+    if ((*p_err      == TFTPc_ERR_NONE) &&                      /* If last blk rx'd, ...                                */
+        ( wr_data_len <  TFTPc_BLK_SIZE_CUR)) {
+        TFTPc_SparseFlush(p_err);                               /* ... extend file over skipped data before ACK'ing it. */
+    }
+#endif
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+    if (TFTPc_TarActive == DEF_YES) {                           /* If archive extracted, chk extraction.                */
+        TFTPc_TarChk((wr_data_len < TFTPc_BLK_SIZE_CUR) ? DEF_YES : DEF_NO, p_err);
+    }
+#endif
+
+    if (*p_err == TFTPc_ERR_NONE) {
+        TFTPc_STAT_INC(DataBlkCtr);
+        TFTPc_STAT_ADD(DataOctetCtr, wr_data_len);
+    }
+
+    return (wr_data_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_RxDupData()
+*
+* Description : Handle a copy of the previous DATA block, received during a read request.
+*
+* Argument(s) : rx_blk_nbr      Block number of the duplicate DATA packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet().
+*
+* Note(s)     : (1) The server retransmits a DATA block when it did not receive the ACK for it.  The ACK is
+*                   re-tx'd immediately instead of letting the server wait for its own timeout.
+*
+*               (2) A given block is re-ACK'd at most once per TFTPc_CFG_RX_DUP_REACK_INTERVAL_MIN_ms (see
+*                   'tftp-c_cfg.h  TFTPc DUPLICATE DATA RE-ACK CONFIGURATION  Note #2').
+*
+*               (3) The rx timeout retry counter is NOT reset: the re-ACK does not prove the server is
+*                   making progress.
+*
+*               (4) During a windowed read, a copy of the previous block is a block of a window the server
+*                   resent, & is NOT re-ACK'd : each ACK would restart the window at the same block (see
+*                   TFTPc_WinAckChk()  Note #2).  The ACK lost is re-tx'd on timeout instead (see
+*                   TFTPc_WinAckRefresh()).
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RX_DUP_REACK_EN == DEF_ENABLED)
+static  void  TFTPc_RxDupData (TFTPc_BLK_NBR  rx_blk_nbr)
+{
+    NET_TS_MS    ts_cur_ms;
+    CPU_BOOLEAN  re_ack;
+    TFTPc_ERR    err;
+
+
+    ts_cur_ms = TFTPc_TIME_GET_ms();
+    re_ack    = DEF_YES;
+    if ((TFTPc_ReAckDone   == DEF_YES)    &&                    /* See Note #2.                                         */
+        (TFTPc_ReAckBlkNbr == rx_blk_nbr) &&
+        ((ts_cur_ms - TFTPc_ReAckTS_ms) < TFTPc_CFG_RX_DUP_REACK_INTERVAL_MIN_ms)) {
+        re_ack = DEF_NO;
+    }
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+    if (TFTPc_WinSize > 1u) {                                   /* See Note #4.                                         */
+        re_ack = DEF_NO;
+    }
+#endif
+
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_RETRY, TFTPc_TRACE_EVENT_DATA_DUP, TFTPc_SessionID, rx_blk_nbr, re_ack);
+
+    if (re_ack != DEF_YES) {
+        goto exit;
+    }
+
+    TFTPc_TxAck(rx_blk_nbr, &err);                              /* See Notes #1 & #3.                                   */
+    if (err == TFTPc_ERR_NONE) {
+        TFTPc_ReAckDone   = DEF_YES;
+        TFTPc_ReAckBlkNbr = rx_blk_nbr;
+        TFTPc_ReAckTS_ms  = ts_cur_ms;
+        TFTPc_STAT_INC(RxDupDataReAckCtr);
+    }
+
+
+exit:
+    return;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_StateDataPut()
+*
+* Description : Process received packet for a write request.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE                  No error.
+*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
+*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received.
+*                               TFTPc_ERR_INVALID_STATE         Invalid state machine state.
+*
+*                                                               ------- RETURNED BY TFTPc_DataRd() : -------
+*                               TFTPc_ERR_FILE_RD               Error reading file.
+*
+*                                                               ------- RETURNED BY TFTPc_TxData() : -------
+*                               TFTPc_ERR_TX                    Error transmitting packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Processing().
+*
+* Note(s)     : (1) If the acknowledge block received is not the expected one, nothing is done, and the
+*                   function silently returns.  This is done in order to prevent the 'Sorcerer's Apprentice'
+*                   bug.  Only a receive timeout is supposed to trigger a block retransmission.
+*
+*               (2) The round-trip time is measured from a DATA pkt to its ACK.  In a background transfer, the
+*                   next block is delayed while the round-trip time rises (see 'tftp-c_cfg.h  TFTPc BACKGROUND
+*                   TRANSFER CONFIGURATION').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
+static  void  TFTPc_StateDataPut (TFTPc_ERR  *p_err)
+{
+    CPU_INT16U  rx_blk_nbr;
+    CPU_INT16U  rd_data_len;
+    TFTPc_ERR   err;
+
+
+    switch (TFTPc_RxPktOpcode) {
+        case TFTP_OPCODE_ACK:
+             TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_PKT, TFTPc_TRACE_EVENT_ACK_RX, TFTPc_SessionID, TFTPc_GetRxBlkNbr(), TFTPc_TxPktBlkNbr);
+            *p_err = TFTPc_ERR_NONE;
+             break;
+
+
+        case TFTP_OPCODE_ERR:
+             TFTPc_RxErrPkt();
+            *p_err = TFTPc_ERR_ERR_PKT_RX;
+             break;
+
+
+        case TFTP_OPCODE_DATA:
+        case TFTP_OPCODE_WRQ:
+        case TFTP_OPCODE_RRQ:
+        default:
+             TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_OPCODE_INVALID, TFTPc_SessionID, TFTPc_RxPktOpcode, TFTPc_State);
+             TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_ILLEGAL_OP,
+                         (CPU_CHAR  *) 0,
+                         (TFTPc_ERR *)&err);
+            *p_err = TFTPc_ERR_INVALID_OPCODE_RX;
+             break;
+    }
+
+    if (*p_err != TFTPc_ERR_NONE) {
+         return;
+    }
+
+
+
+    rx_blk_nbr = TFTPc_GetRxBlkNbr();                           /* Get rx'd pkt's blk nbr.                              */
+
+    if (rx_blk_nbr == TFTPc_TxPktBlkNbr) {                      /* If ACK blk nbr matches data sent (see Note #1) ...   */
+#ifdef  TFTPc_RTT_EN
+        TFTPc_RTT_Sample();                                     /* See Note #2.                                         */
+#endif
+
+        switch (TFTPc_State) {
+            case TFTPc_STATE_DATA_PUT:                          /* ... and more data to read, ...                       */
+                 rd_data_len = TFTPc_DataRd(p_err);             /* ... rd next blk from file                      ...   */
+
+                 if (*p_err == TFTPc_ERR_NONE) {
+                     TFTPc_STAT_INC(DataBlkCtr);
+                     TFTPc_STAT_ADD(DataOctetCtr, rd_data_len);
+                     TFTPc_TxPktBlkNbr++;                       /* ... and tx data.                                     */
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+                     TFTPc_BgYield();                           /* See Note #2.                                         */
+#endif
+                     TFTPc_TxData(TFTPc_TxPktBlkNbr, rd_data_len, p_err);
+#ifdef  TFTPc_RTT_EN
+                     TFTPc_RTT_Start();
+#endif
+                     TFTPc_TxPktRetry = 0;
+
+                     if (rd_data_len < TFTPc_DATA_BLOCK_SIZE) {
+                         TFTPc_State = TFTPc_STATE_DATA_PUT_WAIT_LAST_ACK;
+                     }
+
+                 } else {                                       /* Err rd'ing data to file.                             */
+                     TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_FILE_ERR, TFTPc_SessionID, *p_err, TFTPc_TxPktBlkNbr + 1u);
+                     TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_NOT_DEF,
+                                 (CPU_CHAR  *) TFTPc_ERR_MSG_RD_ERR,
+                                 (TFTPc_ERR *)&err);
+                 }
+                 break;
+
+
+            case TFTPc_STATE_DATA_PUT_WAIT_LAST_ACK:            /* If waiting for last ack, ...                         */
+                 TFTPc_State = TFTPc_STATE_TRANSFER_COMPLETE;   /* ... transfer completed.                              */
+                 break;
+
+
+            default:
+                *p_err = TFTPc_ERR_INVALID_STATE;
+                 break;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_GetRxBlkNbr()
+*
+* Description : Extract the block number from the received TFTP packet.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Received block number.
+*
+* Caller(s)   : TFTPc_StateDataPut().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPc_GetRxBlkNbr (void)
+{
+    CPU_INT16U  blk_nbr;
+
+
+    blk_nbr = NET_UTIL_VAL_GET_NET_16(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_BLK_NBR]);
+
+    return (blk_nbr);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_RxErrPkt()
+*
+* Description : Extract the code & message from the received ERROR packet & classify the error.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet(),
+*               TFTPc_StateDataPut().
+*
+* Note(s)     : (1) A pkt too short to hold an error code is kept as a code 0 (not defined) ERROR.  The message
+*                   is copied up to its terminating NULL character, the end of the pkt or
+*                   TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX characters, whichever comes first.
+*
+*               (2) See 'TFTP ERROR CLASS DEFINES  Note #1'.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_RxErrPkt (void)
+{
+    CPU_INT32S  ix;
+    CPU_INT16U  msg_len;
+    CPU_INT16U  err_code;
+
+
+    err_code = TFTP_ERR_CODE_NOT_DEF;                           /* Get code & msg (see Note #1).                        */
+    msg_len  = 0u;
+    if (TFTPc_RxPktLen >= TFTP_PKT_OFFSET_ERR_MSG) {
+        err_code = NET_UTIL_VAL_GET_NET_16(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_ERR_CODE]);
+
+        ix = TFTP_PKT_OFFSET_ERR_MSG;
+        while ((ix      <  TFTPc_RxPktLen)                   &&
+               (msg_len <  TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX) &&
+               (TFTPc_RxPktBuf[ix] != (CPU_INT08U)0)) {
+            TFTPc_ServerErr.Msg[msg_len] = (CPU_CHAR)TFTPc_RxPktBuf[ix];
+            msg_len++;
+            ix++;
+        }
+    }
+    TFTPc_ServerErr.Msg[msg_len] = (CPU_CHAR)0;
+    TFTPc_ServerErr.Code         =  err_code;
+
+    if ((err_code < DEF_INT_32_NBR_BITS) &&                     /* Classify err (see Note #2).                          */
+        (DEF_BIT_IS_SET((CPU_INT32U)TFTP_ERR_CODE_TRANSIENT_MSK, DEF_BIT(err_code)) == DEF_YES)) {
+        TFTPc_ServerErr.Class = TFTPc_ERR_CLASS_TRANSIENT;
+    } else {
+        TFTPc_ServerErr.Class = TFTPc_ERR_CLASS_PERMANENT;
+    }
+
+    TFTPc_TRACE_INFO(("TFTPc_RxErrPkt: Server error %u (%s)\n\r", (unsigned)err_code, &TFTPc_ServerErr.Msg[0]));
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_ERR_RX, TFTPc_SessionID, err_code, TFTPc_ServerErr.Class);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_FileOpenMode()
+*
+* Description : Open the specified file for read or write.
+*
+* Argument(s) : filename        Name of the file to open.
+*
+*               file_access     File access :
+*
+*                                   TFTPc_FILE_OPEN_RD      Open for reading.
+*                                   TFTPc_FILE_OPEN_WR      Open for writing.
+*
+* Return(s)   : Pointer to a file handle for the opened file, if NO error.
+*
+*               Pointer to NULL,                              otherwise.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put(),
+*               TFTPc_TarHdrProc().
+*
+* Note(s)     : (1) When TFTPc_CFG_POOL_EN is enabled, a file opened for writing is also opened for reading,
+*                   so that the data already wr'n can be compared on failover (see TFTPc_PoolDataCmp()).
+*********************************************************************************************************
+*/
+
+static  void  *TFTPc_FileOpenMode (CPU_CHAR           *p_filename,
+                                   TFTPc_FILE_ACCESS   file_access)
+{
+    void  *pfile;
+
+
+    pfile = (void *)0;
+    switch (file_access) {
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
+        case TFTPc_FILE_OPEN_RD:
+             pfile = NetFS_FileOpen(p_filename,
+                                    NET_FS_FILE_MODE_OPEN,
+                                    NET_FS_FILE_ACCESS_RD);
+             break;
+#endif
+
+
+        case TFTPc_FILE_OPEN_WR:
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+             pfile = NetFS_FileOpen(p_filename,                 /* See Note #1.                                         */
+                                    NET_FS_FILE_MODE_CREATE,
+                                    NET_FS_FILE_ACCESS_RD_WR);
+#else
+             pfile = NetFS_FileOpen(p_filename,
+                                    NET_FS_FILE_MODE_CREATE,
+                                    NET_FS_FILE_ACCESS_WR);
+#endif
+             break;
+
+
+        default:
+             break;
+    }
+
+    return (pfile);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_DataWr()
+*
+* Description : Write data to the file system.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FILE_WR   Error writing to file.
+*                               TFTPc_ERR_CODEC     Codec error.
+*                               TFTPc_ERR_POOL      File shorter than the blocks already written (see Note #2b).
+*
+* Return(s)   : Number of octets written to file.
+*
+* Caller(s)   : TFTPc_DataGetWr(),
+*               TFTPc_McastDataRx().
+*
+* Note(s)     : (1) When the session uses a codec, the data is decoded before being written & the number of
+*                   octets rx'd is returned, so that the caller still detects the last block.
+*
+*               (2) When a transfer is restarted against another pool server (see TFTPc_PoolGet()), the
+*                   octets already wr'n are compared with the data rx'd instead of being wr'n again.  Octets
+*                   are counted rather than blocks, since the servers MAY negotiate different block sizes :
+*
+*                   (a) From the first block that differs, the data rx'd is wr'n over the local file.
+*                   (b) A short block rx'd before the end of the octets already wr'n ends the transfer, since
+*                       the local file can NOT be truncated.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPc_DataWr (TFTPc_ERR  *p_err)
+{
+    CPU_SIZE_T   rx_data_len;
+    CPU_SIZE_T   wr_data_len;
+    CPU_SIZE_T   data_ix;
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+    CPU_SIZE_T   cmp_len;
+    CPU_BOOLEAN  same;
+#endif
+
+
+    rx_data_len = TFTPc_RxPktLen - TFTP_PKT_SIZE_OPCODE - TFTP_PKT_SIZE_BLK_NBR;
+    wr_data_len = 0;
+    data_ix     = 0u;
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    if (TFTPc_CodecActive == DEF_YES) {                         /* See Note #1.                                         */
+        TFTPc_CodecDataWr(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_DATA],
+                           rx_data_len,
+                          (rx_data_len < TFTPc_BLK_SIZE_CUR) ? DEF_YES : DEF_NO,
+                           p_err);
+        return ((CPU_INT16U)rx_data_len);
+    }
+#endif
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+    if (TFTPc_PoolOctetRx < TFTPc_PoolOctetWr) {                /* If data already wr'n, cmp it (see Note #2).          */
+        if ((rx_data_len                     < TFTPc_BLK_SIZE_CUR) &&
+            (TFTPc_PoolOctetRx + rx_data_len < TFTPc_PoolOctetWr)) {
+           *p_err = TFTPc_ERR_POOL;                             /* See Note #2b.                                        */
+            return (0u);
+        }
+
+        cmp_len = DEF_MIN(rx_data_len, TFTPc_PoolOctetWr - TFTPc_PoolOctetRx);
+        same    = TFTPc_PoolDataCmp(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_DATA],
+                                     cmp_len,
+                                     p_err);
+        if (*p_err != TFTPc_ERR_NONE) {
+            return (0u);
+        }
+
+        if (same == DEF_YES) {
+            TFTPc_PoolOctetRx += cmp_len;
+            if (cmp_len == rx_data_len) {
+                return ((CPU_INT16U)rx_data_len);
+            }
+            data_ix = cmp_len;                                  /* Wr data past the octets already wr'n.                */
+        } else {
+            TFTPc_PoolOctetWr = TFTPc_PoolOctetRx;              /* Wr remaining data (see Note #2a).                    */
+        }
+    }
+#endif
+
+    if (rx_data_len > data_ix) {
+        wr_data_len = TFTPc_FileWr(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_DATA + data_ix],
+                                    rx_data_len - data_ix);
+    }
+
+    if (wr_data_len != (rx_data_len - data_ix)) {
+       *p_err = TFTPc_ERR_FILE_WR;
+    } else {
+       *p_err = TFTPc_ERR_NONE;
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+        TFTPc_PoolOctetRx += wr_data_len;
+        TFTPc_PoolOctetWr  = TFTPc_PoolOctetRx;
+#endif
+    }
+
+    return ((CPU_INT16U)(wr_data_len + data_ix));
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_FileWr()
+*
+* Description : Write data to the local file, to the flash sink or to the archive extraction.
+*
+* Argument(s) : p_data      Pointer to data to write.
+*
+*               data_len    Length of data to write (in octets).
+*
+* Return(s)   : Number of octets written.
+*
+* Caller(s)   : TFTPc_DataWr(),
+*               TFTPc_CodecDataWr().
+*
+* Note(s)     : (1) When TFTPc_CFG_SPARSE_EN is enabled, data that only holds zero octets is NOT written to
+*                   the local file (see 'tftp-c_cfg.h  TFTPc SPARSE WRITE CONFIGURATION').
+*********************************************************************************************************
+*/
+
+static  CPU_SIZE_T  TFTPc_FileWr (CPU_INT08U  *p_data,
+                                  CPU_SIZE_T   data_len)
+{
+    CPU_SIZE_T  wr_len;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32    ts_start;
+#endif
+
+
+    TFTPc_PROFILE_TS_GET(ts_start);
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    if (TFTPc_FlashActive == DEF_YES) {
+        wr_len = TFTPc_FlashWr(p_data, data_len);
+        TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+        return (wr_len);
+    }
+#endif
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+    if (TFTPc_TarActive == DEF_YES) {
+        wr_len = TFTPc_TarWr(p_data, data_len);
+        TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+        return (wr_len);
+    }
+#endif
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+    if (TFTPc_SparseSkip(p_data, data_len) == DEF_YES) {        /* See Note #1.                                         */
+        TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+        return (data_len);
+    }
+#endif
+
+    wr_len = 0u;
+   (void)NetFS_FileWr((void       *) TFTPc_FileHandle,
+                      (void       *) p_data,
+                      (CPU_SIZE_T  ) data_len,
+                      (CPU_SIZE_T *)&wr_len);
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+
+    return (wr_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_DataRd()
+*
+* Description : Read data from the file system.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FILE_RD   Error reading file.
+*                               TFTPc_ERR_CODEC     Codec error.
+*
+* Return(s)   : Number of octets read from file.
+*
+* Caller(s)   : TFTPc_StateDataPut().
+*
+* Note(s)     : (1) When the session uses a codec, the block is filled with encoded data & the number of
+*                   encoded octets is returned.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
+static  CPU_INT16U  TFTPc_DataRd (TFTPc_ERR  *p_err)
+{
+    CPU_SIZE_T   rd_data_len;
+    CPU_BOOLEAN  err;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32     ts_start;
+#endif
+
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    if (TFTPc_CodecActive == DEF_YES) {                         /* See Note #1.                                         */
+        rd_data_len = TFTPc_CodecDataRd(&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_DATA],
+                                         TFTPc_DATA_BLOCK_SIZE,
+                                         p_err);
+        return ((CPU_INT16U)rd_data_len);
+    }
+#endif
+
+   *p_err = TFTPc_ERR_NONE;
+                                                                /* Rd data from file.                                   */
+    TFTPc_PROFILE_TS_GET(ts_start);
+    err  = NetFS_FileRd((void       *) TFTPc_FileHandle,
+                        (void       *)&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_DATA],
+                        (CPU_SIZE_T  ) TFTPc_DATA_BLOCK_SIZE,
+                        (CPU_SIZE_T *)&rd_data_len);
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+
+    if (rd_data_len == 0) {                                     /* If NO data rd                   ...                  */
+        if (err == DEF_FAIL) {                                  /* ... and err occurred (NOT EOF), ...                  */
+           *p_err = TFTPc_ERR_FILE_RD;                          /* ... rtn err.                                         */
+        }
+    }
+
+    return ((CPU_INT16U)rd_data_len);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_CodecSel()
+*
+* Description : Select whether the registered codec is used by the current session & initialize it.
+*
+* Argument(s) : p_filename_remote   Pointer to name of the remote file.
+*
+*               mode                TFTP transfer mode, as passed to TFTPc_Get() or TFTPc_Put().
+*
+*               encode              DEF_YES, to encode file data (TFTPc_Put()).
+*                                   DEF_NO,  to decode rx'd data (TFTPc_Get()).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_CODEC     Codec initialization failed, or codec requested
+*                                                       while none is registered.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put().
+*
+* Note(s)     : (1) See 'tftp-c.h  TFTPc CODEC DATA TYPE  Note #4'.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+static  void  TFTPc_CodecSel (CPU_CHAR     *p_filename_remote,
+                              TFTPc_MODE    mode,
+                              CPU_BOOLEAN   encode,
+                              TFTPc_ERR    *p_err)
+{
+    CPU_SIZE_T   filename_len;
+    CPU_SIZE_T   suffix_len;
+    CPU_BOOLEAN  codec_req;
+    CPU_BOOLEAN  ok;
+
+
+    TFTPc_CodecActive = DEF_NO;
+    TFTPc_CodecBufIx  = 0u;
+    TFTPc_CodecBufLen = 0u;
+    TFTPc_CodecEOF    = DEF_NO;
+
+    codec_req = DEF_BIT_IS_SET(mode, TFTPc_MODE_FLAG_CODEC);
+    if (TFTPc_CodecPtr == DEF_NULL) {
+        if (codec_req == DEF_YES) {                             /* Codec req'd but none registered.                     */
+           *p_err = TFTPc_ERR_CODEC;
+        } else {
+           *p_err = TFTPc_ERR_NONE;
+        }
+        return;
+    }
+                                                                /* See Note #1.                                         */
+    if ((codec_req                  == DEF_NO) &&
+        (TFTPc_CodecPtr->SuffixPtr != DEF_NULL)) {
+        filename_len = Str_Len(p_filename_remote);
+        suffix_len   = Str_Len(TFTPc_CodecPtr->SuffixPtr);
+        if ((suffix_len   >  0u)         &&
+            (filename_len >= suffix_len) &&
+            (Str_Cmp(&p_filename_remote[filename_len - suffix_len], TFTPc_CodecPtr->SuffixPtr) == 0)) {
+            codec_req = DEF_YES;
+        }
+    }
+
+    if (codec_req == DEF_NO) {
+       *p_err = TFTPc_ERR_NONE;
+        return;
+    }
+
+    ok = TFTPc_CodecPtr->Init(TFTPc_CodecPtr->CtxPtr, encode);
+    if (ok != DEF_OK) {
+       *p_err = TFTPc_ERR_CODEC;
+        return;
+    }
+
+    TFTPc_CodecActive = DEF_YES;
+   *p_err             = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_CodecDataWr()
+*
+* Description : Decode rx'd data & write it to the file system.
+*
+* Argument(s) : p_data      Pointer to rx'd data.
+*
+*               data_len    Length of rx'd data (in octets).
+*
+*               last        DEF_YES, if the data belongs to the last block of the transfer.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FILE_WR   Error writing to file.
+*                               TFTPc_ERR_CODEC     Codec error.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DataWr().
+*
+* Note(s)     : (1) Decoded data is written by chunks of at most TFTPc_CFG_CODEC_BUF_SIZE octets.
+*
+*               (2) For the last block, the codec is flushed until it produces no more data.
+*
+*               (3) A codec that neither consumes nor produces data is stalled (e.g. output of a truncated
+*                   stream) & the transfer is aborted.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+static  void  TFTPc_CodecDataWr (CPU_INT08U   *p_data,
+                                 CPU_SIZE_T    data_len,
+                                 CPU_BOOLEAN   last,
+                                 TFTPc_ERR    *p_err)
+{
+    CPU_SIZE_T   src_used;
+    CPU_SIZE_T   dst_used;
+    CPU_SIZE_T   wr_len;
+    CPU_BOOLEAN  ok;
+
+
+    for (;;) {
+        ok = TFTPc_CodecPtr->Process(TFTPc_CodecPtr->CtxPtr,    /* See Note #1.                                         */
+                                     p_data,
+                                     data_len,
+                                    &src_used,
+                                    &TFTPc_CodecBuf[0],
+                                     sizeof(TFTPc_CodecBuf),
+                                    &dst_used,
+                                     last);
+        if ((ok       != DEF_OK)  ||
+            (src_used >  data_len)) {
+           *p_err = TFTPc_ERR_CODEC;
+            return;
+        }
+
+        p_data   += src_used;
+        data_len -= src_used;
+
+        if (dst_used > 0u) {
+            wr_len = TFTPc_FileWr(&TFTPc_CodecBuf[0], dst_used);
+            if (wr_len != dst_used) {
+               *p_err = TFTPc_ERR_FILE_WR;
+                return;
+            }
+        }
+
+        if (data_len == 0u) {                                   /* All rx'd data consumed ...                           */
+            if (((last     == DEF_NO)                 &&        /* ... & codec output drained,  ...                     */
+                 (dst_used <  sizeof(TFTPc_CodecBuf))) ||
+                 (dst_used == 0u)) {                            /* ... or codec flushed (see Note #2).                  */
+                break;
+            }
+        } else if ((src_used == 0u) &&                          /* See Note #3.                                         */
+                   (dst_used == 0u)) {
+           *p_err = TFTPc_ERR_CODEC;
+            return;
+        }
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_CodecDataRd()
+*
+* Description : Read file data & encode it into a data block.
+*
+* Argument(s) : p_data      Pointer to data block to fill.
+*
+*               data_len    Size of data block (in octets).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FILE_RD   Error reading file.
+*                               TFTPc_ERR_CODEC     Codec error.
+*
+* Return(s)   : Number of encoded octets in the data block.
+*
+* Caller(s)   : TFTPc_DataRd().
+*
+* Note(s)     : (1) File data is read by chunks of at most TFTPc_CFG_CODEC_BUF_SIZE octets.  Data NOT yet
+*                   consumed by the codec is kept for the next block.
+*
+*               (2) The block is filled completely, unless the codec was flushed : a short block then ends
+*                   the transfer.
+*********************************************************************************************************
+*/
+
+#if ((TFTPc_CFG_CODEC_EN == DEF_ENABLED) && \
+     (TFTPc_CFG_PUT_EN   == DEF_ENABLED))
+static  CPU_SIZE_T  TFTPc_CodecDataRd (CPU_INT08U  *p_data,
+                                       CPU_SIZE_T   data_len,
+                                       TFTPc_ERR   *p_err)
+{
+    CPU_SIZE_T   blk_len;
+    CPU_SIZE_T   rd_len;
+    CPU_SIZE_T   src_used;
+    CPU_SIZE_T   dst_used;
+    CPU_BOOLEAN  ok;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32     ts_start;
+#endif
+
+
+    blk_len = 0u;
+    while (blk_len < data_len) {
+                                                                /* ------------- REFILL BUF (see Note #1) ------------- */
+        if ((TFTPc_CodecBufLen == 0u) &&
+            (TFTPc_CodecEOF    == DEF_NO)) {
+            rd_len = 0u;
+            TFTPc_PROFILE_TS_GET(ts_start);
+            ok     = NetFS_FileRd((void       *) TFTPc_FileHandle,
+                                  (void       *)&TFTPc_CodecBuf[0],
+                                  (CPU_SIZE_T  ) sizeof(TFTPc_CodecBuf),
+                                  (CPU_SIZE_T *)&rd_len);
+            TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+            if (rd_len == 0u) {
+                if (ok == DEF_FAIL) {                           /* Err (NOT EOF).                                       */
+                   *p_err = TFTPc_ERR_FILE_RD;
+                    return (0u);
+                }
+                TFTPc_CodecEOF = DEF_YES;
+            }
+            TFTPc_CodecBufIx  = 0u;
+            TFTPc_CodecBufLen = rd_len;
+        }
+                                                                /* ---------------------- ENCODE ---------------------- */
+        ok = TFTPc_CodecPtr->Process(TFTPc_CodecPtr->CtxPtr,
+                                    &TFTPc_CodecBuf[TFTPc_CodecBufIx],
+                                     TFTPc_CodecBufLen,
+                                    &src_used,
+                                    &p_data[blk_len],
+                                     data_len - blk_len,
+                                    &dst_used,
+                                     TFTPc_CodecEOF);
+        if ((ok       != DEF_OK)            ||
+            (src_used >  TFTPc_CodecBufLen) ||
+            (dst_used > (data_len - blk_len))) {
+           *p_err = TFTPc_ERR_CODEC;
+            return (0u);
+        }
+
+        TFTPc_CodecBufIx  += src_used;
+        TFTPc_CodecBufLen -= src_used;
+        blk_len           += dst_used;
+
+        if (TFTPc_CodecEOF == DEF_YES) {
+            if (dst_used == 0u) {                               /* Codec flushed (see Note #2).                         */
+                break;
+            }
+        } else if ((src_used          == 0u) &&                 /* Codec stalled with input avail.                      */
+                   (dst_used          == 0u) &&
+                   (TFTPc_CodecBufLen >  0u)) {
+           *p_err = TFTPc_ERR_CODEC;
+            return (0u);
+        }
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+
+    return (blk_len);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_FlashSel()
+*
+* Description : Select whether the registered flash driver is used by the current session & initialize the
+*               flash sink.
+*
+* Argument(s) : mode        TFTP transfer mode, as passed to TFTPc_Get().
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FLASH     Flash sink requested while no flash driver is registered.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get().
+*
+* Note(s)     : (1) Until the transfer size is known (see TFTPc_FlashTSizeRx()), sectors are erased ahead up
+*                   to the end of the partition.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+static  void  TFTPc_FlashSel (TFTPc_MODE   mode,
+                              TFTPc_ERR   *p_err)
+{
+    TFTPc_FlashActive = DEF_NO;
+
+    if (DEF_BIT_IS_CLR(mode, TFTPc_MODE_FLAG_FLASH) == DEF_YES) {
+       *p_err = TFTPc_ERR_NONE;
+        return;
+    }
+
+    if (TFTPc_FlashPtr == DEF_NULL) {                           /* Flash req'd but none registered.                     */
+       *p_err = TFTPc_ERR_FLASH;
+        return;
+    }
+
+    TFTPc_FlashBufLen    = 0u;
+    TFTPc_FlashWrAddr    = 0u;
+    TFTPc_FlashEraseAddr = 0u;
+    TFTPc_FlashEraseEnd  = TFTPc_FlashPtr->Size;                /* See Note #1.                                         */
+
+    TFTPc_FlashActive    = DEF_YES;
+   *p_err                = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_FlashWr()
+*
+* Description : Write data to the flash sink.
+*
+* Argument(s) : p_data      Pointer to data to write.
+*
+*               data_len    Length of data to write (in octets).
+*
+* Return(s)   : Number of octets written.
+*
+* Caller(s)   : TFTPc_FileWr().
+*
+* Note(s)     : (1) Flash is programmed by whole pages.  Pages fully contained in the data are programmed
+*                   straight from it; the remaining octets are kept in the staging buffer until the next
+*                   write completes the page, or until TFTPc_FlashFlush() programs the last page.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+static  CPU_SIZE_T  TFTPc_FlashWr (CPU_INT08U  *p_data,
+                                   CPU_SIZE_T   data_len)
+{
+    CPU_SIZE_T   page_size;
+    CPU_SIZE_T   copy_len;
+    CPU_SIZE_T   wr_len;
+    CPU_BOOLEAN  ok;
+
+
+    page_size = TFTPc_FlashPtr->PageSize;
+    wr_len    = 0u;
+    while (wr_len < data_len) {
+        if ((TFTPc_FlashBufLen   == 0u) &&                      /* If whole page in data, ...                           */
+            ((data_len - wr_len) >= page_size)) {
+            ok = TFTPc_FlashPageProg(&p_data[wr_len]);          /* ... program it from data (see Note #1).              */
+            if (ok != DEF_OK) {
+                break;
+            }
+            wr_len += page_size;
+
+        } else {                                                /* Else, stage data.                                    */
+            copy_len = DEF_MIN(page_size - TFTPc_FlashBufLen, data_len - wr_len);
+            Mem_Copy(&TFTPc_FlashBuf[TFTPc_FlashBufLen],
+                     &p_data[wr_len],
+                      copy_len);
+            if ((TFTPc_FlashBufLen + copy_len) == page_size) {  /* If page staged, program it.                          */
+                ok = TFTPc_FlashPageProg(&TFTPc_FlashBuf[0]);
+                if (ok != DEF_OK) {
+                    break;
+                }
+                TFTPc_FlashBufLen  = 0u;
+            } else {
+                TFTPc_FlashBufLen += (CPU_INT16U)copy_len;
+            }
+            wr_len += copy_len;
+        }
+    }
+
+    return (wr_len);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_FlashFlush()
+*
+* Description : Program the last, partial, page staged in the flash sink.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FILE_WR   Error programming flash.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DataGetWr().
+*
+* Note(s)     : (1) The end of the page is padded with erased octets, which leaves the flash as if it had
+*                   NOT been programmed there.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+static  void  TFTPc_FlashFlush (TFTPc_ERR  *p_err)
+{
+    CPU_BOOLEAN  ok;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32     ts_start;
+#endif
+
+
+    if (TFTPc_FlashBufLen == 0u) {
+       *p_err = TFTPc_ERR_NONE;
+        return;
+    }
+
+    Mem_Set(&TFTPc_FlashBuf[TFTPc_FlashBufLen],                 /* See Note #1.                                         */
+             TFTPc_FLASH_ERASED_VAL,
+             TFTPc_FlashPtr->PageSize - TFTPc_FlashBufLen);
+
+    TFTPc_PROFILE_TS_GET(ts_start);
+    ok = TFTPc_FlashPageProg(&TFTPc_FlashBuf[0]);
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+    if (ok != DEF_OK) {
+       *p_err = TFTPc_ERR_FILE_WR;
+        return;
+    }
+
+    TFTPc_FlashBufLen = 0u;
+   *p_err             = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_FlashPageProg()
+*
+* Description : Program the next page of the flash sink.
+*
+* Argument(s) : p_page      Pointer to page data ('PageSize' octets).
+*
+* Return(s)   : DEF_OK,   if page programmed.
+*               DEF_FAIL, if file larger than partition, or if flash driver failed.
+*
+* Caller(s)   : TFTPc_FlashWr(),
+*               TFTPc_FlashFlush().
+*
+* Note(s)     : (1) The sectors NOT erased ahead yet (see TFTPc_FlashPreErase()) are erased before the page
+*                   is programmed, which then stalls the transfer for the erase time.
+*
+*               (2) When TFTPc_CFG_SPARSE_EN is enabled, a page that only holds erased octets is left as
+*                   erased instead of being programmed.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_FlashPageProg (const  CPU_INT08U  *p_page)
+{
+    const  TFTPc_FLASH  *p_flash;
+           CPU_INT32U    page_end;
+           CPU_BOOLEAN   ok;
+
+
+    p_flash  = TFTPc_FlashPtr;
+    page_end = TFTPc_FlashWrAddr + p_flash->PageSize;
+    if (page_end > p_flash->Size) {                             /* File does NOT fit in partition.                      */
+        return (DEF_FAIL);
+    }
+
+    while (TFTPc_FlashEraseAddr < page_end) {                   /* See Note #1.                                         */
+        ok = p_flash->SectorErase(p_flash->CtxPtr, TFTPc_FlashEraseAddr);
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+        TFTPc_FlashEraseAddr += p_flash->SectorSize;
+    }
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+    if (TFTPc_SparseIsFill(p_page, p_flash->PageSize, TFTPc_FLASH_ERASED_VAL) == DEF_YES) {
+        TFTPc_STAT_ADD(SparseOctetCtr, p_flash->PageSize);      /* See Note #2.                                         */
+        TFTPc_FlashWrAddr = page_end;
+        return (DEF_OK);
+    }
+#endif
+
+    ok = p_flash->PageProg(p_flash->CtxPtr, TFTPc_FlashWrAddr, p_page);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+
+    TFTPc_FlashWrAddr = page_end;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_FlashPreErase()
+*
+* Description : Erase the next sector of the flash sink ahead of the write pointer, if needed.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_StateDataGet(),
+*               TFTPc_RxOACK().
+*
+* Note(s)     : (1) Called right after a packet is tx'd to the server, so that the erase time overlaps the
+*                   round trip of the next DATA block instead of delaying the ACK path.
+*
+*               (2) TFTPc_CFG_FLASH_ERASE_AHEAD_NBR sectors are kept erased ahead of the write pointer, up to
+*                   the end of the file when its size is known.  A single sector is erased per call to bound
+*                   the time spent before the next block is rx'd.
+*
+*               (3) A failed erase is NOT reported : the sector is erased again before it is programmed (see
+*                   TFTPc_FlashPageProg()  Note #1), which then reports the failure.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+static  void  TFTPc_FlashPreErase (void)
+{
+    const  TFTPc_FLASH  *p_flash;
+           CPU_BOOLEAN   ok;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+           CPU_TS32      ts_start;
+#endif
+
+
+    if (TFTPc_FlashActive != DEF_YES) {
+        return;
+    }
+
+    p_flash = TFTPc_FlashPtr;
+    if ((TFTPc_FlashEraseAddr >= TFTPc_FlashEraseEnd) ||        /* See Note #2.                                         */
+        ((TFTPc_FlashEraseAddr - TFTPc_FlashWrAddr) >= (TFTPc_CFG_FLASH_ERASE_AHEAD_NBR * p_flash->SectorSize))) {
+        return;
+    }
+
+    TFTPc_PROFILE_TS_GET(ts_start);
+    ok = p_flash->SectorErase(p_flash->CtxPtr, TFTPc_FlashEraseAddr);
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_FILE, ts_start);
+    if (ok == DEF_OK) {                                         /* See Note #3.                                         */
+        TFTPc_FlashEraseAddr += p_flash->SectorSize;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_FlashTSizeRx()
+*
+* Description : Process the transfer size option of an OACK, when the file is written to flash.
+*
+* Argument(s) : p_opt_val   Pointer to option value (file size, in octets).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_OPT_NEGO      Malformed option value.
+*                               TFTPc_ERR_FLASH         File does NOT fit in flash partition.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RxOACK().
+*
+* Note(s)     : (1) RFC #2349 : the server returns the size of the file in the OACK.  A file larger than the
+*                   partition is rejected before any block is rx'd, & sectors beyond the end of the file are
+*                   NOT erased ahead.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+static  void  TFTPc_FlashTSizeRx (CPU_CHAR   *p_opt_val,
+                                  TFTPc_ERR  *p_err)
+{
+    const  TFTPc_FLASH  *p_flash;
+           CPU_CHAR     *p_end;
+           CPU_INT32U    tsize;
+           CPU_INT32U    sector_nbr;
+
+
+    tsize = Str_ParseNbr_Int32U(p_opt_val, &p_end, 10u);
+    if ((p_end  == p_opt_val) ||
+        (*p_end != ASCII_CHAR_NULL)) {
+       *p_err = TFTPc_ERR_OPT_NEGO;
+        return;
+    }
+
+    p_flash = TFTPc_FlashPtr;
+    if (tsize > p_flash->Size) {                                /* See Note #1.                                         */
+       *p_err = TFTPc_ERR_FLASH;
+        return;
+    }
+
+    sector_nbr          = (tsize + p_flash->SectorSize - 1u) / p_flash->SectorSize;
+    TFTPc_FlashEraseEnd =  sector_nbr * p_flash->SectorSize;
+
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_TarSel()
+*
+* Description : Select whether the current session extracts a tar archive & initialize the extraction.
+*
+* Argument(s) : p_dir       Pointer to local directory the entries are extracted to, as passed to TFTPc_Get().
+*
+*               mode        TFTP transfer mode, as passed to TFTPc_Get().
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_NULL_PTR      No local directory & no entry sink registered.
+*                               TFTPc_ERR_CFG_INVALID   Extraction requested with the flash sink.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get().
+*
+* Note(s)     : (1) When an entry sink is registered, 'p_dir' is ignored & MAY be NULL.  An empty 'p_dir'
+*                   extracts the entries to the current directory of the file system.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  void  TFTPc_TarSel (CPU_CHAR    *p_dir,
+                            TFTPc_MODE   mode,
+                            TFTPc_ERR   *p_err)
+{
+    TFTPc_TarActive = DEF_NO;
+
+    if (DEF_BIT_IS_CLR(mode, TFTPc_MODE_FLAG_TAR) == DEF_YES) {
+       *p_err = TFTPc_ERR_NONE;
+        goto exit;
+    }
+
+    if (DEF_BIT_IS_SET(mode, TFTPc_MODE_FLAG_FLASH) == DEF_YES) {
+       *p_err = TFTPc_ERR_CFG_INVALID;                          /* Entries can NOT be wr'n to a single partition.       */
+        goto exit;
+    }
+
+    if ((TFTPc_TarSinkPtr == DEF_NULL) &&                       /* See Note #1.                                         */
+        (p_dir            == DEF_NULL)) {
+       *p_err = TFTPc_ERR_NULL_PTR;
+        goto exit;
+    }
+
+    TFTPc_TarDirPtr    = p_dir;
+    TFTPc_TarState     = TFTPc_TAR_STATE_HDR;
+    TFTPc_TarErr       = TFTPc_ERR_NONE;
+    TFTPc_TarHdrLen    = 0u;
+    TFTPc_TarEntryRem  = 0u;
+    TFTPc_TarPadRem    = 0u;
+    TFTPc_TarEntryOpen = DEF_NO;
+
+    TFTPc_TarActive    = DEF_YES;
+   *p_err              = TFTPc_ERR_NONE;
+
+
+exit:
+    return;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                            TFTPc_TarWr()
+*
+* Description : Extract archive data : parse the entry headers & write the entry data to the entry files.
+*
+* Argument(s) : p_data      Pointer to archive data.
+*
+*               data_len    Length of archive data (in octets).
+*
+* Return(s)   : Number of octets consumed, less than 'data_len' if the extraction failed.
+*
+* Caller(s)   : TFTPc_FileWr().
+*
+* Note(s)     : (1) Archive data is processed as it is rx'd, without any alignment on the archive blocks :
+*                   only the header being rx'd is kept, the entry data is wr'n straight from the rx'd block.
+*
+*               (2) The reason of the failure is kept in TFTPc_TarErr (see TFTPc_TarChk()).
+*
+*               (3) The blocks following the end of archive are ignored.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  CPU_SIZE_T  TFTPc_TarWr (CPU_INT08U  *p_data,
+                                 CPU_SIZE_T   data_len)
+{
+    CPU_SIZE_T   rem_len;
+    CPU_SIZE_T   copy_len;
+    CPU_SIZE_T   wr_len;
+    CPU_BOOLEAN  ok;
+    TFTPc_ERR    err;
+
+
+    rem_len = data_len;
+    while ((rem_len        >  0u) &&                            /* See Note #1.                                         */
+           (TFTPc_TarState != TFTPc_TAR_STATE_ERR)) {
+        switch (TFTPc_TarState) {
+            case TFTPc_TAR_STATE_HDR:
+                 copy_len = DEF_MIN(rem_len, (CPU_SIZE_T)(TFTPc_TAR_BLK_SIZE - TFTPc_TarHdrLen));
+                 Mem_Copy(&TFTPc_TarHdrBuf[TFTPc_TarHdrLen], p_data, copy_len);
+                 TFTPc_TarHdrLen += (CPU_INT16U)copy_len;
+
+                 if (TFTPc_TarHdrLen == TFTPc_TAR_BLK_SIZE) {   /* Complete hdr rx'd.                                   */
+                     TFTPc_TarHdrLen = 0u;
+                     TFTPc_TarHdrProc(&err);
+                     if (err != TFTPc_ERR_NONE) {
+                         TFTPc_TarErr   = err;
+                         TFTPc_TarState = TFTPc_TAR_STATE_ERR;
+                     }
+                 }
+                 break;
+
+
+            case TFTPc_TAR_STATE_DATA:
+                 copy_len = DEF_MIN(rem_len, (CPU_SIZE_T)TFTPc_TarEntryRem);
+                 if (TFTPc_TarEntryOpen == DEF_YES) {
+                     if (TFTPc_TarSinkPtr != DEF_NULL) {
+                         ok = TFTPc_TarSinkPtr->EntryWr(TFTPc_TarSinkPtr->CtxPtr, p_data, copy_len);
+                     } else {
+                         wr_len = 0u;
+                        (void)NetFS_FileWr((void       *) TFTPc_FileHandle,
+                                           (void       *) p_data,
+                                           (CPU_SIZE_T  ) copy_len,
+                                           (CPU_SIZE_T *)&wr_len);
+                         ok = (wr_len == copy_len) ? DEF_OK : DEF_FAIL;
+                     }
+                     if (ok != DEF_OK) {
+                         TFTPc_TarErr   = TFTPc_ERR_FILE_WR;
+                         TFTPc_TarState = TFTPc_TAR_STATE_ERR;
+                         break;
+                     }
+                 }
+
+                 TFTPc_TarEntryRem -= (CPU_INT32U)copy_len;
+                 if (TFTPc_TarEntryRem == 0u) {                 /* All entry data rx'd.                                 */
+                     if (TFTPc_TarEntryOpen == DEF_YES) {
+                         TFTPc_TarEntryClose(DEF_YES);
+                     }
+                     TFTPc_TarState = (TFTPc_TarPadRem > 0u) ? TFTPc_TAR_STATE_PAD
+                                                             : TFTPc_TAR_STATE_HDR;
+                 }
+                 break;
+
+
+            case TFTPc_TAR_STATE_PAD:
+                 copy_len         = DEF_MIN(rem_len, (CPU_SIZE_T)TFTPc_TarPadRem);
+                 TFTPc_TarPadRem -= (CPU_INT16U)copy_len;
+                 if (TFTPc_TarPadRem == 0u) {
+                     TFTPc_TarState = TFTPc_TAR_STATE_HDR;
+                 }
+                 break;
+
+
+            case TFTPc_TAR_STATE_END:                           /* See Note #3.                                         */
+            default:
+                 copy_len = rem_len;
+                 break;
+        }
+
+        if (TFTPc_TarState != TFTPc_TAR_STATE_ERR) {
+            p_data  += copy_len;
+            rem_len -= copy_len;
+        }
+    }
+
+    return (data_len - rem_len);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_TarChk()
+*
+* Description : Check the extraction once a DATA block was written.
+*
+* Argument(s) : last        Indicates whether the last block of the archive was written.
+*
+*               p_err       Pointer to variable that holds the error returned by TFTPc_DataWr() & that will
+*                           receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_TAR           Invalid, unsupported or truncated archive.
+*                               TFTPC_ERR_FILE_OPEN     Entry file could NOT be opened.
+*                               TFTPc_ERR_FILE_WR       Error writing entry file.
+*                               TFTPc_ERR_CODEC         Codec error.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DataGetWr().
+*
+* Note(s)     : (1) A failed extraction is reported by TFTPc_DataWr() as a file write error.  It is replaced
+*                   by the reason kept by TFTPc_TarWr().
+*
+*               (2) The archive is truncated if it ends within an entry header or within the entry data.  An
+*                   archive that ends after the data of its last entry, without the end-of-archive blocks,
+*                   is accepted.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  void  TFTPc_TarChk (CPU_BOOLEAN   last,
+                            TFTPc_ERR    *p_err)
+{
+    if ((*p_err          == TFTPc_ERR_FILE_WR) &&               /* See Note #1.                                         */
+        (TFTPc_TarState  == TFTPc_TAR_STATE_ERR)) {
+       *p_err = TFTPc_TarErr;
+        return;
+    }
+
+    if ((*p_err == TFTPc_ERR_NONE) &&
+        ( last  == DEF_YES)) {
+        if ((TFTPc_TarHdrLen   != 0u) ||                        /* See Note #2.                                         */
+            (TFTPc_TarEntryRem != 0u)) {
+            TFTPc_TRACE_INFO(("TFTPc_TarChk: Archive truncated\n\r"));
+           *p_err = TFTPc_ERR_TAR;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_TarHdrProc()
+*
+* Description : Process a complete entry header & open the entry.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_TAR           Invalid or unsupported header.
+*                               TFTPC_ERR_FILE_OPEN     Entry file could NOT be opened.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TarWr().
+*
+* Note(s)     : (1) An all-zero header marks the end of the archive.
+*
+*               (2) The header checksum is the sum of the header octets, the checksum field being taken as
+*                   spaces.
+*
+*               (3) Regular files are extracted; directories are created with NetFS (NOT passed to the entry
+*                   sink).  The data of any other entry (links, devices, extended headers, ...) is skipped.
+*                   Extended headers (pax, GNU long names) are NOT supported : the entries they describe are
+*                   extracted with the name found in their own ustar header.
+*
+*               (4) A directory that already exists is NOT an error.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  void  TFTPc_TarHdrProc (TFTPc_ERR  *p_err)
+{
+    CPU_INT32U   chksum;
+    CPU_INT32U   chksum_rx;
+    CPU_INT32U   size;
+    CPU_INT16U   ix;
+    CPU_INT08U   type;
+    CPU_SIZE_T   name_len;
+    CPU_BOOLEAN  zero;
+    CPU_BOOLEAN  ok;
+
+
+    chksum = 0u;
+    zero   = DEF_YES;
+    for (ix = 0u; ix < TFTPc_TAR_BLK_SIZE; ix++) {
+        if ((ix >= TFTPc_TAR_HDR_OFFSET_CHKSUM) &&              /* See Note #2.                                         */
+            (ix <  TFTPc_TAR_HDR_OFFSET_CHKSUM + TFTPc_TAR_HDR_LEN_CHKSUM)) {
+            chksum += ASCII_CHAR_SPACE;
+        } else {
+            chksum += TFTPc_TarHdrBuf[ix];
+        }
+        if (TFTPc_TarHdrBuf[ix] != 0u) {
+            zero = DEF_NO;
+        }
+    }
+
+    if (zero == DEF_YES) {                                      /* End of archive (see Note #1).                        */
+        TFTPc_TarState = TFTPc_TAR_STATE_END;
+       *p_err          = TFTPc_ERR_NONE;
+        return;
+    }
+
+    ok = TFTPc_TarNbrParse(&TFTPc_TarHdrBuf[TFTPc_TAR_HDR_OFFSET_CHKSUM], TFTPc_TAR_HDR_LEN_CHKSUM, &chksum_rx);
+    if ((ok        != DEF_OK) ||
+        (chksum_rx != chksum)) {
+        TFTPc_TRACE_INFO(("TFTPc_TarHdrProc: Invalid header checksum\n\r"));
+       *p_err = TFTPc_ERR_TAR;
+        return;
+    }
+
+    ok = TFTPc_TarNbrParse(&TFTPc_TarHdrBuf[TFTPc_TAR_HDR_OFFSET_SIZE], TFTPc_TAR_HDR_LEN_SIZE, &size);
+    if (ok != DEF_OK) {                                         /* Size NOT octal or > 4 GB.                            */
+       *p_err = TFTPc_ERR_TAR;
+        return;
+    }
+
+    TFTPc_TarEntryRem = size;
+    TFTPc_TarPadRem   = (CPU_INT16U)((TFTPc_TAR_BLK_SIZE - (size % TFTPc_TAR_BLK_SIZE)) % TFTPc_TAR_BLK_SIZE);
+    TFTPc_TarState    = (size > 0u) ? TFTPc_TAR_STATE_DATA
+                                    : TFTPc_TAR_STATE_HDR;
+
+    type = TFTPc_TarHdrBuf[TFTPc_TAR_HDR_OFFSET_TYPE];
+    switch (type) {                                             /* See Note #3.                                         */
+        case TFTPc_TAR_TYPE_FILE:
+        case TFTPc_TAR_TYPE_FILE_OLD:
+        case TFTPc_TAR_TYPE_FILE_CONTIG:
+        case TFTPc_TAR_TYPE_DIR:
+             break;
+
+
+        default:
+            *p_err = TFTPc_ERR_NONE;                            /* Skip entry.                                          */
+             return;
+    }
+
+    ok = TFTPc_TarPathBuild(&name_len);
+    if (ok != DEF_OK) {
+        TFTPc_TRACE_INFO(("TFTPc_TarHdrProc: Invalid entry name\n\r"));
+       *p_err = TFTPc_ERR_TAR;
+        return;
+    }
+
+    if (name_len == 0u) {                                       /* Skip entry without a name (e.g. "./").               */
+       *p_err = TFTPc_ERR_NONE;
+        return;
+    }
+
+    if (type == TFTPc_TAR_TYPE_DIR) {
+        if (TFTPc_TarSinkPtr == DEF_NULL) {
+           (void)NetFS_EntryCreate(&TFTPc_TarPath[0], DEF_YES); /* See Note #4.                                         */
+        }
+       *p_err = TFTPc_ERR_NONE;
+        return;
+    }
+
+    TFTPc_TRACE_INFO(("TFTPc_TarHdrProc: Extracting %s (%u octets)\n\r", &TFTPc_TarPath[0], (unsigned)size));
+
+    if (TFTPc_TarSinkPtr != DEF_NULL) {
+        ok = TFTPc_TarSinkPtr->EntryOpen(TFTPc_TarSinkPtr->CtxPtr, &TFTPc_TarPath[0], size);
+    } else {
+        TFTPc_FileHandle = TFTPc_FileOpenMode(&TFTPc_TarPath[0], TFTPc_FILE_OPEN_WR);
+        ok               = (TFTPc_FileHandle != (void *)0) ? DEF_OK : DEF_FAIL;
+    }
+    if (ok != DEF_OK) {
+       *p_err = TFTPC_ERR_FILE_OPEN;
+        return;
+    }
+
+    TFTPc_TarEntryOpen = DEF_YES;
+    if (size == 0u) {                                           /* Empty file : no data blk.                            */
+        TFTPc_TarEntryClose(DEF_YES);
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_TarNbrParse()
+*
+* Description : Parse a numeric header field.
+*
+* Argument(s) : p_field     Pointer to header field.
+*
+*               field_len   Length of header field (in octets).
+*
+*               p_nbr       Pointer to variable that will receive the parsed number.
+*
+* Return(s)   : DEF_OK,   if the field holds a valid number.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPc_TarHdrProc().
+*
+* Note(s)     : (1) The field holds octal digits, optionally preceded by spaces & terminated by a space or a
+*                   NULL character.  The base-256 encoding used by some archivers for numbers that do NOT fit
+*                   the field, & numbers greater than DEF_INT_32U_MAX_VAL, are NOT supported.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_TarNbrParse (const  CPU_INT08U  *p_field,
+                                               CPU_INT16U   field_len,
+                                               CPU_INT32U  *p_nbr)
+{
+    CPU_INT32U  nbr;
+    CPU_INT16U  ix;
+    CPU_INT16U  nbr_dig;
+
+
+    ix = 0u;
+    while ((ix         <  field_len) &&
+           (p_field[ix] == ASCII_CHAR_SPACE)) {
+        ix++;
+    }
+
+    nbr     = 0u;
+    nbr_dig = 0u;
+    while ((ix          <  field_len)             &&
+           (p_field[ix] >= ASCII_CHAR_DIGIT_ZERO) &&
+           (p_field[ix] <= ASCII_CHAR_DIGIT_SEVEN)) {
+        if (nbr > (DEF_INT_32U_MAX_VAL >> 3u)) {                /* See Note #1.                                         */
+            return (DEF_FAIL);
+        }
+        nbr = (nbr << 3u) | (CPU_INT32U)(p_field[ix] - ASCII_CHAR_DIGIT_ZERO);
+        nbr_dig++;
+        ix++;
+    }
+
+    if ((nbr_dig == 0u) ||
+       ((ix          <  field_len)        &&
+        (p_field[ix] != ASCII_CHAR_SPACE) &&
+        (p_field[ix] != ASCII_CHAR_NULL))) {
+        return (DEF_FAIL);
+    }
+
+   *p_nbr = nbr;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TarPathBuild()
+*
+* Description : Build the local path of the current entry in TFTPc_TarPath.
+*
+* Argument(s) : p_name_len  Pointer to variable that will receive the length of the entry name, 0 if the entry
+*                           has NO name once normalized.
+*
+* Return(s)   : DEF_OK,   if the path was built.
+*               DEF_FAIL, if the path is too long or the entry name is NOT safe (see Note #2).
+*
+* Caller(s)   : TFTPc_TarHdrProc().
+*
+* Note(s)     : (1) The path is the local directory (if NO entry sink is registered), followed by the ustar
+*                   name prefix (if any) & by the entry name.
+*
+*               (2) The entry name is normalized : leading, repeated & trailing '/' & "." components are
+*                   removed, so that absolute names are extracted below the local directory.  Names with a
+*                   ".." component are rejected, so that NO file is wr'n outside of the local directory.
+*
+*               (3) The '/' of the entry name are replaced by TFTPc_CFG_TAR_PATH_SEP_CHAR in a local path.
+*                   The entry sink receives the name with '/' separators.
+*
+*               (4) The name is split into components on TFTPc_CFG_TAR_PATH_SEP_CHAR as well as on '/' :
+*                   otherwise, a component holding the local separator (e.g. "..\x" for a '\' separator)
+*                   would escape the ".." check & the local directory.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_TarPathBuild (CPU_SIZE_T  *p_name_len)
+{
+    CPU_SIZE_T   path_len;
+    CPU_SIZE_T   name_ix;
+    CPU_SIZE_T   rd_ix;
+    CPU_SIZE_T   wr_ix;
+    CPU_SIZE_T   seg_ix;
+    CPU_SIZE_T   seg_len;
+    CPU_CHAR     sep_char;
+    CPU_CHAR    *p_prefix;
+    CPU_CHAR    *p_name;
+    CPU_BOOLEAN  ok;
+
+
+    path_len = 0u;
+    sep_char = ASCII_CHAR_SOLIDUS;
+    if (TFTPc_TarSinkPtr == DEF_NULL) {                         /* Local dir (see Note #1).                             */
+        sep_char = TFTPc_CFG_TAR_PATH_SEP_CHAR;
+        ok       = TFTPc_TarPathAdd(&path_len, TFTPc_TarDirPtr, TFTPc_CFG_TAR_PATH_LEN_MAX + 1u);
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+        if ((path_len                      >  0u) &&
+            (TFTPc_TarPath[path_len - 1u] != sep_char)) {
+            if (path_len >= TFTPc_CFG_TAR_PATH_LEN_MAX) {
+                return (DEF_FAIL);
+            }
+            TFTPc_TarPath[path_len] = sep_char;
+            path_len++;
+        }
+    }
+    name_ix = path_len;
+
+    p_prefix = (CPU_CHAR *)&TFTPc_TarHdrBuf[TFTPc_TAR_HDR_OFFSET_PREFIX];
+    p_name   = (CPU_CHAR *)&TFTPc_TarHdrBuf[TFTPc_TAR_HDR_OFFSET_NAME];
+    if ((Mem_Cmp(&TFTPc_TarHdrBuf[TFTPc_TAR_HDR_OFFSET_MAGIC],  /* Name prefix only in ustar hdrs.                      */
+                  TFTPc_TAR_MAGIC_STR,
+                  TFTPc_TAR_HDR_LEN_MAGIC) == DEF_YES) &&
+        (*p_prefix != ASCII_CHAR_NULL)) {
+        ok = TFTPc_TarPathAdd(&path_len, p_prefix, TFTPc_TAR_HDR_LEN_PREFIX);
+        if (ok == DEF_OK) {
+            ok = TFTPc_TarPathAdd(&path_len, "/", 1u);
+        }
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+    }
+    ok = TFTPc_TarPathAdd(&path_len, p_name, TFTPc_TAR_HDR_LEN_NAME);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+
+    rd_ix = name_ix;                                            /* Normalize entry name (see Note #2).                  */
+    wr_ix = name_ix;
+    while (rd_ix < path_len) {
+        seg_ix = rd_ix;
+        while ((rd_ix                < path_len)           &&   /* See Note #4.                                         */
+               (TFTPc_TarPath[rd_ix] != ASCII_CHAR_SOLIDUS) &&
+               (TFTPc_TarPath[rd_ix] != sep_char)) {
+            rd_ix++;
+        }
+        seg_len = rd_ix - seg_ix;
+        rd_ix++;
+
+        if ((seg_len == 0u) ||
+           ((seg_len == 1u) && (TFTPc_TarPath[seg_ix] == ASCII_CHAR_FULL_STOP))) {
+            continue;
+        }
+        if ((seg_len == 2u)                                    &&
+            (TFTPc_TarPath[seg_ix]      == ASCII_CHAR_FULL_STOP) &&
+            (TFTPc_TarPath[seg_ix + 1u] == ASCII_CHAR_FULL_STOP)) {
+            return (DEF_FAIL);
+        }
+
+        if (wr_ix > name_ix) {
+            TFTPc_TarPath[wr_ix] = sep_char;                    /* See Note #3.                                         */
+            wr_ix++;
+        }
+        while (seg_len > 0u) {
+            TFTPc_TarPath[wr_ix] = TFTPc_TarPath[seg_ix];
+            wr_ix++;
+            seg_ix++;
+            seg_len--;
+        }
+    }
+    TFTPc_TarPath[wr_ix] = ASCII_CHAR_NULL;
+
+   *p_name_len = wr_ix - name_ix;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_TarPathAdd()
+*
+* Description : Append a string to the local path of the current entry.
+*
+* Argument(s) : p_path_len      Pointer to the length of the path built so far, updated by this function.
+*
+*               p_str           Pointer to string to append.
+*
+*               str_len_max     Maximum number of characters to append, if NO NULL character is found before.
+*
+* Return(s)   : DEF_OK,   if the string was appended.
+*               DEF_FAIL, if the path would exceed TFTPc_CFG_TAR_PATH_LEN_MAX characters.
+*
+* Caller(s)   : TFTPc_TarPathBuild().
+*
+* Note(s)     : (1) The path is always NULL-terminated.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_TarPathAdd (       CPU_SIZE_T  *p_path_len,
+                                       const  CPU_CHAR    *p_str,
+                                              CPU_SIZE_T   str_len_max)
+{
+    CPU_SIZE_T  path_len;
+    CPU_SIZE_T  ix;
+
+
+    path_len = *p_path_len;
+    for (ix = 0u; (ix < str_len_max) && (p_str[ix] != ASCII_CHAR_NULL); ix++) {
+        if (path_len >= TFTPc_CFG_TAR_PATH_LEN_MAX) {
+            return (DEF_FAIL);
+        }
+        TFTPc_TarPath[path_len] = p_str[ix];
+        path_len++;
+    }
+    TFTPc_TarPath[path_len] = ASCII_CHAR_NULL;                  /* See Note #1.                                         */
+
+   *p_path_len = path_len;
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TarEntryClose()
+*
+* Description : Close the current entry.
+*
+* Argument(s) : complete    Indicates whether all the entry data was written.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TarWr(),
+*               TFTPc_TarHdrProc(),
+*               TFTPc_Terminate().
+*
+* Note(s)     : (1) An entry file left incomplete by an aborted transfer is closed but NOT removed.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+static  void  TFTPc_TarEntryClose (CPU_BOOLEAN  complete)
+{
+    if (TFTPc_TarSinkPtr != DEF_NULL) {
+        if (TFTPc_TarSinkPtr->EntryClose != DEF_NULL) {
+            TFTPc_TarSinkPtr->EntryClose(TFTPc_TarSinkPtr->CtxPtr, complete);
+        }
+    } else if (TFTPc_FileHandle != (void *)0) {                 /* See Note #1.                                         */
+        NetFS_FileClose(TFTPc_FileHandle);
+        TFTPc_FileHandle = (void *)0;
+    }
+
+    TFTPc_TarEntryOpen = DEF_NO;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_SparseSkip()
+*
+* Description : Skip data to write to the local file, if it only holds zero octets.
+*
+* Argument(s) : p_data      Pointer to data to write.
+*
+*               data_len    Length of data to write (in octets).
+*
+* Return(s)   : DEF_YES, if data skipped : the file position was moved past it.
+*               DEF_NO,  if data MUST be written.
+*
+* Caller(s)   : TFTPc_FileWr().
+*
+* Note(s)     : (1) See 'tftp-c_cfg.h  TFTPc SPARSE WRITE CONFIGURATION  Note #2'.  Data whose position can
+*                   NOT be set is written instead.
+*
+*               (2) Blocks of a multicast transfer are positioned by TFTPc_McastDataRx() & rx'd in any order :
+*                   the last block written is NOT always the end of the file, so they are always written.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_SparseSkip (const  CPU_INT08U  *p_data,
+                                              CPU_SIZE_T   data_len)
+{
+    CPU_BOOLEAN  skip;
+    CPU_BOOLEAN  ok;
+
+
+    skip = TFTPc_SparseIsFill(p_data, data_len, TFTPc_SPARSE_HOLE_VAL);
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if (TFTPc_McastSockID != NET_SOCK_ID_NONE) {                /* See Note #2.                                         */
+        skip = DEF_NO;
+    }
+#endif
+
+    if (skip == DEF_YES) {                                      /* See Note #1.                                         */
+        ok = NetFS_FilePosSet(TFTPc_FileHandle,
+                              (CPU_INT32S)data_len,
+                              NET_FS_SEEK_ORIGIN_CUR);
+        if (ok != DEF_OK) {
+            skip = DEF_NO;
+        }
+    }
+
+    if (skip == DEF_YES) {
+        TFTPc_STAT_ADD(SparseOctetCtr, data_len);
+        TFTPc_SparseHole = DEF_YES;
+    } else {
+        TFTPc_SparseHole = DEF_NO;
+    }
+
+    return (skip);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_SparseFlush()
+*
+* Description : Extend the local file up to the current file position, if it ends with skipped data.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FILE_WR   Error writing to file.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DataGetWr().
+*
+* Note(s)     : (1) Setting the file position does NOT change the file size : the last skipped octet is
+*                   written, which extends the file over the whole hole.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+static  void  TFTPc_SparseFlush (TFTPc_ERR  *p_err)
+{
+    CPU_INT08U   hole_val;
+    CPU_SIZE_T   wr_len;
+    CPU_BOOLEAN  ok;
+
+
+    if (TFTPc_SparseHole == DEF_NO) {
+       *p_err = TFTPc_ERR_NONE;
+        goto exit;
+    }
+
+    hole_val = TFTPc_SPARSE_HOLE_VAL;                           /* See Note #1.                                         */
+    wr_len   = 0u;
+    ok       = NetFS_FilePosSet(TFTPc_FileHandle, -1, NET_FS_SEEK_ORIGIN_CUR);
+    if (ok == DEF_OK) {
+       (void)NetFS_FileWr((void       *) TFTPc_FileHandle,
+                          (void       *)&hole_val,
+                          (CPU_SIZE_T  ) 1u,
+                          (CPU_SIZE_T *)&wr_len);
+    }
+
+    if (wr_len != 1u) {
+       *p_err = TFTPc_ERR_FILE_WR;
+        goto exit;
+    }
+
+    TFTPc_SparseHole = DEF_NO;
+   *p_err            = TFTPc_ERR_NONE;
+
+
+exit:
+    return;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_SparseIsFill()
+*
+* Description : Check whether data only holds a given octet value.
+*
+* Argument(s) : p_data      Pointer to data to check.
+*
+*               data_len    Length of data to check (in octets).
+*
+*               fill_val    Octet value to look for.
+*
+* Return(s)   : DEF_YES, if every octet of the data is 'fill_val' (or if data is empty).
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPc_SparseSkip(),
+*               TFTPc_FlashPageProg().
+*
+* Note(s)     : (1) The data is compared one CPU data word at a time, once the octets before the first
+*                   aligned word are checked.  The scan stops at the first mismatch, which for file data
+*                   is almost always within the first words.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_SparseIsFill (const  CPU_INT08U  *p_data,
+                                                CPU_SIZE_T   data_len,
+                                                CPU_INT08U   fill_val)
+{
+    const  CPU_DATA    *p_word;
+           CPU_DATA     fill_word;
+           CPU_SIZE_T   ix;
+
+
+    while ((data_len > 0u) &&                                   /* Chk octets up to 1st aligned word.                   */
+           (((CPU_ADDR)p_data % sizeof(CPU_DATA)) != 0u)) {
+        if (*p_data != fill_val) {
+            return (DEF_NO);
+        }
+        p_data++;
+        data_len--;
+    }
+
+    fill_word = 0u;
+    for (ix = 0u; ix < sizeof(CPU_DATA); ix++) {
+        fill_word = (CPU_DATA)((fill_word << DEF_OCTET_NBR_BITS) | fill_val);
+    }
+
+    p_word = (const CPU_DATA *)p_data;                          /* Chk aligned words (see Note #1).                     */
+    while (data_len >= sizeof(CPU_DATA)) {
+        if (*p_word != fill_word) {
+            return (DEF_NO);
+        }
+        p_word++;
+        data_len -= sizeof(CPU_DATA);
+    }
+
+    p_data = (const CPU_INT08U *)p_word;                        /* Chk remaining octets.                                */
+    while (data_len > 0u) {
+        if (*p_data != fill_val) {
+            return (DEF_NO);
+        }
+        p_data++;
+        data_len--;
+    }
+
+    return (DEF_YES);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelayPeerGet()
+*
+* Description : Request a file from the relay peers, in order, until one of them sends it.
+*
+* Argument(s) : p_filename_remote   Pointer to name of the file to be read from the peers.
+*
+*               mode                TFTP transfer mode, as passed to TFTPc_Get().
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       TFTPc_ERR_NONE      File rx'd from a peer, or file to be req'd from the
+*                                                               server (see Note #3).
+*
+*                                       ------------ RETURNED BY TFTPc_Processing() ------------
+*                                       See TFTPc_Processing() for additional return error codes.
+*
+* Return(s)   : DEF_YES, if the file was rx'd from a peer.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPc_Get().
+*
+* Note(s)     : (1) Only octet mode files are req'd from the peers, since the relay responder only serves
+*                   octet mode requests (see 'TFTPc_RelaySrvProcess()  Note #2').
+*
+*               (2) The peers are req'd by unicast : the multicast option is NOT req'd from a peer.
+*
+*               (3) The next peer, then the server, is req'd only if the peer did NOT send any block of the
+*                   file & did NOT answer with anything but an error.  Once a block is wr'n, or if the
+*                   transfer is aborted or the local file can NOT be wr'n, the session is terminated & the
+*                   error is returned.
+*
+*               (4) Before the next peer is req'd, the socket is closed & the session is reset as if just
+*                   initialized.  The ERROR rx'd from a peer is cleared, so that TFTPc_ServerErrGet() only
+*                   reports an ERROR rx'd from the server.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_RelayPeerGet (CPU_CHAR    *p_filename_remote,
+                                         TFTPc_MODE   mode,
+                                         TFTPc_ERR   *p_err)
+{
+    const  TFTPc_CFG           *p_peer;
+           NET_IP_ADDR_FAMILY   ip_family;
+           CPU_BOOLEAN          fallback;
+           CPU_INT08U           ix;
+
+
+   *p_err = TFTPc_ERR_NONE;
+                                                                /* See Note #1.                                         */
+    if ((mode & (TFTPc_MODE)~(TFTPc_MODE_FLAG_CODEC | TFTPc_MODE_FLAG_MCAST |
+                              TFTPc_MODE_FLAG_FLASH | TFTPc_MODE_FLAG_TAR   |
+                              TFTPc_MODE_FLAG_BG)) != TFTPc_MODE_OCTET) {
+        return (DEF_NO);
+    }
+
+    mode &= (TFTPc_MODE)~TFTPc_MODE_FLAG_MCAST;                 /* See Note #2.                                         */
+
+    for (ix = 0u; ix < TFTPc_RelayPeerNbr; ix++) {
+        p_peer    = &TFTPc_RelayPeerTbl[ix];
+        ip_family =  p_peer->ServerAddrFamily;
+        if (ip_family == NET_IP_ADDR_FAMILY_NONE) {
+            ip_family = TFTPc_IP_ADDR_FAMILY_FIRST;
+        }
+
+        TFTPc_TRACE_INFO(("TFTPc_RelayPeerGet: Request to peer %s\n\r", p_peer->ServerHostnamePtr));
+
+       (void)TFTPc_SockInit(p_peer->ServerHostnamePtr,          /* Init sock.                                           */
+                            p_peer->ServerPortNbr,
+                            ip_family,
+                            p_err);
+        if (*p_err == TFTPc_ERR_NONE) {
+                                                                /* Tx rd req.                                           */
+            TFTPc_TxReq(TFTP_OPCODE_RRQ, p_filename_remote, mode, p_err);
+            if (*p_err == TFTPc_ERR_NONE) {
+                                                                /* Process req.                                         */
+                TFTPc_RxBlkNbrNext = 1;
+                TFTPc_State        = TFTPc_STATE_DATA_GET;
+
+                TFTPc_SessionKeep  = DEF_YES;
+                TFTPc_Processing(p_peer, p_err);
+                TFTPc_SessionKeep  = DEF_NO;
+                if (*p_err == TFTPc_ERR_NONE) {
+                    return (DEF_YES);
+                }
+            }
+        }
+                                                                /* ------------- CHK FALLBACK (see Note #3) ----------- */
+        switch (*p_err) {
+            case TFTPc_ERR_INVALID_PROTO_FAMILY:
+            case TFTPc_ERR_NO_SOCK:
+            case TFTPc_ERR_TX:
+            case TFTPc_ERR_RX:
+            case TFTPc_ERR_RX_TIMEOUT:
+            case TFTPc_ERR_ERR_PKT_RX:
+            case TFTPc_ERR_INVALID_OPCODE_RX:
+            case TFTPc_ERR_OPT_NEGO:
+                 fallback = (TFTPc_RxBlkNbrNext == 1) ? DEF_YES : DEF_NO;
+                 break;
+
+
+            default:
+                 fallback = DEF_NO;
+                 break;
+        }
+
+        if (fallback == DEF_NO) {
+            TFTPc_Terminate();
+            return (DEF_NO);
+        }
+
+        TFTPc_TRACE_INFO(("TFTPc_RelayPeerGet: Peer failed, error %u\n\r", (unsigned)*p_err));
+
+        TFTPc_SessionSrcReset();                                /* See Note #4.                                         */
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+
+    return (DEF_NO);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_RelayCacheRemove()
+*
+* Description : Remove the entries of a local file from the relay cache.
+*
+* Argument(s) : p_filename_local    Pointer to name of the local file.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get().
+*
+* Note(s)     : (1) The file is removed before it is opened to be overwritten.  A transfer serving the file to
+*                   a peer is aborted before its next block is read (see 'TFTPc_RelaySrvProcess()  Note #3').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  void  TFTPc_RelayCacheRemove (const  CPU_CHAR  *p_filename_local)
+{
+    CPU_INT08U  ix;
+    TFTPc_ERR   err;
+
+
+    if (p_filename_local == DEF_NULL) {
+        return;
+    }
+
+    TFTPc_RelayLockAcquire(&err);                               /* See Note #1.                                         */
+    if (err != TFTPc_ERR_NONE) {
+        return;
+    }
+
+    for (ix = 0u; ix < TFTPc_CFG_RELAY_CACHE_NBR; ix++) {
+        if ((TFTPc_RelayCache[ix].NameRemote[0] != ASCII_CHAR_NULL) &&
+            (Str_Cmp(&TFTPc_RelayCache[ix].NameLocal[0], p_filename_local) == 0)) {
+            TFTPc_RelayCache[ix].NameRemote[0] = ASCII_CHAR_NULL;
+            if (&TFTPc_RelayCache[ix] == TFTPc_RelaySrvEntryPtr) {
+                TFTPc_RelaySrvEntryPtr = DEF_NULL;
+            }
+        }
+    }
+
+    TFTPc_RelayLockRelease();
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_RelayLockAcquire()
+*
+* Description : Acquire the relay cache lock.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      Lock acquired.
+*                               TFTPc_ERR_LOCK      Lock could NOT be acquired.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RelayCacheAdd(),
+*               TFTPc_RelayCacheRemove(),
+*               TFTPc_RelaySrvServe().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  void  TFTPc_RelayLockAcquire (TFTPc_ERR  *p_err)
+{
+    KAL_ERR  err;
+
+
+    KAL_LockAcquire(TFTPc_RelayLockHandle, KAL_OPT_PEND_NONE, 0, &err);
+    if (err != KAL_ERR_NONE) {
+       *p_err = TFTPc_ERR_LOCK;
+        return;
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_RelayLockRelease()
+*
+* Description : Release the relay cache lock.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RelayCacheAdd(),
+*               TFTPc_RelayCacheRemove(),
+*               TFTPc_RelaySrvServe().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  void  TFTPc_RelayLockRelease (void)
+{
+    KAL_ERR  err;
+
+
+    KAL_LockRelease(TFTPc_RelayLockHandle, &err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelaySrvServe()
+*
+* Description : Serve a request rx'd by the relay responder.
+*
+* Argument(s) : p_addr_peer     Pointer to address of the requesting peer.
+*
+*               req_len         Length of the request pkt in TFTPc_RelayRxPktBuf (in octets).
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   TFTPc_ERR_NONE          Request served, or rejected (see Note #1).
+*                                   TFTPc_ERR_NO_SOCK       Transfer socket could NOT be opened.
+*                                   TFTPc_ERR_FILE_RD       Error reading the cached file.
+*                                   TFTPc_ERR_RELAY         Cached file replaced while served.
+*
+*                                   ---------- RETURNED BY TFTPc_RelayLockAcquire() ----------
+*                                   See TFTPc_RelayLockAcquire() for additional return error codes.
+*
+*                                   ------------ RETURNED BY TFTPc_RelaySrvBlkTx() ------------
+*                                   See TFTPc_RelaySrvBlkTx() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RelaySrvProcess().
+*
+* Note(s)     : (1) A malformed request, a request other than an octet mode read request, a request for a file
+*                   NOT cached, or a request with an invalid block size is answered with an ERROR pkt from the
+*                   responder socket & is NOT an error of the responder.
+*
+*               (2) The file is sent from a new socket, bound to an ephemeral port that is the responder TID
+*                   for the transfer (see RFC #1350, section 4 'Initial Connection Protocol').
+*
+*               (3) If the block size option was req'd, the OACK is sent as block 0 & MUST be acknowledged
+*                   with an ACK of block 0 (RFC #2347, section 'Negotiation Protocol').
+*
+*               (4) Each DATA block but the last one holds the negotiated block size : the file is sent once a
+*                   shorter block, possibly empty, is acknowledged.  The relay lock is only held to read each
+*                   block (see 'TFTPc_RelaySrvProcess()  Note #3').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  void  TFTPc_RelaySrvServe (NET_SOCK_ADDR  *p_addr_peer,
+                                   CPU_INT16U      req_len,
+                                   TFTPc_ERR      *p_err)
+{
+    TFTPc_RELAY_CACHE_ENTRY   *p_entry;
+    CPU_CHAR                  *p_filename;
+    CPU_CHAR                  *p_mode;
+    void                      *p_file;
+    CPU_SIZE_T                 filename_len;
+    CPU_SIZE_T                 mode_len;
+    CPU_SIZE_T                 rd_len;
+    CPU_INT16U                 ix;
+    CPU_INT16U                 blk_nbr;
+    CPU_INT16U                 blk_size;
+    CPU_INT16U                 oack_len;
+    CPU_BOOLEAN                ok;
+    NET_SOCK_ID                sock_id;
+    NET_SOCK_PROTOCOL_FAMILY   protocol_family;
+    NET_ERR                    err_net;
+    TFTPc_ERR                  err;
+
+
+   *p_err = TFTPc_ERR_NONE;
+                                                                /* ------------------ PARSE REQUEST ------------------- */
+    if ((req_len < TFTP_PKT_OFFSET_FILENAME) ||
+        (NET_UTIL_VAL_GET_NET_16(&TFTPc_RelayRxPktBuf[TFTP_PKT_OFFSET_OPCODE]) != TFTP_OPCODE_RRQ)) {
+        TFTPc_RelaySrvTxErr(TFTPc_RelaySrvSockID, p_addr_peer, TFTP_ERR_CODE_ILLEGAL_OP, TFTPc_ERR_MSG_REQ_UNSUPPORTED);
+        return;
+    }
+
+    p_filename   = (CPU_CHAR *)&TFTPc_RelayRxPktBuf[TFTP_PKT_OFFSET_FILENAME];
+    filename_len =  Str_Len_N(p_filename, req_len - TFTP_PKT_OFFSET_FILENAME);
+    ix           =  TFTP_PKT_OFFSET_FILENAME + filename_len + TFTP_PKT_SIZE_NULL;
+    if (ix >= req_len) {                                        /* Filename NOT terminated, or no mode.                 */
+        TFTPc_RelaySrvTxErr(TFTPc_RelaySrvSockID, p_addr_peer, TFTP_ERR_CODE_ILLEGAL_OP, TFTPc_ERR_MSG_REQ_UNSUPPORTED);
+        return;
+    }
+
+    p_mode   = (CPU_CHAR *)&TFTPc_RelayRxPktBuf[ix];
+    mode_len =  Str_Len_N(p_mode, req_len - ix);
+    if (((ix + mode_len) >= req_len) ||                         /* Mode NOT terminated, or NOT octet (see Note #1).     */
+        (Str_CmpIgnoreCase(p_mode, TFTP_MODE_BINARY_STR) != 0)) {
+        TFTPc_RelaySrvTxErr(TFTPc_RelaySrvSockID, p_addr_peer, TFTP_ERR_CODE_ILLEGAL_OP, TFTPc_ERR_MSG_REQ_UNSUPPORTED);
+        return;
+    }
+    ix += (CPU_INT16U)(mode_len + TFTP_PKT_SIZE_NULL);
+
+    blk_size = 0u;
+    ok       = TFTPc_RelaySrvOptRx(ix, req_len, &blk_size);
+    if (ok != DEF_OK) {                                         /* Invalid blk size (see Note #1).                      */
+        TFTPc_RelaySrvTxErr(TFTPc_RelaySrvSockID, p_addr_peer, TFTP_ERR_CODE_OPT_NEGO, TFTPc_ERR_MSG_BLKSIZE_INVALID);
+        return;
+    }
+                                                                /* ------------------ OPEN CACHED FILE ---------------- */
+    TFTPc_RelayLockAcquire(p_err);
+    if (*p_err != TFTPc_ERR_NONE) {
+        return;
+    }
+
+    p_entry = DEF_NULL;
+    for (ix = 0u; ix < TFTPc_CFG_RELAY_CACHE_NBR; ix++) {
+        if ((TFTPc_RelayCache[ix].NameRemote[0] != ASCII_CHAR_NULL) &&
+            (Str_Cmp(&TFTPc_RelayCache[ix].NameRemote[0], p_filename) == 0)) {
+            p_entry = &TFTPc_RelayCache[ix];
+            break;
+        }
+    }
+
+    p_file = DEF_NULL;
+    if (p_entry != DEF_NULL) {
+        p_file = NetFS_FileOpen(&p_entry->NameLocal[0],
+                                 NET_FS_FILE_MODE_OPEN,
+                                 NET_FS_FILE_ACCESS_RD);
+    }
+    if (p_file != DEF_NULL) {
+        TFTPc_RelaySrvEntryPtr = p_entry;
+    }
+
+    TFTPc_RelayLockRelease();
+
+    if (p_file == DEF_NULL) {
+        TFTPc_TRACE_INFO(("TFTPc_RelaySrvServe: %s not cached\n\r", p_filename));
+        TFTPc_RelaySrvTxErr(TFTPc_RelaySrvSockID, p_addr_peer, TFTP_ERR_CODE_FILE_NOT_FOUND, TFTPc_ERR_MSG_NOT_CACHED);
+        return;
+    }
+
+    TFTPc_TRACE_INFO(("TFTPc_RelaySrvServe: Serving %s\n\r", p_filename));
+
+                                                                /* --------- OPEN TRANSFER SOCK (see Note #2) --------- */
+    protocol_family = (p_addr_peer->AddrFamily == NET_SOCK_ADDR_FAMILY_IP_V6) ? NET_SOCK_PROTOCOL_FAMILY_IP_V6
+                                                                                : NET_SOCK_PROTOCOL_FAMILY_IP_V4;
+    sock_id = NetSock_Open(protocol_family,
+                           NET_SOCK_TYPE_DATAGRAM,
+                           NET_SOCK_PROTOCOL_UDP,
+                          &err_net);
+    if (err_net != NET_SOCK_ERR_NONE) {
+       *p_err = TFTPc_ERR_NO_SOCK;
+        goto exit_close;
+    }
+
+   (void)NetSock_CfgBlock(sock_id, NET_SOCK_BLOCK_SEL_BLOCK, &err_net);
+    NetSock_CfgTimeoutRxQ_Set(sock_id,
+                              TFTPc_CFG_RELAY_SRV_TIMEOUT_ms,
+                             &err_net);
+
+                                                                /* -------------- TX OACK (see Note #3) --------------- */
+    if (blk_size == 0u) {                                       /* If blk size NOT req'd, ...                           */
+        blk_size = TFTPc_DATA_BLOCK_SIZE;                       /* ... use default blk size.                            */
+    } else {
+        NET_UTIL_VAL_SET_NET_16(&TFTPc_RelayTxPktBuf[TFTP_PKT_OFFSET_OPCODE],
+                                 TFTP_OPCODE_OACK);
+        oack_len = TFTP_PKT_SIZE_OPCODE;
+        Str_Copy((CPU_CHAR *)&TFTPc_RelayTxPktBuf[oack_len], TFTP_OPT_BLKSIZE_STR);
+        oack_len += sizeof(TFTP_OPT_BLKSIZE_STR);
+       (void)Str_FmtNbr_Int32U((CPU_INT32U) blk_size,
+                               (CPU_INT08U)(TFTP_OPT_NBR_VAL_LEN_MAX - 1u),
+                                            DEF_NBR_BASE_DEC,
+                                            ASCII_CHAR_NULL,
+                                            DEF_NO,
+                                            DEF_YES,
+                               (CPU_CHAR *)&TFTPc_RelayTxPktBuf[oack_len]);
+        oack_len += (CPU_INT16U)(Str_Len((CPU_CHAR *)&TFTPc_RelayTxPktBuf[oack_len]) + TFTP_PKT_SIZE_NULL);
+
+        TFTPc_RelaySrvBlkTx(sock_id, p_addr_peer, 0u, oack_len, p_err);
+    }
+
+                                                                /* ------------ SEND FILE (see Note #4) --------------- */
+    blk_nbr = 0u;
+    rd_len  = blk_size;
+    while ((*p_err == TFTPc_ERR_NONE) &&
+           (rd_len == blk_size)) {
+        blk_nbr++;
+        rd_len = 0u;
+        TFTPc_RelayLockAcquire(p_err);
+        if (*p_err != TFTPc_ERR_NONE) {
+            break;
+        }
+        if (TFTPc_RelaySrvEntryPtr == DEF_NULL) {               /* If entry replaced, ...                               */
+            TFTPc_RelayLockRelease();
+            TFTPc_RelaySrvTxErr(sock_id, p_addr_peer, TFTP_ERR_CODE_NOT_DEF, TFTPc_ERR_MSG_CACHE_CHANGED);
+           *p_err = TFTPc_ERR_RELAY;                            /* ... abort transfer.                                  */
+            break;
+        }
+        ok = NetFS_FileRd((void       *) p_file,
+                          (void       *)&TFTPc_RelayTxPktBuf[TFTP_PKT_OFFSET_DATA],
+                          (CPU_SIZE_T  ) blk_size,
+                          (CPU_SIZE_T *)&rd_len);
+        TFTPc_RelayLockRelease();
+
+        if ((rd_len == 0u) &&                                   /* If NO data rd & err occurred (NOT EOF), ...          */
+            (ok     == DEF_FAIL)) {
+            TFTPc_RelaySrvTxErr(sock_id, p_addr_peer, TFTP_ERR_CODE_NOT_DEF, TFTPc_ERR_MSG_RD_ERR);
+           *p_err = TFTPc_ERR_FILE_RD;                          /* ... abort transfer.                                  */
+            break;
+        }
+
+        NET_UTIL_VAL_SET_NET_16(&TFTPc_RelayTxPktBuf[TFTP_PKT_OFFSET_OPCODE],
+                                 TFTP_OPCODE_DATA);
+        NET_UTIL_VAL_SET_NET_16(&TFTPc_RelayTxPktBuf[TFTP_PKT_OFFSET_BLK_NBR],
+                                 blk_nbr);
+
+        TFTPc_RelaySrvBlkTx(sock_id,
+                            p_addr_peer,
+                            blk_nbr,
+                            TFTP_PKT_OFFSET_DATA + (CPU_INT16U)rd_len,
+                            p_err);
+    }
+
+    NetSock_Close(sock_id, &err_net);
+
+
+exit_close:
+    NetFS_FileClose(p_file);
+
+    TFTPc_RelayLockAcquire(&err);                               /* Release entry.                                       */
+    if (err == TFTPc_ERR_NONE) {
+        TFTPc_RelaySrvEntryPtr = DEF_NULL;
+        TFTPc_RelayLockRelease();
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelaySrvOptRx()
+*
+* Description : Parse the options of a request rx'd by the relay responder.
+*
+* Argument(s) : opt_ix          Index of the first option in TFTPc_RelayRxPktBuf.
+*
+*               req_len         Length of the request pkt in TFTPc_RelayRxPktBuf (in octets).
+*
+*               p_blk_size      Pointer to variable that will receive the block size of the transfer, if the
+*                               block size option was req'd.  Left unchanged otherwise.
+*
+* Return(s)   : DEF_OK,   if the options are valid.
+*               DEF_FAIL, if the block size req'd is invalid.
+*
+* Caller(s)   : TFTPc_RelaySrvServe().
+*
+* Note(s)     : (1) A truncated option, & the options other than the block size, are ignored (RFC #2347,
+*                   section 'Negotiation Protocol').
+*
+*               (2) See 'TFTPc LAN RELAY DEFINES  Note #1'.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_RelaySrvOptRx (CPU_INT16U   opt_ix,
+                                          CPU_INT16U   req_len,
+                                          CPU_INT16U  *p_blk_size)
+{
+    CPU_CHAR    *p_opt_name;
+    CPU_CHAR    *p_opt_val;
+    CPU_CHAR    *p_end;
+    CPU_SIZE_T   str_len;
+    CPU_INT32U   blk_size;
+
+
+    while (opt_ix < req_len) {
+        p_opt_name  = (CPU_CHAR *)&TFTPc_RelayRxPktBuf[opt_ix];
+        str_len     =  Str_Len_N(p_opt_name, req_len - opt_ix);
+        opt_ix     += (CPU_INT16U)(str_len + TFTP_PKT_SIZE_NULL);
+        if (opt_ix >= req_len) {                                /* See Note #1.                                         */
+            break;
+        }
+
+        p_opt_val   = (CPU_CHAR *)&TFTPc_RelayRxPktBuf[opt_ix];
+        str_len     =  Str_Len_N(p_opt_val, req_len - opt_ix);
+        if ((opt_ix + str_len) >= req_len) {
+            break;
+        }
+        opt_ix     += (CPU_INT16U)(str_len + TFTP_PKT_SIZE_NULL);
+
+        if (Str_CmpIgnoreCase(p_opt_name, TFTP_OPT_BLKSIZE_STR) != 0) {
+            continue;
+        }
+
+        blk_size = Str_ParseNbr_Int32U(p_opt_val, &p_end, 10u);
+        if ((p_end    == p_opt_val)       ||
+            (*p_end   != ASCII_CHAR_NULL) ||
+            (blk_size <  TFTPc_RELAY_BLKSIZE_MIN)) {            /* See Note #2.                                         */
+            return (DEF_FAIL);
+        }
+       *p_blk_size = (CPU_INT16U)DEF_MIN(blk_size, TFTPc_BLK_SIZE_MAX);
+    }
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelaySrvBlkTx()
+*
+* Description : Transmit a DATA block to a relay peer & wait for its acknowledgment.
+*
+* Argument(s) : sock_id         Transfer socket.
+*
+*               p_addr_peer     Pointer to address of the peer.
+*
+*               blk_nbr         Number of the block to transmit.
+*
+*               pkt_len         Length of the DATA pkt in TFTPc_RelayTxPktBuf (in octets).
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   TFTPc_ERR_NONE      Block acknowledged.
+*                                   TFTPc_ERR_RELAY     Peer aborted the transfer, or did NOT acknowledge the
+*                                                           block after TFTPc_CFG_RELAY_SRV_RETRY_MAX re-tx.
+*                                   TFTPc_ERR_TX        Error transmitting the block.
+*                                   TFTPc_ERR_RX        Error receiving the acknowledgment.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RelaySrvServe().
+*
+* Note(s)     : (1) The pkts NOT rx'd from the peer TID, & the ACKs of a previous block, are ignored.  The ACK
+*                   of a previous block is NOT answered, to avoid the duplicated DATA of the 'Sorcerer's
+*                   Apprentice' syndrome (see RFC #1123, section 4.2.3.1).
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  void  TFTPc_RelaySrvBlkTx (NET_SOCK_ID      sock_id,
+                                   NET_SOCK_ADDR   *p_addr_peer,
+                                   CPU_INT16U       blk_nbr,
+                                   CPU_INT16U       pkt_len,
+                                   TFTPc_ERR       *p_err)
+{
+    NET_SOCK_ADDR       addr_rx;
+    NET_SOCK_ADDR_LEN   addr_len;
+    NET_SOCK_RTN_CODE   rx_len;
+    CPU_INT16U          opcode;
+    CPU_INT08U          retry;
+    NET_ERR             err_net;
+
+
+    retry = 0u;
+    for (;;) {
+       (void)NetSock_TxDataTo((NET_SOCK_ID      ) sock_id,
+                              (void            *)&TFTPc_RelayTxPktBuf[0],
+                              (CPU_INT16U       ) pkt_len,
+                              (CPU_INT16S       ) NET_SOCK_FLAG_NONE,
+                              (NET_SOCK_ADDR   *) p_addr_peer,
+                              (NET_SOCK_ADDR_LEN) sizeof(NET_SOCK_ADDR),
+                              (NET_ERR         *)&err_net);
+        if (err_net != NET_SOCK_ERR_NONE) {
+           *p_err = TFTPc_ERR_TX;
+            return;
+        }
+
+        do {                                                    /* Wait for ACK of blk (see Note #1).                   */
+            addr_len = sizeof(addr_rx);
+            rx_len   = NetSock_RxDataFrom((NET_SOCK_ID        ) sock_id,
+                                          (void              *)&TFTPc_RelayRxPktBuf[0],
+                                          (CPU_INT16U         ) sizeof(TFTPc_RelayRxPktBuf),
+                                          (CPU_INT16S         ) NET_SOCK_FLAG_NONE,
+                                          (NET_SOCK_ADDR     *)&addr_rx,
+                                          (NET_SOCK_ADDR_LEN *)&addr_len,
+                                          (void              *) 0,
+                                          (CPU_INT08U         ) 0,
+                                          (CPU_INT08U        *) 0,
+                                          (NET_ERR           *)&err_net);
+            if ((err_net == NET_SOCK_ERR_NONE) &&
+                (rx_len  >= (TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR)) &&
+                (TFTPc_SockAddrCmp(&addr_rx, p_addr_peer, DEF_YES) == DEF_YES)) {
+                opcode = NET_UTIL_VAL_GET_NET_16(&TFTPc_RelayRxPktBuf[TFTP_PKT_OFFSET_OPCODE]);
+                if ((opcode                                                              == TFTP_OPCODE_ACK) &&
+                    (NET_UTIL_VAL_GET_NET_16(&TFTPc_RelayRxPktBuf[TFTP_PKT_OFFSET_BLK_NBR]) == blk_nbr)) {
+                   *p_err = TFTPc_ERR_NONE;
+                    return;
+                }
+
+                if (opcode == TFTP_OPCODE_ERR) {                /* Transfer aborted by peer.                            */
+                   *p_err = TFTPc_ERR_RELAY;
+                    return;
+                }
+            }
+        } while (err_net == NET_SOCK_ERR_NONE);
+
+        if (err_net != NET_SOCK_ERR_RX_Q_EMPTY) {
+           *p_err = TFTPc_ERR_RX;
+            return;
+        }
+
+        if (retry >= TFTPc_CFG_RELAY_SRV_RETRY_MAX) {           /* Peer stopped acknowledging.                          */
+           *p_err = TFTPc_ERR_RELAY;
+            return;
+        }
+        retry++;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_RelaySrvTxErr()
+*
+* Description : Transmit a TFTP error packet to a relay peer.
+*
+* Argument(s) : sock_id         Socket to transmit the error packet from.
+*
+*               p_addr_peer     Pointer to address of the peer.
+*
+*               err_code        Code indicating the nature of the error.
+*
+*               p_err_msg       String associated with error (terminated by NULL character).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RelaySrvServe().
+*
+* Note(s)     : (1) The error packet is NOT re-tx'd & a transmit error is ignored (see RFC #1350, section 7
+*                   'Error Packet').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+static  void  TFTPc_RelaySrvTxErr (NET_SOCK_ID      sock_id,
+                                   NET_SOCK_ADDR   *p_addr_peer,
+                                   CPU_INT16U       err_code,
+                                   CPU_CHAR        *p_err_msg)
+{
+    CPU_INT16U  err_msg_len;
+    CPU_INT16U  pkt_len;
+    NET_ERR     err_net;
+
+
+    NET_UTIL_VAL_SET_NET_16(&TFTPc_RelayTxPktBuf[TFTP_PKT_OFFSET_OPCODE],
+                             TFTP_OPCODE_ERR);
+
+    NET_UTIL_VAL_SET_NET_16(&TFTPc_RelayTxPktBuf[TFTP_PKT_OFFSET_ERR_CODE],
+                             err_code);
+
+    Str_Copy((CPU_CHAR *)&TFTPc_RelayTxPktBuf[TFTP_PKT_OFFSET_ERR_MSG],
+             (CPU_CHAR *) p_err_msg);
+
+    err_msg_len = Str_Len(p_err_msg);
+    pkt_len     = TFTP_PKT_SIZE_OPCODE   +
+                  TFTP_PKT_SIZE_ERR_CODE +
+                  err_msg_len            +
+                  TFTP_PKT_SIZE_NULL;
+                                                                /* Tx pkt once (see Note #1).                           */
+   (void)NetSock_TxDataTo((NET_SOCK_ID      ) sock_id,
+                          (void            *)&TFTPc_RelayTxPktBuf[0],
+                          (CPU_INT16U       ) pkt_len,
+                          (CPU_INT16S       ) NET_SOCK_FLAG_NONE,
+                          (NET_SOCK_ADDR   *) p_addr_peer,
+                          (NET_SOCK_ADDR_LEN) sizeof(NET_SOCK_ADDR),
+                          (NET_ERR         *)&err_net);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_SessionSrcReset()
+*
+* Description : Reset the session before the request is tx'd to another source.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RelayPeerGet(),
+*               TFTPc_PoolGet().
+*
+* Note(s)     : (1) The socket is closed & the multicast group left, as on session termination, but the local
+*                   file, the codec & the flash sink are kept.  The ERROR rx'd from the previous source is
+*                   cleared, so that TFTPc_ServerErrGet() only reports an ERROR rx'd from the last one.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_SESSION_KEEP_EN
+static  void  TFTPc_SessionSrcReset (void)
+{
+    NET_ERR  err_net;
+
+
+    if (TFTPc_SockID != NET_SOCK_ID_NONE) {
+        NetSock_Close(TFTPc_SockID, &err_net);
+        TFTPc_SockID = NET_SOCK_ID_NONE;
+    }
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if (TFTPc_McastSockID != NET_SOCK_ID_NONE) {
+       (void)NetIGMP_HostGrpLeave(TFTPc_McastIF_Nbr, TFTPc_McastAddr, &err_net);
+        NetSock_Close(TFTPc_McastSockID, &err_net);
+        TFTPc_McastSockID = NET_SOCK_ID_NONE;
+    }
+    TFTPc_McastMaster     = DEF_NO;
+    TFTPc_McastBlkMissing = 1u;
+    TFTPc_McastBlkLast    = 0u;
+    TFTPc_McastFileLen    = 0u;
+    Mem_Clr(&TFTPc_McastBitmap[0], sizeof(TFTPc_McastBitmap));
+#endif
+
+    TFTPc_RxPktLen   = 0;
+    TFTPc_TxPktLen   = 0;
+    TFTPc_TxPktRetry = 0;
+    TFTPc_TID_Set    = DEF_NO;
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)
+    TFTPc_SockConn   = DEF_NO;
+#endif
+#if (TFTPc_CFG_RX_DUP_REACK_EN == DEF_ENABLED)
+    TFTPc_ReAckDone  = DEF_NO;
+#endif
+
+    Mem_Clr(&TFTPc_ServerErr, sizeof(TFTPc_ServerErr));         /* See Note #1.                                         */
+    TFTPc_ServerErr.SessionID = TFTPc_SessionID;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_PoolGet()
+*
+* Description : Request a file from the pool servers, in order of expected response time, until one of them
+*               sends it.
+*
+* Argument(s) : p_filename_remote   Pointer to name of the file to be read from the servers.
+*
+*               mode                TFTP transfer mode, as passed to TFTPc_Get().
+*
+*               p_err               Pointer to variable that will receive the return error code from this function :
+*
+*                                       TFTPc_ERR_NONE      File rx'd from a pool server.
+*                                       TFTPc_ERR_FILE_WR   Local file could NOT be rewound (see Note #3b).
+*
+*                                       ------------ RETURNED BY TFTPc_SockInit() ------------
+*                                       See TFTPc_SockInit() for additional return error codes.
+*
+*                                       ------------ RETURNED BY TFTPc_Processing() ------------
+*                                       See TFTPc_Processing() for additional return error codes.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get().
+*
+* Note(s)     : (1) Each server is req'd at most once per transfer, from the one selected by TFTPc_PoolSel().
+*                   If all the servers fail, the error of the last one is returned & the session terminated.
+*
+*               (2) The next server is req'd :
+*
+*                   (a) If the server did NOT send any block & did NOT answer with anything but an error.
+*                   (b) If the server stopped answering once blocks were rx'd, only if the transfer can be
+*                       resumed (see Note #3).
+*
+*                   Once the transfer is aborted or the local file can NOT be wr'n, the error is returned.
+*
+*               (3) A transfer can be resumed when the file is wr'n to NetFS without codec nor multicast :
+*
+*                   (a) The data rx'd from the next server is compared with the octets already wr'n
+*                       instead of being wr'n again (see 'TFTPc_DataWr()  Note #2').
+*                   (b) Before the next server is req'd, the skipped data at the end of the file, if any, is
+*                       wr'n (see TFTPc_SparseFlush()) & the file is rewound.
+*
+*               (4) A server that timed out before sending any block is req'd once more without the block size
+*                   option, before the next server (see TFTPc_BlkSizeFallbackChk()).  The next servers are NOT
+*                   req'd a block size either.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+static  void  TFTPc_PoolGet (CPU_CHAR    *p_filename_remote,
+                             TFTPc_MODE   mode,
+                             TFTPc_ERR   *p_err)
+{
+    const  TFTPc_CFG           *p_server;
+           NET_IP_ADDR_FAMILY   ip_family;
+           CPU_INT32U           tried;
+           CPU_INT08U           nbr_tried;
+           CPU_INT08U           ix;
+           CPU_BOOLEAN          resume_en;
+           CPU_BOOLEAN          fallback;
+           CPU_BOOLEAN          retry;
+           CPU_BOOLEAN          ok;
+
+
+    resume_en = DEF_NO;                                         /* See Note #3.                                         */
+    if ((TFTPc_FileHandle != (void *)0) &&
+        (DEF_BIT_IS_CLR(mode, TFTPc_MODE_FLAG_MCAST) == DEF_YES)) {
+        resume_en = DEF_YES;
+    }
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    if (TFTPc_CodecActive == DEF_YES) {
+        resume_en = DEF_NO;
+    }
+#endif
+
+    tried = 0u;
+    for (nbr_tried = 0u; nbr_tried < TFTPc_PoolNbr; nbr_tried++) {
+        ix        =  TFTPc_PoolSel(tried);                      /* See Note #1.                                         */
+        tried    |=  DEF_BIT(ix);
+        p_server  = &TFTPc_PoolTbl[ix];
+        ip_family =  p_server->ServerAddrFamily;
+        if (ip_family == NET_IP_ADDR_FAMILY_NONE) {
+            ip_family = TFTPc_IP_ADDR_FAMILY_FIRST;
+        }
+
+        TFTPc_TRACE_INFO(("TFTPc_PoolGet: Request to server %s\n\r", p_server->ServerHostnamePtr));
+
+        retry = DEF_YES;
+        while (retry == DEF_YES) {
+           (void)TFTPc_SockInit(p_server->ServerHostnamePtr,    /* Init sock.                                           */
+                                p_server->ServerPortNbr,
+                                ip_family,
+                                p_err);
+            if (*p_err == TFTPc_ERR_NONE) {
+                TFTPc_PoolIxCur     = ix;                       /* Tx rd req.                                           */
+                TFTPc_PoolTS_Req_ms = TFTPc_TIME_GET_ms();
+                TFTPc_TxReq(TFTP_OPCODE_RRQ, p_filename_remote, mode, p_err);
+                if (*p_err == TFTPc_ERR_NONE) {
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+                    TFTPc_FlashPreErase();                      /* Erase 1st sector while req is in flight.             */
+#endif
+                                                                /* Process req.                                         */
+                    TFTPc_RxBlkNbrNext = 1;
+                    TFTPc_State        = TFTPc_STATE_DATA_GET;
+
+                    TFTPc_SessionKeep  = DEF_YES;
+                    TFTPc_Processing(p_server, p_err);
+                    TFTPc_SessionKeep  = DEF_NO;
+                }
+                TFTPc_PoolIxCur = TFTPc_POOL_IX_NONE;
+            }
+
+            retry = DEF_NO;
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+            retry = TFTPc_BlkSizeFallbackChk(*p_err);           /* Re-tx req w/o blk size (see Note #4).                */
+#endif
+        }
+
+        TFTPc_PoolStatUpdate(ix, *p_err);
+        if (*p_err == TFTPc_ERR_NONE) {
+            return;
+        }
+                                                                /* -------------- CHK FAILOVER (see Note #2) ---------- */
+        switch (*p_err) {
+            case TFTPc_ERR_INVALID_PROTO_FAMILY:
+            case TFTPc_ERR_NO_SOCK:
+            case TFTPc_ERR_TX:
+            case TFTPc_ERR_RX:
+            case TFTPc_ERR_RX_TIMEOUT:
+                 fallback = ((TFTPc_RxBlkNbrNext == 1) || (resume_en == DEF_YES)) ? DEF_YES : DEF_NO;
+                 break;
+
+
+            case TFTPc_ERR_ERR_PKT_RX:
+            case TFTPc_ERR_INVALID_OPCODE_RX:
+            case TFTPc_ERR_OPT_NEGO:
+                 fallback = (TFTPc_RxBlkNbrNext == 1) ? DEF_YES : DEF_NO;
+                 break;
+
+
+            default:
+                 fallback = DEF_NO;
+                 break;
+        }
+
+        if (fallback == DEF_NO) {
+            TFTPc_Terminate();
+            return;
+        }
+
+        TFTPc_TRACE_INFO(("TFTPc_PoolGet: Server failed, error %u\n\r", (unsigned)*p_err));
+
+        TFTPc_SessionSrcReset();
+
+        if (TFTPc_PoolOctetWr > 0u) {                           /* ------------ REWIND FILE (see Note #3b) ------------ */
+#if (TFTPc_CFG_SPARSE_EN == DEF_ENABLED)
+            TFTPc_SparseFlush(p_err);
+            if (*p_err != TFTPc_ERR_NONE) {
+                TFTPc_Terminate();
+                return;
+            }
+#endif
+            ok = NetFS_FilePosSet(TFTPc_FileHandle, 0, NET_FS_SEEK_ORIGIN_START);
+            if (ok != DEF_OK) {
+                TFTPc_Terminate();
+               *p_err = TFTPc_ERR_FILE_WR;
+                return;
+            }
+        }
+        TFTPc_PoolOctetRx = 0u;
+    }
+
+    TFTPc_Terminate();                                          /* All servers failed (see Note #1).                    */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_PoolSel()
+*
+* Description : Select the pool server expected to send the file first.
+*
+* Argument(s) : tried       Bit mask of the servers already req'd in the cur transfer (bit 'ix' set).
+*
+* Return(s)   : Index of the server selected.
+*
+* Caller(s)   : TFTPc_PoolGet().
+*
+* Note(s)     : (1) The score of a server is its expected time to answer : its smoothed round-trip time, plus
+*                   the time lost on a failure weighted by its failure rate.  A failure costs the rx inactivity
+*                   timeout of the server for the req & each of its re-tx.
+*
+*               (2) A server never req'd scores 0, so that each server is req'd at least once.  Among servers
+*                   with the same score, the first one in the table is selected.
+*
+*               (3) At least one server is NOT tried yet when this function is called.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+static  CPU_INT08U  TFTPc_PoolSel (CPU_INT32U  tried)
+{
+    const  TFTPc_POOL_STAT  *p_stat;
+           CPU_INT64U        fail_cost_ms;
+           CPU_INT64U        score;
+           CPU_INT64U        score_min;
+           CPU_INT08U        ix;
+           CPU_INT08U        ix_sel;
+
+
+    ix_sel    = TFTPc_POOL_IX_NONE;
+    score_min = 0u;
+    for (ix = 0u; ix < TFTPc_PoolNbr; ix++) {
+        if (DEF_BIT_IS_CLR(tried, DEF_BIT(ix)) == DEF_YES) {
+            p_stat = &TFTPc_PoolStat[ix];
+            if (p_stat->ReqCtr == 0u) {                         /* See Note #2.                                         */
+                score = 0u;
+            } else {                                            /* See Note #1.                                         */
+                fail_cost_ms = (CPU_INT64U)TFTPc_PoolTbl[ix].RxInactivityTimeout_ms * (TFTPc_MAX_NBR_TX_RETRY + 1u);
+                score        = (CPU_INT64U)p_stat->RTT_ms +
+                              ((fail_cost_ms * p_stat->FailRate) / TFTPc_POOL_RATE_SCALE);
+            }
+
+            if ((ix_sel == TFTPc_POOL_IX_NONE) ||
+                (score  <  score_min)) {
+                ix_sel    = ix;
+                score_min = score;
+            }
+        }
+    }
+
+    return (ix_sel);                                            /* See Note #3.                                         */
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_PoolStatUpdate()
+*
+* Description : Update the failure statistics of a pool server once a request to it ends.
+*
+* Argument(s) : ix          Index of the server req'd.
+*
+*               err         Error the request ended with.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_PoolGet().
+*
+* Note(s)     : (1) A request fails if the server could NOT be reached or stopped answering.  Any other end of
+*                   the request, including an ERROR pkt, means that the server answered.
+*
+*               (2) A canceled request, or one that exceeded the transfer deadline, says nothing about the
+*                   server & is NOT sampled.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+static  void  TFTPc_PoolStatUpdate (CPU_INT08U  ix,
+                                    TFTPc_ERR   err)
+{
+    TFTPc_POOL_STAT  *p_stat;
+    CPU_INT16U        rate;
+
+
+    p_stat = &TFTPc_PoolStat[ix];
+    p_stat->ReqCtr++;
+
+    rate = p_stat->FailRate;
+    switch (err) {
+        case TFTPc_ERR_CANCELED:                                /* See Note #2.                                         */
+        case TFTPc_ERR_DEADLINE:
+             return;
+
+
+        case TFTPc_ERR_INVALID_PROTO_FAMILY:                    /* See Note #1.                                         */
+        case TFTPc_ERR_NO_SOCK:
+        case TFTPc_ERR_TX:
+        case TFTPc_ERR_RX:
+        case TFTPc_ERR_RX_TIMEOUT:
+             p_stat->FailCtr++;
+             rate += (CPU_INT16U)((TFTPc_POOL_RATE_SCALE - rate) >> TFTPc_POOL_EWMA_SHIFT);
+             break;
+
+
+        default:
+             rate -= (CPU_INT16U)(rate >> TFTPc_POOL_EWMA_SHIFT);
+             break;
+    }
+
+    p_stat->FailRate = rate;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_PoolRTT_Update()
+*
+* Description : Sample the round-trip time of the pool server req'd, on the first pkt rx'd from it.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TID_Update().
+*
+* Note(s)     : (1) A req that was re-tx'd is NOT sampled, since the tx the server answered is unknown (Karn's
+*                   algorithm, RFC #6298, section 3).
+*
+*               (2) The first sample sets the round-trip time; the following ones are smoothed (see
+*                   'TFTPc SERVER POOL DEFINES  Note #1').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+static  void  TFTPc_PoolRTT_Update (void)
+{
+    TFTPc_POOL_STAT  *p_stat;
+    CPU_INT32U        rtt_ms;
+
+
+    if (TFTPc_PoolIxCur == TFTPc_POOL_IX_NONE) {                /* Pool NOT used.                                       */
+        return;
+    }
+
+    if (TFTPc_TxPktRetry != 0u) {                               /* See Note #1.                                         */
+        return;
+    }
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+    if (TFTPc_BackoffReqRetryCtr != 0u) {
+        return;
+    }
+#endif
+
+    rtt_ms = (CPU_INT32U)(TFTPc_TIME_GET_ms() - TFTPc_PoolTS_Req_ms);
+    p_stat = &TFTPc_PoolStat[TFTPc_PoolIxCur];
+    if (p_stat->RTT_NbrSamples == 0u) {                         /* See Note #2.                                         */
+        p_stat->RTT_ms = rtt_ms;
+    } else {
+        p_stat->RTT_ms = (CPU_INT32U)(((((CPU_INT64U)p_stat->RTT_ms << TFTPc_POOL_EWMA_SHIFT) - p_stat->RTT_ms) + rtt_ms)
+                                      >> TFTPc_POOL_EWMA_SHIFT);
+    }
+    p_stat->RTT_NbrSamples++;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_PoolDataCmp()
+*
+* Description : Compare a block rx'd with the data at the current position of the local file.
+*
+* Argument(s) : p_data      Pointer to data rx'd.
+*
+*               data_len    Length of data rx'd (in octets).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE      No error.
+*                               TFTPc_ERR_FILE_WR   File position could NOT be restored (see Note #1).
+*
+* Return(s)   : DEF_YES, if the local file holds the same data.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPc_DataWr().
+*
+* Note(s)     : (1) The file position is advanced over the data if it is the same; otherwise, it is restored
+*                   to the start of the block, which is then wr'n.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_PoolDataCmp (const  CPU_INT08U  *p_data,
+                                               CPU_SIZE_T   data_len,
+                                               TFTPc_ERR   *p_err)
+{
+    CPU_INT08U   buf[TFTPc_POOL_CMP_CHUNK_LEN];
+    CPU_SIZE_T   rd_len_tot;
+    CPU_SIZE_T   rd_len;
+    CPU_SIZE_T   chunk_len;
+    CPU_BOOLEAN  same;
+    CPU_BOOLEAN  ok;
+
+
+    rd_len_tot = 0u;
+    same       = DEF_YES;
+    while ((rd_len_tot <  data_len) &&
+           (same       == DEF_YES)) {
+        chunk_len = DEF_MIN(data_len - rd_len_tot, sizeof(buf));
+        rd_len    = 0u;
+       (void)NetFS_FileRd((void       *) TFTPc_FileHandle,
+                          (void       *)&buf[0],
+                          (CPU_SIZE_T  ) chunk_len,
+                          (CPU_SIZE_T *)&rd_len);
+        if (rd_len != chunk_len) {
+            same = DEF_NO;
+        } else {
+            same = Mem_Cmp(&buf[0], &p_data[rd_len_tot], chunk_len);
+        }
+        rd_len_tot += rd_len;
+    }
+
+    if ((same       == DEF_NO) &&                               /* See Note #1.                                         */
+        (rd_len_tot >  0u)) {
+        ok = NetFS_FilePosSet(TFTPc_FileHandle,
+                             -(CPU_INT32S)rd_len_tot,
+                              NET_FS_SEEK_ORIGIN_CUR);
+        if (ok != DEF_OK) {
+           *p_err = TFTPc_ERR_FILE_WR;
+            return (DEF_NO);
+        }
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+
+    return (same);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TxReqOptAdd()
+*
+* Description : Append an option to the request packet being built.
+*
+* Argument(s) : pkt_len     Length of the request packet built so far (in octets).
+*
+*               p_opt_name  Pointer to option name.
+*
+*               p_opt_val   Pointer to option value.
+*
+*               opt_flag    Option flag (see 'TFTP OPTION DEFINES  Note #2').
+*
+* Return(s)   : Length of the request packet, including the option if appended.
+*
+* Caller(s)   : TFTPc_TxReq().
+*
+* Note(s)     : (1) An option that does NOT fit in the request packet is NOT req'd : the transfer then goes
+*                   on without it, as with a server that does NOT support it.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_OPT_EN
+static  CPU_INT16U  TFTPc_TxReqOptAdd (       CPU_INT16U   pkt_len,
+                                       const  CPU_CHAR    *p_opt_name,
+                                       const  CPU_CHAR    *p_opt_val,
+                                              CPU_INT08U   opt_flag)
+{
+    CPU_SIZE_T  name_len;
+    CPU_SIZE_T  val_len;
+
+
+    name_len = Str_Len(p_opt_name);
+    val_len  = Str_Len(p_opt_val);
+
+    if ((pkt_len + name_len + val_len + (2u * TFTP_PKT_SIZE_NULL)) > sizeof(TFTPc_TxPktBuf)) {
+        DEF_BIT_CLR(TFTPc_OptReq, opt_flag);                    /* See Note #1.                                         */
+        return (pkt_len);
+    }
+
+   (void)Str_Copy((CPU_CHAR *)&TFTPc_TxPktBuf[pkt_len], p_opt_name);
+    pkt_len += (CPU_INT16U)(name_len + TFTP_PKT_SIZE_NULL);
+
+   (void)Str_Copy((CPU_CHAR *)&TFTPc_TxPktBuf[pkt_len], p_opt_val);
+    pkt_len += (CPU_INT16U)(val_len  + TFTP_PKT_SIZE_NULL);
+
+    return (pkt_len);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_RxOACK()
+*
+* Description : Process an option acknowledgement (OACK) received for a read request.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE                  No error.
+*                               TFTPc_ERR_INVALID_OPCODE_RX     OACK NOT expected (see Note #1).
+*                               TFTPc_ERR_OPT_NEGO              Malformed OACK or option NOT req'd.
+*
+*                                                               ----- RETURNED BY TFTPc_McastOptRx() : -----
+*                               TFTPc_ERR_MCAST                 Multicast transfer error.
+*
+*                                                               ---- RETURNED BY TFTPc_FlashTSizeRx() : ----
+*                               TFTPc_ERR_FLASH                 File does NOT fit in flash partition.
+*
+*                                                               ------ RETURNED BY TFTPc_WinOptRx() : ------
+*                               TFTPc_ERR_OPT_NEGO              Invalid window size.
+*
+*                                                               ---- RETURNED BY TFTPc_BlkSizeOptRx() : ----
+*                               TFTPc_ERR_OPT_NEGO              Invalid block size.
+*
+*                                                               ------- RETURNED BY TFTPc_TxAck() : -------
+*                               TFTPc_ERR_TX                    Error transmitting packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet().
+*
+* Note(s)     : (1) An OACK is only expected when options were req'd & before the first DATA block, except
+*                   during a multicast transfer, where the server sends an OACK to change the master client.
+*
+*               (2) The transfer is aborted with an ERROR 'Option negotiation failed' when the OACK can NOT
+*                   be accepted (RFC #2347, section 'Negotiation Protocol'), or with an ERROR 'Disk full' when
+*                   the file does NOT fit in the flash partition.
+*
+*               (3) The OACK is acknowledged with an ACK of block 0, which starts the transfer.  A multicast
+*                   client only ACKs as master, to request the first block it has NOT rx'd yet (RFC #2090).
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_OPT_EN
+static  void  TFTPc_RxOACK (TFTPc_ERR  *p_err)
+{
+    CPU_CHAR     *p_opt_name;
+    CPU_CHAR     *p_opt_val;
+    CPU_SIZE_T    rx_ix;
+    CPU_SIZE_T    rx_len;
+    CPU_SIZE_T    str_len;
+    CPU_BOOLEAN   oack_ok;
+    CPU_INT16U    err_code;
+    TFTPc_ERR     err;
+
+
+    oack_ok = DEF_YES;
+    if ((TFTPc_OptReq       == 0u) ||                           /* See Note #1.                                         */
+        (TFTPc_RxBlkNbrNext != 1u)) {
+        oack_ok = DEF_NO;
+    }
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if (TFTPc_McastSockID != NET_SOCK_ID_NONE) {
+        oack_ok = DEF_YES;
+    }
+#endif
+    if (oack_ok != DEF_YES) {
+        TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_OPCODE_INVALID, TFTPc_SessionID, TFTPc_RxPktOpcode, TFTPc_State);
+        TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_ILLEGAL_OP,
+                    (CPU_CHAR  *) 0,
+                    (TFTPc_ERR *)&err);
+       *p_err = TFTPc_ERR_INVALID_OPCODE_RX;
+        return;
+    }
+
+                                                                /* ------------------ PARSE OPTIONS ------------------- */
+   *p_err  = TFTPc_ERR_NONE;
+    rx_len = (CPU_SIZE_T)TFTPc_RxPktLen;
+    rx_ix  = TFTP_PKT_OFFSET_OPT;
+    while ((rx_ix  <  rx_len) &&
+           (*p_err == TFTPc_ERR_NONE)) {
+        p_opt_name = (CPU_CHAR *)&TFTPc_RxPktBuf[rx_ix];        /* Get option name ...                                  */
+        str_len    =  Str_Len_N(p_opt_name, rx_len - rx_ix);
+        rx_ix     +=  str_len + TFTP_PKT_SIZE_NULL;
+        if (rx_ix >= rx_len) {                                  /* ... which MUST be followed by a value.               */
+           *p_err = TFTPc_ERR_OPT_NEGO;
+            break;
+        }
+
+        p_opt_val  = (CPU_CHAR *)&TFTPc_RxPktBuf[rx_ix];        /* Get option value ...                                 */
+        str_len    =  Str_Len_N(p_opt_val, rx_len - rx_ix);
+        if ((rx_ix + str_len) >= rx_len) {                      /* ... which MUST be NULL-terminated.                   */
+           *p_err = TFTPc_ERR_OPT_NEGO;
+            break;
+        }
+        rx_ix     +=  str_len + TFTP_PKT_SIZE_NULL;
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+        if ((Str_CmpIgnoreCase(p_opt_name, TFTP_OPT_MCAST_STR)      == 0) &&
+            (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST) == DEF_YES)) {
+            TFTPc_McastOptRx(p_opt_val, p_err);
+            continue;
+        }
+#endif
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+        if ((Str_CmpIgnoreCase(p_opt_name, TFTP_OPT_TSIZE_STR)      == 0) &&
+            (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_TSIZE) == DEF_YES)) {
+            TFTPc_FlashTSizeRx(p_opt_val, p_err);
+            continue;
+        }
+#endif
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+        if ((Str_CmpIgnoreCase(p_opt_name, TFTP_OPT_WIN_STR)        == 0) &&
+            (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_WIN)   == DEF_YES)) {
+            TFTPc_WinOptRx(p_opt_val, p_err);
+            continue;
+        }
+#endif
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+        if ((Str_CmpIgnoreCase(p_opt_name, TFTP_OPT_BLKSIZE_STR)    == 0) &&
+            (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_BLKSIZE) == DEF_YES)) {
+            TFTPc_BlkSizeOptRx(p_opt_val, p_err);
+            continue;
+        }
+#endif
+
+       *p_err = TFTPc_ERR_OPT_NEGO;                             /* Option NOT req'd.                                    */
+    }
+
+    if (*p_err != TFTPc_ERR_NONE) {                             /* See Note #2.                                         */
+        TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_OPCODE_INVALID, TFTPc_SessionID, TFTPc_RxPktOpcode, TFTPc_State);
+        err_code = TFTP_ERR_CODE_OPT_NEGO;
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+        if (*p_err == TFTPc_ERR_FLASH) {                        /* File does NOT fit in flash.                          */
+            err_code = TFTP_ERR_CODE_DISK_FULL;
+        }
+#endif
+        TFTPc_TxErr((CPU_INT16U ) err_code,
+                    (CPU_CHAR  *) 0,
+                    (TFTPc_ERR *)&err);
+        return;
+    }
+
+                                                                /* --------------------- ACK OACK --------------------- */
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if (TFTPc_McastSockID != NET_SOCK_ID_NONE) {                /* See Note #3.                                         */
+        TFTPc_TxPktRetry = 0;
+        if (TFTPc_McastMaster == DEF_YES) {
+            TFTPc_TxAck((TFTPc_BLK_NBR)(TFTPc_McastBlkMissing - 1u), p_err);
+        }
+        return;
+    }
+#endif
+
+    TFTPc_TxPktRetry = 0;
+    TFTPc_TxAck(0u, p_err);
+    if (*p_err != TFTPc_ERR_NONE) {
+        return;
+    }
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    TFTPc_FlashPreErase();
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_McastOptRx()
+*
+* Description : Process the multicast option of an OACK.
+*
+* Argument(s) : p_opt_val   Pointer to option value (see 'TFTPc MULTICAST DEFINES  Note #1').
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_OPT_NEGO      Malformed option value.
+*
+*                                                       ------- RETURNED BY TFTPc_McastOpen() : -------
+*                               TFTPc_ERR_NO_SOCK       No socket available.
+*                               TFTPc_ERR_MCAST         Multicast group could NOT be joined.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RxOACK().
+*
+* Note(s)     : (1) The option value is split in place, in the rx pkt buf.
+*
+*               (2) The group address & port of the following OACKs are ignored : RFC #2090 states that they
+*                   MAY be omitted once the client is a member of the group.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+static  void  TFTPc_McastOptRx (CPU_CHAR   *p_opt_val,
+                                TFTPc_ERR  *p_err)
+{
+    CPU_CHAR       *p_port;
+    CPU_CHAR       *p_mc;
+    CPU_CHAR       *p_end;
+    CPU_INT32U      port;
+    NET_IPv4_ADDR   addr;
+    CPU_BOOLEAN     master;
+    NET_ERR         err_net;
+
+
+                                                                /* ------------------ SPLIT OPT VAL ------------------- */
+    p_port = Str_Char(p_opt_val, TFTPc_MCAST_VAL_SEP);          /* See Note #1.                                         */
+    if (p_port == DEF_NULL) {
+       *p_err = TFTPc_ERR_OPT_NEGO;
+        return;
+    }
+   *p_port = ASCII_CHAR_NULL;
+    p_port++;
+
+    p_mc   = Str_Char(p_port, TFTPc_MCAST_VAL_SEP);
+    if (p_mc == DEF_NULL) {
+       *p_err = TFTPc_ERR_OPT_NEGO;
+        return;
+    }
+   *p_mc   = ASCII_CHAR_NULL;
+    p_mc++;
+
+    if ((p_mc[0] == TFTPc_MCAST_VAL_MASTER) &&
+        (p_mc[1] == ASCII_CHAR_NULL)) {
+        master = DEF_YES;
+    } else if ((p_mc[0] == TFTPc_MCAST_VAL_PASSIVE) &&
+               (p_mc[1] == ASCII_CHAR_NULL)) {
+        master = DEF_NO;
+    } else {
+       *p_err = TFTPc_ERR_OPT_NEGO;
+        return;
+    }
+
+                                                                /* --------------------- JOIN GRP --------------------- */
+    if (TFTPc_McastSockID == NET_SOCK_ID_NONE) {                /* See Note #2.                                         */
+        if ((*p_opt_val == ASCII_CHAR_NULL) ||
+            (*p_port    == ASCII_CHAR_NULL)) {
+           *p_err = TFTPc_ERR_OPT_NEGO;
+            return;
+        }
+
+        addr = NetASCII_Str_to_IPv4(p_opt_val, &err_net);
+        if ((err_net                               != NET_ASCII_ERR_NONE) ||
+           ((addr & TFTPc_MCAST_ADDR_CLASS_MASK) != TFTPc_MCAST_ADDR_CLASS_D)) {
+           *p_err = TFTPc_ERR_OPT_NEGO;
+            return;
+        }
+
+        port = Str_ParseNbr_Int32U(p_port, &p_end, 10u);
+        if ((*p_end != ASCII_CHAR_NULL)           ||
+            ( port  == 0u)                        ||
+            ( port  >  DEF_INT_16U_MAX_VAL)) {
+           *p_err = TFTPc_ERR_OPT_NEGO;
+            return;
+        }
+
+        TFTPc_McastOpen(addr, (NET_PORT_NBR)port, p_err);
+        if (*p_err != TFTPc_ERR_NONE) {
+            return;
+        }
+    }
+
+    TFTPc_McastMaster = master;
+   *p_err             = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_McastOpen()
+*
+* Description : Open the multicast socket & join the multicast group.
+*
+* Argument(s) : addr        Multicast group address (host order).
+*
+*               port        Multicast port.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Multicast group joined.
+*                               TFTPc_ERR_NO_SOCK       No socket available.
+*                               TFTPc_ERR_MCAST         Socket could NOT be bound, or group could NOT be joined.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_McastOptRx().
+*
+* Note(s)     : (1) The group is joined ONLY on the default interface (see NetIF_GetDflt()) : on a host with
+*                   several interfaces, the multicast DATA MUST be routed to the default interface, whatever
+*                   the interface the server is reached on.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+static  void  TFTPc_McastOpen (NET_IPv4_ADDR   addr,
+                               NET_PORT_NBR    port,
+                               TFTPc_ERR      *p_err)
+{
+    NET_SOCK_ID          sock_id;
+    NET_SOCK_ADDR_IPv4   sock_addr;
+    NET_IF_NBR           if_nbr;
+    NET_ERR              err_net;
+
+
+    sock_id = NetSock_Open(NET_SOCK_PROTOCOL_FAMILY_IP_V4,
+                           NET_SOCK_TYPE_DATAGRAM,
+                           NET_SOCK_PROTOCOL_UDP,
+                          &err_net);
+    if (err_net != NET_SOCK_ERR_NONE) {
+       *p_err = TFTPc_ERR_NO_SOCK;
+        return;
+    }
+
+    Mem_Clr(&sock_addr, sizeof(sock_addr));                     /* Bind to multicast port.                              */
+    sock_addr.AddrFamily = NET_SOCK_ADDR_FAMILY_IP_V4;
+    sock_addr.Port       = NET_UTIL_HOST_TO_NET_16(port);
+    sock_addr.Addr       = NET_UTIL_HOST_TO_NET_32(NET_SOCK_ADDR_IP_V4_WILDCARD);
+
+   (void)NetSock_Bind((NET_SOCK_ID      ) sock_id,
+                      (NET_SOCK_ADDR   *)&sock_addr,
+                      (NET_SOCK_ADDR_LEN) sizeof(NET_SOCK_ADDR),
+                      (NET_ERR         *)&err_net);
+    if (err_net != NET_SOCK_ERR_NONE) {
+        NetSock_Close(sock_id, &err_net);
+       *p_err = TFTPc_ERR_MCAST;
+        return;
+    }
+
+    if_nbr = NetIF_GetDflt();                                   /* See Note #1.                                         */
+   (void)NetIGMP_HostGrpJoin(if_nbr, addr, &err_net);
+    if (err_net != NET_IGMP_ERR_NONE) {
+        NetSock_Close(sock_id, &err_net);
+       *p_err = TFTPc_ERR_MCAST;
+        return;
+    }
+
+    TFTPc_McastSockID = sock_id;
+    TFTPc_McastAddr   = addr;
+    TFTPc_McastIF_Nbr = if_nbr;
+
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_McastDataRx()
+*
+* Description : Process a DATA block received during a multicast transfer.
+*
+* Argument(s) : rx_blk_nbr  Block number of the DATA packet.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_MCAST         File larger than TFTPc_CFG_MCAST_BLK_NBR_MAX blocks.
+*
+*                                                       ---------- RETURNED BY TFTPc_DataWr() : ----------
+*                               TFTPc_ERR_FILE_WR       Error writing to file.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet().
+*
+* Note(s)     : (1) Blocks are rx'd in any order : each block is written at its own position in the file &
+*                   recorded in the bitmap of rx'd blocks.  A block beyond the end of the file is written once
+*                   the file is extended up to its position (see TFTPc_McastFileExtend()).  A block that can
+*                   NOT be positioned is dropped, & req'd again once the client is master.
+*
+*               (2) RFC #2090 : the master client ACKs the block preceding the first block it has NOT rx'd
+*                   yet, which requests that block from the server.
+*
+*               (3) Once all the blocks are rx'd, the last block is ACK'd whatever the client status, so that
+*                   the server stops considering this client.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+static  void  TFTPc_McastDataRx (TFTPc_BLK_NBR   rx_blk_nbr,
+                                 TFTPc_ERR      *p_err)
+{
+    CPU_INT32U   blk_ix;
+    CPU_INT32U   pos;
+    CPU_INT16U   wr_data_len;
+    CPU_INT08U   bit;
+    CPU_BOOLEAN  ok;
+    TFTPc_ERR    err;
+
+
+   *p_err = TFTPc_ERR_NONE;
+
+    if (rx_blk_nbr == 0u) {                                     /* Blk 0 does NOT exist.                                */
+        return;
+    }
+
+    if (rx_blk_nbr > TFTPc_CFG_MCAST_BLK_NBR_MAX) {             /* Blk NOT tracked by bitmap.                           */
+        TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_DISK_FULL,
+                    (CPU_CHAR  *) 0,
+                    (TFTPc_ERR *)&err);
+       *p_err = TFTPc_ERR_MCAST;
+        return;
+    }
+
+                                                                /* ------------------- WR NEW BLK --------------------- */
+    blk_ix = (CPU_INT32U)rx_blk_nbr - 1u;
+    bit    = (CPU_INT08U)DEF_BIT(blk_ix % DEF_OCTET_NBR_BITS);
+    if (DEF_BIT_IS_CLR(TFTPc_McastBitmap[blk_ix / DEF_OCTET_NBR_BITS], bit) == DEF_YES) {
+        pos = blk_ix * TFTPc_DATA_BLOCK_SIZE;
+        ok  = TFTPc_McastFileExtend(pos);                       /* See Note #1.                                         */
+        if (ok == DEF_OK) {
+            ok = NetFS_FilePosSet(TFTPc_FileHandle,
+                                  (CPU_INT32S)pos,
+                                  NET_FS_SEEK_ORIGIN_START);
+        }
+        if (ok == DEF_OK) {
+            wr_data_len = TFTPc_DataWr(p_err);
+            if (*p_err != TFTPc_ERR_NONE) {
+                TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_FILE_ERR, TFTPc_SessionID, *p_err, rx_blk_nbr);
+                TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_NOT_DEF,
+                            (CPU_CHAR  *) TFTPc_ERR_MSG_WR_ERR,
+                            (TFTPc_ERR *)&err);
+                return;
+            }
+
+            DEF_BIT_SET(TFTPc_McastBitmap[blk_ix / DEF_OCTET_NBR_BITS], bit);
+            TFTPc_McastFileLen = DEF_MAX(TFTPc_McastFileLen, pos + wr_data_len);
+            TFTPc_STAT_INC(DataBlkCtr);
+            TFTPc_STAT_ADD(DataOctetCtr, wr_data_len);
+
+            if (wr_data_len < TFTPc_DATA_BLOCK_SIZE) {          /* If rx'd data len < TFTP blk size, last blk rx'd.     */
+                TFTPc_McastBlkLast = rx_blk_nbr;
+            }
+        }
+    }
+
+    while (TFTPc_McastBlkMissing <= TFTPc_CFG_MCAST_BLK_NBR_MAX) {
+        blk_ix = TFTPc_McastBlkMissing - 1u;
+        bit    = (CPU_INT08U)DEF_BIT(blk_ix % DEF_OCTET_NBR_BITS);
+        if (DEF_BIT_IS_CLR(TFTPc_McastBitmap[blk_ix / DEF_OCTET_NBR_BITS], bit) == DEF_YES) {
+            break;
+        }
+        TFTPc_McastBlkMissing++;
+    }
+
+    TFTPc_TxPktRetry = 0;                                       /* Server is making progress.                           */
+
+                                                                /* ---------------------- TX ACK ---------------------- */
+    if ((TFTPc_McastBlkLast    != 0u) &&                        /* If all blks rx'd (see Note #3) ...                   */
+        (TFTPc_McastBlkMissing >  TFTPc_McastBlkLast)) {
+        TFTPc_TxAck((TFTPc_BLK_NBR)TFTPc_McastBlkLast, &err);
+        TFTPc_State = TFTPc_STATE_TRANSFER_COMPLETE;            /* ... transfer completed.                              */
+        return;
+    }
+
+    if (TFTPc_McastMaster == DEF_YES) {                         /* See Note #2.                                         */
+        TFTPc_TxAck((TFTPc_BLK_NBR)(TFTPc_McastBlkMissing - 1u), &err);
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_McastFileExtend()
+*
+* Description : Extend the local file with zero octets up to a position, during a multicast transfer.
+*
+* Argument(s) : pos         Position of the block to write (in octets).
+*
+* Return(s)   : DEF_OK,   if the file is at least 'pos' octets long.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPc_McastDataRx().
+*
+* Note(s)     : (1) Setting the file position beyond the end of file is NOT supported by every file system
+*                   (e.g. uC/FS) : the gap up to the block is written with zero octets first, & overwritten
+*                   when the missing blocks are rx'd.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_McastFileExtend (CPU_INT32U  pos)
+{
+    CPU_INT08U   fill_buf[TFTPc_MCAST_FILL_BUF_LEN];
+    CPU_SIZE_T   fill_len;
+    CPU_SIZE_T   wr_len;
+    CPU_BOOLEAN  ok;
+
+
+    if (pos <= TFTPc_McastFileLen) {
+        return (DEF_OK);
+    }
+
+    ok = NetFS_FilePosSet(TFTPc_FileHandle,                     /* See Note #1.                                         */
+                          (CPU_INT32S)TFTPc_McastFileLen,
+                          NET_FS_SEEK_ORIGIN_START);
+    if (ok != DEF_OK) {
+        return (DEF_FAIL);
+    }
+
+    Mem_Clr(&fill_buf[0], sizeof(fill_buf));
+    while (TFTPc_McastFileLen < pos) {
+        fill_len = DEF_MIN(sizeof(fill_buf), (CPU_SIZE_T)(pos - TFTPc_McastFileLen));
+        wr_len   = 0u;
+       (void)NetFS_FileWr((void       *) TFTPc_FileHandle,
+                          (void       *)&fill_buf[0],
+                          (CPU_SIZE_T  ) fill_len,
+                          (CPU_SIZE_T *)&wr_len);
+        if (wr_len != fill_len) {
+            return (DEF_FAIL);
+        }
+        TFTPc_McastFileLen += (CPU_INT32U)fill_len;
+    }
+
+    return (DEF_OK);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_McastSockSel()
+*
+* Description : Wait for a packet on the client socket or on the multicast socket.
+*
+* Argument(s) : sock_id     Client socket id.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               NET_SOCK_ERR_NONE           A packet is available.
+*                               NET_SOCK_ERR_RX_Q_EMPTY     Receive timeout.
+*
+*                                                           ------- RETURNED BY NetSock_Sel() : -------
+*                               See NetSock_Sel() for additional return error codes.
+*
+* Return(s)   : Id of the socket to receive the packet from.
+*
+* Caller(s)   : TFTPc_RxPktSock().
+*
+* Note(s)     : (1) The client socket rx timeout bounds the wait, as for a unicast transfer.
+*
+*               (2) The client socket is served first : it carries the OACKs that change the master client.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+static  NET_SOCK_ID  TFTPc_McastSockSel (NET_SOCK_ID   sock_id,
+                                         NET_ERR      *p_err)
+{
+    NET_SOCK_DESC      sock_desc_rd;
+    NET_SOCK_TIMEOUT   timeout;
+    CPU_INT32U         timeout_ms;
+    NET_SOCK_QTY       sock_nbr_max;
+    NET_SOCK_RTN_CODE  rtn_code;
+
+
+                                                                /* See Note #1.                                         */
+    timeout_ms = NetSock_CfgTimeoutRxQ_Get_ms(sock_id, p_err);
+    if (*p_err != NET_SOCK_ERR_NONE) {
+        return (sock_id);
+    }
+    timeout.timeout_sec =  timeout_ms / DEF_TIME_NBR_mS_PER_SEC;
+    timeout.timeout_us  = (timeout_ms % DEF_TIME_NBR_mS_PER_SEC) * (DEF_TIME_NBR_uS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC);
+
+    NET_SOCK_DESC_INIT(&sock_desc_rd);
+    NET_SOCK_DESC_SET(sock_id,           &sock_desc_rd);
+    NET_SOCK_DESC_SET(TFTPc_McastSockID, &sock_desc_rd);
+    sock_nbr_max = (NET_SOCK_QTY)(DEF_MAX(sock_id, TFTPc_McastSockID) + 1);
+
+    rtn_code = NetSock_Sel(sock_nbr_max,
+                          &sock_desc_rd,
+                           DEF_NULL,
+                           DEF_NULL,
+                          &timeout,
+                           p_err);
+    if ((*p_err    == NET_SOCK_ERR_TIMEOUT) ||
+       ((*p_err    == NET_SOCK_ERR_NONE)    &&
+        ( rtn_code == 0))) {
+       *p_err = NET_SOCK_ERR_RX_Q_EMPTY;
+        return (sock_id);
+    }
+    if (*p_err != NET_SOCK_ERR_NONE) {
+        return (sock_id);
+    }
+
+    if (NET_SOCK_DESC_IS_SET(sock_id, &sock_desc_rd)) {         /* See Note #2.                                         */
+        return (sock_id);
+    }
+
+    return (TFTPc_McastSockID);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_WinReset()
+*
+* Description : Reset the window state of the current session.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TxReq().
+*
+* Note(s)     : (1) Until the window size option is accepted, the transfer uses a window of 1 block, i.e.
+*                   each block is ACK'd (RFC #1350).
+*
+*               (2) The losses & the delay rises are recorded anew for each request (see TFTPc_WinAdaptUpdate()).
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+static  void  TFTPc_WinReset (void)
+{
+#ifdef  TFTPc_WIN_REORDER_EN
+    CPU_INT16U  ix;
+#endif
+
+
+    TFTPc_WinSize       = 1u;                                   /* See Note #1.                                         */
+    TFTPc_WinSizeReq    = 0u;
+    TFTPc_WinAckBlkNbr  = 0u;
+    TFTPc_WinGapBlkNbr  = 0u;
+    TFTPc_WinGapPending = DEF_NO;
+    TFTPc_STAT_SET(WinSize, 1u);
+
+#ifdef  TFTPc_WIN_ADAPT_EN
+    TFTPc_WinAdaptNego      = DEF_NO;                           /* See Note #2.                                         */
+    TFTPc_WinAdaptCongested = DEF_NO;
+#endif
+
+#ifdef  TFTPc_WIN_REORDER_EN
+    for (ix = 0u; ix < TFTPc_CFG_WIN_REORDER_NBR; ix++) {
+        TFTPc_WinReorderTbl[ix].Used = DEF_NO;
+    }
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_WinOptRx()
+*
+* Description : Process the window size option of an OACK.
+*
+* Argument(s) : p_opt_val   Pointer to option value (window size, in blocks).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_OPT_NEGO      Malformed or invalid window size (see Note #1).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RxOACK().
+*
+* Note(s)     : (1) RFC #7440, section 'Window Size Option Specification' : the server MAY answer with a window
+*                   size smaller than the one req'd, but NOT larger.  With the adaptive window, the window size
+*                   req'd MAY be smaller than TFTPc_CFG_WIN_SIZE_MAX.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+static  void  TFTPc_WinOptRx (CPU_CHAR   *p_opt_val,
+                              TFTPc_ERR  *p_err)
+{
+    CPU_CHAR    *p_end;
+    CPU_INT32U   win_size;
+
+
+    win_size = Str_ParseNbr_Int32U(p_opt_val, &p_end, 10u);
+    if ((p_end    == p_opt_val)       ||
+        (*p_end   != ASCII_CHAR_NULL) ||
+        (win_size <  1u)              ||                        /* See Note #1.                                         */
+        (win_size >  TFTPc_WinSizeReq)) {
+       *p_err = TFTPc_ERR_OPT_NEGO;
+        return;
+    }
+
+    TFTPc_WinSize = (CPU_INT16U)win_size;
+    TFTPc_STAT_SET(WinSize, TFTPc_WinSize);
+#ifdef  TFTPc_WIN_ADAPT_EN
+    TFTPc_WinAdaptNego = DEF_YES;
+#endif
+   *p_err         =  TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_WinAckChk()
+*
+* Description : Check whether the data block received in sequence is ACK'd.
+*
+* Argument(s) : blk_nbr     Number of the last block received in sequence.
+*
+*               drained     Indicates whether blocks kept since a gap were written with the block.
+*
+*               last        Indicates whether the block is the last block of the file.
+*
+* Return(s)   : DEF_YES, if the block MUST be ACK'd.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPc_StateDataGet().
+*
+* Note(s)     : (1) A block is ACK'd when it ends the file, when it ends the blocks kept since a gap, or when
+*                   it ends a window.
+*
+*               (2) Each ACK tx'd starts the next window at the block ACK'd, as the server resends the window
+*                   that follows it (RFC #7440) : a window end ACK, a gap ACK (see TFTPc_WinBlkAheadRx()) or an
+*                   ACK re-tx'd on timeout (see TFTPc_WinAckRefresh()).
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_WinAckChk (TFTPc_BLK_NBR  blk_nbr,
+                                      CPU_BOOLEAN    drained,
+                                      CPU_BOOLEAN    last)
+{
+    CPU_BOOLEAN  ack;
+
+
+    ack = DEF_NO;
+    if ((last          == DEF_YES) ||                           /* See Note #1.                                         */
+        (drained       == DEF_YES) ||
+        (TFTPc_WinSize <= 1u)) {
+        ack = DEF_YES;
+
+    } else if ((TFTPc_BLK_NBR)(blk_nbr - TFTPc_WinAckBlkNbr) >= TFTPc_WinSize) {
+        ack = DEF_YES;
+    }
+
+    if (ack == DEF_YES) {
+        TFTPc_WinAckBlkNbr  = blk_nbr;                          /* See Note #2.                                         */
+        TFTPc_WinGapPending = DEF_NO;
+    }
+
+    return (ack);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_WinBlkAheadRx()
+*
+* Description : Handle a data block received ahead of the next block expected, during a windowed read.
+*
+* Argument(s) : rx_blk_nbr      Block number of the DATA packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet().
+*
+* Note(s)     : (1) Only a block within the window that starts at the next block expected can be rx'd ahead
+*                   of it; any other block is a stale copy & is discarded.
+*
+*               (2) The block is kept if a reorder slot is avail for it (see 'tftp-c_cfg.h  TFTPc WINDOWED
+*                   TRANSFER CONFIGURATION  Note #3').
+*
+*               (3) The last block rx'd in sequence is ACK'd once per gap, so that the server resends the
+*                   missing block without waiting for the end of its window nor for its timeout.  The ACK
+*                   starts the next window (see TFTPc_WinAckChk()  Note #2).
+*
+*               (4) A gap is a loss :
+*
+*                   (a) It halves the window size req'd by the next read (see TFTPc_WinAdaptUpdate()).
+*                   (b) The round-trip time being measured would include the recovery of the missing block,
+*                       & is discarded.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+static  void  TFTPc_WinBlkAheadRx (TFTPc_BLK_NBR  rx_blk_nbr)
+{
+    TFTPc_BLK_NBR   blk_diff;
+    TFTPc_BLK_NBR   gap_blk_nbr;
+#ifdef  TFTPc_WIN_REORDER_EN
+    TFTPc_WIN_BLK  *p_blk;
+    CPU_INT16U      data_len;
+#endif
+    TFTPc_ERR       err;
+
+
+    blk_diff = (TFTPc_BLK_NBR)(rx_blk_nbr - TFTPc_RxBlkNbrNext);
+    if (blk_diff >= TFTPc_WinSize) {                            /* See Note #1.                                         */
+        return;
+    }
+
+#ifdef  TFTPc_WIN_REORDER_EN
+    data_len = (CPU_INT16U)(TFTPc_RxPktLen - TFTP_PKT_SIZE_OPCODE - TFTP_PKT_SIZE_BLK_NBR);
+    if (blk_diff <= TFTPc_CFG_WIN_REORDER_NBR) {                /* Keep blk (see Note #2).                              */
+        p_blk          = &TFTPc_WinReorderTbl[rx_blk_nbr % TFTPc_CFG_WIN_REORDER_NBR];
+        p_blk->Used    =  DEF_YES;
+        p_blk->BlkNbr  =  rx_blk_nbr;
+        p_blk->DataLen =  data_len;
+        Mem_Copy(&p_blk->Data[0], &TFTPc_RxPktBuf[TFTP_PKT_OFFSET_DATA], data_len);
+    }
+#endif
+
+    TFTPc_STAT_INC(RxGapCtr);
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_RETRY, TFTPc_TRACE_EVENT_DATA_GAP, TFTPc_SessionID, rx_blk_nbr,
+                        (blk_diff <= TFTPc_CFG_WIN_REORDER_NBR) ? DEF_YES : DEF_NO);
+#ifdef  TFTPc_WIN_ADAPT_EN
+    TFTPc_WinAdaptCongested = DEF_YES;                          /* See Note #4a.                                        */
+#endif
+#ifdef  TFTPc_RTT_EN
+    TFTPc_RTT_Pending       = DEF_NO;                           /* See Note #4b.                                        */
+#endif
+
+    gap_blk_nbr = (TFTPc_BLK_NBR)(TFTPc_RxBlkNbrNext - 1u);
+    if ((TFTPc_WinGapPending == DEF_YES) &&                     /* If gap already ACK'd, ...                            */
+        (TFTPc_WinGapBlkNbr  == gap_blk_nbr)) {
+        return;                                                 /* ... wait for missing blk.                            */
+    }
+
+    TFTPc_TxAck(gap_blk_nbr, &err);                             /* See Note #3.                                         */
+    TFTPc_WinAckBlkNbr  = gap_blk_nbr;
+    TFTPc_WinGapBlkNbr  = gap_blk_nbr;
+    TFTPc_WinGapPending = DEF_YES;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_WinReorderDrain()
+*
+* Description : Write the blocks kept since a gap that follow the data block received in sequence.
+*
+* Argument(s) : p_blk_nbr       Pointer to variable that holds the number of the block received in sequence &
+*                               that will receive the number of the last block written.
+*
+*               wr_data_len     Number of data octets in the block received in sequence.
+*
+*               p_err           Pointer to variable that will receive the return error code from this function :
+*
+*                                   TFTPc_ERR_NONE              No error.
+*
+*                                                               ----- RETURNED BY TFTPc_DataGetWr() : -----
+*                                   TFTPc_ERR_FILE_WR           Error writing to file.
+*
+* Return(s)   : Number of data octets in the last block written.
+*
+* Caller(s)   : TFTPc_StateDataGet().
+*
+* Note(s)     : (1) Each block kept is copied to the rx pkt buf, as if it was rx'd in sequence, & written
+*                   until a block is NOT kept or the last block of the file is written.
+*
+*               (2) The number of blocks written counts as 'RxReorderBlkCtr' (see 'tftp-c.h  TFTPc STATISTICS
+*                   DATA TYPE  Note #2e').
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_WIN_REORDER_EN
+static  CPU_INT16U  TFTPc_WinReorderDrain (TFTPc_BLK_NBR  *p_blk_nbr,
+                                           CPU_INT16U      wr_data_len,
+                                           TFTPc_ERR      *p_err)
+{
+    TFTPc_WIN_BLK  *p_blk;
+    TFTPc_BLK_NBR   blk_nbr;
+
+
+   *p_err = TFTPc_ERR_NONE;
+    while (wr_data_len == TFTPc_BLK_SIZE_CUR) {                 /* While last blk NOT wr'n, ...                         */
+        blk_nbr = (TFTPc_BLK_NBR)(*p_blk_nbr + 1u);
+        p_blk   = &TFTPc_WinReorderTbl[blk_nbr % TFTPc_CFG_WIN_REORDER_NBR];
+        if ((p_blk->Used   != DEF_YES) ||                       /* ... & next blk kept, ...                             */
+            (p_blk->BlkNbr != blk_nbr)) {
+            break;
+        }
+                                                                /* ... wr it (see Note #1).                             */
+        NET_UTIL_VAL_SET_NET_16(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_BLK_NBR], blk_nbr);
+        Mem_Copy(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_DATA], &p_blk->Data[0], p_blk->DataLen);
+        TFTPc_RxPktLen = TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR + p_blk->DataLen;
+        p_blk->Used    = DEF_NO;
+
+       *p_blk_nbr      = blk_nbr;
+        wr_data_len    = TFTPc_DataGetWr(p_err);
+        if (*p_err != TFTPc_ERR_NONE) {
+            break;
+        }
+        TFTPc_STAT_INC(RxReorderBlkCtr);                        /* See Note #2.                                         */
+    }
+
+    return (wr_data_len);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_WinAckRefresh()
+*
+* Description : Update the last ACK transmitted before it is retransmitted, during a windowed read.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Processing().
+*
+* Note(s)     : (1) RFC #7440, section 'Traffic Flow and Error Handling' : on timeout, the receiver ACKs the
+*                   last block rx'd in sequence, which MAY be more recent than the last block ACK'd.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+static  void  TFTPc_WinAckRefresh (void)
+{
+    TFTPc_BLK_NBR  blk_nbr;
+
+
+    if ((TFTPc_WinSize  <= 1u)                   ||
+        (TFTPc_State    != TFTPc_STATE_DATA_GET) ||
+        (TFTPc_TxPktLen != (TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR))) {
+        return;
+    }
+    if (NET_UTIL_VAL_GET_NET_16(&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_OPCODE]) != TFTP_OPCODE_ACK) {
+        return;
+    }
+
+    blk_nbr = (TFTPc_BLK_NBR)(TFTPc_RxBlkNbrNext - 1u);         /* See Note #1.                                         */
+    NET_UTIL_VAL_SET_NET_16(&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_BLK_NBR], blk_nbr);
+
+    TFTPc_WinAckBlkNbr  = blk_nbr;
+    TFTPc_WinGapPending = DEF_NO;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_WinAdaptUpdate()
+*
+* Description : Adapt the window size requested by the next read to the outcome of the current one.
+*
+* Argument(s) : err         Error code returned by the transfer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get().
+*
+* Note(s)     : (1) The window size req'd is only adapted when the server accepted the window size option.
+*
+*               (2) After a loss (a gap or an rx timeout once the server answered) or a rise of the round-trip
+*                   time (see TFTPc_RTT_Sample()  Note #3), the window is halved (see 'tftp-c_cfg.h  TFTPc
+*                   ADAPTIVE WINDOW CONFIGURATION  Note #1c').
+*
+*               (3) After a transfer without loss nor delay rise, the window grows by one block (see
+*                   'tftp-c_cfg.h  TFTPc ADAPTIVE WINDOW CONFIGURATION  Note #1b').  A server that answered
+*                   with a window smaller than the one req'd caps the window.
+*
+*               (4) A transfer that failed without loss, e.g. on an ERROR pkt, does NOT change the window.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_WIN_ADAPT_EN
+static  void  TFTPc_WinAdaptUpdate (TFTPc_ERR  err)
+{
+    CPU_INT32U  win_size;
+
+
+    if (TFTPc_WinAdaptNego != DEF_YES) {                        /* See Note #1.                                         */
+        return;
+    }
+
+    if (TFTPc_WinAdaptCongested == DEF_YES) {                   /* See Note #2.                                         */
+        win_size = DEF_MAX(TFTPc_WinSize / 2u, 1u);
+
+    } else if (err == TFTPc_ERR_NONE) {                         /* See Note #3.                                         */
+        if (TFTPc_WinSize < TFTPc_WinSizeReq) {
+            win_size = TFTPc_WinSize;
+        } else {
+            win_size = DEF_MIN((CPU_INT32U)TFTPc_WinSize + 1u, TFTPc_CFG_WIN_SIZE_MAX);
+        }
+
+    } else {                                                    /* See Note #4.                                         */
+        return;
+    }
+
+    TFTPc_WinAdaptSize = (CPU_INT16U)win_size;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_BlkSizeReqGet()
+*
+* Description : Get the block size to request.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Block size to request, in octets.
+*
+* Caller(s)   : TFTPc_TxReq().
+*
+* Note(s)     : (1) A block size set with TFTPc_BlkSizeSet() is req'd as is, & NOT probed.
+*
+*               (2) The probe state is reset whenever the block size derived from the MTU changes, e.g. when
+*                   the interface is reconfigured : the size derived from the MTU is req'd first.
+*
+*               (3) See 'tftp-c_cfg.h  TFTPc BLOCK SIZE CONFIGURATION  Note #4b'.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+static  CPU_INT16U  TFTPc_BlkSizeReqGet (void)
+{
+    CPU_INT16U  blk_size;
+
+
+    if (TFTPc_BlkSizeSel != TFTPc_BLKSIZE_AUTO) {               /* See Note #1.                                         */
+        return (TFTPc_BlkSizeSel);
+    }
+
+    blk_size = TFTPc_BlkSizeAutoGet();
+
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+    if (blk_size != TFTPc_BlkSizeAutoMax) {                     /* See Note #2.                                         */
+        TFTPc_BlkSizeAutoMax = blk_size;
+        TFTPc_BlkSizeOk      = blk_size;
+        TFTPc_BlkSizeFail    = (CPU_INT32U)blk_size + 1u;
+        TFTPc_BlkSizeOkCtr   = 0u;
+    }
+
+    blk_size = TFTPc_BlkSizeOk;
+    if ((TFTPc_BlkSizeOkCtr                   >= TFTPc_CFG_BLKSIZE_PROBE_INTERVAL) &&
+        (TFTPc_BlkSizeFail - TFTPc_BlkSizeOk  >= TFTPc_BLKSIZE_PROBE_STEP_MIN)) {
+        blk_size           = (CPU_INT16U)(TFTPc_BlkSizeOk + ((TFTPc_BlkSizeFail - TFTPc_BlkSizeOk) / 2u));
+        TFTPc_BlkSizeOkCtr =  0u;                               /* Probe halfway to smallest size failed (see Note #3). */
+    }
+#endif
+
+    return (blk_size);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_BlkSizeAutoGet()
+*
+* Description : Derive the largest block size NOT fragmented on the interface towards the server.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Block size, in octets.
+*
+* Caller(s)   : TFTPc_BlkSizeReqGet().
+*
+* Note(s)     : (1) See 'tftp-c_cfg.h  TFTPc BLOCK SIZE CONFIGURATION  Notes #1, #3 & #5'.  The IP hdr len
+*                   depends on the address family of the server socket.
+*
+*               (2) If the MTU can NOT be obtained or is too small for the hdrs, the default block size is
+*                   used.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+static  CPU_INT16U  TFTPc_BlkSizeAutoGet (void)
+{
+    NET_IF_NBR  if_nbr;
+    NET_MTU     mtu;
+    CPU_INT32U  hdr_len;
+    CPU_INT32U  blk_size;
+    NET_ERR     err;
+
+
+    if_nbr = TFTPc_BLKSIZE_IF_NBR_GET();                        /* See Note #1.                                         */
+    mtu    = NetIF_MTU_Get(if_nbr, &err);
+    if (err != NET_IF_ERR_NONE) {
+        return (TFTPc_DATA_BLOCK_SIZE);                         /* See Note #2.                                         */
+    }
+
+    hdr_len = (TFTPc_SockAddr.AddrFamily == NET_SOCK_ADDR_FAMILY_IP_V6) ? TFTPc_BLKSIZE_HDR_LEN_IPv6
+                                                                        : TFTPc_BLKSIZE_HDR_LEN_IPv4;
+    hdr_len += TFTPc_BLKSIZE_HDR_LEN_UDP
+            +  TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR
+            +  TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD;
+    if (mtu < (hdr_len + TFTPc_BLKSIZE_MIN)) {
+        return (TFTPc_DATA_BLOCK_SIZE);
+    }
+
+    blk_size = mtu - hdr_len;
+    if (blk_size > TFTPc_CFG_BLKSIZE_MAX) {
+        blk_size = TFTPc_CFG_BLKSIZE_MAX;
+    }
+
+    return ((CPU_INT16U)blk_size);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_BlkSizeOptRx()
+*
+* Description : Process the block size option of an OACK.
+*
+* Argument(s) : p_opt_val   Pointer to option value (block size, in octets).
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          No error.
+*                               TFTPc_ERR_OPT_NEGO      Malformed or invalid block size (see Note #1).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RxOACK().
+*
+* Note(s)     : (1) RFC #2348, section 'Block Size Option Specification' : the server MAY answer with a block
+*                   size smaller than the one req'd, but NOT larger.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+static  void  TFTPc_BlkSizeOptRx (CPU_CHAR   *p_opt_val,
+                                  TFTPc_ERR  *p_err)
+{
+    CPU_CHAR    *p_end;
+    CPU_INT32U   blk_size;
+
+
+    blk_size = Str_ParseNbr_Int32U(p_opt_val, &p_end, 10u);
+    if ((p_end    == p_opt_val)         ||
+        (*p_end   != ASCII_CHAR_NULL)   ||
+        (blk_size <  TFTPc_BLKSIZE_MIN) ||                      /* See Note #1.                                         */
+        (blk_size >  TFTPc_BlkSizeReq)) {
+       *p_err = TFTPc_ERR_OPT_NEGO;
+        return;
+    }
+
+    TFTPc_BlkSize = (CPU_INT16U)blk_size;
+    TFTPc_STAT_SET(BlkSize, TFTPc_BlkSize);
+   *p_err         =  TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_BlkSizeFallbackChk()
+*
+* Description : Check whether a read request that failed is re-transmitted without the block size option.
+*
+* Argument(s) : err         Error code returned by the transfer.
+*
+* Return(s)   : DEF_YES, if the request MUST be re-tx'd; the session is reset for it.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_PoolGet().
+*
+* Note(s)     : (1) The request is re-tx'd once per session, if it timed out before any block was rx'd in
+*                   sequence, with a block size larger than 512 octets req'd & NOT refused by the server : the
+*                   blocks MAY be too large for the path (see 'tftp-c_cfg.h  TFTPc BLOCK SIZE CONFIGURATION
+*                   Note #1').  The request is re-tx'd whether probing is enabled or NOT.
+*
+*               (2) With probing, the failure of the block size is recorded first, since the request re-tx'd
+*                   does NOT req a block size (see TFTPc_BlkSizeProbeUpdate()  Note #1).
+*
+*               (3) As before a request to another source, the socket is closed (see TFTPc_SessionSrcReset()) :
+*                   the request is re-tx'd from a new socket, to the server port.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+static  CPU_BOOLEAN  TFTPc_BlkSizeFallbackChk (TFTPc_ERR  err)
+{
+    if ((err                   != TFTPc_ERR_RX_TIMEOUT) ||      /* See Note #1.                                         */
+        (TFTPc_RxBlkNbrNext    != 1u)                   ||
+        (TFTPc_BlkSizeFallback == DEF_YES)              ||
+        (TFTPc_BlkSizeReq      <= TFTPc_DATA_BLOCK_SIZE)) {
+        return (DEF_NO);
+    }
+    if ((TFTPc_TID_Set == DEF_YES) &&                           /* If server answered w/o larger blk size, ...          */
+        (TFTPc_BlkSize <= TFTPc_DATA_BLOCK_SIZE)) {
+        return (DEF_NO);                                        /* ... blk size NOT the cause.                          */
+    }
+
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+    TFTPc_BlkSizeProbeUpdate(err);                              /* See Note #2.                                         */
+#endif
+
+    TFTPc_TRACE_INFO(("TFTPc_BlkSizeFallbackChk: Request timed out, re-sent without block size\n\r"));
+
+    TFTPc_SessionSrcReset();                                    /* See Note #3.                                         */
+    TFTPc_BlkSizeFallback = DEF_YES;
+
+    return (DEF_YES);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_BlkSizeProbeUpdate()
+*
+* Description : Update the block size probe state with the outcome of a read transfer.
+*
+* Argument(s) : err         Error code returned by the transfer.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_BlkSizeFallbackChk().
+*
+* Note(s)     : (1) Only the read transfers that selected the block size derived from the MTU are accounted
+*                   for, including those that use 512-octet blocks after a fall back.
+*
+*               (2) See 'tftp-c_cfg.h  TFTPc BLOCK SIZE CONFIGURATION  Note #4a'.  A transfer that failed
+*                   before the server answered says nothing about the block size.  A failure with blocks of
+*                   512 octets or less is NOT caused by the block size.
+*
+*               (3) A block size that worked between the largest size that worked & the smallest size that
+*                   failed is recorded, whether it was probed or answered smaller by the server.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_BLKSIZE_PROBE_EN
+static  void  TFTPc_BlkSizeProbeUpdate (TFTPc_ERR  err)
+{
+    CPU_BOOLEAN  failed;
+
+
+    if ((TFTPc_BlkSizeReq == 0u) ||                             /* See Note #1.                                         */
+        (TFTPc_BlkSizeSel != TFTPc_BLKSIZE_AUTO)) {
+        return;
+    }
+
+    failed = (TFTPc_BlkSizeTimeoutCtr >= TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX) ? DEF_YES : DEF_NO;
+    if ((err           == TFTPc_ERR_RX_TIMEOUT) &&              /* See Note #2.                                         */
+        (TFTPc_TID_Set == DEF_YES)) {
+        failed = DEF_YES;
+    }
+
+    if (failed == DEF_YES) {
+        if (TFTPc_BlkSize > TFTPc_DATA_BLOCK_SIZE) {
+            if (TFTPc_BlkSize < TFTPc_BlkSizeFail) {
+                TFTPc_BlkSizeFail = TFTPc_BlkSize;
+            }
+            if (TFTPc_BlkSizeOk >= TFTPc_BlkSizeFail) {         /* If size that worked failed, fall back.               */
+                TFTPc_BlkSizeOk = TFTPc_DATA_BLOCK_SIZE;
+            }
+        }
+        TFTPc_BlkSizeOkCtr = 0u;
+
+    } else if (err == TFTPc_ERR_NONE) {
+        if ((TFTPc_BlkSize > TFTPc_BlkSizeOk) &&                /* See Note #3.                                         */
+            (TFTPc_BlkSize < TFTPc_BlkSizeFail)) {
+            TFTPc_BlkSizeOk = TFTPc_BlkSize;
+        }
+        if (TFTPc_BlkSizeOkCtr < DEF_INT_16U_MAX_VAL) {
+            TFTPc_BlkSizeOkCtr++;
+        }
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_RTT_Reset()
+*
+* Description : Reset the round-trip time measurement of the current session.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TxReq().
+*
+* Note(s)     : (1) The delay inserted by a background transfer is reset with the base delay it depends on.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_RTT_EN
+static  void  TFTPc_RTT_Reset (void)
+{
+    TFTPc_RTT_Pending = DEF_NO;
+    TFTPc_RTT_ms      = 0u;
+    TFTPc_RTT_Min_ms  = DEF_INT_32U_MAX_VAL;
+    TFTPc_STAT_SET(RTT_ms, 0u);
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+    TFTPc_BgDly_ms    = 0u;                                     /* See Note #1.                                         */
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_RTT_Start()
+*
+* Description : Start timing the answer to the packet just transmitted.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet(),
+*               TFTPc_StateDataPut().
+*
+* Note(s)     : (1) The time is taken once the pkt is tx'd, so that neither the tx rate limit nor the delay
+*                   inserted by a background transfer count in the round-trip time.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_RTT_EN
+static  void  TFTPc_RTT_Start (void)
+{
+    TFTPc_RTT_TS_Tx_ms = TFTPc_TIME_GET_ms();                   /* See Note #1.                                         */
+    TFTPc_RTT_Pending  = DEF_YES;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_RTT_Sample()
+*
+* Description : Take a round-trip time sample on the answer to the packet timed.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet(),
+*               TFTPc_StateDataPut().
+*
+* Note(s)     : (1) RFC #6298, section 3 : no sample is taken when the pkt timed was re-tx'd, since the answer
+*                   can NOT be matched to one of the copies (Karn's algorithm).
+*
+*               (2) The smallest sample of the session is the base delay; the excess of a sample over it is
+*                   the queuing delay (see 'tftp-c_cfg.h  TFTPc BACKGROUND TRANSFER CONFIGURATION  Note #1a').
+*
+*               (3) With the adaptive window, a smoothed round-trip time more than TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms
+*                   above the base delay is a delay rise, in any read, background or NOT (see 'tftp-c_cfg.h
+*                   TFTPc ADAPTIVE WINDOW CONFIGURATION  Note #3').  The smoothed time is used so that a single
+*                   late sample is NOT a delay rise.
+*********************************************************************************************************
+*/
+
+#ifdef  TFTPc_RTT_EN
+static  void  TFTPc_RTT_Sample (void)
+{
+    CPU_INT32U  rtt_ms;
+
+
+    if (TFTPc_RTT_Pending != DEF_YES) {
+        return;
+    }
+    TFTPc_RTT_Pending = DEF_NO;
+
+    if (TFTPc_TxPktRetry > 0u) {                                /* See Note #1.                                         */
+        return;
+    }
+
+    rtt_ms = (CPU_INT32U)(TFTPc_TIME_GET_ms() - TFTPc_RTT_TS_Tx_ms);
+    if (TFTPc_RTT_Min_ms == DEF_INT_32U_MAX_VAL) {              /* First sample.                                        */
+        TFTPc_RTT_ms = rtt_ms;
+    } else {
+        TFTPc_RTT_ms = ((TFTPc_RTT_ms << TFTPc_RTT_EWMA_SHIFT) - TFTPc_RTT_ms + rtt_ms) >> TFTPc_RTT_EWMA_SHIFT;
+    }
+    TFTPc_STAT_SET(RTT_ms, TFTPc_RTT_ms);
+
+    if (rtt_ms < TFTPc_RTT_Min_ms) {                            /* See Note #2.                                         */
+        TFTPc_RTT_Min_ms = rtt_ms;
+    }
+
+#ifdef  TFTPc_WIN_ADAPT_EN
+    if (TFTPc_RTT_ms > (TFTPc_RTT_Min_ms + TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms)) {
+        TFTPc_WinAdaptCongested = DEF_YES;                      /* See Note #3.                                         */
+    }
+#endif
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+    TFTPc_BgDlyUpdate(rtt_ms - TFTPc_RTT_Min_ms);
+#endif
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_BgYield()
+*
+* Description : Delay the next packet of a background transfer.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_StateDataGet(),
+*               TFTPc_StateDataPut().
+*
+* Note(s)     : (1) See 'tftp-c_cfg.h  TFTPc BACKGROUND TRANSFER CONFIGURATION  Note #1b'.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+static  void  TFTPc_BgYield (void)
+{
+    if ((TFTPc_BgActive == DEF_YES) &&
+        (TFTPc_BgDly_ms >  0u)) {
+        TFTPc_TIME_DLY_ms(TFTPc_BgDly_ms);                      /* See Note #1.                                         */
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_BgDlyUpdate()
+*
+* Description : Update the delay inserted by a background transfer with a queuing delay sample.
+*
+* Argument(s) : qdly_ms     Queuing delay, in milliseconds.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RTT_Sample().
+*
+* Note(s)     : (1) While the queuing delay exceeds the target, the delay grows by the excess, up to
+*                   TFTPc_CFG_BG_DLY_MAX_ms; otherwise, it is halved (see 'tftp-c_cfg.h  TFTPc BACKGROUND
+*                   TRANSFER CONFIGURATION  Note #1b').
+*
+*               (2) A queuing delay above the target is also a sign of congestion for the adaptive window
+*                   (see TFTPc_WinAdaptUpdate()).
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+static  void  TFTPc_BgDlyUpdate (CPU_INT32U  qdly_ms)
+{
+    CPU_INT32U  dly_ms;
+
+
+    if (TFTPc_BgActive != DEF_YES) {
+        return;
+    }
+
+    if (qdly_ms > TFTPc_CFG_BG_DLY_TARGET_ms) {                 /* See Note #1.                                         */
+        dly_ms = qdly_ms - TFTPc_CFG_BG_DLY_TARGET_ms;
+        if (dly_ms < TFTPc_CFG_BG_DLY_MAX_ms) {
+            dly_ms += TFTPc_BgDly_ms;
+        }
+        TFTPc_BgDly_ms = DEF_MIN(dly_ms, TFTPc_CFG_BG_DLY_MAX_ms);
+#ifdef  TFTPc_WIN_ADAPT_EN
+        TFTPc_WinAdaptCongested = DEF_YES;                      /* See Note #2.                                         */
+#endif
+    } else {
+        TFTPc_BgDly_ms /= 2u;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_AbortInit()
+*
+* Description : Start the deadline of the transfer.
+*
+* Argument(s) : p_cfg       Pointer to TFTPc configuration object.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put().
+*
+* Note(s)     : (1) The deadline is absolute : it covers the whole transfer, retransmissions included, &
+*                   is NOT re-armed by the pkts rx'd.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+static  void  TFTPc_AbortInit (const  TFTPc_CFG  *p_cfg)
+{
+    if (p_cfg->TransferTimeoutMax_ms == 0u) {
+        TFTPc_DeadlineEn  = DEF_NO;
+        TFTPc_Deadline_ms = 0u;
+    } else {
+        TFTPc_DeadlineEn  = DEF_YES;                            /* See Note #1.                                         */
+        TFTPc_Deadline_ms = (CPU_INT32U)TFTPc_TIME_GET_ms() + p_cfg->TransferTimeoutMax_ms;
+    }
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_AbortChk()
+*
+* Description : Check whether the transfer must be aborted.
+*
+* Argument(s) : ts_cur_ms   Current time.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Transfer can go on.
+*                               TFTPc_ERR_CANCELED      Transfer canceled.
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
+*
+* Return(s)   : Max time the caller may block before checking again, in milliseconds.
+*
+* Caller(s)   : TFTPc_RxWaitChk(),
+*               TFTPc_BackoffDly(),
+*               TFTPc_TxRateWait(),
+*               TFTPc_SockInit().
+*
+* Note(s)     : (1) Times are compared as differences, so that the wrap-around of the timestamps is
+*                   harmless as long as a transfer lasts less than 2^31 milliseconds.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+static  CPU_INT32U  TFTPc_AbortChk (CPU_INT32U   ts_cur_ms,
+                                    TFTPc_ERR   *p_err)
+{
+    CPU_INT32U  rem_ms;
+    CPU_INT32U  wait_ms;
+
+
+    if (TFTPc_AbortReq == DEF_YES) {                            /* Chk cancel req.                                      */
+       *p_err = TFTPc_ERR_CANCELED;
+        return (0u);
+    }
+
+    wait_ms = TFTPc_CFG_ABORT_POLL_ms;
+
+    if (TFTPc_DeadlineEn == DEF_YES) {                          /* Chk deadline (see Note #1).                          */
+        rem_ms = TFTPc_Deadline_ms - ts_cur_ms;
+        if ((CPU_INT32S)rem_ms <= 0) {
+           *p_err = TFTPc_ERR_DEADLINE;
+            return (0u);
+        }
+        wait_ms = DEF_MIN(wait_ms, rem_ms);
+    }
+
+   *p_err = TFTPc_ERR_NONE;
+
+    return (wait_ms);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_RxWaitChk()
+*
+* Description : (1) Check whether the rx of a pkt can go on & configure the next rx wait slice :
+*
+*                   (a) Check cancel req.
+*                   (b) Check transfer deadline.
+*                   (c) Check rx inactivity timeout.
+*                   (d) Set rx sock timeout to the shortest of the poll period & the remaining times.
+*
+*
+* Argument(s) : sock_id     Socket descriptor/handle identifier of socket to receive data.
+*
+*               ts_start_ms Time at which the rx started.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Rx can go on.
+*                               TFTPc_ERR_CANCELED      Transfer canceled.
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
+*                               TFTPc_ERR_RX_TIMEOUT    Receive timeout.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RxPkt().
+*
+* Note(s)     : (1) Times are compared as differences (see TFTPc_AbortChk() Note #1).
+*
+*               (2) When multicast is enabled, TFTPc_McastSockSel() reads the rx timeout of the unicast sock
+*                   & applies it to both socks.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+static  void  TFTPc_RxWaitChk (NET_SOCK_ID   sock_id,
+                               CPU_INT32U    ts_start_ms,
+                               TFTPc_ERR    *p_err)
+{
+    CPU_INT32U  ts_cur_ms;
+    CPU_INT32U  elapsed_ms;
+    CPU_INT32U  wait_ms;
+    NET_ERR     err_net;
+
+
+    ts_cur_ms = (CPU_INT32U)TFTPc_TIME_GET_ms();
+    wait_ms   =  TFTPc_AbortChk(ts_cur_ms, p_err);              /* Chk cancel req & deadline.                           */
+    if (*p_err != TFTPc_ERR_NONE) {
+        return;
+    }
+
+    elapsed_ms = ts_cur_ms - ts_start_ms;                       /* Chk inactivity timeout.                              */
+    if (elapsed_ms >= TFTPc_RxTimeout_ms) {
+       *p_err = TFTPc_ERR_RX_TIMEOUT;
+        return;
+    }
+    wait_ms = DEF_MIN(wait_ms, TFTPc_RxTimeout_ms - elapsed_ms);
+
+    NetSock_CfgTimeoutRxQ_Set(sock_id,                          /* Set rx wait slice (see Note #2).                     */
+                              wait_ms,
+                             &err_net);
+
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_BackoffStart()
+*
+* Description : (1) Start the request backoff of a transfer :
+*
+*                   (a) Seed the backoff generator.
+*                   (b) Delay the transfer by a random time, if a start jitter is configured.
+*
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Transfer can go on.
+*
+*                                                       --- RETURNED BY TFTPc_BackoffDly() : ---
+*                               TFTPc_ERR_CANCELED      Transfer canceled.
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Get(),
+*               TFTPc_Put().
+*
+* Note(s)     : (1) The generator is seeded at the start of each transfer rather than once in TFTPc_Init() :
+*
+*                   (a) The network interface may NOT be started yet when TFTPc is initialized.
+*
+*                   (b) A transfer's delays only depend on the seed it starts with, so that a transfer can
+*                       be replayed, e.g. on a simulated network with a fixed TFTPc_BACKOFF_SEED_GET().
+*
+*               (2) With TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms set to 0, the first req is tx'd right away :
+*                   NO value is drawn & the transfer is NOT delayed.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+static  void  TFTPc_BackoffStart (TFTPc_ERR  *p_err)
+{
+    CPU_INT32U  dly_ms;
+
+
+    TFTPc_BackoffRandState = TFTPc_BACKOFF_SEED_GET();          /* Seed generator (see Note #1).                        */
+    if (TFTPc_BackoffRandState == 0u) {                         /* Xorshift state MUST NOT be 0.                        */
+        TFTPc_BackoffRandState = 1u;
+    }
+
+    TFTPc_BackoffReqRetryCtr = 0u;
+
+    if (TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms == 0u) {          /* See Note #2.                                         */
+       *p_err = TFTPc_ERR_NONE;
+        goto exit;
+    }
+
+    dly_ms = TFTPc_BackoffRandGet() % (TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms + 1u);
+    TFTPc_BackoffDly(dly_ms, p_err);
+
+
+exit:
+    return;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_BackoffReqDly()
+*
+* Description : Delay the next tx of the request by a random backoff time.
+*
+* Argument(s) : attempt     Nbr of times the request was already re-tx'd.
+*
+*               p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Request can be tx'd.
+*
+*                                                       --- RETURNED BY TFTPc_BackoffDly() : ---
+*                               TFTPc_ERR_CANCELED      Transfer canceled.
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Processing(),
+*               TFTPc_BackoffErrRx().
+*
+* Note(s)     : (1) The delay is drawn uniformly between 0 & the backoff window ("full jitter"), which
+*                   doubles at each attempt, from TFTPc_CFG_BACKOFF_BASE_ms up to TFTPc_CFG_BACKOFF_MAX_ms.
+*                   Drawing from the whole window, rather than adding a small jitter to a fixed delay,
+*                   spreads a burst of clients over time the most evenly.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+static  void  TFTPc_BackoffReqDly (CPU_INT08U   attempt,
+                                   TFTPc_ERR   *p_err)
+{
+    CPU_INT32U  win_ms;
+    CPU_INT32U  dly_ms;
+
+
+    win_ms = TFTPc_CFG_BACKOFF_BASE_ms;                         /* Compute backoff window (see Note #1).                */
+    while ((attempt >  0u) &&
+           (win_ms  <  TFTPc_CFG_BACKOFF_MAX_ms)) {
+        win_ms <<= 1u;
+        attempt--;
+    }
+    win_ms = DEF_MIN(win_ms, TFTPc_CFG_BACKOFF_MAX_ms);
+
+    dly_ms = TFTPc_BackoffRandGet() % (win_ms + 1u);
+
+    TFTPc_BackoffDly(dly_ms, p_err);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_BackoffErrRx()
+*
+* Description : Retry the request after an ERROR packet, if the server is busy.
+*
+* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+*
+*                               TFTPc_ERR_NONE          Request tx'd again; transfer goes on.
+*                               TFTPc_ERR_ERR_PKT_RX    ERROR packet NOT retryable.
+*
+*                                                       --- RETURNED BY TFTPc_BackoffDly() : ---
+*                               TFTPc_ERR_CANCELED      Transfer canceled.
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
+*
+*                                                       ----- RETURNED BY TFTPc_TxPkt() : -----
+*                               TFTPc_ERR_TX            Error transmitting packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_Processing().
+*
+* Note(s)     : (1) The ERROR packet is retryable if it answers the request (the server TID is NOT set, see
+*                   TFTPc_RxPkt() Note #4), if it is transient (see TFTPc_RxErrPkt()) & if its code is set in
+*                   TFTPc_CFG_BACKOFF_ERR_CODE_MSK.  No data was transferred yet : the request is simply tx'd
+*                   again, from the same socket.
+*
+*               (2) The last tx'd packet is still the request.  Its retry counter is reset, since the server
+*                   did answer it.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+static  void  TFTPc_BackoffErrRx (TFTPc_ERR  *p_err)
+{
+    CPU_INT16U         err_code;
+    NET_SOCK_ADDR_LEN  sock_addr_size;
+
+
+    if (TFTPc_TID_Set == DEF_YES) {                             /* See Note #1.                                         */
+        return;
+    }
+
+    if (TFTPc_ServerErr.Class != TFTPc_ERR_CLASS_TRANSIENT) {
+        return;
+    }
+
+    err_code = TFTPc_ServerErr.Code;
+    if ((err_code >= DEF_INT_32_NBR_BITS) ||
+        (DEF_BIT_IS_CLR((CPU_INT32U)TFTPc_CFG_BACKOFF_ERR_CODE_MSK, DEF_BIT(err_code)) == DEF_YES)) {
+        return;
+    }
+
+    if (TFTPc_BackoffReqRetryCtr >= TFTPc_CFG_BACKOFF_REQ_RETRY_MAX) {
+        return;
+    }
 
-        } else {                                                /* Err wr'ing data to file.                             */
-            TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_NOT_DEF,
-                        (CPU_CHAR  *) TFTPc_ERR_MSG_WR_ERR,
-                        (TFTPc_ERR *)&err);
-        }
+    TFTPc_BackoffReqDly(TFTPc_BackoffReqRetryCtr, p_err);
+    if (*p_err != TFTPc_ERR_NONE) {
+        return;
     }
+    TFTPc_BackoffReqRetryCtr++;
+
+    sock_addr_size = sizeof(NET_SOCK_ADDR);                     /* Re-tx req (see Note #2).                             */
+   (void)TFTPc_TxPkt((NET_SOCK_ID      ) TFTPc_SockID,
+                     (void            *)&TFTPc_TxPktBuf[0],
+                     (CPU_INT16U       ) TFTPc_TxPktLen,
+                     (NET_SOCK_ADDR   *)&TFTPc_SockAddr,
+                     (NET_SOCK_ADDR_LEN) sock_addr_size,
+                     (TFTPc_ERR       *) p_err);
+
+    TFTPc_TxPktRetry = 0u;
+    TFTPc_STAT_INC(TxRetryCtr);
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_RETRY, TFTPc_TRACE_EVENT_RE_TX, TFTPc_SessionID, TFTPc_BackoffReqRetryCtr, TFTPc_TxPktLen);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                        TFTPc_StateDataPut()
+*                                          TFTPc_BackoffDly()
 *
-* Description : Process received packet for a write request.
+* Description : Delay the transfer.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : dly_ms      Delay, in milliseconds.
 *
-*                               TFTPc_ERR_NONE                  No error.
-*                               TFTPc_ERR_ERR_PKT_RX            Error packet   received.
-*                               TFTPc_ERR_INVALID_OPCODE_RX     Invalid opcode received.
-*                               TFTPc_ERR_INVALID_STATE         Invalid state machine state.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*                                                               ------- RETURNED BY TFTPc_DataRd() : -------
-*                               TFTPc_ERR_FILE_RD               Error reading file.
+*                               TFTPc_ERR_NONE          Delay elapsed.
 *
-*                                                               ------- RETURNED BY TFTPc_TxData() : -------
-*                               TFTPc_ERR_TX                    Error transmitting packet.
+*                                                       ---- RETURNED BY TFTPc_AbortChk() : ----
+*                               TFTPc_ERR_CANCELED      Transfer canceled.
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
 *
 * Return(s)   : none.
 *
-* Caller(s)   : TFTPc_Processing().
+* Caller(s)   : TFTPc_BackoffStart(),
+*               TFTPc_BackoffReqDly().
 *
-* Note(s)     : (1) If the acknowledge block received is not the expected one, nothing is done, and the
-*                   function silently returns.  This is done in order to prevent the 'Sorcerer's Apprentice'
-*                   bug.  Only a receive timeout is supposed to trigger a block retransmission.
+* Note(s)     : (1) When transfer abort is enabled, the delay is sliced like the rx wait, so that a backoff
+*                   does NOT postpone the cancel req & the deadline.
 *********************************************************************************************************
 */
 
-static  void  TFTPc_StateDataPut (TFTPc_ERR  *p_err)
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+static  void  TFTPc_BackoffDly (CPU_INT32U   dly_ms,
+                                TFTPc_ERR   *p_err)
 {
-    CPU_INT16U  rx_blk_nbr;
-    CPU_INT16U  rd_data_len;
-    TFTPc_ERR   err;
-
-
-    switch (TFTPc_RxPktOpcode) {
-        case TFTP_OPCODE_ACK:
-             TFTPc_TRACE_INFO(("TFTPc_StateDataGet: Opcode ACK rx'd\n\r"));
-            *p_err = TFTPc_ERR_NONE;
-             break;
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    CPU_INT32U  ts_start_ms;
+    CPU_INT32U  ts_cur_ms;
+    CPU_INT32U  elapsed_ms;
+    CPU_INT32U  wait_ms;
 
 
-        case TFTP_OPCODE_ERR:
-             TFTPc_TRACE_INFO(("TFTPc_StateDataPut: Opcode ERROR rx'd\n\r"));
-            *p_err = TFTPc_ERR_ERR_PKT_RX;
-             break;
+    ts_start_ms = (CPU_INT32U)TFTPc_TIME_GET_ms();
+    for (;;) {                                                  /* See Note #1.                                         */
+        ts_cur_ms = (CPU_INT32U)TFTPc_TIME_GET_ms();
+        wait_ms   =  TFTPc_AbortChk(ts_cur_ms, p_err);
+        if (*p_err != TFTPc_ERR_NONE) {
+            return;
+        }
 
+        elapsed_ms = ts_cur_ms - ts_start_ms;
+        if (elapsed_ms >= dly_ms) {
+            break;
+        }
 
-        case TFTP_OPCODE_DATA:
-        case TFTP_OPCODE_WRQ:
-        case TFTP_OPCODE_RRQ:
-        default:
-             TFTPc_TRACE_INFO(("TFTPc_StateDataPut: Invalid opcode rx'd\n\r"));
-             TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_ILLEGAL_OP,
-                         (CPU_CHAR  *) 0,
-                         (TFTPc_ERR *)&err);
-            *p_err = TFTPc_ERR_INVALID_OPCODE_RX;
-             break;
+        TFTPc_TIME_DLY_ms(DEF_MIN(wait_ms, dly_ms - elapsed_ms));
     }
-
-    if (*p_err != TFTPc_ERR_NONE) {
-         return;
+#else
+    if (dly_ms > 0u) {
+        TFTPc_TIME_DLY_ms(dly_ms);
     }
+#endif
 
+   *p_err = TFTPc_ERR_NONE;
+}
+#endif
 
 
-    rx_blk_nbr = TFTPc_GetRxBlkNbr();                           /* Get rx'd pkt's blk nbr.                              */
-
-    if (rx_blk_nbr == TFTPc_TxPktBlkNbr) {                      /* If ACK blk nbr matches data sent (see Note #1) ...   */
-
-        switch (TFTPc_State) {
-            case TFTPc_STATE_DATA_PUT:                          /* ... and more data to read, ...                       */
-                 rd_data_len = TFTPc_DataRd(p_err);             /* ... rd next blk from file                      ...   */
+/*
+*********************************************************************************************************
+*                                       TFTPc_BackoffRandGet()
+*
+* Description : Get the next value of the backoff pseudo-random generator.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Pseudo-random value.
+*
+* Caller(s)   : TFTPc_BackoffStart(),
+*               TFTPc_BackoffReqDly().
+*
+* Note(s)     : (1) A 32-bit xorshift generator is used : it is fast, needs no library support & gives the
+*                   same sequence on every target for a given seed.  It is NOT suitable for anything else
+*                   than spreading retries.
+*********************************************************************************************************
+*/
 
-                 if (*p_err == TFTPc_ERR_NONE) {
-                     TFTPc_TxPktBlkNbr++;                       /* ... and tx data.                                     */
-                     TFTPc_TxData(TFTPc_TxPktBlkNbr, rd_data_len, p_err);
-                     TFTPc_TxPktRetry = 0;
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+static  CPU_INT32U  TFTPc_BackoffRandGet (void)
+{
+    CPU_INT32U  x;
 
-                     if (rd_data_len < TFTPc_DATA_BLOCK_SIZE) {
-                         TFTPc_State = TFTPc_STATE_DATA_PUT_WAIT_LAST_ACK;
-                     }
 
-                 } else {                                       /* Err rd'ing data to file.                             */
-                     TFTPc_TxErr((CPU_INT16U ) TFTP_ERR_CODE_NOT_DEF,
-                                 (CPU_CHAR  *) TFTPc_ERR_MSG_RD_ERR,
-                                 (TFTPc_ERR *)&err);
-                 }
-                 break;
+    x                       = TFTPc_BackoffRandState;           /* See Note #1.                                         */
+    x                      ^= x << 13;
+    x                      ^= x >> 17;
+    x                      ^= x <<  5;
+    TFTPc_BackoffRandState  = x;
 
+    return (x);
+}
+#endif
 
-            case TFTPc_STATE_DATA_PUT_WAIT_LAST_ACK:            /* If waiting for last ack, ...                         */
-                 TFTPc_State = TFTPc_STATE_TRANSFER_COMPLETE;   /* ... transfer completed.                              */
-                 break;
 
+/*
+*********************************************************************************************************
+*                                       TFTPc_BackoffSeedGet()
+*
+* Description : Get the default seed of the backoff pseudo-random generator.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Seed value.
+*
+* Caller(s)   : TFTPc_BackoffStart().
+*
+* Note(s)     : (1) Devices powered up together read nearly the same time : the hardware address of the
+*                   default interface, unique per device, is what tells them apart.  It is hashed with
+*                   FNV-1a so that addresses differing by a single bit give unrelated seeds.
+*********************************************************************************************************
+*/
 
-            default:
-                *p_err = TFTPc_ERR_INVALID_STATE;
-                 break;
+#ifdef  TFTPc_BACKOFF_SEED_DFLT
+static  CPU_INT32U  TFTPc_BackoffSeedGet (void)
+{
+    CPU_INT08U  addr_hw[NET_IF_HW_ADDR_LEN_MAX];
+    CPU_INT08U  addr_hw_len;
+    CPU_INT08U  ix;
+    CPU_INT32U  hash;
+    CPU_INT32U  ts_ms;
+    NET_ERR     err;
+
+
+    hash        = 2166136261u;                                  /* FNV-1a offset basis (see Note #1).                   */
+    addr_hw_len = sizeof(addr_hw);
+    NetIF_AddrHW_Get(NetIF_GetDflt(), &addr_hw[0], &addr_hw_len, &err);
+    if (err == NET_IF_ERR_NONE) {
+        for (ix = 0u; ix < addr_hw_len; ix++) {
+            hash ^= addr_hw[ix];
+            hash *= 16777619u;                                  /* FNV-1a prime.                                        */
         }
     }
+
+    ts_ms = (CPU_INT32U)TFTPc_TIME_GET_ms();
+    for (ix = 0u; ix < sizeof(ts_ms); ix++) {
+        hash  ^= (ts_ms >> (ix * DEF_OCTET_NBR_BITS)) & DEF_OCTET_MASK;
+        hash  *=  16777619u;
+    }
+
+    return (hash);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                         TFTPc_GetRxBlkNbr()
+*                                          TFTPc_CapPktWr()
 *
-* Description : Extract the block number from the received TFTP packet.
+* Description : Record a pkt in the capture ring.
 *
-* Argument(s) : none.
+* Argument(s) : dir             Pkt direction :
 *
-* Return(s)   : Received block number.
+*                                   TFTPc_CAP_DIR_RX    Pkt rx'd from 'p_addr'.
+*                                   TFTPc_CAP_DIR_TX    Pkt tx'd to   'p_addr'.
 *
-* Caller(s)   : TFTPc_StateDataPut().
+*               p_addr          Pointer to remote address.
 *
-* Note(s)     : none.
+*               p_pkt           Pointer to pkt.
+*
+*               pkt_len         Length of  pkt (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_CAP_PKT_WR().
+*
+* Note(s)     : (1) The pkt is timestamped with the TFTPc time source, so that the capture of a transfer run
+*                   on a simulated clock has the same timeline as the transfer itself.
 *********************************************************************************************************
 */
 
-static  CPU_INT16U  TFTPc_GetRxBlkNbr (void)
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+static  void  TFTPc_CapPktWr (       CPU_INT08U      dir,
+                                     NET_SOCK_ADDR  *p_addr,
+                              const  void           *p_pkt,
+                                     CPU_INT16U      pkt_len)
 {
-    CPU_INT16U  blk_nbr;
-
+#ifdef  TFTPc_IPv4_EN
+    NET_SOCK_ADDR_IPv4  *p_addrv4;
+#endif
+#ifdef  TFTPc_IPv6_EN
+    NET_SOCK_ADDR_IPv6  *p_addrv6;
+#endif
+    CPU_INT08U          *p_addr_remote;
+    CPU_INT08U           addr_family;
+    CPU_INT16U           port;
+
+
+    p_addr_remote = DEF_NULL;
+    addr_family   = TFTPc_CAP_ADDR_FAMILY_NONE;
+    port          = 0u;
+    switch (p_addr->AddrFamily) {
+#ifdef  TFTPc_IPv4_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V4:
+             p_addrv4      = (NET_SOCK_ADDR_IPv4 *)p_addr;
+             p_addr_remote = (CPU_INT08U *)&p_addrv4->Addr;
+             addr_family   =  TFTPc_CAP_ADDR_FAMILY_IPv4;
+             port          =  NET_UTIL_NET_TO_HOST_16(p_addrv4->Port);
+             break;
+#endif
+#ifdef  TFTPc_IPv6_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V6:
+             p_addrv6      = (NET_SOCK_ADDR_IPv6 *)p_addr;
+             p_addr_remote = (CPU_INT08U *)&p_addrv6->Addr;
+             addr_family   =  TFTPc_CAP_ADDR_FAMILY_IPv6;
+             port          =  NET_UTIL_NET_TO_HOST_16(p_addrv6->Port);
+             break;
+#endif
 
-    blk_nbr = NET_UTIL_VAL_GET_NET_16(&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_BLK_NBR]);
+        default:
+             break;
+    }
 
-    return (blk_nbr);
+    TFTPc_CapRecWr(dir,                                         /* See Note #1.                                         */
+                   TFTPc_SessionID,
+                   TFTPc_TIME_GET_ms(),
+                   addr_family,
+                   p_addr_remote,
+                   port,
+                   p_pkt,
+                   pkt_len);
 }
+#endif
 
 
 /*
 *********************************************************************************************************
-*                                        TFTPc_FileOpenMode()
+*                                            TFTPc_RxPkt()
 *
-* Description : Open the specified file for read or write.
+* Description : Receive TFTP packet.
 *
-* Argument(s) : filename        Name of the file to open.
+* Argument(s) : sock_id         Socket descriptor/handle identifier of socket to receive data.
 *
-*               file_access     File access :
+*               p_pkt           Pointer to packet to receive.
 *
-*                                   TFTPc_FILE_OPEN_RD      Open for reading.
-*                                   TFTPc_FILE_OPEN_WR      Open for writing.
+*               pkt_len         Length of  packet to receive (in octets).
 *
-* Return(s)   : Pointer to a file handle for the opened file, if NO error.
+*               p_err       Pointer to variable that will receive the return error code from this function :
 *
-*               Pointer to NULL,                              otherwise.
+*                               TFTPc_ERR_NONE          Packet successfully transmitted.
+*                               TFTPc_ERR_RX_TIMEOUT    Receive timeout.
+*                               TFTPc_ERR_RX            Error receiving packet.
 *
-* Caller(s)   : TFTPc_Get(),
-*               TFTPc_Put().
+*                                                       --- RETURNED BY TFTPc_RxWaitChk() : ---
+*                               TFTPc_ERR_CANCELED      Transfer canceled.
+*                               TFTPc_ERR_DEADLINE      Transfer deadline exceeded.
 *
-* Note(s)     : none.
+* Return(s)   : Number of positive data octets received, if NO errors.
+*
+*               NET_SOCK_BSD_RTN_CODE_CONN_CLOSED,       if socket connection closed.
+*
+*               NET_SOCK_BSD_ERR_RX,                     otherwise.
+*
+* Caller(s)   : TFTPc_Processing().
+*
+* Note(s)     : (1) RFC #1350, section 4 'Initial Connection Protocol' states that "if a source TID does not
+*                   match, the packet should be discarded as erroneously sent from somewhere else.  An error
+*                   packet should be sent to the source of the incorrect packet".
+*
+*                   (a) The first packet rx'd from the server's address sets the server TID (port).  When
+*                       TFTPc_CFG_SOCK_CONN_EN is enabled, the socket is then connected to the server TID
+*                       so that the network stack discards foreign packets itself.
+*
+*                   (b) Any other packet whose source address or port does not match the server TID is
+*                       answered with an ERROR 'Unknown transfer ID' & discarded; reception goes on.  This
+*                       also stops a second server session created by a retransmitted request.
+*
+*                   (c) A stray packet does NOT restart the inactivity timeout : reception goes on for the
+*                       time remaining since the rx started, so that a flow of stray packets cannot hold
+*                       the transfer forever.
+*
+*               (2) #### Transitory errors (NET_ERR_RX) should probably trigger another attempt to
+*                   transmit the packet, instead of returning an error right away.
+*
+*               (3) When transfer abort is enabled, the rx wait is sliced by TFTPc_RxWaitChk() : an empty
+*                   slice does NOT end the rx, which goes on until the inactivity timeout expires.
+*
+*               (4) When request backoff is enabled, an ERROR pkt does NOT set the server TID, so that the req
+*                   can be tx'd again to the server port (see TFTPc_BackoffErrRx()).
+*
+*               (5) When packet capture is enabled, every pkt delivered to the state machine is recorded,
+*                   including stray pkts, before the TID is validated, so that a replay reproduces what the
+*                   state machine saw.
 *********************************************************************************************************
 */
 
-static  void  *TFTPc_FileOpenMode (CPU_CHAR           *p_filename,
-                                   TFTPc_FILE_ACCESS   file_access)
+static  NET_SOCK_RTN_CODE  TFTPc_RxPkt (NET_SOCK_ID         sock_id,
+                                        void               *p_pkt,
+                                        CPU_INT16U          pkt_len,
+                                        TFTPc_ERR          *p_err)
 {
-    void  *pfile;
+    NET_SOCK_RTN_CODE  rtn_code;
+    NET_SOCK_ADDR      server_sock_addr_ip;
+    NET_SOCK_ADDR_LEN  server_sock_addr_ip_len;
+    CPU_BOOLEAN        rx_done;
+    CPU_INT32U         ts_start_ms;
+#if (TFTPc_CFG_ABORT_EN != DEF_ENABLED)
+    CPU_INT32U         elapsed_ms;
+    CPU_BOOLEAN        timeout_cut;
+#endif
+    NET_ERR            err;
 
 
-    pfile = (void *)0;
-    switch (file_access) {
-        case TFTPc_FILE_OPEN_RD:
-             pfile = NetFS_FileOpen(p_filename,
-                                    NET_FS_FILE_MODE_OPEN,
-                                    NET_FS_FILE_ACCESS_RD);
-             break;
+    ts_start_ms = TFTPc_TIME_GET_ms();
+#if (TFTPc_CFG_ABORT_EN != DEF_ENABLED)
+    timeout_cut = DEF_NO;
+#endif
 
+    rx_done = DEF_NO;
+    while (rx_done == DEF_NO) {
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+        TFTPc_RxWaitChk(sock_id, ts_start_ms, p_err);           /* Chk abort & set rx wait slice (see Note #3).         */
+        if (*p_err != TFTPc_ERR_NONE) {
+            return (NET_SOCK_BSD_ERR_RX);
+        }
+#endif
+                                                                /* --------------- RX PKT THROUGH SOCK ---------------- */
+        server_sock_addr_ip_len = sizeof(server_sock_addr_ip);
+        rtn_code                = TFTPc_RxPktSock(sock_id,
+                                                  p_pkt,
+                                                  pkt_len,
+                                                 &server_sock_addr_ip,
+                                                 &server_sock_addr_ip_len,
+                                                 &err);
+        rx_done = DEF_YES;
+        switch (err) {
+            case NET_SOCK_ERR_NONE:
+                 TFTPc_STAT_INC(RxPktCtr);
+                                                                /* See Note #5.                                         */
+                 TFTPc_CAP_PKT_WR(TFTPc_CAP_DIR_RX, &server_sock_addr_ip, p_pkt, rtn_code);
+                                                                /* ------------------ VALIDATE TID -------------------- */
+                 if (TFTPc_SockAddrCmp(&server_sock_addr_ip, &TFTPc_SockAddr, TFTPc_TID_Set) != DEF_YES) {
+                     TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_RX_STRAY, TFTPc_SessionID, rtn_code, 0u);
+                     TFTPc_STAT_INC(RxStrayPktCtr);
+                     TFTPc_TxErrStray(&server_sock_addr_ip);    /* See Note #1b.                                        */
+                     rx_done = DEF_NO;
+#if (TFTPc_CFG_ABORT_EN != DEF_ENABLED)                         /* Rx for the remaining time (see Note #1c).            */
+                     elapsed_ms = (CPU_INT32U)TFTPc_TIME_GET_ms() - ts_start_ms;
+                     if (elapsed_ms >= TFTPc_RxTimeout_ms) {
+                        *p_err   = TFTPc_ERR_RX_TIMEOUT;
+                         rtn_code = NET_SOCK_BSD_ERR_RX;
+                         rx_done  = DEF_YES;
+                         break;
+                     }
+                     NetSock_CfgTimeoutRxQ_Set(sock_id,
+                                               TFTPc_RxTimeout_ms - elapsed_ms,
+                                              &err);
+                     timeout_cut = DEF_YES;
+#endif
+                     break;
+                 }
 
-        case TFTPc_FILE_OPEN_WR:
-             pfile = NetFS_FileOpen(p_filename,
-                                    NET_FS_FILE_MODE_CREATE,
-                                    NET_FS_FILE_ACCESS_WR);
-             break;
+                *p_err = TFTPc_ERR_NONE;
+#if (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+                 if ((rtn_code >= TFTP_PKT_OFFSET_OPCODE + TFTP_PKT_SIZE_OPCODE) &&
+                     (NET_UTIL_VAL_GET_NET_16((CPU_INT08U *)p_pkt + TFTP_PKT_OFFSET_OPCODE) == TFTP_OPCODE_ERR)) {
+                     break;                                     /* See Note #4.                                         */
+                 }
+#endif
+                 if (TFTPc_TID_Set != DEF_YES) {                /* If terminal ID NOT set, (see Note #1a) ...           */
+                     TFTPc_TID_Update(&server_sock_addr_ip);    /* ... change server port to last rx'd one.             */
+                 }
+                 break;
 
+            case NET_SOCK_ERR_RX_Q_EMPTY:
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+                 rx_done = DEF_NO;                              /* See Note #3.                                         */
+#else
+                *p_err = TFTPc_ERR_RX_TIMEOUT;
+#endif
+                 break;
 
-        default:
-             break;
+            case NET_ERR_RX:                                    /* See Note #2.                                         */
+            default:
+                *p_err = TFTPc_ERR_RX;
+                 break;
+        }
     }
 
-    return (pfile);
+#if (TFTPc_CFG_ABORT_EN != DEF_ENABLED)
+    if (timeout_cut == DEF_YES) {                               /* Restore the full rx timeout.                         */
+        NetSock_CfgTimeoutRxQ_Set(sock_id,
+                                  TFTPc_RxTimeout_ms,
+                                 &err);
+    }
+#endif
+
+    return (rtn_code);
 }
 
 
 /*
 *********************************************************************************************************
-*                                           TFTPc_DataWr()
+*                                         TFTPc_RxPktSock()
 *
-* Description : Write data to the file system.
+* Description : Receive a packet from the socket.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : sock_id         Socket descriptor/handle identifier of socket to receive data.
 *
-*                               TFTPc_ERR_NONE      No error.
-*                               TFTPc_ERR_FILE_WR   Error writing to file.
+*               p_pkt           Pointer to packet to receive.
 *
-* Return(s)   : Number of octets written to file.
+*               pkt_len         Length of  packet to receive (in octets).
 *
-* Caller(s)   : TFTPc_StateDataGet().
+*               p_addr_remote   Pointer to variable that will receive the source address.
 *
-* Note(s)     : none.
+*               p_addr_len      Pointer to length of source address buffer (in octets).
+*
+*               p_err           Pointer to variable that will receive the return error code from
+*                               NetSock_RxDataFrom().
+*
+* Return(s)   : Return value of NetSock_RxDataFrom().
+*
+* Caller(s)   : TFTPc_RxPkt().
+*
+* Note(s)     : (1) Once a multicast group is joined, the pkt is rx'd from the client sock or from the
+*                   multicast sock, whichever has data first.
 *********************************************************************************************************
 */
 
-static  CPU_INT16U  TFTPc_DataWr (TFTPc_ERR  *p_err)
+static  NET_SOCK_RTN_CODE  TFTPc_RxPktSock (NET_SOCK_ID         sock_id,
+                                            void               *p_pkt,
+                                            CPU_INT16U          pkt_len,
+                                            NET_SOCK_ADDR      *p_addr_remote,
+                                            NET_SOCK_ADDR_LEN  *p_addr_len,
+                                            NET_ERR            *p_err)
 {
-    CPU_SIZE_T  rx_data_len;
-    CPU_SIZE_T  wr_data_len;
-
+    NET_SOCK_RTN_CODE  rtn_code;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32           ts_start;
+#endif
 
-    rx_data_len = TFTPc_RxPktLen - TFTP_PKT_SIZE_OPCODE - TFTP_PKT_SIZE_BLK_NBR;
-    wr_data_len = 0;
 
-    if (rx_data_len > 0) {
-       (void)NetFS_FileWr((void       *) TFTPc_FileHandle,
-                          (void       *)&TFTPc_RxPktBuf[TFTP_PKT_OFFSET_DATA],
-                          (CPU_SIZE_T  ) rx_data_len,
-                          (CPU_SIZE_T *)&wr_data_len);
+    TFTPc_PROFILE_TS_GET(ts_start);
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if (TFTPc_McastSockID != NET_SOCK_ID_NONE) {                /* See Note #1.                                         */
+        sock_id = TFTPc_McastSockSel(sock_id, p_err);
+        if (*p_err != NET_SOCK_ERR_NONE) {
+            return (NET_SOCK_BSD_ERR_RX);
+        }
     }
+#endif
 
-    if (wr_data_len != rx_data_len) {
-       *p_err = TFTPc_ERR_FILE_WR;
-    } else {
-       *p_err = TFTPc_ERR_NONE;
+    rtn_code = NetSock_RxDataFrom((NET_SOCK_ID        ) sock_id,
+                                  (void              *) p_pkt,
+                                  (CPU_INT16U         ) pkt_len,
+                                  (CPU_INT16S         ) NET_SOCK_FLAG_NONE,
+                                  (NET_SOCK_ADDR     *) p_addr_remote,
+                                  (NET_SOCK_ADDR_LEN *) p_addr_len,
+                                  (void              *) 0,
+                                  (CPU_INT08U         ) 0,
+                                  (CPU_INT08U        *) 0,
+                                  (NET_ERR           *) p_err);
+    if (*p_err == NET_SOCK_ERR_NONE) {
+        TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_RX, ts_start);
     }
 
-    return ((CPU_INT16U)wr_data_len);
+    return (rtn_code);
 }
 
 
 /*
 *********************************************************************************************************
-*                                           TFTPc_DataRd()
+*                                         TFTPc_SockAddrCmp()
 *
-* Description : Read data from the file system.
+* Description : Check whether a packet was received from the expected remote host.
 *
-* Argument(s) : p_err       Pointer to variable that will receive the return error code from this function :
+* Argument(s) : p_addr          Pointer to source address of the received packet.
 *
-*                               TFTPc_ERR_NONE      No error.
-*                               TFTPc_ERR_FILE_RD   Error reading file.
+*               p_addr_ref      Pointer to address of the expected remote host (the server, or the relay peer).
 *
-* Return(s)   : Number of octets read from file.
+*               port_chk        Indicates whether the source port must also match the remote TID :
 *
-* Caller(s)   : TFTPc_StateDataPut().
+*                                   DEF_YES     Address & port must match.
+*                                   DEF_NO      Only the address must match.
+*
+* Return(s)   : DEF_YES, if the packet comes from the expected remote host.
+*
+*               DEF_NO,  otherwise.
+*
+* Caller(s)   : TFTPc_RxPkt(),
+*               TFTPc_RelaySrvBlkTx().
 *
 * Note(s)     : none.
 *********************************************************************************************************
 */
 
-static  CPU_INT16U  TFTPc_DataRd (TFTPc_ERR  *p_err)
+static  CPU_BOOLEAN  TFTPc_SockAddrCmp (NET_SOCK_ADDR  *p_addr,
+                                        NET_SOCK_ADDR  *p_addr_ref,
+                                        CPU_BOOLEAN     port_chk)
 {
-    CPU_SIZE_T   rd_data_len;
-    CPU_BOOLEAN  err;
+#ifdef  TFTPc_IPv4_EN
+    NET_SOCK_ADDR_IPv4  *p_addrv4;
+    NET_SOCK_ADDR_IPv4  *p_serverv4;
+#endif
+#ifdef  TFTPc_IPv6_EN
+    NET_SOCK_ADDR_IPv6  *p_addrv6;
+    NET_SOCK_ADDR_IPv6  *p_serverv6;
+#endif
 
 
-   *p_err = TFTPc_ERR_NONE;
-                                                                /* Rd data from file.                                   */
-    err  = NetFS_FileRd((void       *) TFTPc_FileHandle,
-                        (void       *)&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_DATA],
-                        (CPU_SIZE_T  ) TFTPc_DATA_BLOCK_SIZE,
-                        (CPU_SIZE_T *)&rd_data_len);
+    if (p_addr->AddrFamily != p_addr_ref->AddrFamily) {
+        return (DEF_NO);
+    }
 
-    if (rd_data_len == 0) {                                     /* If NO data rd                   ...                  */
-        if (err == DEF_FAIL) {                                  /* ... and err occurred (NOT EOF), ...                  */
-           *p_err = TFTPc_ERR_FILE_RD;                          /* ... rtn err.                                         */
-        }
+    switch (p_addr_ref->AddrFamily) {
+#ifdef  TFTPc_IPv4_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V4:
+             p_addrv4   = (NET_SOCK_ADDR_IPv4 *)p_addr;
+             p_serverv4 = (NET_SOCK_ADDR_IPv4 *)p_addr_ref;
+             if (p_addrv4->Addr != p_serverv4->Addr) {
+                 return (DEF_NO);
+             }
+             if ((port_chk       == DEF_YES) &&
+                 (p_addrv4->Port != p_serverv4->Port)) {
+                 return (DEF_NO);
+             }
+             break;
+#endif
+#ifdef  TFTPc_IPv6_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V6:
+             p_addrv6   = (NET_SOCK_ADDR_IPv6 *)p_addr;
+             p_serverv6 = (NET_SOCK_ADDR_IPv6 *)p_addr_ref;
+             if (Mem_Cmp(&p_addrv6->Addr, &p_serverv6->Addr, sizeof(p_addrv6->Addr)) != DEF_YES) {
+                 return (DEF_NO);
+             }
+             if ((port_chk       == DEF_YES) &&
+                 (p_addrv6->Port != p_serverv6->Port)) {
+                 return (DEF_NO);
+             }
+             break;
+#endif
+
+        default:
+             return (DEF_NO);
     }
 
-    return ((CPU_INT16U)rd_data_len);
+    return (DEF_YES);
 }
 
 
 /*
 *********************************************************************************************************
-*                                            TFTPc_RxPkt()
-*
-* Description : Receive TFTP packet.
-*
-* Argument(s) : sock_id         Socket descriptor/handle identifier of socket to receive data.
-*
-*               p_pkt           Pointer to packet to receive.
-*
-*               pkt_len         Length of  packet to receive (in octets).
-*
-*               p_err       Pointer to variable that will receive the return error code from this function :
-*
-*                               TFTPc_ERR_NONE          Packet successfully transmitted.
-*                               TFTPc_ERR_RX_TIMEOUT    Receive timeout.
-*                               TFTPc_ERR_RX            Error receiving packet.
+*                                         TFTPc_TID_Update()
 *
-* Return(s)   : Number of positive data octets received, if NO errors.
+* Description : Set the server terminal ID (port) from the first packet received from the server.
 *
-*               NET_SOCK_BSD_RTN_CODE_CONN_CLOSED,       if socket connection closed.
+* Argument(s) : p_addr          Pointer to source address of the first packet received from the server.
 *
-*               NET_SOCK_BSD_ERR_RX,                     otherwise.
+* Return(s)   : none.
 *
-* Caller(s)   : TFTPc_Processing().
+* Caller(s)   : TFTPc_RxPkt().
 *
-* Note(s)     : (1) #### When returning from the receive function, we should make sure the received
-*                   packet comes from the host we are connected to.
+* Note(s)     : (1) See 'TFTPc_RxPkt()  Note #1a'.  If the socket cannot be connected, packets keep being
+*                   tx'd with NetSock_TxDataTo() & filtered by TFTPc_RxPkt() only.
 *
-*               (2) #### Transitory errors (NET_ERR_RX) should probably trigger another attempt to
-*                   transmit the packet, instead of returning an error right away.
+*               (2) The first pkt rx'd from a pool server samples its round-trip time.
 *********************************************************************************************************
 */
 
-static  NET_SOCK_RTN_CODE  TFTPc_RxPkt (NET_SOCK_ID         sock_id,
-                                        void               *p_pkt,
-                                        CPU_INT16U          pkt_len,
-                                        TFTPc_ERR          *p_err)
+static  void  TFTPc_TID_Update (NET_SOCK_ADDR  *p_addr)
 {
-#ifdef  NET_IPv4_MODULE_EN
+#ifdef  TFTPc_IPv4_EN
     NET_SOCK_ADDR_IPv4  *p_addrv4;
     NET_SOCK_ADDR_IPv4  *p_serverv4;
 #endif
-#ifdef  NET_IPv6_MODULE_EN
+#ifdef  TFTPc_IPv6_EN
     NET_SOCK_ADDR_IPv6  *p_addrv6;
     NET_SOCK_ADDR_IPv6  *p_serverv6;
 #endif
-    NET_SOCK_RTN_CODE  rtn_code;
-    NET_SOCK_ADDR      server_sock_addr_ip;
-    NET_SOCK_ADDR_LEN  server_sock_addr_ip_len;
-    NET_ERR            err;
-
-                                                                /* --------------- RX PKT THROUGH SOCK ---------------- */
-                                                                /* See Note #1.                                         */
-    server_sock_addr_ip_len = sizeof(server_sock_addr_ip);
-    rtn_code                = NetSock_RxDataFrom((NET_SOCK_ID        ) sock_id,
-                                                 (void              *) p_pkt,
-                                                 (CPU_INT16U         ) pkt_len,
-                                                 (CPU_INT16S         ) NET_SOCK_FLAG_NONE,
-                                                 (NET_SOCK_ADDR     *)&server_sock_addr_ip,
-                                                 (NET_SOCK_ADDR_LEN *)&server_sock_addr_ip_len,
-                                                 (void              *) 0,
-                                                 (CPU_INT08U         ) 0,
-                                                 (CPU_INT08U        *) 0,
-                                                 (NET_ERR           *)&err);
-    switch (err) {
-        case NET_SOCK_ERR_NONE:
-            *p_err = TFTPc_ERR_NONE;
-             if (TFTPc_TID_Set != DEF_YES) {                    /* If terminal ID NOT set, ...                          */
-                                                                /* ... change server port to last rx'd one.             */
-                 switch(TFTPc_SockAddr.AddrFamily) {
-#ifdef  NET_IPv4_MODULE_EN
-                     case NET_SOCK_ADDR_FAMILY_IP_V4:
-                          p_addrv4       = (NET_SOCK_ADDR_IPv4 *)&TFTPc_SockAddr;
-                          p_serverv4     = (NET_SOCK_ADDR_IPv4 *)&server_sock_addr_ip;
-                          p_addrv4->Port =  p_serverv4->Port;
-                          break;
-#endif
-#ifdef  NET_IPv6_MODULE_EN
-                     case NET_SOCK_ADDR_FAMILY_IP_V6:
-                          p_addrv6       = (NET_SOCK_ADDR_IPv6 *)&TFTPc_SockAddr;
-                          p_serverv6     = (NET_SOCK_ADDR_IPv6 *)&server_sock_addr_ip;
-                          p_addrv6->Port =  p_serverv6->Port;
-                          break;
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)
+    NET_ERR              err;
 #endif
 
-                     default:
-                          return (TFTPc_ERR_INVALID_PROTO_FAMILY);
-                 }
 
-                 TFTPc_TID_Set       = DEF_YES;
-             }
+    switch (TFTPc_SockAddr.AddrFamily) {
+#ifdef  TFTPc_IPv4_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V4:
+             p_addrv4         = (NET_SOCK_ADDR_IPv4 *)&TFTPc_SockAddr;
+             p_serverv4       = (NET_SOCK_ADDR_IPv4 *) p_addr;
+             p_addrv4->Port   =  p_serverv4->Port;
              break;
-
-        case NET_SOCK_ERR_RX_Q_EMPTY:
-            *p_err = TFTPc_ERR_RX_TIMEOUT;
+#endif
+#ifdef  TFTPc_IPv6_EN
+        case NET_SOCK_ADDR_FAMILY_IP_V6:
+             p_addrv6         = (NET_SOCK_ADDR_IPv6 *)&TFTPc_SockAddr;
+             p_serverv6       = (NET_SOCK_ADDR_IPv6 *) p_addr;
+             p_addrv6->Port   =  p_serverv6->Port;
              break;
+#endif
 
-        case NET_ERR_RX:                                        /* See Note #2.                                         */
         default:
-            *p_err = TFTPc_ERR_RX;
-             break;
+             return;
     }
 
-    return (rtn_code);
+    TFTPc_TID_Set = DEF_YES;
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+    TFTPc_PoolRTT_Update();                                     /* See Note #2.                                         */
+#endif
+
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)                     /* See Note #1.                                         */
+   (void)NetSock_Conn((NET_SOCK_ID      ) TFTPc_SockID,
+                      (NET_SOCK_ADDR   *)&TFTPc_SockAddr,
+                      (NET_SOCK_ADDR_LEN) sizeof(NET_SOCK_ADDR),
+                      (NET_ERR         *)&err);
+    if (err == NET_SOCK_ERR_NONE) {
+        TFTPc_SockConn = DEF_YES;
+    }
+#endif
 }
 
 
@@ -1626,6 +10280,35 @@ static  NET_SOCK_RTN_CODE  TFTPc_RxPkt (NET_SOCK_ID         sock_id,
 *
 * Note(s)     : (1) RFC #1350, section 1 'Purpose' states that "the mail mode is obsolete and should not
 *                   be implemented or used".
+*
+*               (2) TFTPc_MODE_FLAG_CODEC only selects the codec (see TFTPc_CodecSel()); it is NOT part of the
+*                   TFTP transfer mode.
+*
+*               (3) TFTPc_MODE_FLAG_MCAST requests the multicast option (RFC #2090) for a read request from an
+*                   IPv4 server.  The option is NOT requested when a codec, the flash sink or the archive
+*                   extraction is used, since they require the blocks in sequence.
+*
+*               (4) When the file is wr'n to flash, the transfer size option (RFC #2349) is req'd, so that a
+*                   file too large for the partition is rejected before any block is rx'd & that sectors are
+*                   only erased up to the end of the file (see TFTPc_FlashTSizeRx()).
+*
+*               (5) The window size option (RFC #7440) is req'd for a read request, unless the multicast
+*                   option is req'd.  The transfer goes on with a window of 1 block until the server accepts
+*                   the option.  With the adaptive window, the window size req'd is the one adapted by the
+*                   previous reads (see TFTPc_WinAdaptUpdate()).
+*
+*               (6) The block size option (RFC #2348) is req'd for a read request, unless the multicast option
+*                   is req'd (see TFTPc_BlkSizeSet()), or the request is re-tx'd without it after a timeout (see
+*                   TFTPc_BlkSizeFallbackChk()).  The transfer goes on with blocks of 512 octets until the
+*                   server accepts the option.
+*
+*               (7) TFTPc_MODE_FLAG_BG only selects background pacing (see TFTPc_BgYield()); it is NOT part of
+*                   the TFTP transfer mode.  The round-trip time is measured anew for each request, since the
+*                   request MAY be tx'd to another server.
+*
+*               (8) The session start timestamp is taken when the first request of the session is tx'd, so
+*                   that the session duration excludes the server name resolution, the socket setup & the
+*                   request jitter.  A request re-tx'd to another server does NOT restart it.
 *********************************************************************************************************
 */
 
@@ -1639,6 +10322,16 @@ static  void  TFTPc_TxReq (CPU_INT16U   req_opcode,
     CPU_INT16U          mode_len;
     CPU_INT16U          wr_pkt_ix;
     NET_SOCK_ADDR_LEN   sock_addr_size;
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+    CPU_CHAR            win_str[TFTP_OPT_NBR_VAL_LEN_MAX];
+#endif
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+    CPU_CHAR            blksize_str[TFTP_OPT_NBR_VAL_LEN_MAX];
+    CPU_INT16U          blk_size;
+#endif
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32            ts_start;
+#endif
 
 
                                                                 /* ------------------ VALIDATE ARGS ------------------- */
@@ -1653,10 +10346,95 @@ static  void  TFTPc_TxReq (CPU_INT16U   req_opcode,
          return;
     }
 
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    mode &= (TFTPc_MODE)~TFTPc_MODE_FLAG_CODEC;                 /* See Note #2.                                         */
+#endif
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    mode &= (TFTPc_MODE)~TFTPc_MODE_FLAG_FLASH;
+#endif
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+    mode &= (TFTPc_MODE)~TFTPc_MODE_FLAG_TAR;
+#endif
+
+#if (TFTPc_CFG_BG_EN == DEF_ENABLED)
+    mode &= (TFTPc_MODE)~TFTPc_MODE_FLAG_BG;                    /* See Note #7.                                         */
+#endif
+
+#ifdef  TFTPc_RTT_EN
+    TFTPc_RTT_Reset();
+#endif
+
+#ifdef  TFTPc_OPT_EN
+    TFTPc_OptReq = 0u;
+#endif
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if ((req_opcode                   == TFTP_OPCODE_RRQ)            &&
+        (TFTPc_SockAddr.AddrFamily    == NET_SOCK_ADDR_FAMILY_IP_V4) &&
+        (DEF_BIT_IS_SET(mode, TFTPc_MODE_FLAG_MCAST) == DEF_YES)) {
+        DEF_BIT_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST);        /* See Note #3.                                         */
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+        if (TFTPc_CodecActive == DEF_YES) {
+            DEF_BIT_CLR(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST);
+        }
+#endif
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+        if (TFTPc_FlashActive == DEF_YES) {
+            DEF_BIT_CLR(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST);
+        }
+#endif
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+        if (TFTPc_TarActive == DEF_YES) {
+            DEF_BIT_CLR(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST);
+        }
+#endif
+    }
+    mode &= (TFTPc_MODE)~TFTPc_MODE_FLAG_MCAST;
+#endif
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    if ((req_opcode        == TFTP_OPCODE_RRQ) &&
+        (TFTPc_FlashActive == DEF_YES)) {
+        DEF_BIT_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_TSIZE);        /* See Note #4.                                         */
+    }
+#endif
+
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+    TFTPc_WinReset();
+    if ((req_opcode                                      == TFTP_OPCODE_RRQ) &&
+        (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST) == DEF_NO)) {
+        DEF_BIT_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_WIN);          /* See Note #5.                                         */
+#ifdef  TFTPc_WIN_ADAPT_EN
+        TFTPc_WinSizeReq = TFTPc_WinAdaptSize;
+#else
+        TFTPc_WinSizeReq = TFTPc_CFG_WIN_SIZE_MAX;
+#endif
+    }
+#endif
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+    TFTPc_BlkSize    = TFTPc_DATA_BLOCK_SIZE;
+    TFTPc_BlkSizeReq = 0u;
+    TFTPc_STAT_SET(BlkSize, TFTPc_DATA_BLOCK_SIZE);
+    if ((req_opcode                                      == TFTP_OPCODE_RRQ) &&
+        (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST) == DEF_NO)  &&
+        (TFTPc_BlkSizeFallback                              == DEF_NO)) {
+        blk_size         = TFTPc_BlkSizeReqGet();
+        TFTPc_BlkSizeReq = blk_size;
+        if (blk_size != TFTPc_DATA_BLOCK_SIZE) {
+            DEF_BIT_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_BLKSIZE);  /* See Note #6.                                         */
+        }
+    }
+#endif
+
     switch (mode) {
+#if (TFTPc_CFG_NETASCII_EN == DEF_ENABLED)
         case TFTPc_MODE_NETASCII:
              pmode_str = TFTP_MODE_NETASCII_STR;
              break;
+#endif
 
 
         case TFTPc_MODE_OCTET:
@@ -1673,6 +10451,7 @@ static  void  TFTPc_TxReq (CPU_INT16U   req_opcode,
 
 
                                                                 /* -------------------- CREATE PKT -------------------- */
+    TFTPc_PROFILE_TS_GET(ts_start);
                                                                 /* Wr opcode.                                           */
     NET_UTIL_VAL_SET_NET_16(&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_OPCODE],
                              req_opcode);
@@ -1697,6 +10476,51 @@ static  void  TFTPc_TxReq (CPU_INT16U   req_opcode,
                      mode_len  +
                      TFTP_PKT_SIZE_NULL;
 
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)                         /* Wr options.                                          */
+    if (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_MCAST) == DEF_YES) {
+        TFTPc_TxPktLen = TFTPc_TxReqOptAdd(TFTPc_TxPktLen, TFTP_OPT_MCAST_STR, "", TFTPc_OPT_FLAG_MCAST);
+    }
+#endif
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    if (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_TSIZE) == DEF_YES) {
+        TFTPc_TxPktLen = TFTPc_TxReqOptAdd(TFTPc_TxPktLen, TFTP_OPT_TSIZE_STR, TFTP_OPT_TSIZE_REQ_STR, TFTPc_OPT_FLAG_TSIZE);
+    }
+#endif
+#if (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+    if (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_WIN) == DEF_YES) {
+       (void)Str_FmtNbr_Int32U((CPU_INT32U) TFTPc_WinSizeReq,
+                               (CPU_INT08U)(TFTP_OPT_NBR_VAL_LEN_MAX - 1u),
+                                            DEF_NBR_BASE_DEC,
+                                            ASCII_CHAR_NULL,
+                                            DEF_NO,
+                                            DEF_YES,
+                                           &win_str[0]);
+        TFTPc_TxPktLen = TFTPc_TxReqOptAdd(TFTPc_TxPktLen, TFTP_OPT_WIN_STR, &win_str[0], TFTPc_OPT_FLAG_WIN);
+    }
+#endif
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+    if (DEF_BIT_IS_SET(TFTPc_OptReq, TFTPc_OPT_FLAG_BLKSIZE) == DEF_YES) {
+       (void)Str_FmtNbr_Int32U((CPU_INT32U) TFTPc_BlkSizeReq,
+                               (CPU_INT08U)(TFTP_OPT_NBR_VAL_LEN_MAX - 1u),
+                                            DEF_NBR_BASE_DEC,
+                                            ASCII_CHAR_NULL,
+                                            DEF_NO,
+                                            DEF_YES,
+                                           &blksize_str[0]);
+        TFTPc_TxPktLen = TFTPc_TxReqOptAdd(TFTPc_TxPktLen, TFTP_OPT_BLKSIZE_STR, &blksize_str[0], TFTPc_OPT_FLAG_BLKSIZE);
+    }
+#endif
+
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_PKT_BUILD, ts_start);
+
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_STATE, TFTPc_TRACE_EVENT_REQ_TX, TFTPc_SessionID, req_opcode, TFTPc_TxPktLen);
+
+#if (TFTPc_CFG_STAT_EN == DEF_ENABLED)
+    if (TFTPc_Stats.TxPktCtr == 0u) {                           /* See Note #8.                                         */
+        TFTPc_Stats.TS_Start_ms = TFTPc_TIME_GET_ms();
+    }
+#endif
+
 
                                                                  /* --------------------- TX PKT ---------------------- */
     sock_addr_size = sizeof(NET_SOCK_ADDR);
@@ -1734,14 +10558,19 @@ static  void  TFTPc_TxReq (CPU_INT16U   req_opcode,
 *********************************************************************************************************
 */
 
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
 static  void  TFTPc_TxData (TFTPc_BLK_NBR   blk_nbr,
                             CPU_INT16U      data_len,
                             TFTPc_ERR      *p_err)
 {
     NET_SOCK_ADDR_LEN  sock_addr_size;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32           ts_start;
+#endif
 
 
                                                                 /* -------------------- CREATE PKT -------------------- */
+    TFTPc_PROFILE_TS_GET(ts_start);
                                                                 /* Wr opcode.                                           */
     NET_UTIL_VAL_SET_NET_16(&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_OPCODE],
                              TFTP_OPCODE_DATA);
@@ -1755,6 +10584,10 @@ static  void  TFTPc_TxData (TFTPc_BLK_NBR   blk_nbr,
                      TFTP_PKT_SIZE_BLK_NBR +
                      data_len;
 
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_PKT_BUILD, ts_start);
+
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_PKT, TFTPc_TRACE_EVENT_DATA_TX, TFTPc_SessionID, blk_nbr, data_len);
+
                                                                  /* --------------------- TX PKT ---------------------- */
     sock_addr_size = sizeof(NET_SOCK_ADDR);
    (void)TFTPc_TxPkt((NET_SOCK_ID      ) TFTPc_SockID,
@@ -1764,6 +10597,7 @@ static  void  TFTPc_TxData (TFTPc_BLK_NBR   blk_nbr,
                      (NET_SOCK_ADDR_LEN) sock_addr_size,
                      (TFTPc_ERR       *) p_err);
 }
+#endif
 
 
 /*
@@ -1793,8 +10627,12 @@ static  void  TFTPc_TxAck (TFTPc_BLK_NBR   blk_nbr,
                            TFTPc_ERR      *p_err)
 {
     NET_SOCK_ADDR_LEN  sock_addr_size;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32           ts_start;
+#endif
 
 
+    TFTPc_PROFILE_TS_GET(ts_start);
     NET_UTIL_VAL_SET_NET_16(&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_OPCODE],
                              TFTP_OPCODE_ACK);
 
@@ -1803,6 +10641,10 @@ static  void  TFTPc_TxAck (TFTPc_BLK_NBR   blk_nbr,
 
     TFTPc_TxPktLen = TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_BLK_NBR;
 
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_PKT_BUILD, ts_start);
+
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_PKT, TFTPc_TRACE_EVENT_ACK_TX, TFTPc_SessionID, blk_nbr, 0u);
+
 
                                                                  /* --------------------- TX PKT ---------------------- */
     sock_addr_size = sizeof(NET_SOCK_ADDR);
@@ -1847,8 +10689,12 @@ static  void  TFTPc_TxErr (CPU_INT16U   err_code,
 {
     CPU_INT16U         err_msg_len;
     NET_SOCK_ADDR_LEN  sock_addr_size;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32           ts_start;
+#endif
 
 
+    TFTPc_PROFILE_TS_GET(ts_start);
     NET_UTIL_VAL_SET_NET_16(&TFTPc_TxPktBuf[TFTP_PKT_OFFSET_OPCODE],
                              TFTP_OPCODE_ERR);
 
@@ -1872,6 +10718,10 @@ static  void  TFTPc_TxErr (CPU_INT16U   err_code,
                      err_msg_len            +
                      TFTP_PKT_SIZE_NULL;
 
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_PKT_BUILD, ts_start);
+
+    TFTPc_TRACE_EVENT_WR(TFTPc_TRACE_LVL_ERR, TFTPc_TRACE_EVENT_ERR_TX, TFTPc_SessionID, err_code, 0u);
+
                                                                  /* --------------------- TX PKT ---------------------- */
     sock_addr_size = sizeof(NET_SOCK_ADDR);
    (void)TFTPc_TxPkt((NET_SOCK_ID      ) TFTPc_SockID,
@@ -1883,6 +10733,52 @@ static  void  TFTPc_TxErr (CPU_INT16U   err_code,
 }
 
 
+/*
+*********************************************************************************************************
+*                                         TFTPc_TxErrStray()
+*
+* Description : Transmit a TFTP 'Unknown transfer ID' error packet to the source of a stray packet.
+*
+* Argument(s) : p_addr_remote   Pointer to source address of the stray packet.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_RxPkt().
+*
+* Note(s)     : (1) See 'TFTPc_RxPkt()  Note #1b'.
+*
+*               (2) The error packet is built in a local buffer so that the last packet tx'd to the server
+*                   is kept for retransmission.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_TxErrStray (NET_SOCK_ADDR  *p_addr_remote)
+{
+    CPU_INT08U  pkt_buf[TFTP_PKT_SIZE_OPCODE + TFTP_PKT_SIZE_ERR_CODE + sizeof(TFTPc_ERR_MSG_UNKNOWN_ID)];
+    CPU_INT16U  pkt_len;
+    TFTPc_ERR   err;
+
+
+    NET_UTIL_VAL_SET_NET_16(&pkt_buf[TFTP_PKT_OFFSET_OPCODE],   /* See Note #2.                                         */
+                             TFTP_OPCODE_ERR);
+
+    NET_UTIL_VAL_SET_NET_16(&pkt_buf[TFTP_PKT_OFFSET_ERR_CODE],
+                             TFTP_ERR_CODE_UNKNOWN_ID);
+
+    Str_Copy((CPU_CHAR *)&pkt_buf[TFTP_PKT_OFFSET_ERR_MSG],
+             (CPU_CHAR *) TFTPc_ERR_MSG_UNKNOWN_ID);
+
+    pkt_len = sizeof(pkt_buf);
+
+   (void)TFTPc_TxPkt((NET_SOCK_ID      ) TFTPc_SockID,
+                     (void            *)&pkt_buf[0],
+                     (CPU_INT16U       ) pkt_len,
+                     (NET_SOCK_ADDR   *) p_addr_remote,
+                     (NET_SOCK_ADDR_LEN) sizeof(NET_SOCK_ADDR),
+                     (TFTPc_ERR       *)&err);
+}
+
+
 /*
 *********************************************************************************************************
 *                                            TFTPc_TxPkt()
@@ -1904,6 +10800,10 @@ static  void  TFTPc_TxErr (CPU_INT16U   err_code,
 *                               TFTPc_ERR_NONE      Packet successfully transmitted.
 *                               TFTPc_ERR_TX        Error transmitting packet.
 *
+*                                                   ---- RETURNED BY TFTPc_TxRateWait() : ----
+*                               TFTPc_ERR_CANCELED  Transfer canceled           (see Note #3).
+*                               TFTPc_ERR_DEADLINE  Transfer deadline exceeded  (see Note #3).
+*
 * Return(s)   : Number of positive data octets transmitted, if NO error.
 *
 *               NET_SOCK_BSD_RTN_CODE_CONN_CLOSED,          if socket connection closed.
@@ -1917,6 +10817,13 @@ static  void  TFTPc_TxErr (CPU_INT16U   err_code,
 *
 * Note(s)     : (1) #### Transitory errors (NET_ERR_TX) should probably trigger another attempt to
 *                   transmit the packet, instead of returning an error right away.
+*
+*               (2) When tx rate limit is enabled, the packet is held until the global & session token
+*                   buckets allow it to be tx'd (see 'tftp-c_cfg.h  TFTPc TX RATE LIMIT CONFIGURATION').
+*
+*               (3) A transfer aborted while a packet waits for the tx rate limit returns TFTPc_ERR_CANCELED
+*                   or TFTPc_ERR_DEADLINE without tx'ing the packet, unless it is an ERROR pkt : the ERROR pkt
+*                   notifying the server of the abort is tx'd at once (see TFTPc_Processing() Note #2).
 *********************************************************************************************************
 */
 
@@ -1929,17 +10836,31 @@ static  NET_SOCK_RTN_CODE  TFTPc_TxPkt (NET_SOCK_ID         sock_id,
 {
     NET_SOCK_RTN_CODE  rtn_code;
     NET_ERR            err;
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+    CPU_INT16U         opcode;
+#endif
 
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+    TFTPc_TxRateWait(pkt_len, p_err);                           /* See Note #2.                                         */
+    if (*p_err != TFTPc_ERR_NONE) {
+        opcode = NET_UTIL_VAL_GET_NET_16((CPU_INT08U *)p_pkt + TFTP_PKT_OFFSET_OPCODE);
+        if (opcode != TFTP_OPCODE_ERR) {                        /* See Note #3.                                         */
+            return (NET_SOCK_BSD_ERR_TX);
+        }
+    }
+#endif
                                                                 /* --------------- TX PKT THROUGH SOCK ---------------- */
-    rtn_code = NetSock_TxDataTo((NET_SOCK_ID      ) sock_id,
-                                (void            *) p_pkt,
-                                (CPU_INT16U       ) pkt_len,
-                                (CPU_INT16S       ) NET_SOCK_FLAG_NONE,
-                                (NET_SOCK_ADDR   *) p_addr_remote,
-                                (NET_SOCK_ADDR_LEN) addr_len,
-                                (NET_ERR         *)&err);
+    rtn_code = TFTPc_TxPktSock(sock_id,
+                               p_pkt,
+                               pkt_len,
+                               p_addr_remote,
+                               addr_len,
+                              &err);
+
     switch (err) {
         case NET_SOCK_ERR_NONE:
+             TFTPc_STAT_INC(TxPktCtr);
             *p_err = TFTPc_ERR_NONE;
              break;
 
@@ -1953,6 +10874,85 @@ static  NET_SOCK_RTN_CODE  TFTPc_TxPkt (NET_SOCK_ID         sock_id,
 }
 
 
+/*
+*********************************************************************************************************
+*                                         TFTPc_TxPktSock()
+*
+* Description : Transmit a packet through the socket.
+*
+* Argument(s) : sock_id         Socket descriptor/handle identifier of socket to transmit data.
+*
+*               p_pkt           Pointer to packet to transmit.
+*
+*               pkt_len         Length of  packet to transmit (in octets).
+*
+*               p_addr_remote   Pointer to destination address buffer.
+*
+*               addr_len        Length of  destination address buffer (in octets).
+*
+*               p_err           Pointer to variable that will receive the return error code from
+*                               NetSock_TxData() or NetSock_TxDataTo().
+*
+* Return(s)   : Return value of NetSock_TxData() or NetSock_TxDataTo().
+*
+* Caller(s)   : TFTPc_TxPkt().
+*
+* Note(s)     : (1) Once the socket is connected to the server TID (see 'TFTPc_RxPkt()  Note #1a'), packets
+*                   to the server are tx'd without specifying the remote address.
+*
+*               (2) When packet capture is enabled, every pkt successfully tx'd is recorded, including
+*                   ERROR pkts tx'd to stray hosts.
+*********************************************************************************************************
+*/
+
+static  NET_SOCK_RTN_CODE  TFTPc_TxPktSock (NET_SOCK_ID         sock_id,
+                                            void               *p_pkt,
+                                            CPU_INT16U          pkt_len,
+                                            NET_SOCK_ADDR      *p_addr_remote,
+                                            NET_SOCK_ADDR_LEN   addr_len,
+                                            NET_ERR            *p_err)
+{
+    NET_SOCK_RTN_CODE  rtn_code;
+    CPU_BOOLEAN        tx_conn;
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+    CPU_TS32           ts_start;
+#endif
+
+
+    tx_conn = DEF_NO;
+#if (TFTPc_CFG_SOCK_CONN_EN == DEF_ENABLED)
+    if ((TFTPc_SockConn == DEF_YES) &&                          /* See Note #1.                                         */
+        (p_addr_remote  == &TFTPc_SockAddr)) {
+        tx_conn = DEF_YES;
+    }
+#endif
+
+    TFTPc_PROFILE_TS_GET(ts_start);
+    if (tx_conn == DEF_YES) {
+        rtn_code = NetSock_TxData((NET_SOCK_ID      ) sock_id,
+                                  (void            *) p_pkt,
+                                  (CPU_INT16U       ) pkt_len,
+                                  (CPU_INT16S       ) NET_SOCK_FLAG_NONE,
+                                  (NET_ERR         *) p_err);
+    } else {
+        rtn_code = NetSock_TxDataTo((NET_SOCK_ID      ) sock_id,
+                                    (void            *) p_pkt,
+                                    (CPU_INT16U       ) pkt_len,
+                                    (CPU_INT16S       ) NET_SOCK_FLAG_NONE,
+                                    (NET_SOCK_ADDR   *) p_addr_remote,
+                                    (NET_SOCK_ADDR_LEN) addr_len,
+                                    (NET_ERR         *) p_err);
+    }
+    TFTPc_PROFILE_PHASE_END(TFTPc_PROFILE_PHASE_TX, ts_start);
+
+    if (*p_err == NET_SOCK_ERR_NONE) {                          /* See Note #2.                                         */
+        TFTPc_CAP_PKT_WR(TFTPc_CAP_DIR_TX, p_addr_remote, p_pkt, pkt_len);
+    }
+
+    return (rtn_code);
+}
+
+
 /*
 *********************************************************************************************************
 *                                          TFTPc_Terminate()
@@ -1961,6 +10961,9 @@ static  NET_SOCK_RTN_CODE  TFTPc_TxPkt (NET_SOCK_ID         sock_id,
 *
 *                   (a) Set TFTP client state to 'COMPLETE'
 *                   (b) Close opened file.
+*                   (c) Release codec & flash sink.
+*                   (d) Leave multicast group.
+*                   (e) End session for TFTPc_Cancel().
 *
 *
 * Argument(s) : none.
@@ -1978,6 +10981,9 @@ static  NET_SOCK_RTN_CODE  TFTPc_TxPkt (NET_SOCK_ID         sock_id,
 static  void  TFTPc_Terminate (void)
 {
     NET_ERR  err;
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    CPU_SR_ALLOC();
+#endif
 
 
     if (TFTPc_SockID != NET_SOCK_ID_NONE) {                     /* Close sock.                                          */
@@ -1985,8 +10991,45 @@ static  void  TFTPc_Terminate (void)
         TFTPc_SockID = NET_SOCK_ID_NONE;
     }
 
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+    if (TFTPc_TarActive == DEF_YES) {                           /* Close entry left incomplete.                         */
+        if (TFTPc_TarEntryOpen == DEF_YES) {
+            TFTPc_TarEntryClose(DEF_NO);
+        }
+        TFTPc_TarActive = DEF_NO;
+    }
+#endif
+
     if (TFTPc_FileHandle != (void *)0) {                        /* Close file.                                          */
         NetFS_FileClose(TFTPc_FileHandle);
         TFTPc_FileHandle  = (void *)0;
     }
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+    if (TFTPc_CodecActive == DEF_YES) {                         /* Release codec.                                       */
+        if (TFTPc_CodecPtr->Close != DEF_NULL) {
+            TFTPc_CodecPtr->Close(TFTPc_CodecPtr->CtxPtr);
+        }
+        TFTPc_CodecActive = DEF_NO;
+    }
+#endif
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+    TFTPc_FlashActive = DEF_NO;                                 /* Release flash sink.                                  */
+#endif
+
+#if (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+    if (TFTPc_McastSockID != NET_SOCK_ID_NONE) {                /* Leave multicast grp.                                 */
+       (void)NetIGMP_HostGrpLeave(TFTPc_McastIF_Nbr, TFTPc_McastAddr, &err);
+        NetSock_Close(TFTPc_McastSockID, &err);
+        TFTPc_McastSockID = NET_SOCK_ID_NONE;
+    }
+#endif
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+    CPU_CRITICAL_ENTER();                                       /* End session.                                         */
+    TFTPc_SessionActive = DEF_NO;
+    TFTPc_AbortReq      = DEF_NO;
+    CPU_CRITICAL_EXIT();
+#endif
 }
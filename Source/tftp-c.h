@@ -113,6 +113,14 @@
 *
 *               (c) (1) \<TFTPc>\Source\tftp-c.h
 *                                      \tftp-c.c
+*                                      \tftp-c_trace.h
+*                                      \tftp-c_trace.c
+*                                      \tftp-c_delta.h
+*                                      \tftp-c_delta.c
+*                                      \tftp-c_flash.h
+*                                      \tftp-c_flash.c
+*                                      \tftp-c_cap.h
+*                                      \tftp-c_cap.c
 *
 *           (2) CPU-configuration software files are located in the following directories :
 *
@@ -156,16 +164,14 @@
 #include  <lib_str.h>                                           /* Standard String Library        (see Note #3a)        */
 
 #include  <tftp-c_cfg.h>                                        /* TFTP Client Configuration File (see Note #1a)        */
+#include  "tftp-c_trace.h"                                      /* TFTP Client Trace Ring         (see Note #1c)        */
+#include  "tftp-c_cap.h"                                        /* TFTP Client Capture Ring       (see Note #1c)        */
 
 #include  <FS/net_fs.h>                                         /* File System Interface          (see Note #1b)        */
 
 #include  <Source/net.h>                                        /* Network Protocol Suite         (see Note #1b)        */
 #include  <Source/net_sock.h>
 
-#if 1
-#include  <stdio.h>
-#endif
-
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -184,6 +190,42 @@
 #define  TFTPc_MODE_OCTET                                  2
 #define  TFTPc_MODE_MAIL                                   3
 
+#define  TFTPc_MODE_FLAG_CODEC                    DEF_BIT_07    /* Use codec for transfer (see TFTPc_CodecSet()).       */
+#define  TFTPc_MODE_FLAG_MCAST                    DEF_BIT_06    /* Req multicast transfer (see TFTPc_Get()).            */
+#define  TFTPc_MODE_FLAG_FLASH                    DEF_BIT_05    /* Wr file to flash       (see TFTPc_FlashSet()).       */
+#define  TFTPc_MODE_FLAG_TAR                      DEF_BIT_04    /* Extract tar archive    (see TFTPc_Get()).            */
+#define  TFTPc_MODE_FLAG_BG                       DEF_BIT_03    /* Background transfer    (see TFTPc_Get()).            */
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc SESSION DEFINES
+*********************************************************************************************************
+*/
+
+#define  TFTPc_SESSION_ID_ANY                              0u   /* Any session            (see TFTPc_Cancel()).         */
+                                                                /* No session             (see TFTPc_SessionIDGet()).   */
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc BLOCK SIZE DEFINES
+*********************************************************************************************************
+*/
+
+#define  TFTPc_BLKSIZE_AUTO                                0u   /* Blk size from MTU      (see TFTPc_BlkSizeSet()).     */
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPc SERVER ERROR DEFINES
+*********************************************************************************************************
+*/
+
+#define  TFTPc_ERR_CLASS_NONE                              0u   /* No ERROR pkt rx'd.                                   */
+#define  TFTPc_ERR_CLASS_TRANSIENT                         1u   /* Server may succeed later; req MAY be retried.        */
+#define  TFTPc_ERR_CLASS_PERMANENT                         2u   /* Req will fail again; do NOT retry.                   */
+
 
 /*
 *********************************************************************************************************
@@ -220,7 +262,17 @@ typedef  enum  tftpc_err {
     TFTPc_ERR_FILE_RD,                                  /* Err rd'ing from file.                                */
     TFTPc_ERR_FILE_WR,                                  /* Err wr'ing to   file.                                */
     TFTPc_ERR_INVALID_STATE,                            /* Invalid state for TFTP client state machine.         */
-    TFTPc_ERR_INVALID_PROTO_FAMILY                      /* Invalid or unsupported protocol family.              */
+    TFTPc_ERR_INVALID_PROTO_FAMILY,                     /* Invalid or unsupported protocol family.              */
+    TFTPc_ERR_CODEC,                                    /* Codec err.                                           */
+    TFTPc_ERR_OPT_NEGO,                                 /* Option negotiation failed.                           */
+    TFTPc_ERR_MCAST,                                    /* Multicast transfer err.                              */
+    TFTPc_ERR_FLASH,                                    /* Flash err.                                           */
+    TFTPc_ERR_CANCELED,                                 /* Transfer canceled.                                   */
+    TFTPc_ERR_DEADLINE,                                 /* Transfer deadline exceeded.                          */
+    TFTPc_ERR_SESSION_NONE,                             /* No session in progress.                              */
+    TFTPc_ERR_TAR,                                      /* Invalid or unsupported archive.                      */
+    TFTPc_ERR_RELAY,                                    /* Relay responder NOT started or transfer abandoned.   */
+    TFTPc_ERR_POOL                                      /* Server pool err.                                     */
 } TFTPc_ERR;
 
 
@@ -233,6 +285,257 @@ typedef  enum  tftpc_err {
 typedef  CPU_INT08U  TFTPc_MODE;
 
 
+/*
+*********************************************************************************************************
+*                                     TFTPc STATISTICS DATA TYPE
+*
+* Note(s) : (1) Statistics are reset at the start of each transfer session.
+*
+*           (2) The transfer counters are meant to be compared between runs of the same transfer, e.g. to
+*               evaluate a change to the transfer engine :
+*
+*               (a) 'DataOctetCtr' & 'DataBlkCtr' count file data only, each block once, re-tx excluded.
+*
+*               (b) 'TxPktCtr' & 'RxPktCtr' count every pkt tx'd & rx'd on the session socket, including
+*                   requests, re-tx & pkts rx'd from an unknown TID.
+*
+*               (c) 'Duration_ms' is the time from the first request tx until the session terminates; the
+*                   server name resolution & the socket setup are excluded.  0 if no request was tx'd.
+*                   Throughput (octets/sec) = (DataOctetCtr * 1000) / Duration_ms.
+*
+*               (d) 'SparseOctetCtr' counts the octets NOT written because they only hold zero, or erased
+*                   octets with the flash sink (see 'tftp-c_cfg.h  TFTPc SPARSE WRITE CONFIGURATION').  With the
+*                   flash sink, whole pages are counted, including the padding of the last page.
+*
+*               (e) 'RxGapCtr' counts the blocks rx'd while a previous block was missing, during a windowed
+*                   transfer; 'RxReorderBlkCtr' counts those kept & wr'n once the missing block was rx'd (see
+*                   'tftp-c_cfg.h  TFTPc WINDOWED TRANSFER CONFIGURATION').
+*
+*           (3) 'BlkSize' is the block size of the transfer, as negotiated with the server (see 'tftp-c_cfg.h
+*               TFTPc BLOCK SIZE CONFIGURATION').
+*
+*           (4) 'WinSize' is the window size of the transfer, as negotiated with the server (see 'tftp-c_cfg.h
+*               TFTPc ADAPTIVE WINDOW CONFIGURATION'); 'RTT_ms' is the smoothed round-trip time measured
+*               during the transfer, or zero if none was measured (see 'tftp-c_cfg.h  TFTPc BACKGROUND TRANSFER
+*               CONFIGURATION  Note #1a').
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_stats {
+    CPU_INT16U  SessionID;                                      /* Session the stats belong to.                         */
+    CPU_INT32U  DataOctetCtr;                                   /* Nbr of file data octets transferred (see Note #2a).  */
+    CPU_INT32U  DataBlkCtr;                                     /* Nbr of DATA blks transferred        (see Note #2a).  */
+    CPU_INT32U  TxPktCtr;                                       /* Nbr of pkts tx'd                    (see Note #2b).  */
+    CPU_INT32U  RxPktCtr;                                       /* Nbr of pkts rx'd                    (see Note #2b).  */
+    CPU_INT32U  RxTimeoutCtr;                                   /* Nbr of rx timeouts.                                  */
+    CPU_INT32U  TxRetryCtr;                                     /* Nbr of pkts re-tx'd on rx timeout.                   */
+    CPU_INT32U  RxDupDataReAckCtr;                              /* Nbr of dup DATA blks answered by a re-ACK.           */
+    CPU_INT32U  RxStrayPktCtr;                                  /* Nbr of pkts rx'd from an unknown TID.                */
+    CPU_INT32U  SparseOctetCtr;                                 /* Nbr of file data octets NOT wr'n    (see Note #2d).  */
+    CPU_INT32U  RxGapCtr;                                       /* Nbr of blks rx'd ahead of a gap     (see Note #2e).  */
+    CPU_INT32U  RxReorderBlkCtr;                                /* Nbr of blks kept  ahead of a gap    (see Note #2e).  */
+    CPU_INT16U  BlkSize;                                        /* Blk size (octets)                   (see Note #3).   */
+    CPU_INT16U  WinSize;                                        /* Window size (blks)                  (see Note #4).   */
+    CPU_INT32U  RTT_ms;                                         /* Smoothed round-trip time (ms)       (see Note #4).   */
+    NET_TS_MS   TS_Start_ms;                                    /* First req tx timestamp              (see Note #2c).  */
+    NET_TS_MS   Duration_ms;                                    /* Session duration                    (see Note #2c).  */
+} TFTPc_STATS;
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPc SERVER POOL STATISTICS DATA TYPE
+*
+* Note(s) : (1) The statistics of a server are reset when the pool is registered with TFTPc_PoolSet().
+*
+*           (2) 'RTT_ms' is the smoothed time between the tx of a request & the first pkt rx'd from the
+*               server.  Requests that had to be re-tx'd are NOT sampled, since the pkt answered is unknown.
+*
+*           (3) 'FailRate' is the smoothed rate of requests that ended without any answer from the server,
+*               or on which the server stopped answering, expressed in units of 1/TFTPc_POOL_RATE_SCALE
+*               (0.01 %).  Requests ended by an ERROR pkt are NOT failures : the server answered.
+*********************************************************************************************************
+*/
+
+#define  TFTPc_POOL_RATE_SCALE                         10000u
+
+typedef  struct  tftpc_pool_stat {
+    CPU_INT32U  RTT_ms;                                         /* Smoothed round-trip time         (see Note #2).      */
+    CPU_INT32U  RTT_NbrSamples;                                 /* Nbr of round-trip time samples.                      */
+    CPU_INT16U  FailRate;                                       /* Smoothed failure rate            (see Note #3).      */
+    CPU_INT32U  ReqCtr;                                         /* Nbr of requests tx'd to the server.                  */
+    CPU_INT32U  FailCtr;                                        /* Nbr of failed requests           (see Note #3).      */
+} TFTPc_POOL_STAT;
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc SERVER ERROR DATA TYPE
+*
+* Note(s) : (1) The server ERROR is reset at the start of each transfer session.  'Class' is
+*               TFTPc_ERR_CLASS_NONE if NO ERROR pkt was rx'd during the session.
+*
+*           (2) 'Msg' is always NULL-terminated; it is empty if the server sent NO message.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_server_err {
+    CPU_INT16U  SessionID;                                      /* Session the ERROR belongs to.                        */
+    CPU_INT08U  Class;                                          /* ERROR class (TFTPc_ERR_CLASS_xxx, see Note #1).      */
+    CPU_INT16U  Code;                                           /* TFTP ERROR code rx'd.                                */
+    CPU_CHAR    Msg[TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX + 1u];     /* ERROR msg rx'd (see Note #2).                        */
+} TFTPc_SERVER_ERR;
+
+
+/*
+*********************************************************************************************************
+*                                    TFTPc PHASE PROFILE DATA TYPES
+*
+* Note(s) : (1) Phase durations are expressed in CPU timestamp timer counts (see CPU_TS_TmrFreqGet() &
+*               CPU_TS32_to_uSec()).
+*
+*           (2) Phases of a transfer :
+*
+*               (a) TFTPc_PROFILE_PHASE_RX          Waiting in NetSock_RxDataFrom() until a pkt is rx'd.
+*                                                   Rx timeouts are NOT accounted.
+*               (b) TFTPc_PROFILE_PHASE_FILE        Wr'ing rx'd data to file / rd'ing data to tx from file.
+*               (c) TFTPc_PROFILE_PHASE_PKT_BUILD   Building pkts to tx.
+*               (d) TFTPc_PROFILE_PHASE_TX          Tx'ing pkts through NetSock_TxDataTo().
+*********************************************************************************************************
+*/
+
+#define  TFTPc_PROFILE_PHASE_RX                            0u
+#define  TFTPc_PROFILE_PHASE_FILE                          1u
+#define  TFTPc_PROFILE_PHASE_PKT_BUILD                     2u
+#define  TFTPc_PROFILE_PHASE_TX                            3u
+
+#define  TFTPc_PROFILE_PHASE_NBR                           4u
+
+typedef  struct  tftpc_profile_phase {
+    CPU_INT32U  NbrSamples;                                     /* Nbr of times phase was executed.                     */
+    CPU_TS32    Min;                                            /* Min phase duration (see Note #1).                    */
+    CPU_TS32    Max;                                            /* Max phase duration.                                  */
+    CPU_TS32    Mean;                                           /* Mean phase duration.                                 */
+    CPU_INT64U  Total;                                          /* Sum of all phase durations.                          */
+} TFTPc_PROFILE_PHASE;
+
+typedef  struct  tftpc_profile {
+    CPU_INT16U           SessionID;                             /* Session the profile belongs to.                      */
+    TFTPc_PROFILE_PHASE  Phase[TFTPc_PROFILE_PHASE_NBR];        /* Indexed by phase (see Note #2).                      */
+} TFTPc_PROFILE;
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc CODEC DATA TYPE
+*
+* Note(s) : (1) A codec transforms the file data in the transfer path : data rx'd by TFTPc_Get() is decoded
+*               before being wr'n to the file & file data is encoded before being tx'd by TFTPc_Put().  Any
+*               streaming codec (e.g. LZ4 frame) can be plugged through this interface; a heatshrink codec
+*               (see 'tftp-c_hs.h') & a delta update codec (see 'tftp-c_delta.h') are provided.
+*
+*           (2) 'Init()' resets the codec state at the start of a transfer.  'encode' is DEF_YES for
+*               TFTPc_Put() & DEF_NO for TFTPc_Get().
+*
+*           (3) 'Process()' consumes up to 'src_len' octets from 'p_src' & produces up to 'dst_len' octets
+*               in 'p_dst'.  It returns the number of octets consumed & produced in '*p_src_used' &
+*               '*p_dst_used'.  'flush' is DEF_YES once the end of the input was reached : the codec MUST
+*               then output all pending data, over as many calls as needed, & return '*p_dst_used' of 0
+*               when done.  'Process()' returns DEF_FAIL on corrupted or unsupported data.
+*
+*           (4) The codec is used for a transfer when the remote filename ends with 'SuffixPtr' or when
+*               TFTPc_MODE_FLAG_CODEC is set in the transfer mode.  'SuffixPtr' MAY be NULL.
+*
+*           (5) 'Close()' is called once the transfer using the codec ends, whether it completed or was
+*               aborted, so that the codec can release its resources (e.g. close a file opened by 'Init()').
+*               'Close' MAY be NULL.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_codec {
+    const  CPU_CHAR     *SuffixPtr;                             /* Remote filename suffix (see Note #4).                */
+           void         *CtxPtr;                                /* Codec ctx, passed to each fnct.                      */
+
+    CPU_BOOLEAN        (*Init)   (       void         *p_ctx,   /* Reset codec state (see Note #2).                     */
+                                         CPU_BOOLEAN   encode);
+
+    CPU_BOOLEAN        (*Process)(       void         *p_ctx,   /* Encode/decode data (see Note #3).                    */
+                                  const  CPU_INT08U   *p_src,
+                                         CPU_SIZE_T    src_len,
+                                         CPU_SIZE_T   *p_src_used,
+                                         CPU_INT08U   *p_dst,
+                                         CPU_SIZE_T    dst_len,
+                                         CPU_SIZE_T   *p_dst_used,
+                                         CPU_BOOLEAN   flush);
+
+    void               (*Close)  (       void         *p_ctx);  /* Release codec resources (see Note #5).               */
+} TFTPc_CODEC;
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc FLASH DRIVER DATA TYPE
+*
+* Note(s) : (1) The flash driver gives TFTPc_Get() direct access to a flash partition, bypassing NetFS (e.g.
+*               to write a firmware image).  Addresses are offsets from the start of the partition.
+*
+*           (2) 'Size' MUST be a multiple of 'SectorSize', which MUST be a multiple of 'PageSize'.
+*               'PageSize' MUST NOT be greater than TFTPc_CFG_FLASH_PAGE_SIZE_MAX.
+*
+*           (3) 'SectorErase()' erases the sector starting at 'addr'.  'PageProg()' programs the page starting
+*               at 'addr' with 'PageSize' octets from 'p_data'; the page is always erased beforehand.  Both
+*               return DEF_OK or DEF_FAIL & MAY block until the operation completes.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_flash {
+    void               *CtxPtr;                                 /* Driver ctx, passed to each fnct.                     */
+    CPU_INT32U          Size;                                   /* Partition size (in octets, see Note #2).             */
+    CPU_INT32U          SectorSize;                             /* Erase unit     (in octets).                          */
+    CPU_INT16U          PageSize;                               /* Program unit   (in octets).                          */
+
+    CPU_BOOLEAN       (*SectorErase)(       void        *p_ctx, /* Erase sector   (see Note #3).                        */
+                                            CPU_INT32U   addr);
+
+    CPU_BOOLEAN       (*PageProg)   (       void        *p_ctx, /* Program page   (see Note #3).                        */
+                                            CPU_INT32U   addr,
+                                     const  CPU_INT08U  *p_data);
+} TFTPc_FLASH;
+
+
+/*
+*********************************************************************************************************
+*                                  TFTPc ARCHIVE ENTRY SINK DATA TYPE
+*
+* Note(s) : (1) The entry sink receives the regular files extracted from a tar archive by TFTPc_Get(),
+*               instead of NetFS (e.g. to write each file to its own flash partition).  Directories, links &
+*               other entries are NOT passed to the sink.
+*
+*           (2) 'EntryOpen()' is called with the entry name, as found in the archive ('/' separated), & the
+*               entry size.  'EntryWr()' is then called with the entry data, in order, over as many calls as
+*               needed.  Both return DEF_OK or DEF_FAIL; DEF_FAIL aborts the transfer.
+*
+*           (3) 'EntryClose()' is called once per opened entry.  'complete' is DEF_NO if the transfer was
+*               aborted before all the entry data was rx'd.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_tar_sink {
+    void               *CtxPtr;                                 /* Sink ctx, passed to each fnct.                       */
+
+    CPU_BOOLEAN       (*EntryOpen) (       void        *p_ctx,  /* Open entry  (see Note #2).                           */
+                                    const  CPU_CHAR    *p_name,
+                                           CPU_INT32U   size);
+
+    CPU_BOOLEAN       (*EntryWr)   (       void        *p_ctx,  /* Wr entry data (see Note #2).                         */
+                                    const  CPU_INT08U  *p_data,
+                                           CPU_SIZE_T   data_len);
+
+    void              (*EntryClose)(       void        *p_ctx,  /* Close entry (see Note #3).                           */
+                                           CPU_BOOLEAN  complete);
+} TFTPc_TAR_SINK;
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
@@ -253,17 +556,99 @@ CPU_BOOLEAN  TFTPc_Get        (const  TFTPc_CFG      *p_cfg,
                                       TFTPc_MODE      mode,
                                       TFTPc_ERR      *p_err);
 
+#if (TFTPc_CFG_PUT_EN == DEF_ENABLED)
 CPU_BOOLEAN  TFTPc_Put        (const  TFTPc_CFG      *p_cfg,
                                       CPU_CHAR       *p_filename_local,
                                       CPU_CHAR       *p_filename_remote,
                                       TFTPc_MODE      mode,
                                       TFTPc_ERR      *p_err);
+#endif
+
+#if (TFTPc_CFG_STAT_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_StatsGet   (       TFTPc_STATS    *p_stats,
+                                      TFTPc_ERR      *p_err);
+#endif
+
+CPU_BOOLEAN  TFTPc_ServerErrGet (     TFTPc_SERVER_ERR *p_server_err,
+                                      TFTPc_ERR        *p_err);
+
+#if (TFTPc_CFG_TX_RATE_LIMIT_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_TxRateLimitSet (CPU_INT32U      rate_max_octets_per_sec,
+                                   CPU_INT32U      burst_max_octets,
+                                   TFTPc_ERR      *p_err);
+#endif
+
+#if (TFTPc_CFG_PROFILE_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_ProfileGet (       TFTPc_PROFILE  *p_profile,
+                                      TFTPc_ERR      *p_err);
+#endif
+
+#if (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_CodecSet     (const  TFTPc_CODEC       *p_codec,
+                                        TFTPc_ERR         *p_err);
+#endif
+
+#if (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_FlashSet     (const  TFTPc_FLASH       *p_flash,
+                                        TFTPc_ERR         *p_err);
+#endif
+
+#if (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_TarSinkSet   (const  TFTPc_TAR_SINK    *p_sink,
+                                        TFTPc_ERR         *p_err);
+#endif
+
+#if (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_RelayPeerSet    (const  TFTPc_CFG          *p_peers,
+                                           CPU_INT08U          nbr_peers,
+                                           TFTPc_ERR          *p_err);
+
+CPU_BOOLEAN  TFTPc_RelayCacheAdd   (const  CPU_CHAR           *p_filename_remote,
+                                    const  CPU_CHAR           *p_filename_local,
+                                           TFTPc_ERR          *p_err);
+
+CPU_BOOLEAN  TFTPc_RelaySrvStart   (       NET_IP_ADDR_FAMILY  ip_family,
+                                           NET_PORT_NBR        port,
+                                           TFTPc_ERR          *p_err);
+
+CPU_BOOLEAN  TFTPc_RelaySrvProcess (       CPU_INT32U          timeout_ms,
+                                           TFTPc_ERR          *p_err);
+
+void         TFTPc_RelaySrvStop    (void);
+#endif
+
+#if (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_PoolSet      (const  TFTPc_CFG         *p_servers,
+                                        CPU_INT08U         nbr_servers,
+                                        TFTPc_ERR         *p_err);
+
+CPU_BOOLEAN  TFTPc_PoolStatGet  (       CPU_INT08U         ix,
+                                        TFTPc_POOL_STAT   *p_stat,
+                                        TFTPc_ERR         *p_err);
+#endif
+
+#if (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_BlkSizeSet   (       CPU_INT16U         blk_size,
+                                        TFTPc_ERR         *p_err);
+#endif
+
+#if (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_Cancel       (       CPU_INT16U         session_id,
+                                        TFTPc_ERR         *p_err);
+
+CPU_INT16U   TFTPc_SessionIDGet (       TFTPc_ERR         *p_err);
+#endif
 
 
 /*
 *********************************************************************************************************
 *********************************************************************************************************
 *                                               TRACING
+*
+* Note(s) : (1) 'stdio.h' is only included when text tracing is enabled, for the default TFTPc_TRACE,
+*               'printf()' (see 'INCLUDE FILES  Note #3').  The TFTPc core otherwise only depends
+*               on the uC/CPU, uC/LIB, uC/Common (KAL) & uC/TCP-IP (sockets & NetFS) interfaces, so that
+*               it can be built against any port of these interfaces.
 *********************************************************************************************************
 *********************************************************************************************************
 */
@@ -285,6 +670,10 @@ CPU_BOOLEAN  TFTPc_Put        (const  TFTPc_CFG      *p_cfg,
 #define  TFTPc_TRACE_LEVEL                   TRACE_LEVEL_OFF
 #endif
 
+#if     (TFTPc_TRACE_LEVEL >= TRACE_LEVEL_INFO)
+#include  <stdio.h>                                             /* See Note #1.                                         */
+#endif
+
 #ifndef  TFTPc_TRACE
 #define  TFTPc_TRACE                                  printf
 #endif
@@ -307,6 +696,623 @@ CPU_BOOLEAN  TFTPc_Put        (const  TFTPc_CFG      *p_cfg,
 #endif
 
 
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                        CONFIGURATION ERRORS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CFG_STAT_EN
+#error  "TFTPc_CFG_STAT_EN                     not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_STAT_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_STAT_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_STAT_EN               illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+#ifndef  TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX
+#error  "TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX      not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+
+#elif  ((TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX <   1u) || \
+        (TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX > 255u))
+#error  "TFTPc_CFG_SERVER_ERR_MSG_LEN_MAX illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+#endif
+
+
+#ifndef  TFTPc_CFG_RX_DUP_REACK_EN
+#error  "TFTPc_CFG_RX_DUP_REACK_EN             not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_RX_DUP_REACK_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_RX_DUP_REACK_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_RX_DUP_REACK_EN       illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_RX_DUP_REACK_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_RX_DUP_REACK_INTERVAL_MIN_ms
+#error  "TFTPc_CFG_RX_DUP_REACK_INTERVAL_MIN_ms not #define'd in 'tftp-c_cfg.h'"
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_SOCK_CONN_EN
+#error  "TFTPc_CFG_SOCK_CONN_EN                not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_SOCK_CONN_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_SOCK_CONN_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_SOCK_CONN_EN          illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+#ifndef  TFTPc_CFG_PROFILE_EN
+#error  "TFTPc_CFG_PROFILE_EN                  not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_PROFILE_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_PROFILE_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_PROFILE_EN            illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_PROFILE_EN == DEF_ENABLED) && \
+        (CPU_CFG_TS_32_EN     != DEF_ENABLED))
+#error  "TFTPc_CFG_PROFILE_EN            illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED when            "
+#error  "                                 CPU_CFG_TS_32_EN is DISABLED]          "
+#endif
+
+
+#ifndef  TFTPc_CFG_TX_RATE_LIMIT_EN
+#error  "TFTPc_CFG_TX_RATE_LIMIT_EN            not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_TX_RATE_LIMIT_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_TX_RATE_LIMIT_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_TX_RATE_LIMIT_EN      illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+#ifndef  TFTPc_CFG_BG_EN
+#error  "TFTPc_CFG_BG_EN                       not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_BG_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_BG_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_BG_EN                 illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_BG_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_BG_DLY_TARGET_ms
+#error  "TFTPc_CFG_BG_DLY_TARGET_ms            not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 65535]            "
+
+#elif   (TFTPc_CFG_BG_DLY_TARGET_ms > 65535u)
+#error  "TFTPc_CFG_BG_DLY_TARGET_ms      illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 65535]            "
+#endif
+
+#ifndef  TFTPc_CFG_BG_DLY_MAX_ms
+#error  "TFTPc_CFG_BG_DLY_MAX_ms               not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+
+#elif  ((TFTPc_CFG_BG_DLY_MAX_ms <     1u) || \
+        (TFTPc_CFG_BG_DLY_MAX_ms > 65535u))
+#error  "TFTPc_CFG_BG_DLY_MAX_ms         illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_PUT_EN
+#error  "TFTPc_CFG_PUT_EN                      not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_PUT_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_PUT_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_PUT_EN                illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+#ifndef  TFTPc_CFG_NETASCII_EN
+#error  "TFTPc_CFG_NETASCII_EN                 not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_NETASCII_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_NETASCII_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_NETASCII_EN           illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+#ifndef  TFTPc_CFG_IPv4_EN
+#error  "TFTPc_CFG_IPv4_EN                     not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_IPv4_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_IPv4_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_IPv4_EN               illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+#ifndef  TFTPc_CFG_IPv6_EN
+#error  "TFTPc_CFG_IPv6_EN                     not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_IPv6_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_IPv6_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_IPv6_EN               illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+
+#ifndef  TFTPc_CFG_CODEC_EN
+#error  "TFTPc_CFG_CODEC_EN                    not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_CODEC_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_CODEC_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_CODEC_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_CODEC_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_CODEC_BUF_SIZE
+#error  "TFTPc_CFG_CODEC_BUF_SIZE              not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  > 0]                         "
+
+#elif   (TFTPc_CFG_CODEC_BUF_SIZE < 1u)
+#error  "TFTPc_CFG_CODEC_BUF_SIZE        illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  > 0]                         "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_MCAST_EN
+#error  "TFTPc_CFG_MCAST_EN                    not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_MCAST_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_MCAST_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_MCAST_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_MCAST_EN == DEF_ENABLED)
+#if     (TFTPc_CFG_IPv4_EN  != DEF_ENABLED)
+#error  "TFTPc_CFG_MCAST_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED when            "
+#error  "                                 TFTPc_CFG_IPv4_EN is DISABLED]         "
+#endif
+
+#ifndef  NET_IGMP_MODULE_EN
+#error  "TFTPc_CFG_MCAST_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED when            "
+#error  "                                 IPv4 multicast rx is DISABLED]         "
+#endif
+
+#if     (NET_SOCK_CFG_SEL_EN != DEF_ENABLED)
+#error  "TFTPc_CFG_MCAST_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED when            "
+#error  "                                 NET_SOCK_CFG_SEL_EN is DISABLED]       "
+#endif
+
+#ifndef  TFTPc_CFG_MCAST_BLK_NBR_MAX
+#error  "TFTPc_CFG_MCAST_BLK_NBR_MAX           not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+
+#elif  ((TFTPc_CFG_MCAST_BLK_NBR_MAX < 1u) || \
+        (TFTPc_CFG_MCAST_BLK_NBR_MAX > 65535u))
+#error  "TFTPc_CFG_MCAST_BLK_NBR_MAX     illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+#endif
+
+#ifndef  TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX
+#error  "TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX   not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+
+#elif  ((TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX <   1u) || \
+        (TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX > 255u))
+#error  "TFTPc_CFG_MCAST_PASSIVE_TIMEOUT_MAX illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_FLASH_EN
+#error  "TFTPc_CFG_FLASH_EN                    not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_FLASH_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_FLASH_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_FLASH_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_FLASH_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_FLASH_PAGE_SIZE_MAX
+#error  "TFTPc_CFG_FLASH_PAGE_SIZE_MAX         not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+
+#elif  ((TFTPc_CFG_FLASH_PAGE_SIZE_MAX < 1u) || \
+        (TFTPc_CFG_FLASH_PAGE_SIZE_MAX > 65535u))
+#error  "TFTPc_CFG_FLASH_PAGE_SIZE_MAX   illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+#endif
+
+#ifndef  TFTPc_CFG_FLASH_ERASE_AHEAD_NBR
+#error  "TFTPc_CFG_FLASH_ERASE_AHEAD_NBR       not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0]                        "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_TAR_EN
+#error  "TFTPc_CFG_TAR_EN                      not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_TAR_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_TAR_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_TAR_EN                illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_TAR_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_TAR_PATH_LEN_MAX
+#error  "TFTPc_CFG_TAR_PATH_LEN_MAX            not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 1024]             "
+
+#elif  ((TFTPc_CFG_TAR_PATH_LEN_MAX <    1u) || \
+        (TFTPc_CFG_TAR_PATH_LEN_MAX > 1024u))
+#error  "TFTPc_CFG_TAR_PATH_LEN_MAX      illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 1024]             "
+#endif
+
+#ifndef  TFTPc_CFG_TAR_PATH_SEP_CHAR
+#error  "TFTPc_CFG_TAR_PATH_SEP_CHAR           not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  path separator character]    "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_SPARSE_EN
+#error  "TFTPc_CFG_SPARSE_EN                   not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_SPARSE_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_SPARSE_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_SPARSE_EN             illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+#endif
+
+
+#ifndef  TFTPc_CFG_RELAY_EN
+#error  "TFTPc_CFG_RELAY_EN                    not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_RELAY_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_RELAY_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_RELAY_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_RELAY_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_RELAY_CACHE_NBR
+#error  "TFTPc_CFG_RELAY_CACHE_NBR             not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+
+#elif  ((TFTPc_CFG_RELAY_CACHE_NBR <   1u) || \
+        (TFTPc_CFG_RELAY_CACHE_NBR > 255u))
+#error  "TFTPc_CFG_RELAY_CACHE_NBR       illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+#endif
+
+#ifndef  TFTPc_CFG_RELAY_NAME_LEN_MAX
+#error  "TFTPc_CFG_RELAY_NAME_LEN_MAX          not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+
+#elif  ((TFTPc_CFG_RELAY_NAME_LEN_MAX <   1u) || \
+        (TFTPc_CFG_RELAY_NAME_LEN_MAX > 255u))
+#error  "TFTPc_CFG_RELAY_NAME_LEN_MAX    illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+#endif
+
+#ifndef  TFTPc_CFG_RELAY_SRV_TIMEOUT_ms
+#error  "TFTPc_CFG_RELAY_SRV_TIMEOUT_ms        not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1]                        "
+
+#elif   (TFTPc_CFG_RELAY_SRV_TIMEOUT_ms < 1u)
+#error  "TFTPc_CFG_RELAY_SRV_TIMEOUT_ms  illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1]                        "
+#endif
+
+#ifndef  TFTPc_CFG_RELAY_SRV_RETRY_MAX
+#error  "TFTPc_CFG_RELAY_SRV_RETRY_MAX         not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 255]              "
+
+#elif   (TFTPc_CFG_RELAY_SRV_RETRY_MAX > 255u)
+#error  "TFTPc_CFG_RELAY_SRV_RETRY_MAX   illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 255]              "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_POOL_EN
+#error  "TFTPc_CFG_POOL_EN                     not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_POOL_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_POOL_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_POOL_EN               illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_POOL_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_POOL_NBR_MAX
+#error  "TFTPc_CFG_POOL_NBR_MAX                not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 32]               "
+
+#elif  ((TFTPc_CFG_POOL_NBR_MAX <  1u) || \
+        (TFTPc_CFG_POOL_NBR_MAX > 32u))
+#error  "TFTPc_CFG_POOL_NBR_MAX          illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 32]               "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_WIN_EN
+#error  "TFTPc_CFG_WIN_EN                      not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_WIN_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_WIN_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_WIN_EN                illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_WIN_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_WIN_SIZE_MAX
+#error  "TFTPc_CFG_WIN_SIZE_MAX                not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+
+#elif  ((TFTPc_CFG_WIN_SIZE_MAX <     1u) || \
+        (TFTPc_CFG_WIN_SIZE_MAX > 65535u))
+#error  "TFTPc_CFG_WIN_SIZE_MAX          illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+#endif
+
+#ifndef  TFTPc_CFG_WIN_REORDER_NBR
+#error  "TFTPc_CFG_WIN_REORDER_NBR             not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 128]              "
+#error  "                                [MUST be  0 or a power of 2]           "
+
+#elif  ((TFTPc_CFG_WIN_REORDER_NBR > 128u) || \
+       ((TFTPc_CFG_WIN_REORDER_NBR & (TFTPc_CFG_WIN_REORDER_NBR - 1u)) != 0u))
+#error  "TFTPc_CFG_WIN_REORDER_NBR       illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 128]              "
+#error  "                                [MUST be  0 or a power of 2]           "
+#endif
+
+#ifndef  TFTPc_CFG_WIN_ADAPT_EN
+#error  "TFTPc_CFG_WIN_ADAPT_EN                not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_WIN_ADAPT_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_WIN_ADAPT_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_WIN_ADAPT_EN          illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_WIN_ADAPT_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_WIN_ADAPT_SIZE_INIT
+#error  "TFTPc_CFG_WIN_ADAPT_SIZE_INIT         not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1                         "
+#error  "                                 && <= TFTPc_CFG_WIN_SIZE_MAX]         "
+
+#elif  ((TFTPc_CFG_WIN_ADAPT_SIZE_INIT <                      1u) || \
+        (TFTPc_CFG_WIN_ADAPT_SIZE_INIT > TFTPc_CFG_WIN_SIZE_MAX))
+#error  "TFTPc_CFG_WIN_ADAPT_SIZE_INIT   illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1                         "
+#error  "                                 && <= TFTPc_CFG_WIN_SIZE_MAX]         "
+#endif
+
+#ifndef  TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms
+#error  "TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms        not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+
+#elif  ((TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms <     1u) || \
+        (TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms > 65535u))
+#error  "TFTPc_CFG_WIN_ADAPT_DLY_MAX_ms  illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+#endif
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_BLKSIZE_EN
+#error  "TFTPc_CFG_BLKSIZE_EN                  not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_BLKSIZE_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_BLKSIZE_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_BLKSIZE_EN            illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_BLKSIZE_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_BLKSIZE_MAX
+#error  "TFTPc_CFG_BLKSIZE_MAX                 not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 512 && <= 65464]          "
+
+#elif  ((TFTPc_CFG_BLKSIZE_MAX <   512u) || \
+        (TFTPc_CFG_BLKSIZE_MAX > 65464u))
+#error  "TFTPc_CFG_BLKSIZE_MAX           illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 512 && <= 65464]          "
+#endif
+
+#ifndef  TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD
+#error  "TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD     not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 65535]            "
+
+#elif   (TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD > 65535u)
+#error  "TFTPc_CFG_BLKSIZE_TUNNEL_OVERHEAD illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0 && <= 65535]            "
+#endif
+
+#ifndef  TFTPc_CFG_BLKSIZE_PROBE_EN
+#error  "TFTPc_CFG_BLKSIZE_PROBE_EN            not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_BLKSIZE_PROBE_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_BLKSIZE_PROBE_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_BLKSIZE_PROBE_EN      illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_BLKSIZE_PROBE_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX
+#error  "TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX   not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+
+#elif  ((TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX <   1u) || \
+        (TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX > 255u))
+#error  "TFTPc_CFG_BLKSIZE_PROBE_TIMEOUT_MAX illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 255]              "
+#endif
+
+#ifndef  TFTPc_CFG_BLKSIZE_PROBE_INTERVAL
+#error  "TFTPc_CFG_BLKSIZE_PROBE_INTERVAL      not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+
+#elif  ((TFTPc_CFG_BLKSIZE_PROBE_INTERVAL <     1u) || \
+        (TFTPc_CFG_BLKSIZE_PROBE_INTERVAL > 65535u))
+#error  "TFTPc_CFG_BLKSIZE_PROBE_INTERVAL illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1 && <= 65535]            "
+#endif
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_ABORT_EN
+#error  "TFTPc_CFG_ABORT_EN                    not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_ABORT_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_ABORT_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_ABORT_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_ABORT_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_ABORT_POLL_ms
+#error  "TFTPc_CFG_ABORT_POLL_ms               not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1]                        "
+
+#elif   (TFTPc_CFG_ABORT_POLL_ms < 1u)
+#error  "TFTPc_CFG_ABORT_POLL_ms         illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1]                        "
+#endif
+#endif
+
+
+#ifndef  TFTPc_CFG_BACKOFF_EN
+#error  "TFTPc_CFG_BACKOFF_EN                  not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_BACKOFF_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_BACKOFF_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_BACKOFF_EN            illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_BACKOFF_EN == DEF_ENABLED)
+#ifndef  TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms
+#error  "TFTPc_CFG_BACKOFF_START_JITTER_MAX_ms not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0]                        "
+#endif
+
+#ifndef  TFTPc_CFG_BACKOFF_BASE_ms
+#error  "TFTPc_CFG_BACKOFF_BASE_ms             not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1]                        "
+
+#elif   (TFTPc_CFG_BACKOFF_BASE_ms < 1u)
+#error  "TFTPc_CFG_BACKOFF_BASE_ms       illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 1]                        "
+#endif
+
+#ifndef  TFTPc_CFG_BACKOFF_MAX_ms
+#error  "TFTPc_CFG_BACKOFF_MAX_ms              not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= TFTPc_CFG_BACKOFF_BASE_ms]"
+
+#elif   (TFTPc_CFG_BACKOFF_MAX_ms < TFTPc_CFG_BACKOFF_BASE_ms)
+#error  "TFTPc_CFG_BACKOFF_MAX_ms        illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= TFTPc_CFG_BACKOFF_BASE_ms]"
+#endif
+
+#ifndef  TFTPc_CFG_BACKOFF_REQ_RETRY_MAX
+#error  "TFTPc_CFG_BACKOFF_REQ_RETRY_MAX       not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 0]                        "
+#endif
+
+#ifndef  TFTPc_CFG_BACKOFF_ERR_CODE_MSK
+#error  "TFTPc_CFG_BACKOFF_ERR_CODE_MSK        not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  mask of ERROR codes 0..31]   "
+#endif
+#endif
+
+
+#if    ((TFTPc_CFG_IPv4_EN == DEF_DISABLED) && \
+        (TFTPc_CFG_IPv6_EN == DEF_DISABLED))
+#error  "TFTPc_CFG_IPv4_EN & TFTPc_CFG_IPv6_EN illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST enable at least one IP family]   "
+#endif
+
+
 /*
 *********************************************************************************************************
 *********************************************************************************************************
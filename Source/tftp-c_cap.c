@@ -0,0 +1,720 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      TFTP CLIENT PACKET CAPTURE RING
+*
+* Filename : tftp-c_cap.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The ring is written by a single task at a time : every caller of TFTPc_CapRecWr() runs
+*                from a TFTPc transfer, which holds the TFTPc lock.  No critical section is therefore
+*                required to record a pkt; readers rely on the record sequence number to detect records
+*                overwritten while being copied.
+*
+*            (2) The ring & the last sequence number are volatile, so that the compiler neither reorders
+*                the record writes with the sequence number writes, nor merges the sequence number reads
+*                of a reader with each other.  On a target with a weakly ordered memory, the readers
+*                that run on another core also require memory barriers.
+*
+*            (3) TFTPc_CapPcapExport() & TFTPc_CapPcapImport() only depend on uC/CPU & uC/LIB so that a
+*                dumped ring can be converted off target.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPc_CAP_MODULE
+#include  "tftp-c_cap.h"
+
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPc_CAP_PCAP_IP_PROTOCOL_UDP                   17u
+#define  TFTPc_CAP_PCAP_IP_TTL                            64u
+
+#define  TFTPc_CAP_PCAP_NBR_uS_PER_mS            (DEF_TIME_NBR_uS_PER_SEC / DEF_TIME_NBR_mS_PER_SEC)
+
+#define  TFTPc_CAP_PCAP_SNAP_LEN                 (TFTPc_CAP_PCAP_IPv6_HDR_LEN + \
+                                                  TFTPc_CAP_PCAP_UDP_HDR_LEN  + \
+                                                  TFTPc_CFG_CAP_SNAP_LEN)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+                                                                /* See Note #2.                                         */
+static  volatile  TFTPc_CAP_REC  TFTPc_CapRing[TFTPc_CFG_CAP_RING_NBR_PKT];
+
+static  volatile  CPU_INT32U     TFTPc_CapSeqNbrLast;           /* Seq nbr of last record wr'n (see Note #2).           */
+
+static  CPU_BOOLEAN         TFTPc_CapEn = DEF_ENABLED;
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPc_CapPcapIP_HdrLenGet (const  TFTPc_CAP_REC  *p_rec);
+
+static  CPU_SIZE_T  TFTPc_CapPcapRecWr        (const  TFTPc_CAP_REC  *p_rec,
+                                                      CPU_INT08U     *p_buf);
+
+static  CPU_INT16U  TFTPc_CapPcapChkSumCalc   (const  CPU_INT08U     *p_hdr,
+                                                      CPU_INT16U      hdr_len);
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_CapEnSet()
+*
+* Description : Start or stop recording pkts in the capture ring.
+*
+* Argument(s) : en      Indicates whether pkts are recorded :
+*
+*                           DEF_ENABLED     Pkts are recorded (default).
+*                           DEF_DISABLED    Pkts are NOT recorded; the ring content is kept.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) Stopping the capture freezes the ring, e.g. once a performance problem is detected, so
+*                   that the pkts leading to it are NOT overwritten before being dumped.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+void  TFTPc_CapEnSet (CPU_BOOLEAN  en)
+{
+    TFTPc_CapEn = en;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_CapRecWr()
+*
+* Description : Record a pkt in the capture ring.
+*
+* Argument(s) : dir             Pkt direction (TFTPc_CAP_DIR_xxx).
+*
+*               session_id      Transfer session ID.
+*
+*               ts_ms           Timestamp (ms).
+*
+*               addr_family     Remote addr family (TFTPc_CAP_ADDR_FAMILY_xxx).
+*
+*               p_addr          Pointer to remote addr, in network order.
+*
+*               port            Remote port.
+*
+*               p_pkt           Pointer to TFTP pkt.
+*
+*               pkt_len         Length of  TFTP pkt (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_CapPktWr().
+*
+* Note(s)     : (1) See 'tftp-c_cap.c  Note #1'.
+*
+*               (2) The sequence number is cleared before the record is modified & set again once the
+*                   record is complete (see 'tftp-c_cap.h  TFTPc CAPTURE RECORD DATA TYPE  Note #1').
+*
+*               (3) Sequence number zero is reserved for never written records.
+*
+*               (4) The ring is volatile (see 'tftp-c_cap.c  Note #2') : the record is written between the
+*                   two sequence number writes, in program order.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+void  TFTPc_CapRecWr (       CPU_INT08U   dir,
+                             CPU_INT16U   session_id,
+                             CPU_INT32U   ts_ms,
+                             CPU_INT08U   addr_family,
+                      const  CPU_INT08U  *p_addr,
+                             CPU_INT16U   port,
+                      const  void        *p_pkt,
+                             CPU_INT16U   pkt_len)
+{
+    volatile  TFTPc_CAP_REC  *p_rec;
+              CPU_INT32U      seq_nbr;
+              CPU_SIZE_T      addr_len;
+
+
+    if (TFTPc_CapEn != DEF_ENABLED) {
+        return;
+    }
+
+    seq_nbr = TFTPc_CapSeqNbrLast + 1u;
+    if (seq_nbr == 0u) {                                        /* See Note #3.                                         */
+        seq_nbr = 1u;
+    }
+
+    p_rec         = &TFTPc_CapRing[seq_nbr & (TFTPc_CFG_CAP_RING_NBR_PKT - 1u)];
+    p_rec->SeqNbr =  0u;                                        /* See Notes #2 & #4.                                   */
+
+    addr_len = (addr_family == TFTPc_CAP_ADDR_FAMILY_IPv6) ? TFTPc_CAP_ADDR_LEN_MAX : 4u;
+    Mem_Clr((void *)&p_rec->AddrRemote[0], sizeof(p_rec->AddrRemote));
+    if (p_addr != DEF_NULL) {
+        Mem_Copy((void *)&p_rec->AddrRemote[0], p_addr, addr_len);
+    }
+
+    p_rec->TS_ms      = ts_ms;
+    p_rec->SessionID  = session_id;
+    p_rec->Dir        = dir;
+    p_rec->AddrFamily = addr_family;
+    p_rec->PortRemote = port;
+    p_rec->PktLen     = pkt_len;
+    p_rec->CapLen     = DEF_MIN(pkt_len, TFTPc_CFG_CAP_SNAP_LEN);
+    Mem_Copy((void *)&p_rec->Data[0], p_pkt, p_rec->CapLen);
+
+    p_rec->SeqNbr       = seq_nbr;
+    TFTPc_CapSeqNbrLast = seq_nbr;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_CapDump()
+*
+* Description : Copy the content of the capture ring, oldest record first.
+*
+* Argument(s) : p_recs          Pointer to array that will receive the records.
+*
+*               nbr_recs_max    Size of 'p_recs' array (in records).
+*
+* Return(s)   : Number of records copied.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) If 'p_recs' is too small to hold the whole ring, the most recent records are copied.
+*
+*               (2) The ring may be written while being dumped.  Records overwritten during the copy are
+*                   skipped (see 'tftp-c_cap.h  TFTPc CAPTURE RECORD DATA TYPE  Note #1').  Since the ring
+*                   is volatile (see 'tftp-c_cap.c  Note #2'), the sequence number is actually read again
+*                   after the copy.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+CPU_INT16U  TFTPc_CapDump (TFTPc_CAP_REC  *p_recs,
+                           CPU_INT16U      nbr_recs_max)
+{
+    volatile  TFTPc_CAP_REC  *p_rec;
+              CPU_INT32U      seq_nbr_last;
+              CPU_INT32U      seq_nbr;
+              CPU_INT32U      nbr_recs;
+              CPU_INT16U      nbr_copied;
+
+
+    if ((p_recs       == DEF_NULL) ||
+        (nbr_recs_max == 0u)) {
+        return (0u);
+    }
+
+    seq_nbr_last = TFTPc_CapSeqNbrLast;
+    nbr_recs     = DEF_MIN(seq_nbr_last, TFTPc_CFG_CAP_RING_NBR_PKT);
+    nbr_recs     = DEF_MIN(nbr_recs,     nbr_recs_max);         /* See Note #1.                                         */
+
+    seq_nbr      = seq_nbr_last - nbr_recs + 1u;
+    nbr_copied   = 0u;
+    while (nbr_recs > 0u) {
+        p_rec = &TFTPc_CapRing[seq_nbr & (TFTPc_CFG_CAP_RING_NBR_PKT - 1u)];
+        if (p_rec->SeqNbr == seq_nbr) {
+            p_recs[nbr_copied] = *p_rec;
+            if (p_rec->SeqNbr == seq_nbr) {                     /* See Note #2.                                         */
+                nbr_copied++;
+            }
+        }
+        seq_nbr++;
+        nbr_recs--;
+    }
+
+    return (nbr_copied);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_CapClr()
+*
+* Description : Discard every record of the capture ring.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) MUST NOT be called while a transfer is in progress.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+void  TFTPc_CapClr (void)
+{
+    Mem_Clr((void *)&TFTPc_CapRing[0], sizeof(TFTPc_CapRing));
+    TFTPc_CapSeqNbrLast = 0u;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_CapPcapExport()
+*
+* Description : Convert capture records to a pcap file.
+*
+* Argument(s) : p_recs      Pointer to records to convert (e.g. dumped with TFTPc_CapDump()).
+*
+*               nbr_recs    Number of records to convert.
+*
+*               p_buf       Pointer to buffer that will receive the pcap file, or NULL to get the size of
+*                           the file only.
+*
+*               buf_len     Size of 'p_buf' buffer (in octets).
+*
+* Return(s)   : Size of the pcap file (in octets), if NO error.
+*
+*               0,                                otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) See 'tftp-c_cap.c  Note #3'.
+*
+*               (2) See 'tftp-c_cap.h  TFTPc PCAP FORMAT DEFINES' for the format of the file.
+*********************************************************************************************************
+*/
+
+CPU_SIZE_T  TFTPc_CapPcapExport (const  TFTPc_CAP_REC  *p_recs,
+                                        CPU_INT16U      nbr_recs,
+                                        CPU_INT08U     *p_buf,
+                                        CPU_SIZE_T      buf_len)
+{
+    CPU_SIZE_T  file_len;
+    CPU_SIZE_T  ix;
+    CPU_INT16U  rec_ix;
+
+
+    if ((p_recs   == DEF_NULL) &&
+        (nbr_recs >  0u)) {
+        return (0u);
+    }
+
+    file_len = TFTPc_CAP_PCAP_HDR_LEN;                          /* ---------------- COMPUTE FILE LEN ------------------ */
+    for (rec_ix = 0u; rec_ix < nbr_recs; rec_ix++) {
+        file_len += TFTPc_CAP_PCAP_REC_HDR_LEN
+                 +  TFTPc_CapPcapIP_HdrLenGet(&p_recs[rec_ix])
+                 +  TFTPc_CAP_PCAP_UDP_HDR_LEN
+                 +  p_recs[rec_ix].CapLen;
+    }
+
+    if (p_buf == DEF_NULL) {
+        return (file_len);
+    }
+
+    if (buf_len < file_len) {
+        return (0u);
+    }
+                                                                /* ------------------ WR GLOBAL HDR ------------------- */
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[0],  TFTPc_CAP_PCAP_MAGIC);
+    MEM_VAL_SET_INT16U_LITTLE(&p_buf[4],  TFTPc_CAP_PCAP_VER_MAJOR);
+    MEM_VAL_SET_INT16U_LITTLE(&p_buf[6],  TFTPc_CAP_PCAP_VER_MINOR);
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[8],  0u);                  /* Time zone offset.                                    */
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[12], 0u);                  /* Timestamp accuracy.                                  */
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[16], TFTPc_CAP_PCAP_SNAP_LEN);
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[20], TFTPc_CAP_PCAP_LINKTYPE_RAW);
+
+    ix = TFTPc_CAP_PCAP_HDR_LEN;                                /* -------------------- WR RECORDS -------------------- */
+    for (rec_ix = 0u; rec_ix < nbr_recs; rec_ix++) {
+        ix += TFTPc_CapPcapRecWr(&p_recs[rec_ix], &p_buf[ix]);
+    }
+
+    return (file_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_CapPcapImport()
+*
+* Description : Convert a pcap file to capture records.
+*
+* Argument(s) : p_buf           Pointer to pcap file.
+*
+*               buf_len         Size of pcap file (in octets).
+*
+*               p_recs          Pointer to array that will receive the records.
+*
+*               nbr_recs_max    Size of 'p_recs' array (in records).
+*
+* Return(s)   : Number of records converted.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) See 'tftp-c_cap.c  Note #3'.
+*
+*               (2) Only files in the format written by TFTPc_CapPcapExport() are supported (see
+*                   'tftp-c_cap.h  TFTPc PCAP FORMAT DEFINES').  Pkts other than UDP are skipped.
+*
+*               (3) A pkt whose source address is zero was tx'd by the client (see 'tftp-c_cap.h  TFTPc
+*                   PCAP FORMAT DEFINES  Note #1a'); any other pkt was rx'd by the client.
+*
+*               (4) Octets recorded beyond TFTPc_CFG_CAP_SNAP_LEN are discarded.
+*********************************************************************************************************
+*/
+
+CPU_INT16U  TFTPc_CapPcapImport (const  CPU_INT08U     *p_buf,
+                                        CPU_SIZE_T      buf_len,
+                                        TFTPc_CAP_REC  *p_recs,
+                                        CPU_INT16U      nbr_recs_max)
+{
+           TFTPc_CAP_REC  *p_rec;
+    const  CPU_INT08U     *p_pkt;
+    const  CPU_INT08U     *p_udp;
+    const  CPU_INT08U     *p_addr_src;
+    const  CPU_INT08U     *p_addr_dst;
+           CPU_SIZE_T      ix;
+           CPU_INT32U      ts_sec;
+           CPU_INT32U      ts_usec;
+           CPU_INT32U      incl_len;
+           CPU_INT32U      cap_len;
+           CPU_INT16U      ip_hdr_len;
+           CPU_INT16U      udp_len;
+           CPU_INT16U      addr_len;
+           CPU_INT16U      addr_ix;
+           CPU_INT16U      session_id;
+           CPU_INT08U      addr_family;
+           CPU_BOOLEAN     tx;
+           CPU_INT16U      nbr_recs;
+
+
+    if ((p_buf        == DEF_NULL)               ||
+        (p_recs       == DEF_NULL)               ||
+        (nbr_recs_max == 0u)                     ||
+        (buf_len      <  TFTPc_CAP_PCAP_HDR_LEN)) {
+        return (0u);
+    }
+                                                                /* ------------------ CHK GLOBAL HDR ------------------ */
+    if ((MEM_VAL_GET_INT32U_LITTLE(&p_buf[0])  != TFTPc_CAP_PCAP_MAGIC) ||
+        (MEM_VAL_GET_INT32U_LITTLE(&p_buf[20]) != TFTPc_CAP_PCAP_LINKTYPE_RAW)) {
+        return (0u);                                            /* See Note #2.                                         */
+    }
+
+    ix       = TFTPc_CAP_PCAP_HDR_LEN;
+    nbr_recs = 0u;
+    while ((nbr_recs                        < nbr_recs_max) &&
+           (ix + TFTPc_CAP_PCAP_REC_HDR_LEN <= buf_len)) {
+                                                                /* ------------------ RD RECORD HDR ------------------- */
+        ts_sec   = MEM_VAL_GET_INT32U_LITTLE(&p_buf[ix]);
+        ts_usec  = MEM_VAL_GET_INT32U_LITTLE(&p_buf[ix + 4u]);
+        incl_len = MEM_VAL_GET_INT32U_LITTLE(&p_buf[ix + 8u]);
+        ix      += TFTPc_CAP_PCAP_REC_HDR_LEN;
+        if (incl_len > buf_len - ix) {                          /* Truncated file.                                      */
+            break;
+        }
+        p_pkt    = &p_buf[ix];
+        ix      += incl_len;
+                                                                /* ---------------- PARSE IP & UDP HDR ---------------- */
+        if (incl_len < 1u) {
+            continue;
+        }
+        switch (p_pkt[0] >> 4u) {
+            case TFTPc_CAP_ADDR_FAMILY_IPv4:
+                 ip_hdr_len  = (CPU_INT16U)(p_pkt[0] & 0x0Fu) * 4u;
+                 if ((ip_hdr_len <  TFTPc_CAP_PCAP_IPv4_HDR_LEN) ||
+                     (incl_len   <  (CPU_INT32U)ip_hdr_len + TFTPc_CAP_PCAP_UDP_HDR_LEN) ||
+                     (p_pkt[9]   != TFTPc_CAP_PCAP_IP_PROTOCOL_UDP)) {
+                     continue;
+                 }
+                 addr_family = TFTPc_CAP_ADDR_FAMILY_IPv4;
+                 addr_len    = 4u;
+                 p_addr_src  = &p_pkt[12];
+                 p_addr_dst  = &p_pkt[16];
+                 session_id  = MEM_VAL_GET_INT16U_BIG(&p_pkt[4]);
+                 break;
+
+            case TFTPc_CAP_ADDR_FAMILY_IPv6:
+                 ip_hdr_len  = TFTPc_CAP_PCAP_IPv6_HDR_LEN;
+                 if ((incl_len <  (CPU_INT32U)ip_hdr_len + TFTPc_CAP_PCAP_UDP_HDR_LEN) ||
+                     (p_pkt[6] != TFTPc_CAP_PCAP_IP_PROTOCOL_UDP)) {
+                     continue;
+                 }
+                 addr_family = TFTPc_CAP_ADDR_FAMILY_IPv6;
+                 addr_len    = TFTPc_CAP_ADDR_LEN_MAX;
+                 p_addr_src  = &p_pkt[8];
+                 p_addr_dst  = &p_pkt[24];
+                 session_id  = MEM_VAL_GET_INT16U_BIG(&p_pkt[2]);
+                 break;
+
+            default:
+                 continue;
+        }
+
+        p_udp   = &p_pkt[ip_hdr_len];
+        udp_len =  MEM_VAL_GET_INT16U_BIG(&p_udp[4]);
+        if (udp_len < TFTPc_CAP_PCAP_UDP_HDR_LEN) {
+            continue;
+        }
+
+        tx = DEF_YES;                                           /* See Note #3.                                         */
+        for (addr_ix = 0u; addr_ix < addr_len; addr_ix++) {
+            if (p_addr_src[addr_ix] != 0u) {
+                tx = DEF_NO;
+                break;
+            }
+        }
+                                                                /* -------------------- WR RECORD --------------------- */
+        p_rec = &p_recs[nbr_recs];
+        Mem_Clr(p_rec, sizeof(TFTPc_CAP_REC));
+
+        nbr_recs++;
+        p_rec->SeqNbr     = nbr_recs;
+        p_rec->TS_ms      = (ts_sec * DEF_TIME_NBR_mS_PER_SEC) + (ts_usec / TFTPc_CAP_PCAP_NBR_uS_PER_mS);
+        p_rec->SessionID  = session_id;
+        p_rec->AddrFamily = addr_family;
+        if (tx == DEF_YES) {
+            p_rec->Dir        = TFTPc_CAP_DIR_TX;
+            p_rec->PortRemote = MEM_VAL_GET_INT16U_BIG(&p_udp[2]);
+            Mem_Copy(&p_rec->AddrRemote[0], p_addr_dst, addr_len);
+        } else {
+            p_rec->Dir        = TFTPc_CAP_DIR_RX;
+            p_rec->PortRemote = MEM_VAL_GET_INT16U_BIG(&p_udp[0]);
+            Mem_Copy(&p_rec->AddrRemote[0], p_addr_src, addr_len);
+        }
+        p_rec->PktLen = udp_len - TFTPc_CAP_PCAP_UDP_HDR_LEN;
+        cap_len       = incl_len - ip_hdr_len - TFTPc_CAP_PCAP_UDP_HDR_LEN;
+        cap_len       = DEF_MIN(cap_len, p_rec->PktLen);
+        cap_len       = DEF_MIN(cap_len, TFTPc_CFG_CAP_SNAP_LEN);   /* See Note #4.                                     */
+        p_rec->CapLen = (CPU_INT16U)cap_len;
+        Mem_Copy(&p_rec->Data[0], &p_udp[TFTPc_CAP_PCAP_UDP_HDR_LEN], p_rec->CapLen);
+    }
+
+    return (nbr_recs);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                     TFTPc_CapPcapIP_HdrLenGet()
+*
+* Description : Get the length of the IP header synthesized for a record.
+*
+* Argument(s) : p_rec       Pointer to record.
+*
+* Return(s)   : Length of IP header (in octets).
+*
+* Caller(s)   : TFTPc_CapPcapExport(),
+*               TFTPc_CapPcapRecWr().
+*
+* Note(s)     : (1) Records of unknown address family are exported as IPv4 pkts.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPc_CapPcapIP_HdrLenGet (const  TFTPc_CAP_REC  *p_rec)
+{
+    if (p_rec->AddrFamily == TFTPc_CAP_ADDR_FAMILY_IPv6) {
+        return (TFTPc_CAP_PCAP_IPv6_HDR_LEN);
+    }
+
+    return (TFTPc_CAP_PCAP_IPv4_HDR_LEN);                       /* See Note #1.                                         */
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_CapPcapRecWr()
+*
+* Description : Write a record, with its synthesized IP & UDP headers, to a pcap file.
+*
+* Argument(s) : p_rec       Pointer to record.
+*
+*               p_buf       Pointer to buffer that will receive the pcap record.
+*
+* Return(s)   : Number of octets written.
+*
+* Caller(s)   : TFTPc_CapPcapExport().
+*
+* Note(s)     : (1) See 'tftp-c_cap.h  TFTPc PCAP FORMAT DEFINES  Note #1'.
+*********************************************************************************************************
+*/
+
+static  CPU_SIZE_T  TFTPc_CapPcapRecWr (const  TFTPc_CAP_REC  *p_rec,
+                                               CPU_INT08U     *p_buf)
+{
+    CPU_INT08U  *p_ip;
+    CPU_INT08U  *p_udp;
+    CPU_INT08U  *p_addr_src;
+    CPU_INT08U  *p_addr_dst;
+    CPU_INT16U   ip_hdr_len;
+    CPU_INT16U   addr_len;
+    CPU_INT16U   udp_len;
+    CPU_INT16U   port_src;
+    CPU_INT16U   port_dst;
+    CPU_INT16U   chk_sum;
+
+
+    ip_hdr_len = TFTPc_CapPcapIP_HdrLenGet(p_rec);
+    udp_len    = TFTPc_CAP_PCAP_UDP_HDR_LEN + p_rec->PktLen;
+                                                                /* ------------------ WR RECORD HDR ------------------- */
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[0],   p_rec->TS_ms / DEF_TIME_NBR_mS_PER_SEC);
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[4],  (p_rec->TS_ms % DEF_TIME_NBR_mS_PER_SEC) * TFTPc_CAP_PCAP_NBR_uS_PER_mS);
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[8],  (CPU_INT32U)ip_hdr_len + TFTPc_CAP_PCAP_UDP_HDR_LEN + p_rec->CapLen);
+    MEM_VAL_SET_INT32U_LITTLE(&p_buf[12], (CPU_INT32U)ip_hdr_len + udp_len);
+
+    p_ip  = &p_buf[TFTPc_CAP_PCAP_REC_HDR_LEN];
+    p_udp = &p_ip[ip_hdr_len];
+    Mem_Clr(p_ip, ip_hdr_len);
+                                                                /* --------------------- WR IP HDR -------------------- */
+    if (ip_hdr_len == TFTPc_CAP_PCAP_IPv6_HDR_LEN) {
+        addr_len   = TFTPc_CAP_ADDR_LEN_MAX;
+        p_ip[0]    = 0x60u;                                     /* Version 6.                                           */
+        MEM_VAL_SET_INT16U_BIG(&p_ip[2], p_rec->SessionID);     /* Flow label.                                          */
+        MEM_VAL_SET_INT16U_BIG(&p_ip[4], udp_len);              /* Payload len.                                         */
+        p_ip[6]    = TFTPc_CAP_PCAP_IP_PROTOCOL_UDP;
+        p_ip[7]    = TFTPc_CAP_PCAP_IP_TTL;
+        p_addr_src = &p_ip[8];
+        p_addr_dst = &p_ip[24];
+    } else {
+        addr_len   = 4u;
+        p_ip[0]    = 0x45u;                                     /* Version 4, hdr len 5 words.                          */
+        MEM_VAL_SET_INT16U_BIG(&p_ip[2], ip_hdr_len + udp_len); /* Total len.                                           */
+        MEM_VAL_SET_INT16U_BIG(&p_ip[4], p_rec->SessionID);     /* Identification.                                      */
+        p_ip[8]    = TFTPc_CAP_PCAP_IP_TTL;
+        p_ip[9]    = TFTPc_CAP_PCAP_IP_PROTOCOL_UDP;
+        p_addr_src = &p_ip[12];
+        p_addr_dst = &p_ip[16];
+    }
+
+    if (p_rec->Dir == TFTPc_CAP_DIR_TX) {
+        Mem_Copy(p_addr_dst, &p_rec->AddrRemote[0], addr_len);
+        port_src = TFTPc_CAP_PCAP_PORT_LOCAL;
+        port_dst = p_rec->PortRemote;
+    } else {
+        Mem_Copy(p_addr_src, &p_rec->AddrRemote[0], addr_len);
+        port_src = p_rec->PortRemote;
+        port_dst = TFTPc_CAP_PCAP_PORT_LOCAL;
+    }
+
+    if (ip_hdr_len == TFTPc_CAP_PCAP_IPv4_HDR_LEN) {
+        chk_sum = TFTPc_CapPcapChkSumCalc(p_ip, ip_hdr_len);
+        MEM_VAL_SET_INT16U_BIG(&p_ip[10], chk_sum);
+    }
+                                                                /* -------------------- WR UDP HDR -------------------- */
+    MEM_VAL_SET_INT16U_BIG(&p_udp[0], port_src);
+    MEM_VAL_SET_INT16U_BIG(&p_udp[2], port_dst);
+    MEM_VAL_SET_INT16U_BIG(&p_udp[4], udp_len);
+    MEM_VAL_SET_INT16U_BIG(&p_udp[6], 0u);                      /* Chk sum NOT computed.                                */
+
+    Mem_Copy(&p_udp[TFTPc_CAP_PCAP_UDP_HDR_LEN], &p_rec->Data[0], p_rec->CapLen);
+
+    return (TFTPc_CAP_PCAP_REC_HDR_LEN + ip_hdr_len + TFTPc_CAP_PCAP_UDP_HDR_LEN + p_rec->CapLen);
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_CapPcapChkSumCalc()
+*
+* Description : Compute the checksum of an IPv4 header.
+*
+* Argument(s) : p_hdr       Pointer to IPv4 header, with a zero checksum field.
+*
+*               hdr_len     Length of  IPv4 header (in octets).
+*
+* Return(s)   : Header checksum (one's complement of the one's complement sum of the header words).
+*
+* Caller(s)   : TFTPc_CapPcapRecWr().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPc_CapPcapChkSumCalc (const  CPU_INT08U  *p_hdr,
+                                                    CPU_INT16U   hdr_len)
+{
+    CPU_INT32U  sum;
+    CPU_INT16U  ix;
+
+
+    sum = 0u;
+    for (ix = 0u; ix < hdr_len; ix += 2u) {
+        sum += MEM_VAL_GET_INT16U_BIG(&p_hdr[ix]);
+    }
+
+    while ((sum >> 16u) != 0u) {
+        sum = (sum & DEF_INT_16U_MAX_VAL) + (sum >> 16u);
+    }
+
+    return ((CPU_INT16U)~sum);
+}
@@ -0,0 +1,255 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      TFTP CLIENT PACKET CAPTURE RING
+*
+* Filename : tftp-c_cap.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The capture ring records the pkts rx'd & tx'd by the TFTPc transfer path, with a timestamp
+*                & the remote address.  The ring content can be dumped & converted to a pcap file with
+*                TFTPc_CapPcapExport(), either on target or on a host, to be analyzed with the usual
+*                network tools.
+*
+*            (2) A pcap file is converted back to capture records with TFTPc_CapPcapImport().  The host
+*                replay tool ('Host/Tools/tftpc_replay.c') plays the remote side of the records on the
+*                simulated network, against the unmodified client, & reports the pkts tx'd by the client
+*                that diverge from the capture.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CAP_MODULE_PRESENT
+#define  TFTPc_CAP_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <lib_def.h>
+
+#include  <tftp-c_cfg.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                     TFTPc CAPTURE RECORD DEFINES
+*********************************************************************************************************
+*/
+
+#define  TFTPc_CAP_DIR_RX                                  1u   /* Pkt rx'd from the remote host.                       */
+#define  TFTPc_CAP_DIR_TX                                  2u   /* Pkt tx'd to   the remote host.                       */
+
+#define  TFTPc_CAP_ADDR_FAMILY_NONE                        0u
+#define  TFTPc_CAP_ADDR_FAMILY_IPv4                        4u
+#define  TFTPc_CAP_ADDR_FAMILY_IPv6                        6u
+
+#define  TFTPc_CAP_ADDR_LEN_MAX                           16u
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc PCAP FORMAT DEFINES
+*
+* Note(s) : (1) Exported pcap files use the original little-endian pcap format (magic 0xA1B2C3D4, version
+*               2.4) with link type LINKTYPE_RAW : each pkt is preceded by synthesized IP & UDP headers.
+*
+*               (a) The local address is NOT known by the capture ring & is set to zero (0.0.0.0 or ::).
+*                   The local port is set to TFTPc_CAP_PCAP_PORT_LOCAL.
+*
+*               (b) The session ID is stored in the IPv4 identification field or in the IPv6 flow label.
+*
+*               (c) The UDP checksum is NOT computed (zero).
+*
+*           (2) Size of an exported pcap file :
+*
+*                   TFTPc_CAP_PCAP_HDR_LEN + (nbr of pkts * (TFTPc_CAP_PCAP_REC_HDR_LEN + IP & UDP hdrs len +
+*                                                            nbr of octets recorded per pkt))
+*
+*               TFTPc_CapPcapExport() returns the exact size when called without a buffer.
+*********************************************************************************************************
+*/
+
+#define  TFTPc_CAP_PCAP_MAGIC                     0xA1B2C3D4u
+#define  TFTPc_CAP_PCAP_VER_MAJOR                          2u
+#define  TFTPc_CAP_PCAP_VER_MINOR                          4u
+#define  TFTPc_CAP_PCAP_LINKTYPE_RAW                     101u
+
+#define  TFTPc_CAP_PCAP_HDR_LEN                           24u
+#define  TFTPc_CAP_PCAP_REC_HDR_LEN                       16u
+
+#define  TFTPc_CAP_PCAP_IPv4_HDR_LEN                      20u
+#define  TFTPc_CAP_PCAP_IPv6_HDR_LEN                      40u
+#define  TFTPc_CAP_PCAP_UDP_HDR_LEN                        8u
+
+#define  TFTPc_CAP_PCAP_PORT_LOCAL                     49152u   /* See Note #1a.                                        */
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                   TFTPc CAPTURE RECORD DATA TYPE
+*
+* Note(s) : (1) 'SeqNbr' is written last by TFTPc_CapRecWr().  A record whose 'SeqNbr' is zero was never
+*               written; a reader that finds 'SeqNbr' changed after copying a record MUST discard the copy
+*               since it was overwritten while being read.
+*
+*           (2) 'AddrRemote' holds the remote IP address in network order (4 octets for IPv4, 16 for IPv6).
+*
+*           (3) 'PktLen' is the length of the TFTP pkt; 'CapLen' is the number of octets recorded in 'Data',
+*               at most TFTPc_CFG_CAP_SNAP_LEN.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_cap_rec {
+    CPU_INT32U  SeqNbr;                                         /* Record seq nbr (see Note #1).                        */
+    CPU_INT32U  TS_ms;                                          /* Timestamp (ms).                                      */
+    CPU_INT16U  SessionID;                                      /* Transfer session the pkt belongs to.                 */
+    CPU_INT08U  Dir;                                            /* Pkt direction (TFTPc_CAP_DIR_xxx).                   */
+    CPU_INT08U  AddrFamily;                                     /* Remote addr family (TFTPc_CAP_ADDR_FAMILY_xxx).      */
+    CPU_INT08U  AddrRemote[TFTPc_CAP_ADDR_LEN_MAX];             /* Remote addr (see Note #2).                           */
+    CPU_INT16U  PortRemote;                                     /* Remote port.                                         */
+    CPU_INT16U  PktLen;                                         /* Pkt len      (see Note #3).                          */
+    CPU_INT16U  CapLen;                                         /* Recorded len (see Note #3).                          */
+    CPU_INT08U  Data[TFTPc_CFG_CAP_SNAP_LEN];                   /* Recorded pkt octets.                                 */
+} TFTPc_CAP_REC;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+void         TFTPc_CapEnSet      (       CPU_BOOLEAN     en);
+
+void         TFTPc_CapRecWr      (       CPU_INT08U      dir,
+                                         CPU_INT16U      session_id,
+                                         CPU_INT32U      ts_ms,
+                                         CPU_INT08U      addr_family,
+                                  const  CPU_INT08U     *p_addr,
+                                         CPU_INT16U      port,
+                                  const  void           *p_pkt,
+                                         CPU_INT16U      pkt_len);
+
+CPU_INT16U   TFTPc_CapDump       (       TFTPc_CAP_REC  *p_recs,
+                                         CPU_INT16U      nbr_recs_max);
+
+void         TFTPc_CapClr        (void);
+#endif
+
+                                                                /* Pcap conversion avail even if ring DISABLED.         */
+CPU_SIZE_T   TFTPc_CapPcapExport (const  TFTPc_CAP_REC  *p_recs,
+                                         CPU_INT16U      nbr_recs,
+                                         CPU_INT08U     *p_buf,
+                                         CPU_SIZE_T      buf_len);
+
+CPU_INT16U   TFTPc_CapPcapImport (const  CPU_INT08U     *p_buf,
+                                         CPU_SIZE_T      buf_len,
+                                         TFTPc_CAP_REC  *p_recs,
+                                         CPU_INT16U      nbr_recs_max);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                        CONFIGURATION ERRORS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CFG_CAP_EN
+#error  "TFTPc_CFG_CAP_EN                      not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_CAP_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_CAP_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_CAP_EN                illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_CAP_EN == DEF_ENABLED)
+
+#ifndef  TFTPc_CFG_CAP_RING_NBR_PKT
+#error  "TFTPc_CFG_CAP_RING_NBR_PKT            not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  power of 2 >= 2]             "
+
+#elif  ((TFTPc_CFG_CAP_RING_NBR_PKT < 2u) || \
+       ((TFTPc_CFG_CAP_RING_NBR_PKT & (TFTPc_CFG_CAP_RING_NBR_PKT - 1u)) != 0u))
+#error  "TFTPc_CFG_CAP_RING_NBR_PKT      illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  power of 2 >= 2]             "
+#endif
+
+#endif
+
+
+#ifndef  TFTPc_CFG_CAP_SNAP_LEN
+#error  "TFTPc_CFG_CAP_SNAP_LEN                not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 4 && <= 65535]            "
+
+#elif  ((TFTPc_CFG_CAP_SNAP_LEN <     4u) || \
+        (TFTPc_CFG_CAP_SNAP_LEN > 65535u))
+#error  "TFTPc_CFG_CAP_SNAP_LEN          illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 4 && <= 65535]            "
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPc_CAP_MODULE_PRESENT  */
@@ -0,0 +1,855 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      TFTP CLIENT DELTA UPDATE CODEC
+*
+* Filename : tftp-c_delta.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The codec functions are called by the TFTPc transfer path, which holds the TFTPc lock : the
+*                delta context is never accessed concurrently.
+*
+*            (2) The SHA-256 functions only depend on uC/CPU & uC/LIB so that host tools compute the digest
+*                of the target files with the same code (see 'Host/Tools/tftpc_delta.c').
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPc_DELTA_MODULE
+#include  "tftp-c_delta.h"
+
+#include  <Source/net_util.h>
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_DELTA_EN == DEF_ENABLED)
+
+#define  TFTPc_DELTA_STATE_HDR                             0u   /* Rx'ing patch hdr.                                    */
+#define  TFTPc_DELTA_STATE_CMD                             1u   /* Waiting for next cmd.                                */
+#define  TFTPc_DELTA_STATE_ARG                             2u   /* Rx'ing cmd args.                                     */
+#define  TFTPc_DELTA_STATE_COPY                            3u   /* Copying base file data.                              */
+#define  TFTPc_DELTA_STATE_ADD                             4u   /* Copying patch data.                                  */
+#define  TFTPc_DELTA_STATE_END                             5u   /* END cmd rx'd & rebuilt file verified.                */
+
+#define  TFTPc_DELTA_SHA256_LEN_FIELD_LEN                  8u   /* Len of msg len field in the last blk.                */
+
+#define  TFTPc_DELTA_ROTR(val, nbr)               (((val) >> (nbr)) | ((val) << (32u - (nbr))))
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+                                                                /* SHA-256 round constants (FIPS 180-4 sec 4.2.2).      */
+static  const  CPU_INT32U  TFTPc_DeltaSHA256_K[64] = {
+    0x428A2F98u, 0x71374491u, 0xB5C0FBCFu, 0xE9B5DBA5u, 0x3956C25Bu, 0x59F111F1u, 0x923F82A4u, 0xAB1C5ED5u,
+    0xD807AA98u, 0x12835B01u, 0x243185BEu, 0x550C7DC3u, 0x72BE5D74u, 0x80DEB1FEu, 0x9BDC06A7u, 0xC19BF174u,
+    0xE49B69C1u, 0xEFBE4786u, 0x0FC19DC6u, 0x240CA1CCu, 0x2DE92C6Fu, 0x4A7484AAu, 0x5CB0A9DCu, 0x76F988DAu,
+    0x983E5152u, 0xA831C66Du, 0xB00327C8u, 0xBF597FC7u, 0xC6E00BF3u, 0xD5A79147u, 0x06CA6351u, 0x14292967u,
+    0x27B70A85u, 0x2E1B2138u, 0x4D2C6DFCu, 0x53380D13u, 0x650A7354u, 0x766A0ABBu, 0x81C2C92Eu, 0x92722C85u,
+    0xA2BFE8A1u, 0xA81A664Bu, 0xC24B8B70u, 0xC76C51A3u, 0xD192E819u, 0xD6990624u, 0xF40E3585u, 0x106AA070u,
+    0x19A4C116u, 0x1E376C08u, 0x2748774Cu, 0x34B0BCB5u, 0x391C0CB3u, 0x4ED8AA4Au, 0x5B9CCA4Fu, 0x682E6FF3u,
+    0x748F82EEu, 0x78A5636Fu, 0x84C87814u, 0x8CC70208u, 0x90BEFFFAu, 0xA4506CEBu, 0xBEF9A3F7u, 0xC67178F2u
+};
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_DeltaInit     (       void         *p_ctx,
+                                                 CPU_BOOLEAN   encode);
+
+static  CPU_BOOLEAN  TFTPc_DeltaProcess  (       void         *p_ctx,
+                                          const  CPU_INT08U   *p_src,
+                                                 CPU_SIZE_T    src_len,
+                                                 CPU_SIZE_T   *p_src_used,
+                                                 CPU_INT08U   *p_dst,
+                                                 CPU_SIZE_T    dst_len,
+                                                 CPU_SIZE_T   *p_dst_used,
+                                                 CPU_BOOLEAN   flush);
+
+static  void         TFTPc_DeltaClose    (       void         *p_ctx);
+
+static  CPU_BOOLEAN  TFTPc_DeltaHdrParse (       TFTPc_DELTA  *p_delta);
+
+static  CPU_BOOLEAN  TFTPc_DeltaCmdStart (       TFTPc_DELTA  *p_delta,
+                                                 CPU_INT08U    cmd);
+
+static  CPU_BOOLEAN  TFTPc_DeltaArgParse (       TFTPc_DELTA  *p_delta);
+
+static  void         TFTPc_DeltaOutUpdate(       TFTPc_DELTA  *p_delta,
+                                          const  CPU_INT08U   *p_data,
+                                                 CPU_SIZE_T    data_len);
+
+static  void         TFTPc_DeltaSHA256Blk(       CPU_INT32U   *p_state,
+                                          const  CPU_INT08U   *p_blk);
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_DeltaCodecInit()
+*
+* Description : Initialize a codec structure for delta updates.
+*
+* Argument(s) : p_codec             Pointer to codec structure to initialize.
+*
+*               p_delta             Pointer to delta context (see Note #1).
+*
+*               p_filename_base     Pointer to name of the local base file the patches apply to.
+*
+*               p_digest            Pointer to the expected SHA-256 digest of the file to rebuild
+*                                   (TFTPc_DELTA_SHA256_DIGEST_LEN octets, see Note #4).
+*
+*               p_suffix            Pointer to remote filename suffix identifying patches (e.g. ".tdp").
+*
+*                                       DEF_NULL, to apply the codec only to transfers requested with
+*                                       TFTPc_MODE_FLAG_CODEC.
+*
+*               p_err               Pointer to variable that will receive the return error code from this
+*                                   function :
+*
+*                                       TFTPc_ERR_NONE          Codec successfully initialized.
+*                                       TFTPc_ERR_NULL_PTR      Argument(s) passed NULL pointer(s).
+*
+* Return(s)   : DEF_OK,   if codec was initialized successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The codec structure, the delta context, the base filename & the digest are referenced by
+*                   the codec once registered with TFTPc_CodecSet() : they MUST remain valid while registered.
+*
+*               (2) The base file is opened for each transfer using the codec & closed when the transfer
+*                   ends.  It MUST differ from the local file passed to TFTPc_Get(), which is truncated
+*                   before the patch is applied; the application replaces the base file once the transfer
+*                   succeeds.
+*
+*               (3) Delta patches are only applied to TFTPc_Get() transfers : a TFTPc_Put() transfer using
+*                   the codec fails.
+*
+*               (4) The digest comes from a trusted source (e.g. a signed release manifest), NOT from the
+*                   patch : the transfer fails with TFTPc_ERR_CODEC if the rebuilt file does NOT match it.
+*                   The application updates the digest before each TFTPc_Get() of a new patch.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPc_DeltaCodecInit (       TFTPc_CODEC  *p_codec,
+                                          TFTPc_DELTA  *p_delta,
+                                          CPU_CHAR     *p_filename_base,
+                                   const  CPU_INT08U   *p_digest,
+                                   const  CPU_CHAR     *p_suffix,
+                                          TFTPc_ERR    *p_err)
+{
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+
+    if ((p_codec         == DEF_NULL) ||
+        (p_delta         == DEF_NULL) ||
+        (p_filename_base == DEF_NULL) ||
+        (p_digest        == DEF_NULL)) {
+       *p_err = TFTPc_ERR_NULL_PTR;
+        return (DEF_FAIL);
+    }
+#endif
+
+    Mem_Clr(p_delta, sizeof(TFTPc_DELTA));
+    p_delta->FilenameBasePtr = p_filename_base;
+    p_delta->DigestPtr       = p_digest;
+    p_delta->FileBaseHandle  = DEF_NULL;
+
+    p_codec->SuffixPtr       = p_suffix;
+    p_codec->CtxPtr          = p_delta;
+    p_codec->Init            = TFTPc_DeltaInit;
+    p_codec->Process         = TFTPc_DeltaProcess;
+    p_codec->Close           = TFTPc_DeltaClose;
+
+   *p_err = TFTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_DeltaSHA256Init()
+*
+* Description : Initialize a SHA-256 context.
+*
+* Argument(s) : p_sha256    Pointer to SHA-256 context.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DeltaInit(),
+*               Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPc_DeltaSHA256Init (TFTPc_DELTA_SHA256  *p_sha256)
+{
+    p_sha256->State[0] = 0x6A09E667u;                           /* Initial hash value (FIPS 180-4 sec 5.3.3).           */
+    p_sha256->State[1] = 0xBB67AE85u;
+    p_sha256->State[2] = 0x3C6EF372u;
+    p_sha256->State[3] = 0xA54FF53Au;
+    p_sha256->State[4] = 0x510E527Fu;
+    p_sha256->State[5] = 0x9B05688Cu;
+    p_sha256->State[6] = 0x1F83D9ABu;
+    p_sha256->State[7] = 0x5BE0CD19u;
+    p_sha256->Len      = 0u;
+}
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_DeltaSHA256Update()
+*
+* Description : Hash a block of data.
+*
+* Argument(s) : p_sha256    Pointer to SHA-256 context.
+*
+*               p_data      Pointer to data.
+*
+*               data_len    Length of data (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DeltaOutUpdate(),
+*               Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+void  TFTPc_DeltaSHA256Update (       TFTPc_DELTA_SHA256  *p_sha256,
+                               const  CPU_INT08U          *p_data,
+                                      CPU_SIZE_T           data_len)
+{
+    CPU_SIZE_T  blk_ix;
+    CPU_SIZE_T  len;
+
+
+    while (data_len > 0u) {
+        blk_ix = (CPU_SIZE_T)(p_sha256->Len % TFTPc_DELTA_SHA256_BLK_LEN);
+        len    = DEF_MIN(TFTPc_DELTA_SHA256_BLK_LEN - blk_ix, data_len);
+        Mem_Copy(&p_sha256->Blk[blk_ix], p_data, len);
+        p_sha256->Len += len;
+        p_data        += len;
+        data_len      -= len;
+
+        if ((blk_ix + len) == TFTPc_DELTA_SHA256_BLK_LEN) {
+            TFTPc_DeltaSHA256Blk(p_sha256->State, p_sha256->Blk);
+        }
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                       TFTPc_DeltaSHA256Final()
+*
+* Description : Pad the hashed data & get its digest.
+*
+* Argument(s) : p_sha256    Pointer to SHA-256 context.
+*
+*               p_digest    Pointer to buffer that will receive the digest (TFTPc_DELTA_SHA256_DIGEST_LEN
+*                           octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DeltaCmdStart(),
+*               Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The data is padded with a '1' bit, '0' bits & its length in bits (FIPS 180-4 sec 5.1.1).
+*                   The context MUST be re-initialized before hashing other data.
+*********************************************************************************************************
+*/
+
+void  TFTPc_DeltaSHA256Final (TFTPc_DELTA_SHA256  *p_sha256,
+                              CPU_INT08U          *p_digest)
+{
+    CPU_INT64U  len_bits;
+    CPU_SIZE_T  blk_ix;
+    CPU_INT08U  ix;
+
+
+    len_bits = p_sha256->Len * DEF_OCTET_NBR_BITS;              /* See Note #1.                                         */
+    blk_ix   = (CPU_SIZE_T)(p_sha256->Len % TFTPc_DELTA_SHA256_BLK_LEN);
+
+    p_sha256->Blk[blk_ix] = 0x80u;
+    blk_ix++;
+    if (blk_ix > (TFTPc_DELTA_SHA256_BLK_LEN - TFTPc_DELTA_SHA256_LEN_FIELD_LEN)) {
+        Mem_Clr(&p_sha256->Blk[blk_ix], TFTPc_DELTA_SHA256_BLK_LEN - blk_ix);
+        TFTPc_DeltaSHA256Blk(p_sha256->State, p_sha256->Blk);
+        blk_ix = 0u;
+    }
+    Mem_Clr(&p_sha256->Blk[blk_ix], TFTPc_DELTA_SHA256_BLK_LEN - TFTPc_DELTA_SHA256_LEN_FIELD_LEN - blk_ix);
+
+    for (ix = 0u; ix < TFTPc_DELTA_SHA256_LEN_FIELD_LEN; ix++) {
+        p_sha256->Blk[TFTPc_DELTA_SHA256_BLK_LEN - 1u - ix] = (CPU_INT08U)(len_bits >> (ix * DEF_OCTET_NBR_BITS));
+    }
+    TFTPc_DeltaSHA256Blk(p_sha256->State, p_sha256->Blk);
+
+    for (ix = 0u; ix < 8u; ix++) {
+        NET_UTIL_VAL_SET_NET_32(&p_digest[ix * 4u], p_sha256->State[ix]);
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_DeltaInit()
+*
+* Description : Reset the delta context & open the base file, at the start of a transfer.
+*
+* Argument(s) : p_ctx       Pointer to delta context.
+*
+*               encode      DEF_YES, for a TFTPc_Put() transfer.
+*
+*                           DEF_NO,  for a TFTPc_Get() transfer.
+*
+* Return(s)   : DEF_OK,   if the base file was opened.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPc_CodecSel(), via the codec structure.
+*
+* Note(s)     : (1) See 'TFTPc_DeltaCodecInit()  Note #3'.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_DeltaInit (void         *p_ctx,
+                                      CPU_BOOLEAN   encode)
+{
+    TFTPc_DELTA  *p_delta;
+
+
+    p_delta = (TFTPc_DELTA *)p_ctx;
+
+    if (encode == DEF_YES) {                                    /* See Note #1.                                         */
+        return (DEF_FAIL);
+    }
+
+    TFTPc_DeltaClose(p_delta);                                  /* Close base file left opened, if any.                 */
+
+    p_delta->FileBaseHandle = NetFS_FileOpen(p_delta->FilenameBasePtr,
+                                             NET_FS_FILE_MODE_OPEN,
+                                             NET_FS_FILE_ACCESS_RD);
+    if (p_delta->FileBaseHandle == DEF_NULL) {
+        return (DEF_FAIL);
+    }
+
+    p_delta->State     = TFTPc_DELTA_STATE_HDR;
+    p_delta->Cmd       = TFTPc_DELTA_CMD_END;
+    p_delta->BufLen    = 0u;
+    p_delta->BufLenReq = TFTPc_DELTA_HDR_LEN;
+    p_delta->TargetLen = 0u;
+    p_delta->OutLen    = 0u;
+    p_delta->CmdRem    = 0u;
+    TFTPc_DeltaSHA256Init(&p_delta->OutSHA256);
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_DeltaProcess()
+*
+* Description : Apply a chunk of the patch.
+*
+* Argument(s) : p_ctx       Pointer to delta context.
+*
+*               p_src       Pointer to patch data.
+*
+*               src_len     Length of patch data (in octets).
+*
+*               p_src_used  Pointer to variable that will receive the number of patch octets consumed.
+*
+*               p_dst       Pointer to buffer that will receive the rebuilt data.
+*
+*               dst_len     Length of buffer (in octets).
+*
+*               p_dst_used  Pointer to variable that will receive the number of rebuilt octets.
+*
+*               flush       DEF_YES, if the end of the patch was reached.
+*
+* Return(s)   : DEF_OK,   if no error.
+*               DEF_FAIL, if the patch is corrupted, does NOT apply to the base file, or the rebuilt file
+*                         does NOT match the target length or the expected digest (see 'tftp-c_delta.h
+*                         TFTPc DELTA PATCH DEFINES  Note #1a').
+*
+* Caller(s)   : TFTPc_CodecDataWr(), via the codec structure.
+*
+* Note(s)     : (1) Processing goes on as long as patch data can be consumed or rebuilt data produced.  Base
+*                   file data can be copied even once all the patch data was consumed.
+*
+*               (2) Once flushed, a patch that did NOT reach its END command is truncated.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_DeltaProcess (       void         *p_ctx,
+                                         const  CPU_INT08U   *p_src,
+                                                CPU_SIZE_T    src_len,
+                                                CPU_SIZE_T   *p_src_used,
+                                                CPU_INT08U   *p_dst,
+                                                CPU_SIZE_T    dst_len,
+                                                CPU_SIZE_T   *p_dst_used,
+                                                CPU_BOOLEAN   flush)
+{
+    TFTPc_DELTA  *p_delta;
+    CPU_SIZE_T    src_ix;
+    CPU_SIZE_T    dst_ix;
+    CPU_SIZE_T    len;
+    CPU_SIZE_T    rd_len;
+    CPU_BOOLEAN   progress;
+    CPU_BOOLEAN   ok;
+
+
+    p_delta  = (TFTPc_DELTA *)p_ctx;
+    src_ix   = 0u;
+    dst_ix   = 0u;
+    progress = DEF_YES;
+    ok       = DEF_OK;
+
+    while ((progress == DEF_YES) &&                             /* See Note #1.                                         */
+           (ok       == DEF_OK)) {
+        progress = DEF_NO;
+
+        switch (p_delta->State) {
+            case TFTPc_DELTA_STATE_HDR:
+            case TFTPc_DELTA_STATE_ARG:
+                 len = DEF_MIN((CPU_SIZE_T)(p_delta->BufLenReq - p_delta->BufLen), src_len - src_ix);
+                 if (len > 0u) {
+                     Mem_Copy(&p_delta->Buf[p_delta->BufLen], &p_src[src_ix], len);
+                     p_delta->BufLen += (CPU_INT08U)len;
+                     src_ix          +=             len;
+                     progress         = DEF_YES;
+                 }
+
+                 if (p_delta->BufLen == p_delta->BufLenReq) {
+                     if (p_delta->State == TFTPc_DELTA_STATE_HDR) {
+                         ok = TFTPc_DeltaHdrParse(p_delta);
+                     } else {
+                         ok = TFTPc_DeltaArgParse(p_delta);
+                     }
+                     progress = DEF_YES;
+                 }
+                 break;
+
+
+            case TFTPc_DELTA_STATE_CMD:
+                 if (src_ix < src_len) {
+                     ok       = TFTPc_DeltaCmdStart(p_delta, p_src[src_ix]);
+                     src_ix++;
+                     progress = DEF_YES;
+                 }
+                 break;
+
+
+            case TFTPc_DELTA_STATE_COPY:
+                 len = DEF_MIN((CPU_SIZE_T)p_delta->CmdRem, dst_len - dst_ix);
+                 if (len > 0u) {
+                     rd_len = 0u;
+                    (void)NetFS_FileRd((void       *) p_delta->FileBaseHandle,
+                                       (void       *)&p_dst[dst_ix],
+                                       (CPU_SIZE_T  ) len,
+                                       (CPU_SIZE_T *)&rd_len);
+                     if (rd_len != len) {                       /* Base file too short.                                 */
+                         ok = DEF_FAIL;
+                         break;
+                     }
+                     TFTPc_DeltaOutUpdate(p_delta, &p_dst[dst_ix], len);
+                     dst_ix  += len;
+                     progress = DEF_YES;
+                 }
+                 break;
+
+
+            case TFTPc_DELTA_STATE_ADD:
+                 len = DEF_MIN((CPU_SIZE_T)p_delta->CmdRem, src_len - src_ix);
+                 len = DEF_MIN(len,                         dst_len - dst_ix);
+                 if (len > 0u) {
+                     Mem_Copy(&p_dst[dst_ix], &p_src[src_ix], len);
+                     TFTPc_DeltaOutUpdate(p_delta, &p_dst[dst_ix], len);
+                     src_ix  += len;
+                     dst_ix  += len;
+                     progress = DEF_YES;
+                 }
+                 break;
+
+
+            case TFTPc_DELTA_STATE_END:
+                 if (src_ix < src_len) {                        /* Data following END cmd.                              */
+                     ok = DEF_FAIL;
+                 }
+                 break;
+
+
+            default:
+                 ok = DEF_FAIL;
+                 break;
+        }
+    }
+
+    if ((ok             == DEF_OK)                &&            /* See Note #2.                                         */
+        (flush          == DEF_YES)               &&
+        (dst_ix         == 0u)                    &&
+        (p_delta->State != TFTPc_DELTA_STATE_END)) {
+        ok = DEF_FAIL;
+    }
+
+   *p_src_used = src_ix;
+   *p_dst_used = dst_ix;
+
+    return (ok);
+}
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_DeltaClose()
+*
+* Description : Close the base file, at the end of a transfer.
+*
+* Argument(s) : p_ctx       Pointer to delta context.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DeltaInit(),
+*               TFTPc_Terminate(), via the codec structure.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_DeltaClose (void  *p_ctx)
+{
+    TFTPc_DELTA  *p_delta;
+
+
+    p_delta = (TFTPc_DELTA *)p_ctx;
+
+    if (p_delta->FileBaseHandle != DEF_NULL) {
+        NetFS_FileClose(p_delta->FileBaseHandle);
+        p_delta->FileBaseHandle = DEF_NULL;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_DeltaHdrParse()
+*
+* Description : Parse the patch header.
+*
+* Argument(s) : p_delta     Pointer to delta context, holding the header in its buffer.
+*
+* Return(s)   : DEF_OK,   if the header is valid.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPc_DeltaProcess().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_DeltaHdrParse (TFTPc_DELTA  *p_delta)
+{
+    if ((p_delta->Buf[0] != (CPU_INT08U)TFTPc_DELTA_MAGIC_0) ||
+        (p_delta->Buf[1] != (CPU_INT08U)TFTPc_DELTA_MAGIC_1) ||
+        (p_delta->Buf[2] != (CPU_INT08U)TFTPc_DELTA_MAGIC_2) ||
+        (p_delta->Buf[3] != (CPU_INT08U)TFTPc_DELTA_MAGIC_3)) {
+        return (DEF_FAIL);
+    }
+
+    p_delta->TargetLen = NET_UTIL_VAL_GET_NET_32(&p_delta->Buf[4]);
+    p_delta->State     = TFTPc_DELTA_STATE_CMD;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_DeltaCmdStart()
+*
+* Description : Start processing a patch command.
+*
+* Argument(s) : p_delta     Pointer to delta context.
+*
+*               cmd         Command code.
+*
+* Return(s)   : DEF_OK,   if the command is valid.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPc_DeltaProcess().
+*
+* Note(s)     : (1) The rebuilt file is verified as soon as the END command is rx'd (see 'tftp-c_delta.h
+*                   TFTPc DELTA PATCH DEFINES  Note #1a').
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_DeltaCmdStart (TFTPc_DELTA  *p_delta,
+                                          CPU_INT08U    cmd)
+{
+    CPU_INT08U  digest[TFTPc_DELTA_SHA256_DIGEST_LEN];
+
+
+    p_delta->Cmd    = cmd;
+    p_delta->BufLen = 0u;
+
+    switch (cmd) {
+        case TFTPc_DELTA_CMD_COPY:
+             p_delta->BufLenReq = TFTPc_DELTA_CMD_COPY_ARG_LEN;
+             p_delta->State     = TFTPc_DELTA_STATE_ARG;
+             break;
+
+
+        case TFTPc_DELTA_CMD_ADD:
+             p_delta->BufLenReq = TFTPc_DELTA_CMD_ADD_ARG_LEN;
+             p_delta->State     = TFTPc_DELTA_STATE_ARG;
+             break;
+
+
+        case TFTPc_DELTA_CMD_END:                               /* See Note #1.                                         */
+             if (p_delta->OutLen != p_delta->TargetLen) {
+                 return (DEF_FAIL);
+             }
+             TFTPc_DeltaSHA256Final(&p_delta->OutSHA256, digest);
+             if (Mem_Cmp(digest, p_delta->DigestPtr, TFTPc_DELTA_SHA256_DIGEST_LEN) != DEF_YES) {
+                 return (DEF_FAIL);
+             }
+             p_delta->State = TFTPc_DELTA_STATE_END;
+             break;
+
+
+        default:
+             return (DEF_FAIL);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_DeltaArgParse()
+*
+* Description : Parse the arguments of a COPY or ADD command.
+*
+* Argument(s) : p_delta     Pointer to delta context, holding the arguments in its buffer.
+*
+* Return(s)   : DEF_OK,   if the arguments are valid.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : TFTPc_DeltaProcess().
+*
+* Note(s)     : (1) A command that would make the rebuilt file longer than announced in the patch header is
+*                   rejected before any data is wr'n.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_DeltaArgParse (TFTPc_DELTA  *p_delta)
+{
+    CPU_INT32U   offset;
+    CPU_BOOLEAN  ok;
+
+
+    if (p_delta->Cmd == TFTPc_DELTA_CMD_COPY) {
+        offset          = NET_UTIL_VAL_GET_NET_32(&p_delta->Buf[0]);
+        p_delta->CmdRem = NET_UTIL_VAL_GET_NET_32(&p_delta->Buf[4]);
+        if (offset > (CPU_INT32U)DEF_INT_32S_MAX_VAL) {
+            return (DEF_FAIL);
+        }
+        ok = NetFS_FilePosSet(p_delta->FileBaseHandle,
+                              (CPU_INT32S)offset,
+                              NET_FS_SEEK_ORIGIN_START);
+        if (ok != DEF_OK) {
+            return (DEF_FAIL);
+        }
+        p_delta->State  = TFTPc_DELTA_STATE_COPY;
+    } else {
+        p_delta->CmdRem = NET_UTIL_VAL_GET_NET_32(&p_delta->Buf[0]);
+        p_delta->State  = TFTPc_DELTA_STATE_ADD;
+    }
+
+    if (p_delta->CmdRem > (p_delta->TargetLen - p_delta->OutLen)) {
+        return (DEF_FAIL);                                      /* See Note #1.                                         */
+    }
+
+    if (p_delta->CmdRem == 0u) {
+        p_delta->State = TFTPc_DELTA_STATE_CMD;
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_DeltaOutUpdate()
+*
+* Description : Account for rebuilt data.
+*
+* Argument(s) : p_delta     Pointer to delta context.
+*
+*               p_data      Pointer to rebuilt data.
+*
+*               data_len    Length of rebuilt data (in octets).
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DeltaProcess().
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_DeltaOutUpdate (       TFTPc_DELTA  *p_delta,
+                                    const  CPU_INT08U   *p_data,
+                                           CPU_SIZE_T    data_len)
+{
+    TFTPc_DeltaSHA256Update(&p_delta->OutSHA256, p_data, data_len);
+    p_delta->OutLen += (CPU_INT32U)data_len;
+    p_delta->CmdRem -= (CPU_INT32U)data_len;
+
+    if (p_delta->CmdRem == 0u) {                                /* Cmd done.                                            */
+        p_delta->State = TFTPc_DELTA_STATE_CMD;
+    }
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_DeltaSHA256Blk()
+*
+* Description : Process a 64-octet block of data (FIPS 180-4 sec 6.2.2).
+*
+* Argument(s) : p_state     Pointer to the intermediate hash value.
+*
+*               p_blk       Pointer to the block.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_DeltaSHA256Update(),
+*               TFTPc_DeltaSHA256Final().
+*
+* Note(s)     : (1) The message schedule is computed in a 16-word circular buffer to save stack.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_DeltaSHA256Blk (       CPU_INT32U  *p_state,
+                                    const  CPU_INT08U  *p_blk)
+{
+    CPU_INT32U  w[16];
+    CPU_INT32U  v[8];
+    CPU_INT32U  s0;
+    CPU_INT32U  s1;
+    CPU_INT32U  t1;
+    CPU_INT32U  t2;
+    CPU_INT08U  ix;
+
+
+    for (ix = 0u; ix < 16u; ix++) {
+        w[ix] = NET_UTIL_VAL_GET_NET_32(&p_blk[ix * 4u]);
+    }
+    for (ix = 0u; ix < 8u; ix++) {
+        v[ix] = p_state[ix];
+    }
+
+    for (ix = 0u; ix < 64u; ix++) {
+        if (ix >= 16u) {                                        /* See Note #1.                                         */
+            s0             = w[(ix + 1u) & 0x0Fu];
+            s0             = TFTPc_DELTA_ROTR(s0,  7u) ^ TFTPc_DELTA_ROTR(s0, 18u) ^ (s0 >>  3);
+            s1             = w[(ix + 14u) & 0x0Fu];
+            s1             = TFTPc_DELTA_ROTR(s1, 17u) ^ TFTPc_DELTA_ROTR(s1, 19u) ^ (s1 >> 10);
+            w[ix & 0x0Fu] += s0 + s1 + w[(ix + 9u) & 0x0Fu];
+        }
+
+        t1   = v[7]
+             + (TFTPc_DELTA_ROTR(v[4], 6u) ^ TFTPc_DELTA_ROTR(v[4], 11u) ^ TFTPc_DELTA_ROTR(v[4], 25u))
+             + ((v[4] & v[5]) ^ (~v[4] & v[6]))
+             + TFTPc_DeltaSHA256_K[ix]
+             + w[ix & 0x0Fu];
+        t2   = (TFTPc_DELTA_ROTR(v[0], 2u) ^ TFTPc_DELTA_ROTR(v[0], 13u) ^ TFTPc_DELTA_ROTR(v[0], 22u))
+             + ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+
+        v[7] = v[6];
+        v[6] = v[5];
+        v[5] = v[4];
+        v[4] = v[3] + t1;
+        v[3] = v[2];
+        v[2] = v[1];
+        v[1] = v[0];
+        v[0] = t1 + t2;
+    }
+
+    for (ix = 0u; ix < 8u; ix++) {
+        p_state[ix] += v[ix];
+    }
+}
+
+#endif
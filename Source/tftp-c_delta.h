@@ -0,0 +1,239 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                      TFTP CLIENT DELTA UPDATE CODEC
+*
+* Filename : tftp-c_delta.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The delta codec rebuilds a file from a patch rx'd by TFTPc_Get() & from a base file already
+*                present on the local file system (e.g. the current firmware image).  Only the patch is
+*                transferred; the reconstructed file is written to the local file passed to TFTPc_Get().
+*
+*            (2) The delta codec is a TFTPc codec (see 'tftp-c.h  TFTPc CODEC DATA TYPE') : it is
+*                initialized with TFTPc_DeltaCodecInit() & registered with TFTPc_CodecSet().
+*
+*            (3) The patch is applied as it is rx'd.  RAM usage is bounded by the delta context & by the
+*                codec working buffer (see 'tftp-c_cfg.h  TFTPc_CFG_CODEC_BUF_SIZE'), whatever the size of
+*                the files.
+*
+*            (4) The rebuilt file is verified against the SHA-256 digest supplied by the application (see
+*                TFTPc_DeltaCodecInit()), which is trusted unlike the patch.
+*
+*            (5) Patches are generated on the host with 'Host/Tools/tftpc_delta', which also prints the
+*                SHA-256 digest of the target file.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_DELTA_MODULE_PRESENT
+#define  TFTPc_DELTA_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <lib_def.h>
+
+#include  <tftp-c_cfg.h>
+#include  "tftp-c.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       TFTPc DELTA PATCH DEFINES
+*
+* Note(s) : (1) A patch is made of a header followed by a sequence of commands.  All multi-octet fields
+*               are encoded in network order (big-endian) :
+*
+*                   Header      "TDP1"  Target len (4)
+*
+*                   COPY        0x01    Base offset (4) Len (4)         Copy 'Len' octets of the base file,
+*                                                                       starting at 'Base offset'.
+*
+*                   ADD         0x02    Len (4)         Data ('Len')    Copy 'Len' octets of data following
+*                                                                       the command.
+*
+*                   END         0x00                                    End of patch.
+*
+*               (a) 'Target len' is the length of the file to rebuild; commands that would exceed it are
+*                   rejected.  The transfer fails if the rebuilt file does NOT match the length & the SHA-256
+*                   digest supplied by the application (see Note #4).
+*
+*               (b) Commands are applied in order & the rebuilt file is written sequentially : a patch
+*                   generator only needs to describe the target file as a list of base file extents &
+*                   literal data (see Note #5).
+*********************************************************************************************************
+*/
+
+#define  TFTPc_DELTA_MAGIC_0                             'T'
+#define  TFTPc_DELTA_MAGIC_1                             'D'
+#define  TFTPc_DELTA_MAGIC_2                             'P'
+#define  TFTPc_DELTA_MAGIC_3                             '1'
+
+#define  TFTPc_DELTA_HDR_LEN                               8u
+
+#define  TFTPc_DELTA_CMD_END                            0x00u
+#define  TFTPc_DELTA_CMD_COPY                           0x01u
+#define  TFTPc_DELTA_CMD_ADD                            0x02u
+
+#define  TFTPc_DELTA_CMD_COPY_ARG_LEN                      8u
+#define  TFTPc_DELTA_CMD_ADD_ARG_LEN                       4u
+
+#define  TFTPc_DELTA_SHA256_DIGEST_LEN                    32u
+#define  TFTPc_DELTA_SHA256_BLK_LEN                       64u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                       TFTPc SHA-256 DATA TYPE
+*
+* Note(s) : (1) SHA-256 (FIPS 180-4) context, used by the delta codec to verify the rebuilt file & by host
+*               tools to compute the digest of a target file (see TFTPc_DeltaSHA256Init()).
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_delta_sha256 {
+    CPU_INT32U   State[8];                                      /* Intermediate hash value.                             */
+    CPU_INT64U   Len;                                           /* Nbr of octets hashed.                                */
+    CPU_INT08U   Blk[TFTPc_DELTA_SHA256_BLK_LEN];               /* Partial blk.                                         */
+} TFTPc_DELTA_SHA256;
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc DELTA CONTEXT DATA TYPE
+*
+* Note(s) : (1) The delta context is owned by the application & MUST remain valid while the codec is
+*               registered.  Its fields are private to the delta codec.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_delta {
+           CPU_CHAR            *FilenameBasePtr;                /* Base file name.                                      */
+    const  CPU_INT08U          *DigestPtr;                      /* Expected SHA-256 digest of rebuilt file.             */
+           void                *FileBaseHandle;                 /* Base file handle, NULL if closed.                    */
+
+           CPU_INT08U           State;                          /* Patch parser state.                                  */
+           CPU_INT08U           Cmd;                            /* Cmd being parsed.                                    */
+           CPU_INT08U           Buf[TFTPc_DELTA_HDR_LEN];       /* Hdr & cmd arg accumulation buf.                      */
+           CPU_INT08U           BufLen;                         /* Nbr of octets in buf.                                */
+           CPU_INT08U           BufLenReq;                      /* Nbr of octets req'd in buf.                          */
+
+           CPU_INT32U           TargetLen;                      /* Len of file to rebuild (from patch hdr).             */
+           CPU_INT32U           OutLen;                         /* Nbr of octets rebuilt.                               */
+           TFTPc_DELTA_SHA256   OutSHA256;                      /* SHA-256 of octets rebuilt.                           */
+           CPU_INT32U           CmdRem;                         /* Nbr of octets remaining for cur cmd.                 */
+} TFTPc_DELTA;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_DELTA_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_DeltaCodecInit   (       TFTPc_CODEC         *p_codec,
+                                            TFTPc_DELTA         *p_delta,
+                                            CPU_CHAR            *p_filename_base,
+                                     const  CPU_INT08U          *p_digest,
+                                     const  CPU_CHAR            *p_suffix,
+                                            TFTPc_ERR           *p_err);
+
+void         TFTPc_DeltaSHA256Init  (       TFTPc_DELTA_SHA256  *p_sha256);
+
+void         TFTPc_DeltaSHA256Update(       TFTPc_DELTA_SHA256  *p_sha256,
+                                     const  CPU_INT08U          *p_data,
+                                            CPU_SIZE_T           data_len);
+
+void         TFTPc_DeltaSHA256Final (       TFTPc_DELTA_SHA256  *p_sha256,
+                                            CPU_INT08U          *p_digest);
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                        CONFIGURATION ERRORS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CFG_DELTA_EN
+#error  "TFTPc_CFG_DELTA_EN                    not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_DELTA_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_DELTA_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_DELTA_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_DELTA_EN == DEF_ENABLED) && \
+        (TFTPc_CFG_CODEC_EN != DEF_ENABLED))
+#error  "TFTPc_CFG_DELTA_EN              illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED when            "
+#error  "                                 TFTPc_CFG_CODEC_EN is DISABLED]        "
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPc_DELTA_MODULE_PRESENT  */
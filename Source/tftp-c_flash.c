@@ -0,0 +1,274 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP CLIENT SIMULATED FLASH DRIVER
+*
+* Filename : tftp-c_flash.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The driver functions are called by the TFTPc flash sink, which holds the TFTPc lock : the
+*                simulated flash context is never accessed concurrently.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPc_FLASH_MODULE
+#include  "tftp-c_flash.h"
+
+#include  <KAL/kal.h>
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_RAM_EN == DEF_ENABLED)
+
+#define  TFTPc_FLASH_RAM_ERASED_VAL                     0xFFu   /* Val of an erased octet.                              */
+#define  TFTPc_FLASH_RAM_INIT_VAL                       0x00u   /* Val of a programmed octet (see Note #1).             */
+
+                                                                /* See 'tftp-c.c  TIME SOURCE MACRO'S  Note #1'.        */
+#ifndef  TFTPc_TIME_DLY_ms
+#define  TFTPc_TIME_DLY_ms(dly_ms)                          KAL_Dly(dly_ms)
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_FlashRAM_SectorErase (       void        *p_ctx,
+                                                        CPU_INT32U   addr);
+
+static  CPU_BOOLEAN  TFTPc_FlashRAM_PageProg    (       void        *p_ctx,
+                                                        CPU_INT32U   addr,
+                                                 const  CPU_INT08U  *p_data);
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_FlashRAM_Init()
+*
+* Description : Initialize a flash driver structure backed by a RAM buffer.
+*
+* Argument(s) : p_flash         Pointer to flash driver structure to initialize.
+*
+*               p_ram           Pointer to simulated flash context (see 'tftp-c_flash.h  TFTPc SIMULATED
+*                               FLASH DATA TYPE').
+*
+*               p_mem           Pointer to RAM buffer of 'size' octets holding the simulated flash.
+*
+*               size            Size        of simulated flash (in octets).
+*
+*               sector_size     Sector size of simulated flash (in octets).
+*
+*               page_size       Page size   of simulated flash (in octets).
+*
+*               erase_dly_ms    Delay of each sector erase (in milliseconds), 0 for none.
+*
+*               p_err           Pointer to variable that will receive the return error code from this
+*                               function :
+*
+*                                   TFTPc_ERR_NONE          Driver successfully initialized.
+*                                   TFTPc_ERR_NULL_PTR      Argument(s) passed NULL pointer(s).
+*
+* Return(s)   : DEF_OK,   if driver was initialized successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The simulated flash is initialized with all its octets programmed to 0x00, so that a page
+*                   programmed without its sector being erased first is detected.
+*
+*               (2) The geometry is validated when the driver is registered with TFTPc_FlashSet().
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPc_FlashRAM_Init (TFTPc_FLASH      *p_flash,
+                                  TFTPc_FLASH_RAM  *p_ram,
+                                  CPU_INT08U       *p_mem,
+                                  CPU_INT32U        size,
+                                  CPU_INT32U        sector_size,
+                                  CPU_INT16U        page_size,
+                                  CPU_INT32U        erase_dly_ms,
+                                  TFTPc_ERR        *p_err)
+{
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+
+    if ((p_flash == DEF_NULL) ||
+        (p_ram   == DEF_NULL) ||
+        (p_mem   == DEF_NULL)) {
+       *p_err = TFTPc_ERR_NULL_PTR;
+        return (DEF_FAIL);
+    }
+#endif
+
+    Mem_Set(p_mem, TFTPc_FLASH_RAM_INIT_VAL, size);             /* See Note #1.                                         */
+
+    Mem_Clr(p_ram, sizeof(TFTPc_FLASH_RAM));
+    p_ram->MemPtr        = p_mem;
+    p_ram->Size          = size;
+    p_ram->SectorSize    = sector_size;
+    p_ram->PageSize      = page_size;
+    p_ram->EraseDly_ms   = erase_dly_ms;
+
+    p_flash->CtxPtr      = p_ram;                               /* See Note #2.                                         */
+    p_flash->Size        = size;
+    p_flash->SectorSize  = sector_size;
+    p_flash->PageSize    = page_size;
+    p_flash->SectorErase = TFTPc_FlashRAM_SectorErase;
+    p_flash->PageProg    = TFTPc_FlashRAM_PageProg;
+
+   *p_err = TFTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                    TFTPc_FlashRAM_SectorErase()
+*
+* Description : Erase a sector of the simulated flash.
+*
+* Argument(s) : p_ctx       Pointer to simulated flash context.
+*
+*               addr        Address of the sector to erase.
+*
+* Return(s)   : DEF_OK,   if sector erased.
+*               DEF_FAIL, if address misaligned or out of range.
+*
+* Caller(s)   : TFTPc flash sink, through the flash driver structure.
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_FlashRAM_SectorErase (void        *p_ctx,
+                                                 CPU_INT32U   addr)
+{
+    TFTPc_FLASH_RAM  *p_ram;
+
+
+    p_ram = (TFTPc_FLASH_RAM *)p_ctx;
+    if (((addr % p_ram->SectorSize) != 0u) ||
+         (addr >= p_ram->Size)) {
+        p_ram->ErrCtr++;
+        return (DEF_FAIL);
+    }
+
+    Mem_Set(&p_ram->MemPtr[addr], TFTPc_FLASH_RAM_ERASED_VAL, p_ram->SectorSize);
+    p_ram->EraseCtr++;
+
+    if (p_ram->EraseDly_ms > 0u) {                              /* Simulate erase time.                                 */
+        TFTPc_TIME_DLY_ms(p_ram->EraseDly_ms);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                     TFTPc_FlashRAM_PageProg()
+*
+* Description : Program a page of the simulated flash.
+*
+* Argument(s) : p_ctx       Pointer to simulated flash context.
+*
+*               addr        Address of the page to program.
+*
+*               p_data      Pointer to page data ('PageSize' octets).
+*
+* Return(s)   : DEF_OK,   if page programmed.
+*               DEF_FAIL, if address misaligned or out of range, or if page NOT erased (see Note #1).
+*
+* Caller(s)   : TFTPc flash sink, through the flash driver structure.
+*
+* Note(s)     : (1) Programming can only clear bits : the page is rejected, & left unchanged, if any bit of
+*                   the data is set while the same bit of the flash is clear.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_FlashRAM_PageProg (       void        *p_ctx,
+                                                    CPU_INT32U   addr,
+                                             const  CPU_INT08U  *p_data)
+{
+    TFTPc_FLASH_RAM  *p_ram;
+    CPU_INT08U       *p_mem;
+    CPU_INT16U        ix;
+
+
+    p_ram = (TFTPc_FLASH_RAM *)p_ctx;
+    if (((addr % p_ram->PageSize) != 0u) ||
+         (addr                    >= p_ram->Size) ||
+        ((p_ram->Size - addr)     <  p_ram->PageSize)) {
+        p_ram->ErrCtr++;
+        return (DEF_FAIL);
+    }
+
+    p_mem = &p_ram->MemPtr[addr];
+    for (ix = 0u; ix < p_ram->PageSize; ix++) {                 /* See Note #1.                                         */
+        if ((p_mem[ix] & p_data[ix]) != p_data[ix]) {
+            p_ram->ErrCtr++;
+            return (DEF_FAIL);
+        }
+    }
+
+    for (ix = 0u; ix < p_ram->PageSize; ix++) {
+        p_mem[ix] &= p_data[ix];
+    }
+    p_ram->ProgCtr++;
+
+    return (DEF_OK);
+}
+
+#endif
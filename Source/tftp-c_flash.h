@@ -0,0 +1,157 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                   TFTP CLIENT SIMULATED FLASH DRIVER
+*
+* Filename : tftp-c_flash.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The simulated flash driver backs a TFTPc flash driver (see 'tftp-c.h  TFTPc FLASH DRIVER
+*                DATA TYPE') with a RAM buffer, so that firmware update transfers to flash can be exercised
+*                on a test bench or on a board without a flash partition to spare.
+*
+*            (2) The driver behaves like a NOR flash : erasing a sector sets its octets to 0xFF &
+*                programming a page can only clear bits.  Programming a page that was NOT erased, or any
+*                misaligned or out of range access, fails & is counted.
+*
+*            (3) The simulated flash driver is initialized with TFTPc_FlashRAM_Init() & registered with
+*                TFTPc_FlashSet().
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_FLASH_MODULE_PRESENT
+#define  TFTPc_FLASH_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <lib_def.h>
+
+#include  <tftp-c_cfg.h>
+#include  "tftp-c.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                  TFTPc SIMULATED FLASH DATA TYPE
+*
+* Note(s) : (1) The simulated flash context is owned by the application & MUST remain valid while the
+*               driver is registered.  The counters MAY be read & cleared by the application between
+*               transfers to check the operations done by the flash sink.
+*
+*           (2) 'EraseDly_ms' simulates the time taken by a sector erase, which blocks the caller like a
+*               real flash driver would.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_flash_ram {
+    CPU_INT08U  *MemPtr;                                        /* Simulated flash mem.                                 */
+    CPU_INT32U   Size;                                          /* Size        of simulated flash (in octets).          */
+    CPU_INT32U   SectorSize;                                    /* Sector size of simulated flash (in octets).          */
+    CPU_INT16U   PageSize;                                      /* Page size   of simulated flash (in octets).          */
+    CPU_INT32U   EraseDly_ms;                                   /* Dly of each sector erase (see Note #2).              */
+
+    CPU_INT32U   EraseCtr;                                      /* Nbr of sectors erased.                               */
+    CPU_INT32U   ProgCtr;                                       /* Nbr of pages   programmed.                           */
+    CPU_INT32U   ErrCtr;                                        /* Nbr of ops rejected ('tftp-c_flash.h  Note #2').     */
+} TFTPc_FLASH_RAM;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_FLASH_RAM_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_FlashRAM_Init (TFTPc_FLASH      *p_flash,
+                                  TFTPc_FLASH_RAM  *p_ram,
+                                  CPU_INT08U       *p_mem,
+                                  CPU_INT32U        size,
+                                  CPU_INT32U        sector_size,
+                                  CPU_INT16U        page_size,
+                                  CPU_INT32U        erase_dly_ms,
+                                  TFTPc_ERR        *p_err);
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                        CONFIGURATION ERRORS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CFG_FLASH_RAM_EN
+#error  "TFTPc_CFG_FLASH_RAM_EN                not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_FLASH_RAM_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_FLASH_RAM_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_FLASH_RAM_EN          illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_FLASH_RAM_EN == DEF_ENABLED) && \
+        (TFTPc_CFG_FLASH_EN     != DEF_ENABLED))
+#error  "TFTPc_CFG_FLASH_RAM_EN          illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED when            "
+#error  "                                 TFTPc_CFG_FLASH_EN is DISABLED]        "
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPc_FLASH_MODULE_PRESENT  */
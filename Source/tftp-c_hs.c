@@ -0,0 +1,601 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP CLIENT HEATSHRINK CODEC
+*
+* Filename : tftp-c_hs.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The codec functions are called by the TFTPc transfer path, which holds the TFTPc lock : the
+*                heatshrink context is never accessed concurrently.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPc_HS_MODULE
+#include  "tftp-c_hs.h"
+
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CODEC_HS_EN == DEF_ENABLED)
+
+#define  TFTPc_HS_STATE_TAG                                0u   /* Rx'ing tag bit.                                      */
+#define  TFTPc_HS_STATE_LIT                                1u   /* Rx'ing literal octet.                                */
+#define  TFTPc_HS_STATE_IX                                 2u   /* Rx'ing backref index.                                */
+#define  TFTPc_HS_STATE_CNT                                3u   /* Rx'ing backref count.                                */
+#define  TFTPc_HS_STATE_COPY                               4u   /* Outputting backref octets.                           */
+
+#define  TFTPc_HS_BUF_MASK                 (TFTPc_HS_BUF_SIZE - 1u)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                      LOCAL FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_HS_Init      (       void            *p_ctx,
+                                                CPU_BOOLEAN      encode);
+
+static  CPU_BOOLEAN  TFTPc_HS_Process   (       void            *p_ctx,
+                                         const  CPU_INT08U      *p_src,
+                                                CPU_SIZE_T       src_len,
+                                                CPU_SIZE_T      *p_src_used,
+                                                CPU_INT08U      *p_dst,
+                                                CPU_SIZE_T       dst_len,
+                                                CPU_SIZE_T      *p_dst_used,
+                                                CPU_BOOLEAN      flush);
+
+static  void         TFTPc_HS_Dec       (       TFTPc_CODEC_HS  *p_hs,
+                                         const  CPU_INT08U      *p_src,
+                                                CPU_SIZE_T       src_len,
+                                                CPU_SIZE_T      *p_src_used,
+                                                CPU_INT08U      *p_dst,
+                                                CPU_SIZE_T       dst_len,
+                                                CPU_SIZE_T      *p_dst_used);
+
+static  void         TFTPc_HS_Enc       (       TFTPc_CODEC_HS  *p_hs,
+                                         const  CPU_INT08U      *p_src,
+                                                CPU_SIZE_T       src_len,
+                                                CPU_SIZE_T      *p_src_used,
+                                                CPU_INT08U      *p_dst,
+                                                CPU_SIZE_T       dst_len,
+                                                CPU_SIZE_T      *p_dst_used,
+                                                CPU_BOOLEAN      flush);
+
+static  CPU_INT16U   TFTPc_HS_MatchFind (       TFTPc_CODEC_HS  *p_hs,
+                                                CPU_INT16U      *p_ix);
+
+static  void         TFTPc_HS_BitsPut   (       TFTPc_CODEC_HS  *p_hs,
+                                                CPU_INT32U       val,
+                                                CPU_INT08U       nbr);
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_HS_CodecInit()
+*
+* Description : Initialize a codec structure for heatshrink compression.
+*
+* Argument(s) : p_codec     Pointer to codec structure to initialize.
+*
+*               p_hs        Pointer to heatshrink context (see Note #1).
+*
+*               p_suffix    Pointer to remote filename suffix identifying compressed files (e.g. ".hs").
+*
+*                               DEF_NULL, to apply the codec only to transfers requested with
+*                               TFTPc_MODE_FLAG_CODEC.
+*
+*               p_err       Pointer to variable that will receive the return error code from this
+*                           function :
+*
+*                               TFTPc_ERR_NONE          Codec successfully initialized.
+*                               TFTPc_ERR_NULL_PTR      Argument(s) passed NULL pointer(s).
+*
+* Return(s)   : DEF_OK,   if codec was initialized successfully.
+*               DEF_FAIL, otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) The codec structure & the heatshrink context are referenced by the codec once registered
+*                   with TFTPc_CodecSet() : they MUST remain valid while registered.
+*
+*               (2) A TFTPc_Get() transfer using the codec decompresses the file rx'd; a TFTPc_Put() transfer
+*                   compresses the file tx'd.
+*********************************************************************************************************
+*/
+
+CPU_BOOLEAN  TFTPc_HS_CodecInit (       TFTPc_CODEC     *p_codec,
+                                        TFTPc_CODEC_HS  *p_hs,
+                                 const  CPU_CHAR        *p_suffix,
+                                        TFTPc_ERR       *p_err)
+{
+#if (TFTPc_CFG_ARG_CHK_EXT_EN == DEF_ENABLED)
+    if (p_err == DEF_NULL) {
+        CPU_SW_EXCEPTION(DEF_FAIL);
+    }
+
+    if ((p_codec == DEF_NULL) ||
+        (p_hs    == DEF_NULL)) {
+       *p_err = TFTPc_ERR_NULL_PTR;
+        return (DEF_FAIL);
+    }
+#endif
+
+    Mem_Clr(p_hs, sizeof(TFTPc_CODEC_HS));
+
+    p_codec->SuffixPtr = p_suffix;
+    p_codec->CtxPtr    = p_hs;
+    p_codec->Init      = TFTPc_HS_Init;
+    p_codec->Process   = TFTPc_HS_Process;
+    p_codec->Close     = DEF_NULL;
+
+   *p_err = TFTPc_ERR_NONE;
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                           LOCAL FUNCTIONS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_HS_Init()
+*
+* Description : Reset the heatshrink context, at the start of a transfer.
+*
+* Argument(s) : p_ctx       Pointer to heatshrink context.
+*
+*               encode      DEF_YES, for a TFTPc_Put() transfer.
+*
+*                           DEF_NO,  for a TFTPc_Get() transfer.
+*
+* Return(s)   : DEF_OK.
+*
+* Caller(s)   : TFTPc_CodecSel(), via the codec structure.
+*
+* Note(s)     : (1) The history is cleared : a backref reaching before the start of the stream outputs 0
+*                   octets (see 'tftp-c_hs.h  TFTPc HEATSHRINK STREAM DEFINES  Note #1b').
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_HS_Init (void         *p_ctx,
+                                    CPU_BOOLEAN   encode)
+{
+    TFTPc_CODEC_HS  *p_hs;
+
+
+    p_hs             = (TFTPc_CODEC_HS *)p_ctx;
+
+    p_hs->Encode     = encode;
+    p_hs->State      = TFTPc_HS_STATE_TAG;
+    p_hs->Pos        = 0u;
+    p_hs->InPos      = 0u;
+    p_hs->Bits       = 0u;
+    p_hs->BitsNbr    = 0u;
+    p_hs->BackrefIx  = 0u;
+    p_hs->BackrefRem = 0u;
+
+    Mem_Clr(p_hs->Buf, sizeof(p_hs->Buf));                      /* See Note #1.                                         */
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_HS_Process()
+*
+* Description : Compress or decompress a chunk of data.
+*
+* Argument(s) : p_ctx       Pointer to heatshrink context.
+*
+*               p_src       Pointer to data to process.
+*
+*               src_len     Length of data to process (in octets).
+*
+*               p_src_used  Pointer to variable that will receive the number of octets consumed.
+*
+*               p_dst       Pointer to buffer that will receive the processed data.
+*
+*               dst_len     Length of buffer (in octets).
+*
+*               p_dst_used  Pointer to variable that will receive the number of octets produced.
+*
+*               flush       DEF_YES, if the end of the data to process was reached.
+*
+* Return(s)   : DEF_OK.
+*
+* Caller(s)   : TFTPc_CodecDataWr(),
+*               TFTPc_CodecDataRd(), via the codec structure.
+*
+* Note(s)     : (1) The end of a compressed stream needs no processing : its padding bits are ignored.  A
+*                   truncated or corrupted stream is NOT detected by the heatshrink format; the application
+*                   checks the decompressed file (e.g. its length or digest) when needed.
+*********************************************************************************************************
+*/
+
+static  CPU_BOOLEAN  TFTPc_HS_Process (       void         *p_ctx,
+                                       const  CPU_INT08U   *p_src,
+                                              CPU_SIZE_T    src_len,
+                                              CPU_SIZE_T   *p_src_used,
+                                              CPU_INT08U   *p_dst,
+                                              CPU_SIZE_T    dst_len,
+                                              CPU_SIZE_T   *p_dst_used,
+                                              CPU_BOOLEAN   flush)
+{
+    TFTPc_CODEC_HS  *p_hs;
+
+
+    p_hs = (TFTPc_CODEC_HS *)p_ctx;
+
+    if (p_hs->Encode == DEF_YES) {
+        TFTPc_HS_Enc(p_hs, p_src, src_len, p_src_used, p_dst, dst_len, p_dst_used, flush);
+    } else {                                                    /* See Note #1.                                         */
+        TFTPc_HS_Dec(p_hs, p_src, src_len, p_src_used, p_dst, dst_len, p_dst_used);
+    }
+
+    return (DEF_OK);
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_HS_Dec()
+*
+* Description : Decompress a chunk of a heatshrink stream.
+*
+* Argument(s) : p_hs        Pointer to heatshrink context.
+*
+*               Others      See TFTPc_HS_Process().
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_HS_Process().
+*
+* Note(s)     : (1) Decoding stops as soon as the output buffer is full, before a tag is read : a literal
+*                   always has room to be output.
+*
+*               (2) Backref octets are copied one at a time, since a backref may overlap its own output.  The
+*                   history is cleared by TFTPc_HS_Init() (see 'tftp-c_hs.h  TFTPc HEATSHRINK STREAM DEFINES
+*                   Note #1b').
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_HS_Dec (       TFTPc_CODEC_HS  *p_hs,
+                            const  CPU_INT08U      *p_src,
+                                   CPU_SIZE_T       src_len,
+                                   CPU_SIZE_T      *p_src_used,
+                                   CPU_INT08U      *p_dst,
+                                   CPU_SIZE_T       dst_len,
+                                   CPU_SIZE_T      *p_dst_used)
+{
+    CPU_SIZE_T  src_ix;
+    CPU_SIZE_T  dst_ix;
+    CPU_INT08U  bits_req;
+    CPU_INT32U  val;
+    CPU_INT08U  octet;
+
+
+    src_ix = 0u;
+    dst_ix = 0u;
+
+    for (;;) {
+        if (p_hs->State == TFTPc_HS_STATE_COPY) {               /* See Note #2.                                         */
+            while ((p_hs->BackrefRem > 0u) &&
+                   (dst_ix           < dst_len)) {
+                octet                                  = p_hs->Buf[(p_hs->Pos - p_hs->BackrefIx) & TFTPc_HS_BUF_MASK];
+                p_hs->Buf[p_hs->Pos & TFTPc_HS_BUF_MASK] = octet;
+                p_hs->Pos++;
+                p_dst[dst_ix]                          = octet;
+                dst_ix++;
+                p_hs->BackrefRem--;
+            }
+            if (p_hs->BackrefRem > 0u) {
+                break;
+            }
+            p_hs->State = TFTPc_HS_STATE_TAG;
+        }
+
+        if (dst_ix >= dst_len) {                                /* See Note #1.                                         */
+            break;
+        }
+
+        switch (p_hs->State) {
+            case TFTPc_HS_STATE_LIT:
+                 bits_req = TFTPc_HS_LIT_BITS;
+                 break;
+
+            case TFTPc_HS_STATE_IX:
+                 bits_req = TFTPc_CFG_CODEC_HS_WIN_BITS;
+                 break;
+
+            case TFTPc_HS_STATE_CNT:
+                 bits_req = TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS;
+                 break;
+
+            case TFTPc_HS_STATE_TAG:
+            default:
+                 bits_req = TFTPc_HS_TAG_BITS;
+                 break;
+        }
+
+        while ((p_hs->BitsNbr < bits_req) &&                    /* Accumulate bits req'd by cur state.                  */
+               (src_ix        < src_len)) {
+            p_hs->Bits     = (p_hs->Bits << DEF_OCTET_NBR_BITS) | p_src[src_ix];
+            p_hs->BitsNbr += DEF_OCTET_NBR_BITS;
+            src_ix++;
+        }
+        if (p_hs->BitsNbr < bits_req) {                         /* Wait for more data.                                  */
+            break;
+        }
+
+        p_hs->BitsNbr -= bits_req;
+        val            = (p_hs->Bits >> p_hs->BitsNbr) & ((1u << bits_req) - 1u);
+        p_hs->Bits    &= (1u << p_hs->BitsNbr) - 1u;
+
+        switch (p_hs->State) {
+            case TFTPc_HS_STATE_TAG:
+                 p_hs->State = (val != 0u) ? TFTPc_HS_STATE_LIT : TFTPc_HS_STATE_IX;
+                 break;
+
+
+            case TFTPc_HS_STATE_LIT:
+                 p_hs->Buf[p_hs->Pos & TFTPc_HS_BUF_MASK] = (CPU_INT08U)val;
+                 p_hs->Pos++;
+                 p_dst[dst_ix] = (CPU_INT08U)val;
+                 dst_ix++;
+                 p_hs->State   = TFTPc_HS_STATE_TAG;
+                 break;
+
+
+            case TFTPc_HS_STATE_IX:
+                 p_hs->BackrefIx = (CPU_INT16U)(val + 1u);
+                 p_hs->State     =  TFTPc_HS_STATE_CNT;
+                 break;
+
+
+            case TFTPc_HS_STATE_CNT:
+            default:
+                 p_hs->BackrefRem = (CPU_INT16U)(val + 1u);
+                 p_hs->State      =  TFTPc_HS_STATE_COPY;
+                 break;
+        }
+    }
+
+   *p_src_used = src_ix;
+   *p_dst_used = dst_ix;
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TFTPc_HS_Enc()
+*
+* Description : Compress a chunk of data into a heatshrink stream.
+*
+* Argument(s) : p_hs        Pointer to heatshrink context.
+*
+*               Others      See TFTPc_HS_Process().
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_HS_Process().
+*
+* Note(s)     : (1) Data is consumed until the lookahead is full, so that each match is searched over the
+*                   longest possible lookahead; the lookahead is only encoded partially once flushed.
+*
+*               (2) A new literal or backref is only encoded once all the complete octets of the previous
+*                   ones were output : less than 8 bits remain in the accumulator, which can hold another
+*                   backref (see 'tftp-c_hs.h  CONFIGURATION ERRORS').
+*
+*               (3) Once flushed & the lookahead encoded, the last bits are padded to an octet.  Nothing is
+*                   output by the following calls, which ends the transfer.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_HS_Enc (       TFTPc_CODEC_HS  *p_hs,
+                            const  CPU_INT08U      *p_src,
+                                   CPU_SIZE_T       src_len,
+                                   CPU_SIZE_T      *p_src_used,
+                                   CPU_INT08U      *p_dst,
+                                   CPU_SIZE_T       dst_len,
+                                   CPU_SIZE_T      *p_dst_used,
+                                   CPU_BOOLEAN      flush)
+{
+    CPU_SIZE_T  src_ix;
+    CPU_SIZE_T  dst_ix;
+    CPU_INT32U  lookahead_len;
+    CPU_INT16U  match_len;
+    CPU_INT16U  match_ix;
+
+
+    src_ix = 0u;
+    dst_ix = 0u;
+
+    for (;;) {
+        while ((p_hs->BitsNbr >= DEF_OCTET_NBR_BITS) &&         /* Output complete octets.                              */
+               (dst_ix        <  dst_len)) {
+            p_hs->BitsNbr -= DEF_OCTET_NBR_BITS;
+            p_dst[dst_ix]  = (CPU_INT08U)(p_hs->Bits >> p_hs->BitsNbr);
+            p_hs->Bits    &= (1u << p_hs->BitsNbr) - 1u;
+            dst_ix++;
+        }
+        if (p_hs->BitsNbr >= DEF_OCTET_NBR_BITS) {              /* See Note #2.                                         */
+            break;
+        }
+
+        while (((p_hs->InPos - p_hs->Pos) < TFTPc_HS_LOOKAHEAD_SIZE) &&
+                (src_ix                   < src_len)) {         /* See Note #1.                                         */
+            p_hs->Buf[p_hs->InPos & TFTPc_HS_BUF_MASK] = p_src[src_ix];
+            p_hs->InPos++;
+            src_ix++;
+        }
+
+        lookahead_len = p_hs->InPos - p_hs->Pos;
+        if (lookahead_len == 0u) {
+            if ((flush         == DEF_YES) &&                   /* See Note #3.                                         */
+                (p_hs->BitsNbr >  0u)) {
+                TFTPc_HS_BitsPut(p_hs, 0u, DEF_OCTET_NBR_BITS - p_hs->BitsNbr);
+                continue;
+            }
+            break;
+        }
+        if ((lookahead_len <  TFTPc_HS_LOOKAHEAD_SIZE) &&
+            (flush         == DEF_NO)) {
+            break;
+        }
+
+        match_len = TFTPc_HS_MatchFind(p_hs, &match_ix);
+        if ((match_len * (TFTPc_HS_TAG_BITS + TFTPc_HS_LIT_BITS)) > TFTPc_HS_BACKREF_BITS) {
+            TFTPc_HS_BitsPut(p_hs, 0u,                    TFTPc_HS_TAG_BITS);
+            TFTPc_HS_BitsPut(p_hs, match_ix  - 1u,        TFTPc_CFG_CODEC_HS_WIN_BITS);
+            TFTPc_HS_BitsPut(p_hs, match_len - 1u,        TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS);
+            p_hs->Pos += match_len;
+        } else {
+            TFTPc_HS_BitsPut(p_hs, 1u,                    TFTPc_HS_TAG_BITS);
+            TFTPc_HS_BitsPut(p_hs, p_hs->Buf[p_hs->Pos & TFTPc_HS_BUF_MASK], TFTPc_HS_LIT_BITS);
+            p_hs->Pos++;
+        }
+    }
+
+   *p_src_used = src_ix;
+   *p_dst_used = dst_ix;
+}
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_HS_MatchFind()
+*
+* Description : Find the longest match of the lookahead in the history.
+*
+* Argument(s) : p_hs        Pointer to heatshrink context.
+*
+*               p_ix        Pointer to variable that will receive the match distance (backref index + 1).
+*
+* Return(s)   : Length of the longest match, 0 if none.
+*
+* Caller(s)   : TFTPc_HS_Enc().
+*
+* Note(s)     : (1) The history is searched from the most recent octet : the nearest of the longest matches
+*                   is kept.  The search stops early on a match of the whole lookahead.
+*
+*               (2) A match may run into the lookahead (see 'tftp-c_hs.h  TFTPc HEATSHRINK STREAM DEFINES
+*                   Note #1a').
+*********************************************************************************************************
+*/
+
+static  CPU_INT16U  TFTPc_HS_MatchFind (TFTPc_CODEC_HS  *p_hs,
+                                        CPU_INT16U      *p_ix)
+{
+    CPU_INT32U  ix_max;
+    CPU_INT32U  len_max;
+    CPU_INT32U  ix;
+    CPU_INT32U  len;
+    CPU_INT32U  best_len;
+    CPU_INT32U  best_ix;
+
+
+    ix_max   = DEF_MIN(p_hs->Pos, TFTPc_HS_WIN_SIZE);
+    len_max  = p_hs->InPos - p_hs->Pos;
+    best_len = 0u;
+    best_ix  = 0u;
+
+    for (ix = 1u; ix <= ix_max; ix++) {                         /* See Note #1.                                         */
+        len = 0u;
+        while ((len < len_max) &&                               /* See Note #2.                                         */
+               (p_hs->Buf[(p_hs->Pos - ix + len) & TFTPc_HS_BUF_MASK] ==
+                p_hs->Buf[(p_hs->Pos      + len) & TFTPc_HS_BUF_MASK])) {
+            len++;
+        }
+        if (len > best_len) {
+            best_len = len;
+            best_ix  = ix;
+            if (len == len_max) {
+                break;
+            }
+        }
+    }
+
+   *p_ix = (CPU_INT16U)best_ix;
+
+    return ((CPU_INT16U)best_len);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_HS_BitsPut()
+*
+* Description : Append bits to the encoder bit accumulator.
+*
+* Argument(s) : p_hs        Pointer to heatshrink context.
+*
+*               val         Bits to append, right-aligned.
+*
+*               nbr         Nbr of bits to append.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_HS_Enc().
+*
+* Note(s)     : (1) See 'TFTPc_HS_Enc()  Note #2'.
+*********************************************************************************************************
+*/
+
+static  void  TFTPc_HS_BitsPut (TFTPc_CODEC_HS  *p_hs,
+                                CPU_INT32U       val,
+                                CPU_INT08U       nbr)
+{
+    p_hs->Bits     = (p_hs->Bits << nbr) | (val & ((1u << nbr) - 1u));
+    p_hs->BitsNbr += nbr;
+}
+
+
+#endif
@@ -0,0 +1,234 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+
+/*
+*********************************************************************************************************
+*
+*                                    TFTP CLIENT HEATSHRINK CODEC
+*
+* Filename : tftp-c_hs.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The heatshrink codec compresses the files tx'd by TFTPc_Put() & decompresses the files rx'd
+*                by TFTPc_Get(), in the heatshrink format (LZSS, see 'TFTPc HEATSHRINK STREAM DEFINES').
+*                Files are exchanged with hosts with the heatshrink command line tool, built with the same
+*                window & lookahead sizes :
+*
+*                    heatshrink -e -w TFTPc_CFG_CODEC_HS_WIN_BITS -l TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS
+*
+*            (2) The heatshrink codec is a TFTPc codec (see 'tftp-c.h  TFTPc CODEC DATA TYPE') : it is
+*                initialized with TFTPc_HS_CodecInit() & registered with TFTPc_CodecSet().
+*
+*            (3) RAM usage is bounded by the heatshrink context, whose size only depends on the window size
+*                (see 'TFTPc HEATSHRINK CONTEXT DATA TYPE'), & by the codec working buffer (see
+*                'tftp-c_cfg.h  TFTPc_CFG_CODEC_BUF_SIZE'), whatever the size of the files.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_HS_MODULE_PRESENT
+#define  TFTPc_HS_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <lib_def.h>
+
+#include  <tftp-c_cfg.h>
+#include  "tftp-c.h"
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                   TFTPc HEATSHRINK STREAM DEFINES
+*
+* Note(s) : (1) A heatshrink stream is a sequence of bits, packed most significant bit first, made of :
+*
+*                   Literal     1   Octet (8 bits)                                  Output 'Octet'.
+*
+*                   Backref     0   Index (W bits)      Count (L bits)              Output 'Count + 1'
+*                                                                                   octets, copied from
+*                                                                                   'Index + 1' octets back.
+*
+*               where W is TFTPc_CFG_CODEC_HS_WIN_BITS & L is TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS.  The
+*               last octet is padded with 0 bits.  The stream has no header : both ends MUST be configured
+*               with the same W & L.
+*
+*               (a) A backref may overlap the octets it outputs (e.g. Index 0 repeats the last octet).
+*
+*               (b) The history is all 0 octets at the start of the stream, as with the reference
+*                   implementation : a backref reaching before the start of the stream outputs 0 octets.
+*
+*               (c) A backref costs (1 + W + L) bits & a literal 9 bits : the encoder only uses a backref
+*                   when it is shorter than the literals it replaces.
+*********************************************************************************************************
+*/
+
+#define  TFTPc_HS_WIN_SIZE                (1u << TFTPc_CFG_CODEC_HS_WIN_BITS)
+#define  TFTPc_HS_LOOKAHEAD_SIZE          (1u << TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS)
+#define  TFTPc_HS_BUF_SIZE                (2u * TFTPc_HS_WIN_SIZE)
+
+#define  TFTPc_HS_TAG_BITS                                 1u
+#define  TFTPc_HS_LIT_BITS                                 8u
+#define  TFTPc_HS_BACKREF_BITS           (TFTPc_HS_TAG_BITS            + \
+                                          TFTPc_CFG_CODEC_HS_WIN_BITS  + \
+                                          TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS)
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                   TFTPc HEATSHRINK CONTEXT DATA TYPE
+*
+* Note(s) : (1) The heatshrink context is owned by the application & MUST remain valid while the codec is
+*               registered.  Its fields are private to the heatshrink codec.
+*
+*           (2) The decoder keeps the last TFTPc_HS_WIN_SIZE octets output in 'Buf'.  The encoder keeps the
+*               last TFTPc_HS_WIN_SIZE octets encoded followed by up to TFTPc_HS_LOOKAHEAD_SIZE octets to
+*               encode.  'Buf' is indexed by stream position, modulo its size.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_codec_hs {
+    CPU_BOOLEAN  Encode;                                        /* DEF_YES if compressing, DEF_NO if decompressing.     */
+    CPU_INT08U   State;                                         /* Decoder state.                                       */
+
+    CPU_INT08U   Buf[TFTPc_HS_BUF_SIZE];                        /* History & lookahead (see Note #2).                   */
+    CPU_INT32U   Pos;                                           /* Nbr of octets decoded/encoded.                       */
+    CPU_INT32U   InPos;                                         /* Nbr of octets rx'd by encoder.                       */
+
+    CPU_INT32U   Bits;                                          /* Bit accumulator.                                     */
+    CPU_INT08U   BitsNbr;                                       /* Nbr of bits in accumulator.                          */
+
+    CPU_INT16U   BackrefIx;                                     /* Backref index + 1 being decoded.                     */
+    CPU_INT16U   BackrefRem;                                    /* Nbr of backref octets remaining to output.           */
+} TFTPc_CODEC_HS;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_CODEC_HS_EN == DEF_ENABLED)
+CPU_BOOLEAN  TFTPc_HS_CodecInit (       TFTPc_CODEC     *p_codec,
+                                        TFTPc_CODEC_HS  *p_hs,
+                                 const  CPU_CHAR        *p_suffix,
+                                        TFTPc_ERR       *p_err);
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                        CONFIGURATION ERRORS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CFG_CODEC_HS_EN
+#error  "TFTPc_CFG_CODEC_HS_EN                 not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_CODEC_HS_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_CODEC_HS_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_CODEC_HS_EN           illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_CODEC_HS_EN == DEF_ENABLED) && \
+        (TFTPc_CFG_CODEC_EN    != DEF_ENABLED))
+#error  "TFTPc_CFG_CODEC_HS_EN           illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED when            "
+#error  "                                 TFTPc_CFG_CODEC_EN is DISABLED]        "
+#endif
+
+
+#ifndef  TFTPc_CFG_CODEC_HS_WIN_BITS
+#error  "TFTPc_CFG_CODEC_HS_WIN_BITS           not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >=  4]                       "
+#error  "                                [     &&  <= 15]                       "
+
+#elif  ((TFTPc_CFG_CODEC_HS_WIN_BITS <  4u) || \
+        (TFTPc_CFG_CODEC_HS_WIN_BITS > 15u))
+#error  "TFTPc_CFG_CODEC_HS_WIN_BITS     illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >=  4]                       "
+#error  "                                [     &&  <= 15]                       "
+#endif
+
+
+#ifndef  TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS
+#error  "TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS     not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 3]                        "
+#error  "                                [     &&  <  TFTPc_CFG_CODEC_HS_WIN_BITS]"
+
+#elif  ((TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS <  3u) || \
+        (TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS >= TFTPc_CFG_CODEC_HS_WIN_BITS))
+#error  "TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  >= 3]                        "
+#error  "                                [     &&  <  TFTPc_CFG_CODEC_HS_WIN_BITS]"
+
+#elif   (TFTPc_HS_BACKREF_BITS > 25u)                           /* See 'tftp-c_hs.c  TFTPc_HS_Enc()  Note #2'.          */
+#error  "TFTPc_CFG_CODEC_HS_LOOKAHEAD_BITS illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  <= 24 - TFTPc_CFG_CODEC_HS_WIN_BITS]"
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPc_HS_MODULE_PRESENT  */
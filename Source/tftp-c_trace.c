@@ -0,0 +1,456 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        TFTP CLIENT TRACE RING
+*
+* Filename : tftp-c_trace.c
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The ring is written by a single task at a time : every caller of TFTPc_TraceEventWr()
+*                runs from a TFTPc transfer, which holds the TFTPc lock.  No critical section is
+*                therefore required to record an event; readers rely on the event sequence number to
+*                detect entries overwritten while being copied.
+*
+*            (2) TFTPc_TraceEventNameGet() & TFTPc_TraceDecode() only depend on uC/CPU & uC/LIB so
+*                that a dumped ring can be decoded off target.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define    MICRIUM_SOURCE
+#define    TFTPc_TRACE_MODULE
+#include  "tftp-c_trace.h"
+
+#include  <lib_mem.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            LOCAL DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#define  TFTPc_TRACE_DECODE_NBR_DIG_SEQ                   10u
+#define  TFTPc_TRACE_DECODE_NBR_DIG_TS                    10u
+#define  TFTPc_TRACE_DECODE_NBR_DIG_SESSION                5u
+#define  TFTPc_TRACE_DECODE_NBR_DIG_ARG                   10u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                       LOCAL GLOBAL VARIABLES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+static  TFTPc_TRACE_EVENT   TFTPc_TraceRing[TFTPc_CFG_TRACE_RING_NBR_EVENT];
+
+static  CPU_INT32U          TFTPc_TraceSeqNbrLast;              /* Seq nbr of last event wr'n.                          */
+
+static  CPU_INT08U          TFTPc_TraceMask = TFTPc_CFG_TRACE_RING_LVL_DFLT;
+#endif
+
+                                                                /* Indexed by event ID.                                 */
+static  const  CPU_CHAR    *TFTPc_TraceEventNameTbl[TFTPc_TRACE_EVENT_NBR_MAX] = {
+    "NONE",
+    "SESSION_START",
+    "SESSION_END",
+    "REQ_TX",
+    "DATA_RX",
+    "DATA_TX",
+    "ACK_RX",
+    "ACK_TX",
+    "ERR_RX",
+    "ERR_TX",
+    "OPCODE_INVALID",
+    "RX_TIMEOUT",
+    "RE_TX",
+    "FILE_ERR",
+    "DATA_DUP",
+    "RX_STRAY",
+    "DATA_GAP"
+};
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TraceMaskSet()
+*
+* Description : Set the run-time trace level mask.
+*
+* Argument(s) : mask    Bitwise OR of the levels to record :
+*
+*                           TFTPc_TRACE_LVL_ERR
+*                           TFTPc_TRACE_LVL_STATE
+*                           TFTPc_TRACE_LVL_RETRY
+*                           TFTPc_TRACE_LVL_PKT
+*
+*                       TFTPc_TRACE_LVL_NONE to stop recording, TFTPc_TRACE_LVL_ALL to record everything.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+void  TFTPc_TraceMaskSet (CPU_INT08U  mask)
+{
+    TFTPc_TraceMask = mask;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TraceMaskGet()
+*
+* Description : Get the run-time trace level mask.
+*
+* Argument(s) : none.
+*
+* Return(s)   : Current trace level mask.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : none.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+CPU_INT08U  TFTPc_TraceMaskGet (void)
+{
+    return (TFTPc_TraceMask);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                        TFTPc_TraceEventWr()
+*
+* Description : Record an event in the trace ring.
+*
+* Argument(s) : lvl             Level the event belongs to (see TFTPc TRACE LEVEL MASK DEFINES).
+*
+*               event_id        Event ID (see TFTPc TRACE EVENT ID DEFINES).
+*
+*               session_id      Transfer session ID.
+*
+*               arg0            First  event argument.
+*
+*               arg1            Second event argument.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : TFTPc_TRACE_EVENT_WR().
+*
+* Note(s)     : (1) See 'tftp-c_trace.c  Note #1'.
+*
+*               (2) The sequence number is cleared before the entry is modified & set again once the
+*                   entry is complete (see 'tftp-c_trace.h  TFTPc TRACE EVENT DATA TYPE  Note #1').
+*
+*               (3) Sequence number zero is reserved for never written entries.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+void  TFTPc_TraceEventWr (CPU_INT08U  lvl,
+                          CPU_INT08U  event_id,
+                          CPU_INT16U  session_id,
+                          CPU_INT32U  arg0,
+                          CPU_INT32U  arg1)
+{
+    TFTPc_TRACE_EVENT  *p_event;
+    CPU_INT32U          seq_nbr;
+
+
+    if ((TFTPc_TraceMask & lvl) == 0u) {                        /* Discard event if lvl masked.                         */
+        return;
+    }
+
+    seq_nbr = TFTPc_TraceSeqNbrLast + 1u;
+    if (seq_nbr == 0u) {                                        /* See Note #3.                                         */
+        seq_nbr = 1u;
+    }
+
+    p_event         = &TFTPc_TraceRing[seq_nbr & (TFTPc_CFG_TRACE_RING_NBR_EVENT - 1u)];
+    p_event->SeqNbr =  0u;                                      /* See Note #2.                                         */
+
+#if (CPU_CFG_TS_32_EN == DEF_ENABLED)
+    p_event->TS        = CPU_TS_Get32();
+#else
+    p_event->TS        = 0u;
+#endif
+    p_event->SessionID = session_id;
+    p_event->EventID   = event_id;
+    p_event->Lvl       = lvl;
+    p_event->Arg0      = arg0;
+    p_event->Arg1      = arg1;
+
+    p_event->SeqNbr       = seq_nbr;
+    TFTPc_TraceSeqNbrLast = seq_nbr;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_TraceDump()
+*
+* Description : Copy the content of the trace ring, oldest event first.
+*
+* Argument(s) : p_events            Pointer to array that will receive the events.
+*
+*               nbr_events_max      Size of 'p_events' array (in events).
+*
+* Return(s)   : Number of events copied.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) If 'p_events' is too small to hold the whole ring, the most recent events are copied.
+*
+*               (2) The ring may be written while being dumped.  Entries overwritten during the copy
+*                   are skipped (see 'tftp-c_trace.h  TFTPc TRACE EVENT DATA TYPE  Note #1').
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+CPU_INT16U  TFTPc_TraceDump (TFTPc_TRACE_EVENT  *p_events,
+                             CPU_INT16U          nbr_events_max)
+{
+    TFTPc_TRACE_EVENT  *p_event;
+    CPU_INT32U          seq_nbr_last;
+    CPU_INT32U          seq_nbr;
+    CPU_INT32U          nbr_events;
+    CPU_INT16U          nbr_copied;
+
+
+    if ((p_events       == DEF_NULL) ||
+        (nbr_events_max == 0u)) {
+        return (0u);
+    }
+
+    seq_nbr_last = TFTPc_TraceSeqNbrLast;
+    nbr_events   = DEF_MIN(seq_nbr_last, TFTPc_CFG_TRACE_RING_NBR_EVENT);
+    nbr_events   = DEF_MIN(nbr_events,   nbr_events_max);       /* See Note #1.                                         */
+
+    seq_nbr      = seq_nbr_last - nbr_events + 1u;
+    nbr_copied   = 0u;
+    while (nbr_events > 0u) {
+        p_event = &TFTPc_TraceRing[seq_nbr & (TFTPc_CFG_TRACE_RING_NBR_EVENT - 1u)];
+        if (p_event->SeqNbr == seq_nbr) {
+            p_events[nbr_copied] = *p_event;
+            if (p_event->SeqNbr == seq_nbr) {                   /* See Note #2.                                         */
+                nbr_copied++;
+            }
+        }
+        seq_nbr++;
+        nbr_events--;
+    }
+
+    return (nbr_copied);
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                          TFTPc_TraceClr()
+*
+* Description : Discard every event recorded in the trace ring.
+*
+* Argument(s) : none.
+*
+* Return(s)   : none.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) MUST NOT be called while a transfer is in progress.
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+void  TFTPc_TraceClr (void)
+{
+    Mem_Clr(&TFTPc_TraceRing[0], sizeof(TFTPc_TraceRing));
+    TFTPc_TraceSeqNbrLast = 0u;
+}
+#endif
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc_TraceEventNameGet()
+*
+* Description : Get the name of a trace event.
+*
+* Argument(s) : event_id        Event ID (see TFTPc TRACE EVENT ID DEFINES).
+*
+* Return(s)   : Pointer to event name string.
+*
+* Caller(s)   : TFTPc_TraceDecode(),
+*               Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) See 'tftp-c_trace.c  Note #2'.
+*********************************************************************************************************
+*/
+
+const  CPU_CHAR  *TFTPc_TraceEventNameGet (CPU_INT08U  event_id)
+{
+    if (event_id >= TFTPc_TRACE_EVENT_NBR_MAX) {
+        return ("UNKNOWN");
+    }
+
+    return (TFTPc_TraceEventNameTbl[event_id]);
+}
+
+
+/*
+*********************************************************************************************************
+*                                         TFTPc_TraceDecode()
+*
+* Description : Convert a trace event to a readable text line.
+*
+* Argument(s) : p_event     Pointer to event to decode.
+*
+*               p_str       Pointer to buffer that will receive the NULL-terminated string.
+*
+*               str_len     Size of 'p_str' buffer (in octets).  Strings longer than the buffer are
+*                           truncated; TFTPc_TRACE_DECODE_STR_LEN_MAX is always large enough.
+*
+* Return(s)   : Pointer to 'p_str', if NO error.
+*
+*               Pointer to NULL,    otherwise.
+*
+* Caller(s)   : Application.
+*
+*               This function is a TFTP client application interface (API) function & MAY be called by
+*               application function(s).
+*
+* Note(s)     : (1) See 'tftp-c_trace.c  Note #2'.
+*
+*               (2) The line has the following format (timestamp in CPU_TS timer counts) :
+*
+*                       <seq> <ts> S<session> <event name> <arg0> <arg1>
+*********************************************************************************************************
+*/
+
+CPU_CHAR  *TFTPc_TraceDecode (const  TFTPc_TRACE_EVENT  *p_event,
+                                     CPU_CHAR           *p_str,
+                                     CPU_SIZE_T          str_len)
+{
+    CPU_CHAR    str[TFTPc_TRACE_DECODE_STR_LEN_MAX];
+    CPU_CHAR   *p_wr;
+
+
+    if ((p_event == DEF_NULL) ||
+        (p_str   == DEF_NULL) ||
+        (str_len == 0u)) {
+        return (DEF_NULL);
+    }
+
+    p_wr    = &str[0];
+   (void)Str_FmtNbr_Int32U(p_event->SeqNbr,
+                           TFTPc_TRACE_DECODE_NBR_DIG_SEQ,
+                           DEF_NBR_BASE_DEC,
+                           ' ',
+                           DEF_NO,
+                           DEF_NO,
+                           p_wr);
+    p_wr   +=  TFTPc_TRACE_DECODE_NBR_DIG_SEQ;
+   *p_wr++  = ' ';
+
+   (void)Str_FmtNbr_Int32U(p_event->TS,
+                           TFTPc_TRACE_DECODE_NBR_DIG_TS,
+                           DEF_NBR_BASE_DEC,
+                           ' ',
+                           DEF_NO,
+                           DEF_NO,
+                           p_wr);
+    p_wr   +=  TFTPc_TRACE_DECODE_NBR_DIG_TS;
+   *p_wr++  = ' ';
+   *p_wr++  = 'S';
+
+   (void)Str_FmtNbr_Int32U(p_event->SessionID,
+                           TFTPc_TRACE_DECODE_NBR_DIG_SESSION,
+                           DEF_NBR_BASE_DEC,
+                           '0',
+                           DEF_NO,
+                           DEF_NO,
+                           p_wr);
+    p_wr   +=  TFTPc_TRACE_DECODE_NBR_DIG_SESSION;
+   *p_wr++  = ' ';
+   *p_wr    = '\0';
+
+   (void)Str_Cat(p_wr, TFTPc_TraceEventNameGet(p_event->EventID));
+    p_wr   +=  Str_Len(p_wr);
+   *p_wr++  = ' ';
+
+   (void)Str_FmtNbr_Int32U(p_event->Arg0,
+                           TFTPc_TRACE_DECODE_NBR_DIG_ARG,
+                           DEF_NBR_BASE_DEC,
+                           '\0',
+                           DEF_NO,
+                           DEF_YES,
+                           p_wr);
+    p_wr   +=  Str_Len(p_wr);
+   *p_wr++  = ' ';
+
+   (void)Str_FmtNbr_Int32U(p_event->Arg1,
+                           TFTPc_TRACE_DECODE_NBR_DIG_ARG,
+                           DEF_NBR_BASE_DEC,
+                           '\0',
+                           DEF_NO,
+                           DEF_YES,
+                           p_wr);
+
+   (void)Str_Copy_N(p_str, &str[0], str_len - 1u);
+    p_str[str_len - 1u] = '\0';
+
+    return (p_str);
+}
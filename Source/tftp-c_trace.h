@@ -0,0 +1,281 @@
+/*
+*********************************************************************************************************
+*                                              uC/TFTPc
+*                               Trivial File Transfer Protocol (client)
+*
+*                    Copyright 2004-2020 Silicon Laboratories Inc. www.silabs.com
+*
+*                                 SPDX-License-Identifier: APACHE-2.0
+*
+*               This software is subject to an open source license and is distributed by
+*                Silicon Laboratories Inc. pursuant to the terms of the Apache License,
+*                    Version 2.0 available at www.apache.org/licenses/LICENSE-2.0.
+*
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*
+*                                        TFTP CLIENT TRACE RING
+*
+* Filename : tftp-c_trace.h
+* Version  : V2.01.00
+*********************************************************************************************************
+* Note(s)  : (1) The trace ring records fixed-size binary events from the TFTPc transfer path. No text
+*                formatting is performed when an event is recorded; the ring content can be dumped and
+*                converted to text later with TFTPc_TraceDecode(), either on target or on a host.
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MODULE
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_TRACE_MODULE_PRESENT
+#define  TFTPc_TRACE_MODULE_PRESENT
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                            INCLUDE FILES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#include  <cpu.h>
+#include  <cpu_core.h>
+
+#include  <lib_def.h>
+#include  <lib_str.h>
+
+#include  <tftp-c_cfg.h>
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               DEFINES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                     TFTPc TRACE LEVEL MASK DEFINES
+*
+* Note(s) : (1) Each trace event belongs to exactly one level.  An event is recorded only if the bit of
+*               its level is set in the run-time mask (see TFTPc_TraceMaskSet()).
+*********************************************************************************************************
+*/
+
+#define  TFTPc_TRACE_LVL_ERR                     DEF_BIT_00     /* Errors rx'd or tx'd, session failures.               */
+#define  TFTPc_TRACE_LVL_STATE                   DEF_BIT_01     /* Session start/end & state changes.                   */
+#define  TFTPc_TRACE_LVL_RETRY                   DEF_BIT_02     /* Rx timeouts & re-tx.                                 */
+#define  TFTPc_TRACE_LVL_PKT                     DEF_BIT_03     /* Every pkt rx'd or tx'd.                              */
+
+#define  TFTPc_TRACE_LVL_NONE                             0u
+#define  TFTPc_TRACE_LVL_ALL                    (TFTPc_TRACE_LVL_ERR   | \
+                                                 TFTPc_TRACE_LVL_STATE | \
+                                                 TFTPc_TRACE_LVL_RETRY | \
+                                                 TFTPc_TRACE_LVL_PKT)
+
+
+/*
+*********************************************************************************************************
+*                                      TFTPc TRACE EVENT ID DEFINES
+*
+* Note(s) : (1) Meaning of the two arguments recorded with each event :
+*
+*                   Event                               Arg0                    Arg1
+*                   ------------------------------      --------------------    --------------------
+*                   TFTPc_TRACE_EVENT_SESSION_START     Req opcode              Transfer mode
+*                   TFTPc_TRACE_EVENT_SESSION_END       TFTPc_ERR code          State
+*                   TFTPc_TRACE_EVENT_REQ_TX            Req opcode              Pkt len
+*                   TFTPc_TRACE_EVENT_DATA_RX           Blk nbr                 Data len
+*                   TFTPc_TRACE_EVENT_DATA_TX           Blk nbr                 Data len
+*                   TFTPc_TRACE_EVENT_ACK_RX            Blk nbr                 Blk nbr expected
+*                   TFTPc_TRACE_EVENT_ACK_TX            Blk nbr                 0
+*                   TFTPc_TRACE_EVENT_ERR_RX            TFTP err code           0
+*                   TFTPc_TRACE_EVENT_ERR_TX            TFTP err code           0
+*                   TFTPc_TRACE_EVENT_OPCODE_INVALID    Opcode rx'd             State
+*                   TFTPc_TRACE_EVENT_RX_TIMEOUT        Retry cnt               Last tx'd pkt len
+*                   TFTPc_TRACE_EVENT_RE_TX             Retry cnt               Pkt len
+*                   TFTPc_TRACE_EVENT_FILE_ERR          TFTPc_ERR code          Blk nbr
+*                   TFTPc_TRACE_EVENT_DATA_DUP          Blk nbr                 DEF_YES if re-ACK'd
+*                   TFTPc_TRACE_EVENT_RX_STRAY          Pkt len                 0
+*                   TFTPc_TRACE_EVENT_DATA_GAP          Blk nbr                 DEF_YES if kept
+*********************************************************************************************************
+*/
+
+#define  TFTPc_TRACE_EVENT_NONE                            0u
+#define  TFTPc_TRACE_EVENT_SESSION_START                   1u
+#define  TFTPc_TRACE_EVENT_SESSION_END                     2u
+#define  TFTPc_TRACE_EVENT_REQ_TX                          3u
+#define  TFTPc_TRACE_EVENT_DATA_RX                         4u
+#define  TFTPc_TRACE_EVENT_DATA_TX                         5u
+#define  TFTPc_TRACE_EVENT_ACK_RX                          6u
+#define  TFTPc_TRACE_EVENT_ACK_TX                          7u
+#define  TFTPc_TRACE_EVENT_ERR_RX                          8u
+#define  TFTPc_TRACE_EVENT_ERR_TX                          9u
+#define  TFTPc_TRACE_EVENT_OPCODE_INVALID                 10u
+#define  TFTPc_TRACE_EVENT_RX_TIMEOUT                     11u
+#define  TFTPc_TRACE_EVENT_RE_TX                          12u
+#define  TFTPc_TRACE_EVENT_FILE_ERR                       13u
+#define  TFTPc_TRACE_EVENT_DATA_DUP                       14u
+#define  TFTPc_TRACE_EVENT_RX_STRAY                       15u
+#define  TFTPc_TRACE_EVENT_DATA_GAP                       16u
+
+#define  TFTPc_TRACE_EVENT_NBR_MAX                        17u
+
+
+/*
+*********************************************************************************************************
+*                                   TFTPc TRACE DECODE STRING DEFINES
+*
+* Note(s) : (1) Maximum length of a decoded event string, including the terminating NULL character :
+*
+*                   "<seq> <ts> S<session> <event name> <arg0> <arg1>"
+*********************************************************************************************************
+*/
+
+#define  TFTPc_TRACE_DECODE_STR_LEN_MAX                   80u
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+/*
+*********************************************************************************************************
+*                                    TFTPc TRACE EVENT DATA TYPE
+*
+* Note(s) : (1) 'SeqNbr' is written last by TFTPc_TraceEventWr().  An entry whose 'SeqNbr' is zero was
+*               never written; a reader that finds 'SeqNbr' changed after copying an entry MUST discard
+*               the copy since it was overwritten while being read.
+*********************************************************************************************************
+*/
+
+typedef  struct  tftpc_trace_event {
+    CPU_INT32U  SeqNbr;                                         /* Event seq nbr (see Note #1).                         */
+    CPU_TS32    TS;                                             /* Timestamp (CPU_TS timer cnts).                       */
+    CPU_INT16U  SessionID;                                      /* Transfer session the event belongs to.               */
+    CPU_INT08U  EventID;                                        /* Event ID (see TFTPc TRACE EVENT ID DEFINES).         */
+    CPU_INT08U  Lvl;                                            /* Event level (see TFTPc TRACE LEVEL MASK DEFINES).    */
+    CPU_INT32U  Arg0;
+    CPU_INT32U  Arg1;
+} TFTPc_TRACE_EVENT;
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                               MACRO'S
+*
+* Note(s) : (1) TFTPc_TRACE_EVENT_WR() is used from the transfer path.  It compiles to nothing when the
+*               trace ring is disabled.
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+#define  TFTPc_TRACE_EVENT_WR(lvl, event_id, session_id, arg0, arg1)      TFTPc_TraceEventWr((CPU_INT08U)(lvl),        \
+                                                                                             (CPU_INT08U)(event_id),   \
+                                                                                             (CPU_INT16U)(session_id), \
+                                                                                             (CPU_INT32U)(arg0),       \
+                                                                                             (CPU_INT32U)(arg1))
+#else
+#define  TFTPc_TRACE_EVENT_WR(lvl, event_id, session_id, arg0, arg1)
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#if (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+void         TFTPc_TraceMaskSet (       CPU_INT08U          mask);
+
+CPU_INT08U   TFTPc_TraceMaskGet (void);
+
+void         TFTPc_TraceEventWr (       CPU_INT08U          lvl,
+                                        CPU_INT08U          event_id,
+                                        CPU_INT16U          session_id,
+                                        CPU_INT32U          arg0,
+                                        CPU_INT32U          arg1);
+
+CPU_INT16U   TFTPc_TraceDump    (       TFTPc_TRACE_EVENT  *p_events,
+                                        CPU_INT16U          nbr_events_max);
+
+void         TFTPc_TraceClr     (void);
+#endif
+
+                                                                /* Decoder avail even if ring DISABLED (see Note #1).   */
+const  CPU_CHAR  *TFTPc_TraceEventNameGet (       CPU_INT08U          event_id);
+
+CPU_CHAR         *TFTPc_TraceDecode       (const  TFTPc_TRACE_EVENT  *p_event,
+                                                  CPU_CHAR           *p_str,
+                                                  CPU_SIZE_T          str_len);
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                        CONFIGURATION ERRORS
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#ifndef  TFTPc_CFG_TRACE_RING_EN
+#error  "TFTPc_CFG_TRACE_RING_EN               not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif  ((TFTPc_CFG_TRACE_RING_EN != DEF_DISABLED) && \
+        (TFTPc_CFG_TRACE_RING_EN != DEF_ENABLED ))
+#error  "TFTPc_CFG_TRACE_RING_EN         illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  DEF_DISABLED]                "
+#error  "                                [     ||  DEF_ENABLED ]                "
+
+#elif   (TFTPc_CFG_TRACE_RING_EN == DEF_ENABLED)
+
+#ifndef  TFTPc_CFG_TRACE_RING_NBR_EVENT
+#error  "TFTPc_CFG_TRACE_RING_NBR_EVENT        not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  power of 2 >= 2]             "
+
+#elif  ((TFTPc_CFG_TRACE_RING_NBR_EVENT < 2u) || \
+       ((TFTPc_CFG_TRACE_RING_NBR_EVENT & (TFTPc_CFG_TRACE_RING_NBR_EVENT - 1u)) != 0u))
+#error  "TFTPc_CFG_TRACE_RING_NBR_EVENT  illegally #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  power of 2 >= 2]             "
+#endif
+
+#ifndef  TFTPc_CFG_TRACE_RING_LVL_DFLT
+#error  "TFTPc_CFG_TRACE_RING_LVL_DFLT         not #define'd in 'tftp-c_cfg.h'"
+#error  "                                [MUST be  TFTPc_TRACE_LVL_xxx mask]    "
+#endif
+
+#endif
+
+
+/*
+*********************************************************************************************************
+*********************************************************************************************************
+*                                             MODULE END
+*********************************************************************************************************
+*********************************************************************************************************
+*/
+
+#endif  /* TFTPc_TRACE_MODULE_PRESENT  */
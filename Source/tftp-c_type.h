@@ -85,6 +85,11 @@ typedef  struct  tftpc_cfg {
 
     CPU_INT32U           RxInactivityTimeout_ms;
     CPU_INT32U           TxInactivityTimeout_ms;
+
+    CPU_INT32U           TxRateMaxOctetsPerSec;                 /* Session tx rate limit, 0 if unlimited.               */
+    CPU_INT32U           TxBurstMaxOctets;                      /* Session tx burst size (octets).                      */
+
+    CPU_INT32U           TransferTimeoutMax_ms;                 /* Max transfer duration, 0 if unbounded.               */
 } TFTPc_CFG;
 
 